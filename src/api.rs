@@ -12,11 +12,12 @@ use std::sync::Arc;
 use std::sync::atomic::Ordering;
 use axum::{
     extract::{Path, State, ws::WebSocketUpgrade},
-    http::StatusCode,
-    response::Json,
+    http::{header, HeaderMap, StatusCode},
+    response::{IntoResponse, Json, Response},
     routing::{get, post},
     Router,
 };
+use axum::body::Bytes;
 use axum::extract::ws::Message;
 use serde::{Deserialize, Serialize};
 use tokio::sync::broadcast;
@@ -25,7 +26,7 @@ use crate::config::Config;
 use crate::consensus::ConsensusEngine;
 use crate::state::StateManager;
 use crate::types::{Transaction, AssetAction, Hash, AssetPermission, PermissionLevel, hash_to_hex, address_to_hex};
-use crate::state::AssetState;
+use crate::state::{AssetState, AssetVersion};
 pub use crate::ws_events::WsEvent;
 
 // Use std::result::Result for API handlers to avoid conflict with crate::error::Result
@@ -44,6 +45,8 @@ pub struct WsSubscription {
     pub asset_id: Option<String>,
     pub owner: Option<String>,
     pub game_id: Option<String>,
+    /// pool_updated only
+    pub pool_id: Option<String>,
 }
 
 /// API state shared across handlers
@@ -55,6 +58,8 @@ pub struct ApiState {
     pub ws_tx: broadcast::Sender<WsEvent>,
     /// Shared counter of connected P2P peers (updated by network layer)
     pub connected_peers: Arc<std::sync::atomic::AtomicUsize>,
+    /// Blob store for Core density assets (shared, not re-opened per request)
+    pub blob_storage: Arc<BlobStorage>,
 }
 
 /// API response wrapper
@@ -83,6 +88,68 @@ impl<T> ApiResponse<T> {
     }
 }
 
+/// Content type of the compact binary encoding accepted by POST /api/v1/transactions (and
+/// /transactions/batch) and offered by the account and chain info endpoints. The body is
+/// bincode 1.x with default options, the same encoding the P2P layer uses for transactions:
+/// a request is one `Transaction` (or a `Vec<Transaction>` for a batch), a response is the
+/// `ApiResponse` envelope.
+pub const BINCODE_CONTENT_TYPE: &str = "application/x-haze-bincode";
+
+/// True if the request body is declared as bincode
+fn is_bincode_body(headers: &HeaderMap) -> bool {
+    headers
+        .get(header::CONTENT_TYPE)
+        .and_then(|v| v.to_str().ok())
+        .map(|v| v.trim_start().starts_with(BINCODE_CONTENT_TYPE))
+        .unwrap_or(false)
+}
+
+/// True if the client asked for a bincode response
+fn accepts_bincode(headers: &HeaderMap) -> bool {
+    headers
+        .get(header::ACCEPT)
+        .and_then(|v| v.to_str().ok())
+        .map(|v| v.contains(BINCODE_CONTENT_TYPE))
+        .unwrap_or(false)
+}
+
+/// Decode an untrusted bincode body. Same wire format as `bincode::deserialize`, but length
+/// prefixes cannot make the decoder allocate more than the body holds, and trailing bytes are
+/// an error.
+fn decode_bincode<T: serde::de::DeserializeOwned>(body: &[u8]) -> Result<T, String> {
+    use bincode::Options;
+    bincode::options()
+        .with_fixint_encoding()
+        .with_limit(body.len() as u64)
+        .reject_trailing_bytes()
+        .deserialize(body)
+        .map_err(|e| e.to_string())
+}
+
+/// Response envelope in the encoding the client negotiated (JSON unless it accepts bincode)
+pub struct Negotiated<T> {
+    binary: bool,
+    body: ApiResponse<T>,
+}
+
+impl<T> Negotiated<T> {
+    fn new(headers: &HeaderMap, body: ApiResponse<T>) -> Self {
+        Self { binary: accepts_bincode(headers), body }
+    }
+}
+
+impl<T: Serialize> IntoResponse for Negotiated<T> {
+    fn into_response(self) -> Response {
+        if !self.binary {
+            return Json(self.body).into_response();
+        }
+        match bincode::serialize(&self.body) {
+            Ok(bytes) => ([(header::CONTENT_TYPE, BINCODE_CONTENT_TYPE)], bytes).into_response(),
+            Err(_) => StatusCode::INTERNAL_SERVER_ERROR.into_response(),
+        }
+    }
+}
+
 /// Transaction request (accepts hex strings for byte fields in JSON)
 #[derive(Debug, Deserialize)]
 pub struct SendTransactionRequest {
@@ -90,6 +157,15 @@ pub struct SendTransactionRequest {
     pub transaction: Transaction,
 }
 
+/// Maximum number of transactions accepted by one batch request
+pub const MAX_TRANSACTION_BATCH: usize = 1000;
+
+/// Batch transaction request. Items are parsed one by one so a malformed entry
+/// only fails itself, not the whole batch.
+#[derive(Debug, Deserialize)]
+pub struct SendTransactionBatchRequest {
+    pub transactions: Vec<serde_json::Value>,
+}
 
 fn de_transaction_from_json<'de, D>(d: D) -> Result<Transaction, D::Error>
 where
@@ -324,6 +400,16 @@ pub struct TransactionResponse {
     pub status: String,
 }
 
+/// Per-item result of a batch submission (same order as the request)
+#[derive(Debug, Serialize)]
+pub struct BatchTransactionResult {
+    /// Transaction hash (absent if the item could not be parsed)
+    pub hash: Option<String>,
+    /// "pending" (added to pool), "rejected" (failed validation) or "invalid" (malformed)
+    pub status: String,
+    pub error: Option<String>,
+}
+
 /// Account info response
 #[derive(Debug, Serialize)]
 pub struct AccountInfo {
@@ -343,6 +429,23 @@ pub struct BlockInfo {
     pub validator: String,
     pub transaction_count: usize,
     pub wave_number: u64,
+    /// Transaction hashes in block order, so clients can match receipts per block
+    pub transactions: Vec<String>,
+}
+
+impl BlockInfo {
+    fn from_block(block: &crate::types::Block) -> Self {
+        Self {
+            hash: hash_to_hex(&block.header.hash),
+            parent_hash: hash_to_hex(&block.header.parent_hash),
+            height: block.header.height,
+            timestamp: block.header.timestamp,
+            validator: address_to_hex(&block.header.validator),
+            transaction_count: block.transactions.len(),
+            wave_number: block.header.wave_number,
+            transactions: block.transactions.iter().map(|tx| hash_to_hex(&tx.hash())).collect(),
+        }
+    }
 }
 
 /// Blockchain info response
@@ -359,6 +462,7 @@ pub struct BlockchainInfo {
 /// Create API router
 pub fn create_router(state: ApiState) -> Router {
     let enable_cors = state.config.api.enable_cors;
+    let enable_compression = state.config.api.enable_compression;
     
     let router = Router::new()
         .route("/health", get(health_check))
@@ -366,6 +470,7 @@ pub fn create_router(state: ApiState) -> Router {
         .route("/api/v1/metrics/basic", get(get_basic_metrics))
         .route("/api/v1/metrics/prometheus", get(get_prometheus_metrics))
         .route("/api/v1/transactions", post(send_transaction))
+        .route("/api/v1/transactions/batch", post(send_transaction_batch))
         .route("/api/v1/transactions/:hash", get(get_transaction))
         .route("/api/v1/blocks/:hash", get(get_block_by_hash))
         .route("/api/v1/blocks/height/:height", get(get_block_by_height))
@@ -373,6 +478,7 @@ pub fn create_router(state: ApiState) -> Router {
         .route("/api/v1/accounts/:address/balance", get(get_balance))
         .route("/api/v1/assets/:asset_id", get(get_asset))
         .route("/api/v1/assets/:asset_id/blob/:blob_key", get(get_asset_blob))
+        .route("/api/v1/assets/summaries", post(get_asset_summaries))
         .route("/api/v1/assets/:asset_id/history", get(get_asset_history))
         .route("/api/v1/assets/:asset_id/versions", get(get_asset_versions))
         .route("/api/v1/assets/:asset_id/versions/:version", get(get_asset_version))
@@ -384,10 +490,13 @@ pub fn create_router(state: ApiState) -> Router {
         .route("/api/v1/assets/:asset_id/merge", post(merge_assets))
         .route("/api/v1/assets/:asset_id/split", post(split_asset))
         .route("/api/v1/assets/estimate-gas", post(estimate_asset_gas))
+        .route("/api/v1/assets/gas-schedule", get(get_asset_gas_schedule))
         .route("/api/v1/assets/:asset_id/permissions", get(get_asset_permissions))
         .route("/api/v1/assets/:asset_id/permissions", post(set_asset_permissions))
         .route("/api/v1/assets/:asset_id/export", get(export_asset))
         .route("/api/v1/assets/import", post(import_asset))
+        .route("/api/v1/snapshots/assets", get(get_assets_snapshot))
+        .route("/api/v1/snapshots/assets/stale", post(get_stale_snapshot_entries))
         .route("/api/v1/economy/pools", get(get_liquidity_pools))
         .route("/api/v1/economy/pools", post(create_liquidity_pool))
         .route("/api/v1/economy/pools/:pool_id", get(get_liquidity_pool))
@@ -396,6 +505,12 @@ pub fn create_router(state: ApiState) -> Router {
         .route("/api/v1/sync/status", get(get_sync_status))
         .with_state(state);
     
+    let router = if enable_compression {
+        router.layer(axum::middleware::from_fn(compress_response))
+    } else {
+        router
+    };
+
     // Add CORS if enabled
     if enable_cors {
         router.layer(
@@ -409,6 +524,156 @@ pub fn create_router(state: ApiState) -> Router {
     }
 }
 
+/// Responses smaller than this are sent uncompressed; the envelope of a balance or
+/// transaction status is smaller than the gzip header overhead saves.
+pub const MIN_COMPRESS_SIZE: usize = 1024;
+
+/// Responses larger than this are sent uncompressed: the middleware buffers whatever it
+/// encodes, and a body this large is better paged or range-requested than held in memory.
+pub const MAX_COMPRESS_SIZE: usize = 8 * 1024 * 1024;
+
+/// Content codings the node compresses with
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum ContentCoding {
+    Gzip,
+    Zstd,
+}
+
+impl ContentCoding {
+    fn as_str(self) -> &'static str {
+        match self {
+            ContentCoding::Gzip => "gzip",
+            ContentCoding::Zstd => "zstd",
+        }
+    }
+
+    fn encode(self, data: &[u8]) -> std::io::Result<Vec<u8>> {
+        use std::io::Write;
+        match self {
+            ContentCoding::Gzip => {
+                let mut encoder = flate2::write::GzEncoder::new(Vec::with_capacity(data.len() / 4), flate2::Compression::default());
+                encoder.write_all(data)?;
+                encoder.finish()
+            }
+            ContentCoding::Zstd => zstd::stream::encode_all(data, 0),
+        }
+    }
+}
+
+/// The coding an Accept-Encoding header prefers: the highest q-value, zstd on a tie, None for identity
+fn preferred_coding(headers: &HeaderMap) -> Option<ContentCoding> {
+    let mut best: Option<(ContentCoding, f32)> = None;
+    for value in headers.get_all(header::ACCEPT_ENCODING) {
+        let Ok(value) = value.to_str() else { continue };
+        for item in value.split(',') {
+            let mut params = item.split(';');
+            let coding = match params.next().unwrap_or("").trim().to_ascii_lowercase().as_str() {
+                "gzip" | "x-gzip" => ContentCoding::Gzip,
+                "zstd" => ContentCoding::Zstd,
+                _ => continue,
+            };
+            let q = params
+                .find_map(|param| param.trim().strip_prefix("q=").and_then(|q| q.trim().parse::<f32>().ok()))
+                .unwrap_or(1.0);
+            if q <= 0.0 {
+                continue;
+            }
+            if best.map_or(true, |(_, best_q)| q > best_q || (q == best_q && coding == ContentCoding::Zstd)) {
+                best = Some((coding, q));
+            }
+        }
+    }
+    best.map(|(coding, _)| coding)
+}
+
+/// 2xx full bodies only (not WebSocket upgrades, errors or byte ranges), not already encoded,
+/// and not media that is compressed already. Raw blobs and binary snapshots
+/// (`application/octet-stream`) are skipped too: a Core blob runs to tens of megabytes, and
+/// the middleware would have to buffer it whole to encode it.
+fn is_compressible(response: &Response) -> bool {
+    let status = response.status();
+    let headers = response.headers();
+    if !status.is_success()
+        || status == StatusCode::PARTIAL_CONTENT
+        || headers.contains_key(header::CONTENT_RANGE)
+        || headers.contains_key(header::CONTENT_ENCODING)
+    {
+        return false;
+    }
+    let content_type = headers.get(header::CONTENT_TYPE).and_then(|v| v.to_str().ok()).unwrap_or("");
+    !(content_type.starts_with("image/") && content_type != "image/svg+xml")
+        && !content_type.starts_with("application/octet-stream")
+        && !content_type.starts_with("text/event-stream")
+        && !content_type.starts_with("application/grpc")
+}
+
+/// Size of the identity body: its Content-Length, or the exact size of a body built from
+/// bytes. None for a streamed body, which is never buffered.
+fn known_body_len(response: &Response) -> Option<usize> {
+    response
+        .headers()
+        .get(header::CONTENT_LENGTH)
+        .and_then(|v| v.to_str().ok())
+        .and_then(|v| v.parse::<u64>().ok())
+        .or_else(|| axum::body::HttpBody::size_hint(response.body()).exact())
+        .and_then(|len| usize::try_from(len).ok())
+}
+
+/// gzip/zstd for clients that send Accept-Encoding. Version history, exports and search
+/// pages are repetitive JSON and shrink several times over. Responses to Range requests are
+/// never compressed so resumed blob downloads keep byte offsets into the stored blob. Only
+/// bodies of known size between MIN_COMPRESS_SIZE and MAX_COMPRESS_SIZE are buffered and
+/// encoded, on the blocking pool so a large export does not stall the runtime.
+async fn compress_response(request: axum::extract::Request, next: axum::middleware::Next) -> Response {
+    let coding = preferred_coding(request.headers());
+    let ranged = request.headers().contains_key(header::RANGE);
+    let mut response = next.run(request).await;
+    let Some(coding) = coding else { return response };
+    if ranged || !is_compressible(&response) {
+        return response;
+    }
+
+    response.headers_mut().append(header::VARY, axum::http::HeaderValue::from_static("accept-encoding"));
+    let Some(len) = known_body_len(&response).filter(|len| (MIN_COMPRESS_SIZE..=MAX_COMPRESS_SIZE).contains(len)) else {
+        return response;
+    };
+    let (mut parts, body) = response.into_parts();
+    let Ok(bytes) = axum::body::to_bytes(body, len).await else {
+        return StatusCode::INTERNAL_SERVER_ERROR.into_response();
+    };
+
+    match tokio::task::spawn_blocking(move || coding.encode(&bytes).map_err(|_| bytes)).await {
+        Ok(Ok(encoded)) => {
+            // Lengths and ranges of the identity body no longer apply
+            parts.headers.remove(header::CONTENT_LENGTH);
+            parts.headers.remove(header::ACCEPT_RANGES);
+            // A strong tag names the identity bytes; the encoded body only matches it weakly
+            if let Some(weak) = parts
+                .headers
+                .get(header::ETAG)
+                .and_then(|v| v.to_str().ok())
+                .filter(|v| !v.starts_with("W/"))
+                .and_then(|v| axum::http::HeaderValue::from_str(&format!("W/{}", v)).ok())
+            {
+                parts.headers.insert(header::ETAG, weak);
+            }
+            parts.headers.insert(header::CONTENT_ENCODING, axum::http::HeaderValue::from_static(coding.as_str()));
+            Response::from_parts(parts, axum::body::Body::from(encoded))
+        }
+        Ok(Err(bytes)) => Response::from_parts(parts, axum::body::Body::from(bytes)),
+        Err(_) => StatusCode::INTERNAL_SERVER_ERROR.into_response(),
+    }
+}
+
+/// Whether If-None-Match lists `etag`. The comparison is weak (RFC 9110 13.1.2), so a `W/` tag
+/// handed out on a compressed body still revalidates.
+fn if_none_match(headers: &HeaderMap, etag: &str) -> bool {
+    headers
+        .get(header::IF_NONE_MATCH)
+        .and_then(|v| v.to_str().ok())
+        .is_some_and(|v| v.split(',').map(str::trim).any(|tag| tag == "*" || tag.trim_start_matches("W/") == etag))
+}
+
 /// Health check endpoint
 async fn health_check() -> Json<ApiResponse<&'static str>> {
     Json(ApiResponse::success("OK"))
@@ -417,15 +682,16 @@ async fn health_check() -> Json<ApiResponse<&'static str>> {
 /// Get blockchain info
 async fn get_blockchain_info(
     State(api_state): State<ApiState>,
-) -> ApiResult<Json<ApiResponse<BlockchainInfo>>> {
+    headers: HeaderMap,
+) -> ApiResult<Negotiated<BlockchainInfo>> {
     let height = api_state.state.current_height();
     let total_supply = api_state.state.tokenomics().total_supply();
     
     // Get current wave from consensus
     let current_wave = api_state.consensus.get_current_wave();
     
-    // Compute state root
-    let state_root = api_state.state.compute_state_root();
+    // State root, cached per applied block
+    let (_, state_root) = current_state_root(&api_state).await?;
     
     // Get finalized checkpoint info
     let last_finalized_height = api_state.consensus.get_last_finalized_height();
@@ -440,18 +706,28 @@ async fn get_blockchain_info(
         last_finalized_wave,
     };
     
-    Ok(Json(ApiResponse::success(info)))
+    Ok(Negotiated::new(&headers, ApiResponse::success(info)))
 }
 
 /// Send transaction
+///
+/// The body is `{"transaction": ...}` JSON, or a bare bincode `Transaction` when the
+/// Content-Type is BINCODE_CONTENT_TYPE. The response follows the Accept header.
 async fn send_transaction(
     State(api_state): State<ApiState>,
-    Json(request): Json<SendTransactionRequest>,
-) -> ApiResult<Json<ApiResponse<TransactionResponse>>> {
-    let tx = request.transaction;
+    headers: HeaderMap,
+    body: Bytes,
+) -> ApiResult<Negotiated<TransactionResponse>> {
+    let tx = if is_bincode_body(&headers) {
+        decode_bincode::<Transaction>(&body).map_err(|_| StatusCode::BAD_REQUEST)?
+    } else {
+        serde_json::from_slice::<SendTransactionRequest>(&body)
+            .map_err(|_| StatusCode::BAD_REQUEST)?
+            .transaction
+    };
     let tx_hash = tx.hash();
     
-    match api_state.consensus.add_transaction(tx.clone()) {
+    match api_state.consensus.add_transaction(tx) {
         Ok(()) => {
             // Broadcast transaction to network (async, don't wait)
             // For now, transactions will be broadcast when blocks are created
@@ -462,7 +738,7 @@ async fn send_transaction(
                 hash: hash_to_hex(&tx_hash),
                 status: "pending".to_string(),
             };
-            Ok(Json(ApiResponse::success(response)))
+            Ok(Negotiated::new(&headers, ApiResponse::success(response)))
         }
         Err(_e) => {
             Err(StatusCode::BAD_REQUEST)
@@ -470,6 +746,78 @@ async fn send_transaction(
     }
 }
 
+/// Add one decoded batch item to the pool
+fn submit_batch_item(consensus: &ConsensusEngine, item: Result<Transaction, String>) -> BatchTransactionResult {
+    match item {
+        Ok(tx) => {
+            let hash = Some(hash_to_hex(&tx.hash()));
+            match consensus.add_transaction(tx) {
+                Ok(()) => BatchTransactionResult {
+                    hash,
+                    status: "pending".to_string(),
+                    error: None,
+                },
+                Err(e) => BatchTransactionResult {
+                    hash,
+                    status: "rejected".to_string(),
+                    error: Some(e.to_string()),
+                },
+            }
+        }
+        Err(e) => BatchTransactionResult {
+            hash: None,
+            status: "invalid".to_string(),
+            error: Some(e),
+        },
+    }
+}
+
+/// Send a batch of transactions
+///
+/// Items are added to the pool in request order, so consecutive nonces from one
+/// sender can share a batch. The request fails only if it is empty or larger
+/// than MAX_TRANSACTION_BATCH; otherwise every item gets its own result.
+/// A bincode body is a `Vec<Transaction>` and must decode as a whole.
+async fn send_transaction_batch(
+    State(api_state): State<ApiState>,
+    headers: HeaderMap,
+    body: Bytes,
+) -> ApiResult<Negotiated<Vec<BatchTransactionResult>>> {
+    let items: Vec<Result<Transaction, String>> = if is_bincode_body(&headers) {
+        decode_bincode::<Vec<Transaction>>(&body)
+            .map_err(|_| StatusCode::BAD_REQUEST)?
+            .into_iter()
+            .map(Ok)
+            .collect()
+    } else {
+        let request = serde_json::from_slice::<SendTransactionBatchRequest>(&body)
+            .map_err(|_| StatusCode::BAD_REQUEST)?;
+        if request.transactions.len() > MAX_TRANSACTION_BATCH {
+            return Err(StatusCode::BAD_REQUEST);
+        }
+        request.transactions.iter().map(parse_transaction_from_value).collect()
+    };
+    if items.is_empty() || items.len() > MAX_TRANSACTION_BATCH {
+        return Err(StatusCode::BAD_REQUEST);
+    }
+
+    // Signature checks for hundreds of transactions would stall the async runtime
+    let consensus = api_state.consensus.clone();
+    let results = tokio::task::spawn_blocking(move || {
+        items
+            .into_iter()
+            .map(|item| submit_batch_item(&consensus, item))
+            .collect::<Vec<_>>()
+    })
+    .await
+    .map_err(|_| StatusCode::INTERNAL_SERVER_ERROR)?;
+
+    let accepted = results.iter().filter(|r| r.status == "pending").count();
+    tracing::debug!("Batch: {} of {} transactions added to pool", accepted, results.len());
+
+    Ok(Negotiated::new(&headers, ApiResponse::success(results)))
+}
+
 /// Get transaction by hash
 async fn get_transaction(
     State(api_state): State<ApiState>,
@@ -515,16 +863,7 @@ async fn get_block_by_hash(
         .ok_or(StatusCode::BAD_REQUEST)?;
     
     if let Some(block) = api_state.state.get_block(&hash) {
-        let info = BlockInfo {
-            hash: hash_to_hex(&block.header.hash),
-            parent_hash: hash_to_hex(&block.header.parent_hash),
-            height: block.header.height,
-            timestamp: block.header.timestamp,
-            validator: address_to_hex(&block.header.validator),
-            transaction_count: block.transactions.len(),
-            wave_number: block.header.wave_number,
-        };
-        Ok(Json(ApiResponse::success(info)))
+        Ok(Json(ApiResponse::success(BlockInfo::from_block(&block))))
     } else {
         Err(StatusCode::NOT_FOUND)
     }
@@ -536,16 +875,7 @@ async fn get_block_by_height(
     Path(height): Path<u64>,
 ) -> ApiResult<Json<ApiResponse<BlockInfo>>> {
     if let Some(block) = api_state.state.get_block_by_height(height) {
-        let info = BlockInfo {
-            hash: hash_to_hex(&block.header.hash),
-            parent_hash: hash_to_hex(&block.header.parent_hash),
-            height: block.header.height,
-            timestamp: block.header.timestamp,
-            validator: address_to_hex(&block.header.validator),
-            transaction_count: block.transactions.len(),
-            wave_number: block.header.wave_number,
-        };
-        Ok(Json(ApiResponse::success(info)))
+        Ok(Json(ApiResponse::success(BlockInfo::from_block(&block))))
     } else {
         Err(StatusCode::NOT_FOUND)
     }
@@ -555,7 +885,8 @@ async fn get_block_by_height(
 async fn get_account(
     State(api_state): State<ApiState>,
     Path(address_str): Path<String>,
-) -> ApiResult<Json<ApiResponse<AccountInfo>>> {
+    headers: HeaderMap,
+) -> ApiResult<Negotiated<AccountInfo>> {
     let address = crate::types::hex_to_address(&address_str)
         .ok_or(StatusCode::BAD_REQUEST)?;
     
@@ -566,7 +897,7 @@ async fn get_account(
             nonce: account.nonce,
             staked: account.staked,
         };
-        Ok(Json(ApiResponse::success(info)))
+        Ok(Negotiated::new(&headers, ApiResponse::success(info)))
     } else {
         Err(StatusCode::NOT_FOUND)
     }
@@ -576,25 +907,85 @@ async fn get_account(
 async fn get_balance(
     State(api_state): State<ApiState>,
     Path(address_str): Path<String>,
-) -> ApiResult<Json<ApiResponse<u64>>> {
+    headers: HeaderMap,
+) -> ApiResult<Negotiated<u64>> {
     let address = crate::types::hex_to_address(&address_str)
         .ok_or(StatusCode::BAD_REQUEST)?;
     
-    if let Some(account) = api_state.state.get_account(&address) {
-        Ok(Json(ApiResponse::success(account.balance)))
-    } else {
-        Ok(Json(ApiResponse::success(0))) // New account has 0 balance
+    // New account has 0 balance
+    let balance = api_state.state.get_account(&address).map_or(0, |account| account.balance);
+    Ok(Negotiated::new(&headers, ApiResponse::success(balance)))
+}
+
+/// Get asset query parameters
+#[derive(Debug, Deserialize)]
+pub struct AssetViewQuery {
+    /// "summary" returns `asset_summary_json` (Ethereal-sized) instead of the full asset
+    pub view: Option<String>,
+}
+
+/// Maximum number of assets in one summaries request
+pub const MAX_ASSET_SUMMARY_BATCH: usize = 256;
+
+/// Batch asset summary request
+#[derive(Debug, Deserialize)]
+pub struct AssetSummariesRequest {
+    pub asset_ids: Vec<String>,
+}
+
+/// Lightweight view of an asset for clients that load assets progressively: identity, density,
+/// blob references and as much metadata as fits the Ethereal budget (5KB, smallest keys first).
+/// `metadata_bytes` is the size of the full metadata so clients can budget the full fetch.
+fn asset_summary_json(asset_id: &Hash, asset_state: &AssetState) -> serde_json::Value {
+    let budget = crate::types::DensityLevel::Ethereal.max_size();
+    let mut entries: Vec<(&String, &String)> = asset_state.data.metadata.iter().collect();
+    entries.sort_by(|a, b| (a.0.len() + a.1.len()).cmp(&(b.0.len() + b.1.len())).then(a.0.cmp(b.0)));
+
+    let mut metadata = serde_json::Map::new();
+    let mut used = 0usize;
+    let mut total = 0usize;
+    for (key, value) in entries {
+        let size = key.len() + value.len();
+        total += size;
+        if used + size <= budget {
+            used += size;
+            metadata.insert(key.clone(), serde_json::Value::String(value.clone()));
+        }
     }
+
+    let blob_refs_json: std::collections::HashMap<String, String> = asset_state.blob_refs.iter()
+        .map(|(k, v)| (k.clone(), hex::encode(v)))
+        .collect();
+    serde_json::json!({
+        "asset_id": hash_to_hex(asset_id),
+        "owner": address_to_hex(&asset_state.owner),
+        "density": format!("{:?}", asset_state.data.density),
+        "game_id": asset_state.data.game_id,
+        "created_at": asset_state.created_at,
+        "updated_at": asset_state.updated_at,
+        "current_version": asset_state.current_version,
+        "metadata": metadata,
+        "metadata_bytes": total,
+        "metadata_truncated": used < total,
+        "attribute_count": asset_state.data.attributes.len(),
+        "blob_refs": blob_refs_json,
+    })
 }
 
 /// Get asset info
 async fn get_asset(
     State(api_state): State<ApiState>,
     Path(asset_id_str): Path<String>,
+    axum::extract::Query(query): axum::extract::Query<AssetViewQuery>,
 ) -> ApiResult<Json<ApiResponse<serde_json::Value>>> {
     let asset_id = crate::types::hex_to_hash(&asset_id_str)
         .ok_or(StatusCode::BAD_REQUEST)?;
     
+    if query.view.as_deref() == Some("summary") {
+        let asset_state = api_state.state.get_asset_lightweight(&asset_id).ok_or(StatusCode::NOT_FOUND)?;
+        return Ok(Json(ApiResponse::success(asset_summary_json(&asset_id, &asset_state))));
+    }
+    
     if let Some(asset_state) = api_state.state.get_asset(&asset_id) {
         // Convert blob_refs to hex strings for JSON
         let blob_refs_json: std::collections::HashMap<String, String> = asset_state.blob_refs.iter()
@@ -629,26 +1020,137 @@ async fn get_asset(
     }
 }
 
+/// Summaries for many assets in one request (see `asset_summary_json`). The result has one entry
+/// per requested id, in order; unknown or malformed ids are `null`.
+async fn get_asset_summaries(
+    State(api_state): State<ApiState>,
+    Json(request): Json<AssetSummariesRequest>,
+) -> ApiResult<Json<ApiResponse<Vec<serde_json::Value>>>> {
+    if request.asset_ids.len() > MAX_ASSET_SUMMARY_BATCH {
+        return Err(StatusCode::BAD_REQUEST);
+    }
+    let summaries = request.asset_ids.iter()
+        .map(|id| {
+            crate::types::hex_to_hash(id)
+                .and_then(|asset_id| {
+                    api_state.state.get_asset_lightweight(&asset_id)
+                        .map(|asset_state| asset_summary_json(&asset_id, &asset_state))
+                })
+                .unwrap_or(serde_json::Value::Null)
+        })
+        .collect();
+    Ok(Json(ApiResponse::success(summaries)))
+}
+
+/// Parse a single-range `Range: bytes=...` header against a blob of `len` bytes.
+/// Returns `Ok(None)` when the header should be ignored (not a byte range, or several ranges),
+/// `Ok(Some((start, end)))` with an inclusive end, or `Err(())` when the range is unsatisfiable.
+fn parse_byte_range(value: &str, len: u64) -> std::result::Result<Option<(u64, u64)>, ()> {
+    let spec = match value.trim().strip_prefix("bytes=") {
+        Some(spec) if !spec.contains(',') => spec.trim(),
+        _ => return Ok(None),
+    };
+    let (first, last) = match spec.split_once('-') {
+        Some(parts) => parts,
+        None => return Ok(None),
+    };
+    let (first, last) = (first.trim(), last.trim());
+
+    if first.is_empty() {
+        // Suffix range: the last N bytes
+        let suffix: u64 = last.parse().map_err(|_| ())?;
+        if suffix == 0 || len == 0 {
+            return Err(());
+        }
+        return Ok(Some((len.saturating_sub(suffix), len - 1)));
+    }
+
+    let start: u64 = first.parse().map_err(|_| ())?;
+    if start >= len {
+        return Err(());
+    }
+    let end = if last.is_empty() {
+        len - 1
+    } else {
+        let end: u64 = last.parse().map_err(|_| ())?;
+        if end < start {
+            return Err(());
+        }
+        end.min(len - 1)
+    };
+    Ok(Some((start, end)))
+}
+
 /// Get blob data for an asset by blob key (Core density). Returns raw bytes.
+///
+/// Supports single byte ranges (`Range: bytes=start-end`, answered with 206) so clients can fetch
+/// large blobs in pieces and resume interrupted downloads. The ETag is the blob's SHA-256 from
+/// `blob_refs`; a mismatching `If-Range` returns the whole blob.
 async fn get_asset_blob(
     State(api_state): State<ApiState>,
     Path((asset_id_str, blob_key)): Path<(String, String)>,
-) -> ApiResult<impl axum::response::IntoResponse> {
+    headers: axum::http::HeaderMap,
+) -> ApiResult<axum::response::Response> {
     let asset_id = crate::types::hex_to_hash(&asset_id_str).ok_or(StatusCode::BAD_REQUEST)?;
     let asset_state = api_state.state.get_asset(&asset_id).ok_or(StatusCode::NOT_FOUND)?;
-    let blob_hash = asset_state.blob_refs.get(&blob_key).ok_or(StatusCode::NOT_FOUND)?;
-    let blob_storage = BlobStorage::new(&api_state.config).map_err(|_| StatusCode::INTERNAL_SERVER_ERROR)?;
-    let data = blob_storage.get_blob(&blob_key, blob_hash).map_err(|_| StatusCode::NOT_FOUND)?;
-    Ok((
-        [(axum::http::header::CONTENT_TYPE, "application/octet-stream")],
+    let blob_hash = *asset_state.blob_refs.get(&blob_key).ok_or(StatusCode::NOT_FOUND)?;
+    let etag = format!("\"{}\"", hash_to_hex(&blob_hash));
+
+    let range_header = headers
+        .get(header::RANGE)
+        .and_then(|v| v.to_str().ok())
+        .map(str::to_string);
+    let if_range_matches = headers
+        .get(header::IF_RANGE)
+        .and_then(|v| v.to_str().ok())
+        .map_or(true, |v| v.trim() == etag);
+
+    let blob_storage = api_state.blob_storage.clone();
+    let (status, content_range, data) = tokio::task::spawn_blocking(move || -> ApiResult<(StatusCode, Option<String>, Vec<u8>)> {
+        let len = blob_storage.blob_len(&blob_key, &blob_hash).map_err(|_| StatusCode::NOT_FOUND)?;
+        let range = match range_header.filter(|_| if_range_matches) {
+            Some(value) => parse_byte_range(&value, len),
+            None => Ok(None),
+        };
+        match range {
+            Err(()) => Ok((StatusCode::RANGE_NOT_SATISFIABLE, Some(format!("bytes */{}", len)), Vec::new())),
+            Ok(Some((start, end))) => {
+                let data = blob_storage
+                    .read_blob_range(&blob_key, &blob_hash, start, end - start + 1)
+                    .map_err(|_| StatusCode::INTERNAL_SERVER_ERROR)?;
+                Ok((StatusCode::PARTIAL_CONTENT, Some(format!("bytes {}-{}/{}", start, end, len)), data))
+            }
+            Ok(None) => {
+                let data = blob_storage.get_blob(&blob_key, &blob_hash).map_err(|_| StatusCode::NOT_FOUND)?;
+                Ok((StatusCode::OK, None, data))
+            }
+        }
+    })
+    .await
+    .map_err(|_| StatusCode::INTERNAL_SERVER_ERROR)??;
+
+    let mut response = (
+        status,
+        [
+            (header::CONTENT_TYPE, "application/octet-stream".to_string()),
+            (header::ACCEPT_RANGES, "bytes".to_string()),
+            (header::ETAG, etag),
+        ],
         data,
-    ))
+    )
+        .into_response();
+    if let Some(content_range) = content_range.and_then(|v| axum::http::HeaderValue::from_str(&v).ok()) {
+        response.headers_mut().insert(header::CONTENT_RANGE, content_range);
+    }
+    Ok(response)
 }
 
 /// Get asset history query parameters
 #[derive(Debug, Deserialize)]
 pub struct AssetHistoryQuery {
     pub limit: Option<usize>,
+    /// First history index the client does not have yet; switches the response to `{ first_index, next_index, entries }`
+    pub since: Option<u64>,
 }
 
 /// Create asset snapshot
@@ -672,36 +1174,88 @@ async fn create_asset_snapshot(
     }
 }
 
+/// Get asset versions query parameters
+#[derive(Debug, Deserialize)]
+pub struct AssetVersionsQuery {
+    /// Newest version the client already has: only later versions are returned, with blob refs as a delta
+    pub since: Option<u64>,
+}
+
+/// JSON for one asset version, with its full blob refs
+fn asset_version_json(version: &AssetVersion) -> serde_json::Value {
+    let blob_refs_json: std::collections::HashMap<String, String> = version.blob_refs.iter()
+        .map(|(k, h)| (k.clone(), hex::encode(h)))
+        .collect();
+    serde_json::json!({
+        "version": version.version,
+        "timestamp": version.timestamp,
+        "density": format!("{:?}", version.data.density),
+        "metadata": version.data.metadata,
+        "attributes": version.data.attributes,
+        "game_id": version.data.game_id,
+        "blob_refs": blob_refs_json,
+    })
+}
+
+/// `asset_version_json` with blob refs relative to `base` (the number and blob refs of the version the client
+/// already has): `blob_refs` lists only keys that are new or point at another blob and `removed_blob_refs` the
+/// keys that are gone, so unchanged blob refs are not sent again. `blob_refs_base` names that version; 0 means
+/// there was none and `blob_refs` is the full map.
+fn asset_version_delta_json(version: &AssetVersion, base: Option<(u64, &std::collections::HashMap<String, Hash>)>) -> serde_json::Value {
+    let mut json = asset_version_json(version);
+    let Some((base_version, base_refs)) = base else {
+        json["blob_refs_base"] = serde_json::json!(0);
+        json["removed_blob_refs"] = serde_json::json!([]);
+        return json;
+    };
+    let changed: std::collections::HashMap<String, String> = version.blob_refs.iter()
+        .filter(|(k, h)| base_refs.get(*k) != Some(*h))
+        .map(|(k, h)| (k.clone(), hex::encode(h)))
+        .collect();
+    let mut removed: Vec<&String> = base_refs.keys().filter(|k| !version.blob_refs.contains_key(*k)).collect();
+    removed.sort();
+    json["blob_refs"] = serde_json::json!(changed);
+    json["blob_refs_base"] = serde_json::json!(base_version);
+    json["removed_blob_refs"] = serde_json::json!(removed);
+    json
+}
+
 /// Get asset versions
+///
+/// Without `since`: every stored version with full blob refs. With `?since=N`: `{ since, current_version,
+/// versions }` holding only versions after N, each with its blob refs relative to the version before it
+/// (version N for the first, when the node still stores it).
 async fn get_asset_versions(
     State(api_state): State<ApiState>,
     Path(asset_id_str): Path<String>,
-) -> ApiResult<Json<ApiResponse<Vec<serde_json::Value>>>> {
+    axum::extract::Query(query): axum::extract::Query<AssetVersionsQuery>,
+) -> ApiResult<Json<ApiResponse<serde_json::Value>>> {
     let asset_id = crate::types::hex_to_hash(&asset_id_str)
         .ok_or(StatusCode::BAD_REQUEST)?;
-    
-    if let Some(versions) = api_state.state.get_asset_versions(&asset_id) {
+
+    let Some(since) = query.since else {
+        let versions = api_state.state.get_asset_versions(&asset_id).ok_or(StatusCode::NOT_FOUND)?;
         let versions_json: Vec<serde_json::Value> = versions.iter()
-            .map(|v| {
-                let blob_refs_json: std::collections::HashMap<String, String> = v.blob_refs.iter()
-                    .map(|(k, h)| (k.clone(), hex::encode(h)))
-                    .collect();
-                
-                serde_json::json!({
-                    "version": v.version,
-                    "timestamp": v.timestamp,
-                    "density": format!("{:?}", v.data.density),
-                    "metadata": v.data.metadata,
-                    "attributes": v.data.attributes,
-                    "game_id": v.data.game_id,
-                    "blob_refs": blob_refs_json,
-                })
-            })
+            .map(asset_version_json)
             .collect();
-        Ok(Json(ApiResponse::success(versions_json)))
-    } else {
-        Err(StatusCode::NOT_FOUND)
+        return Ok(Json(ApiResponse::success(serde_json::Value::Array(versions_json))));
+    };
+
+    let versions = api_state.state.get_asset_versions_since(&asset_id, since).ok_or(StatusCode::NOT_FOUND)?;
+    let known = if since > 0 { api_state.state.get_asset_version(&asset_id, since) } else { None };
+    let current_version = api_state.state.get_asset(&asset_id).map(|a| a.current_version).unwrap_or(since);
+
+    let mut previous = known.as_ref();
+    let mut versions_json = Vec::with_capacity(versions.len());
+    for v in &versions {
+        versions_json.push(asset_version_delta_json(v, previous.map(|p| (p.version, &p.blob_refs))));
+        previous = Some(v);
     }
+    Ok(Json(ApiResponse::success(serde_json::json!({
+        "since": since,
+        "current_version": current_version,
+        "versions": versions_json,
+    }))))
 }
 
 /// Get asset version by version number
@@ -716,51 +1270,52 @@ async fn get_asset_version(
         .map_err(|_| StatusCode::BAD_REQUEST)?;
     
     if let Some(asset_version) = api_state.state.get_asset_version(&asset_id, version) {
-        let blob_refs_json: std::collections::HashMap<String, String> = asset_version.blob_refs.iter()
-            .map(|(k, h)| (k.clone(), hex::encode(h)))
-            .collect();
-        
-        let version_json = serde_json::json!({
-            "asset_id": hash_to_hex(&asset_id),
-            "version": asset_version.version,
-            "timestamp": asset_version.timestamp,
-            "density": format!("{:?}", asset_version.data.density),
-            "metadata": asset_version.data.metadata,
-            "attributes": asset_version.data.attributes,
-            "game_id": asset_version.data.game_id,
-            "blob_refs": blob_refs_json,
-        });
+        let mut version_json = asset_version_json(&asset_version);
+        version_json["asset_id"] = serde_json::json!(hash_to_hex(&asset_id));
         Ok(Json(ApiResponse::success(version_json)))
     } else {
         Err(StatusCode::NOT_FOUND)
     }
 }
 
+/// JSON for one history entry
+fn asset_history_json(entry: &crate::state::AssetHistoryEntry) -> serde_json::Value {
+    serde_json::json!({
+        "timestamp": entry.timestamp,
+        "action": format!("{:?}", entry.action),
+        "changes": entry.changes,
+    })
+}
+
 /// Get asset history
+///
+/// Without `since`: the last `limit` entries (0 = all). With `?since=N`: up to `limit` entries from history index N
+/// on, oldest first, as `{ first_index, next_index, entries }`. Indexes count every entry ever recorded; a
+/// `first_index` above N means the entries in between were dropped by the 100-entry limit. Poll again with
+/// `since=next_index`.
 async fn get_asset_history(
     State(api_state): State<ApiState>,
     Path(asset_id_str): Path<String>,
     axum::extract::Query(query): axum::extract::Query<AssetHistoryQuery>,
-) -> ApiResult<Json<ApiResponse<Vec<serde_json::Value>>>> {
+) -> ApiResult<Json<ApiResponse<serde_json::Value>>> {
     let asset_id = crate::types::hex_to_hash(&asset_id_str)
         .ok_or(StatusCode::BAD_REQUEST)?;
     
     let limit = query.limit.unwrap_or(0); // 0 = all
-    
-    if let Some(history) = api_state.state.get_asset_history(&asset_id, limit) {
-        let history_json: Vec<serde_json::Value> = history.iter()
-            .map(|entry| {
-                serde_json::json!({
-                    "timestamp": entry.timestamp,
-                    "action": format!("{:?}", entry.action),
-                    "changes": entry.changes,
-                })
-            })
-            .collect();
-        Ok(Json(ApiResponse::success(history_json)))
-    } else {
-        Err(StatusCode::NOT_FOUND)
-    }
+
+    let Some(since) = query.since else {
+        let history = api_state.state.get_asset_history(&asset_id, limit).ok_or(StatusCode::NOT_FOUND)?;
+        let history_json: Vec<serde_json::Value> = history.iter().map(asset_history_json).collect();
+        return Ok(Json(ApiResponse::success(serde_json::Value::Array(history_json))));
+    };
+
+    let (first_index, entries) = api_state.state.get_asset_history_since(&asset_id, since, limit).ok_or(StatusCode::NOT_FOUND)?;
+    let entries_json: Vec<serde_json::Value> = entries.iter().map(asset_history_json).collect();
+    Ok(Json(ApiResponse::success(serde_json::json!({
+        "first_index": first_index,
+        "next_index": first_index + entries.len() as u64,
+        "entries": entries_json,
+    }))))
 }
 
 /// Create asset
@@ -810,6 +1365,8 @@ pub struct SearchAssetsQuery {
     pub sort_order: Option<String>, // asc, desc
     pub limit: Option<usize>,
     pub offset: Option<usize>,
+    /// "summary" returns `asset_summary_json` entries instead of full assets
+    pub view: Option<String>,
 }
 
 /// Condense asset (increase density)
@@ -1007,6 +1564,8 @@ pub struct GasEstimateResponse {
     pub gas_cost: u64,
     pub gas_fee: u64,
     pub gas_price: u64,
+    /// `version` of the gas schedule the estimate was priced with
+    pub schedule_version: u64,
 }
 
 async fn estimate_asset_gas(
@@ -1036,9 +1595,26 @@ async fn estimate_asset_gas(
         gas_cost,
         gas_fee,
         gas_price: api_state.config.vm.gas_price,
+        schedule_version: crate::assets::AssetGasSchedule::from_config(&api_state.config).version,
     })))
 }
 
+/// Get the asset gas schedule
+///
+/// The constants `estimate-gas` prices with, so clients can run the same formulas locally. The ETag is the
+/// schedule version: a client that sends it back as `If-None-Match` gets 304 with no body until it changes.
+async fn get_asset_gas_schedule(
+    State(api_state): State<ApiState>,
+    headers: HeaderMap,
+) -> Response {
+    let schedule = crate::assets::AssetGasSchedule::from_config(&api_state.config);
+    let etag = format!("\"{}\"", schedule.version);
+    if if_none_match(&headers, &etag) {
+        return (StatusCode::NOT_MODIFIED, [(header::ETAG, etag)]).into_response();
+    }
+    ([(header::ETAG, etag)], Json(ApiResponse::success(schedule))).into_response()
+}
+
 /// Get asset permissions
 async fn get_asset_permissions(
     State(api_state): State<ApiState>,
@@ -1283,6 +1859,129 @@ async fn import_asset(
     }
 }
 
+/// Asset snapshot query parameters: the assets of one owner, or of one game
+#[derive(Debug, Deserialize)]
+pub struct AssetSnapshotQuery {
+    pub owner: Option<String>,
+    pub game_id: Option<String>,
+}
+
+/// State root and the height it was taken at. Hashing the whole state is only done once per
+/// applied block, off the async workers; every other request reads the cached root.
+async fn current_state_root(api_state: &ApiState) -> ApiResult<(u64, Hash)> {
+    if let Some(cached) = api_state.state.cached_state_root() {
+        return Ok(cached);
+    }
+    let state = api_state.state.clone();
+    tokio::task::spawn_blocking(move || state.state_root())
+        .await
+        .map_err(|_| StatusCode::INTERNAL_SERVER_ERROR)
+}
+
+/// Binary snapshot (`crate::asset_snapshot`) of an owner's or a game's assets, for clients that
+/// memory-map it at startup instead of fetching each asset. The ETag is the snapshot's state root.
+async fn get_assets_snapshot(
+    State(api_state): State<ApiState>,
+    axum::extract::Query(query): axum::extract::Query<AssetSnapshotQuery>,
+    headers: HeaderMap,
+) -> ApiResult<Response> {
+    // Root and height first: assets read afterwards are at least as new as the header says
+    let (height, state_root) = current_state_root(&api_state).await?;
+    let etag = format!("\"{}\"", hash_to_hex(&state_root));
+    if if_none_match(&headers, &etag) {
+        return Ok((StatusCode::NOT_MODIFIED, [(header::ETAG, etag)]).into_response());
+    }
+
+    let asset_ids = if let Some(ref owner) = query.owner {
+        let owner = crate::types::hex_to_address(owner).ok_or(StatusCode::BAD_REQUEST)?;
+        api_state.state.search_assets_by_owner(&owner)
+    } else if let Some(ref game_id) = query.game_id {
+        api_state.state.search_assets_by_game_id(game_id)
+    } else {
+        return Err(StatusCode::BAD_REQUEST);
+    };
+    let assets: Vec<(Hash, AssetState)> = asset_ids
+        .iter()
+        .filter_map(|id| api_state.state.get_asset(id).map(|state| (*id, state)))
+        .filter(|(_, state)| query.game_id.as_ref().map_or(true, |g| state.data.game_id.as_ref() == Some(g)))
+        .collect();
+
+    let bytes = tokio::task::spawn_blocking(move || {
+        crate::asset_snapshot::write_asset_snapshot(&assets, height, &state_root, chrono::Utc::now().timestamp())
+    })
+    .await
+    .map_err(|_| StatusCode::INTERNAL_SERVER_ERROR)?;
+    Ok((
+        [
+            (header::CONTENT_TYPE, "application/octet-stream".to_string()),
+            (header::ETAG, etag),
+        ],
+        bytes,
+    )
+        .into_response())
+}
+
+/// Maximum number of entries in one snapshot staleness check
+pub const MAX_SNAPSHOT_STALE_BATCH: usize = 1024;
+
+/// One snapshot entry as the client holds it
+#[derive(Debug, Deserialize)]
+pub struct SnapshotEntryRequest {
+    pub asset_id: String,
+    /// `asset_fingerprint` in 16 hex digits
+    pub fingerprint: String,
+}
+
+#[derive(Debug, Deserialize)]
+pub struct SnapshotStaleRequest {
+    pub assets: Vec<SnapshotEntryRequest>,
+}
+
+/// A snapshot entry that no longer matches the chain
+#[derive(Debug, Serialize)]
+pub struct SnapshotStaleEntry {
+    pub asset_id: String,
+    /// Current fingerprint; `None` if the asset no longer exists
+    pub fingerprint: Option<String>,
+}
+
+#[derive(Debug, Serialize)]
+pub struct SnapshotStaleResponse {
+    pub state_root: String,
+    pub current_height: u64,
+    pub stale: Vec<SnapshotStaleEntry>,
+}
+
+/// Which of a snapshot's entries changed since it was taken, so a client refetches only those.
+/// Malformed ids and fingerprints are reported stale.
+async fn get_stale_snapshot_entries(
+    State(api_state): State<ApiState>,
+    Json(request): Json<SnapshotStaleRequest>,
+) -> ApiResult<Json<ApiResponse<SnapshotStaleResponse>>> {
+    if request.assets.len() > MAX_SNAPSHOT_STALE_BATCH {
+        return Err(StatusCode::BAD_REQUEST);
+    }
+    let (current_height, state_root) = current_state_root(&api_state).await?;
+    let stale = request.assets.into_iter()
+        .filter_map(|entry| {
+            let current = crate::types::hex_to_hash(&entry.asset_id).and_then(|asset_id| {
+                api_state.state.get_asset(&asset_id)
+                    .map(|asset_state| crate::asset_snapshot::asset_fingerprint(&asset_id, &asset_state))
+            });
+            let held = crate::asset_snapshot::fingerprint_from_hex(&entry.fingerprint);
+            (current.is_none() || current != held).then(|| SnapshotStaleEntry {
+                asset_id: entry.asset_id,
+                fingerprint: current.map(crate::asset_snapshot::fingerprint_to_hex),
+            })
+        })
+        .collect();
+    Ok(Json(ApiResponse::success(SnapshotStaleResponse {
+        state_root: hash_to_hex(&state_root),
+        current_height,
+        stale,
+    })))
+}
+
 /// Search assets
 async fn search_assets(
     State(api_state): State<ApiState>,
@@ -1290,24 +1989,24 @@ async fn search_assets(
 ) -> ApiResult<Json<ApiResponse<Vec<serde_json::Value>>>> {
     let limit = query.limit.unwrap_or(100).min(1000);
     let offset = query.offset.unwrap_or(0);
+    let density_filter = match query.density.as_deref() {
+        None => None,
+        Some("Ethereal") => Some(crate::types::DensityLevel::Ethereal),
+        Some("Light") => Some(crate::types::DensityLevel::Light),
+        Some("Dense") => Some(crate::types::DensityLevel::Dense),
+        Some("Core") => Some(crate::types::DensityLevel::Core),
+        Some(_) => return Err(StatusCode::BAD_REQUEST),
+    };
     let mut candidate_ids: Vec<Hash> = Vec::new();
     
-    // Use indexes for efficient filtering
+    // Use indexes for efficient filtering (the narrowest index; the other filters are applied below)
     if let Some(ref owner_filter) = query.owner {
         if let Some(owner) = crate::types::hex_to_address(owner_filter) {
             candidate_ids = api_state.state.search_assets_by_owner(&owner);
         }
     } else if let Some(ref game_id_filter) = query.game_id {
         candidate_ids = api_state.state.search_assets_by_game_id(game_id_filter);
-    } else if let Some(ref density_filter) = query.density {
-        // Parse density level
-        let density = match density_filter.as_str() {
-            "Ethereal" => crate::types::DensityLevel::Ethereal,
-            "Light" => crate::types::DensityLevel::Light,
-            "Dense" => crate::types::DensityLevel::Dense,
-            "Core" => crate::types::DensityLevel::Core,
-            _ => return Err(StatusCode::BAD_REQUEST),
-        };
+    } else if let Some(density) = density_filter {
         candidate_ids = api_state.state.search_assets_by_density(density);
     } else {
         // No specific filter, use all assets
@@ -1329,6 +2028,10 @@ async fn search_assets(
         .filter_map(|id| {
             api_state.state.get_asset(id).map(|state| (*id, state))
         })
+        .filter(|(_, state)| {
+            query.game_id.as_ref().map_or(true, |g| state.data.game_id.as_ref() == Some(g))
+                && density_filter.map_or(true, |d| state.data.density == d)
+        })
         .collect();
     
     // Sort results
@@ -1336,23 +2039,16 @@ async fn search_assets(
     let sort_order = query.sort_order.as_deref().unwrap_or("desc");
     let ascending = sort_order == "asc";
     
+    // Ties are broken by asset id so that offset paging sees a stable order
     match sort_by {
-        "created_at" => {
-            results.sort_by(|a, b| {
-                if ascending {
-                    a.1.created_at.cmp(&b.1.created_at)
-                } else {
-                    b.1.created_at.cmp(&a.1.created_at)
-                }
-            });
-        }
         "updated_at" => {
             results.sort_by(|a, b| {
-                if ascending {
+                let order = if ascending {
                     a.1.updated_at.cmp(&b.1.updated_at)
                 } else {
                     b.1.updated_at.cmp(&a.1.updated_at)
-                }
+                };
+                order.then_with(|| a.0.cmp(&b.0))
             });
         }
         "rarity" => {
@@ -1365,25 +2061,38 @@ async fn search_assets(
                     .find(|attr| attr.name == "rarity")
                     .and_then(|attr| attr.rarity)
                     .unwrap_or(0.0);
-                if ascending {
+                let order = if ascending {
                     rarity_a.partial_cmp(&rarity_b).unwrap_or(std::cmp::Ordering::Equal)
                 } else {
                     rarity_b.partial_cmp(&rarity_a).unwrap_or(std::cmp::Ordering::Equal)
-                }
+                };
+                order.then_with(|| a.0.cmp(&b.0))
             });
         }
         _ => {
-            // Default: sort by created_at desc
-            results.sort_by(|a, b| b.1.created_at.cmp(&a.1.created_at));
+            // created_at (the default; unknown keys sort by created_at desc)
+            let ascending = ascending && sort_by == "created_at";
+            results.sort_by(|a, b| {
+                let order = if ascending {
+                    a.1.created_at.cmp(&b.1.created_at)
+                } else {
+                    b.1.created_at.cmp(&a.1.created_at)
+                };
+                order.then_with(|| a.0.cmp(&b.0))
+            });
         }
     }
     
     // Apply pagination
+    let summary = query.view.as_deref() == Some("summary");
     let paginated_results: Vec<serde_json::Value> = results
         .into_iter()
         .skip(offset)
         .take(limit)
         .map(|(asset_id, asset_state)| {
+            if summary {
+                return asset_summary_json(&asset_id, &asset_state);
+            }
             let blob_refs_json: std::collections::HashMap<String, String> = asset_state.blob_refs.iter()
                 .map(|(k, v)| (k.clone(), hex::encode(v)))
                 .collect();
@@ -1544,6 +2253,13 @@ async fn handle_socket(socket: axum::extract::ws::WebSocket, state: ApiState) {
                         sub.asset_id.as_ref().map(|id| id == asset_id).unwrap_or(true) &&
                         sub.owner.as_ref().map(|o| o == owner).unwrap_or(true)
                     }
+                    // owner filters blocks to those touching that account
+                    ("block_applied", WsEvent::BlockApplied { accounts, .. }) => {
+                        sub.owner.as_ref().map(|o| accounts.iter().any(|a| a == o)).unwrap_or(true)
+                    }
+                    ("pool_updated", WsEvent::PoolUpdated { pool_id, .. }) => {
+                        sub.pool_id.as_ref().map(|id| id == pool_id).unwrap_or(true)
+                    }
                     _ => false,
                 }
             });
@@ -1776,6 +2492,8 @@ mod tests {
         let mut config = Config::default();
         // Use unique database path for tests
         config.storage.db_path = std::path::PathBuf::from("./haze_db_test_api");
+        config.storage.blob_storage_path = std::path::PathBuf::from("./haze_db_test_api/blobs");
+        let blob_storage = Arc::new(BlobStorage::new(&config).unwrap());
         let state = Arc::new(StateManager::new(&config).unwrap());
         let consensus = Arc::new(ConsensusEngine::new(config.clone(), state.clone()).unwrap());
         
@@ -1786,6 +2504,7 @@ mod tests {
             config,
             ws_tx,
             connected_peers: Arc::new(std::sync::atomic::AtomicUsize::new(0)),
+            blob_storage,
         }
     }
     
@@ -1811,4 +2530,163 @@ mod tests {
         assert_eq!(response.data, None);
         assert_eq!(response.error, Some("test error".to_string()));
     }
+
+    #[test]
+    fn test_parse_byte_range() {
+        assert_eq!(parse_byte_range("bytes=0-99", 1000), Ok(Some((0, 99))));
+        assert_eq!(parse_byte_range("bytes=500-", 1000), Ok(Some((500, 999))));
+        assert_eq!(parse_byte_range("bytes=900-5000", 1000), Ok(Some((900, 999))));
+        assert_eq!(parse_byte_range("bytes=-100", 1000), Ok(Some((900, 999))));
+        assert_eq!(parse_byte_range("bytes=-5000", 1000), Ok(Some((0, 999))));
+        assert_eq!(parse_byte_range("bytes=1000-", 1000), Err(()));
+        assert_eq!(parse_byte_range("bytes=20-10", 1000), Err(()));
+        assert_eq!(parse_byte_range("bytes=-0", 1000), Err(()));
+        // Ignored: multiple ranges or other units
+        assert_eq!(parse_byte_range("bytes=0-1,5-6", 1000), Ok(None));
+        assert_eq!(parse_byte_range("items=0-1", 1000), Ok(None));
+    }
+
+    #[test]
+    fn test_asset_summary_keeps_metadata_within_ethereal_budget() {
+        let mut metadata = std::collections::HashMap::new();
+        metadata.insert("name".to_string(), "Sword".to_string());
+        metadata.insert("model".to_string(), "x".repeat(8 * 1024));
+        let owner = [1u8; 32];
+        let asset_state = AssetState {
+            owner,
+            data: crate::types::AssetData {
+                density: crate::types::DensityLevel::Dense,
+                metadata,
+                attributes: vec![],
+                game_id: Some("game".to_string()),
+                owner,
+            },
+            created_at: 1,
+            updated_at: 2,
+            blob_refs: std::collections::HashMap::new(),
+            history: Vec::new(),
+            history_base: 0,
+            versions: Vec::new(),
+            current_version: 0,
+            permissions: Vec::new(),
+            public_read: false,
+        };
+
+        let summary = asset_summary_json(&[2u8; 32], &asset_state);
+        assert_eq!(summary["density"], "Dense");
+        assert_eq!(summary["metadata"]["name"], "Sword");
+        assert!(summary["metadata"].get("model").is_none());
+        assert_eq!(summary["metadata_truncated"], true);
+        assert_eq!(summary["metadata_bytes"], 4 + 5 + 5 + 8 * 1024);
+    }
+
+    #[test]
+    fn test_asset_version_delta_sends_only_changed_blob_refs() {
+        let owner = [1u8; 32];
+        let version = |number: u64, refs: &[(&str, u8)]| AssetVersion {
+            version: number,
+            timestamp: number as i64,
+            data: crate::types::AssetData {
+                density: crate::types::DensityLevel::Core,
+                metadata: std::collections::HashMap::new(),
+                attributes: vec![],
+                game_id: None,
+                owner,
+            },
+            blob_refs: refs.iter().map(|(k, h)| (k.to_string(), [*h; 32])).collect(),
+        };
+        let base = version(4, &[("mesh", 1), ("texture", 2), ("sound", 3)]);
+        let next = version(5, &[("mesh", 1), ("texture", 9), ("anim", 4)]);
+
+        let delta = asset_version_delta_json(&next, Some((base.version, &base.blob_refs)));
+        assert_eq!(delta["blob_refs_base"], 4);
+        assert!(delta["blob_refs"].get("mesh").is_none());
+        assert_eq!(delta["blob_refs"]["texture"], hex::encode([9u8; 32]));
+        assert_eq!(delta["blob_refs"]["anim"], hex::encode([4u8; 32]));
+        assert_eq!(delta["removed_blob_refs"], serde_json::json!(["sound"]));
+
+        let full = asset_version_delta_json(&next, None);
+        assert_eq!(full["blob_refs_base"], 0);
+        assert_eq!(full["blob_refs"].as_object().unwrap().len(), 3);
+    }
+
+    #[test]
+    fn test_block_info_lists_transaction_hashes_like_block_applied() {
+        use crate::types::{Block, BlockHeader};
+        let from = [1u8; 32];
+        let transfer = |nonce| Transaction::Transfer {
+            from,
+            to: [2u8; 32],
+            amount: 1,
+            fee: 1,
+            nonce,
+            chain_id: None,
+            valid_until_height: None,
+            signature: vec![0; 64],
+        };
+        let block = Block {
+            header: BlockHeader {
+                hash: [7u8; 32],
+                parent_hash: [6u8; 32],
+                height: 3,
+                timestamp: 0,
+                validator: [9u8; 32],
+                merkle_root: [0u8; 32],
+                state_root: [0u8; 32],
+                wave_number: 0,
+                committee_id: 0,
+            },
+            transactions: vec![transfer(0), transfer(1)],
+            dag_references: vec![],
+        };
+
+        let info = BlockInfo::from_block(&block);
+        assert_eq!(info.parent_hash, hash_to_hex(&[6u8; 32]));
+        assert_eq!(info.transaction_count, 2);
+        match StateManager::block_applied_event(&block) {
+            WsEvent::BlockApplied { transactions, .. } => assert_eq!(info.transactions, transactions),
+            other => panic!("unexpected event {:?}", other),
+        }
+    }
+
+    #[test]
+    fn test_preferred_coding() {
+        let accept = |value: &'static str| {
+            let mut headers = HeaderMap::new();
+            headers.insert(header::ACCEPT_ENCODING, axum::http::HeaderValue::from_static(value));
+            preferred_coding(&headers)
+        };
+        assert_eq!(preferred_coding(&HeaderMap::new()), None);
+        assert_eq!(accept("gzip"), Some(ContentCoding::Gzip));
+        assert_eq!(accept("gzip, deflate, br"), Some(ContentCoding::Gzip));
+        assert_eq!(accept("gzip, zstd"), Some(ContentCoding::Zstd));
+        assert_eq!(accept("zstd;q=0.5, gzip;q=0.8"), Some(ContentCoding::Gzip));
+        assert_eq!(accept("gzip;q=0, identity"), None);
+        assert_eq!(accept("br"), None);
+
+        let body = b"repetitive metadata value ".repeat(100);
+        for coding in [ContentCoding::Gzip, ContentCoding::Zstd] {
+            assert!(coding.encode(&body).unwrap().len() * 4 < body.len(), "{:?}", coding);
+        }
+        let mut gzip = flate2::read::GzDecoder::new(&ContentCoding::Gzip.encode(&body).unwrap()[..]);
+        let mut inflated = Vec::new();
+        std::io::Read::read_to_end(&mut gzip, &mut inflated).unwrap();
+        assert_eq!(inflated, body);
+        assert_eq!(zstd::stream::decode_all(&ContentCoding::Zstd.encode(&body).unwrap()[..]).unwrap(), body);
+    }
+
+    #[test]
+    fn test_if_none_match_is_weak() {
+        let request = |value: &'static str| {
+            let mut headers = HeaderMap::new();
+            headers.insert(header::IF_NONE_MATCH, axum::http::HeaderValue::from_static(value));
+            headers
+        };
+        assert!(!if_none_match(&HeaderMap::new(), "\"7\""));
+        assert!(if_none_match(&request("\"7\""), "\"7\""));
+        assert!(if_none_match(&request("W/\"7\""), "\"7\""));
+        assert!(if_none_match(&request("\"6\", W/\"7\""), "\"7\""));
+        assert!(if_none_match(&request("*"), "\"7\""));
+        assert!(!if_none_match(&request("\"70\""), "\"7\""));
+    }
 }
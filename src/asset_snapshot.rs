@@ -0,0 +1,382 @@
+//! Asset snapshots - pre-baked binary images of many assets for fast client startup
+//!
+//! A snapshot holds the same fields as `export_asset` for a set of assets, in a layout a client can
+//! memory-map and read in place: a fixed header, fixed-size asset records sorted by asset id (the
+//! index, binary-searchable), fixed-size metadata / attribute / blob ref records, and one interned
+//! string table. Every integer is little-endian and every section starts 8-byte aligned.
+//!
+//! ```text
+//! header      HEADER_SIZE bytes
+//! assets      asset_count     x ASSET_RECORD_SIZE  sorted by asset id
+//! metadata    metadata_count  x 8   (key string, value string), sorted by key within an asset
+//! attributes  attribute_count x 16  (name string, value string, rarity f64; NaN = none)
+//! blob refs   blob_ref_count  x 40  (key string, 0u32, 32-byte hash), sorted by key within an asset
+//! strings     (string_count + 1) x u32 offsets into the string bytes, then the UTF-8 bytes
+//! ```
+//!
+//! The header records the `state_root` and height the snapshot was taken at. Each asset carries a
+//! fingerprint of its chain-derived state, so a client whose snapshot is behind the chain asks
+//! `POST /api/v1/snapshots/assets/stale` which entries changed and refetches only those.
+
+use crate::state::AssetState;
+use crate::types::{Hash, DensityLevel, PermissionLevel};
+use std::collections::HashMap;
+
+pub const SNAPSHOT_MAGIC: [u8; 8] = *b"HAZESNAP";
+pub const SNAPSHOT_FORMAT_VERSION: u32 = 1;
+pub const HEADER_SIZE: usize = 128;
+pub const ASSET_RECORD_SIZE: usize = 128;
+pub const METADATA_RECORD_SIZE: usize = 8;
+pub const ATTRIBUTE_RECORD_SIZE: usize = 16;
+pub const BLOB_REF_RECORD_SIZE: usize = 40;
+/// String index for "no value" (an asset without a game id)
+pub const NO_STRING: u32 = u32::MAX;
+/// Asset record flag: anyone may read the asset
+pub const FLAG_PUBLIC_READ: u8 = 1;
+
+/// First 8 bytes (little-endian) of the SHA-256 of a canonical encoding of the asset: its id, owner,
+/// data (metadata sorted by key), blob refs sorted by key, version, permissions and read flag.
+/// Maps are sorted and the wall-clock fields (`created_at`, `updated_at`, history and version
+/// timestamps) left out, so every node that applied the same blocks agrees on the fingerprint.
+pub fn asset_fingerprint(asset_id: &Hash, asset_state: &AssetState) -> u64 {
+    let digest = crate::types::sha256(&canonical_asset_bytes(asset_id, asset_state));
+    let mut head = [0u8; 8];
+    head.copy_from_slice(&digest[..8]);
+    u64::from_le_bytes(head)
+}
+
+fn put_str(out: &mut Vec<u8>, value: &str) {
+    out.extend_from_slice(&(value.len() as u32).to_le_bytes());
+    out.extend_from_slice(value.as_bytes());
+}
+
+fn put_opt_str(out: &mut Vec<u8>, value: Option<&str>) {
+    match value {
+        Some(value) => {
+            out.push(1);
+            put_str(out, value);
+        }
+        None => out.push(0),
+    }
+}
+
+fn canonical_asset_bytes(asset_id: &Hash, asset_state: &AssetState) -> Vec<u8> {
+    let data = &asset_state.data;
+    let mut out = Vec::with_capacity(256);
+    out.extend_from_slice(asset_id);
+    out.extend_from_slice(&asset_state.owner);
+    out.extend_from_slice(&data.owner);
+    out.push(density_byte(&data.density));
+    put_opt_str(&mut out, data.game_id.as_deref());
+
+    let mut metadata: Vec<(&String, &String)> = data.metadata.iter().collect();
+    metadata.sort();
+    out.extend_from_slice(&(metadata.len() as u32).to_le_bytes());
+    for (key, value) in metadata {
+        put_str(&mut out, key);
+        put_str(&mut out, value);
+    }
+
+    // Attributes are a list: their order is part of the asset
+    out.extend_from_slice(&(data.attributes.len() as u32).to_le_bytes());
+    for attribute in &data.attributes {
+        put_str(&mut out, &attribute.name);
+        put_str(&mut out, &attribute.value);
+        out.extend_from_slice(&attribute.rarity.unwrap_or(f64::NAN).to_bits().to_le_bytes());
+    }
+
+    let mut blob_refs: Vec<(&String, &Hash)> = asset_state.blob_refs.iter().collect();
+    blob_refs.sort();
+    out.extend_from_slice(&(blob_refs.len() as u32).to_le_bytes());
+    for (key, hash) in blob_refs {
+        put_str(&mut out, key);
+        out.extend_from_slice(hash);
+    }
+
+    out.extend_from_slice(&asset_state.current_version.to_le_bytes());
+    out.extend_from_slice(&(asset_state.permissions.len() as u32).to_le_bytes());
+    for permission in &asset_state.permissions {
+        out.extend_from_slice(&permission.grantee);
+        out.push(match permission.level {
+            PermissionLevel::GameContract => 0,
+            PermissionLevel::PublicRead => 1,
+        });
+        put_opt_str(&mut out, permission.game_id.as_deref());
+        match permission.expires_at {
+            Some(expires_at) => {
+                out.push(1);
+                out.extend_from_slice(&expires_at.to_le_bytes());
+            }
+            None => out.push(0),
+        }
+    }
+    out.push(asset_state.public_read as u8);
+    out
+}
+
+/// Fingerprints travel as 16 lowercase hex digits (JSON numbers lose precision above 2^53)
+pub fn fingerprint_to_hex(fingerprint: u64) -> String {
+    format!("{:016x}", fingerprint)
+}
+
+pub fn fingerprint_from_hex(hex: &str) -> Option<u64> {
+    if hex.len() != 16 {
+        return None;
+    }
+    u64::from_str_radix(hex, 16).ok()
+}
+
+fn density_byte(density: &DensityLevel) -> u8 {
+    match density {
+        DensityLevel::Ethereal => 0,
+        DensityLevel::Light => 1,
+        DensityLevel::Dense => 2,
+        DensityLevel::Core => 3,
+    }
+}
+
+fn align8(len: usize) -> usize {
+    (len + 7) & !7
+}
+
+/// Strings stored once, numbered in first-use order
+#[derive(Default)]
+struct StringTable<'a> {
+    ids: HashMap<&'a str, u32>,
+    strings: Vec<&'a str>,
+}
+
+impl<'a> StringTable<'a> {
+    fn intern(&mut self, value: &'a str) -> u32 {
+        if let Some(id) = self.ids.get(value) {
+            return *id;
+        }
+        let id = self.strings.len() as u32;
+        self.ids.insert(value, id);
+        self.strings.push(value);
+        id
+    }
+}
+
+/// Build a snapshot of `assets` (any order, ids unique) taken at `height` / `state_root`.
+/// `state_root` should be computed before the assets are read, so a snapshot whose root still
+/// matches the chain is known to hold current assets.
+pub fn write_asset_snapshot(assets: &[(Hash, AssetState)], height: u64, state_root: &Hash, created_at: i64) -> Vec<u8> {
+    let mut order: Vec<&(Hash, AssetState)> = assets.iter().collect();
+    order.sort_by(|a, b| a.0.cmp(&b.0));
+
+    let mut strings = StringTable::default();
+    let mut records = Vec::with_capacity(order.len() * ASSET_RECORD_SIZE);
+    let mut metadata = Vec::new();
+    let mut attributes = Vec::new();
+    let mut blob_refs = Vec::new();
+    let (mut metadata_count, mut attribute_count, mut blob_ref_count) = (0u32, 0u32, 0u32);
+
+    for (asset_id, asset_state) in order {
+        let data = &asset_state.data;
+        let game_id = data.game_id.as_deref().map_or(NO_STRING, |g| strings.intern(g));
+
+        let mut entries: Vec<(&String, &String)> = data.metadata.iter().collect();
+        entries.sort();
+        let metadata_first = metadata_count;
+        for (key, value) in entries {
+            metadata.extend_from_slice(&strings.intern(key).to_le_bytes());
+            metadata.extend_from_slice(&strings.intern(value).to_le_bytes());
+            metadata_count += 1;
+        }
+
+        let attributes_first = attribute_count;
+        for attribute in &data.attributes {
+            attributes.extend_from_slice(&strings.intern(&attribute.name).to_le_bytes());
+            attributes.extend_from_slice(&strings.intern(&attribute.value).to_le_bytes());
+            attributes.extend_from_slice(&attribute.rarity.unwrap_or(f64::NAN).to_le_bytes());
+            attribute_count += 1;
+        }
+
+        let mut refs: Vec<(&String, &Hash)> = asset_state.blob_refs.iter().collect();
+        refs.sort();
+        let blob_refs_first = blob_ref_count;
+        for (key, hash) in refs {
+            blob_refs.extend_from_slice(&strings.intern(key).to_le_bytes());
+            blob_refs.extend_from_slice(&0u32.to_le_bytes());
+            blob_refs.extend_from_slice(hash);
+            blob_ref_count += 1;
+        }
+
+        records.extend_from_slice(asset_id);
+        records.extend_from_slice(&asset_state.owner);
+        records.extend_from_slice(&asset_fingerprint(asset_id, asset_state).to_le_bytes());
+        records.extend_from_slice(&asset_state.created_at.to_le_bytes());
+        records.extend_from_slice(&asset_state.updated_at.to_le_bytes());
+        records.extend_from_slice(&asset_state.current_version.to_le_bytes());
+        records.extend_from_slice(&game_id.to_le_bytes());
+        records.extend_from_slice(&metadata_first.to_le_bytes());
+        records.extend_from_slice(&attributes_first.to_le_bytes());
+        records.extend_from_slice(&blob_refs_first.to_le_bytes());
+        records.extend_from_slice(&(metadata_count - metadata_first).to_le_bytes());
+        records.extend_from_slice(&(attribute_count - attributes_first).to_le_bytes());
+        records.extend_from_slice(&(blob_ref_count - blob_refs_first).to_le_bytes());
+        records.push(density_byte(&data.density));
+        records.push(if asset_state.public_read { FLAG_PUBLIC_READ } else { 0 });
+        records.extend_from_slice(&[0u8; 2]);
+    }
+
+    let mut string_offsets = Vec::with_capacity((strings.strings.len() + 1) * 4);
+    let mut string_bytes: Vec<u8> = Vec::new();
+    for value in &strings.strings {
+        string_offsets.extend_from_slice(&(string_bytes.len() as u32).to_le_bytes());
+        string_bytes.extend_from_slice(value.as_bytes());
+    }
+    string_offsets.extend_from_slice(&(string_bytes.len() as u32).to_le_bytes());
+
+    let sections = [&records, &metadata, &attributes, &blob_refs, &string_offsets, &string_bytes];
+    let file_size = HEADER_SIZE + sections.iter().map(|s| align8(s.len())).sum::<usize>();
+
+    let mut out = Vec::with_capacity(file_size);
+    out.extend_from_slice(&SNAPSHOT_MAGIC);
+    out.extend_from_slice(&SNAPSHOT_FORMAT_VERSION.to_le_bytes());
+    out.extend_from_slice(&(HEADER_SIZE as u32).to_le_bytes());
+    out.extend_from_slice(&height.to_le_bytes());
+    out.extend_from_slice(state_root);
+    out.extend_from_slice(&created_at.to_le_bytes());
+    out.extend_from_slice(&((records.len() / ASSET_RECORD_SIZE) as u32).to_le_bytes());
+    out.extend_from_slice(&metadata_count.to_le_bytes());
+    out.extend_from_slice(&attribute_count.to_le_bytes());
+    out.extend_from_slice(&blob_ref_count.to_le_bytes());
+    out.extend_from_slice(&(strings.strings.len() as u32).to_le_bytes());
+    out.extend_from_slice(&0u32.to_le_bytes());
+    out.extend_from_slice(&(string_bytes.len() as u64).to_le_bytes());
+    out.extend_from_slice(&(file_size as u64).to_le_bytes());
+    out.resize(HEADER_SIZE, 0);
+    for section in sections {
+        out.extend_from_slice(section);
+        out.resize(align8(out.len()), 0);
+    }
+    debug_assert_eq!(out.len(), file_size);
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::types::{AssetData, Attribute};
+
+    fn asset(owner: u8, name: &str, game_id: Option<&str>) -> AssetState {
+        let mut metadata = HashMap::new();
+        metadata.insert("name".to_string(), name.to_string());
+        metadata.insert("class".to_string(), "weapon".to_string());
+        AssetState {
+            owner: [owner; 32],
+            data: AssetData {
+                density: DensityLevel::Dense,
+                metadata,
+                attributes: vec![Attribute { name: "damage".to_string(), value: "42".to_string(), rarity: Some(0.25) }],
+                game_id: game_id.map(str::to_string),
+                owner: [owner; 32],
+            },
+            created_at: 1_700_000_000,
+            updated_at: 1_700_000_500,
+            blob_refs: HashMap::from([("model".to_string(), [7u8; 32])]),
+            history: vec![],
+            history_base: 0,
+            versions: vec![],
+            current_version: 3,
+            permissions: vec![],
+            public_read: true,
+        }
+    }
+
+    fn u32_at(bytes: &[u8], offset: usize) -> u32 {
+        u32::from_le_bytes(bytes[offset..offset + 4].try_into().unwrap())
+    }
+
+    fn u64_at(bytes: &[u8], offset: usize) -> u64 {
+        u64::from_le_bytes(bytes[offset..offset + 8].try_into().unwrap())
+    }
+
+    #[test]
+    fn test_snapshot_layout() {
+        let assets = vec![
+            ([9u8; 32], asset(1, "Shield", Some("haze-rpg"))),
+            ([2u8; 32], asset(1, "Sword", Some("haze-rpg"))),
+        ];
+        let root = [5u8; 32];
+        let bytes = write_asset_snapshot(&assets, 42, &root, 1_700_001_000);
+
+        assert_eq!(&bytes[0..8], &SNAPSHOT_MAGIC);
+        assert_eq!(u32_at(&bytes, 8), SNAPSHOT_FORMAT_VERSION);
+        assert_eq!(u64_at(&bytes, 16), 42);
+        assert_eq!(&bytes[24..56], &root);
+        assert_eq!(u32_at(&bytes, 64), 2);
+        assert_eq!(u32_at(&bytes, 68), 4); // two metadata entries each
+        assert_eq!(u32_at(&bytes, 72), 2);
+        assert_eq!(u32_at(&bytes, 76), 2);
+        // haze-rpg, class, weapon, name, Sword, damage, 42, model, Shield
+        assert_eq!(u32_at(&bytes, 80), 9);
+        assert_eq!(u64_at(&bytes, 96) as usize, bytes.len());
+        assert_eq!(bytes.len() % 8, 0);
+
+        // Index sorted by asset id, fingerprints as asset_fingerprint computes them
+        let first = HEADER_SIZE;
+        assert_eq!(&bytes[first..first + 32], &[2u8; 32]);
+        assert_eq!(&bytes[first + ASSET_RECORD_SIZE..first + ASSET_RECORD_SIZE + 32], &[9u8; 32]);
+        assert_eq!(u64_at(&bytes, first + 64), asset_fingerprint(&[2u8; 32], &assets[1].1));
+        assert_eq!(bytes[first + 124], 2);
+        assert_eq!(bytes[first + 125], FLAG_PUBLIC_READ);
+        // Second asset's metadata and blob refs follow the first one's
+        assert_eq!(u32_at(&bytes, first + ASSET_RECORD_SIZE + 100), 2);
+        assert_eq!(u32_at(&bytes, first + ASSET_RECORD_SIZE + 108), 1);
+    }
+
+    #[test]
+    fn test_snapshot_is_deterministic_and_fingerprints_track_changes() {
+        let assets = vec![([2u8; 32], asset(1, "Sword", None)), ([3u8; 32], asset(1, "Bow", None))];
+        let reversed: Vec<_> = assets.iter().rev().cloned().collect();
+        assert_eq!(write_asset_snapshot(&assets, 1, &[0u8; 32], 0), write_asset_snapshot(&reversed, 1, &[0u8; 32], 0));
+
+        let before = asset_fingerprint(&[2u8; 32], &assets[0].1);
+        let mut changed = assets[0].1.clone();
+        changed.data.metadata.insert("name".to_string(), "Sword+1".to_string());
+        assert_ne!(asset_fingerprint(&[2u8; 32], &changed), before);
+        assert_ne!(asset_fingerprint(&[3u8; 32], &assets[0].1), before);
+
+        assert_eq!(fingerprint_from_hex(&fingerprint_to_hex(before)), Some(before));
+        assert_eq!(fingerprint_from_hex("12"), None);
+    }
+
+    #[test]
+    fn test_fingerprint_agrees_across_nodes() {
+        // The same asset as two nodes hold it: maps filled in a different order (separate HashMaps,
+        // each with its own hasher seed) and applied at different wall-clock times
+        let keys: Vec<String> = (0..32).map(|i| format!("key{:02}", i)).collect();
+        let mut one = asset(1, "Sword", Some("haze-rpg"));
+        let mut other = asset(1, "Sword", Some("haze-rpg"));
+        one.data.metadata = HashMap::new();
+        other.data.metadata = HashMap::new();
+        one.blob_refs = HashMap::new();
+        other.blob_refs = HashMap::new();
+        for (i, key) in keys.iter().enumerate() {
+            one.data.metadata.insert(key.clone(), i.to_string());
+            one.blob_refs.insert(key.clone(), [i as u8; 32]);
+        }
+        for (i, key) in keys.iter().enumerate().rev() {
+            other.data.metadata.insert(key.clone(), i.to_string());
+            other.blob_refs.insert(key.clone(), [i as u8; 32]);
+        }
+        other.created_at += 3;
+        other.updated_at += 7;
+        assert_eq!(asset_fingerprint(&[2u8; 32], &one), asset_fingerprint(&[2u8; 32], &other));
+
+        other.blob_refs.insert("key00".to_string(), [99u8; 32]);
+        assert_ne!(asset_fingerprint(&[2u8; 32], &one), asset_fingerprint(&[2u8; 32], &other));
+    }
+
+    #[test]
+    fn test_empty_snapshot() {
+        let bytes = write_asset_snapshot(&[], 0, &[0u8; 32], 0);
+        // Header plus the terminating string offset
+        assert_eq!(bytes.len(), HEADER_SIZE + 8);
+        assert_eq!(u32_at(&bytes, 64), 0);
+        assert_eq!(u32_at(&bytes, HEADER_SIZE), 0);
+    }
+}
@@ -154,6 +154,70 @@ impl BlobStorage {
         Ok(data)
     }
     
+    /// Total size in bytes of a stored blob (from file metadata, without reading it)
+    pub fn blob_len(&self, blob_key: &str, blob_hash: &Hash) -> Result<u64> {
+        let blob_path = self.get_blob_path(blob_key, blob_hash);
+        let chunk_dir = blob_path.with_extension("chunks");
+        if !chunk_dir.exists() {
+            return fs::metadata(&blob_path)
+                .map(|m| m.len())
+                .map_err(|e| HazeError::Asset(format!("Failed to stat blob: {}", e)));
+        }
+
+        let mut total = 0u64;
+        let mut chunk_index = 0;
+        loop {
+            let chunk_path = chunk_dir.join(format!("chunk_{:08}", chunk_index));
+            match fs::metadata(&chunk_path) {
+                Ok(m) => total += m.len(),
+                Err(_) => break,
+            }
+            chunk_index += 1;
+        }
+        Ok(total)
+    }
+
+    /// Read `len` bytes starting at `offset`, touching only the files (or chunks) that overlap the range.
+    /// The result is shorter than `len` if the blob ends first.
+    pub fn read_blob_range(&self, blob_key: &str, blob_hash: &Hash, offset: u64, len: u64) -> Result<Vec<u8>> {
+        use std::io::{Read, Seek, SeekFrom};
+
+        let read_err = |e: std::io::Error| HazeError::Asset(format!("Failed to read blob: {}", e));
+        let blob_path = self.get_blob_path(blob_key, blob_hash);
+        let chunk_dir = blob_path.with_extension("chunks");
+        let mut data = Vec::with_capacity(len.min(self.max_size as u64) as usize);
+
+        if !chunk_dir.exists() {
+            let mut file = fs::File::open(&blob_path).map_err(read_err)?;
+            file.seek(SeekFrom::Start(offset)).map_err(read_err)?;
+            file.take(len).read_to_end(&mut data).map_err(read_err)?;
+            return Ok(data);
+        }
+
+        // Chunk sizes come from the files themselves, so blobs stored with a different chunk_size still read back
+        let end = offset.saturating_add(len);
+        let mut chunk_start = 0u64;
+        let mut chunk_index = 0;
+        while chunk_start < end {
+            let chunk_path = chunk_dir.join(format!("chunk_{:08}", chunk_index));
+            let chunk_len = match fs::metadata(&chunk_path) {
+                Ok(m) => m.len(),
+                Err(_) => break,
+            };
+            let chunk_end = chunk_start + chunk_len;
+            if chunk_end > offset {
+                let from = offset.saturating_sub(chunk_start);
+                let to = end.min(chunk_end) - chunk_start;
+                let mut file = fs::File::open(&chunk_path).map_err(read_err)?;
+                file.seek(SeekFrom::Start(from)).map_err(read_err)?;
+                file.take(to - from).read_to_end(&mut data).map_err(read_err)?;
+            }
+            chunk_start = chunk_end;
+            chunk_index += 1;
+        }
+        Ok(data)
+    }
+    
     /// Delete blob
     pub fn delete_blob(&self, blob_key: &str, blob_hash: &Hash) -> Result<()> {
         let blob_path = self.get_blob_path(blob_key, blob_hash);
@@ -608,6 +672,86 @@ impl MistbornAsset {
     }
 }
 
+/// Multiplier on `condense_base` for condensing into `density`
+pub fn condense_density_multiplier(density: &DensityLevel) -> u64 {
+    match density {
+        DensityLevel::Light => 1,   // Ethereal -> Light
+        DensityLevel::Dense => 2,    // Light -> Dense
+        DensityLevel::Core => 5,     // Dense -> Core
+        DensityLevel::Ethereal => 1, // Shouldn't happen, but default to 1
+    }
+}
+
+/// Every constant `calculate_asset_operation_gas` prices with, plus the gas price, as published by
+/// `GET /api/v1/assets/gas-schedule` so clients can estimate locally.
+#[derive(Debug, Clone, PartialEq, Eq, serde::Serialize)]
+pub struct AssetGasSchedule {
+    /// Content version: changes whenever any constant below does (53 bits, exact as a JSON number)
+    pub version: u64,
+    pub gas_price: u64,
+    pub create_base: u64,
+    pub create_per_kb: u64,
+    pub update_base: u64,
+    pub update_per_kb: u64,
+    pub condense_base: u64,
+    /// `condense_density_multiplier` for each target density
+    pub condense_multiplier_ethereal: u64,
+    pub condense_multiplier_light: u64,
+    pub condense_multiplier_dense: u64,
+    pub condense_multiplier_core: u64,
+    pub condense_per_kb: u64,
+    pub evaporate_base: u64,
+    pub merge_base: u64,
+    pub merge_per_kb: u64,
+    pub split_base: u64,
+    pub split_per_component: u64,
+    pub split_per_kb: u64,
+}
+
+impl AssetGasSchedule {
+    pub fn from_config(config: &Config) -> Self {
+        let gas = &config.asset_gas;
+        let mut schedule = Self {
+            version: 0,
+            gas_price: config.vm.gas_price,
+            create_base: gas.create_base,
+            create_per_kb: gas.create_per_kb,
+            update_base: gas.update_base,
+            update_per_kb: gas.update_per_kb,
+            condense_base: gas.condense_base,
+            condense_multiplier_ethereal: condense_density_multiplier(&DensityLevel::Ethereal),
+            condense_multiplier_light: condense_density_multiplier(&DensityLevel::Light),
+            condense_multiplier_dense: condense_density_multiplier(&DensityLevel::Dense),
+            condense_multiplier_core: condense_density_multiplier(&DensityLevel::Core),
+            condense_per_kb: gas.condense_per_kb,
+            evaporate_base: gas.evaporate_base,
+            merge_base: gas.merge_base,
+            merge_per_kb: gas.merge_per_kb,
+            split_base: gas.split_base,
+            split_per_component: gas.split_per_component,
+            split_per_kb: gas.split_per_kb,
+        };
+        schedule.version = schedule.content_version();
+        schedule
+    }
+
+    /// First 53 bits of the SHA-256 of the constants (little-endian, in field order), never 0
+    fn content_version(&self) -> u64 {
+        let constants = [
+            self.gas_price, self.create_base, self.create_per_kb, self.update_base, self.update_per_kb,
+            self.condense_base, self.condense_multiplier_ethereal, self.condense_multiplier_light,
+            self.condense_multiplier_dense, self.condense_multiplier_core, self.condense_per_kb,
+            self.evaporate_base, self.merge_base, self.merge_per_kb, self.split_base, self.split_per_component,
+            self.split_per_kb,
+        ];
+        let bytes: Vec<u8> = constants.iter().flat_map(|c| c.to_le_bytes()).collect();
+        let digest = crate::types::sha256(&bytes);
+        let mut head = [0u8; 8];
+        head.copy_from_slice(&digest[..8]);
+        (u64::from_le_bytes(head) & ((1u64 << 53) - 1)).max(1)
+    }
+}
+
 /// Calculate gas cost for asset operations
 pub fn calculate_asset_operation_gas(
     config: &crate::config::Config,
@@ -632,13 +776,7 @@ pub fn calculate_asset_operation_gas(
             let metadata_size: usize = data.metadata.values().map(|v| v.len()).sum();
             let metadata_kb = (metadata_size as u64 + 1023) / 1024; // Round up
             
-            // Calculate density multiplier
-            let density_multiplier = match data.density {
-                DensityLevel::Light => 1,   // Ethereal -> Light
-                DensityLevel::Dense => 2,    // Light -> Dense
-                DensityLevel::Core => 5,     // Dense -> Core
-                DensityLevel::Ethereal => 1, // Shouldn't happen, but default to 1
-            };
+            let density_multiplier = condense_density_multiplier(&data.density);
             
             gas_config.condense_base * density_multiplier + (gas_config.condense_per_kb * metadata_kb)
         }
@@ -732,6 +870,33 @@ mod tests {
         std::fs::remove_dir_all(&config.storage.blob_storage_path).ok();
     }
     
+    #[test]
+    fn test_blob_storage_read_range_across_chunks() {
+        let mut config = create_test_config();
+        config.storage.blob_chunk_size = 16;
+        let blob_storage = BlobStorage::new(&config).unwrap();
+
+        let test_data: Vec<u8> = (0..100u8).collect();
+        let blob_hash = blob_storage.store_blob("ranged", &test_data).unwrap();
+        assert_eq!(blob_storage.blob_len("ranged", &blob_hash).unwrap(), 100);
+
+        // Starts mid-chunk and spans several chunks
+        let range = blob_storage.read_blob_range("ranged", &blob_hash, 10, 40).unwrap();
+        assert_eq!(range, &test_data[10..50]);
+
+        // Clamped at the end of the blob
+        let tail = blob_storage.read_blob_range("ranged", &blob_hash, 90, 50).unwrap();
+        assert_eq!(tail, &test_data[90..]);
+
+        // Unchunked blob
+        let small = blob_storage.store_blob("small", b"0123456789").unwrap();
+        assert_eq!(blob_storage.blob_len("small", &small).unwrap(), 10);
+        assert_eq!(blob_storage.read_blob_range("small", &small, 3, 4).unwrap(), b"3456");
+
+        // Cleanup
+        std::fs::remove_dir_all(&config.storage.blob_storage_path).ok();
+    }
+    
     #[test]
     fn test_condense_with_blob_storage() {
         let config = create_test_config();
@@ -954,4 +1119,57 @@ mod tests {
         add.insert("_components".to_string(), "a,b".to_string());
         assert!(calculate_asset_operation_gas(&config, &AssetAction::Split, &data, Some(&add)) > 0);
     }
+
+    /// Mirrored by `HAZE.Gas.Vectors` in the Unreal plugin (`FHazeGasEstimate`); change both together.
+    #[test]
+    fn test_asset_gas_vectors() {
+        use crate::types::{AssetAction, AssetData, DensityLevel};
+        use std::collections::HashMap;
+
+        let config = Config::default();
+        let gas = |action: AssetAction, density: DensityLevel, metadata: &[(&str, String)]| {
+            let data = AssetData {
+                density,
+                metadata: metadata.iter().map(|(k, v)| (k.to_string(), v.clone())).collect::<HashMap<_, _>>(),
+                attributes: vec![],
+                game_id: None,
+                owner: [1u8; 32],
+            };
+            calculate_asset_operation_gas(&config, &action, &data, Some(&data.metadata))
+        };
+
+        assert_eq!(gas(AssetAction::Create, DensityLevel::Ethereal, &[]), 10_000);
+        assert_eq!(gas(AssetAction::Create, DensityLevel::Ethereal, &[("name", "Sword".into())]), 10_100);
+        // Sizes are UTF-8 bytes: 513 two-byte characters are 1026 bytes, two KB
+        assert_eq!(gas(AssetAction::Create, DensityLevel::Ethereal, &[("name", "Ω".repeat(513))]), 10_200);
+        assert_eq!(gas(AssetAction::Update, DensityLevel::Light, &[("bio", "a".repeat(1024))]), 5_050);
+        assert_eq!(gas(AssetAction::Update, DensityLevel::Light, &[("bio", "a".repeat(1025))]), 5_100);
+        assert_eq!(gas(AssetAction::Condense, DensityLevel::Dense, &[("name", "a".repeat(10))]), 30_200);
+        assert_eq!(gas(AssetAction::Condense, DensityLevel::Core, &[("model", "a".repeat(2048))]), 75_400);
+        assert_eq!(gas(AssetAction::Evaporate, DensityLevel::Ethereal, &[("name", "a".repeat(5000))]), 2_000);
+        assert_eq!(gas(AssetAction::Merge, DensityLevel::Light, &[]), 20_000);
+        assert_eq!(gas(AssetAction::Merge, DensityLevel::Light, &[("_other_asset_id", "a".repeat(64))]), 20_150);
+        assert_eq!(gas(AssetAction::Split, DensityLevel::Light, &[("name", "x".into())]), 20_100);
+        assert_eq!(gas(AssetAction::Split, DensityLevel::Light, &[("_components", "a, b,,c".into())]), 30_300);
+        assert_eq!(gas(AssetAction::Split, DensityLevel::Light, &[("_components", " ,".into())]), 15_000);
+    }
+
+    #[test]
+    fn test_asset_gas_schedule_version() {
+        let config = Config::default();
+        let schedule = AssetGasSchedule::from_config(&config);
+        assert_eq!(schedule, AssetGasSchedule::from_config(&config));
+        assert_eq!(
+            [schedule.condense_multiplier_ethereal, schedule.condense_multiplier_light, schedule.condense_multiplier_dense, schedule.condense_multiplier_core],
+            [1, 1, 2, 5]
+        );
+        assert!(schedule.version > 0 && schedule.version < (1u64 << 53));
+
+        let mut changed = config.clone();
+        changed.asset_gas.merge_per_kb += 1;
+        assert_ne!(AssetGasSchedule::from_config(&changed).version, schedule.version);
+        changed = config.clone();
+        changed.vm.gas_price += 1;
+        assert_ne!(AssetGasSchedule::from_config(&changed).version, schedule.version);
+    }
 }
\ No newline at end of file
@@ -14,6 +14,14 @@ pub struct ApiConfig {
     
     /// Enable WebSocket support
     pub enable_websocket: bool,
+
+    /// Compress responses (gzip/zstd) for clients that send Accept-Encoding
+    #[serde(default = "default_enable_compression")]
+    pub enable_compression: bool,
+}
+
+fn default_enable_compression() -> bool {
+    true
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize)]
@@ -270,6 +278,7 @@ impl Config {
                 listen_addr: "127.0.0.1:8080".to_string(),
                 enable_cors: true,
                 enable_websocket: true,
+                enable_compression: true,
             },
             asset_gas: AssetGasConfig {
                 create_base: 10_000,
@@ -1937,4 +1937,76 @@ mod tests {
         let err_msg = result.unwrap_err().to_string();
         assert!(err_msg.contains("finalized") || err_msg.contains("Finalized"), "expected finalized-related error, got: {}", err_msg);
     }
+    /// Signing payloads pinned byte for byte. The Unreal plugin's automation tests (HazeTestVectors.cpp) and
+    /// docs/API_TRANSACTIONS.md carry the same vectors; change all three together.
+    #[test]
+    fn test_signing_payload_vectors() {
+        use crate::types::{AssetAction, AssetData, DensityLevel};
+
+        let config = create_test_config("payload_vectors");
+        let state = crate::state::StateManager::new(&config).unwrap();
+        let consensus = ConsensusEngine::new(config, std::sync::Arc::new(state)).unwrap();
+
+        let mut from = [0u8; 32];
+        from[0] = 1;
+        let mut to = [0u8; 32];
+        to[0] = 2;
+        let transfer = |from, chain_id, valid_until_height| Transaction::Transfer {
+            from,
+            to,
+            amount: 1_000_000,
+            fee: 1000,
+            nonce: 5,
+            chain_id,
+            valid_until_height,
+            signature: vec![],
+        };
+        assert_eq!(
+            hex::encode(consensus.get_transaction_data_for_signing(&transfer(from, None, None))),
+            "5472616e736665720100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000040420f0000000000e8030000000000000500000000000000"
+        );
+        assert_eq!(
+            hex::encode(consensus.get_transaction_data_for_signing(&transfer(from, Some(1), Some(500)))),
+            "5472616e736665720100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000040420f0000000000e80300000000000005000000000000000100000000000000f401000000000000"
+        );
+
+        let asset = |action, density, metadata: HashMap<String, String>, chain_id| Transaction::MistbornAsset {
+            from: [0x11; 32],
+            action,
+            asset_id: [0x22; 32],
+            data: AssetData { density, metadata, attributes: vec![], game_id: None, owner: [0x11; 32] },
+            fee: 10,
+            nonce: 3,
+            chain_id,
+            valid_until_height: None,
+            signature: vec![],
+        };
+        assert_eq!(
+            hex::encode(consensus.get_transaction_data_for_signing(&asset(AssetAction::Create, DensityLevel::Light, HashMap::new(), None))),
+            "4d697374626f726e417373657411111111111111111111111111111111111111111111111111111111111111110022222222222222222222222222222222222222222222222222222222222222221111111111111111111111111111111111111111111111111111111111111111010a000000000000000300000000000000"
+        );
+        let merge = HashMap::from([("_other_asset_id".to_string(), hex::encode([0x33u8; 32]))]);
+        assert_eq!(
+            hex::encode(consensus.get_transaction_data_for_signing(&asset(AssetAction::Merge, DensityLevel::Dense, merge, Some(7)))),
+            "4d697374626f726e4173736574111111111111111111111111111111111111111111111111111111111111111104222222222222222222222222222222222222222222222222222222222222222211111111111111111111111111111111111111111111111111111111111111110233333333333333333333333333333333333333333333333333333333333333330a0000000000000003000000000000000700000000000000"
+        );
+        let split = HashMap::from([("_components".to_string(), "aa,bb".to_string())]);
+        assert_eq!(
+            hex::encode(consensus.get_transaction_data_for_signing(&asset(AssetAction::Split, DensityLevel::Core, split, None))),
+            "4d697374626f726e4173736574111111111111111111111111111111111111111111111111111111111111111105222222222222222222222222222222222222222222222222222222222222222211111111111111111111111111111111111111111111111111111111111111110361612c62620a000000000000000300000000000000"
+        );
+
+        // RFC 8032 test 1 key signing the chain-bound Transfer, sent from its own address
+        let key = crate::crypto::signing_key_from_bytes(
+            &hex::decode("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60").unwrap(),
+        )
+        .unwrap();
+        let address = crate::crypto::verifying_key_to_bytes(&key.verifying_key());
+        assert_eq!(hex::encode(address), "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a");
+        let payload = consensus.get_transaction_data_for_signing(&transfer(address, Some(1), Some(500)));
+        assert_eq!(
+            hex::encode(ed25519_dalek::Signer::sign(&key, &payload).to_bytes()),
+            "09faf1afd4ccb2740d014078cdd1aa4405e4d36742127b7428385c2210e2e5bacb74a72dc35c70018bb4b49c6dee503f579e07d54d7a1208b6c2227b2f563d01"
+        );
+    }
 }
\ No newline at end of file
@@ -7,9 +7,12 @@
 
 use std::sync::Arc;
 use dashmap::DashMap;
+use parking_lot::RwLock;
+use tokio::sync::broadcast;
 use chrono::{DateTime, Utc, Duration};
 use crate::types::Address;
 use crate::error::{HazeError, Result};
+use crate::ws_events::WsEvent;
 
 /// Fog Economics manager
 pub struct FogEconomy {
@@ -24,6 +27,9 @@ pub struct FogEconomy {
     
     /// Game activity tracking
     game_activity: Arc<DashMap<String, GameActivity>>,
+
+    /// WebSocket broadcaster for pool_updated events (set with the state's)
+    ws_tx: Arc<RwLock<Option<broadcast::Sender<WsEvent>>>>,
 }
 
 /// Economic zone within a game
@@ -91,6 +97,31 @@ impl FogEconomy {
             vortex_markets: Arc::new(DashMap::new()),
             liquidity_pools: Arc::new(DashMap::new()),
             game_activity: Arc::new(DashMap::new()),
+            ws_tx: Arc::new(RwLock::new(None)),
+        }
+    }
+
+    /// Set WebSocket broadcaster for pool_updated events
+    pub fn set_ws_tx(&self, tx: broadcast::Sender<WsEvent>) {
+        *self.ws_tx.write() = Some(tx);
+    }
+
+    /// Broadcast a pool's new reserves so clients can requote without refetching
+    fn broadcast_pool(&self, pool: &LiquidityPool) {
+        if let Some(ref tx) = *self.ws_tx.read() {
+            let _ = tx.send(Self::pool_updated_event(pool));
+        }
+    }
+
+    fn pool_updated_event(pool: &LiquidityPool) -> WsEvent {
+        WsEvent::PoolUpdated {
+            pool_id: pool.pool_id.clone(),
+            asset1: pool.asset1.clone(),
+            asset2: pool.asset2.clone(),
+            reserve1: pool.reserve1,
+            reserve2: pool.reserve2,
+            fee_rate: pool.fee_rate,
+            total_liquidity: pool.total_liquidity,
         }
     }
 
@@ -235,7 +266,9 @@ impl FogEconomy {
             total_liquidity,
         };
 
-        self.liquidity_pools.insert(pool_id.clone(), pool);
+        // Inserted first: a subscriber that fetches the pool on pool_updated must find it
+        self.liquidity_pools.insert(pool_id.clone(), pool.clone());
+        self.broadcast_pool(&pool);
 
         Ok(pool_id)
     }
@@ -294,6 +327,7 @@ impl FogEconomy {
 
         // Update k (should be same or slightly larger due to fee)
         pool.k = pool.reserve1 as u128 * pool.reserve2 as u128;
+        self.broadcast_pool(&pool);
 
         Ok(amount_out)
     }
@@ -321,6 +355,7 @@ impl FogEconomy {
         pool.reserve2 += amount2;
         pool.total_liquidity += liquidity_tokens;
         pool.k = pool.reserve1 as u128 * pool.reserve2 as u128;
+        self.broadcast_pool(&pool);
 
         Ok(liquidity_tokens)
     }
@@ -342,3 +377,53 @@ impl Default for FogEconomy {
         Self::new()
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Swap outputs the Unreal quote engine (FHazeAmm, HazeAmmTests.cpp) must reproduce exactly
+    #[test]
+    fn test_swap_quote_vectors() {
+        let economy = FogEconomy::new();
+        let pool_id = economy
+            .create_liquidity_pool("HAZE".to_string(), "GOLD".to_string(), 1_000_000, 2_000_000, 30)
+            .unwrap();
+
+        // fee = 10_000 * 30 / 10_000 = 30; new_in = 1_009_970; new_out = 2e12 / 1_009_970 = 1_980_256
+        assert_eq!(economy.swap_assets(&pool_id, "HAZE", 10_000).unwrap(), 19_744);
+        let pool = economy.get_liquidity_pool(&pool_id).unwrap();
+        assert_eq!((pool.reserve1, pool.reserve2), (1_009_970, 1_980_256));
+
+        // Reverse direction against the updated reserves; fee rounds down to 0 below 334 units
+        assert_eq!(economy.swap_assets(&pool_id, "GOLD", 333).unwrap(), 170);
+        let pool = economy.get_liquidity_pool(&pool_id).unwrap();
+        assert_eq!((pool.reserve1, pool.reserve2), (1_009_800, 1_980_589));
+
+        // Flooring k / new_reserve_in favours the trader: one unit still buys one
+        assert_eq!(economy.swap_assets(&pool_id, "GOLD", 1).unwrap(), 1);
+        assert!(economy.swap_assets(&pool_id, "HAZE", 0).is_err());
+        assert!(economy.swap_assets(&pool_id, "SILVER", 100).is_err());
+    }
+
+    #[test]
+    fn test_pool_updated_event() {
+        let economy = FogEconomy::new();
+        let (tx, mut rx) = broadcast::channel(8);
+        economy.set_ws_tx(tx);
+
+        let pool_id = economy
+            .create_liquidity_pool("HAZE".to_string(), "GOLD".to_string(), 1_000_000, 2_000_000, 30)
+            .unwrap();
+        economy.swap_assets(&pool_id, "HAZE", 10_000).unwrap();
+
+        assert!(matches!(rx.try_recv().unwrap(), WsEvent::PoolUpdated { reserve1: 1_000_000, .. }));
+        match rx.try_recv().unwrap() {
+            WsEvent::PoolUpdated { pool_id: id, reserve1, reserve2, fee_rate, .. } => {
+                assert_eq!(id, pool_id);
+                assert_eq!((reserve1, reserve2, fee_rate), (1_009_970, 1_980_256, 30));
+            }
+            other => panic!("unexpected event {:?}", other),
+        }
+    }
+}
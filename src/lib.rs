@@ -16,6 +16,7 @@ pub mod tokenomics;
 pub mod economy;
 pub mod api;
 pub mod ws_events;
+pub mod asset_snapshot;
 
 // Re-export commonly used types
 pub use types::{Block, Transaction, Address, Hash, AssetAction, AssetData, DensityLevel, AssetPermission, PermissionLevel, sha256, hash_to_hex, hex_to_hash};
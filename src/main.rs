@@ -89,6 +89,10 @@ async fn main() -> Result<()> {
     state_manager.set_ws_tx(ws_tx.clone());
     info!("✓ WebSocket event broadcaster initialized");
     
+    // Blob store for Core density assets, shared by all API handlers
+    let blob_storage = Arc::new(crate::assets::BlobStorage::new(&config)?);
+    info!("✓ Blob storage initialized at {:?}", config.storage.blob_storage_path);
+
     // Initialize API server
     let api_state = crate::api::ApiState {
         consensus: consensus.clone(),
@@ -96,6 +100,7 @@ async fn main() -> Result<()> {
         config: config.clone(),
         ws_tx: ws_tx.clone(),
         connected_peers: connected_peers.clone(),
+        blob_storage,
     };
     info!("✓ API server state initialized");
 
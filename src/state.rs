@@ -40,6 +40,17 @@ pub struct StateManager {
 
     /// Deployed WASM contract code by address (address = sha256(code) for DeployContract)
     contracts: Arc<DashMap<Address, Vec<u8>>>,
+
+    /// `compute_state_root` at a height, kept until the next change to the state
+    state_root_cache: Arc<RwLock<StateRootCache>>,
+}
+
+/// Last computed state root and the generation of the state it was hashed from
+#[derive(Default)]
+struct StateRootCache {
+    /// Bumped by every change to the hashed state
+    generation: u64,
+    root: Option<(u64, Hash)>,
 }
 
 #[derive(Debug, Clone, serde::Serialize)]
@@ -91,6 +102,10 @@ pub struct AssetState {
     /// History of asset changes (limited to last 100 entries)
     #[serde(default)]
     pub history: Vec<AssetHistoryEntry>,
+    /// Index of `history[0]` among all entries ever recorded (entries dropped by the limit count too),
+    /// so history indexes stay stable for incremental sync
+    #[serde(default)]
+    pub history_base: u64,
     /// Version snapshots (limited to last 10 versions)
     #[serde(default)]
     pub versions: Vec<AssetVersion>,
@@ -105,6 +120,40 @@ pub struct AssetState {
     pub public_read: bool,
 }
 
+/// The fields of an `AssetState` that go into `compute_state_root`, in their original order.
+/// `history_base` is bookkeeping for incremental history sync and stays out, so nodes that predate
+/// it compute the same root.
+#[derive(serde::Serialize)]
+struct AssetStateRootView<'a> {
+    owner: &'a Address,
+    data: &'a crate::types::AssetData,
+    created_at: i64,
+    updated_at: i64,
+    blob_refs: &'a HashMap<String, Hash>,
+    history: &'a Vec<AssetHistoryEntry>,
+    versions: &'a Vec<AssetVersion>,
+    current_version: u64,
+    permissions: &'a Vec<AssetPermission>,
+    public_read: bool,
+}
+
+impl AssetState {
+    fn root_view(&self) -> AssetStateRootView<'_> {
+        AssetStateRootView {
+            owner: &self.owner,
+            data: &self.data,
+            created_at: self.created_at,
+            updated_at: self.updated_at,
+            blob_refs: &self.blob_refs,
+            history: &self.history,
+            versions: &self.versions,
+            current_version: self.current_version,
+            permissions: &self.permissions,
+            public_read: self.public_read,
+        }
+    }
+}
+
 impl StateManager {
     /// Create a new StateManager
     ///
@@ -147,6 +196,7 @@ impl StateManager {
             asset_index_by_density: Arc::new(DashMap::new()),
             asset_access_count: Arc::new(DashMap::new()),
             contracts: Arc::new(DashMap::new()),
+            state_root_cache: Arc::new(RwLock::new(StateRootCache::default())),
         };
         state.replay_blocks_from_db()?;
         Ok(state)
@@ -176,6 +226,7 @@ impl StateManager {
 
     /// Set WebSocket broadcaster for real-time event notifications
     pub fn set_ws_tx(&self, tx: broadcast::Sender<WsEvent>) {
+        self.economy.set_ws_tx(tx.clone());
         *self.ws_tx.write() = Some(tx);
     }
 
@@ -199,6 +250,7 @@ impl StateManager {
         // Limit history to last 100 entries
         if asset_state.history.len() > 100 {
             asset_state.history.remove(0);
+            asset_state.history_base += 1;
         }
     }
 
@@ -381,6 +433,27 @@ impl StateManager {
         })
     }
 
+    /// Get asset history entries from absolute index `since` on (oldest first)
+    ///
+    /// # Arguments
+    /// * `asset_id` - The asset identifier (hash)
+    /// * `since` - First history index the caller does not have yet
+    /// * `limit` - Maximum number of entries to return (0 = all)
+    ///
+    /// # Returns
+    /// `Some((first_index, entries))` if the asset exists, `None` otherwise. `first_index` is the index of
+    /// `entries[0]` (or the next index when there is nothing new); it is greater than `since` when the
+    /// entries in between were already dropped by the history limit.
+    pub fn get_asset_history_since(&self, asset_id: &Hash, since: u64, limit: usize) -> Option<(u64, Vec<AssetHistoryEntry>)> {
+        self.assets.get(asset_id).map(|asset_state| {
+            let end = asset_state.history_base + asset_state.history.len() as u64;
+            let first = since.clamp(asset_state.history_base, end);
+            let skip = (first - asset_state.history_base) as usize;
+            let take = if limit > 0 { limit } else { usize::MAX };
+            (first, asset_state.history.iter().skip(skip).take(take).cloned().collect())
+        })
+    }
+
     /// Get asset version by version number
     ///
     /// # Arguments
@@ -427,6 +500,12 @@ impl StateManager {
         })
     }
 
+    /// Get the versions of an asset newer than `since_version` (oldest first)
+    pub fn get_asset_versions_since(&self, asset_id: &Hash, since_version: u64) -> Option<Vec<AssetVersion>> {
+        self.get_asset_versions(asset_id)
+            .map(|versions| versions.into_iter().filter(|v| v.version > since_version).collect())
+    }
+
     /// Create a manual snapshot of an asset
     pub fn create_asset_snapshot(&self, asset_id: &Hash) -> Result<u64> {
         let mut asset_state = self.assets.get_mut(asset_id)
@@ -435,6 +514,7 @@ impl StateManager {
             ))?;
         
         Self::add_asset_snapshot(&mut asset_state);
+        self.invalidate_state_root();
         let version = asset_state.current_version;
         let owner = asset_state.owner;
         self.broadcast_event(WsEvent::AssetVersionCreated {
@@ -779,10 +859,41 @@ impl StateManager {
 
         // Update height
         *self.current_height.write() = height;
+        self.invalidate_state_root();
+
+        self.broadcast_event(Self::block_applied_event(block));
 
         Ok(())
     }
 
+    /// Build the block_applied WebSocket event (tx hashes and touched accounts)
+    pub(crate) fn block_applied_event(block: &Block) -> WsEvent {
+        let mut accounts: Vec<Address> = Vec::with_capacity(block.transactions.len() + 1);
+        accounts.push(block.header.validator);
+        for tx in &block.transactions {
+            match tx {
+                Transaction::Transfer { from, to, .. } => {
+                    accounts.push(*from);
+                    accounts.push(*to);
+                }
+                Transaction::DeployContract { from, .. }
+                | Transaction::ContractCall { from, .. }
+                | Transaction::MistbornAsset { from, .. }
+                | Transaction::Stake { from, .. }
+                | Transaction::SetAssetPermissions { from, .. } => accounts.push(*from),
+            }
+        }
+        accounts.sort_unstable();
+        accounts.dedup();
+
+        WsEvent::BlockApplied {
+            height: block.header.height,
+            hash: crate::types::hash_to_hex(&block.header.hash),
+            transactions: block.transactions.iter().map(|tx| crate::types::hash_to_hex(&tx.hash())).collect(),
+            accounts: accounts.iter().map(crate::types::address_to_hex).collect(),
+        }
+    }
+
     /// Apply transaction to state
     fn apply_transaction(&self, tx: &Transaction) -> Result<()> {
         match tx {
@@ -936,6 +1047,7 @@ impl StateManager {
                             updated_at: chrono::Utc::now().timestamp(),
                             blob_refs,
                             history: Vec::new(),
+                            history_base: 0,
                             versions: Vec::new(),
                             current_version: 0,
                             permissions: Vec::new(),
@@ -1541,6 +1653,7 @@ impl StateManager {
                                 updated_at: chrono::Utc::now().timestamp(),
                                 blob_refs: HashMap::new(), // Components start with empty blob_refs
                                 history: Vec::new(),
+                                history_base: 0,
                                 versions: Vec::new(),
                                 current_version: 0,
                                 permissions: Vec::new(),
@@ -1714,11 +1827,9 @@ impl StateManager {
     /// This method is optimized for batch operations by reducing index updates overhead.
     pub fn apply_transactions_batch(&self, transactions: &[Transaction]) -> Result<()> {
         // Apply all transactions
-        for tx in transactions {
-            self.apply_transaction(tx)?;
-        }
-        
-        Ok(())
+        let result = transactions.iter().try_for_each(|tx| self.apply_transaction(tx));
+        self.invalidate_state_root();
+        result
     }
     
     /// Batch create assets (optimized for multiple asset creation)
@@ -1757,6 +1868,7 @@ impl StateManager {
             // Insert asset
             self.assets.insert(asset_id, asset_state);
         }
+        self.invalidate_state_root();
         
         Ok(())
     }
@@ -1793,6 +1905,49 @@ impl StateManager {
             staked: 0,
         };
         self.accounts.insert(address, account);
+        self.invalidate_state_root();
+    }
+
+    /// State root of the current state and the height it was taken at, if computed since the
+    /// state last changed. Readers that can afford a stale miss (the API) check this before
+    /// paying for `compute_state_root`.
+    pub fn cached_state_root(&self) -> Option<(u64, Hash)> {
+        self.state_root_cache.read().root
+    }
+
+    /// `compute_state_root`, served from the cache while the state is unchanged since the last call
+    pub fn state_root(&self) -> (u64, Hash) {
+        let generation = {
+            let cache = self.state_root_cache.read();
+            if let Some(cached) = cache.root {
+                return cached;
+            }
+            cache.generation
+        };
+        let height = self.current_height();
+        let root = self.compute_state_root();
+        self.store_state_root(generation, height, root);
+        (height, root)
+    }
+
+    /// Keep a root hashed from the state at `generation`, unless the state changed since. Any
+    /// change while hashing (a block, a batch, a snapshot) may be half covered by the root, so it
+    /// is returned to its caller but not kept.
+    fn store_state_root(&self, generation: u64, height: u64, root: Hash) -> bool {
+        let mut cache = self.state_root_cache.write();
+        if cache.generation != generation {
+            return false;
+        }
+        cache.root = Some((height, root));
+        true
+    }
+
+    /// Called after every change to the hashed state. The bump and `store_state_root` both hold
+    /// the write lock, so a root hashed before the change is either cleared here or never stored.
+    fn invalidate_state_root(&self) {
+        let mut cache = self.state_root_cache.write();
+        cache.generation = cache.generation.wrapping_add(1);
+        cache.root = None;
     }
 
     /// Compute state root hash
@@ -1813,7 +1968,7 @@ impl StateManager {
         // Collect all asset states
         let mut asset_data = Vec::new();
         for entry in self.assets.iter() {
-            let asset_bytes = bincode::serialize(&(*entry.key(), entry.value()))
+            let asset_bytes = bincode::serialize(&(*entry.key(), entry.value().root_view()))
                 .unwrap_or_default();
             asset_data.push(asset_bytes);
         }
@@ -1846,6 +2001,7 @@ impl Clone for StateManager {
             asset_index_by_density: self.asset_index_by_density.clone(),
             asset_access_count: self.asset_access_count.clone(),
             contracts: self.contracts.clone(),
+            state_root_cache: self.state_root_cache.clone(),
         }
     }
 }
@@ -1903,6 +2059,78 @@ mod tests {
         assert_eq!(state_root1, state_root2);
     }
 
+    #[test]
+    fn test_state_root_cache() {
+        let config = create_test_config("state_root_cache");
+        let state_manager = StateManager::new(&config).unwrap();
+        assert_eq!(state_manager.cached_state_root(), None);
+
+        let (height, root) = state_manager.state_root();
+        assert_eq!(height, 0);
+        assert_eq!(root, state_manager.compute_state_root());
+        assert_eq!(state_manager.cached_state_root(), Some((0, root)));
+
+        // Any change to the state drops the cached root
+        state_manager.create_test_account(create_test_address(1), 100, 0);
+        assert_eq!(state_manager.cached_state_root(), None);
+        let (_, changed) = state_manager.state_root();
+        assert_ne!(changed, root);
+        assert_eq!(changed, state_manager.compute_state_root());
+
+        // A change that leaves the height alone still drops it
+        state_manager.create_test_account(create_test_address(2), 100, 0);
+        assert_eq!(state_manager.current_height(), 0);
+        assert_eq!(state_manager.cached_state_root(), None);
+    }
+
+    #[test]
+    fn test_state_root_not_stored_across_change() {
+        let config = create_test_config("state_root_generation");
+        let state_manager = StateManager::new(&config).unwrap();
+
+        // A root hashed before a same-height change must not be kept for after it
+        let generation = state_manager.state_root_cache.read().generation;
+        let stale = state_manager.compute_state_root();
+        state_manager.create_test_account(create_test_address(1), 100, 0);
+        assert!(!state_manager.store_state_root(generation, 0, stale));
+        assert_eq!(state_manager.cached_state_root(), None);
+        assert_ne!(state_manager.state_root().1, stale);
+    }
+
+    #[test]
+    fn test_state_root_ignores_history_base() {
+        let config = create_test_config("state_root_history_base");
+        let state_manager = StateManager::new(&config).unwrap();
+        let owner = create_test_address(1);
+        state_manager.create_test_account(owner, 100_000, 0);
+        let asset_id = crate::types::sha256(b"history_base");
+        let create_tx = Transaction::MistbornAsset {
+            from: owner,
+            action: crate::types::AssetAction::Create,
+            asset_id,
+            data: crate::types::AssetData {
+                density: crate::types::DensityLevel::Ethereal,
+                metadata: std::collections::HashMap::new(),
+                attributes: vec![],
+                game_id: None,
+                owner,
+            },
+            fee: 0,
+            nonce: 0,
+            chain_id: None,
+            valid_until_height: None,
+            signature: vec![1; 64],
+        };
+        state_manager.apply_transaction(&create_tx).unwrap();
+
+        // A node that has dropped old history entries agrees with one that never counted them
+        let root = state_manager.compute_state_root();
+        state_manager.assets.get_mut(&asset_id).unwrap().history_base = 7;
+        assert_eq!(state_manager.compute_state_root(), root);
+        state_manager.assets.get_mut(&asset_id).unwrap().current_version += 1;
+        assert_ne!(state_manager.compute_state_root(), root);
+    }
+
     #[test]
     fn test_current_height() {
         let config = create_test_config("height");
@@ -1941,6 +2169,52 @@ mod tests {
         assert!(err_msg.contains("current_height") || err_msg.contains("sequential"), "expected height/sequential error, got: {}", err_msg);
     }
 
+    #[test]
+    fn test_block_applied_event_lists_transactions_and_accounts() {
+        use crate::types::{Block, BlockHeader};
+        let validator = create_test_address(9);
+        let from = create_test_address(1);
+        let to = create_test_address(2);
+        let transfer = |nonce| Transaction::Transfer {
+            from,
+            to,
+            amount: 1,
+            fee: 1,
+            nonce,
+            chain_id: None,
+            valid_until_height: None,
+            signature: vec![0; 64],
+        };
+        let block = Block {
+            header: BlockHeader {
+                hash: [7u8; 32],
+                parent_hash: [0u8; 32],
+                height: 1,
+                timestamp: 0,
+                validator,
+                merkle_root: [0u8; 32],
+                state_root: [0u8; 32],
+                wave_number: 0,
+                committee_id: 0,
+            },
+            transactions: vec![transfer(0), transfer(1)],
+            dag_references: vec![],
+        };
+
+        match StateManager::block_applied_event(&block) {
+            WsEvent::BlockApplied { height, hash, transactions, accounts } => {
+                assert_eq!(height, 1);
+                assert_eq!(hash, crate::types::hash_to_hex(&[7u8; 32]));
+                assert_eq!(transactions.len(), 2);
+                assert_eq!(transactions[1], crate::types::hash_to_hex(&transfer(1).hash()));
+                // Repeated sender/recipient appear once
+                assert_eq!(accounts.len(), 3);
+                assert!(accounts.contains(&crate::types::address_to_hex(&validator)));
+            }
+            other => panic!("unexpected event {:?}", other),
+        }
+    }
+
     #[test]
     fn test_merge_assets() {
         let config = create_test_config("merge");
@@ -2498,6 +2772,58 @@ mod tests {
         assert_eq!(v_current.version, 2);
     }
 
+    #[test]
+    fn test_asset_history_and_versions_since() {
+        let config = create_test_config("history_since");
+        let state_manager = StateManager::new(&config).unwrap();
+
+        let owner = create_test_address(1);
+        state_manager.create_test_account(owner, 100_000, 0);
+        let asset_id = crate::types::sha256(b"test_asset");
+        let tx = Transaction::MistbornAsset {
+            from: owner,
+            action: crate::types::AssetAction::Create,
+            asset_id,
+            data: crate::types::AssetData {
+                density: crate::types::DensityLevel::Ethereal,
+                metadata: std::collections::HashMap::new(),
+                attributes: vec![],
+                game_id: None,
+                owner,
+            },
+            fee: 0,
+            nonce: 0,
+            chain_id: None,
+            valid_until_height: None,
+            signature: vec![1; 64],
+        };
+        state_manager.apply_transaction(&tx).unwrap();
+
+        // Push the create entry out of the 100-entry window: indexes keep counting
+        {
+            let mut asset_state = state_manager.assets.get_mut(&asset_id).unwrap();
+            for _ in 0..110 {
+                StateManager::add_asset_history(&mut asset_state, crate::types::AssetAction::Update, HashMap::new());
+            }
+        }
+        let (first, entries) = state_manager.get_asset_history_since(&asset_id, 105, 0).unwrap();
+        assert_eq!(first, 105);
+        assert_eq!(entries.len(), 6);
+        let (first, entries) = state_manager.get_asset_history_since(&asset_id, 0, 3).unwrap();
+        assert_eq!(first, 11, "dropped entries are skipped");
+        assert_eq!(entries.len(), 3);
+        let (first, entries) = state_manager.get_asset_history_since(&asset_id, 500, 0).unwrap();
+        assert_eq!(first, 111);
+        assert!(entries.is_empty());
+
+        state_manager.create_asset_snapshot(&asset_id).unwrap();
+        state_manager.create_asset_snapshot(&asset_id).unwrap();
+        let versions = state_manager.get_asset_versions_since(&asset_id, 1).unwrap();
+        assert_eq!(versions.iter().map(|v| v.version).collect::<Vec<_>>(), vec![2, 3]);
+        assert!(state_manager.get_asset_versions_since(&asset_id, 3).unwrap().is_empty());
+        assert!(state_manager.get_asset_history_since(&crate::types::sha256(b"missing"), 0, 0).is_none());
+    }
+
     #[test]
     fn test_asset_versions_on_condense() {
         let config = create_test_config("versions_condense");
@@ -57,6 +57,31 @@ pub enum WsEvent {
         version: u64,
         owner: String,
     },
+    /// A block was applied to state. Lets clients follow the head and refresh
+    /// only the accounts it touched instead of polling.
+    #[serde(rename = "block_applied")]
+    BlockApplied {
+        height: u64,
+        hash: String,
+        /// Transaction hashes in block order
+        transactions: Vec<String>,
+        /// Accounts whose balance or nonce the block may have changed
+        /// (senders, transfer recipients and the validator)
+        accounts: Vec<String>,
+    },
+    /// A liquidity pool's reserves changed (created, swap or added
+    /// liquidity). k is always reserve1 * reserve2.
+    #[serde(rename = "pool_updated")]
+    PoolUpdated {
+        pool_id: String,
+        asset1: String,
+        asset2: String,
+        reserve1: u64,
+        reserve2: u64,
+        /// Basis points
+        fee_rate: u64,
+        total_liquidity: u64,
+    },
     #[serde(rename = "error")]
     Error { message: String },
 }
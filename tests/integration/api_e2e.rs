@@ -7,11 +7,12 @@ use std::sync::Arc;
 use axum::body::Body;
 use axum::http::{Request, StatusCode};
 use bytes::Bytes;
-use haze::api::{create_router, ApiState, EstimateGasRequest};
+use haze::api::{create_router, ApiState, EstimateGasRequest, BINCODE_CONTENT_TYPE};
+use haze::assets::BlobStorage;
 use haze::config::Config;
 use haze::consensus::ConsensusEngine;
-use haze::state::StateManager;
-use haze::types::{AssetAction, AssetData, DensityLevel, Transaction};
+use haze::state::{AssetState, StateManager};
+use haze::types::{hash_to_hex, AssetAction, AssetData, DensityLevel, Transaction};
 use tower::util::ServiceExt;
 
 static INTEGRATION_TEST_DB_COUNTER: AtomicU64 = AtomicU64::new(0);
@@ -21,10 +22,12 @@ fn create_test_api_state() -> ApiState {
     let mut config = Config::default();
     config.storage.db_path = PathBuf::from(format!("./haze_db_test_integration_{}", id));
     config.api.enable_cors = false;
+    config.storage.blob_storage_path = PathBuf::from(format!("./haze_db_test_integration_{}/blobs", id));
 
     let state = Arc::new(StateManager::new(&config).unwrap());
     let consensus = Arc::new(ConsensusEngine::new(config.clone(), state.clone()).unwrap());
     let (ws_tx, _) = tokio::sync::broadcast::channel(100);
+    let blob_storage = Arc::new(BlobStorage::new(&config).unwrap());
 
     ApiState {
         consensus,
@@ -32,9 +35,41 @@ fn create_test_api_state() -> ApiState {
         config,
         ws_tx,
         connected_peers: Arc::new(AtomicUsize::new(0)),
+        blob_storage,
     }
 }
 
+/// Put an asset straight into state (no transaction), for read-path tests
+fn insert_test_asset(
+    api_state: &ApiState,
+    asset_id: [u8; 32],
+    density: DensityLevel,
+    metadata: std::collections::HashMap<String, String>,
+    blob_refs: std::collections::HashMap<String, [u8; 32]>,
+) {
+    let owner = [3u8; 32];
+    let data = AssetData {
+        density,
+        metadata,
+        attributes: vec![],
+        game_id: None,
+        owner,
+    };
+    api_state.state.assets().insert(asset_id, AssetState {
+        owner,
+        data,
+        created_at: 0,
+        updated_at: 0,
+        blob_refs,
+        history: Vec::new(),
+        history_base: 0,
+        versions: Vec::new(),
+        current_version: 0,
+        permissions: Vec::new(),
+        public_read: false,
+    });
+}
+
 #[tokio::test]
 async fn e2e_health() {
     let api_state = create_test_api_state();
@@ -115,3 +150,468 @@ async fn e2e_estimate_gas_create() {
 
     assert_eq!(response.status(), StatusCode::OK);
 }
+
+#[tokio::test]
+async fn e2e_gas_schedule_matches_estimate_and_revalidates() {
+    let api_state = create_test_api_state();
+    let gas_config = api_state.config.asset_gas.clone();
+    let app = create_router(api_state);
+
+    let req = Request::builder().uri("/api/v1/assets/gas-schedule").body(Body::empty()).unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    let etag = response.headers().get("etag").unwrap().to_str().unwrap().to_string();
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    let schedule = &json["data"];
+    let version = schedule["version"].as_u64().unwrap();
+    assert_eq!(etag, format!("\"{}\"", version));
+    assert_eq!(schedule["create_base"], gas_config.create_base);
+    assert_eq!(schedule["split_per_component"], gas_config.split_per_component);
+    assert_eq!(schedule["condense_multiplier_core"], 5);
+
+    // Unchanged: 304 without a body
+    let req = Request::builder()
+        .uri("/api/v1/assets/gas-schedule")
+        .header("if-none-match", etag.as_str())
+        .body(Body::empty())
+        .unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::NOT_MODIFIED);
+    assert!(axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap().is_empty());
+
+    let req = Request::builder()
+        .uri("/api/v1/assets/gas-schedule")
+        .header("if-none-match", "\"1\"")
+        .body(Body::empty())
+        .unwrap();
+    assert_eq!(app.clone().oneshot(req).await.unwrap().status(), StatusCode::OK);
+
+    // estimate-gas names the schedule it priced with
+    let owner = [1u8; 32];
+    let tx = Transaction::MistbornAsset {
+        from: owner,
+        action: AssetAction::Condense,
+        asset_id: [3u8; 32],
+        data: AssetData {
+            density: DensityLevel::Core,
+            metadata: std::collections::HashMap::new(),
+            attributes: vec![],
+            game_id: None,
+            owner,
+        },
+        fee: 0,
+        nonce: 0,
+        chain_id: None,
+        valid_until_height: None,
+        signature: vec![0; 64],
+    };
+    let body = serde_json::to_vec(&EstimateGasRequest { transaction: tx }).unwrap();
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/assets/estimate-gas")
+        .header("content-type", "application/json")
+        .body(Body::from(Bytes::from(body)))
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    assert_eq!(json["data"]["schedule_version"].as_u64(), Some(version));
+    assert_eq!(json["data"]["gas_cost"].as_u64(), Some(gas_config.condense_base * schedule["condense_multiplier_core"].as_u64().unwrap()));
+}
+
+#[tokio::test]
+async fn e2e_asset_snapshot_and_stale_entries() {
+    let api_state = create_test_api_state();
+    let asset_id = [8u8; 32];
+    insert_test_asset(
+        &api_state,
+        asset_id,
+        DensityLevel::Light,
+        std::collections::HashMap::from([("name".to_string(), "Cloak".to_string())]),
+        std::collections::HashMap::new(),
+    );
+    let fingerprint = haze::asset_snapshot::asset_fingerprint(&asset_id, &api_state.state.get_asset(&asset_id).unwrap());
+    let app = create_router(api_state);
+
+    let req = Request::builder().uri("/api/v1/snapshots/assets").body(Body::empty()).unwrap();
+    assert_eq!(app.clone().oneshot(req).await.unwrap().status(), StatusCode::BAD_REQUEST);
+
+    let uri = format!("/api/v1/snapshots/assets?owner={}", "00".repeat(32));
+    let req = Request::builder().uri(uri.as_str()).body(Body::empty()).unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    let etag = response.headers().get("etag").unwrap().to_str().unwrap().to_string();
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    assert_eq!(&bytes[0..8], &haze::asset_snapshot::SNAPSHOT_MAGIC);
+    assert_eq!(etag, format!("\"{}\"", hex::encode(&bytes[24..56])));
+
+    let req = Request::builder().uri(uri.as_str()).header("if-none-match", etag.as_str()).body(Body::empty()).unwrap();
+    assert_eq!(app.clone().oneshot(req).await.unwrap().status(), StatusCode::NOT_MODIFIED);
+
+    // Current entry is not reported; a changed one gets its new fingerprint, a missing one none
+    let body = serde_json::json!({ "assets": [
+        { "asset_id": hex::encode(asset_id), "fingerprint": format!("{:016x}", fingerprint) },
+        { "asset_id": hex::encode(asset_id), "fingerprint": format!("{:016x}", fingerprint ^ 1) },
+        { "asset_id": "00".repeat(32), "fingerprint": "0000000000000000" },
+    ] });
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/snapshots/assets/stale")
+        .header("content-type", "application/json")
+        .body(Body::from(serde_json::to_vec(&body).unwrap()))
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    let stale = json["data"]["stale"].as_array().unwrap();
+    assert_eq!(stale.len(), 2);
+    assert_eq!(stale[0]["fingerprint"], format!("{:016x}", fingerprint));
+    assert!(stale[1]["fingerprint"].is_null());
+    assert_eq!(json["data"]["state_root"].as_str().unwrap().len(), 64);
+}
+
+#[tokio::test]
+async fn e2e_send_transaction_batch_per_item_results() {
+    let api_state = create_test_api_state();
+    let app = create_router(api_state);
+
+    // One structurally valid transfer with a bad signature, one malformed entry
+    let transfer = serde_json::json!({
+        "Transfer": {
+            "from": "01".repeat(32),
+            "to": "02".repeat(32),
+            "amount": 10,
+            "fee": 1,
+            "nonce": 0,
+            "signature": "00".repeat(64)
+        }
+    });
+    let body = serde_json::json!({ "transactions": [transfer, { "Unknown": {} }] });
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/transactions/batch")
+        .header("content-type", "application/json")
+        .body(Body::from(serde_json::to_vec(&body).unwrap()))
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    let results = json["data"].as_array().unwrap();
+    assert_eq!(results.len(), 2);
+    assert_eq!(results[0]["status"], "rejected");
+    assert_eq!(results[0]["hash"].as_str().unwrap().len(), 64);
+    assert_eq!(results[1]["status"], "invalid");
+    assert!(results[1]["hash"].is_null());
+}
+
+#[tokio::test]
+async fn e2e_send_transaction_batch_empty_is_bad_request() {
+    let api_state = create_test_api_state();
+    let app = create_router(api_state);
+
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/transactions/batch")
+        .header("content-type", "application/json")
+        .body(Body::from(r#"{"transactions":[]}"#))
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+
+    assert_eq!(response.status(), StatusCode::BAD_REQUEST);
+}
+
+#[tokio::test]
+async fn e2e_send_transaction_batch_bincode() {
+    let api_state = create_test_api_state();
+    let app = create_router(api_state);
+
+    let transfer = Transaction::Transfer {
+        from: [1u8; 32],
+        to: [2u8; 32],
+        amount: 10,
+        fee: 1,
+        nonce: 0,
+        chain_id: None,
+        valid_until_height: None,
+        signature: vec![0u8; 64],
+    };
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/transactions/batch")
+        .header("content-type", BINCODE_CONTENT_TYPE)
+        .header("accept", BINCODE_CONTENT_TYPE)
+        .body(Body::from(bincode::serialize(&vec![transfer.clone()]).unwrap()))
+        .unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    assert_eq!(response.headers()["content-type"], BINCODE_CONTENT_TYPE);
+
+    // ApiResponse<Vec<BatchTransactionResult>> as tuples: same bincode layout as the structs
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let (success, data, error): (bool, Option<Vec<(Option<String>, String, Option<String>)>>, Option<String>) =
+        bincode::deserialize(&bytes).unwrap();
+    assert!(success);
+    assert!(error.is_none());
+    let results = data.unwrap();
+    assert_eq!(results.len(), 1);
+    assert_eq!(results[0].0.as_deref(), Some(hash_to_hex(&transfer.hash()).as_str()));
+    assert_eq!(results[0].1, "rejected");
+
+    // Truncated body
+    let mut truncated = bincode::serialize(&vec![transfer]).unwrap();
+    truncated.truncate(truncated.len() - 1);
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/transactions/batch")
+        .header("content-type", BINCODE_CONTENT_TYPE)
+        .body(Body::from(truncated))
+        .unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::BAD_REQUEST);
+
+    // Read endpoints follow Accept
+    let req = Request::builder()
+        .uri(format!("/api/v1/accounts/{}/balance", "05".repeat(32)))
+        .header("accept", BINCODE_CONTENT_TYPE)
+        .body(Body::empty())
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let balance: (bool, Option<u64>, Option<String>) = bincode::deserialize(&bytes).unwrap();
+    assert_eq!(balance, (true, Some(0), None));
+}
+
+#[tokio::test]
+async fn e2e_get_asset_blob_range_and_resume() {
+    let api_state = create_test_api_state();
+    let blob: Vec<u8> = (0..3000u32).map(|i| (i % 251) as u8).collect();
+    let blob_hash = api_state.blob_storage.store_blob("model", &blob).unwrap();
+
+    let asset_id = [7u8; 32];
+    insert_test_asset(
+        &api_state,
+        asset_id,
+        DensityLevel::Core,
+        std::collections::HashMap::new(),
+        std::collections::HashMap::from([("model".to_string(), blob_hash)]),
+    );
+    let app = create_router(api_state);
+    let uri = format!("/api/v1/assets/{}/blob/model", hex::encode(asset_id));
+    let etag = format!("\"{}\"", hex::encode(blob_hash));
+
+    // Resume from the middle
+    let req = Request::builder()
+        .uri(&uri)
+        .header("range", "bytes=1000-1999")
+        .header("if-range", &etag)
+        .body(Body::empty())
+        .unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::PARTIAL_CONTENT);
+    assert_eq!(response.headers()["content-range"], "bytes 1000-1999/3000");
+    assert_eq!(response.headers()["etag"], etag.as_str());
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    assert_eq!(&bytes[..], &blob[1000..2000]);
+
+    // Past the end
+    let req = Request::builder()
+        .uri(&uri)
+        .header("range", "bytes=3000-")
+        .body(Body::empty())
+        .unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::RANGE_NOT_SATISFIABLE);
+    assert_eq!(response.headers()["content-range"], "bytes */3000");
+
+    // Stale If-Range: whole blob
+    let req = Request::builder()
+        .uri(&uri)
+        .header("range", "bytes=1000-1999")
+        .header("if-range", "\"stale\"")
+        .body(Body::empty())
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    assert_eq!(response.headers()["accept-ranges"], "bytes");
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    assert_eq!(&bytes[..], &blob[..]);
+}
+
+#[tokio::test]
+async fn e2e_compresses_large_responses_only() {
+    let api_state = create_test_api_state();
+    let metadata = (0..200)
+        .map(|i| (format!("key_{:03}", i), "repetitive metadata value".to_string()))
+        .collect();
+    let blob = vec![0u8; 4096];
+    let blob_hash = api_state.blob_storage.store_blob("model", &blob).unwrap();
+    let asset_id = [8u8; 32];
+    insert_test_asset(
+        &api_state,
+        asset_id,
+        DensityLevel::Core,
+        metadata,
+        std::collections::HashMap::from([("model".to_string(), blob_hash)]),
+    );
+    let app = create_router(api_state);
+    let uri = format!("/api/v1/assets/{}", hex::encode(asset_id));
+
+    let get = |uri: String, encoding: Option<&'static str>, range: Option<&'static str>| {
+        let mut req = Request::builder().uri(uri);
+        if let Some(encoding) = encoding {
+            req = req.header("accept-encoding", encoding);
+        }
+        if let Some(range) = range {
+            req = req.header("range", range);
+        }
+        req.body(Body::empty()).unwrap()
+    };
+
+    let plain = app.clone().oneshot(get(uri.clone(), None, None)).await.unwrap();
+    assert!(plain.headers().get("content-encoding").is_none());
+    let plain_len = axum::body::to_bytes(plain.into_body(), usize::MAX).await.unwrap().len();
+
+    for encoding in ["gzip", "zstd"] {
+        let response = app.clone().oneshot(get(uri.clone(), Some(encoding), None)).await.unwrap();
+        assert_eq!(response.status(), StatusCode::OK);
+        assert_eq!(response.headers()["content-encoding"], encoding);
+        let len = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap().len();
+        assert!(len * 4 < plain_len, "{}: {} vs {} bytes", encoding, len, plain_len);
+    }
+
+    // Small bodies and byte ranges stay identity
+    let response = app.clone().oneshot(get("/health".to_string(), Some("gzip"), None)).await.unwrap();
+    assert!(response.headers().get("content-encoding").is_none());
+    let blob_uri = format!("{}/blob/model", uri);
+    let response = app.clone().oneshot(get(blob_uri.clone(), Some("gzip"), Some("bytes=0-2047"))).await.unwrap();
+    assert_eq!(response.status(), StatusCode::PARTIAL_CONTENT);
+    assert!(response.headers().get("content-encoding").is_none());
+    // A Range request is answered in identity coding even where the route ignores the range
+    let response = app.clone().oneshot(get(uri.clone(), Some("gzip"), Some("bytes=0-99"))).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    assert!(response.headers().get("content-encoding").is_none());
+
+    // Whole blobs are streamed as stored, with their strong ETag
+    let response = app.clone().oneshot(get(blob_uri, Some("gzip"), None)).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    assert!(response.headers().get("content-encoding").is_none());
+    assert_eq!(response.headers()["etag"], format!("\"{}\"", hex::encode(blob_hash)));
+}
+
+#[tokio::test]
+async fn e2e_asset_summaries_batch() {
+    let api_state = create_test_api_state();
+    let asset_id = [8u8; 32];
+    insert_test_asset(
+        &api_state,
+        asset_id,
+        DensityLevel::Light,
+        std::collections::HashMap::from([("name".to_string(), "Cloak".to_string())]),
+        std::collections::HashMap::new(),
+    );
+    let app = create_router(api_state);
+
+    let body = serde_json::json!({ "asset_ids": [hex::encode(asset_id), "00".repeat(32), "not-hex"] });
+    let req = Request::builder()
+        .method("POST")
+        .uri("/api/v1/assets/summaries")
+        .header("content-type", "application/json")
+        .body(Body::from(serde_json::to_vec(&body).unwrap()))
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    let summaries = json["data"].as_array().unwrap();
+    assert_eq!(summaries.len(), 3);
+    assert_eq!(summaries[0]["density"], "Light");
+    assert_eq!(summaries[0]["metadata"]["name"], "Cloak");
+    assert_eq!(summaries[0]["metadata_truncated"], false);
+    assert!(summaries[1].is_null());
+    assert!(summaries[2].is_null());
+}
+
+#[tokio::test]
+async fn e2e_search_assets_summary_pages_are_stable() {
+    let api_state = create_test_api_state();
+    // Equal created_at everywhere, so only the id tie-break keeps pages apart
+    for i in 1..=5u8 {
+        insert_test_asset(
+            &api_state,
+            [i; 32],
+            DensityLevel::Ethereal,
+            std::collections::HashMap::from([("name".to_string(), format!("item {}", i))]),
+            std::collections::HashMap::new(),
+        );
+    }
+    let app = create_router(api_state);
+
+    let mut seen = Vec::new();
+    for offset in [0, 2, 4] {
+        let req = Request::builder()
+            .uri(format!("/api/v1/assets/search?view=summary&limit=2&offset={}", offset))
+            .body(Body::empty())
+            .unwrap();
+        let response = app.clone().oneshot(req).await.unwrap();
+        assert_eq!(response.status(), StatusCode::OK);
+        let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+        let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+        for entry in json["data"].as_array().unwrap() {
+            assert!(entry.get("attributes").is_none());
+            assert_eq!(entry["attribute_count"], 0);
+            seen.push(entry["asset_id"].as_str().unwrap().to_string());
+        }
+    }
+    let expected: Vec<String> = (1..=5u8).map(|i| hex::encode([i; 32])).collect();
+    assert_eq!(seen, expected);
+}
+
+#[tokio::test]
+async fn e2e_asset_versions_since_sends_delta() {
+    let api_state = create_test_api_state();
+    let asset_id = [9u8; 32];
+    insert_test_asset(
+        &api_state,
+        asset_id,
+        DensityLevel::Core,
+        std::collections::HashMap::new(),
+        std::collections::HashMap::from([("mesh".to_string(), [1u8; 32])]),
+    );
+    api_state.state.create_asset_snapshot(&asset_id).unwrap();
+    api_state.state.assets().get_mut(&asset_id).unwrap().blob_refs.insert("texture".to_string(), [2u8; 32]);
+    api_state.state.create_asset_snapshot(&asset_id).unwrap();
+    let app = create_router(api_state);
+
+    let req = Request::builder()
+        .uri(format!("/api/v1/assets/{}/versions?since=1", hex::encode(asset_id)))
+        .body(Body::empty())
+        .unwrap();
+    let response = app.clone().oneshot(req).await.unwrap();
+    assert_eq!(response.status(), StatusCode::OK);
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    assert_eq!(json["data"]["current_version"], 2);
+    let versions = json["data"]["versions"].as_array().unwrap();
+    assert_eq!(versions.len(), 1);
+    assert_eq!(versions[0]["version"], 2);
+    assert_eq!(versions[0]["blob_refs_base"], 1);
+    assert_eq!(versions[0]["blob_refs"], serde_json::json!({ "texture": hex::encode([2u8; 32]) }));
+
+    // Without since: the full list, unchanged
+    let req = Request::builder()
+        .uri(format!("/api/v1/assets/{}/versions", hex::encode(asset_id)))
+        .body(Body::empty())
+        .unwrap();
+    let response = app.oneshot(req).await.unwrap();
+    let bytes = axum::body::to_bytes(response.into_body(), usize::MAX).await.unwrap();
+    let json: serde_json::Value = serde_json::from_slice(&bytes).unwrap();
+    let versions = json["data"].as_array().unwrap();
+    assert_eq!(versions.len(), 2);
+    assert_eq!(versions[1]["blob_refs"].as_object().unwrap().len(), 2);
+}
@@ -43,18 +43,29 @@ namespace Haze.Tests
                 Debug.Log($"Payload hex: {Utils.BytesToHex(payload)}");
                 
                 // Verify payload structure:
-                // "Transfer" (7 bytes) + from (32) + to (32) + amount (8) + fee (8) + nonce (8) = 95 bytes
-                if (payload.Length == 95)
+                // "Transfer" (8 bytes) + from (32) + to (32) + amount (8) + fee (8) + nonce (8) = 96 bytes
+                if (payload.Length == 96)
                 {
-                    Debug.Log("✓ Payload length correct (95 bytes for Transfer without chain fields)");
+                    Debug.Log("✓ Payload length correct (96 bytes for Transfer without chain fields)");
                 }
                 else
                 {
-                    Debug.LogWarning($"⚠ Payload length: {payload.Length} (expected 95)");
+                    Debug.LogWarning($"⚠ Payload length: {payload.Length} (expected 96)");
+                }
+                
+                // Same vector as test_signing_payload_vectors (src/consensus.rs) and the Unreal plugin tests
+                const string expectedHex = "5472616e736665720100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000040420f0000000000e8030000000000000500000000000000";
+                if (Utils.BytesToHex(payload) == expectedHex)
+                {
+                    Debug.Log("✓ Payload matches the node's vector byte for byte");
+                }
+                else
+                {
+                    Debug.LogError($"✗ Payload differs from the node's vector\n  got:      {Utils.BytesToHex(payload)}\n  expected: {expectedHex}");
                 }
                 
                 // Verify "Transfer" prefix
-                var prefix = System.Text.Encoding.UTF8.GetString(payload.Take(7).ToArray());
+                var prefix = System.Text.Encoding.UTF8.GetString(payload.Take(8).ToArray());
                 if (prefix == "Transfer")
                 {
                     Debug.Log("✓ Payload starts with 'Transfer'");
@@ -20,7 +20,8 @@ public class HazeBlockchain : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
 			"CoreUObject",
-			"Engine"
+			"Engine",
+			"WebSockets"
 		});
 
 		// Ed25519: optional ThirdParty. If ThirdParty/ed25519 exists with lib, link it.
@@ -0,0 +1,360 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeAccountLedger.h"
+#include "HazeChainFollower.h"
+#include "HazeEventStream.h"
+#include "HazeTxSubmitter.h"
+
+UHazeAccountLedger* UHazeAccountLedger::CreateAccountLedger(UHazeClient* InClient)
+{
+	UHazeAccountLedger* Ledger = NewObject<UHazeAccountLedger>();
+	Ledger->Client = InClient;
+	return Ledger;
+}
+
+FString UHazeAccountLedger::KeyFor(const FString& Address)
+{
+	// The node prints addresses in lower case
+	return Address.ToLower();
+}
+
+void UHazeAccountLedger::Watch(const FString& Address)
+{
+	const FString Key = KeyFor(Address);
+	if (Key.IsEmpty() || Accounts.Contains(Key)) return;
+	Accounts.Add(Key);
+	Refresh(Key);
+}
+
+void UHazeAccountLedger::Unwatch(const FString& Address)
+{
+	const FString Key = KeyFor(Address);
+	FAccount Account;
+	if (!Accounts.RemoveAndCopyValue(Key, Account)) return;
+	for (const FDelta& Delta : Account.Pending)
+	{
+		FEntry* Entry = Entries.Find(Delta.EntryId);
+		if (!Entry) continue;
+		Entry->Accounts.Remove(Key);
+		if (Entry->Accounts.Num() == 0) RemoveEntry(Delta.EntryId);
+	}
+}
+
+void UHazeAccountLedger::Refresh(const FString& Address)
+{
+	const FString Key = KeyFor(Address);
+	FAccount* Account = Accounts.Find(Key);
+	if (!Account || !Client) return;
+	if (Account->bFetching)
+	{
+		// The answer in flight may predate what the caller knows; ask again once it is in
+		Account->bRefetch = true;
+		return;
+	}
+	Account->bFetching = true;
+	Account->RequestedAt = ++Clock;
+	// A cached account may be older than the block that prompted this fetch
+	Client->InvalidateAccount(Key);
+	Client->FetchAccount(Key, [WeakThis = TWeakObjectPtr<UHazeAccountLedger>(this), Key](bool bOk, const FAccountInfo& Info)
+	{
+		UHazeAccountLedger* This = WeakThis.Get();
+		if (!This) return;
+		FAccount* Account = This->Accounts.Find(Key);
+		if (!Account) return;
+		Account->bFetching = false;
+		if (bOk)
+		{
+			This->ApplyFetched(Key, Info, Account->RequestedAt);
+			Account = This->Accounts.Find(Key);
+		}
+		if (Account && Account->bRefetch)
+		{
+			Account->bRefetch = false;
+			This->Refresh(Key);
+		}
+	});
+}
+
+void UHazeAccountLedger::BindEventStream(UHazeEventStream* Stream)
+{
+	if (Stream)
+	{
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = EHazeStreamEventType::BlockApplied;
+		Stream->Subscribe(Subscription);
+		Stream->OnEventNative().AddUObject(this, &UHazeAccountLedger::HandleStreamEvent);
+	}
+}
+
+void UHazeAccountLedger::BindChainFollower(UHazeChainFollower* InFollower)
+{
+	UHazeChainFollower* Previous = BoundFollower.Get();
+	for (TPair<int64, FEntry>& Pair : Entries)
+	{
+		if (Previous && Pair.Value.FollowerListener != 0)
+		{
+			Previous->RemoveReceiptListener(Pair.Value.TxHash, Pair.Value.FollowerListener);
+		}
+		Pair.Value.FollowerListener = 0;
+	}
+	BoundFollower = InFollower;
+	TArray<int64> Tracked;
+	EntryByHash.GenerateValueArray(Tracked);
+	for (const int64 EntryId : Tracked)
+	{
+		TrackOnFollower(EntryId);
+	}
+}
+
+void UHazeAccountLedger::HandleStreamEvent(const FHazeStreamEvent& Event)
+{
+	if (Event.Type != EHazeStreamEventType::BlockApplied) return;
+	for (const FString& TxHash : Event.Transactions)
+	{
+		MarkIncluded(TxHash);
+	}
+	// Transfers from other players, fees, rewards: anything that moved a watched balance
+	for (const FString& Address : Event.Accounts)
+	{
+		Refresh(Address);
+	}
+}
+
+void UHazeAccountLedger::TrackOnFollower(int64 EntryId)
+{
+	UHazeChainFollower* Follower = BoundFollower.Get();
+	const FEntry* Entry = Entries.Find(EntryId);
+	if (!Follower || !Entry) return;
+	// Other systems may wait on the same hash, so the ledger removes only its own listener (RemoveEntry)
+	const FString TxHash = Entry->TxHash;
+	const uint64 Listener = Follower->TrackTransactionNative(TxHash, [WeakThis = TWeakObjectPtr<UHazeAccountLedger>(this)](const FHazeReceipt& Receipt)
+	{
+		UHazeAccountLedger* This = WeakThis.Get();
+		if (!This) return;
+		if (Receipt.Status == EHazeReceiptStatus::Pending)
+		{
+			This->MarkReverted(Receipt.TxHash);
+		}
+		else
+		{
+			This->MarkIncluded(Receipt.TxHash);
+		}
+	});
+	// Found again: a block already held confirms at once, and the callback may have changed Entries
+	if (FEntry* Current = Entries.Find(EntryId))
+	{
+		Current->FollowerListener = Listener;
+	}
+	else
+	{
+		Follower->RemoveReceiptListener(TxHash, Listener);
+	}
+}
+
+FHazeAmount UHazeAccountLedger::GetProjectedBalance(const FString& Address) const
+{
+	const FAccount* Account = Accounts.Find(KeyFor(Address));
+	if (!Account) return FHazeAmount();
+	FHazeAmount Balance = Account->Confirmed.Balance;
+	for (const FDelta& Delta : Account->Pending)
+	{
+		if (!FHazeAmount::TryAdd(Balance, Delta.Credit, Balance)) Balance = FHazeAmount::MaxValue();
+	}
+	for (const FDelta& Delta : Account->Pending)
+	{
+		// Debits after credits: an incoming transfer can fund an outgoing one. Never below zero on screen.
+		if (!FHazeAmount::TrySubtract(Balance, Delta.Debit, Balance)) Balance = FHazeAmount();
+	}
+	return Balance;
+}
+
+int64 UHazeAccountLedger::GetProjectedNonce(const FString& Address) const
+{
+	const FAccount* Account = Accounts.Find(KeyFor(Address));
+	if (!Account) return 0;
+	int64 Nonce = Account->Confirmed.Nonce;
+	for (const FDelta& Delta : Account->Pending)
+	{
+		if (Delta.bOutgoing) Nonce++;
+	}
+	return Nonce;
+}
+
+bool UHazeAccountLedger::GetConfirmedAccount(const FString& Address, FAccountInfo& OutInfo) const
+{
+	const FAccount* Account = Accounts.Find(KeyFor(Address));
+	if (!Account || !Account->bLoaded) return false;
+	OutInfo = Account->Confirmed;
+	return true;
+}
+
+int32 UHazeAccountLedger::GetPendingCount(const FString& Address) const
+{
+	const FAccount* Account = Accounts.Find(KeyFor(Address));
+	return Account ? Account->Pending.Num() : 0;
+}
+
+int64 UHazeAccountLedger::AddPendingTransfer(const FString& From, const FString& To, const FHazeAmount& Amount, const FHazeAmount& Fee)
+{
+	const FString FromKey = KeyFor(From);
+	const FString ToKey = KeyFor(To);
+	const bool bFrom = Accounts.Contains(FromKey);
+	const bool bTo = Accounts.Contains(ToKey);
+	if (!bFrom && !bTo) return 0;
+
+	const int64 EntryId = NextEntryId++;
+	Entries.Add(EntryId);
+	if (bFrom)
+	{
+		FHazeAmount Debit;
+		if (!FHazeAmount::TryAdd(Amount, Fee, Debit)) Debit = FHazeAmount::MaxValue();
+		AddDelta(FromKey, EntryId, FHazeAmount(), Debit, true);
+	}
+	if (bTo)
+	{
+		// A transfer to oneself only costs the fee
+		AddDelta(ToKey, EntryId, Amount, FHazeAmount(), false);
+	}
+	return EntryId;
+}
+
+void UHazeAccountLedger::AddDelta(const FString& Key, int64 EntryId, const FHazeAmount& Credit, const FHazeAmount& Debit, bool bOutgoing)
+{
+	FDelta& Delta = Accounts[Key].Pending.AddDefaulted_GetRef();
+	Delta.EntryId = EntryId;
+	Delta.Credit = Credit;
+	Delta.Debit = Debit;
+	Delta.bOutgoing = bOutgoing;
+	Entries[EntryId].Accounts.AddUnique(Key);
+	Broadcast(Key);
+}
+
+void UHazeAccountLedger::SetTransactionHash(int64 EntryId, const FString& TxHash)
+{
+	FEntry* Entry = Entries.Find(EntryId);
+	const FString Hash = TxHash.ToLower();
+	if (!Entry || Hash.IsEmpty() || !Entry->TxHash.IsEmpty()) return;
+	Entry->TxHash = Hash;
+	EntryByHash.Add(Hash, EntryId);
+	TrackOnFollower(EntryId);
+}
+
+void UHazeAccountLedger::Fail(int64 EntryId)
+{
+	const FEntry* Entry = Entries.Find(EntryId);
+	if (!Entry) return;
+	const TArray<FString> Touched = Entry->Accounts;
+	RemoveEntry(EntryId);
+	for (const FString& Key : Touched)
+	{
+		if (FAccount* Account = Accounts.Find(Key))
+		{
+			Account->Pending.RemoveAll([EntryId](const FDelta& Delta) { return Delta.EntryId == EntryId; });
+			Broadcast(Key);
+		}
+	}
+}
+
+bool UHazeAccountLedger::SubmitTransfer(UHazeTxSubmitter* Submitter, const FString& TransactionJson, const FString& From, const FString& To,
+	const FHazeAmount& Amount, const FHazeAmount& Fee, FHazeOnTransaction OnComplete, TOptional<uint64> Nonce)
+{
+	if (!Submitter) return false;
+	const int64 EntryId = AddPendingTransfer(From, To, Amount, Fee);
+	const bool bQueued = Submitter->Submit(TransactionJson, EHazeTxPriority::Normal, KeyFor(From),
+		[WeakThis = TWeakObjectPtr<UHazeAccountLedger>(this), EntryId, OnComplete = MoveTemp(OnComplete)]
+		(bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
+	{
+		if (UHazeAccountLedger* This = WeakThis.Get())
+		{
+			if (bAccepted)
+			{
+				This->SetTransactionHash(EntryId, Response.Hash);
+			}
+			else
+			{
+				This->Fail(EntryId);
+			}
+		}
+		if (OnComplete) OnComplete(bAccepted, Response, ResponseCode);
+	}, Nonce);
+	if (!bQueued)
+	{
+		Fail(EntryId);
+	}
+	return bQueued;
+}
+
+void UHazeAccountLedger::MarkIncluded(const FString& TxHash)
+{
+	const int64* EntryId = EntryByHash.Find(TxHash.ToLower());
+	FEntry* Entry = EntryId ? Entries.Find(*EntryId) : nullptr;
+	if (!Entry || Entry->IncludedAt != 0) return;
+	Entry->IncludedAt = ++Clock;
+	RefreshEntryAccounts(*Entry);
+}
+
+void UHazeAccountLedger::MarkReverted(const FString& TxHash)
+{
+	const int64* EntryId = EntryByHash.Find(TxHash.ToLower());
+	FEntry* Entry = EntryId ? Entries.Find(*EntryId) : nullptr;
+	if (!Entry || Entry->IncludedAt == 0) return;
+	// Accounts that already settled the entry learn of the replacement block from their next fetch
+	Entry->IncludedAt = 0;
+	RefreshEntryAccounts(*Entry);
+}
+
+void UHazeAccountLedger::RefreshEntryAccounts(const FEntry& Entry)
+{
+	const TArray<FString> Touched = Entry.Accounts;
+	for (const FString& Key : Touched)
+	{
+		Refresh(Key);
+	}
+}
+
+void UHazeAccountLedger::ApplyAccount(const FString& Address, const FAccountInfo& Info)
+{
+	ApplyFetched(KeyFor(Address), Info, ++Clock);
+}
+
+void UHazeAccountLedger::ApplyFetched(const FString& Key, const FAccountInfo& Info, uint64 RequestedAt)
+{
+	FAccount* Account = Accounts.Find(Key);
+	if (!Account) return;
+	Account->Confirmed = Info;
+	Account->bLoaded = true;
+
+	// Entries included before the fetch was sent are part of Info now
+	TArray<int64> Settled;
+	Account->Pending.RemoveAll([this, RequestedAt, &Settled](const FDelta& Delta)
+	{
+		const FEntry* Entry = Entries.Find(Delta.EntryId);
+		if (Entry && (Entry->IncludedAt == 0 || Entry->IncludedAt > RequestedAt)) return false;
+		Settled.Add(Delta.EntryId);
+		return true;
+	});
+	for (const int64 EntryId : Settled)
+	{
+		FEntry* Entry = Entries.Find(EntryId);
+		if (!Entry) continue;
+		Entry->Accounts.Remove(Key);
+		if (Entry->Accounts.Num() == 0) RemoveEntry(EntryId);
+	}
+	Broadcast(Key);
+}
+
+void UHazeAccountLedger::RemoveEntry(int64 EntryId)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(EntryId, Entry) || Entry.TxHash.IsEmpty()) return;
+	EntryByHash.Remove(Entry.TxHash);
+	if (UHazeChainFollower* Follower = BoundFollower.Get())
+	{
+		Follower->RemoveReceiptListener(Entry.TxHash, Entry.FollowerListener);
+	}
+}
+
+void UHazeAccountLedger::Broadcast(const FString& Key)
+{
+	OnBalanceChanged.Broadcast(Key, GetProjectedBalance(Key));
+}
@@ -0,0 +1,160 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeAmm.h"
+
+namespace
+{
+	/** Doublings before QuoteExactOut gives up on an upper bound; 2^65 is past every u64 input */
+	constexpr int32 MaxBoundSteps = 65;
+
+	bool ResolveSides(const FLiquidityPool& Pool, const FString& AssetIn, FHazeAmount& OutReserveIn, FHazeAmount& OutReserveOut, FString& OutAssetOut)
+	{
+		if (AssetIn == Pool.Asset1)
+		{
+			OutReserveIn = Pool.Reserve1;
+			OutReserveOut = Pool.Reserve2;
+			OutAssetOut = Pool.Asset2;
+			return true;
+		}
+		if (AssetIn == Pool.Asset2)
+		{
+			OutReserveIn = Pool.Reserve2;
+			OutReserveOut = Pool.Reserve1;
+			OutAssetOut = Pool.Asset1;
+			return true;
+		}
+		return false;
+	}
+}
+
+EHazeSwapQuoteStatus FHazeAmm::QuoteExactIn(const FHazeAmount& ReserveIn, const FHazeAmount& ReserveOut, int32 FeeRate,
+	const FHazeAmount& AmountIn, FHazeSwapQuote& Out)
+{
+	const FHazeAmount U64Max(MAX_uint64);
+	Out.AmountIn = AmountIn;
+	Out.Fee = FHazeAmount();
+	Out.AmountOut = FHazeAmount();
+	Out.NewReserveIn = ReserveIn;
+	Out.NewReserveOut = ReserveOut;
+	Out.PriceImpact = 0.f;
+
+	// The node keeps all of these in u64 and would overflow (or underflow amount_in - fee) outside this range
+	FHazeAmount Scaled;
+	if (FeeRate < 0 || FeeRate > FeeDenominator || !ReserveIn.FitsUint64() || !ReserveOut.FitsUint64()
+		|| !FHazeAmount::TryMultiply(AmountIn, FHazeAmount(static_cast<uint64>(FeeRate)), Scaled) || Scaled > U64Max)
+	{
+		return Out.Status = EHazeSwapQuoteStatus::OutOfRange;
+	}
+	Out.Fee = Scaled / FHazeAmount(FeeDenominator);
+	// With a zero fee AmountIn itself can reach 2^128; the sum must not wrap into a small (or zero) reserve
+	FHazeAmount NewReserveIn;
+	if (!FHazeAmount::TryAdd(ReserveIn, AmountIn - Out.Fee, NewReserveIn) || NewReserveIn > U64Max)
+	{
+		return Out.Status = EHazeSwapQuoteStatus::OutOfRange;
+	}
+	if (NewReserveIn.IsZero())
+	{
+		return Out.Status = EHazeSwapQuoteStatus::InsufficientLiquidity;
+	}
+
+	// Both reserves fit u64, so k fits in 128 bits and the floored quotient fits u64 again
+	const FHazeAmount NewReserveOut = (ReserveIn * ReserveOut) / NewReserveIn;
+	if (NewReserveOut >= ReserveOut)
+	{
+		return Out.Status = EHazeSwapQuoteStatus::InsufficientLiquidity;
+	}
+	Out.AmountOut = ReserveOut - NewReserveOut;
+	Out.NewReserveIn = NewReserveIn;
+	Out.NewReserveOut = NewReserveOut;
+
+	// Spot is ReserveOut / ReserveIn; execution AmountOut / AmountIn
+	const double Spot = ReserveOut.ToDouble() * AmountIn.ToDouble();
+	Out.PriceImpact = Spot > 0.0 ? FMath::Clamp(static_cast<float>(1.0 - Out.AmountOut.ToDouble() * ReserveIn.ToDouble() / Spot), 0.f, 1.f) : 0.f;
+	return Out.Status = EHazeSwapQuoteStatus::Ok;
+}
+
+EHazeSwapQuoteStatus FHazeAmm::QuoteExactIn(const FLiquidityPool& Pool, const FString& AssetIn, const FHazeAmount& AmountIn, FHazeSwapQuote& Out)
+{
+	Out.PoolId = Pool.PoolId;
+	Out.AssetIn = AssetIn;
+	FHazeAmount ReserveIn, ReserveOut;
+	if (!ResolveSides(Pool, AssetIn, ReserveIn, ReserveOut, Out.AssetOut))
+	{
+		Out.AssetOut.Reset();
+		Out.AmountIn = AmountIn;
+		Out.AmountOut = FHazeAmount();
+		return Out.Status = EHazeSwapQuoteStatus::AssetNotInPool;
+	}
+	return QuoteExactIn(ReserveIn, ReserveOut, Pool.FeeRate, AmountIn, Out);
+}
+
+EHazeSwapQuoteStatus FHazeAmm::QuoteExactOut(const FLiquidityPool& Pool, const FString& AssetIn, const FHazeAmount& AmountOut, FHazeSwapQuote& Out)
+{
+	Out.PoolId = Pool.PoolId;
+	Out.AssetIn = AssetIn;
+	FHazeAmount ReserveIn, ReserveOut;
+	if (!ResolveSides(Pool, AssetIn, ReserveIn, ReserveOut, Out.AssetOut))
+	{
+		Out.AssetOut.Reset();
+		Out.AmountIn = FHazeAmount();
+		Out.AmountOut = FHazeAmount();
+		return Out.Status = EHazeSwapQuoteStatus::AssetNotInPool;
+	}
+	if (AmountOut.IsZero() || AmountOut > ReserveOut)
+	{
+		QuoteExactIn(ReserveIn, ReserveOut, Pool.FeeRate, FHazeAmount(), Out);
+		return Out.Status = EHazeSwapQuoteStatus::InsufficientLiquidity;
+	}
+
+	// Output is monotonic in input, and so is running out of the node's range; bisect for the first input that is
+	// either enough or out of range, which then settles which of the two the answer is
+	const auto Reaches = [&](const FHazeAmount& AmountIn)
+	{
+		const EHazeSwapQuoteStatus Status = QuoteExactIn(ReserveIn, ReserveOut, Pool.FeeRate, AmountIn, Out);
+		return Status == EHazeSwapQuoteStatus::OutOfRange || (Status == EHazeSwapQuoteStatus::Ok && Out.AmountOut >= AmountOut);
+	};
+	FHazeAmount Low;
+	FHazeAmount High(1);
+	for (int32 Steps = 0; !Reaches(High); Steps++)
+	{
+		if (Steps == MaxBoundSteps)
+		{
+			return Out.Status = EHazeSwapQuoteStatus::InsufficientLiquidity;
+		}
+		Low = High;
+		High = High + High;
+	}
+	// Invariant: Low falls short, High reaches AmountOut (or is out of range)
+	while (High - Low > FHazeAmount(1))
+	{
+		const FHazeAmount Mid = Low + (High - Low) / FHazeAmount(2);
+		if (Reaches(Mid))
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid;
+		}
+	}
+	return QuoteExactIn(ReserveIn, ReserveOut, Pool.FeeRate, High, Out);
+}
+
+void FHazeAmm::ApplyQuote(FLiquidityPool& Pool, const FHazeSwapQuote& Quote)
+{
+	if (!Quote.IsValid())
+	{
+		return;
+	}
+	// Same precedence as the node: Asset1 first
+	if (Quote.AssetIn == Pool.Asset1)
+	{
+		Pool.Reserve1 = Quote.NewReserveIn;
+		Pool.Reserve2 = Quote.NewReserveOut;
+	}
+	else if (Quote.AssetIn == Pool.Asset2)
+	{
+		Pool.Reserve2 = Quote.NewReserveIn;
+		Pool.Reserve1 = Quote.NewReserveOut;
+	}
+}
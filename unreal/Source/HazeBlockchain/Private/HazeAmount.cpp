@@ -0,0 +1,268 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeAmount.h"
+
+namespace
+{
+	constexpr uint64 Pow10[20] =
+	{
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+		10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+		1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+		10000000000000000000ull
+	};
+
+	/** Digits of a uint64 that always fit one chunk (10^19 - 1 is the largest) */
+	constexpr int32 ChunkDigits = 19;
+
+	/** Full 128-bit product of two 64-bit values */
+	FHazeAmount Multiply64(uint64 A, uint64 B)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 Product = static_cast<unsigned __int128>(A) * B;
+		return FHazeAmount::FromParts(static_cast<uint64>(Product >> 64), static_cast<uint64>(Product));
+#else
+		const uint64 ALo = A & 0xffffffffull, AHi = A >> 32;
+		const uint64 BLo = B & 0xffffffffull, BHi = B >> 32;
+		const uint64 LoLo = ALo * BLo;
+		const uint64 HiLo = AHi * BLo;
+		const uint64 LoHi = ALo * BHi;
+		// Cannot overflow: at most (2^32 - 1) + (2^32 - 1) + (2^32 - 1)^2
+		const uint64 Cross = (LoLo >> 32) + (HiLo & 0xffffffffull) + LoHi;
+		return FHazeAmount::FromParts(AHi * BHi + (HiLo >> 32) + (Cross >> 32), (Cross << 32) | (LoLo & 0xffffffffull));
+#endif
+	}
+
+	/** Value /= Divisor in 32-bit limbs; returns the remainder */
+	uint32 DivideSmall(FHazeAmount& Value, uint32 Divisor)
+	{
+		uint32 Limbs[4] = { static_cast<uint32>(Value.High >> 32), static_cast<uint32>(Value.High),
+			static_cast<uint32>(Value.Low >> 32), static_cast<uint32>(Value.Low) };
+		uint64 Remainder = 0;
+		for (uint32& Limb : Limbs)
+		{
+			const uint64 Current = (Remainder << 32) | Limb;
+			Limb = static_cast<uint32>(Current / Divisor);
+			Remainder = Current % Divisor;
+		}
+		Value.High = (static_cast<uint64>(Limbs[0]) << 32) | Limbs[1];
+		Value.Low = (static_cast<uint64>(Limbs[2]) << 32) | Limbs[3];
+		return static_cast<uint32>(Remainder);
+	}
+
+	int32 CountLeadingZeros(const FHazeAmount& Value)
+	{
+		return Value.High ? static_cast<int32>(FMath::CountLeadingZeros64(Value.High))
+			: 64 + static_cast<int32>(FMath::CountLeadingZeros64(Value.Low));
+	}
+
+	FHazeAmount ShiftLeft(const FHazeAmount& Value, int32 Shift)
+	{
+		if (Shift == 0) return Value;
+		if (Shift >= 64) return FHazeAmount::FromParts(Value.Low << (Shift - 64), 0);
+		return FHazeAmount::FromParts((Value.High << Shift) | (Value.Low >> (64 - Shift)), Value.Low << Shift);
+	}
+
+	/** B must be non-zero */
+	void DivMod(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& OutQuotient, FHazeAmount& OutRemainder)
+	{
+		if ((A.High | B.High) == 0)
+		{
+			OutQuotient = FHazeAmount(A.Low / B.Low);
+			OutRemainder = FHazeAmount(A.Low % B.Low);
+			return;
+		}
+		if (A < B)
+		{
+			OutQuotient = FHazeAmount();
+			OutRemainder = A;
+			return;
+		}
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 Dividend = (static_cast<unsigned __int128>(A.High) << 64) | A.Low;
+		const unsigned __int128 Divisor = (static_cast<unsigned __int128>(B.High) << 64) | B.Low;
+		const unsigned __int128 Quotient = Dividend / Divisor;
+		const unsigned __int128 Remainder = Dividend - Quotient * Divisor;
+		OutQuotient = FHazeAmount::FromParts(static_cast<uint64>(Quotient >> 64), static_cast<uint64>(Quotient));
+		OutRemainder = FHazeAmount::FromParts(static_cast<uint64>(Remainder >> 64), static_cast<uint64>(Remainder));
+#else
+		if (B.High == 0 && B.Low <= MAX_uint32)
+		{
+			OutQuotient = A;
+			OutRemainder = FHazeAmount(DivideSmall(OutQuotient, static_cast<uint32>(B.Low)));
+			return;
+		}
+		// Shift-subtract from the highest quotient bit A >= B allows (at most 128 steps, usually far fewer)
+		const int32 Shift = CountLeadingZeros(B) - CountLeadingZeros(A);
+		FHazeAmount Divisor = ShiftLeft(B, Shift);
+		FHazeAmount Quotient;
+		FHazeAmount Remainder = A;
+		for (int32 Bit = Shift; Bit >= 0; Bit--)
+		{
+			if (Remainder >= Divisor)
+			{
+				Remainder -= Divisor;
+				if (Bit >= 64) Quotient.High |= 1ull << (Bit - 64);
+				else Quotient.Low |= 1ull << Bit;
+			}
+			Divisor.Low = (Divisor.Low >> 1) | (Divisor.High << 63);
+			Divisor.High >>= 1;
+		}
+		OutQuotient = Quotient;
+		OutRemainder = Remainder;
+#endif
+	}
+}
+
+bool FHazeAmount::Parse(FStringView Text, FHazeAmount& Out)
+{
+	if (Text.IsEmpty()) return false;
+
+	// Whole 19-digit chunks in uint64, then one widening multiply-add per chunk (at most three for 39 digits)
+	FHazeAmount Value;
+	for (int32 Start = 0; Start < Text.Len(); Start += ChunkDigits)
+	{
+		const int32 Len = FMath::Min(ChunkDigits, Text.Len() - Start);
+		uint64 Chunk = 0;
+		for (int32 i = Start; i < Start + Len; i++)
+		{
+			const TCHAR C = Text[i];
+			if (C < TEXT('0') || C > TEXT('9')) return false;
+			Chunk = Chunk * 10 + static_cast<uint64>(C - TEXT('0'));
+		}
+		if (!TryMultiply(Value, FHazeAmount(Pow10[Len]), Value) || !TryAdd(Value, FHazeAmount(Chunk), Value)) return false;
+	}
+	Out = Value;
+	return true;
+}
+
+int32 FHazeAmount::ToChars(TCHAR* Out) const
+{
+	// Least significant digit first, nine at a time while the value is wider than 64 bits
+	TCHAR Reversed[MaxDigits];
+	int32 Count = 0;
+	FHazeAmount Value = *this;
+	while (Value.High)
+	{
+		uint32 Chunk = DivideSmall(Value, 1000000000u);
+		for (int32 i = 0; i < 9; i++)
+		{
+			Reversed[Count++] = static_cast<TCHAR>(TEXT('0') + Chunk % 10);
+			Chunk /= 10;
+		}
+	}
+	uint64 Rest = Value.Low;
+	do
+	{
+		Reversed[Count++] = static_cast<TCHAR>(TEXT('0') + Rest % 10);
+		Rest /= 10;
+	}
+	while (Rest);
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		Out[i] = Reversed[Count - 1 - i];
+	}
+	return Count;
+}
+
+void FHazeAmount::AppendTo(FString& Out) const
+{
+	TCHAR Digits[MaxDigits];
+	Out.AppendChars(Digits, ToChars(Digits));
+}
+
+FString FHazeAmount::ToString() const
+{
+	FString Out;
+	AppendTo(Out);
+	return Out;
+}
+
+FString FHazeAmount::ToDisplayString(int32 Decimals, int32 MaxFractionDigits) const
+{
+	TCHAR Digits[MaxDigits];
+	const int32 Count = ToChars(Digits);
+	Decimals = FMath::Clamp(Decimals, 0, MaxDigits);
+
+	FString Out;
+	if (Count > Decimals) Out.AppendChars(Digits, Count - Decimals);
+	else Out.AppendChar(TEXT('0'));
+
+	// Fraction is the last Decimals digits, left-padded with zeros when the value is below one token
+	TCHAR Fraction[MaxDigits];
+	int32 FractionLen = 0;
+	const int32 Shown = FMath::Clamp(MaxFractionDigits, 0, Decimals);
+	for (int32 i = 0; i < Shown; i++)
+	{
+		const int32 Index = Count - Decimals + i;
+		Fraction[FractionLen++] = Index >= 0 ? Digits[Index] : TEXT('0');
+	}
+	while (FractionLen > 0 && Fraction[FractionLen - 1] == TEXT('0')) FractionLen--;
+	if (FractionLen > 0)
+	{
+		Out.AppendChar(TEXT('.'));
+		Out.AppendChars(Fraction, FractionLen);
+	}
+	return Out;
+}
+
+bool FHazeAmount::TryAdd(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& Out)
+{
+	const FHazeAmount Sum = A + B;
+	if (Sum < A) return false;
+	Out = Sum;
+	return true;
+}
+
+bool FHazeAmount::TrySubtract(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& Out)
+{
+	if (A < B) return false;
+	Out = A - B;
+	return true;
+}
+
+bool FHazeAmount::TryMultiply(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& Out)
+{
+	if (A.High && B.High) return false;
+	const FHazeAmount Product = Multiply64(A.Low, B.Low);
+	// At most one cross term is non-zero; it must fit in the high word
+	const FHazeAmount Cross = A.High ? Multiply64(A.High, B.Low) : Multiply64(A.Low, B.High);
+	if (Cross.High) return false;
+	const uint64 High = Product.High + Cross.Low;
+	if (High < Product.High) return false;
+	Out = FromParts(High, Product.Low);
+	return true;
+}
+
+bool FHazeAmount::TryDivide(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& OutQuotient, FHazeAmount& OutRemainder)
+{
+	if (B.IsZero()) return false;
+	// Through locals, so Out may alias A or B
+	FHazeAmount Quotient, Remainder;
+	DivMod(A, B, Quotient, Remainder);
+	OutQuotient = Quotient;
+	OutRemainder = Remainder;
+	return true;
+}
+
+FHazeAmount& FHazeAmount::operator*=(const FHazeAmount& B)
+{
+	FHazeAmount Product = Multiply64(Low, B.Low);
+	Product.High += High * B.Low + Low * B.High;
+	return *this = Product;
+}
+
+FHazeAmount& FHazeAmount::operator/=(const FHazeAmount& B)
+{
+	FHazeAmount Quotient, Remainder;
+	if (!TryDivide(*this, B, Quotient, Remainder)) Quotient = FHazeAmount();
+	return *this = Quotient;
+}
+
+FHazeAmount& FHazeAmount::operator%=(const FHazeAmount& B)
+{
+	FHazeAmount Quotient, Remainder;
+	if (!TryDivide(*this, B, Quotient, Remainder)) Remainder = FHazeAmount();
+	return *this = Remainder;
+}
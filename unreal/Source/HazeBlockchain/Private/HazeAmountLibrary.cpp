@@ -0,0 +1,107 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeAmountLibrary.h"
+
+bool UHazeAmountLibrary::ParseAmount(const FString& Text, FHazeAmount& Amount)
+{
+	Amount = FHazeAmount();
+	return FHazeAmount::Parse(Text, Amount);
+}
+
+FHazeAmount UHazeAmountLibrary::Conv_Int64ToHazeAmount(int64 Value)
+{
+	return FHazeAmount(Value > 0 ? static_cast<uint64>(Value) : 0);
+}
+
+FString UHazeAmountLibrary::Conv_HazeAmountToString(const FHazeAmount& Amount)
+{
+	return Amount.ToString();
+}
+
+int64 UHazeAmountLibrary::ToInt64(const FHazeAmount& Amount)
+{
+	return static_cast<int64>(FMath::Min<uint64>(Amount.ToUint64Clamped(), MAX_int64));
+}
+
+double UHazeAmountLibrary::ToFloat(const FHazeAmount& Amount)
+{
+	return Amount.ToDouble();
+}
+
+FString UHazeAmountLibrary::ToDisplayString(const FHazeAmount& Amount, int32 Decimals, int32 MaxFractionDigits)
+{
+	return Amount.ToDisplayString(Decimals, MaxFractionDigits);
+}
+
+FHazeAmount UHazeAmountLibrary::Add_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	FHazeAmount Sum;
+	return FHazeAmount::TryAdd(A, B, Sum) ? Sum : FHazeAmount::MaxValue();
+}
+
+FHazeAmount UHazeAmountLibrary::Subtract_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	FHazeAmount Difference;
+	return FHazeAmount::TrySubtract(A, B, Difference) ? Difference : FHazeAmount();
+}
+
+FHazeAmount UHazeAmountLibrary::Multiply_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	FHazeAmount Product;
+	return FHazeAmount::TryMultiply(A, B, Product) ? Product : FHazeAmount::MaxValue();
+}
+
+FHazeAmount UHazeAmountLibrary::Divide_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A / B;
+}
+
+FHazeAmount UHazeAmountLibrary::Percent_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A % B;
+}
+
+bool UHazeAmountLibrary::EqualEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A == B;
+}
+
+bool UHazeAmountLibrary::NotEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A != B;
+}
+
+bool UHazeAmountLibrary::Less_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A < B;
+}
+
+bool UHazeAmountLibrary::LessEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A <= B;
+}
+
+bool UHazeAmountLibrary::Greater_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A > B;
+}
+
+bool UHazeAmountLibrary::GreaterEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A >= B;
+}
+
+FHazeAmount UHazeAmountLibrary::Min_HazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return B < A ? B : A;
+}
+
+FHazeAmount UHazeAmountLibrary::Max_HazeAmount(const FHazeAmount& A, const FHazeAmount& B)
+{
+	return A < B ? B : A;
+}
+
+bool UHazeAmountLibrary::IsZero(const FHazeAmount& Amount)
+{
+	return Amount.IsZero();
+}
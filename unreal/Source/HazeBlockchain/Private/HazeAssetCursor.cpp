@@ -0,0 +1,152 @@
+// Copyright HAZE Blockchain. Paged asset search with next-page prefetch.
+
+#include "HazeAssetCursor.h"
+#include "HazeClient.h"
+#include "HazeHex.h"
+#include "Async/Async.h"
+
+void UHazeAssetCursor::Init(UHazeClient* InClient, const FHazeAssetSearchQuery& InQuery)
+{
+	Client = InClient;
+	Query = InQuery;
+	Query.PageSize = FMath::Clamp(Query.PageSize, 1, UHazeClient::MaxAssetSearchPage);
+}
+
+UHazeAssetCursor* UHazeAssetCursor::CreateAssetCursor(const FHazeAssetSearchQuery& InQuery, FHazeAssetSearchTransport InTransport)
+{
+	UHazeAssetCursor* Cursor = NewObject<UHazeAssetCursor>();
+	Cursor->Init(nullptr, InQuery);
+	Cursor->Transport = MoveTemp(InTransport);
+	return Cursor;
+}
+
+void UHazeAssetCursor::NextPage(FHazeOnAssetPage OnPage)
+{
+	if (Waiting || (!Client && !Transport))
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnPage = MoveTemp(OnPage)]() { OnPage(false, nullptr); });
+		return;
+	}
+
+	if (Prefetched || bExhausted)
+	{
+		// Keep the asynchronous contract even when the page is already here
+		TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe> Page = MoveTemp(Prefetched);
+		Prefetched.Reset();
+		if (!Page)
+		{
+			Page = MakeShared<FHazeAssetPage, ESPMode::ThreadSafe>();
+		}
+		Waiting = MoveTemp(OnPage);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UHazeAssetCursor>(this), Page]()
+		{
+			if (UHazeAssetCursor* This = WeakThis.Get()) This->Deliver(Page);
+		});
+		return;
+	}
+
+	Waiting = MoveTemp(OnPage);
+	if (!bRequesting)
+	{
+		Request();
+	}
+	else if (RequestTicket != 0)
+	{
+		// The prefetch went out as Background; someone waits for it now
+		Client->Scheduler->Promote(RequestTicket, EHazeRequestPriority::Interactive);
+	}
+}
+
+void UHazeAssetCursor::Next(const FHazeAssetPageDelegate& OnComplete)
+{
+	NextPage([OnComplete](bool bOk, const TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe>& Page)
+	{
+		OnComplete.ExecuteIfBound(bOk, Page ? Page->Num() : 0);
+	});
+}
+
+void UHazeAssetCursor::Request()
+{
+	bRequesting = true;
+	auto OnComplete = [WeakThis = TWeakObjectPtr<UHazeAssetCursor>(this)](bool bOk, TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe> Page)
+	{
+		if (UHazeAssetCursor* This = WeakThis.Get()) This->OnPageArrived(bOk, MoveTemp(Page));
+	};
+	if (Transport)
+	{
+		Transport(Query, NextOffset, MoveTemp(OnComplete));
+		return;
+	}
+
+	// A prefetch (nobody waiting for the page yet) must not hold a slot interactive reads need
+	FHazeRequestScope Scope(*Client, Waiting ? EHazeRequestPriority::Interactive : EHazeRequestPriority::Background, Query.SupersedeKey);
+	Client->LastTicket = 0;
+	Client->FetchAssetSearchPage(Query, NextOffset, MoveTemp(OnComplete));
+	RequestTicket = Client->LastTicket;
+}
+
+void UHazeAssetCursor::OnPageArrived(bool bOk, TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe> Page)
+{
+	bRequesting = false;
+	RequestTicket = 0;
+	if (!bOk || !Page)
+	{
+		// A failed prefetch is dropped silently; the next Next asks again from the same offset
+		if (Waiting)
+		{
+			FHazeOnAssetPage OnPage = MoveTemp(Waiting);
+			Waiting = nullptr;
+			OnPage(false, nullptr);
+		}
+		return;
+	}
+
+	Page->ShareStrings(Strings);
+	NextOffset += Page->Num();
+	bExhausted = Page->Num() < Query.PageSize;
+	if (Waiting)
+	{
+		Deliver(Page);
+	}
+	else
+	{
+		Prefetched = Page;
+	}
+}
+
+void UHazeAssetCursor::Deliver(const TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe>& Page)
+{
+	Current = Page;
+	FHazeOnAssetPage OnPage = MoveTemp(Waiting);
+	Waiting = nullptr;
+	if (Query.bPrefetch && !bExhausted && !bRequesting && !Prefetched)
+	{
+		Request();
+	}
+	if (OnPage) OnPage(true, Page);
+}
+
+FString UHazeAssetCursor::GetAssetIdHex(int32 Index) const
+{
+	return IsValidIndex(Index) ? Current->GetAssetIdHex(Index) : FString();
+}
+
+FString UHazeAssetCursor::GetOwnerHex(int32 Index) const
+{
+	return IsValidIndex(Index) ? FHazeHex::ToHex(Current->GetOwner(Index)) : FString();
+}
+
+EDensityLevel UHazeAssetCursor::GetDensity(int32 Index) const
+{
+	return IsValidIndex(Index) ? Current->GetDensity(Index) : EDensityLevel::Ethereal;
+}
+
+FString UHazeAssetCursor::GetGameId(int32 Index) const
+{
+	return IsValidIndex(Index) ? Current->GetGameId(Index) : FString();
+}
+
+FString UHazeAssetCursor::GetLabel(int32 Index) const
+{
+	return IsValidIndex(Index) ? FString(Current->GetLabel(Index)) : FString();
+}
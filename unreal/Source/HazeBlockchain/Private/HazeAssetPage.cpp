@@ -0,0 +1,101 @@
+// Copyright HAZE Blockchain. Compact column storage for asset search results.
+
+#include "HazeAssetPage.h"
+#include "HazeHex.h"
+
+int32 FHazeStringTable::Intern(const FString& Value)
+{
+	if (Value.IsEmpty()) return INDEX_NONE;
+	if (const int32* Existing = Lookup.Find(Value)) return *Existing;
+	const int32 Index = Strings.Add(Value);
+	Lookup.Add(Value, Index);
+	return Index;
+}
+
+const FString& FHazeStringTable::Get(int32 Index) const
+{
+	static const FString Empty;
+	return Strings.IsValidIndex(Index) ? Strings[Index] : Empty;
+}
+
+FHazeAssetPage::FHazeAssetPage()
+	: Strings(MakeShared<FHazeStringTable>())
+{
+}
+
+FString FHazeAssetPage::GetAssetIdHex(int32 Index) const
+{
+	return FHazeHex::ToHex(GetAssetId(Index));
+}
+
+int32 FHazeAssetPage::Find(TArrayView<const uint8> AssetId) const
+{
+	if (AssetId.Num() != IdSize) return INDEX_NONE;
+	for (int32 i = 0; i < Num(); i++)
+	{
+		if (FMemory::Memcmp(AssetIds.GetData() + i * IdSize, AssetId.GetData(), IdSize) == 0) return i;
+	}
+	return INDEX_NONE;
+}
+
+SIZE_T FHazeAssetPage::GetAllocatedSize() const
+{
+	return AssetIds.GetAllocatedSize() + Owners.GetAllocatedSize() + Densities.GetAllocatedSize() + GameIdIndices.GetAllocatedSize()
+		+ CreatedAt.GetAllocatedSize() + UpdatedAt.GetAllocatedSize() + AttributeCounts.GetAllocatedSize() + BlobCounts.GetAllocatedSize()
+		+ LabelChars.GetAllocatedSize() + LabelStarts.GetAllocatedSize() + LabelLengths.GetAllocatedSize();
+}
+
+void FHazeAssetPage::Reserve(int32 Count)
+{
+	AssetIds.Reserve(Count * IdSize);
+	Owners.Reserve(Count * IdSize);
+	Densities.Reserve(Count);
+	GameIdIndices.Reserve(Count);
+	CreatedAt.Reserve(Count);
+	UpdatedAt.Reserve(Count);
+	AttributeCounts.Reserve(Count);
+	BlobCounts.Reserve(Count);
+	LabelStarts.Reserve(Count);
+	LabelLengths.Reserve(Count);
+	// Roughly one short name per asset
+	LabelChars.Reserve(Count * 16);
+}
+
+int32 FHazeAssetPage::AddEntry()
+{
+	AssetIds.AddZeroed(IdSize);
+	Owners.AddZeroed(IdSize);
+	Densities.Add(static_cast<uint8>(EDensityLevel::Ethereal));
+	GameIdIndices.Add(INDEX_NONE);
+	CreatedAt.Add(0);
+	UpdatedAt.Add(0);
+	AttributeCounts.Add(0);
+	BlobCounts.Add(0);
+	LabelStarts.Add(LabelChars.Num());
+	LabelLengths.Add(0);
+	return Densities.Num() - 1;
+}
+
+void FHazeAssetPage::SetLabel(int32 Index, FStringView Label)
+{
+	LabelStarts[Index] = LabelChars.Num();
+	LabelLengths[Index] = Label.Len();
+	LabelChars.Append(Label.GetData(), Label.Len());
+}
+
+void FHazeAssetPage::ShareStrings(const TSharedRef<FHazeStringTable>& Table)
+{
+	if (&Strings.Get() == &Table.Get()) return;
+
+	TArray<int32> Remap;
+	Remap.SetNumUninitialized(Strings->Num());
+	for (int32 i = 0; i < Strings->Num(); i++)
+	{
+		Remap[i] = Table->Intern(Strings->Get(i));
+	}
+	for (int32& GameIdIndex : GameIdIndices)
+	{
+		if (GameIdIndex != INDEX_NONE) GameIdIndex = Remap[GameIdIndex];
+	}
+	Strings = Table;
+}
@@ -0,0 +1,682 @@
+// Copyright HAZE Blockchain. Pre-baked binary asset snapshots, memory-mapped for fast startup.
+
+#include "HazeAssetSnapshot.h"
+#include "HazeBlobCache.h"
+#include "HazeHex.h"
+#include "HazeStats.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Containers/StringConv.h"
+#include <limits>
+
+namespace
+{
+	constexpr uint8 Magic[8] = { 'H', 'A', 'Z', 'E', 'S', 'N', 'A', 'P' };
+	constexpr uint64 MetadataRecordSize = 8;
+	constexpr uint64 AttributeRecordSize = 16;
+	constexpr uint64 BlobRefRecordSize = 40;
+	/** String index of an absent game id */
+	constexpr uint32 NoString = MAX_uint32;
+	constexpr uint8 FlagPublicRead = 1;
+
+	/** Fields are copied out as stored: the format is little-endian, as every platform the engine ships on */
+	template <typename T>
+	T ReadLe(const uint8* Data)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Data, sizeof(T));
+		return Value;
+	}
+
+	template <typename T>
+	void AppendLe(TArray<uint8>& Out, T Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	uint64 Align8(uint64 Len)
+	{
+		return (Len + 7) & ~uint64(7);
+	}
+
+	void Pad8(TArray<uint8>& Out)
+	{
+		Out.AddZeroed(static_cast<int32>(Align8(Out.Num()) - Out.Num()));
+	}
+
+	/** FString keys compare case-insensitively by default; snapshot strings must not */
+	struct FCaseSensitiveStringKeyFuncs : BaseKeyFuncs<TPair<FString, uint32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, uint32>& Element) { return Element.Key; }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/** Strings numbered in first-use order, as the node numbers them */
+	struct FSnapshotStrings
+	{
+		TArray<FString> Strings;
+		TMap<FString, uint32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> Ids;
+
+		uint32 Intern(const FString& Value)
+		{
+			if (const uint32* Existing = Ids.Find(Value)) return *Existing;
+			const uint32 Id = static_cast<uint32>(Strings.Add(Value));
+			Ids.Add(Value, Id);
+			return Id;
+		}
+	};
+
+	/** Write Bytes next to Path and move it into place, so a failed write leaves the old file */
+	bool WriteSnapshotFile(TArrayView<const uint8> Bytes, const FString& Path)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const FString TempPath = Path + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath)) return false;
+		PlatformFile.DeleteFile(*Path);
+		return PlatformFile.MoveFile(*Path, *TempPath);
+	}
+}
+
+FHazeAssetSnapshot::~FHazeAssetSnapshot() = default;
+
+TUniquePtr<FHazeAssetSnapshot> FHazeAssetSnapshot::Open(const FString& Path)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IMappedFileHandle> Handle(PlatformFile.OpenMapped(*Path));
+	if (!Handle || Handle->GetFileSize() < HeaderSize || Handle->GetFileSize() > MAX_int32) return nullptr;
+
+	TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+	if (!Region) return nullptr;
+
+	TUniquePtr<FHazeAssetSnapshot> Snapshot(new FHazeAssetSnapshot());
+	Snapshot->Mapping = MakeUnique<FHazeMappedBlob>(MoveTemp(Handle), MoveTemp(Region));
+	Snapshot->Bytes = Snapshot->Mapping->GetView();
+	return Snapshot->ParseHeader() ? MoveTemp(Snapshot) : nullptr;
+}
+
+TUniquePtr<FHazeAssetSnapshot> FHazeAssetSnapshot::FromBytes(TArray<uint8> InBytes)
+{
+	TUniquePtr<FHazeAssetSnapshot> Snapshot(new FHazeAssetSnapshot());
+	Snapshot->Owned = MoveTemp(InBytes);
+	Snapshot->Bytes = Snapshot->Owned;
+	return Snapshot->ParseHeader() ? MoveTemp(Snapshot) : nullptr;
+}
+
+bool FHazeAssetSnapshot::IsValid(TArrayView<const uint8> InBytes)
+{
+	FHazeAssetSnapshot Snapshot;
+	Snapshot.Bytes = InBytes;
+	return Snapshot.ParseHeader();
+}
+
+bool FHazeAssetSnapshot::ParseHeader()
+{
+	if (Bytes.Num() < HeaderSize || FMemory::Memcmp(Bytes.GetData(), Magic, sizeof(Magic)) != 0) return false;
+	const uint8* Data = Bytes.GetData();
+	if (ReadLe<uint32>(Data + 8) != FormatVersion) return false;
+
+	// A longer header (fields added at its end) moves the sections, which is all this reader needs to know
+	const uint32 DeclaredHeaderSize = ReadLe<uint32>(Data + 12);
+	const uint32 Assets = ReadLe<uint32>(Data + 64);
+	const uint64 FileSize = ReadLe<uint64>(Data + 96);
+	StringBytes = ReadLe<uint64>(Data + 88);
+	if (DeclaredHeaderSize < HeaderSize || DeclaredHeaderSize % 8 != 0 || Assets > MAX_int32
+		|| FileSize != static_cast<uint64>(Bytes.Num()) || StringBytes > FileSize)
+	{
+		return false;
+	}
+
+	Height = ReadLe<int64>(Data + 16);
+	CreatedAt = ReadLe<int64>(Data + 56);
+	MetadataCount = ReadLe<uint32>(Data + 68);
+	AttributeCount = ReadLe<uint32>(Data + 72);
+	BlobRefCount = ReadLe<uint32>(Data + 76);
+	StringCount = ReadLe<uint32>(Data + 80);
+
+	// Counts are 32-bit, so none of these sums can overflow
+	RecordsOffset = DeclaredHeaderSize;
+	MetadataOffset = RecordsOffset + Align8(static_cast<uint64>(Assets) * AssetRecordSize);
+	AttributesOffset = MetadataOffset + Align8(MetadataCount * MetadataRecordSize);
+	BlobRefsOffset = AttributesOffset + Align8(AttributeCount * AttributeRecordSize);
+	StringOffsetsOffset = BlobRefsOffset + Align8(BlobRefCount * BlobRefRecordSize);
+	StringBytesOffset = StringOffsetsOffset + Align8((static_cast<uint64>(StringCount) + 1) * 4);
+	if (StringBytesOffset + Align8(StringBytes) != FileSize) return false;
+
+	AssetCount = static_cast<int32>(Assets);
+	return true;
+}
+
+FString FHazeAssetSnapshot::GetStateRootHex() const
+{
+	return FHazeHex::ToHex(Bytes.Slice(24, 32));
+}
+
+int32 FHazeAssetSnapshot::Find(FStringView AssetIdHex) const
+{
+	uint8 Id[32];
+	if (!FHazeHex::Decode(AssetIdHex.TrimStartAndEnd(), Id, sizeof(Id))) return INDEX_NONE;
+
+	int32 Low = 0;
+	int32 High = AssetCount;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		const int32 Order = FMemory::Memcmp(Bytes.GetData() + RecordsOffset + static_cast<uint64>(Mid) * AssetRecordSize, Id, sizeof(Id));
+		if (Order == 0) return Mid;
+		if (Order < 0) Low = Mid + 1;
+		else High = Mid;
+	}
+	return INDEX_NONE;
+}
+
+FString FHazeAssetSnapshot::GetAssetId(int32 Index) const
+{
+	check(Index >= 0 && Index < AssetCount);
+	return FHazeHex::ToHex(MakeArrayView(Bytes.GetData() + RecordsOffset + static_cast<uint64>(Index) * AssetRecordSize, 32));
+}
+
+uint64 FHazeAssetSnapshot::GetFingerprint(int32 Index) const
+{
+	check(Index >= 0 && Index < AssetCount);
+	return ReadLe<uint64>(Bytes.GetData() + RecordsOffset + static_cast<uint64>(Index) * AssetRecordSize + 64);
+}
+
+bool FHazeAssetSnapshot::ReadString(uint32 Id, FString& OutString) const
+{
+	if (Id >= StringCount) return false;
+	const uint8* Offsets = Bytes.GetData() + StringOffsetsOffset + static_cast<uint64>(Id) * 4;
+	const uint32 Begin = ReadLe<uint32>(Offsets);
+	const uint32 End = ReadLe<uint32>(Offsets + 4);
+	if (Begin > End || End > StringBytes) return false;
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + StringBytesOffset + Begin), End - Begin);
+	OutString = FString(Converted.Length(), Converted.Get());
+	return true;
+}
+
+bool FHazeAssetSnapshot::Read(int32 Index, FHazeAssetInfo& OutAsset) const
+{
+	if (Index < 0 || Index >= AssetCount) return false;
+	const uint8* Record = Bytes.GetData() + RecordsOffset + static_cast<uint64>(Index) * AssetRecordSize;
+
+	const uint32 GameId = ReadLe<uint32>(Record + 96);
+	const uint32 MetadataFirst = ReadLe<uint32>(Record + 100);
+	const uint32 AttributesFirst = ReadLe<uint32>(Record + 104);
+	const uint32 BlobRefsFirst = ReadLe<uint32>(Record + 108);
+	const uint32 MetadataNum = ReadLe<uint32>(Record + 112);
+	const uint32 AttributesNum = ReadLe<uint32>(Record + 116);
+	const uint32 BlobRefsNum = ReadLe<uint32>(Record + 120);
+	const uint8 Density = Record[124];
+	if (static_cast<uint64>(MetadataFirst) + MetadataNum > MetadataCount
+		|| static_cast<uint64>(AttributesFirst) + AttributesNum > AttributeCount
+		|| static_cast<uint64>(BlobRefsFirst) + BlobRefsNum > BlobRefCount
+		|| Density > static_cast<uint8>(EDensityLevel::Core))
+	{
+		return false;
+	}
+
+	FHazeAssetInfo Asset;
+	Asset.AssetId = FHazeHex::ToHex(MakeArrayView(Record, 32));
+	Asset.Owner = FHazeHex::ToHex(MakeArrayView(Record + 32, 32));
+	Asset.CreatedAt = ReadLe<int64>(Record + 72);
+	Asset.UpdatedAt = ReadLe<int64>(Record + 80);
+	Asset.CurrentVersion = ReadLe<int64>(Record + 88);
+	Asset.Density = static_cast<EDensityLevel>(Density);
+	Asset.bPublicRead = (Record[125] & FlagPublicRead) != 0;
+	if (GameId != NoString && !ReadString(GameId, Asset.GameId)) return false;
+
+	Asset.Metadata.Reserve(MetadataNum);
+	for (uint32 i = 0; i < MetadataNum; i++)
+	{
+		const uint8* Entry = Bytes.GetData() + MetadataOffset + (MetadataFirst + i) * MetadataRecordSize;
+		FString Key, Value;
+		if (!ReadString(ReadLe<uint32>(Entry), Key) || !ReadString(ReadLe<uint32>(Entry + 4), Value)) return false;
+		Asset.Metadata.Add(MoveTemp(Key), MoveTemp(Value));
+	}
+
+	Asset.Attributes.Reserve(AttributesNum);
+	for (uint32 i = 0; i < AttributesNum; i++)
+	{
+		const uint8* Entry = Bytes.GetData() + AttributesOffset + (AttributesFirst + i) * AttributeRecordSize;
+		FHazeAssetAttribute& Attribute = Asset.Attributes.AddDefaulted_GetRef();
+		if (!ReadString(ReadLe<uint32>(Entry), Attribute.Name) || !ReadString(ReadLe<uint32>(Entry + 4), Attribute.Value)) return false;
+		const double Rarity = ReadLe<double>(Entry + 8);
+		Attribute.Rarity = FMath::IsNaN(Rarity) ? -1.f : static_cast<float>(Rarity);
+	}
+
+	Asset.BlobRefs.Reserve(BlobRefsNum);
+	for (uint32 i = 0; i < BlobRefsNum; i++)
+	{
+		const uint8* Entry = Bytes.GetData() + BlobRefsOffset + (BlobRefsFirst + i) * BlobRefRecordSize;
+		FString Key;
+		if (!ReadString(ReadLe<uint32>(Entry), Key)) return false;
+		Asset.BlobRefs.Add(MoveTemp(Key), FHazeHex::ToHex(MakeArrayView(Entry + 8, 32)));
+	}
+
+	OutAsset = MoveTemp(Asset);
+	return true;
+}
+
+TArray<uint8> FHazeAssetSnapshot::Write(TArray<FHazeAssetSnapshotEntry> Entries, int64 InHeight, const FString& StateRootHex, int64 InCreatedAt)
+{
+	uint8 StateRoot[32];
+	if (!FHazeHex::Decode(StateRootHex.TrimStartAndEnd(), StateRoot, sizeof(StateRoot))) return TArray<uint8>();
+
+	struct FKeyed
+	{
+		uint8 Id[32];
+		const FHazeAssetSnapshotEntry* Entry;
+	};
+	TArray<FKeyed> Order;
+	Order.Reserve(Entries.Num());
+	{
+		HAZE_SCOPE(STAT_HazeHex, HazeHex);
+		for (const FHazeAssetSnapshotEntry& Entry : Entries)
+		{
+			FKeyed& Keyed = Order.AddDefaulted_GetRef();
+			Keyed.Entry = &Entry;
+			if (!FHazeHex::Decode(Entry.Asset.AssetId.TrimStartAndEnd(), Keyed.Id, sizeof(Keyed.Id))) return TArray<uint8>();
+		}
+	}
+	Order.Sort([](const FKeyed& A, const FKeyed& B) { return FMemory::Memcmp(A.Id, B.Id, sizeof(A.Id)) < 0; });
+
+	FSnapshotStrings Strings;
+	TArray<uint8> Records, Metadata, Attributes, BlobRefs;
+	Records.Reserve(Order.Num() * AssetRecordSize);
+	uint32 MetadataNum = 0, AttributesNum = 0, BlobRefsNum = 0;
+	for (const FKeyed& Keyed : Order)
+	{
+		const FHazeAssetInfo& Asset = Keyed.Entry->Asset;
+		uint8 Owner[32];
+		if (!FHazeHex::Decode(Asset.Owner.TrimStartAndEnd(), Owner, sizeof(Owner))) return TArray<uint8>();
+		const uint32 GameId = Asset.GameId.IsEmpty() ? NoString : Strings.Intern(Asset.GameId);
+
+		// Metadata and blob refs by key, as the node writes them, so both sides produce the same bytes
+		TArray<TPair<FString, FString>> SortedMetadata = Asset.Metadata.Array();
+		SortedMetadata.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B) { return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0; });
+		const uint32 MetadataFirst = MetadataNum;
+		for (const TPair<FString, FString>& Entry : SortedMetadata)
+		{
+			AppendLe(Metadata, Strings.Intern(Entry.Key));
+			AppendLe(Metadata, Strings.Intern(Entry.Value));
+			MetadataNum++;
+		}
+
+		const uint32 AttributesFirst = AttributesNum;
+		for (const FHazeAssetAttribute& Attribute : Asset.Attributes)
+		{
+			AppendLe(Attributes, Strings.Intern(Attribute.Name));
+			AppendLe(Attributes, Strings.Intern(Attribute.Value));
+			AppendLe(Attributes, Attribute.Rarity < 0.f ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(Attribute.Rarity));
+			AttributesNum++;
+		}
+
+		TArray<TPair<FString, FString>> SortedBlobRefs = Asset.BlobRefs.Array();
+		SortedBlobRefs.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B) { return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0; });
+		const uint32 BlobRefsFirst = BlobRefsNum;
+		for (const TPair<FString, FString>& Entry : SortedBlobRefs)
+		{
+			uint8 Hash[32];
+			if (!FHazeHex::Decode(Entry.Value.TrimStartAndEnd(), Hash, sizeof(Hash))) return TArray<uint8>();
+			AppendLe(BlobRefs, Strings.Intern(Entry.Key));
+			AppendLe(BlobRefs, uint32(0));
+			BlobRefs.Append(Hash, sizeof(Hash));
+			BlobRefsNum++;
+		}
+
+		Records.Append(Keyed.Id, sizeof(Keyed.Id));
+		Records.Append(Owner, sizeof(Owner));
+		AppendLe(Records, Keyed.Entry->Fingerprint);
+		AppendLe(Records, Asset.CreatedAt);
+		AppendLe(Records, Asset.UpdatedAt);
+		AppendLe(Records, static_cast<uint64>(Asset.CurrentVersion));
+		AppendLe(Records, GameId);
+		AppendLe(Records, MetadataFirst);
+		AppendLe(Records, AttributesFirst);
+		AppendLe(Records, BlobRefsFirst);
+		AppendLe(Records, MetadataNum - MetadataFirst);
+		AppendLe(Records, AttributesNum - AttributesFirst);
+		AppendLe(Records, BlobRefsNum - BlobRefsFirst);
+		Records.Add(static_cast<uint8>(Asset.Density));
+		Records.Add(Asset.bPublicRead ? FlagPublicRead : 0);
+		Records.AddZeroed(2);
+	}
+
+	TArray<uint8> StringOffsets, StringData;
+	StringOffsets.Reserve((Strings.Strings.Num() + 1) * 4);
+	for (const FString& Value : Strings.Strings)
+	{
+		AppendLe(StringOffsets, static_cast<uint32>(StringData.Num()));
+		const FTCHARToUTF8 Utf8(*Value, Value.Len());
+		StringData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+	AppendLe(StringOffsets, static_cast<uint32>(StringData.Num()));
+
+	const TArray<uint8>* Sections[] = { &Records, &Metadata, &Attributes, &BlobRefs, &StringOffsets, &StringData };
+	uint64 FileSize = HeaderSize;
+	for (const TArray<uint8>* Section : Sections)
+	{
+		FileSize += Align8(Section->Num());
+	}
+
+	TArray<uint8> Out;
+	Out.Reserve(static_cast<int32>(FileSize));
+	Out.Append(Magic, sizeof(Magic));
+	AppendLe(Out, FormatVersion);
+	AppendLe(Out, static_cast<uint32>(HeaderSize));
+	AppendLe(Out, static_cast<uint64>(InHeight));
+	Out.Append(StateRoot, sizeof(StateRoot));
+	AppendLe(Out, InCreatedAt);
+	AppendLe(Out, static_cast<uint32>(Order.Num()));
+	AppendLe(Out, MetadataNum);
+	AppendLe(Out, AttributesNum);
+	AppendLe(Out, BlobRefsNum);
+	AppendLe(Out, static_cast<uint32>(Strings.Strings.Num()));
+	AppendLe(Out, uint32(0));
+	AppendLe(Out, static_cast<uint64>(StringData.Num()));
+	AppendLe(Out, FileSize);
+	Out.AddZeroed(HeaderSize - Out.Num());
+	for (const TArray<uint8>* Section : Sections)
+	{
+		Out.Append(*Section);
+		Pad8(Out);
+	}
+	check(static_cast<uint64>(Out.Num()) == FileSize);
+	return Out;
+}
+
+UHazeAssetSnapshotStore* UHazeAssetSnapshotStore::CreateAssetSnapshotStore(UHazeClient* InClient)
+{
+	UHazeAssetSnapshotStore* Store = NewObject<UHazeAssetSnapshotStore>();
+	Store->Client = InClient;
+	return Store;
+}
+
+FString UHazeAssetSnapshotStore::GetDefaultPath(const FString& Name)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HazeSnapshots"), Name + TEXT(".hazesnap"));
+}
+
+bool UHazeAssetSnapshotStore::Load(const FString& Path)
+{
+	return Adopt(FHazeAssetSnapshot::Open(Path));
+}
+
+bool UHazeAssetSnapshotStore::LoadBytes(TArray<uint8> Bytes)
+{
+	return Adopt(FHazeAssetSnapshot::FromBytes(MoveTemp(Bytes)));
+}
+
+bool UHazeAssetSnapshotStore::Adopt(TUniquePtr<FHazeAssetSnapshot> Loaded)
+{
+	if (!Loaded) return false;
+	Snapshot = MoveTemp(Loaded);
+	Refreshed.Reset();
+	Stale.Reset();
+	Removed.Reset();
+	StateRoot = Snapshot->GetStateRootHex();
+	Height = Snapshot->GetHeight();
+	bVerified = false;
+	DownloadedQuery.Reset();
+	// In-flight checks and fetches belong to the old snapshot
+	Generation++;
+	bValidating = false;
+	bValidateAgain = false;
+	PendingRequests = 0;
+	return true;
+}
+
+void UHazeAssetSnapshotStore::Download(const FString& OwnerHex, const FString& GameId, const FString& Path)
+{
+	const FString Owner = OwnerHex.TrimStartAndEnd().ToLower();
+	if (!Client || (Owner.IsEmpty() && GameId.IsEmpty()))
+	{
+		OnDownloaded.Broadcast(false);
+		return;
+	}
+
+	const FString Query = Owner + TEXT("|") + GameId;
+	const FString KnownRoot = Snapshot && Query == DownloadedQuery ? StateRoot : FString();
+	Client->FetchAssetSnapshot(Owner, GameId, KnownRoot,
+		[WeakThis = TWeakObjectPtr<UHazeAssetSnapshotStore>(this), Query, Path](bool bOk, bool bChanged, const TArray<uint8>& Bytes)
+	{
+		UHazeAssetSnapshotStore* This = WeakThis.Get();
+		if (!This) return;
+		if (bOk && !bChanged)
+		{
+			// 304: nothing was applied since the state the store holds
+			This->bVerified = true;
+			This->OnDownloaded.Broadcast(true);
+			return;
+		}
+		if (!bOk || !This->LoadBytes(Bytes))
+		{
+			This->OnDownloaded.Broadcast(false);
+			return;
+		}
+		This->bVerified = true;
+		This->DownloadedQuery = Query;
+		This->OnDownloaded.Broadcast(WriteSnapshotFile(This->Snapshot->GetView(), Path));
+	});
+}
+
+void UHazeAssetSnapshotStore::Validate(const FBlockchainInfo& Info)
+{
+	if (!Snapshot)
+	{
+		OnValidated.Broadcast(false, 0);
+		return;
+	}
+	if (bValidating)
+	{
+		bValidateAgain = true;
+		NextInfo = Info;
+		return;
+	}
+	if (Info.StateRoot.Equals(StateRoot, ESearchCase::IgnoreCase))
+	{
+		// Nothing was applied since: every entry held is current
+		bVerified = true;
+		OnValidated.Broadcast(true, 0);
+		return;
+	}
+
+	TArray<TArray<TPair<FString, uint64>>> Batches;
+	for (int32 i = 0; i < Snapshot->Num(); i++)
+	{
+		const FString AssetId = Snapshot->GetAssetId(i);
+		if (Removed.Contains(AssetId)) continue;
+		if (Batches.IsEmpty() || Batches.Last().Num() == UHazeClient::MaxSnapshotStaleBatch)
+		{
+			Batches.AddDefaulted_GetRef().Reserve(FMath::Min(Snapshot->Num() - i, UHazeClient::MaxSnapshotStaleBatch));
+		}
+		const FHazeAssetSnapshotEntry* Entry = Refreshed.Find(AssetId);
+		Batches.Last().Emplace(AssetId, Entry ? Entry->Fingerprint : Snapshot->GetFingerprint(i));
+	}
+	if (Batches.IsEmpty())
+	{
+		StateRoot = Info.StateRoot.ToLower();
+		Height = Info.CurrentHeight;
+		bVerified = true;
+		OnValidated.Broadcast(true, 0);
+		return;
+	}
+	if (!Client)
+	{
+		OnValidated.Broadcast(false, 0);
+		return;
+	}
+
+	bValidating = true;
+	PendingRequests = Batches.Num();
+	RefreshedThisRound = 0;
+	bRoundFailed = false;
+	bRootsAgree = true;
+	RoundRoot.Reset();
+	RoundHeight = 0;
+	const TWeakObjectPtr<UHazeAssetSnapshotStore> WeakThis(this);
+	const uint32 RoundGeneration = Generation;
+	for (const TArray<TPair<FString, uint64>>& Batch : Batches)
+	{
+		Client->FetchStaleSnapshotEntries(Batch, [WeakThis, RoundGeneration](bool bOk, const FHazeSnapshotStalePage& Page)
+		{
+			UHazeAssetSnapshotStore* This = WeakThis.Get();
+			if (!This || This->Generation != RoundGeneration) return;
+			if (!bOk)
+			{
+				This->bRoundFailed = true;
+			}
+			else
+			{
+				// Batches checked against different blocks leave the root unadopted, so the next Validate checks again
+				if (This->RoundRoot.IsEmpty())
+				{
+					This->RoundRoot = Page.StateRoot.ToLower();
+					This->RoundHeight = Page.CurrentHeight;
+				}
+				else if (!This->RoundRoot.Equals(Page.StateRoot, ESearchCase::IgnoreCase))
+				{
+					This->bRootsAgree = false;
+				}
+				for (const FHazeSnapshotStaleEntry& Entry : This->ApplyStalePage(Page))
+				{
+					This->PendingRequests++;
+					This->Client->FetchAsset(Entry.AssetId, [WeakThis, RoundGeneration, Fingerprint = Entry.Fingerprint](bool bAssetOk, const FHazeAssetInfo& Asset)
+					{
+						UHazeAssetSnapshotStore* Owner = WeakThis.Get();
+						if (!Owner || Owner->Generation != RoundGeneration) return;
+						if (bAssetOk) Owner->ApplyRefreshed(Asset, Fingerprint);
+						else Owner->bRoundFailed = true;
+						if (--Owner->PendingRequests == 0) Owner->FinishValidate();
+					});
+				}
+			}
+			if (--This->PendingRequests == 0) This->FinishValidate();
+		});
+	}
+}
+
+void UHazeAssetSnapshotStore::FinishValidate()
+{
+	bValidating = false;
+	if (!bRoundFailed)
+	{
+		bVerified = true;
+		if (bRootsAgree)
+		{
+			StateRoot = RoundRoot;
+			Height = RoundHeight;
+		}
+	}
+	OnValidated.Broadcast(!bRoundFailed, RefreshedThisRound);
+	if (bValidateAgain)
+	{
+		bValidateAgain = false;
+		Validate(NextInfo);
+	}
+}
+
+TArray<FHazeSnapshotStaleEntry> UHazeAssetSnapshotStore::ApplyStalePage(const FHazeSnapshotStalePage& Page)
+{
+	TArray<FHazeSnapshotStaleEntry> Refetch;
+	if (!Snapshot) return Refetch;
+	for (const FHazeSnapshotStaleEntry& Entry : Page.Stale)
+	{
+		if (Snapshot->Find(Entry.AssetId) == INDEX_NONE) continue;
+		const FString AssetId = Entry.AssetId.TrimStartAndEnd().ToLower();
+		if (Entry.bRemoved)
+		{
+			Removed.Add(AssetId);
+			Refreshed.Remove(AssetId);
+			Stale.Remove(AssetId);
+			RefreshedThisRound++;
+			continue;
+		}
+		Stale.Add(AssetId);
+		FHazeSnapshotStaleEntry& Next = Refetch.Add_GetRef(Entry);
+		Next.AssetId = AssetId;
+	}
+	return Refetch;
+}
+
+void UHazeAssetSnapshotStore::ApplyRefreshed(const FHazeAssetInfo& Asset, uint64 Fingerprint)
+{
+	const FString AssetId = Asset.AssetId.TrimStartAndEnd().ToLower();
+	if (!Snapshot || Snapshot->Find(AssetId) == INDEX_NONE) return;
+	Stale.Remove(AssetId);
+	Removed.Remove(AssetId);
+	Refreshed.Add(AssetId, FHazeAssetSnapshotEntry{ Asset, Fingerprint });
+	RefreshedThisRound++;
+}
+
+bool UHazeAssetSnapshotStore::Save(const FString& Path)
+{
+	if (!Snapshot || bValidating) return false;
+
+	TArray<FHazeAssetSnapshotEntry> Entries;
+	Entries.Reserve(Snapshot->Num() - Removed.Num());
+	for (int32 i = 0; i < Snapshot->Num(); i++)
+	{
+		const FString AssetId = Snapshot->GetAssetId(i);
+		if (Removed.Contains(AssetId)) continue;
+		if (const FHazeAssetSnapshotEntry* Entry = Refreshed.Find(AssetId))
+		{
+			Entries.Add(*Entry);
+			continue;
+		}
+		FHazeAssetSnapshotEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Fingerprint = Snapshot->GetFingerprint(i);
+		if (!Snapshot->Read(i, Entry.Asset)) return false;
+	}
+	TArray<uint8> Bytes = FHazeAssetSnapshot::Write(MoveTemp(Entries), Height, StateRoot, FDateTime::UtcNow().ToUnixTimestamp());
+	if (Bytes.IsEmpty()) return false;
+
+	// Entries still stale keep their old fingerprint in the merged copy, so the next Validate refetches them
+	const bool bWasVerified = bVerified;
+	TSet<FString> StillStale = MoveTemp(Stale);
+	const FString Query = DownloadedQuery;
+	if (!LoadBytes(MoveTemp(Bytes))) return false;
+	bVerified = bWasVerified;
+	Stale = MoveTemp(StillStale);
+	DownloadedQuery = Query;
+	return WriteSnapshotFile(Snapshot->GetView(), Path);
+}
+
+bool UHazeAssetSnapshotStore::GetAsset(const FString& AssetIdHex, FHazeAssetInfo& OutAsset) const
+{
+	if (!Snapshot) return false;
+	const FString AssetId = AssetIdHex.TrimStartAndEnd().ToLower();
+	if (Removed.Contains(AssetId)) return false;
+	if (const FHazeAssetSnapshotEntry* Entry = Refreshed.Find(AssetId))
+	{
+		OutAsset = Entry->Asset;
+		return true;
+	}
+	return Snapshot->Read(Snapshot->Find(AssetId), OutAsset);
+}
+
+EHazeSnapshotEntryStatus UHazeAssetSnapshotStore::GetStatus(const FString& AssetIdHex) const
+{
+	const FString AssetId = AssetIdHex.TrimStartAndEnd().ToLower();
+	if (!Snapshot || Snapshot->Find(AssetId) == INDEX_NONE) return EHazeSnapshotEntryStatus::None;
+	if (Removed.Contains(AssetId)) return EHazeSnapshotEntryStatus::Removed;
+	if (Stale.Contains(AssetId)) return EHazeSnapshotEntryStatus::Stale;
+	if (bVerified || Refreshed.Contains(AssetId)) return EHazeSnapshotEntryStatus::Current;
+	return EHazeSnapshotEntryStatus::Unverified;
+}
+
+TArray<FString> UHazeAssetSnapshotStore::GetAssetIds() const
+{
+	TArray<FString> AssetIds;
+	if (!Snapshot) return AssetIds;
+	AssetIds.Reserve(Snapshot->Num() - Removed.Num());
+	for (int32 i = 0; i < Snapshot->Num(); i++)
+	{
+		FString AssetId = Snapshot->GetAssetId(i);
+		if (!Removed.Contains(AssetId)) AssetIds.Add(MoveTemp(AssetId));
+	}
+	return AssetIds;
+}
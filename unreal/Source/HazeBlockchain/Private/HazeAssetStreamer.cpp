@@ -0,0 +1,568 @@
+// Copyright HAZE Blockchain. Density-tiered, budgeted streaming of Mistborn assets.
+
+#include "HazeAssetStreamer.h"
+#include "HazeBlobCache.h"
+#include "HazeEventStream.h"
+#include "Async/Async.h"
+
+namespace
+{
+	/** Events that name assets whose loaded tiers may be stale */
+	constexpr EHazeStreamEventType AssetEvents[] =
+	{
+		EHazeStreamEventType::AssetCreated,
+		EHazeStreamEventType::AssetUpdated,
+		EHazeStreamEventType::AssetCondensed,
+		EHazeStreamEventType::AssetEvaporated,
+		EHazeStreamEventType::AssetMerged,
+		EHazeStreamEventType::AssetSplit,
+		EHazeStreamEventType::AssetPermissionChanged,
+		EHazeStreamEventType::AssetAttributeUpdated,
+		EHazeStreamEventType::AssetVersionCreated,
+	};
+
+	EDensityLevel NextTier(EDensityLevel Tier)
+	{
+		return static_cast<EDensityLevel>(FMath::Min<uint8>(static_cast<uint8>(Tier) + 1, static_cast<uint8>(EDensityLevel::Core)));
+	}
+
+	EDensityLevel PreviousTier(EDensityLevel Tier)
+	{
+		return Tier == EDensityLevel::Ethereal ? Tier : static_cast<EDensityLevel>(static_cast<uint8>(Tier) - 1);
+	}
+
+	int64 StringMapBytes(const TMap<FString, FString>& Map)
+	{
+		int64 Bytes = Map.GetAllocatedSize();
+		for (const TPair<FString, FString>& Pair : Map)
+		{
+			Bytes += Pair.Key.GetAllocatedSize() + Pair.Value.GetAllocatedSize();
+		}
+		return Bytes;
+	}
+
+	/** Heap held by a decoded asset (what evicting it gives back) */
+	int64 EstimateBytes(const FHazeAssetInfo& Asset)
+	{
+		int64 Bytes = sizeof(FHazeAssetInfo) + Asset.AssetId.GetAllocatedSize() + Asset.Owner.GetAllocatedSize() + Asset.GameId.GetAllocatedSize();
+		Bytes += StringMapBytes(Asset.Metadata) + StringMapBytes(Asset.BlobRefs) + Asset.Attributes.GetAllocatedSize();
+		for (const FHazeAssetAttribute& Attribute : Asset.Attributes)
+		{
+			Bytes += Attribute.Name.GetAllocatedSize() + Attribute.Value.GetAllocatedSize();
+		}
+		return Bytes;
+	}
+}
+
+UHazeAssetStreamer* UHazeAssetStreamer::CreateAssetStreamer(UHazeClient* InClient)
+{
+	UHazeAssetStreamer* Streamer = NewObject<UHazeAssetStreamer>();
+	Streamer->Client = InClient;
+	return Streamer;
+}
+
+FString UHazeAssetStreamer::AssetKey(const FString& AssetIdHex)
+{
+	return AssetIdHex.TrimStartAndEnd().ToLower();
+}
+
+UHazeAssetStreamer::FEntry* UHazeAssetStreamer::FindEntry(const FString& AssetIdHex)
+{
+	return Entries.Find(AssetKey(AssetIdHex));
+}
+
+const UHazeAssetStreamer::FEntry* UHazeAssetStreamer::FindEntry(const FString& AssetIdHex) const
+{
+	return Entries.Find(AssetKey(AssetIdHex));
+}
+
+void UHazeAssetStreamer::Track(const FString& AssetIdHex, const FVector& Location)
+{
+	const FString Key = AssetKey(AssetIdHex);
+	if (Key.IsEmpty()) return;
+
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Key);
+		Entry->Generation = ++GenerationCounter;
+	}
+	Entry->Location = Location;
+	EnsureTicking();
+}
+
+void UHazeAssetStreamer::Untrack(const FString& AssetIdHex)
+{
+	const FString Key = AssetKey(AssetIdHex);
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		EvictTo(Key, *Entry, EDensityLevel::Ethereal, true);
+		Entries.Remove(Key);
+	}
+}
+
+void UHazeAssetStreamer::SetAssetLocation(const FString& AssetIdHex, const FVector& Location)
+{
+	if (FEntry* Entry = FindEntry(AssetIdHex)) Entry->Location = Location;
+}
+
+void UHazeAssetStreamer::SetAssetVisible(const FString& AssetIdHex, bool bVisible)
+{
+	if (FEntry* Entry = FindEntry(AssetIdHex)) Entry->bVisible = bVisible;
+}
+
+void UHazeAssetStreamer::SetAssetPriority(const FString& AssetIdHex, int32 Priority)
+{
+	if (FEntry* Entry = FindEntry(AssetIdHex)) Entry->Priority = Priority;
+}
+
+void UHazeAssetStreamer::SetRequiredTier(const FString& AssetIdHex, EDensityLevel Tier)
+{
+	if (FEntry* Entry = FindEntry(AssetIdHex)) Entry->RequiredTier = Tier;
+}
+
+void UHazeAssetStreamer::SetViewLocation(const FVector& Location)
+{
+	ViewLocation = Location;
+}
+
+bool UHazeAssetStreamer::GetLoadedTier(const FString& AssetIdHex, EDensityLevel& OutTier) const
+{
+	const FEntry* Entry = FindEntry(AssetIdHex);
+	if (!Entry || !Entry->bHasSummary) return false;
+	OutTier = Entry->LoadedTier;
+	return true;
+}
+
+bool UHazeAssetStreamer::GetAsset(const FString& AssetIdHex, FHazeAssetInfo& OutAsset) const
+{
+	const FEntry* Entry = FindEntry(AssetIdHex);
+	if (!Entry || !Entry->bHasSummary) return false;
+	OutAsset = Entry->LoadedTier >= EDensityLevel::Light ? Entry->Full : Entry->Summary;
+	return true;
+}
+
+TSharedPtr<FHazeMappedBlob, ESPMode::ThreadSafe> UHazeAssetStreamer::FindBlob(const FString& AssetIdHex, const FString& BlobKey) const
+{
+	const FEntry* Entry = FindEntry(AssetIdHex);
+	if (!Entry || Entry->LoadedTier != EDensityLevel::Core) return nullptr;
+	const TSharedPtr<FHazeMappedBlob, ESPMode::ThreadSafe>* Blob = Entry->Blobs.Find(BlobKey);
+	return Blob ? *Blob : nullptr;
+}
+
+void UHazeAssetStreamer::BindInvalidation(UHazeEventStream* Stream)
+{
+	if (!Stream) return;
+	for (EHazeStreamEventType Type : AssetEvents)
+	{
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = Type;
+		Stream->Subscribe(Subscription);
+	}
+	Stream->OnEventNative().AddUObject(this, &UHazeAssetStreamer::HandleStreamEvent);
+}
+
+void UHazeAssetStreamer::HandleStreamEvent(const FHazeStreamEvent& Event)
+{
+	bool bAssetEvent = false;
+	for (EHazeStreamEventType Type : AssetEvents)
+	{
+		bAssetEvent |= Event.Type == Type;
+	}
+	if (!bAssetEvent) return;
+
+	// Drop to nothing so the next update requests a fresh summary (density may have changed too)
+	TArray<FString> Touched = Event.RelatedAssetIds;
+	Touched.Add(Event.AssetId);
+	for (const FString& AssetId : Touched)
+	{
+		const FString Key = AssetKey(AssetId);
+		if (FEntry* Entry = Entries.Find(Key))
+		{
+			EvictTo(Key, *Entry, EDensityLevel::Ethereal, true);
+		}
+	}
+}
+
+void UHazeAssetStreamer::BeginDestroy()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+void UHazeAssetStreamer::EnsureTicking()
+{
+	if (TickHandle.IsValid()) return;
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UHazeAssetStreamer::Tick), UpdateIntervalSeconds);
+}
+
+bool UHazeAssetStreamer::Tick(float DeltaTime)
+{
+	Update(FPlatformTime::Seconds());
+	if (Entries.Num() == 0 && LoadsInFlight == 0)
+	{
+		TickHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool UHazeAssetStreamer::IsMoreImportant(const FEntry& A, const FEntry& B)
+{
+	if (A.bVisible != B.bVisible) return A.bVisible;
+	if (A.Priority != B.Priority) return A.Priority > B.Priority;
+	return A.Distance < B.Distance;
+}
+
+EDensityLevel UHazeAssetStreamer::ComputeWantedTier(const FEntry& Entry) const
+{
+	if (!Entry.bHasSummary) return EDensityLevel::Ethereal;
+
+	EDensityLevel Tier = EDensityLevel::Ethereal;
+	if (Entry.bVisible)
+	{
+		if (Entry.Distance <= CoreDistance) Tier = EDensityLevel::Core;
+		else if (Entry.Distance <= DenseDistance) Tier = EDensityLevel::Dense;
+		else if (Entry.Distance <= LightDistance) Tier = EDensityLevel::Light;
+	}
+	// Nothing above the asset's own density exists on the node
+	return FMath::Min(FMath::Max(Tier, Entry.RequiredTier), Entry.Summary.Density);
+}
+
+void UHazeAssetStreamer::Update(double Now)
+{
+	if (!Client && !(SummaryTransport && AssetTransport)) return;
+
+	// Hysteresis: assets stripped for budget only climb back once there is real headroom
+	const bool bBelowLowWater = ResidentBytes <= MemoryBudgetBytes / 4 * 3;
+	TArray<FString> Order;
+	Order.Reserve(Entries.Num());
+	for (TPair<FString, FEntry>& Pair : Entries)
+	{
+		FEntry& Entry = Pair.Value;
+		Entry.Distance = FVector::Dist(ViewLocation, Entry.Location);
+		Entry.WantedTier = ComputeWantedTier(Entry);
+		if (bBelowLowWater) Entry.BudgetCap = EDensityLevel::Core;
+		Order.Add(Pair.Key);
+	}
+	Order.Sort([this](const FString& A, const FString& B) { return IsMoreImportant(Entries.FindChecked(A), Entries.FindChecked(B)); });
+
+	RequestSummaries(Order, Now);
+
+	// Delegates may untrack while we walk, so entries are looked up again each step
+	for (const FString& AssetId : Order)
+	{
+		FEntry* Entry = Entries.Find(AssetId);
+		if (!Entry || !Entry->bHasSummary) continue;
+		if (Entry->LoadedTier <= Entry->WantedTier)
+		{
+			Entry->UnwantedSince = 0.0;
+			continue;
+		}
+		if (Entry->UnwantedSince == 0.0) Entry->UnwantedSince = Now;
+		if (Now - Entry->UnwantedSince >= EvictDelaySeconds)
+		{
+			EvictTo(AssetId, *Entry, Entry->WantedTier);
+		}
+	}
+
+	EnforceBudget(Order);
+
+	for (const FString& AssetId : Order)
+	{
+		if (LoadsInFlight >= MaxConcurrentLoads || ResidentBytes >= MemoryBudgetBytes) break;
+		FEntry* Entry = Entries.Find(AssetId);
+		if (!Entry || !Entry->bHasSummary || Entry->bLoading || Entry->RetryAt > Now) continue;
+		if (Entry->LoadedTier < FMath::Min(Entry->WantedTier, Entry->BudgetCap))
+		{
+			LoadNextTier(AssetId, *Entry);
+		}
+	}
+}
+
+void UHazeAssetStreamer::RequestSummaries(const TArray<FString>& Order, double Now)
+{
+	TArray<FString> Batch;
+	TArray<uint32> Generations;
+	auto SendBatch = [this, &Batch, &Generations]()
+	{
+		LoadsInFlight++;
+		FHazeOnAssetSummaries OnComplete = [WeakThis = TWeakObjectPtr<UHazeAssetStreamer>(this), AssetIds = Batch, Generations]
+			(bool bOk, const TArray<FHazeAssetInfo>& Assets)
+		{
+			if (UHazeAssetStreamer* This = WeakThis.Get())
+			{
+				This->OnSummaries(AssetIds, Generations, bOk, Assets);
+			}
+		};
+		if (SummaryTransport)
+		{
+			SummaryTransport(Batch, MoveTemp(OnComplete));
+		}
+		else
+		{
+			FHazeRequestScope Scope(*Client, EHazeRequestPriority::Background);
+			Client->FetchAssetSummaries(Batch, MoveTemp(OnComplete));
+		}
+		Batch.Reset();
+		Generations.Reset();
+	};
+
+	// Order is most important first, so visible assets get their summaries in the earliest batches
+	for (const FString& AssetId : Order)
+	{
+		if (LoadsInFlight >= MaxConcurrentLoads) break;
+		FEntry& Entry = Entries.FindChecked(AssetId);
+		if (Entry.bHasSummary || Entry.bSummaryQueued || Entry.RetryAt > Now) continue;
+		Entry.bSummaryQueued = true;
+		Batch.Add(AssetId);
+		Generations.Add(Entry.Generation);
+		if (Batch.Num() == UHazeClient::MaxAssetSummaryBatch) SendBatch();
+	}
+	if (Batch.Num() > 0) SendBatch();
+}
+
+void UHazeAssetStreamer::OnSummaries(const TArray<FString>& AssetIds, const TArray<uint32>& Generations, bool bOk, const TArray<FHazeAssetInfo>& Assets)
+{
+	LoadsInFlight = FMath::Max(0, LoadsInFlight - 1);
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<FString> Loaded;
+	for (int32 i = 0; i < AssetIds.Num(); i++)
+	{
+		FEntry* Entry = Entries.Find(AssetIds[i]);
+		if (!Entry || Entry->Generation != Generations[i]) continue;
+		Entry->bSummaryQueued = false;
+		if (!bOk || !Assets.IsValidIndex(i) || Assets[i].AssetId.IsEmpty())
+		{
+			// Unknown ids are retried too: the asset may simply not have been created yet
+			Entry->RetryAt = Now + RetryDelaySeconds;
+			continue;
+		}
+		const int64 OldBytes = Entry->GetBytes();
+		Entry->Summary = Assets[i];
+		Entry->SummaryBytes = EstimateBytes(Entry->Summary);
+		Entry->bHasSummary = true;
+		Entry->LoadedTier = EDensityLevel::Ethereal;
+		ResidentBytes += Entry->GetBytes() - OldBytes;
+		Loaded.Add(AssetIds[i]);
+	}
+	for (const FString& AssetId : Loaded)
+	{
+		OnTierLoaded.Broadcast(AssetId, EDensityLevel::Ethereal);
+	}
+}
+
+void UHazeAssetStreamer::LoadNextTier(const FString& AssetId, FEntry& Entry)
+{
+	const EDensityLevel Next = NextTier(Entry.LoadedTier);
+	if (Next == EDensityLevel::Light)
+	{
+		LoadFull(AssetId, Entry);
+	}
+	else if (Entry.Full.BlobRefs.Num() == 0)
+	{
+		// No blobs: Dense and Core hold nothing beyond the full asset
+		SetLoadedTier(AssetId, Entry, Next);
+	}
+	else if (!Client)
+	{
+		// Only summaries and full assets go through the transport
+		return;
+	}
+	else if (Next == EDensityLevel::Dense)
+	{
+		LoadBlobsToDisk(AssetId, Entry);
+	}
+	else
+	{
+		MapBlobs(AssetId, Entry);
+	}
+}
+
+void UHazeAssetStreamer::LoadFull(const FString& AssetId, FEntry& Entry)
+{
+	Entry.bLoading = true;
+	LoadsInFlight++;
+	FHazeOnAsset OnComplete = [WeakThis = TWeakObjectPtr<UHazeAssetStreamer>(this), AssetId, Generation = Entry.Generation]
+		(bool bOk, const FHazeAssetInfo& Asset)
+	{
+		UHazeAssetStreamer* This = WeakThis.Get();
+		if (!This) return;
+		FEntry* Done = This->FinishLoad(AssetId, Generation, bOk && !Asset.AssetId.IsEmpty());
+		if (!Done) return;
+		const int64 OldBytes = Done->GetBytes();
+		Done->Full = Asset;
+		Done->FullBytes = EstimateBytes(Done->Full);
+		This->ResidentBytes += Done->GetBytes() - OldBytes;
+		This->SetLoadedTier(AssetId, *Done, EDensityLevel::Light);
+	};
+	if (AssetTransport)
+	{
+		AssetTransport(AssetId, MoveTemp(OnComplete));
+		return;
+	}
+	FHazeRequestScope Scope(*Client, EHazeRequestPriority::Background);
+	Client->FetchAsset(AssetId, MoveTemp(OnComplete));
+}
+
+void UHazeAssetStreamer::LoadBlobsToDisk(const FString& AssetId, FEntry& Entry)
+{
+	struct FBlobSet
+	{
+		int32 Remaining = 0;
+		bool bFailed = false;
+	};
+	TSharedRef<FBlobSet> Set = MakeShared<FBlobSet>();
+	Set->Remaining = Entry.Full.BlobRefs.Num();
+
+	Entry.bLoading = true;
+	LoadsInFlight++;
+	// Downloads are shared with any other asset (or caller) fetching the same hash; cached blobs finish at once
+	for (const TPair<FString, FString>& Ref : Entry.Full.BlobRefs)
+	{
+		Client->FetchBlob(AssetId, Ref.Key, Ref.Value, [WeakThis = TWeakObjectPtr<UHazeAssetStreamer>(this), AssetId, Generation = Entry.Generation, Set]
+			(bool bOk, const FHazeBlobDownloadResult&)
+		{
+			Set->bFailed |= !bOk;
+			if (--Set->Remaining > 0) return;
+			UHazeAssetStreamer* This = WeakThis.Get();
+			if (!This) return;
+			if (FEntry* Done = This->FinishLoad(AssetId, Generation, !Set->bFailed))
+			{
+				This->SetLoadedTier(AssetId, *Done, EDensityLevel::Dense);
+			}
+		});
+	}
+}
+
+void UHazeAssetStreamer::MapBlobs(const FString& AssetId, FEntry& Entry)
+{
+	Entry.bLoading = true;
+	LoadsInFlight++;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = TWeakObjectPtr<UHazeAssetStreamer>(this), AssetId,
+		Generation = Entry.Generation, Refs = Entry.Full.BlobRefs.Array()]()
+	{
+		FMappedBlobs Blobs;
+		int64 Bytes = 0;
+		bool bCached = true;
+		for (const TPair<FString, FString>& Ref : Refs)
+		{
+			if (TUniquePtr<FHazeMappedBlob> Mapped = FHazeBlobCache::Map(Ref.Value))
+			{
+				Bytes += Mapped->GetSize();
+				Blobs.Add(Ref.Key, TSharedPtr<FHazeMappedBlob, ESPMode::ThreadSafe>(Mapped.Release()));
+			}
+			else if (!FHazeBlobCache::Contains(Ref.Value))
+			{
+				bCached = false;
+				break;
+			}
+			// Cached but unmappable (empty, or no mapping on this platform): FindBlob returns null for it
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, AssetId, Generation, bCached, Bytes, Blobs = MoveTemp(Blobs)]() mutable
+		{
+			UHazeAssetStreamer* This = WeakThis.Get();
+			if (!This) return;
+			FEntry* Done = This->FinishLoad(AssetId, Generation, true);
+			if (!Done) return;
+			if (!bCached)
+			{
+				// The blob cache was cleared under us: fall back so Dense downloads it again
+				This->EvictTo(AssetId, *Done, EDensityLevel::Light);
+				return;
+			}
+			const int64 OldBytes = Done->GetBytes();
+			Done->Blobs = MoveTemp(Blobs);
+			Done->BlobBytes = Bytes;
+			This->ResidentBytes += Done->GetBytes() - OldBytes;
+			This->SetLoadedTier(AssetId, *Done, EDensityLevel::Core);
+		});
+	});
+}
+
+UHazeAssetStreamer::FEntry* UHazeAssetStreamer::FinishLoad(const FString& AssetId, uint32 Generation, bool bOk)
+{
+	LoadsInFlight = FMath::Max(0, LoadsInFlight - 1);
+	FEntry* Entry = Entries.Find(AssetId);
+	if (!Entry || Entry->Generation != Generation) return nullptr;
+	Entry->bLoading = false;
+	if (!bOk)
+	{
+		Entry->RetryAt = FPlatformTime::Seconds() + RetryDelaySeconds;
+		return nullptr;
+	}
+	return Entry;
+}
+
+void UHazeAssetStreamer::SetLoadedTier(const FString& AssetId, FEntry& Entry, EDensityLevel Tier)
+{
+	Entry.LoadedTier = Tier;
+	OnTierLoaded.Broadcast(AssetId, Tier);
+}
+
+void UHazeAssetStreamer::EvictTo(const FString& AssetId, FEntry& Entry, EDensityLevel Tier, bool bDropSummary)
+{
+	if (!bDropSummary && Tier >= Entry.LoadedTier) return;
+
+	TArray<EDensityLevel, TInlineAllocator<4>> Evicted;
+	if (Entry.bHasSummary)
+	{
+		const int32 Floor = bDropSummary ? -1 : static_cast<int32>(Tier);
+		for (int32 Level = static_cast<int32>(Entry.LoadedTier); Level > Floor; Level--)
+		{
+			Evicted.Add(static_cast<EDensityLevel>(Level));
+		}
+	}
+
+	const int64 OldBytes = Entry.GetBytes();
+	Entry.Generation = ++GenerationCounter;
+	Entry.bLoading = false;
+	Entry.UnwantedSince = 0.0;
+	if (bDropSummary || Tier < EDensityLevel::Core)
+	{
+		Entry.Blobs.Empty();
+		Entry.BlobBytes = 0;
+	}
+	if (bDropSummary || Tier < EDensityLevel::Light)
+	{
+		Entry.Full = FHazeAssetInfo();
+		Entry.FullBytes = 0;
+	}
+	if (bDropSummary)
+	{
+		Entry.Summary = FHazeAssetInfo();
+		Entry.SummaryBytes = 0;
+		Entry.bHasSummary = false;
+		Entry.bSummaryQueued = false;
+		Entry.RetryAt = 0.0;
+	}
+	Entry.LoadedTier = bDropSummary ? EDensityLevel::Ethereal : Tier;
+	ResidentBytes += Entry.GetBytes() - OldBytes;
+
+	// Last: handlers may untrack
+	for (EDensityLevel Level : Evicted)
+	{
+		OnTierEvicted.Broadcast(AssetId, Level);
+	}
+}
+
+void UHazeAssetStreamer::EnforceBudget(const TArray<FString>& Order)
+{
+	for (int32 i = Order.Num() - 1; i >= 0 && ResidentBytes > MemoryBudgetBytes; i--)
+	{
+		// Summaries stay: they are small, and without them the asset cannot be placed at all
+		for (FEntry* Entry = Entries.Find(Order[i]); Entry && Entry->bHasSummary && Entry->LoadedTier > EDensityLevel::Ethereal
+			&& ResidentBytes > MemoryBudgetBytes; Entry = Entries.Find(Order[i]))
+		{
+			const EDensityLevel Lower = PreviousTier(Entry->LoadedTier);
+			Entry->BudgetCap = Lower;
+			EvictTo(Order[i], *Entry, Lower);
+		}
+	}
+}
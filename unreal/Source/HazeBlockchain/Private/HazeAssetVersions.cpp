@@ -0,0 +1,327 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeAssetVersions.h"
+#include "HazeEventStream.h"
+
+namespace
+{
+	/** Events after which an asset has a new version or history entry */
+	constexpr EHazeStreamEventType AssetChangeEvents[] =
+	{
+		EHazeStreamEventType::AssetUpdated,
+		EHazeStreamEventType::AssetCondensed,
+		EHazeStreamEventType::AssetEvaporated,
+		EHazeStreamEventType::AssetMerged,
+		EHazeStreamEventType::AssetSplit,
+		EHazeStreamEventType::AssetAttributeUpdated,
+		EHazeStreamEventType::AssetVersionCreated,
+	};
+}
+
+int32 UHazeAssetVersionCache::FStringTable::Add(const FString& Value)
+{
+	if (const int32* Id = Ids.Find(Value))
+	{
+		RefCounts[*Id]++;
+		return *Id;
+	}
+	int32 Id;
+	if (FreeIds.Num() > 0)
+	{
+		Id = FreeIds.Pop();
+		Values[Id] = Value;
+		RefCounts[Id] = 1;
+	}
+	else
+	{
+		Id = Values.Add(Value);
+		RefCounts.Add(1);
+	}
+	Ids.Add(Value, Id);
+	return Id;
+}
+
+void UHazeAssetVersionCache::FStringTable::Release(int32 Id)
+{
+	if (--RefCounts[Id] > 0) return;
+	Ids.Remove(Values[Id]);
+	Values[Id].Empty();
+	FreeIds.Add(Id);
+}
+
+UHazeAssetVersionCache* UHazeAssetVersionCache::CreateAssetVersionCache(UHazeClient* InClient)
+{
+	UHazeAssetVersionCache* Cache = NewObject<UHazeAssetVersionCache>();
+	Cache->Client = InClient;
+	return Cache;
+}
+
+void UHazeAssetVersionCache::Track(const FString& AssetId)
+{
+	const FString Key = AssetId.ToLower();
+	if (Key.IsEmpty() || Tracked.Contains(Key)) return;
+	Tracked.Add(Key);
+	Sync(Key);
+}
+
+void UHazeAssetVersionCache::Untrack(const FString& AssetId)
+{
+	FTracked Entry;
+	if (Tracked.RemoveAndCopyValue(AssetId.ToLower(), Entry))
+	{
+		ReleaseVersions(Entry);
+	}
+}
+
+void UHazeAssetVersionCache::Sync(const FString& AssetId)
+{
+	const FString Key = AssetId.ToLower();
+	FTracked* Entry = Tracked.Find(Key);
+	if (!Entry || !Client) return;
+	if (Entry->Pending > 0)
+	{
+		Entry->bResync = true;
+		return;
+	}
+	Entry->Pending = 2;
+	Entry->bSyncOk = true;
+	Entry->bChanged = false;
+	const int64 SinceVersion = GetKnownVersion(Key);
+	const int64 SinceHistory = Entry->NextHistoryIndex;
+
+	const TWeakObjectPtr<UHazeAssetVersionCache> WeakThis(this);
+	Client->FetchAssetVersionsSince(Key, SinceVersion, [WeakThis, Key](bool bOk, const FHazeAssetVersionsPage& Page)
+	{
+		UHazeAssetVersionCache* This = WeakThis.Get();
+		if (!This) return;
+		// An unknown base drops the versions and marks the asset for a full refetch
+		if (bOk) This->ApplyVersions(Key, Page);
+		This->FinishRequest(Key, bOk);
+	});
+	Client->FetchAssetHistorySince(Key, SinceHistory, 0, [WeakThis, Key](bool bOk, const FHazeAssetHistoryPage& Page)
+	{
+		UHazeAssetVersionCache* This = WeakThis.Get();
+		if (!This) return;
+		if (bOk) This->ApplyHistory(Key, Page);
+		This->FinishRequest(Key, bOk);
+	});
+}
+
+void UHazeAssetVersionCache::SyncAll()
+{
+	TArray<FString> Keys;
+	Tracked.GetKeys(Keys);
+	for (const FString& Key : Keys)
+	{
+		Sync(Key);
+	}
+}
+
+void UHazeAssetVersionCache::FinishRequest(const FString& Key, bool bOk)
+{
+	FTracked* Entry = Tracked.Find(Key);
+	if (!Entry || Entry->Pending == 0) return;
+	Entry->bSyncOk &= bOk;
+	if (--Entry->Pending > 0) return;
+
+	const bool bSyncOk = Entry->bSyncOk;
+	const bool bChanged = Entry->bChanged;
+	const bool bResync = Entry->bResync;
+	Entry->bResync = false;
+	OnSynced.Broadcast(Key, bSyncOk, bChanged);
+	if (bResync) Sync(Key);
+}
+
+void UHazeAssetVersionCache::BindEventStream(UHazeEventStream* Stream)
+{
+	if (!Stream) return;
+	for (EHazeStreamEventType Type : AssetChangeEvents)
+	{
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = Type;
+		Stream->Subscribe(Subscription);
+	}
+	Stream->OnEventNative().AddUObject(this, &UHazeAssetVersionCache::HandleStreamEvent);
+}
+
+void UHazeAssetVersionCache::HandleStreamEvent(const FHazeStreamEvent& Event)
+{
+	bool bAssetChange = false;
+	for (EHazeStreamEventType Type : AssetChangeEvents)
+	{
+		bAssetChange |= Event.Type == Type;
+	}
+	if (!bAssetChange) return;
+
+	Sync(Event.AssetId);
+	// A merge also changes the asset merged away
+	for (const FString& Related : Event.RelatedAssetIds)
+	{
+		Sync(Related);
+	}
+}
+
+bool UHazeAssetVersionCache::ApplyVersions(const FString& AssetId, const FHazeAssetVersionsPage& Page)
+{
+	FTracked* Entry = Tracked.Find(AssetId.ToLower());
+	if (!Entry) return false;
+
+	for (const FHazeAssetVersionDelta& Delta : Page.Versions)
+	{
+		// Overlapping syncs return the same versions twice
+		const int64 Known = Entry->Versions.Num() > 0 ? Entry->Versions.Last().Header.Version : 0;
+		if (Delta.Version.Version <= Known) continue;
+
+		TMap<FString, FString> BlobRefs;
+		if (Delta.BlobRefsBase != 0)
+		{
+			const FStoredVersion* Base = Entry->Versions.FindByPredicate([&Delta](const FStoredVersion& Stored)
+			{
+				return Stored.Header.Version == Delta.BlobRefsBase;
+			});
+			if (!Base)
+			{
+				ReleaseVersions(*Entry);
+				Entry->bResync = true;
+				Entry->bChanged = true;
+				return false;
+			}
+			BlobRefs = Materialize(*Base).BlobRefs;
+			for (const FString& Removed : Delta.RemovedBlobRefs)
+			{
+				BlobRefs.Remove(Removed);
+			}
+		}
+		BlobRefs.Append(Delta.Version.BlobRefs);
+
+		FStoredVersion& Stored = Entry->Versions.AddDefaulted_GetRef();
+		Stored.Header = Delta.Version;
+		Stored.Header.BlobRefs.Empty();
+		Stored.BlobRefs.Reserve(BlobRefs.Num());
+		for (const TPair<FString, FString>& Ref : BlobRefs)
+		{
+			Stored.BlobRefs.Emplace(BlobKeys.Add(Ref.Key), BlobHashes.Add(Ref.Value.ToLower()));
+		}
+		Entry->bChanged = true;
+	}
+	// After the whole page: a delta may be based on an older version in the same page
+	Prune(*Entry);
+	return true;
+}
+
+void UHazeAssetVersionCache::ApplyHistory(const FString& AssetId, const FHazeAssetHistoryPage& Page)
+{
+	FTracked* Entry = Tracked.Find(AssetId.ToLower());
+	if (!Entry) return;
+	for (const FHazeAssetHistoryEntry& History : Page.Entries)
+	{
+		if (History.Index < Entry->NextHistoryIndex) continue;
+		Entry->History.Add(History);
+		Entry->bChanged = true;
+	}
+	Entry->NextHistoryIndex = FMath::Max(Entry->NextHistoryIndex, Page.NextIndex);
+	Prune(*Entry);
+}
+
+void UHazeAssetVersionCache::ReleaseVersion(const FStoredVersion& Stored)
+{
+	for (const TPair<int32, int32>& Ref : Stored.BlobRefs)
+	{
+		BlobKeys.Release(Ref.Key);
+		BlobHashes.Release(Ref.Value);
+	}
+}
+
+void UHazeAssetVersionCache::ReleaseVersions(FTracked& Entry)
+{
+	for (const FStoredVersion& Stored : Entry.Versions)
+	{
+		ReleaseVersion(Stored);
+	}
+	Entry.Versions.Reset();
+}
+
+void UHazeAssetVersionCache::Prune(FTracked& Entry)
+{
+	// New deltas are based on the newest version held, so the oldest can go without forcing a refetch
+	const int32 ExtraVersions = MaxVersions > 0 ? Entry.Versions.Num() - MaxVersions : 0;
+	if (ExtraVersions > 0)
+	{
+		for (int32 i = 0; i < ExtraVersions; i++)
+		{
+			ReleaseVersion(Entry.Versions[i]);
+		}
+		Entry.Versions.RemoveAt(0, ExtraVersions);
+	}
+	// NextHistoryIndex is kept, so dropped entries are not fetched again
+	const int32 ExtraHistory = MaxHistoryEntries > 0 ? Entry.History.Num() - MaxHistoryEntries : 0;
+	if (ExtraHistory > 0)
+	{
+		Entry.History.RemoveAt(0, ExtraHistory);
+	}
+}
+
+FHazeAssetVersion UHazeAssetVersionCache::Materialize(const FStoredVersion& Stored) const
+{
+	FHazeAssetVersion Version = Stored.Header;
+	Version.BlobRefs.Reserve(Stored.BlobRefs.Num());
+	for (const TPair<int32, int32>& Ref : Stored.BlobRefs)
+	{
+		Version.BlobRefs.Add(BlobKeys.Values[Ref.Key], BlobHashes.Values[Ref.Value]);
+	}
+	return Version;
+}
+
+TArray<FHazeAssetVersion> UHazeAssetVersionCache::GetVersions(const FString& AssetId) const
+{
+	TArray<FHazeAssetVersion> Versions;
+	if (const FTracked* Entry = Tracked.Find(AssetId.ToLower()))
+	{
+		Versions.Reserve(Entry->Versions.Num());
+		for (const FStoredVersion& Stored : Entry->Versions)
+		{
+			Versions.Add(Materialize(Stored));
+		}
+	}
+	return Versions;
+}
+
+bool UHazeAssetVersionCache::GetVersion(const FString& AssetId, int64 Version, FHazeAssetVersion& OutVersion) const
+{
+	const FTracked* Entry = Tracked.Find(AssetId.ToLower());
+	if (!Entry) return false;
+	for (const FStoredVersion& Stored : Entry->Versions)
+	{
+		if (Stored.Header.Version == Version)
+		{
+			OutVersion = Materialize(Stored);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UHazeAssetVersionCache::GetLatestVersion(const FString& AssetId, FHazeAssetVersion& OutVersion) const
+{
+	const FTracked* Entry = Tracked.Find(AssetId.ToLower());
+	if (!Entry || Entry->Versions.Num() == 0) return false;
+	OutVersion = Materialize(Entry->Versions.Last());
+	return true;
+}
+
+int64 UHazeAssetVersionCache::GetKnownVersion(const FString& AssetId) const
+{
+	const FTracked* Entry = Tracked.Find(AssetId.ToLower());
+	return Entry && Entry->Versions.Num() > 0 ? Entry->Versions.Last().Header.Version : 0;
+}
+
+TArray<FHazeAssetHistoryEntry> UHazeAssetVersionCache::GetHistory(const FString& AssetId) const
+{
+	const FTracked* Entry = Tracked.Find(AssetId.ToLower());
+	return Entry ? Entry->History : TArray<FHazeAssetHistoryEntry>();
+}
+
+int32 UHazeAssetVersionCache::GetBlobHashCount() const
+{
+	return BlobHashes.Ids.Num();
+}
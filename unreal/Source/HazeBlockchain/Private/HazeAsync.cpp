@@ -0,0 +1,284 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeAsync.h"
+#include "Async/Async.h"
+
+namespace
+{
+	FHazeError MakeError(EHazeErrorKind Kind, int32 ResponseCode, FString Message)
+	{
+		FHazeError Error;
+		Error.Kind = Kind;
+		Error.ResponseCode = ResponseCode;
+		Error.Message = MoveTemp(Message);
+		return Error;
+	}
+
+	/**
+	 * The promise behind one call. Set once; if the callback holding it is dropped without firing (the client or
+	 * follower went away first) the future still completes, as Abandoned: TPromise does not allow broken promises.
+	 */
+	template <typename ValueType>
+	class THazeCompletion
+	{
+	public:
+		~THazeCompletion()
+		{
+			if (!bSet)
+			{
+				Promise.SetValue(THazeResult<ValueType>::Fail(MakeError(EHazeErrorKind::Abandoned, 0, TEXT("Abandoned before completion"))));
+			}
+		}
+
+		THazeFuture<ValueType> GetFuture() { return Promise.GetFuture(); }
+
+		void Set(THazeResult<ValueType> Result)
+		{
+			if (bSet) return;
+			bSet = true;
+			Promise.SetValue(MoveTemp(Result));
+		}
+
+	private:
+		TPromise<THazeResult<ValueType>> Promise;
+		bool bSet = false;
+	};
+
+	template <typename ValueType>
+	using TCompletionRef = TSharedRef<THazeCompletion<ValueType>, ESPMode::ThreadSafe>;
+
+	template <typename ValueType>
+	THazeResult<ValueType> FromCallback(bool bOk, const ValueType& Value, const TCHAR* Call)
+	{
+		if (bOk) return THazeResult<ValueType>::Ok(Value);
+		return THazeResult<ValueType>::Fail(MakeError(EHazeErrorKind::Request, 0, FString::Printf(TEXT("%s failed"), Call)));
+	}
+
+	/** Submissions report the HTTP status; a 4xx is the node refusing the transaction rather than a failed request */
+	template <typename ValueType>
+	THazeResult<ValueType> FromSubmission(bool bOk, const ValueType& Value, int32 ResponseCode, const TCHAR* Call)
+	{
+		if (bOk) return THazeResult<ValueType>::Ok(Value, ResponseCode);
+		const bool bRejected = ResponseCode >= 400 && ResponseCode < 500;
+		return THazeResult<ValueType>::Fail(MakeError(bRejected ? EHazeErrorKind::Rejected : EHazeErrorKind::Request, ResponseCode,
+			FString::Printf(bRejected ? TEXT("%s rejected (HTTP %d)") : TEXT("%s failed (HTTP %d)"), Call, ResponseCode)));
+	}
+
+	/** Run Begin(Client, Completion) on the game thread, where the client's requests start */
+	template <typename ValueType, typename BeginFn>
+	THazeFuture<ValueType> Start(UHazeClient* Client, BeginFn&& Begin)
+	{
+		TCompletionRef<ValueType> Completion = MakeShared<THazeCompletion<ValueType>, ESPMode::ThreadSafe>();
+		THazeFuture<ValueType> Future = Completion->GetFuture();
+		if (!Client)
+		{
+			Completion->Set(THazeResult<ValueType>::Fail(MakeError(EHazeErrorKind::InvalidInput, 0, TEXT("No client"))));
+			return Future;
+		}
+
+		auto Run = [WeakClient = TWeakObjectPtr<UHazeClient>(Client), Completion, Begin = Forward<BeginFn>(Begin)]() mutable
+		{
+			if (UHazeClient* Target = WeakClient.Get())
+			{
+				Begin(*Target, Completion);
+			}
+		};
+		if (IsInGameThread())
+		{
+			Run();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(Run));
+		}
+		return Future;
+	}
+}
+
+namespace HazeAsync
+{
+	THazeFuture<FString> FetchHealth(UHazeClient* Client)
+	{
+		return Start<FString>(Client, [](UHazeClient& Target, const TCompletionRef<FString>& Done)
+		{
+			Target.FetchHealth([Done](bool bOk, const FString& Health) { Done->Set(FromCallback(bOk, Health, TEXT("FetchHealth"))); });
+		});
+	}
+
+	THazeFuture<FBlockchainInfo> FetchBlockchainInfo(UHazeClient* Client)
+	{
+		return Start<FBlockchainInfo>(Client, [](UHazeClient& Target, const TCompletionRef<FBlockchainInfo>& Done)
+		{
+			Target.FetchBlockchainInfo([Done](bool bOk, const FBlockchainInfo& Info) { Done->Set(FromCallback(bOk, Info, TEXT("FetchBlockchainInfo"))); });
+		});
+	}
+
+	THazeFuture<FHazeAmount> FetchBalance(UHazeClient* Client, const FString& AddressHex)
+	{
+		return Start<FHazeAmount>(Client, [AddressHex](UHazeClient& Target, const TCompletionRef<FHazeAmount>& Done)
+		{
+			Target.FetchBalance(AddressHex, [Done](bool bOk, const FHazeAmount& Balance) { Done->Set(FromCallback(bOk, Balance, TEXT("FetchBalance"))); });
+		});
+	}
+
+	THazeFuture<FAccountInfo> FetchAccount(UHazeClient* Client, const FString& AddressHex)
+	{
+		return Start<FAccountInfo>(Client, [AddressHex](UHazeClient& Target, const TCompletionRef<FAccountInfo>& Done)
+		{
+			Target.FetchAccount(AddressHex, [Done](bool bOk, const FAccountInfo& Info) { Done->Set(FromCallback(bOk, Info, TEXT("FetchAccount"))); });
+		});
+	}
+
+	THazeFuture<FHazeBlockInfo> FetchBlockByHeight(UHazeClient* Client, int64 Height)
+	{
+		return Start<FHazeBlockInfo>(Client, [Height](UHazeClient& Target, const TCompletionRef<FHazeBlockInfo>& Done)
+		{
+			Target.FetchBlockByHeight(Height, [Done](bool bOk, const FHazeBlockInfo& Block) { Done->Set(FromCallback(bOk, Block, TEXT("FetchBlockByHeight"))); });
+		});
+	}
+
+	THazeFuture<FHazeAssetInfo> FetchAsset(UHazeClient* Client, const FString& AssetIdHex)
+	{
+		return Start<FHazeAssetInfo>(Client, [AssetIdHex](UHazeClient& Target, const TCompletionRef<FHazeAssetInfo>& Done)
+		{
+			Target.FetchAsset(AssetIdHex, [Done](bool bOk, const FHazeAssetInfo& Asset) { Done->Set(FromCallback(bOk, Asset, TEXT("FetchAsset"))); });
+		});
+	}
+
+	THazeFuture<TArray<FHazeAssetInfo>> FetchAssetSummaries(UHazeClient* Client, const TArray<FString>& AssetIdsHex)
+	{
+		return Start<TArray<FHazeAssetInfo>>(Client, [AssetIdsHex](UHazeClient& Target, const TCompletionRef<TArray<FHazeAssetInfo>>& Done)
+		{
+			Target.FetchAssetSummaries(AssetIdsHex, [Done](bool bOk, const TArray<FHazeAssetInfo>& Assets)
+			{
+				Done->Set(FromCallback(bOk, Assets, TEXT("FetchAssetSummaries")));
+			});
+		});
+	}
+
+	THazeFuture<FHazeBlobDownloadResult> FetchAssetBlob(UHazeClient* Client, const FString& AssetIdHex, const FString& BlobKey)
+	{
+		return Start<FHazeBlobDownloadResult>(Client, [AssetIdHex, BlobKey](UHazeClient& Target, const TCompletionRef<FHazeBlobDownloadResult>& Done)
+		{
+			Target.FetchAssetBlob(AssetIdHex, BlobKey, [Done](bool bOk, const FHazeBlobDownloadResult& Result)
+			{
+				if (bOk || Result.Error.IsEmpty())
+				{
+					Done->Set(FromCallback(bOk, Result, TEXT("FetchAssetBlob")));
+					return;
+				}
+				THazeResult<FHazeBlobDownloadResult> Failed = THazeResult<FHazeBlobDownloadResult>::Fail(MakeError(EHazeErrorKind::Request, 0, Result.Error));
+				Failed.Value = Result;
+				Done->Set(MoveTemp(Failed));
+			});
+		});
+	}
+
+	THazeFuture<TArray<FLiquidityPool>> FetchLiquidityPools(UHazeClient* Client)
+	{
+		return Start<TArray<FLiquidityPool>>(Client, [](UHazeClient& Target, const TCompletionRef<TArray<FLiquidityPool>>& Done)
+		{
+			Target.FetchLiquidityPools([Done](bool bOk, const TArray<FLiquidityPool>& Pools) { Done->Set(FromCallback(bOk, Pools, TEXT("FetchLiquidityPools"))); });
+		});
+	}
+
+	THazeFuture<FLiquidityPool> FetchLiquidityPool(UHazeClient* Client, const FString& PoolId)
+	{
+		return Start<FLiquidityPool>(Client, [PoolId](UHazeClient& Target, const TCompletionRef<FLiquidityPool>& Done)
+		{
+			Target.FetchLiquidityPool(PoolId, [Done](bool bOk, const FLiquidityPool& Pool) { Done->Set(FromCallback(bOk, Pool, TEXT("FetchLiquidityPool"))); });
+		});
+	}
+
+	THazeFuture<FTransactionResponse> SubmitTransaction(UHazeClient* Client, const FString& TransactionJson)
+	{
+		return Start<FTransactionResponse>(Client, [TransactionJson](UHazeClient& Target, const TCompletionRef<FTransactionResponse>& Done)
+		{
+			Target.SubmitTransaction(TransactionJson, [Done](bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
+			{
+				Done->Set(FromSubmission(bAccepted, Response, ResponseCode, TEXT("SubmitTransaction")));
+			});
+		});
+	}
+
+	THazeFuture<FTransactionResponse> SubmitTransactionBinary(UHazeClient* Client, TArray<uint8> Transaction)
+	{
+		return Start<FTransactionResponse>(Client, [Transaction = MoveTemp(Transaction)](UHazeClient& Target, const TCompletionRef<FTransactionResponse>& Done) mutable
+		{
+			Target.SubmitTransactionBinary(MoveTemp(Transaction), [Done](bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
+			{
+				Done->Set(FromSubmission(bAccepted, Response, ResponseCode, TEXT("SubmitTransactionBinary")));
+			});
+		});
+	}
+
+	THazeFuture<TArray<FBatchTransactionResult>> SubmitTransactionBatch(UHazeClient* Client, const TArray<FString>& TransactionJsons)
+	{
+		return Start<TArray<FBatchTransactionResult>>(Client, [TransactionJsons](UHazeClient& Target, const TCompletionRef<TArray<FBatchTransactionResult>>& Done)
+		{
+			Target.SubmitTransactionBatch(TransactionJsons, [Done](bool bOk, const TArray<FBatchTransactionResult>& Results, int32 ResponseCode)
+			{
+				Done->Set(FromSubmission(bOk, Results, ResponseCode, TEXT("SubmitTransactionBatch")));
+			});
+		});
+	}
+
+	THazeFuture<TArray<FBatchTransactionResult>> SubmitTransactionBatchBinary(UHazeClient* Client, const TArray<TArray<uint8>>& Transactions)
+	{
+		return Start<TArray<FBatchTransactionResult>>(Client, [Transactions](UHazeClient& Target, const TCompletionRef<TArray<FBatchTransactionResult>>& Done)
+		{
+			Target.SubmitTransactionBatchBinary(Transactions, [Done](bool bOk, const TArray<FBatchTransactionResult>& Results, int32 ResponseCode)
+			{
+				Done->Set(FromSubmission(bOk, Results, ResponseCode, TEXT("SubmitTransactionBatchBinary")));
+			});
+		});
+	}
+
+	THazeFuture<FHazeReceipt> WaitForReceipt(UHazeChainFollower* Follower, const FString& TxHash, EHazeReceiptStatus Status)
+	{
+		check(IsInGameThread());
+		TCompletionRef<FHazeReceipt> Completion = MakeShared<THazeCompletion<FHazeReceipt>, ESPMode::ThreadSafe>();
+		THazeFuture<FHazeReceipt> Future = Completion->GetFuture();
+		if (!Follower || TxHash.IsEmpty() || Status == EHazeReceiptStatus::Pending)
+		{
+			Completion->Set(THazeResult<FHazeReceipt>::Fail(MakeError(EHazeErrorKind::InvalidInput, 0, TEXT("Nothing to wait for"))));
+			return Future;
+		}
+
+		// Followed until final like TrackTransaction, whoever else listens; re-tracking an already confirmed
+		// transaction does not fire callbacks again
+		Follower->TrackTransaction(TxHash);
+		FHazeReceipt Current;
+		if (Follower->GetReceipt(TxHash, Current) && Current.Status >= Status)
+		{
+			Completion->Set(THazeResult<FHazeReceipt>::Ok(Current));
+			return Future;
+		}
+		// The listener leaves once the wait is over; the follower keeps the others. A block already held confirms inside
+		// TrackTransactionNative, before its handle is known, so the handle is removed after the call in that case.
+		struct FListener
+		{
+			uint64 Handle = 0;
+			bool bDone = false;
+		};
+		TSharedRef<FListener> Listener = MakeShared<FListener>();
+		TWeakObjectPtr<UHazeChainFollower> WeakFollower(Follower);
+		const uint64 Handle = Follower->TrackTransactionNative(TxHash, [Completion, Status, Listener, WeakFollower](const FHazeReceipt& Receipt)
+		{
+			if (Receipt.Status < Status || Listener->bDone) return;
+			Listener->bDone = true;
+			Completion->Set(THazeResult<FHazeReceipt>::Ok(Receipt));
+			UHazeChainFollower* Owner = WeakFollower.Get();
+			if (Owner && Listener->Handle != 0)
+			{
+				Owner->RemoveReceiptListener(Receipt.TxHash, Listener->Handle);
+			}
+		});
+		Listener->Handle = Handle;
+		if (Listener->bDone)
+		{
+			Follower->RemoveReceiptListener(TxHash, Handle);
+		}
+		return Future;
+	}
+}
@@ -0,0 +1,112 @@
+// Copyright HAZE Blockchain. bincode 1.x encoding of node types (application/x-haze-bincode).
+
+#include "HazeBincode.h"
+
+void FHazeBincodeWriter::WriteU32(uint32 Value)
+{
+	uint8 Bytes[4];
+	for (int32 i = 0; i < 4; i++) Bytes[i] = static_cast<uint8>(Value >> (8 * i));
+	Out.Append(Bytes, 4);
+}
+
+void FHazeBincodeWriter::WriteU64(uint64 Value)
+{
+	uint8 Bytes[8];
+	for (int32 i = 0; i < 8; i++) Bytes[i] = static_cast<uint8>(Value >> (8 * i));
+	Out.Append(Bytes, 8);
+}
+
+void FHazeBincodeWriter::WriteBytes(TArrayView<const uint8> Bytes)
+{
+	WriteLength(Bytes.Num());
+	WriteFixed(Bytes);
+}
+
+void FHazeBincodeWriter::WriteString(FStringView Value)
+{
+	const FTCHARToUTF8 Utf8(Value.GetData(), Value.Len());
+	WriteLength(Utf8.Length());
+	Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+void FHazeBincodeWriter::WriteOptionU64(TOptional<uint64> Value)
+{
+	WriteBool(Value.IsSet());
+	if (Value.IsSet()) WriteU64(Value.GetValue());
+}
+
+void FHazeBincodeWriter::WriteOptionString(FStringView Value)
+{
+	WriteBool(!Value.IsEmpty());
+	if (!Value.IsEmpty()) WriteString(Value);
+}
+
+const uint8* FHazeBincodeReader::Take(int32 Num)
+{
+	if (!bOk || Num < 0 || Num > Data.Num() - Offset)
+	{
+		bOk = false;
+		return nullptr;
+	}
+	const uint8* Bytes = Data.GetData() + Offset;
+	Offset += Num;
+	return Bytes;
+}
+
+uint8 FHazeBincodeReader::ReadU8()
+{
+	const uint8* Bytes = Take(1);
+	return Bytes ? Bytes[0] : 0;
+}
+
+bool FHazeBincodeReader::ReadBool()
+{
+	const uint8 Value = ReadU8();
+	// bincode rejects anything but 0 and 1
+	if (Value > 1) bOk = false;
+	return bOk && Value == 1;
+}
+
+uint32 FHazeBincodeReader::ReadU32()
+{
+	const uint8* Bytes = Take(4);
+	if (!Bytes) return 0;
+	uint32 Value = 0;
+	for (int32 i = 0; i < 4; i++) Value |= static_cast<uint32>(Bytes[i]) << (8 * i);
+	return Value;
+}
+
+uint64 FHazeBincodeReader::ReadU64()
+{
+	const uint8* Bytes = Take(8);
+	if (!Bytes) return 0;
+	uint64 Value = 0;
+	for (int32 i = 0; i < 8; i++) Value |= static_cast<uint64>(Bytes[i]) << (8 * i);
+	return Value;
+}
+
+bool FHazeBincodeReader::ReadSome()
+{
+	return ReadBool();
+}
+
+int32 FHazeBincodeReader::ReadLength(int32 MinElementSize)
+{
+	const uint64 Num = ReadU64();
+	if (!bOk) return 0;
+	if (Num > static_cast<uint64>(Data.Num() - Offset) / FMath::Max(MinElementSize, 1))
+	{
+		bOk = false;
+		return 0;
+	}
+	return static_cast<int32>(Num);
+}
+
+FString FHazeBincodeReader::ReadString()
+{
+	const int32 Len = ReadLength();
+	const uint8* Bytes = Take(Len);
+	if (!Bytes || Len == 0) return FString();
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes), Len);
+	return FString(Converted.Length(), Converted.Get());
+}
@@ -0,0 +1,84 @@
+// Copyright HAZE Blockchain. Content-addressed on-disk cache for Core-density blobs.
+
+#include "HazeBlobCache.h"
+#include "HazeHex.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+FHazeMappedBlob::FHazeMappedBlob(TUniquePtr<IMappedFileHandle> InHandle, TUniquePtr<IMappedFileRegion> InRegion)
+	: Handle(MoveTemp(InHandle))
+	, Region(MoveTemp(InRegion))
+{
+}
+
+FHazeMappedBlob::~FHazeMappedBlob()
+{
+	// The region must go before the handle it was mapped from
+	Region.Reset();
+	Handle.Reset();
+}
+
+const uint8* FHazeMappedBlob::GetData() const
+{
+	return Region ? Region->GetMappedPtr() : nullptr;
+}
+
+int64 FHazeMappedBlob::GetSize() const
+{
+	return Region ? Region->GetMappedSize() : 0;
+}
+
+FString FHazeBlobCache::GetCacheDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HazeBlobs"));
+}
+
+FString FHazeBlobCache::GetBlobPath(const FString& BlobHashHex)
+{
+	return FPaths::Combine(GetCacheDirectory(), NormalizeHash(BlobHashHex) + TEXT(".blob"));
+}
+
+FString FHazeBlobCache::GetPartialPath(const FString& BlobHashHex)
+{
+	return FPaths::Combine(GetCacheDirectory(), NormalizeHash(BlobHashHex) + TEXT(".part"));
+}
+
+bool FHazeBlobCache::Contains(const FString& BlobHashHex)
+{
+	const FString Hash = NormalizeHash(BlobHashHex);
+	return !Hash.IsEmpty() && FPlatformFileManager::Get().GetPlatformFile().FileExists(*GetBlobPath(Hash));
+}
+
+TUniquePtr<FHazeMappedBlob> FHazeBlobCache::Map(const FString& BlobHashHex)
+{
+	if (!Contains(BlobHashHex)) return nullptr;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IMappedFileHandle> Handle(PlatformFile.OpenMapped(*GetBlobPath(BlobHashHex)));
+	if (!Handle || Handle->GetFileSize() <= 0) return nullptr;
+
+	TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+	if (!Region) return nullptr;
+	return MakeUnique<FHazeMappedBlob>(MoveTemp(Handle), MoveTemp(Region));
+}
+
+void FHazeBlobCache::Remove(const FString& BlobHashHex)
+{
+	const FString Hash = NormalizeHash(BlobHashHex);
+	if (Hash.IsEmpty()) return;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.DeleteFile(*GetBlobPath(Hash));
+	PlatformFile.DeleteFile(*GetPartialPath(Hash));
+}
+
+FString FHazeBlobCache::NormalizeHash(const FString& BlobHashHex)
+{
+	FString Hash = BlobHashHex.TrimStartAndEnd().ToLower();
+	if (Hash.Len() != 64) return FString();
+	for (TCHAR C : Hash)
+	{
+		if (FHazeHex::DigitValue(C) < 0) return FString();
+	}
+	return Hash;
+}
@@ -0,0 +1,324 @@
+// Copyright HAZE Blockchain. Ranged, resumable blob download into FHazeBlobCache.
+
+#include "HazeBlobDownload.h"
+#include "HazeBlobCache.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** Read size when re-hashing a partial file on resume */
+	constexpr int64 ResumeReadSize = 1024 * 1024;
+}
+
+FHazeBlobDownload::FHazeBlobDownload(FString InBlobHash, int32 InChunkSize, FHazeBlobTransport InTransport)
+	: BlobHash(MoveTemp(InBlobHash))
+	, ChunkSize(FMath::Max(InChunkSize, 64 * 1024))
+	, Transport(MoveTemp(InTransport))
+{
+	PartPath = FHazeBlobCache::GetPartialPath(BlobHash);
+	FinalPath = FHazeBlobCache::GetBlobPath(BlobHash);
+}
+
+void FHazeBlobDownload::AddWaiter(FHazeOnBlobDownload OnComplete, FHazeOnBlobProgress OnProgress)
+{
+	Waiters.Add({ MoveTemp(OnComplete), MoveTemp(OnProgress) });
+}
+
+void FHazeBlobDownload::Start(TFunction<void()> InOnFinished)
+{
+	if (bStarted) return;
+	bStarted = true;
+	OnFinished = MoveTemp(InOnFinished);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [This = AsShared()]() { This->ResumeFromDisk(); });
+}
+
+void FHazeBlobDownload::ResumeFromDisk()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (PlatformFile.FileExists(*FinalPath))
+	{
+		const int64 Size = PlatformFile.FileSize(*FinalPath);
+		AsyncTask(ENamedThreads::GameThread, [This = AsShared(), Size]()
+		{
+			This->Offset = Size;
+			This->Finish(true, FString(), true);
+		});
+		return;
+	}
+
+	// Bring the hasher up to date with what an earlier session already wrote
+	int64 Resumed = 0;
+	Hasher.Reset();
+	TUniquePtr<IFileHandle> File(PlatformFile.OpenRead(*PartPath));
+	if (File)
+	{
+		const int64 Size = File->Size();
+		TArray<uint8> Block;
+		Block.SetNumUninitialized(static_cast<int32>(FMath::Min(Size, ResumeReadSize)));
+		while (Resumed < Size)
+		{
+			const int64 Take = FMath::Min<int64>(Block.Num(), Size - Resumed);
+			if (!File->Read(Block.GetData(), Take)) break;
+			Hasher.Update(Block.GetData(), Take);
+			Resumed += Take;
+		}
+		if (Resumed < Size)
+		{
+			// Unreadable tail: start over rather than resume from a hash we cannot trust
+			Resumed = 0;
+		}
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [This = AsShared(), Resumed]()
+	{
+		This->Offset = Resumed;
+		This->RequestNextRange();
+	});
+}
+
+void FHazeBlobDownload::RequestNextRange()
+{
+	TMap<FString, FString> Headers;
+	Headers.Add(TEXT("Range"), FString::Printf(TEXT("bytes=%lld-%lld"), Offset, Offset + ChunkSize - 1));
+	// The node's ETag is the blob hash; if it ever serves other bytes we get the whole blob (200) instead
+	Headers.Add(TEXT("If-Range"), FString::Printf(TEXT("\"%s\""), *BlobHash));
+	// Offsets and lengths are checked against the stored blob, so its bytes must arrive as stored
+	Headers.Add(TEXT("Accept-Encoding"), TEXT("identity"));
+	Transport(Headers, [This = AsShared()](FHazeBlobResponse&& Response)
+	{
+		This->HandleResponse(MoveTemp(Response));
+	});
+}
+
+void FHazeBlobDownload::HandleResponse(FHazeBlobResponse&& Response)
+{
+	const int32 Code = Response.Code;
+	switch (Code)
+	{
+	case 206:
+	{
+		int64 Start = 0, End = 0, RangeTotal = 0;
+		if (!ParseContentRange(Response.ContentRange, Start, End, RangeTotal) || Start != Offset
+			|| Response.GetContent().Num() != End - Start + 1)
+		{
+			Restart(TEXT("unexpected Content-Range"));
+			return;
+		}
+		Total = RangeTotal;
+		WriteChunk(MoveTemp(Response), Offset == 0);
+		return;
+	}
+	case 200:
+		// Range not honoured (or If-Range mismatch): the body is the whole blob
+		Total = Response.GetContent().Num();
+		WriteChunk(MoveTemp(Response), true);
+		return;
+	case 416:
+	{
+		int64 Start = 0, End = 0, RangeTotal = 0;
+		if (ParseContentRange(Response.ContentRange, Start, End, RangeTotal) && RangeTotal == Offset)
+		{
+			// Everything was already on disk
+			Total = RangeTotal;
+			Verify();
+		}
+		else
+		{
+			Restart(TEXT("range not satisfiable"));
+		}
+		return;
+	}
+	case 0:
+	case 408:
+	case 429:
+		RetryLater(Code == 0 ? TEXT("no response") : FString::Printf(TEXT("HTTP %d"), Code));
+		return;
+	default:
+		if (Code >= 500)
+		{
+			RetryLater(FString::Printf(TEXT("HTTP %d"), Code));
+		}
+		else
+		{
+			Finish(false, Code == 404 ? FString(TEXT("blob not found")) : FString::Printf(TEXT("HTTP %d"), Code));
+		}
+		return;
+	}
+}
+
+void FHazeBlobDownload::WriteChunk(FHazeBlobResponse&& Response, bool bTruncate)
+{
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [This = AsShared(), Response = MoveTemp(Response), bTruncate]()
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		PlatformFile.CreateDirectoryTree(*FPaths::GetPath(This->PartPath));
+		if (bTruncate)
+		{
+			This->Hasher.Reset();
+		}
+
+		const TArray<uint8>& Content = Response.GetContent();
+		TUniquePtr<IFileHandle> File(PlatformFile.OpenWrite(*This->PartPath, !bTruncate));
+		const bool bWritten = File && File->Write(Content.GetData(), Content.Num()) && File->Flush();
+		File.Reset();
+		if (bWritten)
+		{
+			This->Hasher.Update(Content.GetData(), Content.Num());
+		}
+		else
+		{
+			// A short write leaves the file and the hash out of step; resuming from it is not possible
+			PlatformFile.DeleteFile(*This->PartPath);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [This, bWritten, Written = static_cast<int64>(Content.Num()), bTruncate]()
+		{
+			This->OnChunkWritten(bWritten, Written, bTruncate);
+		});
+	});
+}
+
+void FHazeBlobDownload::OnChunkWritten(bool bWritten, int64 BytesWritten, bool bTruncate)
+{
+	if (!bWritten)
+	{
+		Offset = 0;
+		Finish(false, FString::Printf(TEXT("cannot write %s"), *PartPath));
+		return;
+	}
+
+	Offset = (bTruncate ? 0 : Offset) + BytesWritten;
+	Failures = 0;
+	for (const FWaiter& Waiter : Waiters)
+	{
+		if (Waiter.OnProgress) Waiter.OnProgress(Offset, Total);
+	}
+
+	if (Total >= 0 && Offset >= Total)
+	{
+		Verify();
+	}
+	else if (BytesWritten == 0)
+	{
+		RetryLater(TEXT("empty range"));
+	}
+	else
+	{
+		RequestNextRange();
+	}
+}
+
+void FHazeBlobDownload::RetryLater(const FString& Error)
+{
+	if (++Failures >= MaxAttempts)
+	{
+		Finish(false, Error);
+		return;
+	}
+	const float Delay = FMath::FRandRange(0.f, FMath::Min(10.f, 0.5f * FMath::Pow(2.f, static_cast<float>(Failures - 1))));
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([This = AsShared()](float)
+	{
+		This->RequestNextRange();
+		return false;
+	}), Delay);
+}
+
+void FHazeBlobDownload::Restart(const FString& Reason)
+{
+	if (++Failures >= MaxAttempts)
+	{
+		Finish(false, Reason);
+		return;
+	}
+	// The next write truncates the partial file and resets the hasher
+	Offset = 0;
+	Total = -1;
+	RequestNextRange();
+}
+
+void FHazeBlobDownload::Verify()
+{
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [This = AsShared()]()
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const FString Digest = This->Hasher.FinalHex();
+		This->Hasher.Reset();
+
+		FString Error;
+		if (Digest != This->BlobHash)
+		{
+			PlatformFile.DeleteFile(*This->PartPath);
+			Error = FString::Printf(TEXT("hash mismatch (got %s)"), *Digest);
+		}
+		else if (!PlatformFile.FileExists(*This->PartPath))
+		{
+			// Empty blob: the node never sent a byte, so there is no partial file to rename
+			PlatformFile.CreateDirectoryTree(*FPaths::GetPath(This->FinalPath));
+			if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>(), *This->FinalPath))
+			{
+				Error = FString::Printf(TEXT("cannot write %s"), *This->FinalPath);
+			}
+		}
+		else if (PlatformFile.FileExists(*This->FinalPath))
+		{
+			// Another process finished the same blob first
+			PlatformFile.DeleteFile(*This->PartPath);
+		}
+		else if (!PlatformFile.MoveFile(*This->FinalPath, *This->PartPath))
+		{
+			Error = FString::Printf(TEXT("cannot move %s into the cache"), *This->PartPath);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [This, Error]()
+		{
+			This->Finish(Error.IsEmpty(), Error);
+		});
+	});
+}
+
+void FHazeBlobDownload::Finish(bool bOk, const FString& Error, bool bFromCache)
+{
+	FHazeBlobDownloadResult Result;
+	Result.BlobHash = BlobHash;
+	Result.FilePath = bOk ? FinalPath : FString();
+	Result.Size = bOk ? Offset : 0;
+	Result.bFromCache = bFromCache;
+	Result.Error = Error;
+
+	TArray<FWaiter> Done = MoveTemp(Waiters);
+	Waiters.Reset();
+	// Before the waiters: one of them may ask the owner for this blob again
+	TFunction<void()> Finished = MoveTemp(OnFinished);
+	OnFinished = nullptr;
+	if (Finished)
+	{
+		Finished();
+	}
+	for (const FWaiter& Waiter : Done)
+	{
+		Waiter.OnComplete(bOk, Result);
+	}
+}
+
+bool FHazeBlobDownload::ParseContentRange(const FString& Value, int64& OutStart, int64& OutEnd, int64& OutTotal)
+{
+	FString Unit, Spec, Range, TotalText;
+	if (!Value.TrimStartAndEnd().Split(TEXT(" "), &Unit, &Spec) || Unit != TEXT("bytes")) return false;
+	if (!Spec.Split(TEXT("/"), &Range, &TotalText) || TotalText.IsEmpty() || !TotalText.IsNumeric()) return false;
+	OutTotal = FCString::Atoi64(*TotalText);
+
+	if (Range == TEXT("*"))
+	{
+		OutStart = OutEnd = -1;
+		return true;
+	}
+	FString StartText, EndText;
+	if (!Range.Split(TEXT("-"), &StartText, &EndText) || !StartText.IsNumeric() || !EndText.IsNumeric()) return false;
+	OutStart = FCString::Atoi64(*StartText);
+	OutEnd = FCString::Atoi64(*EndText);
+	return OutStart <= OutEnd && OutEnd < OutTotal;
+}
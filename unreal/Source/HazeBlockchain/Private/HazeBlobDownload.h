@@ -0,0 +1,94 @@
+// Copyright HAZE Blockchain. Ranged, resumable blob download into FHazeBlobCache.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeClient.h"
+#include "HazeSha256.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/** What a blob transport got back for one ranged GET */
+struct FHazeBlobResponse
+{
+	/** HTTP status; 0 if no response arrived */
+	int32 Code = 0;
+	/** Content-Range header, if any */
+	FString ContentRange;
+	/** The HTTP response the body lives in; transports without one fill Body instead */
+	FHttpResponsePtr Http;
+	TArray<uint8> Body;
+
+	const TArray<uint8>& GetContent() const { return Http.IsValid() ? Http->GetContent() : Body; }
+};
+
+/**
+ * Sends GET with Headers (Range, If-Range, Accept-Encoding) for the blob and calls OnResponse on the game thread,
+ * never from inside the call.
+ */
+using FHazeBlobTransport = TFunction<void(const TMap<FString, FString>& Headers, TFunction<void(FHazeBlobResponse&& Response)> OnResponse)>;
+
+/**
+ * Downloads one blob as a sequence of Range requests of ChunkSize bytes. Each chunk is appended to <hash>.part and
+ * fed to a running SHA-256 on a background task, so memory stays bounded by one chunk. The file is renamed to its
+ * final name only if the digest matches; an interrupted download resumes from the partial file (re-hashing it once).
+ * Requests carry If-Range with the hash, so a node serving different bytes answers 200 and the download restarts.
+ *
+ * Driven from the game thread; the hasher and the partial file are only touched by the background task of the
+ * current step, and steps never overlap.
+ */
+class FHazeBlobDownload : public TSharedFromThis<FHazeBlobDownload, ESPMode::ThreadSafe>
+{
+public:
+	/** BlobHash must be normalized (FHazeBlobCache::NormalizeHash); Transport sends each range request. */
+	FHazeBlobDownload(FString InBlobHash, int32 InChunkSize, FHazeBlobTransport InTransport);
+
+	/** Add a caller. Callers added before completion share this download. */
+	void AddWaiter(FHazeOnBlobDownload OnComplete, FHazeOnBlobProgress OnProgress);
+
+	/**
+	 * Start (once). OnFinished runs on the game thread just before the waiters are called, so the owner can forget the
+	 * download first: a waiter asking for the same blob again then starts a new one instead of joining this one.
+	 */
+	void Start(TFunction<void()> InOnFinished);
+
+	/** Consecutive failed requests before giving up (the partial file is kept for a later resume) */
+	static constexpr int32 MaxAttempts = 5;
+
+	/** Content-Range "bytes Start-End/Total", or the 416 form with "*" for the range (Start and End -1) */
+	static bool ParseContentRange(const FString& Value, int64& OutStart, int64& OutEnd, int64& OutTotal);
+
+private:
+	struct FWaiter
+	{
+		FHazeOnBlobDownload OnComplete;
+		FHazeOnBlobProgress OnProgress;
+	};
+
+	void ResumeFromDisk();
+	void RequestNextRange();
+	void HandleResponse(FHazeBlobResponse&& Response);
+	/** Append the response body to the partial file, or replace it when bTruncate */
+	void WriteChunk(FHazeBlobResponse&& Response, bool bTruncate);
+	void OnChunkWritten(bool bWritten, int64 BytesWritten, bool bTruncate);
+	void RetryLater(const FString& Error);
+	/** Drop what we have and start again from byte 0 (counts as a failed attempt) */
+	void Restart(const FString& Reason);
+	void Verify();
+	void Finish(bool bOk, const FString& Error, bool bFromCache = false);
+
+	FString BlobHash;
+	FString PartPath;
+	FString FinalPath;
+	int32 ChunkSize;
+	FHazeBlobTransport Transport;
+
+	FHazeSha256 Hasher;
+	int64 Offset = 0;
+	int64 Total = -1;
+	int32 Failures = 0;
+	bool bStarted = false;
+
+	TArray<FWaiter> Waiters;
+	TFunction<void()> OnFinished;
+};
@@ -4,6 +4,8 @@
 #include "Misc/Paths.h"
 #include "HAL/PlatformProcess.h"
 
+DEFINE_LOG_CATEGORY(LogHaze);
+
 #define LOCTEXT_NAMESPACE "FHazeBlockchainModule"
 
 void FHazeBlockchainModule::StartupModule()
@@ -26,9 +26,8 @@ FString UHazeBlueprintLibrary::BuildSignedMistbornCreate(
 	int64 Nonce)
 {
 	if (!KeyPair || Fee < 0 || Nonce < 0) return FString();
-	TArray<FString> Attrs;
 	return FTransactionBuilder::BuildSignedMistbornCreate(
-		KeyPair, AssetIdHex, Density, Metadata, Attrs, GameId, static_cast<uint64>(Fee), static_cast<uint64>(Nonce));
+		KeyPair, AssetIdHex, Density, Metadata, GameId, static_cast<uint64>(Fee), static_cast<uint64>(Nonce));
 }
 
 bool UHazeBlueprintLibrary::IsSigningAvailable()
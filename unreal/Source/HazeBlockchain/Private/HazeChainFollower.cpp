@@ -0,0 +1,331 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeChainFollower.h"
+#include "HazeEventStream.h"
+
+UHazeChainFollower* UHazeChainFollower::CreateChainFollower(UHazeClient* InClient)
+{
+	UHazeChainFollower* Follower = NewObject<UHazeChainFollower>();
+	Follower->Client = InClient;
+	return Follower;
+}
+
+void UHazeChainFollower::BeginDestroy()
+{
+	Stop();
+	Super::BeginDestroy();
+}
+
+void UHazeChainFollower::Start()
+{
+	if (IsRunning()) return;
+	PollHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis = TWeakObjectPtr<UHazeChainFollower>(this)](float)
+	{
+		UHazeChainFollower* This = WeakThis.Get();
+		if (!This) return false;
+		This->Poll();
+		return true;
+	}), FMath::Max(0.1f, PollIntervalSeconds));
+	Poll();
+}
+
+void UHazeChainFollower::Stop()
+{
+	if (PollHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PollHandle);
+		PollHandle.Reset();
+	}
+}
+
+void UHazeChainFollower::BindEventStream(UHazeEventStream* Stream)
+{
+	if (Stream)
+	{
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = EHazeStreamEventType::BlockApplied;
+		Stream->Subscribe(Subscription);
+		Stream->OnEventNative().AddUObject(this, &UHazeChainFollower::HandleStreamEvent);
+	}
+}
+
+void UHazeChainFollower::HandleStreamEvent(const FHazeStreamEvent& Event)
+{
+	if (Event.Type != EHazeStreamEventType::BlockApplied || Event.BlockHash.IsEmpty()) return;
+	FHazeBlockInfo Block;
+	Block.Hash = Event.BlockHash;
+	Block.Height = Event.Height;
+	Block.Transactions = Event.Transactions;
+	TargetHeight = FMath::Max(TargetHeight, Event.Height);
+	if (!ApplyBlock(Block))
+	{
+		// Missed events (reconnect, lag): fetch the gap
+		FetchMissing();
+	}
+}
+
+void UHazeChainFollower::Poll()
+{
+	if (!Client || bPollInFlight) return;
+	bPollInFlight = true;
+	Client->FetchBlockchainInfo([WeakThis = TWeakObjectPtr<UHazeChainFollower>(this)](bool bOk, const FBlockchainInfo& Info)
+	{
+		UHazeChainFollower* This = WeakThis.Get();
+		if (!This) return;
+		This->bPollInFlight = false;
+		if (!bOk) return;
+		if (!This->bPositioned)
+		{
+			const int64 Backfill = FMath::Clamp<int64>(This->BackfillBlocks, 0, FMath::Max(1, This->RecentBlocks));
+			This->Position(FMath::Max<int64>(-1, Info.CurrentHeight - Backfill));
+		}
+		This->TargetHeight = FMath::Max(This->TargetHeight, Info.CurrentHeight);
+		This->ApplyFinalizedHeight(Info.LastFinalizedHeight);
+		This->FetchMissing();
+	});
+}
+
+void UHazeChainFollower::FetchMissing()
+{
+	if (!Client || !bPositioned || bFetchInFlight || HeadHeight >= TargetHeight) return;
+	bFetchInFlight = true;
+	const int64 Height = HeadHeight + 1;
+	Client->FetchBlockByHeight(Height, [WeakThis = TWeakObjectPtr<UHazeChainFollower>(this), Height](bool bOk, const FHazeBlockInfo& Block)
+	{
+		UHazeChainFollower* This = WeakThis.Get();
+		if (!This) return;
+		This->bFetchInFlight = false;
+		if (!bOk) return;
+		// An event may have delivered the block meanwhile; keep going either way. Stop on a block that does not fit
+		// (node behind, or a finalized block disagreeing) until the next poll.
+		if (This->ApplyBlock(Block) || This->HeadHeight >= Height)
+		{
+			This->FetchMissing();
+		}
+	});
+}
+
+void UHazeChainFollower::Position(int64 Height)
+{
+	Ring.Reset();
+	Ring.SetNum(FMath::Max(1, RecentBlocks));
+	HeadHeight = Height;
+	TailHeight = Height + 1;
+	bPositioned = true;
+}
+
+const FHazeBlockInfo* UHazeChainFollower::FindBlock(int64 Height) const
+{
+	return bPositioned && Height >= TailHeight && Height <= HeadHeight ? &Ring[Height % Ring.Num()] : nullptr;
+}
+
+bool UHazeChainFollower::ApplyBlock(const FHazeBlockInfo& Block)
+{
+	if (Block.Hash.IsEmpty() || Block.Height < 0) return false;
+	if (!bPositioned)
+	{
+		Position(Block.Height - 1);
+	}
+	if (Block.Height > HeadHeight + 1) return false;
+
+	if (Block.Height <= HeadHeight)
+	{
+		const FHazeBlockInfo* Held = FindBlock(Block.Height);
+		if (!Held || Held->Hash == Block.Hash || Block.Height <= FinalizedHeight) return false;
+		RollBack(Block.Height);
+	}
+	else if (const FHazeBlockInfo* Parent = FindBlock(Block.Height - 1))
+	{
+		// Events carry no parent hash; fetched blocks do
+		if (!Block.ParentHash.IsEmpty() && Parent->Hash != Block.ParentHash)
+		{
+			if (Parent->Height <= FinalizedHeight) return false;
+			RollBack(Parent->Height);
+			return true;
+		}
+	}
+	Append(Block);
+	return true;
+}
+
+void UHazeChainFollower::Append(const FHazeBlockInfo& Block)
+{
+	if (HeadHeight - TailHeight + 1 == Ring.Num())
+	{
+		FHazeBlockInfo& Oldest = Ring[TailHeight % Ring.Num()];
+		for (const FString& TxHash : Oldest.Transactions)
+		{
+			TxHeights.Remove(TxHash);
+		}
+		Oldest = FHazeBlockInfo();
+		TailHeight++;
+	}
+	HeadHeight = Block.Height;
+	TargetHeight = FMath::Max(TargetHeight, HeadHeight);
+	FHazeBlockInfo& Slot = Ring[HeadHeight % Ring.Num()];
+	Slot = Block;
+	for (const FString& TxHash : Slot.Transactions)
+	{
+		TxHeights.Add(TxHash, Slot.Height);
+		if (Tracked.Contains(TxHash))
+		{
+			Confirm(TxHash, Slot);
+		}
+	}
+	OnBlock.Broadcast(Slot);
+}
+
+void UHazeChainFollower::RollBack(int64 Height)
+{
+	const int64 From = FMath::Max(Height, TailHeight);
+	for (int64 At = HeadHeight; At >= From; At--)
+	{
+		FHazeBlockInfo& Block = Ring[At % Ring.Num()];
+		for (const FString& TxHash : Block.Transactions)
+		{
+			TxHeights.Remove(TxHash);
+		}
+		Block = FHazeBlockInfo();
+
+		TArray<FString> Reverted;
+		if (ConfirmedAt.RemoveAndCopyValue(At, Reverted))
+		{
+			for (const FString& TxHash : Reverted)
+			{
+				FTracked* Entry = Tracked.Find(TxHash);
+				if (!Entry) continue;
+				Entry->Receipt.Status = EHazeReceiptStatus::Pending;
+				Entry->Receipt.BlockHeight = -1;
+				Entry->Receipt.BlockHash.Reset();
+				const FHazeReceipt Receipt = Entry->Receipt;
+				const TArray<TPair<uint64, FHazeOnReceipt>> Listeners = Entry->Listeners;
+				Notify(Receipt, Listeners, OnTransactionReverted);
+			}
+		}
+	}
+	HeadHeight = From - 1;
+}
+
+void UHazeChainFollower::ApplyFinalizedHeight(int64 Height)
+{
+	if (Height <= FinalizedHeight) return;
+	FinalizedHeight = Height;
+
+	TArray<int64> Heights;
+	for (const TPair<int64, TArray<FString>>& Pair : ConfirmedAt)
+	{
+		if (Pair.Key <= Height) Heights.Add(Pair.Key);
+	}
+	Heights.Sort();
+	for (const int64 At : Heights)
+	{
+		TArray<FString> Hashes;
+		if (ConfirmedAt.RemoveAndCopyValue(At, Hashes))
+		{
+			for (const FString& TxHash : Hashes)
+			{
+				Finalize(TxHash);
+			}
+		}
+	}
+}
+
+void UHazeChainFollower::Confirm(const FString& TxHash, const FHazeBlockInfo& Block)
+{
+	FTracked& Entry = Tracked[TxHash];
+	Entry.Receipt.Status = EHazeReceiptStatus::Confirmed;
+	Entry.Receipt.BlockHeight = Block.Height;
+	Entry.Receipt.BlockHash = Block.Hash;
+	ConfirmedAt.FindOrAdd(Block.Height).Add(TxHash);
+	// Copies: the callback may untrack (or track) transactions
+	const FHazeReceipt Receipt = Entry.Receipt;
+	const TArray<TPair<uint64, FHazeOnReceipt>> Listeners = Entry.Listeners;
+	Notify(Receipt, Listeners, OnTransactionConfirmed);
+	if (Block.Height <= FinalizedHeight)
+	{
+		Finalize(TxHash);
+	}
+}
+
+void UHazeChainFollower::Finalize(const FString& TxHash)
+{
+	FTracked Entry;
+	if (!Tracked.RemoveAndCopyValue(TxHash, Entry)) return;
+	if (TArray<FString>* AtHeight = ConfirmedAt.Find(Entry.Receipt.BlockHeight))
+	{
+		AtHeight->RemoveSingleSwap(TxHash);
+		if (AtHeight->Num() == 0) ConfirmedAt.Remove(Entry.Receipt.BlockHeight);
+	}
+	Entry.Receipt.Status = EHazeReceiptStatus::Finalized;
+	Notify(Entry.Receipt, Entry.Listeners, OnTransactionFinalized);
+}
+
+void UHazeChainFollower::Notify(const FHazeReceipt& Receipt, const TArray<TPair<uint64, FHazeOnReceipt>>& Listeners, FHazeReceiptDelegate& Delegate)
+{
+	for (const TPair<uint64, FHazeOnReceipt>& Listener : Listeners)
+	{
+		Listener.Value(Receipt);
+	}
+	Delegate.Broadcast(Receipt);
+}
+
+void UHazeChainFollower::TrackTransaction(const FString& TxHash)
+{
+	TrackTransactionNative(TxHash, nullptr);
+}
+
+uint64 UHazeChainFollower::TrackTransactionNative(const FString& TxHash, FHazeOnReceipt OnUpdate)
+{
+	// The node prints hashes in lower case
+	const FString Hash = TxHash.ToLower();
+	if (Hash.IsEmpty()) return 0;
+	FTracked& Entry = Tracked.FindOrAdd(Hash);
+	Entry.Receipt.TxHash = Hash;
+	uint64 Handle = 0;
+	if (OnUpdate)
+	{
+		Handle = NextListener++;
+		Entry.Listeners.Emplace(Handle, MoveTemp(OnUpdate));
+	}
+	else
+	{
+		Entry.bTrackedPlain = true;
+	}
+	if (Entry.Receipt.Status != EHazeReceiptStatus::Pending) return Handle;
+	if (const int64* Height = TxHeights.Find(Hash))
+	{
+		Confirm(Hash, *FindBlock(*Height));
+	}
+	return Handle;
+}
+
+void UHazeChainFollower::RemoveReceiptListener(const FString& TxHash, uint64 Handle)
+{
+	FTracked* Entry = Tracked.Find(TxHash.ToLower());
+	if (!Entry || Entry->Listeners.RemoveAll([Handle](const TPair<uint64, FHazeOnReceipt>& Listener) { return Listener.Key == Handle; }) == 0) return;
+	if (Entry->Listeners.Num() == 0 && !Entry->bTrackedPlain)
+	{
+		UntrackTransaction(TxHash);
+	}
+}
+
+void UHazeChainFollower::UntrackTransaction(const FString& TxHash)
+{
+	FTracked Entry;
+	if (!Tracked.RemoveAndCopyValue(TxHash.ToLower(), Entry)) return;
+	if (TArray<FString>* AtHeight = ConfirmedAt.Find(Entry.Receipt.BlockHeight))
+	{
+		AtHeight->RemoveSingleSwap(Entry.Receipt.TxHash);
+		if (AtHeight->Num() == 0) ConfirmedAt.Remove(Entry.Receipt.BlockHeight);
+	}
+}
+
+bool UHazeChainFollower::GetReceipt(const FString& TxHash, FHazeReceipt& OutReceipt) const
+{
+	if (const FTracked* Entry = Tracked.Find(TxHash.ToLower()))
+	{
+		OutReceipt = Entry->Receipt;
+		return true;
+	}
+	return false;
+}
@@ -3,9 +3,230 @@
 #include "HazeClient.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Async/Async.h"
+#include "Misc/Compression.h"
+#include "HazeResponseParser.h"
+#include "HazeEventStream.h"
+#include "HazeAssetCursor.h"
+#include "HazeAssetPage.h"
+#include "HazeAssetVersions.h"
+#include "HazeAssetSnapshot.h"
+#include "HazeBlobCache.h"
+#include "HazeBlobDownload.h"
+#include "HazeBincode.h"
+#include "HazeJsonWriter.h"
+#include "HazeHex.h"
+#include "HazeStats.h"
+#include "TransactionBuilder.h"
+
+namespace
+{
+	/** GetHealthBlocking blocks its caller at most this long (plus a second for the HTTP stack to report the timeout) */
+	constexpr float HealthBlockingTimeoutSeconds = 10.f;
+
+	/** Largest body inflated from a gzip response; anything claiming more is treated as a failed response */
+	constexpr int32 MaxInflatedBodyBytes = 256 * 1024 * 1024;
+
+	/**
+	 * The response body, inflated if the node sent it gzip-encoded. Platform HTTP stacks that already inflate
+	 * (libcurl keeps the Content-Encoding header) are detected by the missing gzip magic. Empty on a corrupt body.
+	 */
+	TArrayView<const uint8> ResponseBody(const FHttpResponsePtr& Res, TArray<uint8>& Inflated)
+	{
+		const TArray<uint8>& Content = Res->GetContent();
+		const bool bGzipMagic = Content.Num() >= 18 && Content[0] == 0x1f && Content[1] == 0x8b;
+		if (!bGzipMagic || !Res->GetHeader(TEXT("Content-Encoding")).Contains(TEXT("gzip")))
+		{
+			return Content;
+		}
+
+		// ISIZE trailer: uncompressed length mod 2^32 (responses are far below 4GB)
+		const uint8* Trailer = Content.GetData() + Content.Num() - 4;
+		const uint32 Size = Trailer[0] | (Trailer[1] << 8) | (Trailer[2] << 16) | (static_cast<uint32>(Trailer[3]) << 24);
+		if (Size > static_cast<uint32>(MaxInflatedBodyBytes)) return TArrayView<const uint8>();
+		Inflated.SetNumUninitialized(Size);
+		if (!FCompression::UncompressMemory(NAME_Gzip, Inflated.GetData(), Size, Content.GetData(), Content.Num()))
+		{
+			return TArrayView<const uint8>();
+		}
+		return Inflated;
+	}
+
+	/**
+	 * Decode the response on a background task and marshal only the typed result back to the game thread.
+	 * Parse(Body, Result) -> bool runs off-thread; Deliver(bOk, Result, ResponseCode) runs on the game thread.
+	 * Trace gets the completed, parsed and delivered stages.
+	 */
+	template <typename ResultType, typename ParseFn, typename DeliverFn>
+	void DecodeOffGameThread(FHazeRequestTrace Trace, FHttpResponsePtr Res, bool bOk, bool bRequire200, ParseFn&& Parse, DeliverFn&& Deliver)
+	{
+		Trace.MarkCompleted(Res.IsValid() ? Res->GetContentLength() : 0);
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+			[Trace, Res, bOk, bRequire200, Parse = Forward<ParseFn>(Parse), Deliver = Forward<DeliverFn>(Deliver)]() mutable
+		{
+			ResultType Result{};
+			const int32 Code = bOk && Res.IsValid() ? Res->GetResponseCode() : 0;
+			bool bParsed = false;
+			if (Code != 0 && (!bRequire200 || Code == 200))
+			{
+				TArray<uint8> Inflated;
+				TArrayView<const uint8> Body;
+				{
+					HAZE_SCOPE(STAT_HazeInflate, HazeInflate);
+					Body = ResponseBody(Res, Inflated);
+				}
+				HAZE_SCOPE(STAT_HazeParse, HazeParse);
+				bParsed = Parse(Body, Result);
+			}
+			Trace.MarkParsed();
+			AsyncTask(ENamedThreads::GameThread, [Trace, bParsed, Code, Result = MoveTemp(Result), Deliver = MoveTemp(Deliver)]() mutable
+			{
+				Trace.Finish(bParsed);
+				HAZE_SCOPE(STAT_HazeDeliver, HazeDeliver);
+				Deliver(bParsed, Result, Code);
+			});
+		});
+	}
+
+	bool IsSubmission(EHazeEndpoint Endpoint)
+	{
+		return Endpoint == EHazeEndpoint::SubmitTransaction || Endpoint == EHazeEndpoint::SubmitTransactionBatch;
+	}
+
+	/** Request (verb, path, headers, body, header delegate) again, on NewBaseUrl instead of OldBaseUrl */
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> RetargetRequest(IHttpRequest& Request, const FString& OldBaseUrl, const FString& NewBaseUrl, float Timeout)
+	{
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Retry = FHttpModule::Get().CreateRequest();
+		Retry->SetURL(NewBaseUrl + Request.GetURL().Mid(OldBaseUrl.Len()));
+		Retry->SetVerb(Request.GetVerb());
+		for (const FString& Header : Request.GetAllHeaders())
+		{
+			FString Name, Value;
+			if (Header.Split(TEXT(": "), &Name, &Value))
+			{
+				Retry->SetHeader(Name, Value);
+			}
+		}
+		Retry->SetContent(Request.GetContent());
+		Retry->SetTimeout(Timeout);
+		Retry->OnHeaderReceived() = Request.OnHeaderReceived();
+		return Retry;
+	}
+
+	/**
+	 * Count Request against its node and, when it fails in a way that is safe to repeat, resend it to the best node
+	 * not tried yet. The original completion runs once, with the last attempt's result. Reads are repeated after
+	 * transport failures and 502/503/504; submissions only when the connection itself failed, since a timed-out
+	 * submission may have reached the node, and repeating it would report a duplicate instead of the real outcome.
+	 * A repeated submission moves its Sender to the new node.
+	 */
+	void RouteRequest(const TSharedRef<FHazeNodeRouter, ESPMode::ThreadSafe>& Router, const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+		bool bSubmission, const FString& Sender, float FailoverTimeout, float FinalTimeout, uint64 Tried)
+	{
+		const int32 Node = Router->FindNode(Request->GetURL());
+		if (Node == INDEX_NONE) return;
+		Router->MarkStarted(Node);
+		Tried |= 1ull << Node;
+
+		FHttpRequestCompleteDelegate Complete = Request->OnProcessRequestComplete();
+		Request->OnProcessRequestComplete().BindLambda([WeakRouter = TWeakPtr<FHazeNodeRouter, ESPMode::ThreadSafe>(Router), NodeUrl = Router->GetUrl(Node),
+			Complete = MoveTemp(Complete), bSubmission, Sender, FailoverTimeout, FinalTimeout, Tried](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
+		{
+			const int32 Code = bOk && Res.IsValid() ? Res->GetResponseCode() : 0;
+			const TSharedPtr<FHazeNodeRouter, ESPMode::ThreadSafe> Router = WeakRouter.Pin();
+			// The node list may have changed while the request was out
+			const int32 Node = Router.IsValid() ? Router->FindNode(NodeUrl) : INDEX_NONE;
+			if (Node != INDEX_NONE && Req.IsValid())
+			{
+				Router->MarkFinished(Node, Code != 0 && Code < 500);
+				const bool bRetry = bSubmission ? Req->GetStatus() == EHttpRequestStatus::Failed_ConnectionError
+					: Code == 0 || Code == 502 || Code == 503 || Code == 504;
+				const int32 Next = bRetry ? (bSubmission ? Router->PickSubmitFor(Sender, Tried) : Router->PickRead(Tried)) : INDEX_NONE;
+				if (Next != INDEX_NONE)
+				{
+					const bool bMoreLeft = Router->PickRead(Tried | (1ull << Next)) != INDEX_NONE;
+					TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Retry = RetargetRequest(*Req, NodeUrl, Router->GetUrl(Next),
+						!bSubmission && bMoreLeft ? FailoverTimeout : FinalTimeout);
+					Retry->OnProcessRequestComplete() = Complete;
+					RouteRequest(Router.ToSharedRef(), Retry, bSubmission, Sender, FailoverTimeout, FinalTimeout, Tried);
+					Retry->ProcessRequest();
+					return;
+				}
+			}
+			Complete.ExecuteIfBound(Req, Res, bOk);
+		});
+	}
+
+	/** Cache key for per-address entries */
+	FString AddressKey(const FString& AddressHex)
+	{
+		return AddressHex.TrimStartAndEnd().ToLower();
+	}
+
+	const TCHAR* DensityName(EDensityLevel Density)
+	{
+		switch (Density)
+		{
+		case EDensityLevel::Light: return TEXT("Light");
+		case EDensityLevel::Dense: return TEXT("Dense");
+		case EDensityLevel::Core: return TEXT("Core");
+		default: return TEXT("Ethereal");
+		}
+	}
+
+	/** Query string for GET /api/v1/assets/search (summary view) */
+	FString AssetSearchPath(const FHazeAssetSearchQuery& Query, int64 Offset)
+	{
+		static const TCHAR* const SortNames[] = { TEXT("created_at"), TEXT("updated_at"), TEXT("rarity") };
+		FString Path = FString::Printf(TEXT("/api/v1/assets/search?view=summary&limit=%d&offset=%lld&sort_by=%s&sort_order=%s"),
+			FMath::Clamp(Query.PageSize, 1, UHazeClient::MaxAssetSearchPage), Offset,
+			SortNames[FMath::Min<int32>(static_cast<int32>(Query.SortBy), UE_ARRAY_COUNT(SortNames) - 1)],
+			Query.bAscending ? TEXT("asc") : TEXT("desc"));
+		if (!Query.Owner.IsEmpty()) Path += TEXT("&owner=") + FGenericPlatformHttp::UrlEncode(Query.Owner.TrimStartAndEnd());
+		if (!Query.GameId.IsEmpty()) Path += TEXT("&game_id=") + FGenericPlatformHttp::UrlEncode(Query.GameId);
+		if (Query.bFilterDensity) Path += FString(TEXT("&density=")) + DensityName(Query.Density);
+		if (!Query.Text.IsEmpty()) Path += TEXT("&q=") + FGenericPlatformHttp::UrlEncode(Query.Text);
+		return Path;
+	}
+
+	/** "from" of a transaction body built by FTransactionBuilder ({"Variant":{"from":"<hex>",...}}), or empty */
+	FString FindSender(const FString& TransactionJson)
+	{
+		static const FStringView Marker = TEXTVIEW("\"from\":\"");
+		const int32 Start = TransactionJson.Find(Marker.GetData(), ESearchCase::CaseSensitive);
+		if (Start == INDEX_NONE) return FString();
+		const int32 ValueStart = Start + Marker.Len();
+		const int32 ValueEnd = TransactionJson.Find(TEXT("\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, ValueStart);
+		return ValueEnd == INDEX_NONE ? FString() : TransactionJson.Mid(ValueStart, ValueEnd - ValueStart);
+	}
+
+	/** FindSender over a UTF-8 request body */
+	FString FindSender(TArrayView<const uint8> Body)
+	{
+		static const char Marker[] = "\"from\":\"";
+		constexpr int32 MarkerLen = UE_ARRAY_COUNT(Marker) - 1;
+		for (int32 i = 0; i + MarkerLen <= Body.Num(); i++)
+		{
+			if (FMemory::Memcmp(Body.GetData() + i, Marker, MarkerLen) != 0) continue;
+			const int32 ValueStart = i + MarkerLen;
+			int32 ValueEnd = ValueStart;
+			while (ValueEnd < Body.Num() && Body[ValueEnd] != '"') ValueEnd++;
+			if (ValueEnd == Body.Num()) return FString();
+			return FString(ValueEnd - ValueStart, reinterpret_cast<const ANSICHAR*>(Body.GetData() + ValueStart));
+		}
+		return FString();
+	}
+
+	/** Content type of the node's bincode encoding (BINCODE_CONTENT_TYPE in src/api.rs) */
+	const TCHAR* const BincodeContentType = TEXT("application/x-haze-bincode");
+
+	/** Sender of a bincode transaction: every variant starts with its u32 index and then `from` */
+	FString FindBinarySender(const TArray<uint8>& Transaction)
+	{
+		return Transaction.Num() >= 4 + 32 ? FHazeHex::ToHex(MakeArrayView(Transaction.GetData() + 4, 32)) : FString();
+	}
+}
 
 UHazeClient::UHazeClient()
 {
@@ -18,6 +239,170 @@ UHazeClient* UHazeClient::CreateClient(const FString& InBaseUrl)
 	return Client;
 }
 
+UHazeClient* UHazeClient::CreateMultiNodeClient(const TArray<FString>& InNodeUrls)
+{
+	UHazeClient* Client = NewObject<UHazeClient>();
+	Client->NodeUrls = InNodeUrls;
+	if (InNodeUrls.Num() > 0)
+	{
+		Client->BaseUrl = InNodeUrls[0];
+	}
+	Client->SyncNodes();
+	return Client;
+}
+
+void UHazeClient::PostInitProperties()
+{
+	Super::PostInitProperties();
+	ApplyRequestBudgets();
+}
+
+void UHazeClient::PostLoad()
+{
+	Super::PostLoad();
+	ApplyRequestBudgets();
+}
+
+#if WITH_EDITOR
+void UHazeClient::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	const FName Name = PropertyChangedEvent.GetPropertyName();
+	if (Name == GET_MEMBER_NAME_CHECKED(UHazeClient, MaxCriticalRequests) || Name == GET_MEMBER_NAME_CHECKED(UHazeClient, MaxInteractiveRequests)
+		|| Name == GET_MEMBER_NAME_CHECKED(UHazeClient, MaxBackgroundRequests))
+	{
+		ApplyRequestBudgets();
+	}
+}
+#endif
+
+void UHazeClient::SetMaxCriticalRequests(int32 InMax)
+{
+	MaxCriticalRequests = FMath::Max(InMax, 1);
+	ApplyRequestBudgets();
+}
+
+void UHazeClient::SetMaxInteractiveRequests(int32 InMax)
+{
+	MaxInteractiveRequests = FMath::Max(InMax, 1);
+	ApplyRequestBudgets();
+}
+
+void UHazeClient::SetMaxBackgroundRequests(int32 InMax)
+{
+	MaxBackgroundRequests = FMath::Max(InMax, 1);
+	ApplyRequestBudgets();
+}
+
+void UHazeClient::ApplyRequestBudgets()
+{
+	// SetBudget only pumps the queue when a budget actually changed
+	Scheduler->SetBudget(EHazeRequestPriority::Critical, MaxCriticalRequests);
+	Scheduler->SetBudget(EHazeRequestPriority::Interactive, MaxInteractiveRequests);
+	Scheduler->SetBudget(EHazeRequestPriority::Background, MaxBackgroundRequests);
+}
+
+void UHazeClient::BeginDestroy()
+{
+	if (ProbeHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ProbeHandle);
+		ProbeHandle.Reset();
+	}
+	// Requests still waiting for a slot would otherwise never call back
+	Scheduler->CancelQueued();
+	Super::BeginDestroy();
+}
+
+void UHazeClient::SyncNodes()
+{
+	Router->MaxFinalizedLag = MaxFinalizedLag;
+	if (Router->HasNodes(NodeUrls)) return;
+	Router->SetNodes(NodeUrls);
+
+	const bool bProbe = Router->Num() > 1;
+	if (bProbe && !ProbeHandle.IsValid())
+	{
+		ProbeHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis = TWeakObjectPtr<UHazeClient>(this)](float)
+		{
+			UHazeClient* This = WeakThis.Get();
+			if (!This) return false;
+			This->ProbeNodes();
+			return true;
+		}), FMath::Max(0.25f, NodeProbeIntervalSeconds));
+	}
+	else if (!bProbe && ProbeHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ProbeHandle);
+		ProbeHandle.Reset();
+	}
+	if (bProbe)
+	{
+		// Rank the nodes before the first interval has passed
+		ProbeNodes();
+	}
+}
+
+void UHazeClient::ProbeNodes()
+{
+	for (const FHazeNodeStatus& Node : Router->GetStatus())
+	{
+		ProbeNode(Node.Url);
+	}
+}
+
+void UHazeClient::ProbeNode(const FString& NodeUrl)
+{
+	const int32 Node = Router->FindNode(NodeUrl);
+	if (Node == INDEX_NONE || !Router->BeginProbe(Node)) return;
+
+	// Probes bypass CreateRequest: they are neither routed nor counted in the endpoint metrics
+	const float Timeout = FMath::Min<float>(TimeoutSeconds, FailoverTimeoutSeconds);
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(NodeUrl + TEXT("/health"));
+	Request->SetVerb(TEXT("GET"));
+	Request->SetTimeout(Timeout);
+	Request->OnProcessRequestComplete().BindLambda([WeakThis = TWeakObjectPtr<UHazeClient>(this), NodeUrl, Timeout, Started = FPlatformTime::Seconds()]
+		(FHttpRequestPtr, FHttpResponsePtr Res, bool bOk)
+	{
+		const double RoundTripMs = (FPlatformTime::Seconds() - Started) * 1000.0;
+		DecodeOffGameThread<FString>(FHazeRequestTrace(), Res, bOk, true,
+			[](TArrayView<const uint8> Body, FString& Health) { return HazeResponse::ParseHealth(Body, Health); },
+			[WeakThis, NodeUrl, Timeout, RoundTripMs](bool bHealthy, const FString&, int32)
+		{
+			UHazeClient* This = WeakThis.Get();
+			const int32 Node = This ? This->Router->FindNode(NodeUrl) : INDEX_NONE;
+			if (Node == INDEX_NONE) return;
+			This->Router->RecordProbe(Node, bHealthy, RoundTripMs);
+			if (!bHealthy)
+			{
+				This->Router->EndProbe(Node);
+				return;
+			}
+
+			TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Info = FHttpModule::Get().CreateRequest();
+			Info->SetURL(NodeUrl + TEXT("/api/v1/blockchain/info"));
+			Info->SetVerb(TEXT("GET"));
+			Info->SetTimeout(Timeout);
+			Info->OnProcessRequestComplete().BindLambda([WeakThis, NodeUrl](FHttpRequestPtr, FHttpResponsePtr InfoRes, bool bInfoOk)
+			{
+				DecodeOffGameThread<FBlockchainInfo>(FHazeRequestTrace(), InfoRes, bInfoOk, true,
+					[](TArrayView<const uint8> Body, FBlockchainInfo& Result) { return HazeResponse::ParseBlockchainInfo(Body, Result); },
+					[WeakThis, NodeUrl](bool bParsed, const FBlockchainInfo& Result, int32)
+				{
+					UHazeClient* This = WeakThis.Get();
+					const int32 Node = This ? This->Router->FindNode(NodeUrl) : INDEX_NONE;
+					if (Node == INDEX_NONE) return;
+					if (bParsed) This->Router->RecordInfo(Node, Result);
+					This->Router->EndProbe(Node);
+				});
+			});
+			Info->ProcessRequest();
+		});
+	});
+	Request->ProcessRequest();
+}
+
 FString UHazeClient::NormalizeBaseUrl() const
 {
 	FString Url = BaseUrl.TrimStartAndEnd();
@@ -28,176 +413,956 @@ FString UHazeClient::NormalizeBaseUrl() const
 	return Url;
 }
 
-void UHazeClient::GetHealth(const FHazeHealthDelegate& OnComplete)
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> UHazeClient::CreateRequest(const TCHAR* Verb, const FString& Path, EHazeEndpoint Endpoint,
+	FHazeRequestTrace& OutTrace, const FString& Sender)
 {
-	FString Url = NormalizeBaseUrl() + TEXT("/health");
+	SyncNodes();
+	FString Base;
+	float Timeout = TimeoutSeconds;
+	if (Router->Num() > 0)
+	{
+		const bool bSubmission = IsSubmission(Endpoint);
+		Base = Router->GetUrl(bSubmission || !Sender.IsEmpty() ? Router->PickSubmitFor(Sender) : Router->PickRead());
+		if (!bSubmission && Router->Num() > 1)
+		{
+			Timeout = FMath::Min<float>(TimeoutSeconds, FailoverTimeoutSeconds);
+		}
+	}
+	else
+	{
+		Base = NormalizeBaseUrl();
+	}
+
+	OutTrace = Metrics->Begin(Endpoint);
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Url);
-	Request->SetVerb(TEXT("GET"));
-	Request->SetTimeout(TimeoutSeconds);
+	Request->OnHeaderReceived().BindLambda([Trace = OutTrace](FHttpRequestPtr, const FString&, const FString&) mutable
+	{
+		Trace.MarkFirstByte();
+	});
+	Request->SetURL(Base + Path);
+	Request->SetVerb(Verb);
+	Request->SetTimeout(Timeout);
+	if (bRequestCompression)
+	{
+		Request->SetHeader(TEXT("Accept-Encoding"), TEXT("gzip"));
+	}
+	return Request;
+}
+
+void UHazeClient::SendRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, FHazeRequestTrace& Trace, const FString& Sender)
+{
+	const EHazeEndpoint Endpoint = Trace.GetEndpoint();
+	const bool bSubmission = IsSubmission(Endpoint);
+	const EHazeRequestPriority Priority = CurrentPriority(Endpoint);
 
-	auto Ctx = MakeShared<FHazeHealthDelegate>(OnComplete);
-	Request->OnProcessRequestComplete().BindLambda([this, Ctx](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
+	auto Start = [WeakScheduler = TWeakPtr<FHazeRequestScheduler, ESPMode::ThreadSafe>(Scheduler), Router = Router, Request, Trace, bSubmission, Sender,
+		FailoverTimeout = FMath::Min<float>(TimeoutSeconds, FailoverTimeoutSeconds), FinalTimeout = static_cast<float>(TimeoutSeconds)](uint64 Ticket) mutable
 	{
-		FString Health;
-		if (bOk && Res.IsValid() && Res->GetResponseCode() == 200)
+		// The slot is held until the caller's completion, failover attempts included
+		FHttpRequestCompleteDelegate Complete = Request->OnProcessRequestComplete();
+		Request->OnProcessRequestComplete().BindLambda([WeakScheduler, Ticket, Complete = MoveTemp(Complete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
 		{
-			Health = Res->GetContentAsString();
-			TSharedPtr<FJsonObject> Json;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Health);
-			if (FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid() && Json->HasField(TEXT("data")))
+			if (const TSharedPtr<FHazeRequestScheduler, ESPMode::ThreadSafe> Scheduler = WeakScheduler.Pin())
 			{
-				Health = Json->GetStringField(TEXT("data"));
+				Scheduler->Finish(Ticket);
 			}
+			Complete.ExecuteIfBound(Req, Res, bOk);
+		});
+		Trace.MarkSent();
+		if (Router->Num() > 0)
+		{
+			RouteRequest(Router, Request, bSubmission, Sender, FailoverTimeout, FinalTimeout, 0);
 		}
-		if (Ctx->IsBound())
+		Request->ProcessRequest();
+	};
+
+	// Never sent: completes as a transport failure, on the next tick like any other
+	auto OnSuperseded = [Request]()
+	{
+		AsyncTask(ENamedThreads::GameThread, [Request]()
 		{
-			Ctx->Execute(Health);
+			Request->OnProcessRequestComplete().ExecuteIfBound(Request, nullptr, false);
+		});
+	};
+
+	// Each submission is its own transaction, so none replaces another
+	LastTicket = Scheduler->Enqueue(Priority, bSubmission ? FString() : ScopedSupersedeKey, MoveTemp(Start), MoveTemp(OnSuperseded));
+}
+
+EHazeRequestPriority UHazeClient::CurrentPriority(EHazeEndpoint Endpoint) const
+{
+	return ScopedPriority.IsSet() ? ScopedPriority.GetValue() : FHazeRequestScheduler::DefaultPriority(Endpoint);
+}
+
+FHazeRequestScope::FHazeRequestScope(UHazeClient& InClient, EHazeRequestPriority Priority, const FString& SupersedeKey)
+	: Client(InClient)
+	, PreviousPriority(InClient.ScopedPriority)
+	, PreviousSupersedeKey(InClient.ScopedSupersedeKey)
+{
+	Client.ScopedPriority = Priority;
+	Client.ScopedSupersedeKey = SupersedeKey;
+}
+
+FHazeRequestScope::~FHazeRequestScope()
+{
+	Client.ScopedPriority = PreviousPriority;
+	Client.ScopedSupersedeKey = MoveTemp(PreviousSupersedeKey);
+}
+
+template <typename ValueType, typename SendFn>
+void UHazeClient::FetchCached(THazeReadCache<ValueType> UHazeClient::* Cache, EHazeEndpoint Endpoint, const FString& Key, float TtlSeconds,
+	TFunction<void(bool, const ValueType&)> OnComplete, SendFn&& Send)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (const ValueType* Hit = (this->*Cache).FindFresh(Key, Now))
+	{
+		// Keep the asynchronous contract: never call back from inside the Fetch call
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete), Value = *Hit]() { OnComplete(true, Value); });
+		return;
+	}
+	if ((this->*Cache).JoinOrStart(Key, MoveTemp(OnComplete), Now))
+	{
+		// The flight's priority and supersede key came from whoever started it; this caller waits on it too
+		if (const uint64 Ticket = (this->*Cache).GetFlightTag(Key))
+		{
+			Scheduler->Share(Ticket);
+			Scheduler->Promote(Ticket, CurrentPriority(Endpoint));
+		}
+		return;
+	}
+
+	TWeakObjectPtr<UHazeClient> WeakThis(this);
+	LastTicket = 0;
+	Send([WeakThis, Cache, Key, TtlSeconds](bool bOk, const ValueType& Value)
+	{
+		UHazeClient* This = WeakThis.Get();
+		if (!This) return;
+		for (const TFunction<void(bool, const ValueType&)>& Waiter : (This->*Cache).Complete(Key, bOk, Value, FPlatformTime::Seconds(), TtlSeconds))
+		{
+			Waiter(bOk, Value);
 		}
 	});
-	Request->ProcessRequest();
+	(this->*Cache).SetFlightTag(Key, LastTicket);
 }
 
-void UHazeClient::GetBlockchainInfo(const FHazeBlockchainInfoDelegate& OnComplete)
+void UHazeClient::FetchHealth(FHazeOnHealth OnComplete)
 {
-	FString Url = NormalizeBaseUrl() + TEXT("/api/v1/blockchain/info");
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Url);
-	Request->SetVerb(TEXT("GET"));
-	Request->SetTimeout(TimeoutSeconds);
+	if (!bEnableReadCache)
+	{
+		RequestHealth(MoveTemp(OnComplete));
+		return;
+	}
+	FetchCached(&UHazeClient::HealthCache, EHazeEndpoint::Health, FString(), HealthCacheSeconds, MoveTemp(OnComplete),
+		[this](FHazeOnHealth&& Done) { RequestHealth(MoveTemp(Done)); });
+}
+
+void UHazeClient::FetchBlockchainInfo(FHazeOnBlockchainInfo OnComplete)
+{
+	if (!bEnableReadCache)
+	{
+		RequestBlockchainInfo(MoveTemp(OnComplete));
+		return;
+	}
+	FetchCached(&UHazeClient::BlockchainInfoCache, EHazeEndpoint::BlockchainInfo, FString(), BlockchainInfoCacheSeconds, MoveTemp(OnComplete),
+		[this](FHazeOnBlockchainInfo&& Done) { RequestBlockchainInfo(MoveTemp(Done)); });
+}
+
+void UHazeClient::FetchBalance(const FString& AddressHex, FHazeOnBalance OnComplete)
+{
+	if (!bEnableReadCache)
+	{
+		RequestBalance(AddressHex, MoveTemp(OnComplete));
+		return;
+	}
+	FetchCached(&UHazeClient::BalanceCache, EHazeEndpoint::Balance, AddressKey(AddressHex), BalanceCacheSeconds, MoveTemp(OnComplete),
+		[this, &AddressHex](FHazeOnBalance&& Done) { RequestBalance(AddressHex, MoveTemp(Done)); });
+}
+
+void UHazeClient::FetchAccount(const FString& AddressHex, FHazeOnAccount OnComplete)
+{
+	if (!bEnableReadCache)
+	{
+		RequestAccount(AddressHex, MoveTemp(OnComplete));
+		return;
+	}
+	FetchCached(&UHazeClient::AccountCache, EHazeEndpoint::Account, AddressKey(AddressHex), AccountCacheSeconds, MoveTemp(OnComplete),
+		[this, &AddressHex](FHazeOnAccount&& Done) { RequestAccount(AddressHex, MoveTemp(Done)); });
+}
+
+void UHazeClient::InvalidateAccount(const FString& AddressHex)
+{
+	const FString Key = AddressKey(AddressHex);
+	BalanceCache.Invalidate(Key);
+	AccountCache.Invalidate(Key);
+}
+
+void UHazeClient::InvalidateCache()
+{
+	HealthCache.InvalidateAll();
+	BlockchainInfoCache.InvalidateAll();
+	BalanceCache.InvalidateAll();
+	AccountCache.InvalidateAll();
+}
 
-	auto Ctx = MakeShared<FHazeBlockchainInfoDelegate>(OnComplete);
-	Request->OnProcessRequestComplete().BindLambda([this, Ctx](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
+void UHazeClient::BindCacheInvalidation(UHazeEventStream* Stream)
+{
+	if (Stream)
 	{
-		FBlockchainInfo Info;
-		if (bOk && Res.IsValid() && Res->GetResponseCode() == 200)
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = EHazeStreamEventType::BlockApplied;
+		Stream->Subscribe(Subscription);
+		Stream->OnEventNative().AddUObject(this, &UHazeClient::HandleStreamEvent);
+	}
+}
+
+void UHazeClient::HandleStreamEvent(const FHazeStreamEvent& Event)
+{
+	if (Event.Type != EHazeStreamEventType::BlockApplied) return;
+	BlockchainInfoCache.InvalidateAll();
+	for (const FString& Account : Event.Accounts)
+	{
+		InvalidateAccount(Account);
+	}
+}
+
+void UHazeClient::RequestHealth(FHazeOnHealth OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), TEXT("/health"), EHazeEndpoint::Health, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FString>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FString& Health) { return HazeResponse::ParseHealth(Body, Health); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FString& Health, int32) { OnComplete(bParsed, Health); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::RequestBlockchainInfo(FHazeOnBlockchainInfo OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), TEXT("/api/v1/blockchain/info"), EHazeEndpoint::BlockchainInfo, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FBlockchainInfo>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FBlockchainInfo& Info) { return HazeResponse::ParseBlockchainInfo(Body, Info); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FBlockchainInfo& Info, int32) { OnComplete(bParsed, Info); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::RequestBalance(const FString& AddressHex, FHazeOnBalance OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), FString::Printf(TEXT("/api/v1/accounts/%s/balance"), *AddressHex), EHazeEndpoint::Balance, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FHazeAmount>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FHazeAmount& Balance) { return HazeResponse::ParseBalance(Body, Balance); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeAmount& Balance, int32) { OnComplete(bParsed, Balance); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::RequestAccount(const FString& AddressHex, FHazeOnAccount OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), FString::Printf(TEXT("/api/v1/accounts/%s"), *AddressHex), EHazeEndpoint::Account, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FAccountInfo>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FAccountInfo& Info) { return HazeResponse::ParseAccount(Body, Info); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FAccountInfo& Info, int32) { OnComplete(bParsed, Info); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::SubmitTransaction(const FString& TransactionJson, FHazeOnTransaction OnComplete)
+{
+	TArray<uint8> Body;
+	{
+		HAZE_SCOPE(STAT_HazeBuildJson, HazeBuildJson);
+		Body.Reserve(TransactionJson.Len() + 20);
+		FHazeJsonWriter W(Body);
+		W.BeginObject();
+		W.Key(TEXT("transaction"));
+		W.RawValue(TransactionJson);
+		W.EndObject();
+	}
+	SubmitTransactionBody(MoveTemp(Body), MoveTemp(OnComplete));
+}
+
+void UHazeClient::SubmitTransactionBody(TArray<uint8> Body, FHazeOnTransaction OnComplete)
+{
+	const FString Sender = FindSender(Body);
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), TEXT("/api/v1/transactions"), EHazeEndpoint::SubmitTransaction, Trace, Sender);
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	if (bEnableReadCache)
+	{
+		// The sender's cached balance/nonce are stale once the node has the transaction
+		OnComplete = [WeakThis = TWeakObjectPtr<UHazeClient>(this), Sender, Inner = MoveTemp(OnComplete)]
+			(bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
 		{
-			TSharedPtr<FJsonObject> Root;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Res->GetContentAsString());
-			if (FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid() && Root->HasField(TEXT("data")))
-			{
-				TSharedPtr<FJsonObject> Data = Root->GetObjectField(TEXT("data"));
-				Info.CurrentHeight = Data->GetIntegerField(TEXT("current_height"));
-				Info.TotalSupply = Data->GetStringField(TEXT("total_supply"));
-				Info.CurrentWave = Data->GetIntegerField(TEXT("current_wave"));
-				Info.StateRoot = Data->GetStringField(TEXT("state_root"));
-				Info.LastFinalizedHeight = Data->GetIntegerField(TEXT("last_finalized_height"));
-				Info.LastFinalizedWave = Data->GetIntegerField(TEXT("last_finalized_wave"));
-			}
+			if (bAccepted && WeakThis.IsValid()) WeakThis->InvalidateAccount(Sender);
+			Inner(bAccepted, Response, ResponseCode);
+		};
+	}
+	Request->SetContent(MoveTemp(Body));
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		// Rejections come back as 4xx without an envelope; ParseTransaction reports them as failures
+		DecodeOffGameThread<FTransactionResponse>(Trace, Res, bOk, false,
+			[](TArrayView<const uint8> Body, FTransactionResponse& Response) { return HazeResponse::ParseTransaction(Body, Response); },
+			MoveTemp(OnComplete));
+	});
+	SendRequest(Request, Trace, Sender);
+}
+
+void UHazeClient::SubmitTransactionBatch(const TArray<FString>& TransactionJsons, FHazeOnTransactionBatch OnComplete)
+{
+	if (TransactionJsons.Num() == 0 || TransactionJsons.Num() > MaxTransactionBatch)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]() { OnComplete(false, TArray<FBatchTransactionResult>(), 0); });
+		return;
+	}
+
+	// Builder output is ASCII, so the character count is the UTF-8 size
+	int32 Length = 20 + TransactionJsons.Num();
+	for (const FString& Json : TransactionJsons)
+	{
+		Length += Json.Len();
+	}
+	TArray<uint8> Payload;
+	{
+		HAZE_SCOPE(STAT_HazeBuildJson, HazeBuildJson);
+		Payload.Reserve(Length);
+		FHazeJsonWriter W(Payload);
+		W.BeginObject();
+		W.Key(TEXT("transactions"));
+		W.BeginArray();
+		for (const FString& Json : TransactionJsons)
+		{
+			W.RawValue(Json);
 		}
-		if (Ctx->IsBound())
+		W.EndArray();
+		W.EndObject();
+	}
+
+	// A batch goes where its first transaction's sender goes
+	const FString Sender = FindSender(TransactionJsons[0]);
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), TEXT("/api/v1/transactions/batch"), EHazeEndpoint::SubmitTransactionBatch, Trace, Sender);
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetContent(MoveTemp(Payload));
+	if (bEnableReadCache)
+	{
+		TArray<FString> Senders;
+		Senders.Reserve(TransactionJsons.Num());
+		for (const FString& Json : TransactionJsons)
 		{
-			Ctx->Execute(Info);
+			Senders.Add(FindSender(Json));
 		}
+		OnComplete = [WeakThis = TWeakObjectPtr<UHazeClient>(this), Senders = MoveTemp(Senders), Inner = MoveTemp(OnComplete)]
+			(bool bOk, const TArray<FBatchTransactionResult>& Results, int32 ResponseCode)
+		{
+			if (UHazeClient* This = WeakThis.Get())
+			{
+				for (int32 i = 0; i < Results.Num() && i < Senders.Num(); i++)
+				{
+					if (Results[i].IsAccepted()) This->InvalidateAccount(Senders[i]);
+				}
+			}
+			Inner(bOk, Results, ResponseCode);
+		};
+	}
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<TArray<FBatchTransactionResult>>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, TArray<FBatchTransactionResult>& Results) { return HazeResponse::ParseTransactionBatch(Body, Results); },
+			MoveTemp(OnComplete));
 	});
-	Request->ProcessRequest();
+	SendRequest(Request, Trace, Sender);
 }
 
-void UHazeClient::GetBalance(const FString& AddressHex, const FHazeBalanceDelegate& OnComplete)
+void UHazeClient::SubmitTransactionBinary(TArray<uint8> Transaction, FHazeOnTransaction OnComplete)
 {
-	FString Url = NormalizeBaseUrl() + FString::Printf(TEXT("/api/v1/accounts/%s/balance"), *AddressHex);
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Url);
-	Request->SetVerb(TEXT("GET"));
-	Request->SetTimeout(TimeoutSeconds);
+	if (Transaction.Num() == 0)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]() { OnComplete(false, FTransactionResponse(), 0); });
+		return;
+	}
 
-	auto Ctx = MakeShared<FHazeBalanceDelegate>(OnComplete);
-	Request->OnProcessRequestComplete().BindLambda([Ctx](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
+	const FString Sender = FindBinarySender(Transaction);
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), TEXT("/api/v1/transactions"), EHazeEndpoint::SubmitTransaction, Trace, Sender);
+	Request->SetHeader(TEXT("Content-Type"), BincodeContentType);
+	Request->SetHeader(TEXT("Accept"), BincodeContentType);
+	if (bEnableReadCache)
 	{
-		FString Balance;
-		if (bOk && Res.IsValid() && Res->GetResponseCode() == 200)
+		OnComplete = [WeakThis = TWeakObjectPtr<UHazeClient>(this), Sender, Inner = MoveTemp(OnComplete)]
+			(bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
 		{
-			TSharedPtr<FJsonObject> Root;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Res->GetContentAsString());
-			if (FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid() && Root->HasField(TEXT("data")))
+			if (bAccepted && WeakThis.IsValid()) WeakThis->InvalidateAccount(Sender);
+			Inner(bAccepted, Response, ResponseCode);
+		};
+	}
+	Request->SetContent(MoveTemp(Transaction));
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FTransactionResponse>(Trace, Res, bOk, false,
+			[](TArrayView<const uint8> Body, FTransactionResponse& Response) { return HazeResponse::ParseTransactionBinary(Body, Response); },
+			MoveTemp(OnComplete));
+	});
+	SendRequest(Request, Trace, Sender);
+}
+
+void UHazeClient::SubmitTransactionBatchBinary(const TArray<TArray<uint8>>& Transactions, FHazeOnTransactionBatch OnComplete)
+{
+	const bool bAnyEmpty = Transactions.ContainsByPredicate([](const TArray<uint8>& Tx) { return Tx.Num() == 0; });
+	if (bAnyEmpty || Transactions.Num() == 0 || Transactions.Num() > MaxTransactionBatch)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]() { OnComplete(false, TArray<FBatchTransactionResult>(), 0); });
+		return;
+	}
+
+	// Vec<Transaction>: u64 count, then the transactions back to back
+	int32 Length = 8;
+	for (const TArray<uint8>& Tx : Transactions)
+	{
+		Length += Tx.Num();
+	}
+	TArray<uint8> Payload;
+	Payload.Reserve(Length);
+	FHazeBincodeWriter(Payload).WriteLength(Transactions.Num());
+	for (const TArray<uint8>& Tx : Transactions)
+	{
+		Payload.Append(Tx);
+	}
+
+	const FString Sender = FindBinarySender(Transactions[0]);
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), TEXT("/api/v1/transactions/batch"), EHazeEndpoint::SubmitTransactionBatch, Trace, Sender);
+	Request->SetHeader(TEXT("Content-Type"), BincodeContentType);
+	Request->SetHeader(TEXT("Accept"), BincodeContentType);
+	Request->SetContent(MoveTemp(Payload));
+	if (bEnableReadCache)
+	{
+		TArray<FString> Senders;
+		Senders.Reserve(Transactions.Num());
+		for (const TArray<uint8>& Tx : Transactions)
+		{
+			Senders.Add(FindBinarySender(Tx));
+		}
+		OnComplete = [WeakThis = TWeakObjectPtr<UHazeClient>(this), Senders = MoveTemp(Senders), Inner = MoveTemp(OnComplete)]
+			(bool bOk, const TArray<FBatchTransactionResult>& Results, int32 ResponseCode)
+		{
+			if (UHazeClient* This = WeakThis.Get())
 			{
-				Balance = Root->GetStringField(TEXT("data"));
+				for (int32 i = 0; i < Results.Num() && i < Senders.Num(); i++)
+				{
+					if (Results[i].IsAccepted()) This->InvalidateAccount(Senders[i]);
+				}
 			}
-		}
-		if (Ctx->IsBound())
+			Inner(bOk, Results, ResponseCode);
+		};
+	}
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<TArray<FBatchTransactionResult>>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, TArray<FBatchTransactionResult>& Results) { return HazeResponse::ParseTransactionBatchBinary(Body, Results); },
+			MoveTemp(OnComplete));
+	});
+	SendRequest(Request, Trace, Sender);
+}
+
+bool UHazeClient::FetchSubmittedTransaction(const FString& TransactionJson, FHazeOnTransaction OnComplete)
+{
+	const FString Hash = FTransactionBuilder::TransferHash(TransactionJson);
+	if (Hash.IsEmpty()) return false;
+
+	// Pools are per node: only the one the sender submits to knows a pending transaction
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), FString::Printf(TEXT("/api/v1/transactions/%s"), *Hash),
+		EHazeEndpoint::Transaction, Trace, FindSender(TransactionJson));
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FTransactionResponse>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FTransactionResponse& Response) { return HazeResponse::ParseTransaction(Body, Response); },
+			MoveTemp(OnComplete));
+	});
+	SendRequest(Request, Trace);
+	return true;
+}
+
+void UHazeClient::FetchAsset(const FString& AssetIdHex, FHazeOnAsset OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), FString::Printf(TEXT("/api/v1/assets/%s"), *AssetIdHex), EHazeEndpoint::Asset, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FHazeAssetInfo>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FHazeAssetInfo& Asset) { return HazeResponse::ParseAsset(Body, Asset); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeAssetInfo& Asset, int32) { OnComplete(bParsed, Asset); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchAssetSummaries(const TArray<FString>& AssetIdsHex, FHazeOnAssetSummaries OnComplete)
+{
+	if (AssetIdsHex.Num() == 0 || AssetIdsHex.Num() > MaxAssetSummaryBatch)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]() { OnComplete(false, TArray<FHazeAssetInfo>()); });
+		return;
+	}
+
+	// The writer escapes ids, so a malformed one is refused by the node rather than breaking the body
+	TArray<uint8> Payload;
+	Payload.Reserve(16 + AssetIdsHex.Num() * 67);
+	{
+		FHazeJsonWriter W(Payload);
+		W.BeginObject();
+		W.Key(TEXT("asset_ids"));
+		W.BeginArray();
+		for (const FString& AssetId : AssetIdsHex)
 		{
-			Ctx->Execute(Balance);
+			W.String(AssetId.TrimStartAndEnd());
 		}
+		W.EndArray();
+		W.EndObject();
+	}
+
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), TEXT("/api/v1/assets/summaries"), EHazeEndpoint::AssetSummaries, Trace);
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetContent(MoveTemp(Payload));
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<TArray<FHazeAssetInfo>>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, TArray<FHazeAssetInfo>& Assets) { return HazeResponse::ParseAssetSummaries(Body, Assets); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const TArray<FHazeAssetInfo>& Assets, int32) { OnComplete(bParsed, Assets); });
 	});
-	Request->ProcessRequest();
+	SendRequest(Request, Trace);
 }
 
-void UHazeClient::GetAccount(const FString& AddressHex, const FHazeAccountInfoDelegate& OnComplete)
+UHazeAssetCursor* UHazeClient::SearchAssets(const FHazeAssetSearchQuery& Query)
 {
-	FString Url = NormalizeBaseUrl() + FString::Printf(TEXT("/api/v1/accounts/%s"), *AddressHex);
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Url);
-	Request->SetVerb(TEXT("GET"));
-	Request->SetTimeout(TimeoutSeconds);
+	UHazeAssetCursor* Cursor = NewObject<UHazeAssetCursor>(this);
+	Cursor->Init(this, Query);
+	return Cursor;
+}
 
-	auto Ctx = MakeShared<FHazeAccountInfoDelegate>(OnComplete);
-	Request->OnProcessRequestComplete().BindLambda([Ctx](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
+void UHazeClient::FetchAssetSearchPage(const FHazeAssetSearchQuery& Query, int64 Offset, FHazeOnAssetSearchPage OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), AssetSearchPath(Query, Offset), EHazeEndpoint::AssetSearch, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete), LabelKey = Query.LabelKey, Capacity = Query.PageSize, Offset]
+		(FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
 	{
-		FAccountInfo Info;
-		if (bOk && Res.IsValid() && Res->GetResponseCode() == 200)
+		using FPagePtr = TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe>;
+		DecodeOffGameThread<FPagePtr>(Trace, Res, bOk, true,
+			[LabelKey, Capacity, Offset](TArrayView<const uint8> Body, FPagePtr& Page)
+			{
+				Page = MakeShared<FHazeAssetPage, ESPMode::ThreadSafe>();
+				Page->SetOffset(Offset);
+				Page->Reserve(FMath::Clamp(Capacity, 1, MaxAssetSearchPage));
+				return HazeResponse::ParseAssetSearchPage(Body, *Page, LabelKey);
+			},
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FPagePtr& Page, int32) { OnComplete(bParsed, bParsed ? Page : nullptr); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchAssetBlob(const FString& AssetIdHex, const FString& BlobKey, FHazeOnBlobDownload OnComplete, FHazeOnBlobProgress OnProgress)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), FString::Printf(TEXT("/api/v1/assets/%s"), *AssetIdHex), EHazeEndpoint::AssetBlobRef, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, WeakThis = TWeakObjectPtr<UHazeClient>(this), AssetIdHex, BlobKey,
+		OnComplete = MoveTemp(OnComplete), OnProgress = MoveTemp(OnProgress)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FString>(Trace, Res, bOk, true,
+			[BlobKey](TArrayView<const uint8> Body, FString& BlobHash) { return HazeResponse::ParseAssetBlobRef(Body, BlobKey, BlobHash); },
+			[WeakThis, AssetIdHex, BlobKey, OnComplete = MoveTemp(OnComplete), OnProgress = MoveTemp(OnProgress)](bool bParsed, const FString& BlobHash, int32 Code) mutable
 		{
-			TSharedPtr<FJsonObject> Root;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Res->GetContentAsString());
-			if (FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid() && Root->HasField(TEXT("data")))
+			UHazeClient* This = WeakThis.Get();
+			if (!This || !bParsed)
 			{
-				TSharedPtr<FJsonObject> Data = Root->GetObjectField(TEXT("data"));
-				Info.Balance = Data->GetStringField(TEXT("balance"));
-				Info.Nonce = Data->GetIntegerField(TEXT("nonce"));
-				Info.Staked = Data->GetStringField(TEXT("staked"));
+				FHazeBlobDownloadResult Result;
+				Result.Error = Code == 404 ? TEXT("asset not found")
+					: Code == 200 ? FString::Printf(TEXT("asset has no blob '%s'"), *BlobKey)
+					: FString::Printf(TEXT("asset lookup failed (HTTP %d)"), Code);
+				OnComplete(false, Result);
+				return;
 			}
+			This->FetchBlob(AssetIdHex, BlobKey, BlobHash, MoveTemp(OnComplete), MoveTemp(OnProgress));
+		});
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchBlob(const FString& AssetIdHex, const FString& BlobKey, const FString& BlobHashHex, FHazeOnBlobDownload OnComplete, FHazeOnBlobProgress OnProgress)
+{
+	const FString BlobHash = FHazeBlobCache::NormalizeHash(BlobHashHex);
+	if (BlobHash.IsEmpty())
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete), BlobHashHex]()
+		{
+			FHazeBlobDownloadResult Result;
+			Result.Error = FString::Printf(TEXT("invalid blob hash '%s'"), *BlobHashHex);
+			OnComplete(false, Result);
+		});
+		return;
+	}
+
+	// Content-addressed: whichever asset started the download, the bytes are the same
+	if (TSharedPtr<FHazeBlobDownload, ESPMode::ThreadSafe>* Existing = BlobDownloads.Find(BlobHash))
+	{
+		(*Existing)->AddWaiter(MoveTemp(OnComplete), MoveTemp(OnProgress));
+		return;
+	}
+
+	// Each chunk is a Background request that fails over like any read; If-Range with the hash keeps chunks from
+	// different nodes consistent. A failed download resumes from the partial file on the next call.
+	const FString Path = FString::Printf(TEXT("/api/v1/assets/%s/blob/%s"), *AssetIdHex, *FGenericPlatformHttp::UrlEncode(BlobKey));
+	FHazeBlobTransport Transport = [WeakThis = TWeakObjectPtr<UHazeClient>(this), Path](const TMap<FString, FString>& Headers,
+		TFunction<void(FHazeBlobResponse&&)> OnResponse)
+	{
+		UHazeClient* This = WeakThis.Get();
+		if (!This)
+		{
+			AsyncTask(ENamedThreads::GameThread, [OnResponse = MoveTemp(OnResponse)]() { OnResponse(FHazeBlobResponse()); });
+			return;
 		}
-		if (Ctx->IsBound())
+
+		FHazeRequestTrace Trace;
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = This->CreateRequest(TEXT("GET"), Path, EHazeEndpoint::AssetBlob, Trace);
+		// A whole chunk on the first node; the read failover timeout is sized for small responses
+		Request->SetTimeout(This->TimeoutSeconds);
+		for (const TPair<FString, FString>& Header : Headers)
 		{
-			Ctx->Execute(Info);
+			Request->SetHeader(Header.Key, Header.Value);
+		}
+		Request->OnProcessRequestComplete().BindLambda([Trace, OnResponse = MoveTemp(OnResponse)](FHttpRequestPtr, FHttpResponsePtr Res, bool bOk) mutable
+		{
+			FHazeBlobResponse Response;
+			if (bOk && Res.IsValid())
+			{
+				Response.Code = Res->GetResponseCode();
+				Response.ContentRange = Res->GetHeader(TEXT("Content-Range"));
+				Response.Http = Res;
+				Trace.MarkCompleted(Res->GetContentLength());
+			}
+			Trace.Finish(Response.Code == 200 || Response.Code == 206);
+			OnResponse(MoveTemp(Response));
+		});
+		FHazeRequestScope Scope(*This, EHazeRequestPriority::Background);
+		This->SendRequest(Request, Trace);
+	};
+
+	TSharedPtr<FHazeBlobDownload, ESPMode::ThreadSafe> Download = MakeShared<FHazeBlobDownload, ESPMode::ThreadSafe>(BlobHash, BlobChunkSizeBytes,
+		MoveTemp(Transport));
+	Download->AddWaiter(MoveTemp(OnComplete), MoveTemp(OnProgress));
+	BlobDownloads.Add(BlobHash, Download);
+	Download->Start([WeakThis = TWeakObjectPtr<UHazeClient>(this), BlobHash]()
+	{
+		if (UHazeClient* This = WeakThis.Get())
+		{
+			This->BlobDownloads.Remove(BlobHash);
 		}
 	});
-	Request->ProcessRequest();
+}
+
+void UHazeClient::GetHealth(const FHazeHealthDelegate& OnComplete)
+{
+	FetchHealth([OnComplete](bool, const FString& Health) { OnComplete.ExecuteIfBound(Health); });
+}
+
+void UHazeClient::GetBlockchainInfo(const FHazeBlockchainInfoDelegate& OnComplete)
+{
+	FetchBlockchainInfo([OnComplete](bool, const FBlockchainInfo& Info) { OnComplete.ExecuteIfBound(Info); });
+}
+
+void UHazeClient::GetBalance(const FString& AddressHex, const FHazeBalanceDelegate& OnComplete)
+{
+	FetchBalance(AddressHex, [OnComplete](bool, const FHazeAmount& Balance) { OnComplete.ExecuteIfBound(Balance); });
+}
+
+void UHazeClient::GetAccount(const FString& AddressHex, const FHazeAccountInfoDelegate& OnComplete)
+{
+	FetchAccount(AddressHex, [OnComplete](bool, const FAccountInfo& Info) { OnComplete.ExecuteIfBound(Info); });
 }
 
 void UHazeClient::SendTransaction(const FString& TransactionJson, const FHazeTransactionDelegate& OnComplete)
 {
-	FString Url = NormalizeBaseUrl() + TEXT("/api/v1/transactions");
-	FString Body = FString::Printf(TEXT("{\"transaction\":%s}"), *TransactionJson);
+	SubmitTransaction(TransactionJson, [OnComplete](bool bAccepted, const FTransactionResponse& Response, int32)
+	{
+		OnComplete.ExecuteIfBound(bAccepted, Response);
+	});
+}
 
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(Url);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Request->SetContentAsString(Body);
-	Request->SetTimeout(TimeoutSeconds);
+void UHazeClient::SendTransactionBatch(const TArray<FString>& TransactionJsons, const FHazeTransactionBatchDelegate& OnComplete)
+{
+	SubmitTransactionBatch(TransactionJsons, [OnComplete](bool bOk, const TArray<FBatchTransactionResult>& Results, int32)
+	{
+		OnComplete.ExecuteIfBound(bOk, Results);
+	});
+}
 
-	auto Ctx = MakeShared<FHazeTransactionDelegate>(OnComplete);
-	Request->OnProcessRequestComplete().BindLambda([Ctx](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk)
+void UHazeClient::FetchBlockByHeight(int64 Height, FHazeOnBlock OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"),
+		FString::Printf(TEXT("/api/v1/blocks/height/%lld"), Height), EHazeEndpoint::Block, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
 	{
-		FTransactionResponse TxRes;
-		bool bSuccess = false;
-		if (bOk && Res.IsValid())
+		DecodeOffGameThread<FHazeBlockInfo>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FHazeBlockInfo& Block) { return HazeResponse::ParseBlock(Body, Block); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeBlockInfo& Block, int32) { OnComplete(bParsed, Block); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::GetBlockByHeight(int64 Height, const FHazeBlockDelegate& OnComplete)
+{
+	FetchBlockByHeight(Height, [OnComplete](bool bOk, const FHazeBlockInfo& Block) { OnComplete.ExecuteIfBound(bOk, Block); });
+}
+
+void UHazeClient::FetchLiquidityPools(FHazeOnLiquidityPools OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), TEXT("/api/v1/economy/pools"), EHazeEndpoint::LiquidityPools, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<TArray<FLiquidityPool>>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, TArray<FLiquidityPool>& Pools) { return HazeResponse::ParseLiquidityPools(Body, Pools); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const TArray<FLiquidityPool>& Pools, int32) { OnComplete(bParsed, Pools); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchLiquidityPool(const FString& PoolId, FHazeOnLiquidityPool OnComplete)
+{
+	// Pool ids are "pool:{asset1}:{asset2}" with arbitrary asset names
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"),
+		TEXT("/api/v1/economy/pools/") + FGenericPlatformHttp::UrlEncode(PoolId), EHazeEndpoint::LiquidityPools, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FLiquidityPool>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FLiquidityPool& Pool) { return HazeResponse::ParseLiquidityPool(Body, Pool); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FLiquidityPool& Pool, int32) { OnComplete(bParsed, Pool); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchGasSchedule(int64 KnownVersion, FHazeOnGasSchedule OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), TEXT("/api/v1/assets/gas-schedule"), EHazeEndpoint::GasSchedule, Trace);
+	if (KnownVersion != 0)
+	{
+		// The ETag is the quoted schedule version
+		Request->SetHeader(TEXT("If-None-Match"), FString::Printf(TEXT("\"%lld\""), KnownVersion));
+	}
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FHazeGasSchedule>(Trace, Res, bOk, false,
+			[](TArrayView<const uint8> Body, FHazeGasSchedule& Schedule) { return HazeResponse::ParseGasSchedule(Body, Schedule); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeGasSchedule& Schedule, int32 Code)
 		{
-			TSharedPtr<FJsonObject> Root;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Res->GetContentAsString());
-			if (FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid())
+			if (Code == 304)
 			{
-				bSuccess = Root->GetBoolField(TEXT("success"));
-				if (bSuccess && Root->HasField(TEXT("data")))
-				{
-					TSharedPtr<FJsonObject> Data = Root->GetObjectField(TEXT("data"));
-					TxRes.Hash = Data->GetStringField(TEXT("hash"));
-					TxRes.Status = Data->GetStringField(TEXT("status"));
-				}
+				OnComplete(true, false, FHazeGasSchedule());
+				return;
 			}
-		}
-		if (Ctx->IsBound())
+			const bool bFetched = bParsed && Code == 200 && Schedule.Version != 0;
+			OnComplete(bFetched, bFetched, bFetched ? Schedule : FHazeGasSchedule());
+		});
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchAssetSnapshot(const FString& OwnerHex, const FString& GameId, const FString& KnownStateRoot, FHazeOnAssetSnapshot OnComplete)
+{
+	const FString Owner = OwnerHex.TrimStartAndEnd();
+	const FString Path = !Owner.IsEmpty()
+		? TEXT("/api/v1/snapshots/assets?owner=") + FGenericPlatformHttp::UrlEncode(Owner)
+		: TEXT("/api/v1/snapshots/assets?game_id=") + FGenericPlatformHttp::UrlEncode(GameId);
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), Path, EHazeEndpoint::AssetSnapshot, Trace);
+	if (!KnownStateRoot.IsEmpty())
+	{
+		// The ETag is the quoted state root the snapshot was taken at
+		Request->SetHeader(TEXT("If-None-Match"), FString::Printf(TEXT("\"%s\""), *KnownStateRoot.TrimStartAndEnd().ToLower()));
+	}
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<TArray<uint8>>(Trace, Res, bOk, false,
+			[](TArrayView<const uint8> Body, TArray<uint8>& Snapshot)
+			{
+				if (!FHazeAssetSnapshot::IsValid(Body)) return false;
+				Snapshot.Append(Body.GetData(), Body.Num());
+				return true;
+			},
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const TArray<uint8>& Snapshot, int32 Code)
+		{
+			if (Code == 304)
+			{
+				OnComplete(true, false, TArray<uint8>());
+				return;
+			}
+			const bool bFetched = bParsed && Code == 200;
+			OnComplete(bFetched, bFetched, Snapshot);
+		});
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchStaleSnapshotEntries(const TArray<TPair<FString, uint64>>& Entries, FHazeOnSnapshotStale OnComplete)
+{
+	if (Entries.Num() > MaxSnapshotStaleBatch)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]() { OnComplete(false, FHazeSnapshotStalePage()); });
+		return;
+	}
+
+	// The writer escapes ids, so a malformed one is refused by the node rather than breaking the body
+	TArray<uint8> Payload;
+	Payload.Reserve(16 + Entries.Num() * 112);
+	{
+		FHazeJsonWriter W(Payload);
+		W.BeginObject();
+		W.Key(TEXT("assets"));
+		W.BeginArray();
+		for (const TPair<FString, uint64>& Entry : Entries)
 		{
-			Ctx->Execute(bSuccess, TxRes);
+			W.BeginObject();
+			W.Field(TEXT("asset_id"), Entry.Key.TrimStartAndEnd());
+			W.Field(TEXT("fingerprint"), FString::Printf(TEXT("%016llx"), Entry.Value));
+			W.EndObject();
 		}
+		W.EndArray();
+		W.EndObject();
+	}
+
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), TEXT("/api/v1/snapshots/assets/stale"), EHazeEndpoint::SnapshotStale, Trace);
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetContent(MoveTemp(Payload));
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FHazeSnapshotStalePage>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FHazeSnapshotStalePage& Page) { return HazeResponse::ParseSnapshotStalePage(Body, Page); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeSnapshotStalePage& Page, int32) { OnComplete(bParsed, Page); });
 	});
-	Request->ProcessRequest();
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchAssetVersionsSince(const FString& AssetIdHex, int64 SinceVersion, FHazeOnAssetVersions OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"),
+		FString::Printf(TEXT("/api/v1/assets/%s/versions?since=%lld"), *AssetIdHex, FMath::Max<int64>(SinceVersion, 0)), EHazeEndpoint::AssetVersions, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FHazeAssetVersionsPage>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FHazeAssetVersionsPage& Page) { return HazeResponse::ParseAssetVersionsPage(Body, Page); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeAssetVersionsPage& Page, int32) { OnComplete(bParsed, Page); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::FetchAssetHistorySince(const FString& AssetIdHex, int64 SinceIndex, int32 Limit, FHazeOnAssetHistory OnComplete)
+{
+	FHazeRequestTrace Trace;
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"),
+		FString::Printf(TEXT("/api/v1/assets/%s/history?since=%lld&limit=%d"), *AssetIdHex, FMath::Max<int64>(SinceIndex, 0), FMath::Max(Limit, 0)),
+		EHazeEndpoint::AssetHistory, Trace);
+	Request->OnProcessRequestComplete().BindLambda([Trace, OnComplete = MoveTemp(OnComplete)](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bOk) mutable
+	{
+		DecodeOffGameThread<FHazeAssetHistoryPage>(Trace, Res, bOk, true,
+			[](TArrayView<const uint8> Body, FHazeAssetHistoryPage& Page) { return HazeResponse::ParseAssetHistoryPage(Body, Page); },
+			[OnComplete = MoveTemp(OnComplete)](bool bParsed, const FHazeAssetHistoryPage& Page, int32) { OnComplete(bParsed, Page); });
+	});
+	SendRequest(Request, Trace);
+}
+
+void UHazeClient::GetAsset(const FString& AssetIdHex, const FHazeAssetDelegate& OnComplete)
+{
+	FetchAsset(AssetIdHex, [OnComplete](bool bOk, const FHazeAssetInfo& Asset) { OnComplete.ExecuteIfBound(bOk, Asset); });
+}
+
+void UHazeClient::GetAssetSummaries(const TArray<FString>& AssetIdsHex, const FHazeAssetSummariesDelegate& OnComplete)
+{
+	FetchAssetSummaries(AssetIdsHex, [OnComplete](bool bOk, const TArray<FHazeAssetInfo>& Assets) { OnComplete.ExecuteIfBound(bOk, Assets); });
+}
+
+void UHazeClient::DownloadAssetBlob(const FString& AssetIdHex, const FString& BlobKey, const FHazeBlobDownloadDelegate& OnComplete)
+{
+	FetchAssetBlob(AssetIdHex, BlobKey, [OnComplete](bool bOk, const FHazeBlobDownloadResult& Result)
+	{
+		OnComplete.ExecuteIfBound(bOk, Result);
+	});
+}
+
+void UHazeClient::GetLiquidityPools(const FHazeLiquidityPoolsDelegate& OnComplete)
+{
+	FetchLiquidityPools([OnComplete](bool bOk, const TArray<FLiquidityPool>& Pools) { OnComplete.ExecuteIfBound(bOk, Pools); });
+}
+
+void UHazeClient::GetLiquidityPool(const FString& PoolId, const FHazeLiquidityPoolDelegate& OnComplete)
+{
+	FetchLiquidityPool(PoolId, [OnComplete](bool bOk, const FLiquidityPool& Pool) { OnComplete.ExecuteIfBound(bOk, Pool); });
 }
 
 void UHazeClient::GetHealthSync(const FString& BaseUrl, FString& OutHealth, FString& OutError)
 {
 	OutHealth.Empty();
-	OutError.Empty();
-	// Sync HTTP in Unreal is not straightforward; typically use async. For BlueprintPure we return empty and document "use async GetHealth".
 	OutError = TEXT("Use async GetHealth instead");
 }
+
+void UHazeClient::GetHealthBlocking(const FString& BaseUrl, FString& OutHealth, FString& OutError)
+{
+	check(!IsInGameThread());
+	OutHealth.Empty();
+	OutError.Empty();
+	FString Url = BaseUrl.TrimStartAndEnd();
+	if (Url.EndsWith(TEXT("/")))
+	{
+		Url.LeftChopInline(1);
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Url + TEXT("/health"));
+	Request->SetVerb(TEXT("GET"));
+	Request->SetTimeout(HealthBlockingTimeoutSeconds);
+	if (!Request->ProcessRequest())
+	{
+		OutError = TEXT("Request could not be started");
+		return;
+	}
+
+	// The game thread keeps ticking the HTTP manager while this thread waits
+	const double Deadline = FPlatformTime::Seconds() + HealthBlockingTimeoutSeconds + 1.0;
+	while (Request->GetStatus() == EHttpRequestStatus::Processing && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	const FHttpResponsePtr Res = Request->GetResponse();
+	if (Request->GetStatus() != EHttpRequestStatus::Succeeded || !Res.IsValid())
+	{
+		Request->CancelRequest();
+		OutError = Request->GetStatus() == EHttpRequestStatus::Processing ? TEXT("Timed out") : TEXT("Request failed");
+		return;
+	}
+	if (Res->GetResponseCode() != 200)
+	{
+		OutError = FString::Printf(TEXT("HTTP %d"), Res->GetResponseCode());
+		return;
+	}
+	if (!HazeResponse::ParseHealth(Res->GetContent(), OutHealth))
+	{
+		OutError = TEXT("Unexpected response");
+	}
+}
@@ -0,0 +1,264 @@
+// Copyright HAZE Blockchain. Persistent WebSocket client for /api/v1/ws.
+
+#include "HazeEventStream.h"
+#include "HazeBlockchain.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+#include "Async/Async.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "HazeResponseParser.h"
+
+UHazeEventStream* UHazeEventStream::CreateEventStream(const FString& InBaseUrl)
+{
+	UHazeEventStream* Stream = NewObject<UHazeEventStream>();
+	Stream->BaseUrl = InBaseUrl;
+	return Stream;
+}
+
+void UHazeEventStream::Connect()
+{
+	bWantConnected = true;
+	if (!Socket.IsValid() && !ReconnectHandle.IsValid())
+	{
+		ReconnectAttempt = 0;
+		OpenSocket();
+	}
+}
+
+void UHazeEventStream::Disconnect()
+{
+	bWantConnected = false;
+	if (ReconnectHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+		ReconnectHandle.Reset();
+	}
+	CloseSocket();
+}
+
+bool UHazeEventStream::IsConnected() const
+{
+	return bConnected;
+}
+
+void UHazeEventStream::Subscribe(const FHazeStreamSubscription& Subscription)
+{
+	const int32 Index = Subscriptions.Find(Subscription);
+	if (Index != INDEX_NONE)
+	{
+		++SubscriptionRefs[Index];
+		return;
+	}
+	Subscriptions.Add(Subscription);
+	SubscriptionRefs.Add(1);
+	MarkSubscriptionsDirty();
+}
+
+void UHazeEventStream::Unsubscribe(const FHazeStreamSubscription& Subscription)
+{
+	const int32 Index = Subscriptions.Find(Subscription);
+	if (Index == INDEX_NONE || --SubscriptionRefs[Index] > 0) return;
+	Subscriptions.RemoveAt(Index);
+	SubscriptionRefs.RemoveAt(Index);
+	MarkSubscriptionsDirty();
+}
+
+void UHazeEventStream::ClearSubscriptions()
+{
+	if (Subscriptions.Num() > 0)
+	{
+		Subscriptions.Reset();
+		SubscriptionRefs.Reset();
+		MarkSubscriptionsDirty();
+	}
+}
+
+void UHazeEventStream::BeginDestroy()
+{
+	if (FlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+		FlushHandle.Reset();
+	}
+	OnConnectionChanged.Clear();
+	Disconnect();
+	Super::BeginDestroy();
+}
+
+FString UHazeEventStream::MakeWebSocketUrl() const
+{
+	FString Url = BaseUrl.TrimStartAndEnd();
+	if (Url.EndsWith(TEXT("/")))
+	{
+		Url.LeftChopInline(1);
+	}
+	if (Url.StartsWith(TEXT("https://")))
+	{
+		Url = TEXT("wss://") + Url.RightChop(8);
+	}
+	else if (Url.StartsWith(TEXT("http://")))
+	{
+		Url = TEXT("ws://") + Url.RightChop(7);
+	}
+	return Url + TEXT("/api/v1/ws");
+}
+
+void UHazeEventStream::OpenSocket()
+{
+	FWebSocketsModule& Module = FModuleManager::LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets"));
+	Socket = Module.CreateWebSocket(MakeWebSocketUrl());
+	Socket->OnConnected().AddUObject(this, &UHazeEventStream::HandleConnected);
+	Socket->OnConnectionError().AddUObject(this, &UHazeEventStream::HandleConnectionError);
+	Socket->OnClosed().AddUObject(this, &UHazeEventStream::HandleClosed);
+	Socket->OnRawMessage().AddUObject(this, &UHazeEventStream::HandleRawMessage);
+	Socket->Connect();
+}
+
+void UHazeEventStream::CloseSocket()
+{
+	if (Socket.IsValid())
+	{
+		TSharedPtr<IWebSocket> Closing = MoveTemp(Socket);
+		Socket.Reset();
+		Closing->OnConnected().RemoveAll(this);
+		Closing->OnConnectionError().RemoveAll(this);
+		Closing->OnClosed().RemoveAll(this);
+		Closing->OnRawMessage().RemoveAll(this);
+		Closing->Close();
+		// Called from the socket's own callbacks too: release it after they unwind
+		AsyncTask(ENamedThreads::GameThread, [Closing]() {});
+	}
+	Partial.Reset();
+	if (bConnected)
+	{
+		bConnected = false;
+		OnConnectionChanged.Broadcast(false);
+	}
+}
+
+void UHazeEventStream::ScheduleReconnect()
+{
+	CloseSocket();
+	if (!bWantConnected || ReconnectHandle.IsValid()) return;
+
+	const float Cap = FMath::Min(MaxReconnectDelaySeconds, InitialReconnectDelaySeconds * FMath::Pow(2.f, static_cast<float>(ReconnectAttempt)));
+	const float Delay = FMath::FRandRange(0.5f * Cap, Cap);
+	ReconnectAttempt = FMath::Min(ReconnectAttempt + 1, 16);
+
+	TWeakObjectPtr<UHazeEventStream> WeakThis(this);
+	ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+	{
+		if (UHazeEventStream* This = WeakThis.Get())
+		{
+			This->ReconnectHandle.Reset();
+			if (This->bWantConnected && !This->Socket.IsValid())
+			{
+				This->OpenSocket();
+			}
+		}
+		return false;
+	}), Delay);
+}
+
+void UHazeEventStream::MarkSubscriptionsDirty()
+{
+	if (!bConnected || FlushHandle.IsValid()) return;
+
+	TWeakObjectPtr<UHazeEventStream> WeakThis(this);
+	FlushHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+	{
+		if (UHazeEventStream* This = WeakThis.Get())
+		{
+			This->FlushHandle.Reset();
+			This->SendSubscriptions();
+		}
+		return false;
+	}));
+}
+
+void UHazeEventStream::SendSubscriptions()
+{
+	if (!bConnected || !Socket.IsValid()) return;
+
+	// {"subscribe":[{"type":"asset_created","asset_id":"...","owner":"...","game_id":"...","pool_id":"..."}]} (empty fields omitted)
+	FString Message;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Message);
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("subscribe"));
+	for (const FHazeStreamSubscription& Sub : Subscriptions)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("type"), HazeResponse::StreamEventTypeName(Sub.Type));
+		if (!Sub.AssetId.IsEmpty()) Writer->WriteValue(TEXT("asset_id"), Sub.AssetId.ToLower());
+		if (!Sub.Owner.IsEmpty()) Writer->WriteValue(TEXT("owner"), Sub.Owner.ToLower());
+		if (!Sub.GameId.IsEmpty()) Writer->WriteValue(TEXT("game_id"), Sub.GameId);
+		if (!Sub.PoolId.IsEmpty()) Writer->WriteValue(TEXT("pool_id"), Sub.PoolId);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	Socket->Send(Message);
+}
+
+void UHazeEventStream::HandleConnected()
+{
+	bConnected = true;
+	ReconnectAttempt = 0;
+	SendSubscriptions();
+	OnConnectionChanged.Broadcast(true);
+}
+
+void UHazeEventStream::HandleConnectionError(const FString& Error)
+{
+	UE_LOG(LogHaze, Warning, TEXT("HAZE event stream: connection error (%s)"), *Error);
+	ScheduleReconnect();
+}
+
+void UHazeEventStream::HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
+{
+	ScheduleReconnect();
+}
+
+void UHazeEventStream::HandleRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+{
+	Partial.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+	if (BytesRemaining > 0) return;
+
+	const uint64 Sequence = NextDecodeSequence++;
+	TWeakObjectPtr<UHazeEventStream> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Sequence, Message = MoveTemp(Partial)]() mutable
+	{
+		FHazeStreamEvent Event;
+		const bool bOk = HazeResponse::ParseStreamEvent(Message, Event);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Sequence, bOk, Event = MoveTemp(Event)]() mutable
+		{
+			if (UHazeEventStream* This = WeakThis.Get())
+			{
+				This->DeliverDecoded(Sequence, bOk, MoveTemp(Event));
+			}
+		});
+	});
+	Partial.Reset();
+}
+
+void UHazeEventStream::DeliverDecoded(uint64 Sequence, bool bOk, FHazeStreamEvent&& Event)
+{
+	TOptional<FHazeStreamEvent> Entry;
+	if (bOk) Entry = MoveTemp(Event);
+	Decoded.Add(Sequence, MoveTemp(Entry));
+
+	while (TOptional<FHazeStreamEvent>* Next = Decoded.Find(NextDeliverSequence))
+	{
+		TOptional<FHazeStreamEvent> Ready = MoveTemp(*Next);
+		Decoded.Remove(NextDeliverSequence);
+		NextDeliverSequence++;
+		if (Ready.IsSet())
+		{
+			EventNative.Broadcast(Ready.GetValue());
+			OnEvent.Broadcast(Ready.GetValue());
+		}
+	}
+}
@@ -0,0 +1,163 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeGasEstimator.h"
+
+namespace
+{
+	/** Metadata size in KB, rounded up */
+	uint64 SizeKb(uint64 Bytes)
+	{
+		return (Bytes + 1023) / 1024;
+	}
+
+	uint64 CondenseMultiplier(const FHazeGasSchedule& Schedule, EDensityLevel Density)
+	{
+		switch (Density)
+		{
+		case EDensityLevel::Light: return static_cast<uint64>(Schedule.CondenseMultiplierLight);
+		case EDensityLevel::Dense: return static_cast<uint64>(Schedule.CondenseMultiplierDense);
+		case EDensityLevel::Core: return static_cast<uint64>(Schedule.CondenseMultiplierCore);
+		default: return static_cast<uint64>(Schedule.CondenseMultiplierEthereal);
+		}
+	}
+}
+
+uint64 FHazeGasEstimate::MetadataBytes(const TMap<FString, FString>& Metadata)
+{
+	uint64 Bytes = 0;
+	for (const TPair<FString, FString>& Entry : Metadata)
+	{
+		Bytes += FPlatformString::ConvertedLength<UTF8CHAR>(*Entry.Value, Entry.Value.Len());
+	}
+	return Bytes;
+}
+
+uint64 FHazeGasEstimate::CountComponents(FStringView Components)
+{
+	uint64 Count = 0;
+	bool bSegmentHasText = false;
+	for (const TCHAR Char : Components)
+	{
+		if (Char == TEXT(','))
+		{
+			Count += bSegmentHasText;
+			bSegmentHasText = false;
+		}
+		else if (!FChar::IsWhitespace(Char))
+		{
+			bSegmentHasText = true;
+		}
+	}
+	return Count + bSegmentHasText;
+}
+
+uint64 FHazeGasEstimate::GasCost(const FHazeGasSchedule& Schedule, EAssetAction Action, EDensityLevel Density, const TMap<FString, FString>& Metadata)
+{
+	// The node reads the merge and split parameters from the same metadata it sizes
+	const FString* Components = Metadata.Find(TEXT("_components"));
+	return GasCost(Schedule, Action, Density, MetadataBytes(Metadata), Metadata.Contains(TEXT("_other_asset_id")),
+		Components ? CountComponents(*Components) : 1);
+}
+
+uint64 FHazeGasEstimate::GasCost(const FHazeGasSchedule& Schedule, EAssetAction Action, EDensityLevel Density, uint64 MetadataBytes,
+	bool bHasOtherAsset, uint64 ComponentCount)
+{
+	switch (Action)
+	{
+	case EAssetAction::Create:
+		return static_cast<uint64>(Schedule.CreateBase) + static_cast<uint64>(Schedule.CreatePerKb) * SizeKb(MetadataBytes);
+	case EAssetAction::Update:
+		return static_cast<uint64>(Schedule.UpdateBase) + static_cast<uint64>(Schedule.UpdatePerKb) * SizeKb(MetadataBytes);
+	case EAssetAction::Condense:
+		return static_cast<uint64>(Schedule.CondenseBase) * CondenseMultiplier(Schedule, Density)
+			+ static_cast<uint64>(Schedule.CondensePerKb) * SizeKb(MetadataBytes);
+	case EAssetAction::Evaporate:
+		return static_cast<uint64>(Schedule.EvaporateBase);
+	case EAssetAction::Merge:
+		// The node counts the other asset as the same size as this one
+		return static_cast<uint64>(Schedule.MergeBase)
+			+ static_cast<uint64>(Schedule.MergePerKb) * SizeKb(bHasOtherAsset ? MetadataBytes * 2 : MetadataBytes);
+	case EAssetAction::Split:
+	{
+		const uint64 ComponentKb = SizeKb(MetadataBytes / FMath::Max<uint64>(ComponentCount, 1));
+		return static_cast<uint64>(Schedule.SplitBase) + static_cast<uint64>(Schedule.SplitPerComponent) * ComponentCount
+			+ static_cast<uint64>(Schedule.SplitPerKb) * ComponentKb * ComponentCount;
+	}
+	default:
+		return 0;
+	}
+}
+
+FHazeGasQuote FHazeGasEstimate::MakeQuote(const FHazeGasSchedule& Schedule, uint64 GasCost)
+{
+	FHazeGasQuote Quote;
+	Quote.bValid = Schedule.Version != 0;
+	Quote.GasCost = static_cast<int64>(GasCost);
+	Quote.GasFee = FHazeAmount::FromParts(0, GasCost * static_cast<uint64>(Schedule.GasPrice));
+	Quote.GasPrice = Schedule.GasPrice;
+	Quote.ScheduleVersion = Schedule.Version;
+	return Quote;
+}
+
+UHazeGasEstimator* UHazeGasEstimator::CreateGasEstimator(UHazeClient* InClient)
+{
+	UHazeGasEstimator* Estimator = NewObject<UHazeGasEstimator>();
+	Estimator->Client = InClient;
+	return Estimator;
+}
+
+void UHazeGasEstimator::Refresh()
+{
+	if (!Client)
+	{
+		OnRefreshed.Broadcast(false, false);
+		return;
+	}
+	if (bRefreshing)
+	{
+		bRefreshAgain = true;
+		return;
+	}
+	bRefreshing = true;
+	Client->FetchGasSchedule(Schedule.Version, [WeakThis = TWeakObjectPtr<UHazeGasEstimator>(this)](bool bOk, bool bChanged, const FHazeGasSchedule& Fetched)
+	{
+		UHazeGasEstimator* This = WeakThis.Get();
+		if (!This) return;
+		This->bRefreshing = false;
+		const bool bAdopted = bOk && bChanged && This->ApplySchedule(Fetched);
+		This->OnRefreshed.Broadcast(bOk, bAdopted);
+		if (This->bRefreshAgain)
+		{
+			This->bRefreshAgain = false;
+			This->Refresh();
+		}
+	});
+}
+
+void UHazeGasEstimator::NoteScheduleVersion(int64 Version)
+{
+	if (Version != 0 && Version != Schedule.Version)
+	{
+		Refresh();
+	}
+}
+
+FHazeGasQuote UHazeGasEstimator::Estimate(EAssetAction Action, EDensityLevel Density, const TMap<FString, FString>& Metadata) const
+{
+	return FHazeGasEstimate::MakeQuote(Schedule, FHazeGasEstimate::GasCost(Schedule, Action, Density, Metadata));
+}
+
+FHazeGasQuote UHazeGasEstimator::EstimateSized(EAssetAction Action, EDensityLevel Density, uint64 MetadataBytes, bool bHasOtherAsset,
+	uint64 ComponentCount) const
+{
+	return FHazeGasEstimate::MakeQuote(Schedule,
+		FHazeGasEstimate::GasCost(Schedule, Action, Density, MetadataBytes, bHasOtherAsset, ComponentCount));
+}
+
+bool UHazeGasEstimator::ApplySchedule(const FHazeGasSchedule& InSchedule)
+{
+	if (InSchedule.Version == 0) return false;
+	const bool bChanged = InSchedule.Version != Schedule.Version;
+	Schedule = InSchedule;
+	return bChanged;
+}
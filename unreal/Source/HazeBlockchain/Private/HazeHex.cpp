@@ -0,0 +1,237 @@
+// Copyright HAZE Blockchain. Hex codec.
+
+#include "HazeHex.h"
+
+#if PLATFORM_ALWAYS_HAS_SSE4_1
+#include <tmmintrin.h>
+#define HAZE_HEX_SSSE3 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_64BITS
+#include <arm_neon.h>
+#define HAZE_HEX_NEON 1
+#endif
+
+namespace
+{
+	struct FHexTables
+	{
+		/** Two lowercase digits per byte value */
+		ANSICHAR Pairs[512];
+		/** Digit value per code unit < 256, -1 if not a hex digit */
+		int8 Values[256];
+
+		constexpr FHexTables()
+			: Pairs{}
+			, Values{}
+		{
+			constexpr ANSICHAR Digits[] = "0123456789abcdef";
+			for (int32 i = 0; i < 256; i++)
+			{
+				Pairs[i * 2] = Digits[i >> 4];
+				Pairs[i * 2 + 1] = Digits[i & 15];
+				Values[i] = -1;
+			}
+			for (int32 i = 0; i < 10; i++)
+			{
+				Values['0' + i] = static_cast<int8>(i);
+			}
+			for (int32 i = 0; i < 6; i++)
+			{
+				Values['a' + i] = static_cast<int8>(10 + i);
+				Values['A' + i] = static_cast<int8>(10 + i);
+			}
+		}
+	};
+
+	constexpr FHexTables Tables;
+
+	FORCEINLINE int32 Nibble(TCHAR C)
+	{
+		const uint32 U = static_cast<uint32>(C);
+		return U < 256 ? Tables.Values[U] : -1;
+	}
+
+	FORCEINLINE bool IsAsciiWhitespace(TCHAR C)
+	{
+		return C == TEXT(' ') || C == TEXT('\t') || C == TEXT('\n') || C == TEXT('\r');
+	}
+
+	template <typename CharType>
+	FORCEINLINE void EncodeScalar(const uint8* Bytes, int32 Len, CharType* Out)
+	{
+		for (int32 i = 0; i < Len; i++)
+		{
+			const ANSICHAR* Pair = &Tables.Pairs[Bytes[i] * 2];
+			Out[i * 2] = static_cast<CharType>(Pair[0]);
+			Out[i * 2 + 1] = static_cast<CharType>(Pair[1]);
+		}
+	}
+
+#if HAZE_HEX_SSSE3
+	/** 16 input bytes -> 32 ASCII digits in two registers (bytes 0-7, bytes 8-15). */
+	FORCEINLINE void Encode16(const uint8* In, __m128i& OutA, __m128i& OutB)
+	{
+		const __m128i Lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+		const __m128i Mask = _mm_set1_epi8(0x0f);
+		const __m128i V = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In));
+		const __m128i Hi = _mm_shuffle_epi8(Lut, _mm_and_si128(_mm_srli_epi16(V, 4), Mask));
+		const __m128i Lo = _mm_shuffle_epi8(Lut, _mm_and_si128(V, Mask));
+		OutA = _mm_unpacklo_epi8(Hi, Lo);
+		OutB = _mm_unpackhi_epi8(Hi, Lo);
+	}
+
+	FORCEINLINE void Store32(uint8* Out, const __m128i& A, const __m128i& B)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out), A);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 16), B);
+	}
+
+	/** Widen 32 ASCII digits to 16-bit code units. */
+	FORCEINLINE void Store32Wide(uint16* Out, const __m128i& A, const __m128i& B)
+	{
+		const __m128i Zero = _mm_setzero_si128();
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out), _mm_unpacklo_epi8(A, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 8), _mm_unpackhi_epi8(A, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 16), _mm_unpacklo_epi8(B, Zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 24), _mm_unpackhi_epi8(B, Zero));
+	}
+#elif HAZE_HEX_NEON
+	FORCEINLINE uint8x16x2_t Encode16(const uint8* In)
+	{
+		static constexpr uint8 LutBytes[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+		const uint8x16_t Lut = vld1q_u8(LutBytes);
+		const uint8x16_t V = vld1q_u8(In);
+		const uint8x16_t Hi = vqtbl1q_u8(Lut, vshrq_n_u8(V, 4));
+		const uint8x16_t Lo = vqtbl1q_u8(Lut, vandq_u8(V, vdupq_n_u8(0x0f)));
+		return vzipq_u8(Hi, Lo);
+	}
+
+	FORCEINLINE void Store32(uint8* Out, const uint8x16x2_t& D)
+	{
+		vst1q_u8(Out, D.val[0]);
+		vst1q_u8(Out + 16, D.val[1]);
+	}
+
+	FORCEINLINE void Store32Wide(uint16* Out, const uint8x16x2_t& D)
+	{
+		vst1q_u16(Out, vmovl_u8(vget_low_u8(D.val[0])));
+		vst1q_u16(Out + 8, vmovl_u8(vget_high_u8(D.val[0])));
+		vst1q_u16(Out + 16, vmovl_u8(vget_low_u8(D.val[1])));
+		vst1q_u16(Out + 24, vmovl_u8(vget_high_u8(D.val[1])));
+	}
+#endif
+}
+
+void FHazeHex::Encode(const uint8* Bytes, int32 Len, TCHAR* Out)
+{
+	int32 i = 0;
+#if HAZE_HEX_SSSE3 || HAZE_HEX_NEON
+	if constexpr (sizeof(TCHAR) == 2)
+	{
+		for (; i + 16 <= Len; i += 16)
+		{
+#if HAZE_HEX_SSSE3
+			__m128i A, B;
+			Encode16(Bytes + i, A, B);
+			Store32Wide(reinterpret_cast<uint16*>(Out + i * 2), A, B);
+#else
+			Store32Wide(reinterpret_cast<uint16*>(Out + i * 2), Encode16(Bytes + i));
+#endif
+		}
+	}
+#endif
+	EncodeScalar(Bytes + i, Len - i, Out + i * 2);
+}
+
+void FHazeHex::Encode(const uint8* Bytes, int32 Len, UTF8CHAR* Out)
+{
+	int32 i = 0;
+#if HAZE_HEX_SSSE3 || HAZE_HEX_NEON
+	for (; i + 16 <= Len; i += 16)
+	{
+#if HAZE_HEX_SSSE3
+		__m128i A, B;
+		Encode16(Bytes + i, A, B);
+		Store32(reinterpret_cast<uint8*>(Out + i * 2), A, B);
+#else
+		Store32(reinterpret_cast<uint8*>(Out + i * 2), Encode16(Bytes + i));
+#endif
+	}
+#endif
+	EncodeScalar(Bytes + i, Len - i, Out + i * 2);
+}
+
+FString FHazeHex::ToHex(TArrayView<const uint8> Bytes)
+{
+	FString Result;
+	AppendHex(Result, Bytes);
+	return Result;
+}
+
+void FHazeHex::AppendHex(FString& Out, TArrayView<const uint8> Bytes)
+{
+	if (Bytes.Num() == 0) return;
+	const int32 Start = Out.Len();
+	const int32 HexLen = Bytes.Num() * 2;
+	auto& Chars = Out.GetCharArray();
+	Chars.SetNumUninitialized(Start + HexLen + 1);
+	Encode(Bytes.GetData(), Bytes.Num(), Chars.GetData() + Start);
+	Chars[Start + HexLen] = TEXT('\0');
+}
+
+bool FHazeHex::Decode(FStringView Hex, uint8* Out, int32 OutLen)
+{
+	if (OutLen < 0 || Hex.Len() != OutLen * 2) return false;
+	const TCHAR* P = Hex.GetData();
+	// Accumulate instead of branching per digit; any -1 makes Bad negative (shifted unsigned, so -1 is not UB)
+	int32 Bad = 0;
+	for (int32 i = 0; i < OutLen; i++)
+	{
+		const int32 A = Nibble(P[i * 2]);
+		const int32 B = Nibble(P[i * 2 + 1]);
+		Bad |= A | B;
+		Out[i] = static_cast<uint8>((static_cast<uint32>(A) << 4) | static_cast<uint32>(B));
+	}
+	return Bad >= 0;
+}
+
+int32 FHazeHex::DecodeLenient(FStringView Hex, uint8* Out, int32 OutCapacity)
+{
+	int32 N = 0;
+	int32 Pending = -1;
+	for (TCHAR C : Hex)
+	{
+		if (IsAsciiWhitespace(C)) continue;
+		const int32 V = Nibble(C);
+		if (V < 0) return -1;
+		if (Pending < 0)
+		{
+			Pending = V;
+			continue;
+		}
+		if (N >= OutCapacity) return -1;
+		Out[N++] = static_cast<uint8>((Pending << 4) | V);
+		Pending = -1;
+	}
+	return Pending < 0 ? N : -1;
+}
+
+TArray<uint8> FHazeHex::ToBytes(FStringView Hex)
+{
+	TArray<uint8> Out;
+	Out.SetNumUninitialized(Hex.Len() / 2);
+	const int32 N = DecodeLenient(Hex, Out.GetData(), Out.Num());
+	if (N < 0)
+	{
+		Out.Reset();
+	}
+	else
+	{
+		Out.SetNum(N);
+	}
+	return Out;
+}
+
+int32 FHazeHex::DigitValue(TCHAR C)
+{
+	return Nibble(C);
+}
@@ -0,0 +1,192 @@
+// Copyright HAZE Blockchain. Single-pass UTF-8 JSON writer for request bodies.
+
+#include "HazeJsonWriter.h"
+#include "HazeHex.h"
+
+void FHazeJsonWriter::Separate()
+{
+	if (bAfterKey)
+	{
+		bAfterKey = false;
+		return;
+	}
+	if (HasValue.Num() > 0)
+	{
+		if (HasValue.Last()) Out.Add(',');
+		HasValue.Last() = true;
+	}
+}
+
+void FHazeJsonWriter::BeginObject()
+{
+	Separate();
+	Out.Add('{');
+	HasValue.Add(false);
+}
+
+void FHazeJsonWriter::EndObject()
+{
+	Out.Add('}');
+	if (HasValue.Num() > 0) HasValue.Pop();
+}
+
+void FHazeJsonWriter::BeginArray()
+{
+	Separate();
+	Out.Add('[');
+	HasValue.Add(false);
+}
+
+void FHazeJsonWriter::EndArray()
+{
+	Out.Add(']');
+	if (HasValue.Num() > 0) HasValue.Pop();
+}
+
+void FHazeJsonWriter::Key(FStringView Name)
+{
+	Separate();
+	Out.Add('"');
+	AppendUtf8(Name, true);
+	Ascii("\":", 2);
+	bAfterKey = true;
+}
+
+void FHazeJsonWriter::String(FStringView Value)
+{
+	Separate();
+	Out.Add('"');
+	AppendUtf8(Value, true);
+	Out.Add('"');
+}
+
+void FHazeJsonWriter::Hex(TArrayView<const uint8> Bytes)
+{
+	Separate();
+	Out.Add('"');
+	const int32 Start = Out.AddUninitialized(Bytes.Num() * 2);
+	FHazeHex::Encode(Bytes.GetData(), Bytes.Num(), reinterpret_cast<UTF8CHAR*>(Out.GetData() + Start));
+	Out.Add('"');
+}
+
+void FHazeJsonWriter::Number(uint64 Value)
+{
+	Separate();
+	AppendDigits(Value);
+}
+
+void FHazeJsonWriter::NumberString(uint64 Value)
+{
+	Separate();
+	Out.Add('"');
+	AppendDigits(Value);
+	Out.Add('"');
+}
+
+void FHazeJsonWriter::AppendDigits(uint64 Value)
+{
+	char Digits[20];
+	int32 Len = 0;
+	do
+	{
+		Digits[Len++] = static_cast<char>('0' + Value % 10);
+		Value /= 10;
+	}
+	while (Value != 0);
+	const int32 Start = Out.AddUninitialized(Len);
+	for (int32 i = 0; i < Len; i++)
+	{
+		Out[Start + i] = static_cast<uint8>(Digits[Len - 1 - i]);
+	}
+}
+
+void FHazeJsonWriter::Null()
+{
+	Separate();
+	Ascii("null", 4);
+}
+
+void FHazeJsonWriter::RawValue(FStringView Json)
+{
+	Separate();
+	AppendUtf8(Json, false);
+}
+
+void FHazeJsonWriter::RawValue(TArrayView<const uint8> Utf8Json)
+{
+	Separate();
+	Out.Append(Utf8Json.GetData(), Utf8Json.Num());
+}
+
+void FHazeJsonWriter::AppendUtf8(FStringView Text, bool bEscape)
+{
+	static const char HexDigits[] = "0123456789abcdef";
+
+	const TCHAR* Chars = Text.GetData();
+	const int32 Len = Text.Len();
+	for (int32 i = 0; i < Len; i++)
+	{
+		uint32 C = static_cast<uint32>(Chars[i]);
+		if (C < 0x80)
+		{
+			if (!bEscape || (C >= 0x20 && C != '"' && C != '\\'))
+			{
+				Out.Add(static_cast<uint8>(C));
+				continue;
+			}
+			switch (C)
+			{
+			case '"': Ascii("\\\"", 2); break;
+			case '\\': Ascii("\\\\", 2); break;
+			case '\n': Ascii("\\n", 2); break;
+			case '\r': Ascii("\\r", 2); break;
+			case '\t': Ascii("\\t", 2); break;
+			case '\b': Ascii("\\b", 2); break;
+			case '\f': Ascii("\\f", 2); break;
+			default:
+			{
+				const char Escaped[6] = { '\\', 'u', '0', '0', HexDigits[C >> 4], HexDigits[C & 0xF] };
+				Ascii(Escaped, 6);
+				break;
+			}
+			}
+			continue;
+		}
+
+		// UTF-16 TCHAR: combine surrogate pairs; a lone surrogate becomes U+FFFD
+		if (sizeof(TCHAR) == 2 && C >= 0xD800 && C <= 0xDFFF)
+		{
+			const uint32 Next = i + 1 < Len ? static_cast<uint32>(Chars[i + 1]) : 0;
+			if (C <= 0xDBFF && Next >= 0xDC00 && Next <= 0xDFFF)
+			{
+				C = 0x10000 + ((C - 0xD800) << 10) + (Next - 0xDC00);
+				i++;
+			}
+			else
+			{
+				C = 0xFFFD;
+			}
+		}
+		else if (C > 0x10FFFF || (C >= 0xD800 && C <= 0xDFFF))
+		{
+			C = 0xFFFD;
+		}
+
+		if (C < 0x800)
+		{
+			const uint8 Bytes[2] = { static_cast<uint8>(0xC0 | (C >> 6)), static_cast<uint8>(0x80 | (C & 0x3F)) };
+			Out.Append(Bytes, 2);
+		}
+		else if (C < 0x10000)
+		{
+			const uint8 Bytes[3] = { static_cast<uint8>(0xE0 | (C >> 12)), static_cast<uint8>(0x80 | ((C >> 6) & 0x3F)), static_cast<uint8>(0x80 | (C & 0x3F)) };
+			Out.Append(Bytes, 3);
+		}
+		else
+		{
+			const uint8 Bytes[4] = { static_cast<uint8>(0xF0 | (C >> 18)), static_cast<uint8>(0x80 | ((C >> 12) & 0x3F)),
+				static_cast<uint8>(0x80 | ((C >> 6) & 0x3F)), static_cast<uint8>(0x80 | (C & 0x3F)) };
+			Out.Append(Bytes, 4);
+		}
+	}
+}
@@ -0,0 +1,224 @@
+// Copyright HAZE Blockchain.
+
+#include "HazeNodeRouter.h"
+
+namespace
+{
+	/** Weight of the newest probe in the smoothed latency */
+	constexpr double LatencySmoothing = 0.3;
+
+	FString NormalizeUrl(const FString& Url)
+	{
+		FString Out = Url.TrimStartAndEnd();
+		while (Out.EndsWith(TEXT("/")))
+		{
+			Out.LeftChopInline(1);
+		}
+		return Out;
+	}
+
+	bool IsExcluded(uint64 Excluded, int32 Node)
+	{
+		return (Excluded & (1ull << Node)) != 0;
+	}
+}
+
+void FHazeNodeRouter::SetNodes(const TArray<FString>& Urls)
+{
+	Configured = Urls;
+	TArray<FNode> Next;
+	for (const FString& Raw : Urls)
+	{
+		const FString Url = NormalizeUrl(Raw);
+		if (Url.IsEmpty() || Next.Num() == MaxNodes || Next.ContainsByPredicate([&Url](const FNode& N) { return N.Url == Url; }))
+		{
+			continue;
+		}
+		const FNode* Known = Nodes.FindByPredicate([&Url](const FNode& N) { return N.Url == Url; });
+		FNode& Node = Next.Add_GetRef(Known ? *Known : FNode());
+		Node.Url = Url;
+	}
+	Nodes = MoveTemp(Next);
+	NextSubmit = Nodes.Num() > 0 ? NextSubmit % Nodes.Num() : 0;
+	for (auto It = SenderNodes.CreateIterator(); It; ++It)
+	{
+		if (!Nodes.ContainsByPredicate([&It](const FNode& N) { return N.Url == It.Value(); })) It.RemoveCurrent();
+	}
+}
+
+int32 FHazeNodeRouter::FindNode(const FString& Url) const
+{
+	int32 Best = INDEX_NONE;
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		// Longest match, so http://host:80 never claims http://host:8080
+		if (Url.StartsWith(Nodes[i].Url) && (Best == INDEX_NONE || Nodes[i].Url.Len() > Nodes[Best].Url.Len()))
+		{
+			Best = i;
+		}
+	}
+	return Best;
+}
+
+int64 FHazeNodeRouter::HighestFinalized() const
+{
+	int64 Highest = -1;
+	for (const FNode& Node : Nodes)
+	{
+		if (!Node.bDown) Highest = FMath::Max(Highest, Node.LastFinalizedHeight);
+	}
+	return Highest;
+}
+
+bool FHazeNodeRouter::IsCaughtUp(int32 Node) const
+{
+	const int64 Finalized = Nodes[Node].LastFinalizedHeight;
+	return Finalized < 0 || Finalized + MaxFinalizedLag >= HighestFinalized();
+}
+
+int32 FHazeNodeRouter::PickRead(uint64 Excluded) const
+{
+	// Healthy and caught up, then healthy, then down; fastest within each (unprobed ones last)
+	int32 Best = INDEX_NONE;
+	int32 BestTier = 0;
+	double BestLatency = 0.0;
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		if (IsExcluded(Excluded, i)) continue;
+		const FNode& Node = Nodes[i];
+		const int32 Tier = Node.bDown ? 2 : IsCaughtUp(i) ? 0 : 1;
+		const double Latency = Node.LatencyMs >= 0.0 ? Node.LatencyMs : MAX_dbl;
+		if (Best == INDEX_NONE || Tier < BestTier || (Tier == BestTier && Latency < BestLatency))
+		{
+			Best = i;
+			BestTier = Tier;
+			BestLatency = Latency;
+		}
+	}
+	return Best;
+}
+
+int32 FHazeNodeRouter::PickSubmit(uint64 Excluded)
+{
+	// Same tiers as reads (a node that is behind may reject a valid nonce), then fewest in flight, round robin on ties
+	int32 Best = INDEX_NONE;
+	int32 BestTier = 0;
+	int32 BestInFlight = 0;
+	for (int32 Step = 0; Step < Nodes.Num(); Step++)
+	{
+		const int32 i = (NextSubmit + Step) % Nodes.Num();
+		if (IsExcluded(Excluded, i)) continue;
+		const FNode& Node = Nodes[i];
+		const int32 Tier = Node.bDown ? 2 : IsCaughtUp(i) ? 0 : 1;
+		if (Best == INDEX_NONE || Tier < BestTier || (Tier == BestTier && Node.InFlight < BestInFlight))
+		{
+			Best = i;
+			BestTier = Tier;
+			BestInFlight = Node.InFlight;
+		}
+	}
+	if (Best != INDEX_NONE)
+	{
+		NextSubmit = (Best + 1) % Nodes.Num();
+	}
+	return Best;
+}
+
+int32 FHazeNodeRouter::PickSubmitFor(const FString& Sender, uint64 Excluded)
+{
+	const FString Key = Sender.TrimStartAndEnd().ToLower();
+	if (Key.IsEmpty()) return PickSubmit(Excluded);
+
+	// A lagging node keeps its senders: moving one while its earlier nonces sit in that pool would open a gap
+	if (const FString* Url = SenderNodes.Find(Key))
+	{
+		const int32 Node = Nodes.IndexOfByPredicate([Url](const FNode& N) { return N.Url == *Url; });
+		if (Node != INDEX_NONE && !Nodes[Node].bDown && !IsExcluded(Excluded, Node)) return Node;
+	}
+	const int32 Node = PickSubmit(Excluded);
+	if (Node != INDEX_NONE)
+	{
+		SenderNodes.Add(Key, Nodes[Node].Url);
+	}
+	return Node;
+}
+
+void FHazeNodeRouter::MarkStarted(int32 Node)
+{
+	Nodes[Node].InFlight++;
+}
+
+void FHazeNodeRouter::MarkFinished(int32 Node, bool bReached)
+{
+	FNode& State = Nodes[Node];
+	State.InFlight = FMath::Max(0, State.InFlight - 1);
+	if (bReached)
+	{
+		State.Failures = 0;
+		State.bDown = false;
+	}
+	else
+	{
+		RecordFailure(State);
+	}
+}
+
+void FHazeNodeRouter::RecordFailure(FNode& Node)
+{
+	Node.Failures++;
+	if (Node.Failures >= FailuresBeforeDown)
+	{
+		Node.bDown = true;
+	}
+}
+
+void FHazeNodeRouter::RecordProbe(int32 Node, bool bHealthy, double RoundTripMs)
+{
+	FNode& State = Nodes[Node];
+	if (!bHealthy)
+	{
+		RecordFailure(State);
+		return;
+	}
+	State.Failures = 0;
+	State.bDown = false;
+	State.LatencyMs = State.LatencyMs < 0.0 ? RoundTripMs : State.LatencyMs + LatencySmoothing * (RoundTripMs - State.LatencyMs);
+}
+
+void FHazeNodeRouter::RecordInfo(int32 Node, const FBlockchainInfo& Info)
+{
+	Nodes[Node].LastFinalizedHeight = Info.LastFinalizedHeight;
+	Nodes[Node].CurrentHeight = Info.CurrentHeight;
+}
+
+bool FHazeNodeRouter::BeginProbe(int32 Node)
+{
+	if (Nodes[Node].bProbing) return false;
+	Nodes[Node].bProbing = true;
+	return true;
+}
+
+void FHazeNodeRouter::EndProbe(int32 Node)
+{
+	Nodes[Node].bProbing = false;
+}
+
+TArray<FHazeNodeStatus> FHazeNodeRouter::GetStatus() const
+{
+	TArray<FHazeNodeStatus> Out;
+	Out.Reserve(Nodes.Num());
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		const FNode& Node = Nodes[i];
+		FHazeNodeStatus& Status = Out.AddDefaulted_GetRef();
+		Status.Url = Node.Url;
+		Status.bHealthy = !Node.bDown;
+		Status.bCaughtUp = IsCaughtUp(i);
+		Status.LatencyMs = static_cast<float>(Node.LatencyMs);
+		Status.LastFinalizedHeight = Node.LastFinalizedHeight;
+		Status.CurrentHeight = Node.CurrentHeight;
+		Status.ConsecutiveFailures = Node.Failures;
+		Status.InFlight = Node.InFlight;
+	}
+	return Out;
+}
@@ -0,0 +1,145 @@
+// Copyright HAZE Blockchain. Local nonce allocation for pipelined transaction submission.
+
+#include "HazeNonceManager.h"
+#include "HazeClient.h"
+#include "Misc/ScopeLock.h"
+
+FString FHazeNonceManager::KeyFor(const FString& AddressHex)
+{
+	return AddressHex.TrimStartAndEnd().ToLower();
+}
+
+bool FHazeNonceManager::IsSeeded(const FString& AddressHex) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Accounts.Contains(KeyFor(AddressHex));
+}
+
+bool FHazeNonceManager::NeedsResync(const FString& AddressHex) const
+{
+	FScopeLock ScopeLock(&Lock);
+	const FAccountNonces* Account = Accounts.Find(KeyFor(AddressHex));
+	return Account && Account->bNeedsResync;
+}
+
+void FHazeNonceManager::Seed(const FString& AddressHex, uint64 NextNonce)
+{
+	FScopeLock ScopeLock(&Lock);
+	const FString Key = KeyFor(AddressHex);
+	if (!Accounts.Contains(Key))
+	{
+		Accounts.Add(Key).NextNonce = NextNonce;
+	}
+}
+
+bool FHazeNonceManager::Reserve(const FString& AddressHex, uint64& OutNonce)
+{
+	FScopeLock ScopeLock(&Lock);
+	FAccountNonces* Account = Accounts.Find(KeyFor(AddressHex));
+	if (!Account || Account->bNeedsResync) return false;
+
+	OutNonce = Account->NextNonce++;
+	Account->Pending.Add(OutNonce, ENonceState::Reserved);
+	return true;
+}
+
+void FHazeNonceManager::MarkAccepted(const FString& AddressHex, uint64 Nonce)
+{
+	FScopeLock ScopeLock(&Lock);
+	FAccountNonces* Account = Accounts.Find(KeyFor(AddressHex));
+	if (!Account) return;
+	if (ENonceState* State = Account->Pending.Find(Nonce))
+	{
+		*State = ENonceState::Accepted;
+	}
+}
+
+void FHazeNonceManager::MarkRejected(const FString& AddressHex, uint64 Nonce)
+{
+	FScopeLock ScopeLock(&Lock);
+	FAccountNonces* Account = Accounts.Find(KeyFor(AddressHex));
+	if (!Account) return;
+	if (ENonceState* State = Account->Pending.Find(Nonce))
+	{
+		*State = ENonceState::Rejected;
+		Account->bNeedsResync = true;
+	}
+}
+
+void FHazeNonceManager::MarkConfirmed(const FString& AddressHex, uint64 Nonce)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (FAccountNonces* Account = Accounts.Find(KeyFor(AddressHex)))
+	{
+		Account->Pending.Remove(Nonce);
+	}
+}
+
+FHazeNonceResync FHazeNonceManager::Resync(const FString& AddressHex, uint64 AccountNonce)
+{
+	FScopeLock ScopeLock(&Lock);
+	FAccountNonces& Account = Accounts.FindOrAdd(KeyFor(AddressHex));
+
+	FHazeNonceResync Result;
+	// Walk pending nonces in order: executed ones drop out, the unbroken run from the account nonce survives
+	// (accepted, or still in flight), and everything from the first rejected or missing nonce is orphaned.
+	uint64 Expected = AccountNonce;
+	TSortedMap<uint64, ENonceState> Survivors;
+	for (const TPair<uint64, ENonceState>& Entry : Account.Pending)
+	{
+		if (Entry.Key < AccountNonce)
+		{
+			Result.Confirmed.Add(Entry.Key);
+		}
+		else if (!Result.Gap.IsSet() && Entry.Key == Expected && Entry.Value != ENonceState::Rejected)
+		{
+			Survivors.Add(Entry.Key, Entry.Value);
+			Expected++;
+		}
+		else
+		{
+			if (!Result.Gap.IsSet()) Result.Gap = Expected;
+			Result.Orphaned.Add(Entry.Key);
+		}
+	}
+
+	Account.Pending = MoveTemp(Survivors);
+	Account.NextNonce = Expected;
+	Account.bNeedsResync = false;
+	Result.NextNonce = Expected;
+	return Result;
+}
+
+void FHazeNonceManager::SyncFromNode(UHazeClient* Client, const FString& AddressHex, TFunction<void(bool bOk, const FHazeNonceResync& Result)> OnComplete)
+{
+	if (!Client)
+	{
+		OnComplete(false, FHazeNonceResync());
+		return;
+	}
+
+	TWeakPtr<FHazeNonceManager, ESPMode::ThreadSafe> WeakThis = AsShared();
+	Client->FetchAccount(AddressHex, [WeakThis, AddressHex, OnComplete = MoveTemp(OnComplete)](bool bOk, const FAccountInfo& Info)
+	{
+		TSharedPtr<FHazeNonceManager, ESPMode::ThreadSafe> This = WeakThis.Pin();
+		if (!This.IsValid() || !bOk)
+		{
+			OnComplete(false, FHazeNonceResync());
+			return;
+		}
+		OnComplete(true, This->Resync(AddressHex, static_cast<uint64>(FMath::Max(Info.Nonce, 0))));
+	});
+}
+
+int32 FHazeNonceManager::GetPendingCount(const FString& AddressHex) const
+{
+	FScopeLock ScopeLock(&Lock);
+	const FAccountNonces* Account = Accounts.Find(KeyFor(AddressHex));
+	return Account ? Account->Pending.Num() : 0;
+}
+
+void FHazeNonceManager::Remove(const FString& AddressHex)
+{
+	FScopeLock ScopeLock(&Lock);
+	Accounts.Remove(KeyFor(AddressHex));
+}
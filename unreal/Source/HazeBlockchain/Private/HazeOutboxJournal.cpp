@@ -0,0 +1,319 @@
+// Copyright HAZE Blockchain. Crash-safe journal of signed transactions not yet answered by the node.
+
+#include "HazeOutboxJournal.h"
+#include "HazeBincode.h"
+#include "HazeBlockchain.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** "HZOJ": start of every record */
+	constexpr uint32 RecordMagic = 0x4A4F5A48;
+	/** Magic, kind, payload length, payload CRC-32 */
+	constexpr int32 RecordHeaderSize = 4 + 1 + 4 + 4;
+
+	enum class ERecordKind : uint8
+	{
+		Entry = 1,
+		Ack = 2
+	};
+
+	TArray<uint8> EncodeEntry(const FHazeOutboxEntry& Entry)
+	{
+		TArray<uint8> Payload;
+		FHazeBincodeWriter Writer(Payload);
+		Writer.WriteU64(Entry.Id);
+		Writer.WriteString(Entry.OrderingKey);
+		Writer.WriteOptionU64(Entry.Nonce);
+		Writer.WriteU8(Entry.Priority);
+		Writer.WriteString(Entry.TransactionJson);
+		return Payload;
+	}
+
+	/**
+	 * Pending entries of the journal at Path (none if there is no journal). False if there is one but it could not
+	 * be read: too large, an I/O error, or not even its first record is whole.
+	 */
+	bool ReadJournalFile(const FString& Path, TArray<FHazeOutboxEntry>& OutEntries, uint64& OutMaxId)
+	{
+		OutMaxId = 0;
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const int64 FileSize = PlatformFile.FileSize(*Path);
+		if (FileSize <= 0) return true;
+		if (FileSize > MAX_int32) return false;
+
+		int32 ReadBytes = 0;
+		TUniquePtr<IMappedFileHandle> Handle(PlatformFile.OpenMapped(*Path));
+		TUniquePtr<IMappedFileRegion> Region(Handle ? Handle->MapRegion(0, FileSize) : nullptr);
+		if (Region)
+		{
+			OutEntries = FHazeOutboxJournal::ReadPending(
+				MakeArrayView(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize())), OutMaxId, &ReadBytes);
+			// The region must go before the handle it was mapped from
+			Region.Reset();
+		}
+		else
+		{
+			// Platforms without mapped files
+			TArray<uint8> Data;
+			if (!FFileHelper::LoadFileToArray(Data, *Path)) return false;
+			OutEntries = FHazeOutboxJournal::ReadPending(Data, OutMaxId, &ReadBytes);
+		}
+		return ReadBytes > 0;
+	}
+}
+
+FString FHazeOutboxJournal::GetJournalDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Haze"));
+}
+
+FString FHazeOutboxJournal::GetJournalPath(const FString& Name)
+{
+	return FPaths::Combine(GetJournalDirectory(), Name + TEXT(".journal"));
+}
+
+TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> FHazeOutboxJournal::Open(const FString& Name, float SyncIntervalSeconds)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Path = GetJournalPath(Name);
+	const FString TempPath = Path + TEXT(".tmp");
+	PlatformFile.CreateDirectoryTree(*GetJournalDirectory());
+
+	// The old journal is only deleted once its rewrite is complete: a rewrite without a journal is the journal
+	if (!PlatformFile.FileExists(*Path) && PlatformFile.FileExists(*TempPath))
+	{
+		PlatformFile.MoveFile(*Path, *TempPath);
+	}
+	PlatformFile.DeleteFile(*TempPath);
+
+	TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Journal = MakeShareable(new FHazeOutboxJournal());
+	Journal->Path = Path;
+	uint64 MaxId = 0;
+	if (!ReadJournalFile(Path, Journal->Recovered, MaxId))
+	{
+		// Starting over would truncate transactions we could not read: keep the file for whoever can
+		const FString UnreadPath = FString::Printf(TEXT("%s.%s.unread"), *Path, *FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S")));
+		if (!PlatformFile.MoveFile(*UnreadPath, *Path))
+		{
+			UE_LOG(LogHaze, Error, TEXT("HAZE outbox: cannot read %s or move it aside; not opening"), *Path);
+			return nullptr;
+		}
+		UE_LOG(LogHaze, Error, TEXT("HAZE outbox: cannot read %s; moved it to %s and started a new journal"), *Path, *UnreadPath);
+	}
+	Journal->NextId = MaxId + 1;
+
+	if (Journal->Recovered.Num() > 0)
+	{
+		// Rewrite with the pending entries only (drops acknowledged ones and any torn tail)
+		Journal->File.Reset(PlatformFile.OpenWrite(*TempPath));
+		if (!Journal->File) return nullptr;
+		for (const FHazeOutboxEntry& Entry : Journal->Recovered)
+		{
+			if (!Journal->WriteRecord(static_cast<uint8>(ERecordKind::Entry), EncodeEntry(Entry))) return nullptr;
+			Journal->Pending.Add(Entry.Id);
+		}
+		const bool bSynced = Journal->File->Flush(true);
+		Journal->File.Reset();
+		if (!bSynced || !PlatformFile.DeleteFile(*Path) || !PlatformFile.MoveFile(*Path, *TempPath)) return nullptr;
+		Journal->File.Reset(PlatformFile.OpenWrite(*Path, true));
+	}
+	else
+	{
+		Journal->File.Reset(PlatformFile.OpenWrite(*Path));
+		Journal->Size = 0;
+	}
+	if (!Journal->File) return nullptr;
+
+	Journal->StartSyncTicker(SyncIntervalSeconds);
+	return Journal;
+}
+
+FHazeOutboxJournal::~FHazeOutboxJournal()
+{
+	if (SyncHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SyncHandle);
+	}
+	if (File)
+	{
+		File->Flush(true);
+	}
+}
+
+void FHazeOutboxJournal::StartSyncTicker(float IntervalSeconds)
+{
+	SyncHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakThis = TWeakPtr<FHazeOutboxJournal, ESPMode::ThreadSafe>(AsShared())](float)
+	{
+		TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> This = WeakThis.Pin();
+		if (!This) return false;
+		if (This->bSyncQueued) return true;
+		{
+			FScopeLock ScopeLock(&This->Lock);
+			if (!This->bDirty) return true;
+		}
+		// One sync covers every record appended since the last; appends only wait for it if they land during it
+		This->bSyncQueued = true;
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [This]()
+		{
+			This->Sync();
+			This->bSyncQueued = false;
+		});
+		return true;
+	}), FMath::Max(0.f, IntervalSeconds));
+}
+
+bool FHazeOutboxJournal::WriteRecord(uint8 Kind, const TArray<uint8>& Payload)
+{
+	TArray<uint8> Record;
+	Record.Reserve(RecordHeaderSize + Payload.Num());
+	FHazeBincodeWriter Writer(Record);
+	Writer.WriteU32(RecordMagic);
+	Writer.WriteU8(Kind);
+	Writer.WriteU32(static_cast<uint32>(Payload.Num()));
+	Writer.WriteU32(FCrc::MemCrc32(Payload.GetData(), Payload.Num()));
+	Writer.WriteFixed(Payload);
+
+	if (!File->Write(Record.GetData(), Record.Num()))
+	{
+		// A partial record would hide every later one from recovery: stop journaling instead
+		File.Reset();
+		return false;
+	}
+	Size += Record.Num();
+	bDirty = true;
+	return true;
+}
+
+uint64 FHazeOutboxJournal::Append(const FString& OrderingKey, TOptional<uint64> Nonce, uint8 Priority, const FString& TransactionJson)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!File) return 0;
+	FHazeOutboxEntry Entry;
+	Entry.Id = NextId++;
+	Entry.OrderingKey = OrderingKey;
+	Entry.Nonce = Nonce;
+	Entry.Priority = Priority;
+	Entry.TransactionJson = TransactionJson;
+	if (!WriteRecord(static_cast<uint8>(ERecordKind::Entry), EncodeEntry(Entry))) return 0;
+	Pending.Add(Entry.Id);
+	return Entry.Id;
+}
+
+void FHazeOutboxJournal::Acknowledge(uint64 Id)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!File || Pending.Remove(Id) == 0) return;
+	TArray<uint8> Payload;
+	FHazeBincodeWriter(Payload).WriteU64(Id);
+	if (!WriteRecord(static_cast<uint8>(ERecordKind::Ack), Payload)) return;
+
+	if (Pending.Num() == 0 && Size >= CompactBytes)
+	{
+		// Nothing left to recover, so an empty file loses nothing even if we crash right here. Truncating in place keeps
+		// the handle: reopening would have to close it first (platforms refuse a second writer), and a failed reopen
+		// would leave nothing to append to.
+		if (!File->Truncate(0))
+		{
+			UE_LOG(LogHaze, Error, TEXT("HAZE outbox: cannot truncate %s; appending to it as it is"), *Path);
+			return;
+		}
+		if (!File->Seek(0))
+		{
+			// Appending past the end would leave a hole recovery cannot read through: stop journaling instead
+			UE_LOG(LogHaze, Error, TEXT("HAZE outbox: cannot rewind %s after truncating it; journaling stopped"), *Path);
+			File.Reset();
+			return;
+		}
+		Size = 0;
+	}
+}
+
+TArray<FHazeOutboxEntry> FHazeOutboxJournal::TakeRecovered()
+{
+	FScopeLock ScopeLock(&Lock);
+	TArray<FHazeOutboxEntry> Out = MoveTemp(Recovered);
+	Recovered.Reset();
+	return Out;
+}
+
+int32 FHazeOutboxJournal::GetPendingCount() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Pending.Num();
+}
+
+int64 FHazeOutboxJournal::GetFileSize() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Size;
+}
+
+void FHazeOutboxJournal::Sync()
+{
+	// Under Lock: IFileHandle makes no promise that Flush may race Write on the same handle, and platform handles
+	// keep their position and buffers in it
+	FScopeLock ScopeLock(&Lock);
+	if (File && bDirty && File->Flush(true))
+	{
+		bDirty = false;
+	}
+}
+
+TArray<FHazeOutboxEntry> FHazeOutboxJournal::ReadPending(TArrayView<const uint8> Data, uint64& OutMaxId, int32* OutReadBytes)
+{
+	OutMaxId = 0;
+	TArray<FHazeOutboxEntry> Entries;
+	TMap<uint64, int32> IndexById;
+	int32 Offset = 0;
+	while (Data.Num() - Offset >= RecordHeaderSize)
+	{
+		FHazeBincodeReader Header(Data.Slice(Offset, RecordHeaderSize));
+		const uint32 Magic = Header.ReadU32();
+		const uint8 Kind = Header.ReadU8();
+		const uint32 Length = Header.ReadU32();
+		const uint32 Crc = Header.ReadU32();
+		if (Magic != RecordMagic || Length > static_cast<uint32>(Data.Num() - Offset - RecordHeaderSize)) break;
+		const TArrayView<const uint8> Payload = Data.Slice(Offset + RecordHeaderSize, static_cast<int32>(Length));
+		if (FCrc::MemCrc32(Payload.GetData(), Payload.Num()) != Crc) break;
+
+		FHazeBincodeReader Reader(Payload);
+		if (Kind == static_cast<uint8>(ERecordKind::Entry))
+		{
+			FHazeOutboxEntry Entry;
+			Entry.Id = Reader.ReadU64();
+			Entry.OrderingKey = Reader.ReadString();
+			if (Reader.ReadSome()) Entry.Nonce = Reader.ReadU64();
+			Entry.Priority = Reader.ReadU8();
+			Entry.TransactionJson = Reader.ReadString();
+			if (!Reader.IsDone() || Entry.Id == 0) break;
+			OutMaxId = FMath::Max(OutMaxId, Entry.Id);
+			IndexById.Add(Entry.Id, Entries.Add(MoveTemp(Entry)));
+		}
+		else if (Kind == static_cast<uint8>(ERecordKind::Ack))
+		{
+			const uint64 Id = Reader.ReadU64();
+			if (!Reader.IsDone()) break;
+			if (const int32* Index = IndexById.Find(Id))
+			{
+				// Acknowledged entries are dropped below
+				Entries[*Index].Id = 0;
+			}
+		}
+		else
+		{
+			break;
+		}
+		Offset += RecordHeaderSize + static_cast<int32>(Length);
+	}
+	Entries.RemoveAll([](const FHazeOutboxEntry& Entry) { return Entry.Id == 0; });
+	if (OutReadBytes) *OutReadBytes = Offset;
+	return Entries;
+}
@@ -0,0 +1,156 @@
+// Copyright HAZE Blockchain.
+
+#include "HazePoolBook.h"
+#include "HazeEventStream.h"
+
+UHazePoolBook* UHazePoolBook::CreatePoolBook(UHazeClient* InClient)
+{
+	UHazePoolBook* Book = NewObject<UHazePoolBook>();
+	Book->Client = InClient;
+	return Book;
+}
+
+void UHazePoolBook::Refresh()
+{
+	if (!Client)
+	{
+		OnRefreshed.Broadcast(false);
+		return;
+	}
+	if (RefreshesInFlight++ == 0)
+	{
+		ChangedDuringRefresh.Reset();
+	}
+	Client->FetchLiquidityPools([WeakThis = TWeakObjectPtr<UHazePoolBook>(this)](bool bOk, const TArray<FLiquidityPool>& Fetched)
+	{
+		UHazePoolBook* This = WeakThis.Get();
+		if (!This) return;
+		This->RefreshesInFlight--;
+		if (bOk)
+		{
+			TMap<FString, FLiquidityPool> Next;
+			Next.Reserve(Fetched.Num());
+			for (const FLiquidityPool& Pool : Fetched)
+			{
+				const FLiquidityPool* Newer = This->ChangedDuringRefresh.Contains(Pool.PoolId) ? This->Pools.Find(Pool.PoolId) : nullptr;
+				Next.Add(Pool.PoolId, Newer ? *Newer : Pool);
+			}
+			// Created after the snapshot was taken
+			for (const FString& PoolId : This->ChangedDuringRefresh)
+			{
+				if (!Next.Contains(PoolId))
+				{
+					if (const FLiquidityPool* Pool = This->Pools.Find(PoolId)) Next.Add(PoolId, *Pool);
+				}
+			}
+			This->Pools = MoveTemp(Next);
+			This->Revision++;
+			for (const TPair<FString, FLiquidityPool>& Pair : This->Pools)
+			{
+				This->OnPoolUpdated.Broadcast(Pair.Value);
+			}
+		}
+		if (This->RefreshesInFlight == 0)
+		{
+			This->ChangedDuringRefresh.Reset();
+		}
+		This->OnRefreshed.Broadcast(bOk);
+	});
+}
+
+void UHazePoolBook::RefreshPool(const FString& PoolId)
+{
+	if (!Client) return;
+	Client->FetchLiquidityPool(PoolId, [WeakThis = TWeakObjectPtr<UHazePoolBook>(this)](bool bOk, const FLiquidityPool& Pool)
+	{
+		if (UHazePoolBook* This = WeakThis.Get())
+		{
+			if (bOk) This->ApplyPool(Pool);
+		}
+	});
+}
+
+void UHazePoolBook::BindEventStream(UHazeEventStream* Stream)
+{
+	if (Stream)
+	{
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = EHazeStreamEventType::PoolUpdated;
+		Stream->Subscribe(Subscription);
+		Stream->OnEventNative().AddUObject(this, &UHazePoolBook::HandleStreamEvent);
+	}
+}
+
+void UHazePoolBook::HandleStreamEvent(const FHazeStreamEvent& Event)
+{
+	if (Event.Type == EHazeStreamEventType::PoolUpdated && !Event.Pool.PoolId.IsEmpty())
+	{
+		ApplyPool(Event.Pool);
+	}
+}
+
+void UHazePoolBook::ApplyPool(const FLiquidityPool& Pool)
+{
+	Pools.Add(Pool.PoolId, Pool);
+	if (RefreshesInFlight > 0)
+	{
+		ChangedDuringRefresh.Add(Pool.PoolId);
+	}
+	Revision++;
+	OnPoolUpdated.Broadcast(Pool);
+}
+
+bool UHazePoolBook::GetPool(const FString& PoolId, FLiquidityPool& OutPool) const
+{
+	if (const FLiquidityPool* Pool = Pools.Find(PoolId))
+	{
+		OutPool = *Pool;
+		return true;
+	}
+	return false;
+}
+
+bool UHazePoolBook::FindPool(const FString& AssetA, const FString& AssetB, FLiquidityPool& OutPool) const
+{
+	// Pool ids are "pool:{asset1}:{asset2}" in creation order
+	return GetPool(FString::Printf(TEXT("pool:%s:%s"), *AssetA, *AssetB), OutPool)
+		|| GetPool(FString::Printf(TEXT("pool:%s:%s"), *AssetB, *AssetA), OutPool);
+}
+
+TArray<FLiquidityPool> UHazePoolBook::GetPools() const
+{
+	TArray<FLiquidityPool> Out;
+	Pools.GenerateValueArray(Out);
+	return Out;
+}
+
+FHazeSwapQuote UHazePoolBook::QuoteSwap(const FString& PoolId, const FString& AssetIn, const FHazeAmount& AmountIn) const
+{
+	FHazeSwapQuote Quote;
+	if (const FLiquidityPool* Pool = Pools.Find(PoolId))
+	{
+		FHazeAmm::QuoteExactIn(*Pool, AssetIn, AmountIn, Quote);
+	}
+	else
+	{
+		Quote.PoolId = PoolId;
+		Quote.AssetIn = AssetIn;
+		Quote.AmountIn = AmountIn;
+	}
+	return Quote;
+}
+
+FHazeSwapQuote UHazePoolBook::QuoteSwapForOutput(const FString& PoolId, const FString& AssetIn, const FHazeAmount& AmountOut) const
+{
+	FHazeSwapQuote Quote;
+	if (const FLiquidityPool* Pool = Pools.Find(PoolId))
+	{
+		FHazeAmm::QuoteExactOut(*Pool, AssetIn, AmountOut, Quote);
+	}
+	else
+	{
+		Quote.PoolId = PoolId;
+		Quote.AssetIn = AssetIn;
+	}
+	return Quote;
+}
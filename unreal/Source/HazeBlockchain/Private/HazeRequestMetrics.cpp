@@ -0,0 +1,144 @@
+// Copyright HAZE Blockchain. Per-endpoint request latency and in-flight tracking.
+
+#include "HazeRequestMetrics.h"
+#include "HazeStats.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+TRACE_DECLARE_INT_COUNTER(HazeRequestsInFlight, TEXT("Haze/RequestsInFlight"));
+TRACE_DECLARE_FLOAT_COUNTER(HazeLastLatencyMs, TEXT("Haze/LastRequestMs"));
+
+const float FHazeRequestMetrics::BucketUpperMs[NumBuckets] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, MAX_flt };
+
+void FHazeRequestTrace::MarkSent()
+{
+	if (State) State->Sent = FPlatformTime::Seconds();
+}
+
+void FHazeRequestTrace::MarkFirstByte()
+{
+	if (State && State->FirstByte == 0.0) State->FirstByte = FPlatformTime::Seconds();
+}
+
+void FHazeRequestTrace::MarkCompleted(int64 BytesReceived)
+{
+	if (!State) return;
+	State->Completed = FPlatformTime::Seconds();
+	State->Bytes = BytesReceived;
+	INC_DWORD_STAT_BY(STAT_HazeBytesReceived, BytesReceived);
+}
+
+void FHazeRequestTrace::MarkParsed()
+{
+	if (State) State->Parsed = FPlatformTime::Seconds();
+}
+
+void FHazeRequestTrace::Finish(bool bOk)
+{
+	if (!State || State->bFinished) return;
+	State->bFinished = true;
+	if (TSharedPtr<FHazeRequestMetrics, ESPMode::ThreadSafe> Metrics = State->Metrics.Pin())
+	{
+		Metrics->Record(*State, bOk, FPlatformTime::Seconds());
+	}
+}
+
+FHazeRequestTrace FHazeRequestMetrics::Begin(EHazeEndpoint Endpoint)
+{
+	FHazeRequestTrace Trace;
+	Trace.State = MakeShared<FHazeRequestTrace::FState, ESPMode::ThreadSafe>();
+	Trace.State->Endpoint = Endpoint;
+	Trace.State->Metrics = AsShared();
+	Trace.State->Queued = FPlatformTime::Seconds();
+
+	Endpoints[static_cast<int32>(Endpoint)].InFlight++;
+	TotalInFlight++;
+	INC_DWORD_STAT(STAT_HazeRequestsInFlight);
+	TRACE_COUNTER_SET(HazeRequestsInFlight, TotalInFlight);
+	return Trace;
+}
+
+void FHazeRequestMetrics::Record(const FHazeRequestTrace::FState& State, bool bOk, double Now)
+{
+	FEndpoint& E = Endpoints[static_cast<int32>(State.Endpoint)];
+	E.InFlight--;
+	TotalInFlight--;
+	DEC_DWORD_STAT(STAT_HazeRequestsInFlight);
+	INC_DWORD_STAT(STAT_HazeRequestsCompleted);
+	TRACE_COUNTER_SET(HazeRequestsInFlight, TotalInFlight);
+
+	// Stages that were never reached (transport failure) count as zero
+	const double Sent = State.Sent > 0.0 ? State.Sent : State.Queued;
+	const double FirstByte = State.FirstByte > 0.0 ? State.FirstByte : Sent;
+	const double Completed = State.Completed > 0.0 ? State.Completed : FirstByte;
+	const double Parsed = State.Parsed > 0.0 ? State.Parsed : Completed;
+	const double Total = Now - Sent;
+
+	E.Completed++;
+	if (!bOk) E.Failed++;
+	E.Bytes += State.Bytes;
+	E.TotalSeconds += Total;
+	E.QueuedSeconds += Sent - State.Queued;
+	E.FirstByteSeconds += FirstByte - Sent;
+	E.TransferSeconds += Completed - FirstByte;
+	E.ParseSeconds += Parsed - Completed;
+	E.DispatchSeconds += Now - Parsed;
+
+	const float TotalMs = static_cast<float>(Total * 1000.0);
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && TotalMs > BucketUpperMs[Bucket]) Bucket++;
+	E.Buckets[Bucket]++;
+	TRACE_COUNTER_SET(HazeLastLatencyMs, TotalMs);
+}
+
+FHazeEndpointStats FHazeRequestMetrics::GetStats(EHazeEndpoint Endpoint) const
+{
+	FHazeEndpointStats Stats;
+	if (Endpoint >= EHazeEndpoint::Count) return Stats;
+	const FEndpoint& E = Endpoints[static_cast<int32>(Endpoint)];
+	Stats.InFlight = E.InFlight;
+	Stats.Completed = E.Completed;
+	Stats.Failed = E.Failed;
+	Stats.BytesReceived = E.Bytes;
+	if (E.Completed == 0) return Stats;
+
+	const double ToAverageMs = 1000.0 / E.Completed;
+	Stats.AverageMs = static_cast<float>(E.TotalSeconds * ToAverageMs);
+	Stats.QueuedMs = static_cast<float>(E.QueuedSeconds * ToAverageMs);
+	Stats.FirstByteMs = static_cast<float>(E.FirstByteSeconds * ToAverageMs);
+	Stats.TransferMs = static_cast<float>(E.TransferSeconds * ToAverageMs);
+	Stats.ParseMs = static_cast<float>(E.ParseSeconds * ToAverageMs);
+	Stats.DispatchMs = static_cast<float>(E.DispatchSeconds * ToAverageMs);
+
+	auto Percentile = [&E](double Fraction)
+	{
+		const double Target = Fraction * E.Completed;
+		int64 Seen = 0;
+		for (int32 i = 0; i < NumBuckets; i++)
+		{
+			Seen += E.Buckets[i];
+			// The open last bucket reports the largest finite bound
+			if (Seen >= Target) return BucketUpperMs[FMath::Min(i, NumBuckets - 2)];
+		}
+		return BucketUpperMs[NumBuckets - 2];
+	};
+	Stats.P50Ms = Percentile(0.50);
+	Stats.P95Ms = Percentile(0.95);
+	Stats.P99Ms = Percentile(0.99);
+	return Stats;
+}
+
+TArrayView<const uint32> FHazeRequestMetrics::GetHistogram(EHazeEndpoint Endpoint) const
+{
+	if (Endpoint >= EHazeEndpoint::Count) return TArrayView<const uint32>();
+	return MakeArrayView(Endpoints[static_cast<int32>(Endpoint)].Buckets, NumBuckets);
+}
+
+void FHazeRequestMetrics::Reset()
+{
+	for (FEndpoint& E : Endpoints)
+	{
+		const int32 InFlight = E.InFlight;
+		E = FEndpoint();
+		E.InFlight = InFlight;
+	}
+}
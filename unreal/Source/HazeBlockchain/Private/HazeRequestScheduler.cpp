@@ -0,0 +1,187 @@
+// Copyright HAZE Blockchain. Priority classes and concurrency budgets for a client's requests.
+
+#include "HazeRequestScheduler.h"
+
+namespace
+{
+	/** Budgets until the client sets its own (UHazeClient::MaxCriticalRequests and the rest) */
+	constexpr int32 DefaultBudgets[] = { 8, 6, 2 };
+	static_assert(UE_ARRAY_COUNT(DefaultBudgets) == static_cast<int32>(EHazeRequestPriority::Count), "One budget per class");
+}
+
+EHazeRequestPriority FHazeRequestScheduler::DefaultPriority(EHazeEndpoint Endpoint)
+{
+	switch (Endpoint)
+	{
+	case EHazeEndpoint::SubmitTransaction:
+	case EHazeEndpoint::SubmitTransactionBatch:
+	case EHazeEndpoint::Transaction:
+		return EHazeRequestPriority::Critical;
+	case EHazeEndpoint::AssetBlobRef:
+	case EHazeEndpoint::AssetBlob:
+	case EHazeEndpoint::AssetVersions:
+	case EHazeEndpoint::AssetHistory:
+	case EHazeEndpoint::AssetSnapshot:
+		return EHazeRequestPriority::Background;
+	default:
+		return EHazeRequestPriority::Interactive;
+	}
+}
+
+FHazeRequestScheduler::FHazeRequestScheduler()
+{
+	for (int32 i = 0; i < UE_ARRAY_COUNT(Classes); i++)
+	{
+		Classes[i].Budget = DefaultBudgets[i];
+	}
+}
+
+void FHazeRequestScheduler::SetBudget(EHazeRequestPriority Priority, int32 MaxInFlight)
+{
+	if (Priority >= EHazeRequestPriority::Count) return;
+	FClass& Class = Classes[static_cast<int32>(Priority)];
+	const int32 Budget = FMath::Max(MaxInFlight, 1);
+	if (Class.Budget == Budget) return;
+	// A lowered budget takes effect as requests finish; nothing in flight is interrupted
+	Class.Budget = Budget;
+	Pump();
+}
+
+int32 FHazeRequestScheduler::GetBudget(EHazeRequestPriority Priority) const
+{
+	return Priority < EHazeRequestPriority::Count ? Classes[static_cast<int32>(Priority)].Budget : 0;
+}
+
+uint64 FHazeRequestScheduler::Enqueue(EHazeRequestPriority Priority, const FString& SupersedeKey, TFunction<void(uint64 Ticket)> Start,
+	TFunction<void()> OnSuperseded)
+{
+	if (Priority >= EHazeRequestPriority::Count) Priority = EHazeRequestPriority::Interactive;
+	const uint64 Ticket = NextTicket++;
+
+	TArray<TFunction<void()>> Superseded;
+	if (!SupersedeKey.IsEmpty())
+	{
+		for (FClass& Class : Classes)
+		{
+			for (int32 i = Class.Queue.Num() - 1; i >= 0; i--)
+			{
+				if (Class.Queue[i].SupersedeKey != SupersedeKey) continue;
+				if (Class.Queue[i].OnSuperseded) Superseded.Add(MoveTemp(Class.Queue[i].OnSuperseded));
+				Class.Queue.RemoveAt(i);
+			}
+		}
+	}
+
+	FQueued& Queued = Classes[static_cast<int32>(Priority)].Queue.AddDefaulted_GetRef();
+	Queued.Ticket = Ticket;
+	Queued.SupersedeKey = SupersedeKey;
+	Queued.Start = MoveTemp(Start);
+	Queued.OnSuperseded = MoveTemp(OnSuperseded);
+
+	for (TFunction<void()>& Callback : Superseded)
+	{
+		Callback();
+	}
+	Pump();
+	return Ticket;
+}
+
+void FHazeRequestScheduler::Finish(uint64 Ticket)
+{
+	EHazeRequestPriority Priority;
+	if (!Running.RemoveAndCopyValue(Ticket, Priority)) return;
+	Classes[static_cast<int32>(Priority)].InFlight--;
+	Pump();
+}
+
+void FHazeRequestScheduler::Promote(uint64 Ticket, EHazeRequestPriority Priority)
+{
+	if (Priority >= EHazeRequestPriority::Count) return;
+	int32 From = 0;
+	FQueued* Queued = FindQueued(Ticket, From);
+	const int32 To = static_cast<int32>(Priority);
+	if (!Queued || To >= From) return;
+	// Behind the requests already waiting in the more urgent class, ahead of none of them
+	FQueued Moved = MoveTemp(*Queued);
+	Classes[From].Queue.RemoveAll([Ticket](const FQueued& Entry) { return Entry.Ticket == Ticket; });
+	Classes[To].Queue.Add(MoveTemp(Moved));
+	Pump();
+}
+
+void FHazeRequestScheduler::Share(uint64 Ticket)
+{
+	int32 Class = 0;
+	if (FQueued* Queued = FindQueued(Ticket, Class))
+	{
+		Queued->SupersedeKey.Reset();
+	}
+}
+
+FHazeRequestScheduler::FQueued* FHazeRequestScheduler::FindQueued(uint64 Ticket, int32& OutClass)
+{
+	for (int32 i = 0; i < UE_ARRAY_COUNT(Classes); i++)
+	{
+		for (FQueued& Queued : Classes[i].Queue)
+		{
+			if (Queued.Ticket == Ticket)
+			{
+				OutClass = i;
+				return &Queued;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void FHazeRequestScheduler::CancelQueued()
+{
+	TArray<TFunction<void()>> Cancelled;
+	for (FClass& Class : Classes)
+	{
+		for (FQueued& Queued : Class.Queue)
+		{
+			if (Queued.OnSuperseded) Cancelled.Add(MoveTemp(Queued.OnSuperseded));
+		}
+		Class.Queue.Reset();
+	}
+	for (TFunction<void()>& Callback : Cancelled)
+	{
+		Callback();
+	}
+}
+
+void FHazeRequestScheduler::Pump()
+{
+	if (bPumping) return;
+	TGuardValue<bool> Guard(bPumping, true);
+
+	// After every start look again from the most urgent class: Start may have enqueued or finished requests
+	bool bStarted = true;
+	while (bStarted)
+	{
+		bStarted = false;
+		for (int32 i = 0; i < UE_ARRAY_COUNT(Classes); i++)
+		{
+			FClass& Class = Classes[i];
+			if (Class.Queue.Num() == 0 || Class.InFlight >= Class.Budget) continue;
+
+			FQueued Next = MoveTemp(Class.Queue[0]);
+			Class.Queue.RemoveAt(0);
+			Class.InFlight++;
+			Running.Add(Next.Ticket, static_cast<EHazeRequestPriority>(i));
+			Next.Start(Next.Ticket);
+			bStarted = true;
+			break;
+		}
+	}
+}
+
+int32 FHazeRequestScheduler::GetInFlight(EHazeRequestPriority Priority) const
+{
+	return Priority < EHazeRequestPriority::Count ? Classes[static_cast<int32>(Priority)].InFlight : 0;
+}
+
+int32 FHazeRequestScheduler::GetQueued(EHazeRequestPriority Priority) const
+{
+	return Priority < EHazeRequestPriority::Count ? Classes[static_cast<int32>(Priority)].Queue.Num() : 0;
+}
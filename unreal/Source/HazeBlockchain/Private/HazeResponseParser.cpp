@@ -0,0 +1,1105 @@
+// Copyright HAZE Blockchain. Typed decoding of HAZE REST responses.
+
+#include "HazeResponseParser.h"
+#include "HazeAssetPage.h"
+#include "HazeHex.h"
+#include "HazeBincode.h"
+#include "Containers/StringConv.h"
+
+namespace HazeResponse
+{
+	namespace
+	{
+		bool ReadDataObject(TJsonReader<TCHAR>& Reader, FDataFieldFn OnDataField)
+		{
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					OnDataField(Reader.GetIdentifier(), Notation, Reader);
+					break;
+				}
+			}
+			return false;
+		}
+
+		bool ReadDataArray(TJsonReader<TCHAR>& Reader, FDataElementFn OnDataElement)
+		{
+			int32 Index = -1;
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				switch (Notation)
+				{
+				case EJsonNotation::ArrayEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+				{
+					++Index;
+					const bool bOk = ReadDataObject(Reader, [&](const FString& Field, EJsonNotation FieldNotation, const TJsonReader<TCHAR>& FieldReader)
+					{
+						OnDataElement(Index, Field, FieldNotation, FieldReader);
+					});
+					if (!bOk) return false;
+					break;
+				}
+				case EJsonNotation::ArrayStart:
+					++Index;
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					OnDataElement(++Index, FString(), Notation, Reader);
+					break;
+				}
+			}
+			return false;
+		}
+
+		bool ReadStringArray(TJsonReader<TCHAR>& Reader, TArray<FString>& Out)
+		{
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				switch (Notation)
+				{
+				case EJsonNotation::ArrayEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					Out.Add(ScalarAsString(Notation, Reader));
+					break;
+				}
+			}
+			return false;
+		}
+
+		EDensityLevel DensityFromName(const FString& Name)
+		{
+			if (Name == TEXT("Light")) return EDensityLevel::Light;
+			if (Name == TEXT("Dense")) return EDensityLevel::Dense;
+			if (Name == TEXT("Core")) return EDensityLevel::Core;
+			return EDensityLevel::Ethereal;
+		}
+
+		/** Scalar fields of the object just opened, until its end (nested values skipped) */
+		bool ReadStringMap(TJsonReader<TCHAR>& Reader, TMap<FString, FString>& Out)
+		{
+			return ReadDataObject(Reader, [&Out](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& FieldReader)
+			{
+				Out.Add(Field, ScalarAsString(Notation, FieldReader));
+			});
+		}
+
+		bool ReadAttributes(TJsonReader<TCHAR>& Reader, TArray<FHazeAssetAttribute>& Out)
+		{
+			return ReadDataArray(Reader, [&Out](int32 Index, const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& FieldReader)
+			{
+				if (Index >= Out.Num()) Out.SetNum(Index + 1);
+				FHazeAssetAttribute& Attribute = Out[Index];
+				if (Field == TEXT("name")) Attribute.Name = ScalarAsString(Notation, FieldReader);
+				else if (Field == TEXT("value")) Attribute.Value = ScalarAsString(Notation, FieldReader);
+				else if (Field == TEXT("rarity") && Notation == EJsonNotation::Number) Attribute.Rarity = static_cast<float>(FieldReader.GetValueAsNumber());
+			});
+		}
+
+		/** The asset object just opened (full or summary view), until its end */
+		bool ReadAssetObject(TJsonReader<TCHAR>& Reader, FHazeAssetInfo& Out)
+		{
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				const FString& Field = Reader.GetIdentifier();
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					if (!Out.bIsSummary) Out.AttributeCount = Out.Attributes.Num();
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (Field == TEXT("metadata"))
+					{
+						if (!ReadStringMap(Reader, Out.Metadata)) return false;
+					}
+					else if (Field == TEXT("blob_refs"))
+					{
+						if (!ReadStringMap(Reader, Out.BlobRefs)) return false;
+					}
+					else if (!Reader.SkipObject())
+					{
+						return false;
+					}
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!(Field == TEXT("attributes") ? ReadAttributes(Reader, Out.Attributes) : Reader.SkipArray())) return false;
+					break;
+				default:
+					if (Field == TEXT("asset_id")) Out.AssetId = ScalarAsString(Notation, Reader);
+					else if (Field == TEXT("owner")) Out.Owner = ScalarAsString(Notation, Reader);
+					else if (Field == TEXT("density")) Out.Density = DensityFromName(ScalarAsString(Notation, Reader));
+					else if (Field == TEXT("game_id")) Out.GameId = ScalarAsString(Notation, Reader);
+					else if (Field == TEXT("created_at")) Out.CreatedAt = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("updated_at")) Out.UpdatedAt = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("current_version")) Out.CurrentVersion = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("public_read")) Out.bPublicRead = Notation == EJsonNotation::Boolean && Reader.GetValueAsBoolean();
+					else if (Field == TEXT("metadata_bytes")) { Out.MetadataBytes = ScalarAsInt64(Notation, Reader); Out.bIsSummary = true; }
+					else if (Field == TEXT("metadata_truncated")) Out.bMetadataTruncated = Notation == EJsonNotation::Boolean && Reader.GetValueAsBoolean();
+					else if (Field == TEXT("attribute_count")) Out.AttributeCount = static_cast<int32>(ScalarAsInt64(Notation, Reader));
+					break;
+				}
+			}
+			return false;
+		}
+
+		/** Objects of the array just opened, each handed to OnObject right after its start; other elements skipped */
+		bool ReadObjectArray(TJsonReader<TCHAR>& Reader, TFunctionRef<bool(TJsonReader<TCHAR>& Reader)> OnObject)
+		{
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				switch (Notation)
+				{
+				case EJsonNotation::ArrayEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!OnObject(Reader)) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					break;
+				}
+			}
+			return false;
+		}
+
+		/** One entry of a ?since= versions response just opened, until its end */
+		bool ReadAssetVersionObject(TJsonReader<TCHAR>& Reader, FHazeAssetVersionDelta& Out)
+		{
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				const FString& Field = Reader.GetIdentifier();
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (Field == TEXT("metadata"))
+					{
+						if (!ReadStringMap(Reader, Out.Version.Metadata)) return false;
+					}
+					else if (Field == TEXT("blob_refs"))
+					{
+						if (!ReadStringMap(Reader, Out.Version.BlobRefs)) return false;
+					}
+					else if (!Reader.SkipObject())
+					{
+						return false;
+					}
+					break;
+				case EJsonNotation::ArrayStart:
+					if (Field == TEXT("attributes"))
+					{
+						if (!ReadAttributes(Reader, Out.Version.Attributes)) return false;
+					}
+					else if (!(Field == TEXT("removed_blob_refs") ? ReadStringArray(Reader, Out.RemovedBlobRefs) : Reader.SkipArray()))
+					{
+						return false;
+					}
+					break;
+				default:
+					if (Field == TEXT("version")) Out.Version.Version = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("timestamp")) Out.Version.Timestamp = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("density")) Out.Version.Density = DensityFromName(ScalarAsString(Notation, Reader));
+					else if (Field == TEXT("game_id")) Out.Version.GameId = ScalarAsString(Notation, Reader);
+					else if (Field == TEXT("blob_refs_base")) Out.BlobRefsBase = ScalarAsInt64(Notation, Reader);
+					break;
+				}
+			}
+			return false;
+		}
+
+		/** One history entry just opened, until its end */
+		bool ReadAssetHistoryObject(TJsonReader<TCHAR>& Reader, FHazeAssetHistoryEntry& Out)
+		{
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				const FString& Field = Reader.GetIdentifier();
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!(Field == TEXT("changes") ? ReadStringMap(Reader, Out.Changes) : Reader.SkipObject())) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					if (Field == TEXT("timestamp")) Out.Timestamp = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("action")) Out.Action = ScalarAsString(Notation, Reader);
+					break;
+				}
+			}
+			return false;
+		}
+
+		/** One entry of a snapshot staleness check just opened, until its end; a null fingerprint means removed */
+		bool ReadSnapshotStaleObject(TJsonReader<TCHAR>& Reader, FHazeSnapshotStaleEntry& Out)
+		{
+			Out.bRemoved = true;
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				const FString& Field = Reader.GetIdentifier();
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					if (Field == TEXT("asset_id"))
+					{
+						Out.AssetId = ScalarAsString(Notation, Reader);
+					}
+					else if (Field == TEXT("fingerprint") && Notation == EJsonNotation::String)
+					{
+						// 16 hex digits, most significant first
+						uint8 Digits[8];
+						if (!FHazeHex::Decode(Reader.GetValueAsString(), Digits, sizeof(Digits))) return false;
+						Out.Fingerprint = 0;
+						for (const uint8 Digit : Digits)
+						{
+							Out.Fingerprint = (Out.Fingerprint << 8) | Digit;
+						}
+						Out.bRemoved = false;
+					}
+					break;
+				}
+			}
+			return false;
+		}
+
+		/** One search result (summary view) just opened, into a new page entry */
+		bool ReadSearchEntry(TJsonReader<TCHAR>& Reader, FHazeAssetPage& Page, const FString& LabelKey)
+		{
+			const int32 Index = Page.AddEntry();
+			int64 CreatedAt = 0, UpdatedAt = 0;
+			int32 AttributeCount = 0, BlobCount = 0;
+			EJsonNotation Notation;
+			while (Reader.ReadNext(Notation))
+			{
+				const FString& Field = Reader.GetIdentifier();
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					Page.SetTimes(Index, CreatedAt, UpdatedAt);
+					Page.SetCounts(Index, AttributeCount, BlobCount);
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+				{
+					const bool bMetadata = Field == TEXT("metadata");
+					const bool bBlobRefs = Field == TEXT("blob_refs");
+					if (!bMetadata && !bBlobRefs)
+					{
+						if (!Reader.SkipObject()) return false;
+						break;
+					}
+					// Only the label survives; the rest of the metadata is never copied out of the reader
+					const bool bRead = ReadDataObject(Reader, [&](const FString& Key, EJsonNotation ValueNotation, const TJsonReader<TCHAR>& ValueReader)
+					{
+						if (bBlobRefs) BlobCount++;
+						else if (Key == LabelKey) Page.SetLabel(Index, ScalarAsString(ValueNotation, ValueReader));
+					});
+					if (!bRead) return false;
+					break;
+				}
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				case EJsonNotation::String:
+					if (Field == TEXT("asset_id"))
+					{
+						if (!FHazeHex::Decode(Reader.GetValueAsString(), Page.GetMutableAssetId(Index), FHazeAssetPage::IdSize)) return false;
+					}
+					else if (Field == TEXT("owner"))
+					{
+						if (!FHazeHex::Decode(Reader.GetValueAsString(), Page.GetMutableOwner(Index), FHazeAssetPage::IdSize)) return false;
+					}
+					else if (Field == TEXT("density")) Page.SetDensity(Index, DensityFromName(Reader.GetValueAsString()));
+					else if (Field == TEXT("game_id")) Page.SetGameId(Index, Reader.GetValueAsString());
+					else if (Field == TEXT("created_at")) CreatedAt = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("updated_at")) UpdatedAt = ScalarAsInt64(Notation, Reader);
+					break;
+				default:
+					if (Field == TEXT("created_at")) CreatedAt = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("updated_at")) UpdatedAt = ScalarAsInt64(Notation, Reader);
+					else if (Field == TEXT("attribute_count")) AttributeCount = static_cast<int32>(ScalarAsInt64(Notation, Reader));
+					break;
+				}
+			}
+			return false;
+		}
+
+		struct FStreamEventName
+		{
+			const TCHAR* Name;
+			EHazeStreamEventType Type;
+		};
+
+		constexpr FStreamEventName StreamEventNames[] =
+		{
+			{ TEXT("asset_created"), EHazeStreamEventType::AssetCreated },
+			{ TEXT("asset_updated"), EHazeStreamEventType::AssetUpdated },
+			{ TEXT("asset_condensed"), EHazeStreamEventType::AssetCondensed },
+			{ TEXT("asset_evaporated"), EHazeStreamEventType::AssetEvaporated },
+			{ TEXT("asset_merged"), EHazeStreamEventType::AssetMerged },
+			{ TEXT("asset_split"), EHazeStreamEventType::AssetSplit },
+			{ TEXT("asset_permission_changed"), EHazeStreamEventType::AssetPermissionChanged },
+			{ TEXT("asset_attribute_updated"), EHazeStreamEventType::AssetAttributeUpdated },
+			{ TEXT("asset_version_created"), EHazeStreamEventType::AssetVersionCreated },
+			{ TEXT("block_applied"), EHazeStreamEventType::BlockApplied },
+			{ TEXT("error"), EHazeStreamEventType::Error },
+			{ TEXT("pool_updated"), EHazeStreamEventType::PoolUpdated },
+		};
+
+		/** One field of a pool object (REST or pool_updated); false if it is not a pool field */
+		bool ReadPoolField(const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader, FLiquidityPool& Out)
+		{
+			if (Field == TEXT("pool_id")) Out.PoolId = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("asset1")) Out.Asset1 = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("asset2")) Out.Asset2 = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("reserve1")) Out.Reserve1 = ScalarAsAmount(Notation, Reader);
+			else if (Field == TEXT("reserve2")) Out.Reserve2 = ScalarAsAmount(Notation, Reader);
+			else if (Field == TEXT("fee_rate")) Out.FeeRate = static_cast<int32>(ScalarAsInt64(Notation, Reader));
+			else if (Field == TEXT("total_liquidity")) Out.TotalLiquidity = ScalarAsAmount(Notation, Reader);
+			else return false;
+			return true;
+		}
+
+		bool ReadEnvelopeImpl(TArrayView<const uint8> Body, bool& bOutSuccess, const FDataFieldFn* OnDataField, const FDataElementFn* OnDataElement,
+			const FDataValueFn* OnDataValue = nullptr)
+		{
+			bOutSuccess = false;
+			if (Body.Num() == 0) return false;
+
+			FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+			TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(FStringView(Text.Get(), Text.Length()));
+
+			EJsonNotation Notation;
+			if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart) return false;
+
+			while (Reader->ReadNext(Notation))
+			{
+				const bool bIsData = Reader->GetIdentifier() == TEXT("data");
+				if (bIsData && OnDataValue && Notation != EJsonNotation::ObjectEnd && Notation != EJsonNotation::Error)
+				{
+					if (!(*OnDataValue)(Notation, *Reader)) return false;
+					continue;
+				}
+				switch (Notation)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!(bIsData && OnDataField ? ReadDataObject(*Reader, *OnDataField) : Reader->SkipObject())) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!(bIsData && OnDataElement ? ReadDataArray(*Reader, *OnDataElement) : Reader->SkipArray())) return false;
+					break;
+				case EJsonNotation::Boolean:
+					if (Reader->GetIdentifier() == TEXT("success"))
+					{
+						bOutSuccess = Reader->GetValueAsBoolean();
+					}
+					else if (bIsData && OnDataField)
+					{
+						(*OnDataField)(FString(), Notation, *Reader);
+					}
+					break;
+				default:
+					if (bIsData && OnDataField)
+					{
+						(*OnDataField)(FString(), Notation, *Reader);
+					}
+					break;
+				}
+			}
+			return false;
+		}
+	}
+
+	bool ReadEnvelope(TArrayView<const uint8> Body, bool& bOutSuccess, FDataFieldFn OnDataField)
+	{
+		return ReadEnvelopeImpl(Body, bOutSuccess, &OnDataField, nullptr);
+	}
+
+	bool ReadEnvelopeArray(TArrayView<const uint8> Body, bool& bOutSuccess, FDataElementFn OnDataElement)
+	{
+		return ReadEnvelopeImpl(Body, bOutSuccess, nullptr, &OnDataElement);
+	}
+
+	bool ReadEnvelopeValue(TArrayView<const uint8> Body, bool& bOutSuccess, FDataValueFn OnDataValue)
+	{
+		return ReadEnvelopeImpl(Body, bOutSuccess, nullptr, nullptr, &OnDataValue);
+	}
+
+	FString ScalarAsString(EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::String: return Reader.GetValueAsString();
+		case EJsonNotation::Number: return Reader.GetValueAsNumberString();
+		case EJsonNotation::Boolean: return Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+		default: return FString();
+		}
+	}
+
+	int64 ScalarAsInt64(EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::String: return FCString::Atoi64(*Reader.GetValueAsString());
+		case EJsonNotation::Number: return FCString::Atoi64(*Reader.GetValueAsNumberString());
+		default: return 0;
+		}
+	}
+
+	FHazeAmount ScalarAsAmount(EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+	{
+		FHazeAmount Amount;
+		switch (Notation)
+		{
+		case EJsonNotation::String: FHazeAmount::Parse(Reader.GetValueAsString(), Amount); break;
+		case EJsonNotation::Number: FHazeAmount::Parse(Reader.GetValueAsNumberString(), Amount); break;
+		default: break;
+		}
+		return Amount;
+	}
+
+	bool ParseHealth(TArrayView<const uint8> Body, FString& OutHealth)
+	{
+		bool bSuccess = false;
+		bool bHasData = false;
+		const bool bOk = ReadEnvelope(Body, bSuccess, [&](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Field.IsEmpty())
+			{
+				OutHealth = ScalarAsString(Notation, Reader);
+				bHasData = true;
+			}
+		});
+		if (!bOk || !bHasData)
+		{
+			// Non-envelope health endpoints: report the raw body
+			OutHealth = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num()));
+		}
+		return true;
+	}
+
+	bool ParseBlockchainInfo(TArrayView<const uint8> Body, FBlockchainInfo& OutInfo)
+	{
+		bool bSuccess = false;
+		return ReadEnvelope(Body, bSuccess, [&](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Field == TEXT("current_height")) OutInfo.CurrentHeight = ScalarAsInt64(Notation, Reader);
+			else if (Field == TEXT("total_supply")) OutInfo.TotalSupply = ScalarAsAmount(Notation, Reader);
+			else if (Field == TEXT("current_wave")) OutInfo.CurrentWave = ScalarAsInt64(Notation, Reader);
+			else if (Field == TEXT("state_root")) OutInfo.StateRoot = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("last_finalized_height")) OutInfo.LastFinalizedHeight = ScalarAsInt64(Notation, Reader);
+			else if (Field == TEXT("last_finalized_wave")) OutInfo.LastFinalizedWave = ScalarAsInt64(Notation, Reader);
+		}) && bSuccess;
+	}
+
+	bool ParseBalance(TArrayView<const uint8> Body, FHazeAmount& OutBalance)
+	{
+		bool bSuccess = false;
+		return ReadEnvelope(Body, bSuccess, [&](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Field.IsEmpty()) OutBalance = ScalarAsAmount(Notation, Reader);
+		}) && bSuccess;
+	}
+
+	bool ParseAccount(TArrayView<const uint8> Body, FAccountInfo& OutInfo)
+	{
+		bool bSuccess = false;
+		return ReadEnvelope(Body, bSuccess, [&](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Field == TEXT("balance")) OutInfo.Balance = ScalarAsAmount(Notation, Reader);
+			else if (Field == TEXT("nonce")) OutInfo.Nonce = static_cast<int32>(ScalarAsInt64(Notation, Reader));
+			else if (Field == TEXT("staked")) OutInfo.Staked = ScalarAsAmount(Notation, Reader);
+		}) && bSuccess;
+	}
+
+	bool ParseTransaction(TArrayView<const uint8> Body, FTransactionResponse& OutResponse)
+	{
+		bool bSuccess = false;
+		FTransactionResponse Parsed;
+		const bool bOk = ReadEnvelope(Body, bSuccess, [&](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Field == TEXT("hash")) Parsed.Hash = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("status")) Parsed.Status = ScalarAsString(Notation, Reader);
+		});
+		if (!bOk || !bSuccess) return false;
+		OutResponse = MoveTemp(Parsed);
+		return true;
+	}
+
+	bool ParseTransactionBatch(TArrayView<const uint8> Body, TArray<FBatchTransactionResult>& OutResults)
+	{
+		bool bSuccess = false;
+		const bool bOk = ReadEnvelopeArray(Body, bSuccess, [&](int32 Index, const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Index >= OutResults.Num()) OutResults.SetNum(Index + 1);
+			FBatchTransactionResult& Result = OutResults[Index];
+			if (Field == TEXT("hash")) Result.Hash = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("status")) Result.Status = ScalarAsString(Notation, Reader);
+			else if (Field == TEXT("error")) Result.Error = ScalarAsString(Notation, Reader);
+		});
+		return bOk && bSuccess;
+	}
+
+	bool ParseTransactionBinary(TArrayView<const uint8> Body, FTransactionResponse& OutResponse)
+	{
+		// ApiResponse<TransactionResponse { hash, status }>
+		FHazeBincodeReader R(Body);
+		const bool bSuccess = R.ReadBool();
+		FTransactionResponse Parsed;
+		if (R.ReadSome())
+		{
+			Parsed.Hash = R.ReadString();
+			Parsed.Status = R.ReadString();
+		}
+		R.ReadOptionString();
+		if (!R.IsDone() || !bSuccess) return false;
+		OutResponse = MoveTemp(Parsed);
+		return true;
+	}
+
+	bool ParseTransactionBatchBinary(TArrayView<const uint8> Body, TArray<FBatchTransactionResult>& OutResults)
+	{
+		// ApiResponse<Vec<BatchTransactionResult { hash: Option, status, error: Option }>>
+		FHazeBincodeReader R(Body);
+		const bool bSuccess = R.ReadBool();
+		if (R.ReadSome())
+		{
+			// Smallest entry: None, empty status (u64 length), None
+			const int32 Num = R.ReadLength(1 + 8 + 1);
+			OutResults.SetNum(Num);
+			for (FBatchTransactionResult& Result : OutResults)
+			{
+				Result.Hash = R.ReadOptionString();
+				Result.Status = R.ReadString();
+				Result.Error = R.ReadOptionString();
+			}
+		}
+		R.ReadOptionString();
+		return R.IsDone() && bSuccess;
+	}
+
+	bool ParseAsset(TArrayView<const uint8> Body, FHazeAssetInfo& OutAsset)
+	{
+		bool bSuccess = false;
+		bool bHasAsset = false;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation == EJsonNotation::ObjectStart)
+			{
+				bHasAsset = true;
+				return ReadAssetObject(Reader, OutAsset);
+			}
+			return Notation != EJsonNotation::ArrayStart || Reader.SkipArray();
+		});
+		return bOk && bSuccess && bHasAsset;
+	}
+
+	bool ParseAssetSummaries(TArrayView<const uint8> Body, TArray<FHazeAssetInfo>& OutAssets)
+	{
+		bool bSuccess = false;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation != EJsonNotation::ArrayStart)
+			{
+				return Notation != EJsonNotation::ObjectStart || Reader.SkipObject();
+			}
+			EJsonNotation Element;
+			while (Reader.ReadNext(Element))
+			{
+				switch (Element)
+				{
+				case EJsonNotation::ArrayEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!ReadAssetObject(Reader, OutAssets.AddDefaulted_GetRef())) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					OutAssets.AddDefaulted();
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					// null: unknown asset (AssetId stays empty)
+					OutAssets.AddDefaulted();
+					break;
+				}
+			}
+			return false;
+		});
+		return bOk && bSuccess;
+	}
+
+	bool ParseAssetSearchPage(TArrayView<const uint8> Body, FHazeAssetPage& OutPage, const FString& LabelKey)
+	{
+		bool bSuccess = false;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation != EJsonNotation::ArrayStart)
+			{
+				return Notation != EJsonNotation::ObjectStart || Reader.SkipObject();
+			}
+			EJsonNotation Element;
+			while (Reader.ReadNext(Element))
+			{
+				switch (Element)
+				{
+				case EJsonNotation::ArrayEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!ReadSearchEntry(Reader, OutPage, LabelKey)) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!Reader.SkipArray()) return false;
+					break;
+				default:
+					break;
+				}
+			}
+			return false;
+		});
+		return bOk && bSuccess;
+	}
+
+	bool ParseAssetVersionsPage(TArrayView<const uint8> Body, FHazeAssetVersionsPage& OutPage)
+	{
+		bool bSuccess = false;
+		bool bHasPage = false;
+		FHazeAssetVersionsPage Page;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation != EJsonNotation::ObjectStart)
+			{
+				return Notation != EJsonNotation::ArrayStart || Reader.SkipArray();
+			}
+			bHasPage = true;
+			EJsonNotation Field;
+			while (Reader.ReadNext(Field))
+			{
+				const FString& Name = Reader.GetIdentifier();
+				switch (Field)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (Name != TEXT("versions"))
+					{
+						if (!Reader.SkipArray()) return false;
+						break;
+					}
+					if (!ReadObjectArray(Reader, [&Page](TJsonReader<TCHAR>& VersionReader)
+					{
+						return ReadAssetVersionObject(VersionReader, Page.Versions.AddDefaulted_GetRef());
+					}))
+					{
+						return false;
+					}
+					break;
+				default:
+					if (Name == TEXT("since")) Page.Since = ScalarAsInt64(Field, Reader);
+					else if (Name == TEXT("current_version")) Page.CurrentVersion = ScalarAsInt64(Field, Reader);
+					break;
+				}
+			}
+			return false;
+		});
+		if (!bOk || !bSuccess || !bHasPage) return false;
+		OutPage = MoveTemp(Page);
+		return true;
+	}
+
+	bool ParseAssetHistoryPage(TArrayView<const uint8> Body, FHazeAssetHistoryPage& OutPage)
+	{
+		bool bSuccess = false;
+		bool bHasPage = false;
+		FHazeAssetHistoryPage Page;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation != EJsonNotation::ObjectStart)
+			{
+				return Notation != EJsonNotation::ArrayStart || Reader.SkipArray();
+			}
+			bHasPage = true;
+			EJsonNotation Field;
+			while (Reader.ReadNext(Field))
+			{
+				const FString& Name = Reader.GetIdentifier();
+				switch (Field)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (Name != TEXT("entries"))
+					{
+						if (!Reader.SkipArray()) return false;
+						break;
+					}
+					if (!ReadObjectArray(Reader, [&Page](TJsonReader<TCHAR>& EntryReader)
+					{
+						return ReadAssetHistoryObject(EntryReader, Page.Entries.AddDefaulted_GetRef());
+					}))
+					{
+						return false;
+					}
+					break;
+				default:
+					if (Name == TEXT("first_index")) Page.FirstIndex = ScalarAsInt64(Field, Reader);
+					else if (Name == TEXT("next_index")) Page.NextIndex = ScalarAsInt64(Field, Reader);
+					break;
+				}
+			}
+			return false;
+		});
+		if (!bOk || !bSuccess || !bHasPage) return false;
+		// The fields may come in any order, so indexes are assigned once first_index is known
+		for (int32 i = 0; i < Page.Entries.Num(); i++)
+		{
+			Page.Entries[i].Index = Page.FirstIndex + i;
+		}
+		OutPage = MoveTemp(Page);
+		return true;
+	}
+
+	bool ParseGasSchedule(TArrayView<const uint8> Body, FHazeGasSchedule& OutSchedule)
+	{
+		bool bSuccess = false;
+		FHazeGasSchedule Schedule;
+		const bool bOk = ReadEnvelope(Body, bSuccess, [&Schedule](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			const int64 Value = ScalarAsInt64(Notation, Reader);
+			if (Field == TEXT("version")) Schedule.Version = Value;
+			else if (Field == TEXT("gas_price")) Schedule.GasPrice = Value;
+			else if (Field == TEXT("create_base")) Schedule.CreateBase = Value;
+			else if (Field == TEXT("create_per_kb")) Schedule.CreatePerKb = Value;
+			else if (Field == TEXT("update_base")) Schedule.UpdateBase = Value;
+			else if (Field == TEXT("update_per_kb")) Schedule.UpdatePerKb = Value;
+			else if (Field == TEXT("condense_base")) Schedule.CondenseBase = Value;
+			else if (Field == TEXT("condense_multiplier_ethereal")) Schedule.CondenseMultiplierEthereal = Value;
+			else if (Field == TEXT("condense_multiplier_light")) Schedule.CondenseMultiplierLight = Value;
+			else if (Field == TEXT("condense_multiplier_dense")) Schedule.CondenseMultiplierDense = Value;
+			else if (Field == TEXT("condense_multiplier_core")) Schedule.CondenseMultiplierCore = Value;
+			else if (Field == TEXT("condense_per_kb")) Schedule.CondensePerKb = Value;
+			else if (Field == TEXT("evaporate_base")) Schedule.EvaporateBase = Value;
+			else if (Field == TEXT("merge_base")) Schedule.MergeBase = Value;
+			else if (Field == TEXT("merge_per_kb")) Schedule.MergePerKb = Value;
+			else if (Field == TEXT("split_base")) Schedule.SplitBase = Value;
+			else if (Field == TEXT("split_per_component")) Schedule.SplitPerComponent = Value;
+			else if (Field == TEXT("split_per_kb")) Schedule.SplitPerKb = Value;
+		});
+		if (!bOk || !bSuccess) return false;
+		OutSchedule = Schedule;
+		return true;
+	}
+
+	bool ParseSnapshotStalePage(TArrayView<const uint8> Body, FHazeSnapshotStalePage& OutPage)
+	{
+		bool bSuccess = false;
+		bool bHasPage = false;
+		FHazeSnapshotStalePage Page;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation != EJsonNotation::ObjectStart)
+			{
+				return Notation != EJsonNotation::ArrayStart || Reader.SkipArray();
+			}
+			bHasPage = true;
+			EJsonNotation Field;
+			while (Reader.ReadNext(Field))
+			{
+				const FString& Name = Reader.GetIdentifier();
+				switch (Field)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (Name != TEXT("stale"))
+					{
+						if (!Reader.SkipArray()) return false;
+						break;
+					}
+					if (!ReadObjectArray(Reader, [&Page](TJsonReader<TCHAR>& EntryReader)
+					{
+						return ReadSnapshotStaleObject(EntryReader, Page.Stale.AddDefaulted_GetRef());
+					}))
+					{
+						return false;
+					}
+					break;
+				default:
+					if (Name == TEXT("state_root")) Page.StateRoot = ScalarAsString(Field, Reader);
+					else if (Name == TEXT("current_height")) Page.CurrentHeight = ScalarAsInt64(Field, Reader);
+					break;
+				}
+			}
+			return false;
+		});
+		if (!bOk || !bSuccess || !bHasPage) return false;
+		OutPage = MoveTemp(Page);
+		return true;
+	}
+
+	bool ParseBlock(TArrayView<const uint8> Body, FHazeBlockInfo& OutBlock)
+	{
+		bool bSuccess = false;
+		FHazeBlockInfo Block;
+		const bool bOk = ReadEnvelopeValue(Body, bSuccess, [&](EJsonNotation Notation, TJsonReader<TCHAR>& Reader)
+		{
+			if (Notation != EJsonNotation::ObjectStart)
+			{
+				return Notation != EJsonNotation::ArrayStart || Reader.SkipArray();
+			}
+			EJsonNotation Field;
+			while (Reader.ReadNext(Field))
+			{
+				const FString& Name = Reader.GetIdentifier();
+				switch (Field)
+				{
+				case EJsonNotation::ObjectEnd:
+					return true;
+				case EJsonNotation::Error:
+					return false;
+				case EJsonNotation::ObjectStart:
+					if (!Reader.SkipObject()) return false;
+					break;
+				case EJsonNotation::ArrayStart:
+					if (!(Name == TEXT("transactions") ? ReadStringArray(Reader, Block.Transactions) : Reader.SkipArray())) return false;
+					break;
+				default:
+					if (Name == TEXT("hash")) Block.Hash = ScalarAsString(Field, Reader);
+					else if (Name == TEXT("parent_hash")) Block.ParentHash = ScalarAsString(Field, Reader);
+					else if (Name == TEXT("height")) Block.Height = ScalarAsInt64(Field, Reader);
+					else if (Name == TEXT("timestamp")) Block.Timestamp = ScalarAsInt64(Field, Reader);
+					else if (Name == TEXT("validator")) Block.Validator = ScalarAsString(Field, Reader);
+					else if (Name == TEXT("wave_number")) Block.WaveNumber = ScalarAsInt64(Field, Reader);
+					break;
+				}
+			}
+			return false;
+		});
+		if (!bOk || !bSuccess || Block.Hash.IsEmpty()) return false;
+		OutBlock = MoveTemp(Block);
+		return true;
+	}
+
+	bool ParseLiquidityPools(TArrayView<const uint8> Body, TArray<FLiquidityPool>& OutPools)
+	{
+		bool bSuccess = false;
+		TArray<FLiquidityPool> Pools;
+		const bool bOk = ReadEnvelopeArray(Body, bSuccess, [&](int32 Index, const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			if (Index >= Pools.Num()) Pools.SetNum(Index + 1);
+			ReadPoolField(Field, Notation, Reader, Pools[Index]);
+		});
+		if (!bOk || !bSuccess) return false;
+		OutPools = MoveTemp(Pools);
+		return true;
+	}
+
+	bool ParseLiquidityPool(TArrayView<const uint8> Body, FLiquidityPool& OutPool)
+	{
+		bool bSuccess = false;
+		FLiquidityPool Pool;
+		const bool bOk = ReadEnvelope(Body, bSuccess, [&](const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)
+		{
+			ReadPoolField(Field, Notation, Reader, Pool);
+		});
+		if (!bOk || !bSuccess || Pool.PoolId.IsEmpty()) return false;
+		OutPool = MoveTemp(Pool);
+		return true;
+	}
+
+	bool ParseAssetBlobRef(TArrayView<const uint8> Body, const FString& BlobKey, FString& OutBlobHash)
+	{
+		OutBlobHash.Reset();
+		if (Body.Num() == 0) return false;
+
+		FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(FStringView(Text.Get(), Text.Length()));
+
+		// 1 = envelope, 2 = "data" (the asset), 3 = "data"."blob_refs"; everything else is skipped
+		int32 Depth = 0;
+		bool bSuccess = false;
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation))
+		{
+			const FString& Identifier = Reader->GetIdentifier();
+			switch (Notation)
+			{
+			case EJsonNotation::ObjectStart:
+				if (Depth == 0 || (Depth == 1 && Identifier == TEXT("data")) || (Depth == 2 && Identifier == TEXT("blob_refs")))
+				{
+					Depth++;
+				}
+				else if (!Reader->SkipObject())
+				{
+					return false;
+				}
+				break;
+			case EJsonNotation::ObjectEnd:
+				if (--Depth == 0) return bSuccess && !OutBlobHash.IsEmpty();
+				break;
+			case EJsonNotation::ArrayStart:
+				if (!Reader->SkipArray()) return false;
+				break;
+			case EJsonNotation::Error:
+				return false;
+			case EJsonNotation::Boolean:
+				if (Depth == 1 && Identifier == TEXT("success")) bSuccess = Reader->GetValueAsBoolean();
+				break;
+			case EJsonNotation::String:
+				if (Depth == 3 && Identifier == BlobKey) OutBlobHash = Reader->GetValueAsString();
+				break;
+			default:
+				break;
+			}
+		}
+		return false;
+	}
+
+	EHazeStreamEventType StreamEventTypeFromName(FStringView Name)
+	{
+		for (const FStreamEventName& Entry : StreamEventNames)
+		{
+			if (Name == Entry.Name) return Entry.Type;
+		}
+		return EHazeStreamEventType::Unknown;
+	}
+
+	const TCHAR* StreamEventTypeName(EHazeStreamEventType Type)
+	{
+		for (const FStreamEventName& Entry : StreamEventNames)
+		{
+			if (Entry.Type == Type) return Entry.Name;
+		}
+		return TEXT("");
+	}
+
+	bool ParseStreamEvent(TArrayView<const uint8> Message, FHazeStreamEvent& OutEvent)
+	{
+		if (Message.Num() == 0) return false;
+
+		FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Message.GetData()), Message.Num());
+		TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::CreateFromView(FStringView(Text.Get(), Text.Length()));
+
+		EJsonNotation Notation;
+		if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart) return false;
+
+		FHazeStreamEvent Event;
+		while (Reader->ReadNext(Notation))
+		{
+			const FString& Field = Reader->GetIdentifier();
+			switch (Notation)
+			{
+			case EJsonNotation::ObjectEnd:
+				if (Event.Type == EHazeStreamEventType::Unknown) return false;
+				OutEvent = MoveTemp(Event);
+				return true;
+			case EJsonNotation::Error:
+				return false;
+			case EJsonNotation::ObjectStart:
+				if (!Reader->SkipObject()) return false;
+				break;
+			case EJsonNotation::ArrayStart:
+			{
+				TArray<FString>* Target =
+					Field == TEXT("created_assets") ? &Event.RelatedAssetIds :
+					Field == TEXT("attributes") ? &Event.Attributes :
+					Field == TEXT("transactions") ? &Event.Transactions :
+					Field == TEXT("accounts") ? &Event.Accounts : nullptr;
+				if (!(Target ? ReadStringArray(*Reader, *Target) : Reader->SkipArray())) return false;
+				break;
+			}
+			default:
+				if (Field == TEXT("type")) Event.Type = StreamEventTypeFromName(ScalarAsString(Notation, *Reader));
+				else if (Field == TEXT("asset_id")) Event.AssetId = ScalarAsString(Notation, *Reader);
+				else if (Field == TEXT("owner")) Event.Owner = ScalarAsString(Notation, *Reader);
+				else if (Field == TEXT("density") || Field == TEXT("new_density")) Event.Density = DensityFromName(ScalarAsString(Notation, *Reader));
+				else if (Field == TEXT("merged_asset_id")) Event.RelatedAssetIds.Add(ScalarAsString(Notation, *Reader));
+				else if (Field == TEXT("version")) Event.Version = ScalarAsInt64(Notation, *Reader);
+				else if (Field == TEXT("height")) Event.Height = ScalarAsInt64(Notation, *Reader);
+				else if (Field == TEXT("hash")) Event.BlockHash = ScalarAsString(Notation, *Reader);
+				else if (Field == TEXT("message")) Event.Message = ScalarAsString(Notation, *Reader);
+				else ReadPoolField(Field, Notation, *Reader, Event.Pool);
+				break;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,86 @@
+// Copyright HAZE Blockchain. Typed decoding of HAZE REST responses (no JSON DOM).
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeTypes.h"
+#include "HazeAssetPage.h"
+#include "HazeAssetVersions.h"
+#include "HazeAssetSnapshot.h"
+#include "Serialization/JsonTypes.h"
+#include "Serialization/JsonReader.h"
+
+/**
+ * Pull-parses the node's { "success": bool, "data": ..., "error": ... } envelope with TJsonReader,
+ * extracting only the fields the typed result needs and skipping everything else.
+ * Thread-safe (no shared state); UHazeClient runs these on background tasks.
+ */
+namespace HazeResponse
+{
+	/** Called once per scalar field of an object "data", or once with an empty name when "data" itself is a scalar. */
+	using FDataFieldFn = TFunctionRef<void(const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)>;
+
+	/** Called once per scalar field of each object in an array "data" (Field empty for scalar elements). */
+	using FDataElementFn = TFunctionRef<void(int32 Index, const FString& Field, EJsonNotation Notation, const TJsonReader<TCHAR>& Reader)>;
+
+	/** Called once with "data" positioned at its first token; must consume the whole value (nested objects included). */
+	using FDataValueFn = TFunctionRef<bool(EJsonNotation Notation, TJsonReader<TCHAR>& Reader)>;
+
+	/** Walk the envelope in Body (UTF-8). Returns false on malformed JSON. */
+	bool ReadEnvelope(TArrayView<const uint8> Body, bool& bOutSuccess, FDataFieldFn OnDataField);
+
+	/** As ReadEnvelope, for responses whose "data" is an array. */
+	bool ReadEnvelopeArray(TArrayView<const uint8> Body, bool& bOutSuccess, FDataElementFn OnDataElement);
+
+	/** As ReadEnvelope, handing the whole "data" value (any shape) to OnDataValue. */
+	bool ReadEnvelopeValue(TArrayView<const uint8> Body, bool& bOutSuccess, FDataValueFn OnDataValue);
+
+	/** Scalar value as string; numbers keep their exact digits (u64 balances do not round-trip through double). */
+	FString ScalarAsString(EJsonNotation Notation, const TJsonReader<TCHAR>& Reader);
+
+	/** Scalar value as int64 (numbers or decimal strings). */
+	int64 ScalarAsInt64(EJsonNotation Notation, const TJsonReader<TCHAR>& Reader);
+
+	/** Scalar value as FHazeAmount (numbers or decimal strings, parsed from their digits); zero if not a non-negative integer. */
+	FHazeAmount ScalarAsAmount(EJsonNotation Notation, const TJsonReader<TCHAR>& Reader);
+
+	bool ParseHealth(TArrayView<const uint8> Body, FString& OutHealth);
+	bool ParseBlockchainInfo(TArrayView<const uint8> Body, FBlockchainInfo& OutInfo);
+	bool ParseBalance(TArrayView<const uint8> Body, FHazeAmount& OutBalance);
+	bool ParseAccount(TArrayView<const uint8> Body, FAccountInfo& OutInfo);
+	/** Returns the envelope's success flag; Hash/Status are filled only on success. */
+	bool ParseTransaction(TArrayView<const uint8> Body, FTransactionResponse& OutResponse);
+	bool ParseTransactionBatch(TArrayView<const uint8> Body, TArray<FBatchTransactionResult>& OutResults);
+	/** ParseTransaction / ParseTransactionBatch for application/x-haze-bincode bodies (see FHazeBincodeReader) */
+	bool ParseTransactionBinary(TArrayView<const uint8> Body, FTransactionResponse& OutResponse);
+	bool ParseTransactionBatchBinary(TArrayView<const uint8> Body, TArray<FBatchTransactionResult>& OutResults);
+	/** GET /api/v1/assets/{id}, full or ?view=summary */
+	bool ParseAsset(TArrayView<const uint8> Body, FHazeAssetInfo& OutAsset);
+	/** POST /api/v1/assets/summaries: one entry per requested id; unknown ids have an empty AssetId */
+	bool ParseAssetSummaries(TArrayView<const uint8> Body, TArray<FHazeAssetInfo>& OutAssets);
+	/** GET /api/v1/assets/search?view=summary into OutPage (appended); LabelKey picks the one metadata value kept */
+	bool ParseAssetSearchPage(TArrayView<const uint8> Body, FHazeAssetPage& OutPage, const FString& LabelKey);
+	/** GET /api/v1/assets/{id}/versions?since=N */
+	bool ParseAssetVersionsPage(TArrayView<const uint8> Body, FHazeAssetVersionsPage& OutPage);
+	/** GET /api/v1/assets/{id}/history?since=N (entry indexes filled in) */
+	bool ParseAssetHistoryPage(TArrayView<const uint8> Body, FHazeAssetHistoryPage& OutPage);
+	/** GET /api/v1/assets/gas-schedule */
+	bool ParseGasSchedule(TArrayView<const uint8> Body, FHazeGasSchedule& OutSchedule);
+	/** POST /api/v1/snapshots/assets/stale */
+	bool ParseSnapshotStalePage(TArrayView<const uint8> Body, FHazeSnapshotStalePage& OutPage);
+	/** GET /api/v1/blocks/height/{height} or /api/v1/blocks/{hash} */
+	bool ParseBlock(TArrayView<const uint8> Body, FHazeBlockInfo& OutBlock);
+	/** GET /api/v1/economy/pools */
+	bool ParseLiquidityPools(TArrayView<const uint8> Body, TArray<FLiquidityPool>& OutPools);
+	/** GET /api/v1/economy/pools/{pool_id} */
+	bool ParseLiquidityPool(TArrayView<const uint8> Body, FLiquidityPool& OutPool);
+	/** blob_refs[BlobKey] (hex SHA-256) of a GET /api/v1/assets/{id} response. False if the asset has no such blob. */
+	bool ParseAssetBlobRef(TArrayView<const uint8> Body, const FString& BlobKey, FString& OutBlobHash);
+
+	/** Decode one /api/v1/ws message (a bare WsEvent object, no envelope). False if malformed or of unknown type. */
+	bool ParseStreamEvent(TArrayView<const uint8> Message, FHazeStreamEvent& OutEvent);
+
+	/** WsEvent "type" names (also used for subscriptions) */
+	EHazeStreamEventType StreamEventTypeFromName(FStringView Name);
+	const TCHAR* StreamEventTypeName(EHazeStreamEventType Type);
+}
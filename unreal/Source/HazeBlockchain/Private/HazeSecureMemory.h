@@ -0,0 +1,17 @@
+// Copyright HAZE Blockchain. Page-locked, zeroized allocations for key material.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace HazeSecureMemory
+{
+	/** Zeroize through a volatile pointer so the store is not elided. */
+	void Zero(void* Ptr, SIZE_T Size);
+
+	/** Whole pages from the OS, locked out of swap (best effort). Size is rounded up to the page size; pass the same Size to Free. */
+	void* Allocate(SIZE_T Size);
+
+	/** Zeroize, unlock and release an Allocate block */
+	void Free(void* Ptr, SIZE_T Size);
+}
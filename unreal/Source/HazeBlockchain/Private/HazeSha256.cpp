@@ -0,0 +1,143 @@
+// Copyright HAZE Blockchain. Incremental SHA-256 (FIPS 180-4).
+
+#include "HazeSha256.h"
+#include "HazeHex.h"
+
+namespace
+{
+	constexpr uint32 RoundConstants[64] =
+	{
+		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+	};
+
+	FORCEINLINE uint32 RotateRight(uint32 Value, uint32 Bits)
+	{
+		return (Value >> Bits) | (Value << (32 - Bits));
+	}
+}
+
+void FHazeSha256::Reset()
+{
+	State[0] = 0x6a09e667;
+	State[1] = 0xbb67ae85;
+	State[2] = 0x3c6ef372;
+	State[3] = 0xa54ff53a;
+	State[4] = 0x510e527f;
+	State[5] = 0x9b05688c;
+	State[6] = 0x1f83d9ab;
+	State[7] = 0x5be0cd19;
+	TotalLen = 0;
+	BufferLen = 0;
+}
+
+void FHazeSha256::Transform(const uint8* Block)
+{
+	uint32 W[64];
+	for (int32 i = 0; i < 16; i++)
+	{
+		W[i] = (uint32(Block[i * 4]) << 24) | (uint32(Block[i * 4 + 1]) << 16) | (uint32(Block[i * 4 + 2]) << 8) | uint32(Block[i * 4 + 3]);
+	}
+	for (int32 i = 16; i < 64; i++)
+	{
+		const uint32 S0 = RotateRight(W[i - 15], 7) ^ RotateRight(W[i - 15], 18) ^ (W[i - 15] >> 3);
+		const uint32 S1 = RotateRight(W[i - 2], 17) ^ RotateRight(W[i - 2], 19) ^ (W[i - 2] >> 10);
+		W[i] = W[i - 16] + S0 + W[i - 7] + S1;
+	}
+
+	uint32 A = State[0], B = State[1], C = State[2], D = State[3];
+	uint32 E = State[4], F = State[5], G = State[6], H = State[7];
+	for (int32 i = 0; i < 64; i++)
+	{
+		const uint32 S1 = RotateRight(E, 6) ^ RotateRight(E, 11) ^ RotateRight(E, 25);
+		const uint32 Choose = (E & F) ^ (~E & G);
+		const uint32 T1 = H + S1 + Choose + RoundConstants[i] + W[i];
+		const uint32 S0 = RotateRight(A, 2) ^ RotateRight(A, 13) ^ RotateRight(A, 22);
+		const uint32 Majority = (A & B) ^ (A & C) ^ (B & C);
+		const uint32 T2 = S0 + Majority;
+		H = G;
+		G = F;
+		F = E;
+		E = D + T1;
+		D = C;
+		C = B;
+		B = A;
+		A = T1 + T2;
+	}
+
+	State[0] += A; State[1] += B; State[2] += C; State[3] += D;
+	State[4] += E; State[5] += F; State[6] += G; State[7] += H;
+}
+
+void FHazeSha256::Update(const uint8* Data, int64 Len)
+{
+	TotalLen += static_cast<uint64>(Len);
+	if (BufferLen > 0)
+	{
+		const int32 Take = static_cast<int32>(FMath::Min<int64>(64 - BufferLen, Len));
+		FMemory::Memcpy(Buffer + BufferLen, Data, Take);
+		BufferLen += Take;
+		Data += Take;
+		Len -= Take;
+		if (BufferLen < 64) return;
+		Transform(Buffer);
+		BufferLen = 0;
+	}
+	while (Len >= 64)
+	{
+		Transform(Data);
+		Data += 64;
+		Len -= 64;
+	}
+	if (Len > 0)
+	{
+		FMemory::Memcpy(Buffer, Data, Len);
+		BufferLen = static_cast<int32>(Len);
+	}
+}
+
+void FHazeSha256::Final(uint8* OutDigest)
+{
+	const uint64 BitLen = TotalLen * 8;
+	Buffer[BufferLen++] = 0x80;
+	if (BufferLen > 56)
+	{
+		FMemory::Memzero(Buffer + BufferLen, 64 - BufferLen);
+		Transform(Buffer);
+		BufferLen = 0;
+	}
+	FMemory::Memzero(Buffer + BufferLen, 56 - BufferLen);
+	for (int32 i = 0; i < 8; i++)
+	{
+		Buffer[56 + i] = static_cast<uint8>(BitLen >> (56 - i * 8));
+	}
+	Transform(Buffer);
+
+	for (int32 i = 0; i < 8; i++)
+	{
+		OutDigest[i * 4] = static_cast<uint8>(State[i] >> 24);
+		OutDigest[i * 4 + 1] = static_cast<uint8>(State[i] >> 16);
+		OutDigest[i * 4 + 2] = static_cast<uint8>(State[i] >> 8);
+		OutDigest[i * 4 + 3] = static_cast<uint8>(State[i]);
+	}
+}
+
+FString FHazeSha256::FinalHex()
+{
+	uint8 Digest[DigestSize];
+	Final(Digest);
+	return FHazeHex::ToHex(MakeArrayView(Digest, DigestSize));
+}
+
+FString FHazeSha256::HashHex(TArrayView<const uint8> Data)
+{
+	FHazeSha256 Hasher;
+	Hasher.Update(Data);
+	return Hasher.FinalHex();
+}
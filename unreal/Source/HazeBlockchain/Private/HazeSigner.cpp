@@ -0,0 +1,174 @@
+// Copyright HAZE Blockchain. Expanded Ed25519 signing key.
+
+#include "HazeSigner.h"
+#include "HazeSecureMemory.h"
+#include "HazeStats.h"
+#include "HAL/PlatformMemory.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC || PLATFORM_IOS || PLATFORM_ANDROID
+#include <sys/mman.h>
+#endif
+
+// Optional: link against ThirdParty/ed25519 when available
+#if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
+extern "C" {
+	void ed25519_seed_keypair(const uint8_t seed[32], uint8_t public_key[32], uint8_t private_key[64]);
+	void ed25519_sign(uint8_t signature[64], const uint8_t* message, size_t message_len, const uint8_t public_key[32], const uint8_t private_key[64]);
+}
+#endif
+
+namespace
+{
+	SIZE_T SecretAllocSize(SIZE_T Size)
+	{
+		const SIZE_T PageSize = FPlatformMemory::GetConstants().PageSize;
+		return Align(Size, PageSize);
+	}
+
+	/** Keep key pages out of swap. Best effort: failure (e.g. RLIMIT_MEMLOCK) is not fatal. */
+	void LockPages(void* Ptr, SIZE_T Size)
+	{
+#if PLATFORM_WINDOWS
+		::VirtualLock(Ptr, Size);
+#elif PLATFORM_UNIX || PLATFORM_MAC || PLATFORM_IOS || PLATFORM_ANDROID
+		::mlock(Ptr, Size);
+#endif
+	}
+
+	void UnlockPages(void* Ptr, SIZE_T Size)
+	{
+#if PLATFORM_WINDOWS
+		::VirtualUnlock(Ptr, Size);
+#elif PLATFORM_UNIX || PLATFORM_MAC || PLATFORM_IOS || PLATFORM_ANDROID
+		::munlock(Ptr, Size);
+#endif
+	}
+}
+
+void HazeSecureMemory::Zero(void* Ptr, SIZE_T Size)
+{
+	volatile uint8* P = static_cast<volatile uint8*>(Ptr);
+	while (Size--)
+	{
+		*P++ = 0;
+	}
+}
+
+void* HazeSecureMemory::Allocate(SIZE_T Size)
+{
+	const SIZE_T AllocSize = SecretAllocSize(Size);
+	void* Mem = FPlatformMemory::BinnedAllocFromOS(AllocSize);
+	if (Mem)
+	{
+		LockPages(Mem, AllocSize);
+	}
+	return Mem;
+}
+
+void HazeSecureMemory::Free(void* Ptr, SIZE_T Size)
+{
+	if (!Ptr) return;
+	const SIZE_T AllocSize = SecretAllocSize(Size);
+	Zero(Ptr, Size);
+	UnlockPages(Ptr, AllocSize);
+	FPlatformMemory::BinnedFreeToOS(Ptr, AllocSize);
+}
+
+FHazeSignerView::FHazeSignerView(const FHazeSignerContext& Context)
+{
+	if (Context.Secret)
+	{
+		PublicKey = Context.Secret->PublicKey;
+		ExpandedKey = Context.Secret->ExpandedKey;
+	}
+}
+
+TArrayView<const uint8> FHazeSignerView::GetPublicKey() const
+{
+	return PublicKey ? MakeArrayView(PublicKey, FHazeSignerContext::PublicKeySize) : TArrayView<const uint8>();
+}
+
+bool FHazeSignerView::Sign(const uint8* Message, int32 MessageLen, uint8* OutSignature) const
+{
+	HAZE_SCOPE(STAT_HazeSign, HazeSign);
+#if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
+	if (!IsValid() || !OutSignature || MessageLen < 0) return false;
+	ed25519_sign(OutSignature, Message, static_cast<size_t>(MessageLen), PublicKey, ExpandedKey);
+	return true;
+#else
+	(void)Message;
+	(void)MessageLen;
+	(void)OutSignature;
+	return false;
+#endif
+}
+
+FHazeSignerContext::~FHazeSignerContext()
+{
+	Reset();
+}
+
+bool FHazeSignerContext::DeriveKeys(const uint8* Seed, uint8* OutPublicKey, uint8* OutExpandedKey)
+{
+#if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
+	if (!Seed || !OutPublicKey || !OutExpandedKey) return false;
+	ed25519_seed_keypair(Seed, OutPublicKey, OutExpandedKey);
+	return true;
+#else
+	(void)Seed;
+	(void)OutPublicKey;
+	(void)OutExpandedKey;
+	return false;
+#endif
+}
+
+bool FHazeSignerContext::Initialize(const uint8* Seed)
+{
+	Reset();
+#if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
+	if (!Seed) return false;
+	void* Mem = HazeSecureMemory::Allocate(sizeof(FSecret));
+	if (!Mem) return false;
+
+	FSecret* S = new (Mem) FSecret();
+	FMemory::Memcpy(S->Seed, Seed, SeedSize);
+	DeriveKeys(S->Seed, S->PublicKey, S->ExpandedKey);
+	Secret = S;
+	return true;
+#else
+	(void)Seed;
+	return false;
+#endif
+}
+
+void FHazeSignerContext::Reset()
+{
+	if (!Secret) return;
+	HazeSecureMemory::Free(Secret, sizeof(FSecret));
+	Secret = nullptr;
+}
+
+bool FHazeSignerContext::MatchesSeed(const uint8* Seed) const
+{
+	if (!Secret || !Seed) return false;
+	uint8 Diff = 0;
+	for (int32 i = 0; i < SeedSize; i++)
+	{
+		Diff |= Secret->Seed[i] ^ Seed[i];
+	}
+	return Diff == 0;
+}
+
+const uint8* FHazeSignerContext::GetPublicKey() const
+{
+	return Secret ? Secret->PublicKey : nullptr;
+}
+
+bool FHazeSignerContext::Sign(const uint8* Message, int32 MessageLen, uint8* OutSignature) const
+{
+	return FHazeSignerView(*this).Sign(Message, MessageLen, OutSignature);
+}
@@ -0,0 +1,17 @@
+// Copyright HAZE Blockchain. Stat group and trace channel for plugin hot paths.
+
+#include "HazeStats.h"
+
+DEFINE_STAT(STAT_HazeBuildPayload);
+DEFINE_STAT(STAT_HazeSign);
+DEFINE_STAT(STAT_HazeHex);
+DEFINE_STAT(STAT_HazeBuildJson);
+DEFINE_STAT(STAT_HazeBuildBinary);
+DEFINE_STAT(STAT_HazeInflate);
+DEFINE_STAT(STAT_HazeParse);
+DEFINE_STAT(STAT_HazeDeliver);
+DEFINE_STAT(STAT_HazeRequestsInFlight);
+DEFINE_STAT(STAT_HazeRequestsCompleted);
+DEFINE_STAT(STAT_HazeBytesReceived);
+
+UE_TRACE_CHANNEL_DEFINE(HazeChannel);
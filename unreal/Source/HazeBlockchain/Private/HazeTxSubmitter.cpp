@@ -0,0 +1,485 @@
+// Copyright HAZE Blockchain. Windowed transaction submission with retries and backpressure.
+
+#include "HazeTxSubmitter.h"
+#include "HazeBlockchain.h"
+
+namespace
+{
+	/** Heap order: higher priority first, then enqueue order */
+	template <typename RefType>
+	struct FSendOrder
+	{
+		bool operator()(const RefType& A, const RefType& B) const
+		{
+			if (A->Priority != B->Priority) return A->Priority > B->Priority;
+			return A->Sequence < B->Sequence;
+		}
+	};
+}
+
+UHazeTxSubmitter* UHazeTxSubmitter::CreateSubmitter(UHazeClient* InClient)
+{
+	UHazeTxSubmitter* Submitter = NewObject<UHazeTxSubmitter>();
+	Submitter->Client = InClient;
+	return Submitter;
+}
+
+bool UHazeTxSubmitter::Enqueue(const FString& TransactionJson, EHazeTxPriority Priority, const FString& OrderingKey, const FHazeTransactionDelegate& OnComplete)
+{
+	return Submit(TransactionJson, Priority, OrderingKey, [OnComplete](bool bAccepted, const FTransactionResponse& Response, int32)
+	{
+		OnComplete.ExecuteIfBound(bAccepted, Response);
+	});
+}
+
+bool UHazeTxSubmitter::Submit(const FString& TransactionJson, EHazeTxPriority Priority, const FString& OrderingKey, FHazeOnTransaction OnComplete,
+	TOptional<uint64> Nonce)
+{
+	if ((!Client && !Transport) || QueuedCount >= MaxQueueDepth) return false;
+
+	FQueuedTxRef Tx = MakeShared<FQueuedTx>();
+	Tx->Json = TransactionJson;
+	Tx->OrderingKey = OrderingKey;
+	Tx->OnComplete = MoveTemp(OnComplete);
+	Tx->Priority = Priority;
+	if (Outbox)
+	{
+		Tx->JournalId = Outbox->Append(OrderingKey, Nonce, static_cast<uint8>(Priority), TransactionJson);
+		if (Tx->JournalId == 0)
+		{
+			UE_LOG(LogHaze, Warning, TEXT("HAZE outbox: journal write failed, transaction sent without a crash-safe record"));
+		}
+	}
+	Admit(Tx);
+	return true;
+}
+
+int32 UHazeTxSubmitter::EnableOutbox(const FString& JournalName)
+{
+	Outbox = FHazeOutboxJournal::Open(JournalName);
+	return Outbox ? ReplayOutbox() : -1;
+}
+
+int32 UHazeTxSubmitter::ReplayOutbox()
+{
+	if ((!Client && !Transport) || !Outbox) return 0;
+	TArray<FHazeOutboxEntry> Entries = Outbox->TakeRecovered();
+	for (FHazeOutboxEntry& Entry : Entries)
+	{
+		FQueuedTxRef Tx = MakeShared<FQueuedTx>();
+		Tx->Json = MoveTemp(Entry.TransactionJson);
+		Tx->OrderingKey = Entry.OrderingKey;
+		Tx->Priority = static_cast<EHazeTxPriority>(FMath::Min<uint8>(Entry.Priority, static_cast<uint8>(EHazeTxPriority::High)));
+		Tx->JournalId = Entry.Id;
+		Tx->bReplayed = true;
+		Tx->OnComplete = [WeakThis = TWeakObjectPtr<UHazeTxSubmitter>(this), Key = Entry.OrderingKey](bool bAccepted, const FTransactionResponse& Response, int32)
+		{
+			if (UHazeTxSubmitter* This = WeakThis.Get())
+			{
+				This->OnOutboxReplayed.Broadcast(bAccepted, Response, Key);
+			}
+		};
+		// Owed from before the restart, so not subject to MaxQueueDepth
+		Admit(Tx);
+	}
+	return Entries.Num();
+}
+
+void UHazeTxSubmitter::Admit(const FQueuedTxRef& Tx)
+{
+	const FString& OrderingKey = Tx->OrderingKey;
+	Tx->Sequence = NextSequence++;
+	QueuedCount++;
+
+	if (OrderingKey.IsEmpty())
+	{
+		PushReady(Tx);
+	}
+	else
+	{
+		FLane& Lane = Lanes.FindOrAdd(OrderingKey);
+		Lane.Waiting.Add(Tx);
+		ReleaseNext(Lane);
+	}
+
+	UpdateBackpressure();
+	EnsureTicking();
+	Pump();
+}
+
+void UHazeTxSubmitter::Acknowledge(const FQueuedTx& Tx)
+{
+	if (Outbox && Tx.JournalId != 0)
+	{
+		Outbox->Acknowledge(Tx.JournalId);
+	}
+}
+
+void UHazeTxSubmitter::CancelPending()
+{
+	TArray<FQueuedTxRef> Dropped = MoveTemp(Ready);
+	Dropped.Append(MoveTemp(Delayed));
+	Ready.Reset();
+	Delayed.Reset();
+	// Lanes keep only what is in flight; a key with nothing in flight is free again
+	for (auto It = Lanes.CreateIterator(); It; ++It)
+	{
+		FLane& Lane = It.Value();
+		Lane.Active.RemoveAll([](const FQueuedTxRef& Tx) { return !Tx->bInFlight; });
+		Dropped.Append(MoveTemp(Lane.Waiting));
+		Lane.Waiting.Reset();
+		if (Lane.Active.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	CompleteDropped(Dropped);
+}
+
+FHazeTxSubmitterStats UHazeTxSubmitter::GetStats() const
+{
+	FHazeTxSubmitterStats Stats;
+	Stats.QueueDepth = QueuedCount;
+	Stats.InFlight = InFlight;
+	Stats.Window = CurrentWindow();
+	Stats.Accepted = AcceptedTotal;
+	Stats.Rejected = RejectedTotal;
+	Stats.Dropped = DroppedTotal;
+	Stats.Retries = RetryTotal;
+	Stats.AcceptedPerSecond = AcceptedPerSecond;
+	return Stats;
+}
+
+void UHazeTxSubmitter::BeginDestroy()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+int32 UHazeTxSubmitter::CurrentWindow() const
+{
+	if (CongestionWindow <= 0.f) return MaxInFlight;
+	return FMath::Clamp(FMath::FloorToInt(CongestionWindow), 1, MaxInFlight);
+}
+
+bool UHazeTxSubmitter::IsRetryable(int32 ResponseCode)
+{
+	// Anything else reached the node and was answered; sending it again would only be answered the same way
+	return ResponseCode == 0 || ResponseCode == 429 || ResponseCode == 503;
+}
+
+double UHazeTxSubmitter::BackoffSeconds(int32 Attempt) const
+{
+	const double Cap = FMath::Min<double>(MaxBackoffSeconds, InitialBackoffSeconds * FMath::Pow(2.0, Attempt - 1));
+	return FMath::FRandRange(0.0, Cap);
+}
+
+void UHazeTxSubmitter::PushReady(const FQueuedTxRef& Tx)
+{
+	Ready.HeapPush(Tx, FSendOrder<FQueuedTxRef>());
+}
+
+void UHazeTxSubmitter::Pump()
+{
+	while (InFlight < CurrentWindow() && Ready.Num() > 0)
+	{
+		FQueuedTxRef Tx = Ready.HeapTop();
+		Ready.HeapPopDiscard(FSendOrder<FQueuedTxRef>());
+		Send(Tx);
+	}
+}
+
+void UHazeTxSubmitter::Send(const FQueuedTxRef& Tx)
+{
+	QueuedCount--;
+	InFlight++;
+	Tx->bInFlight = true;
+	// On its way: the next transaction of its key may follow
+	if (FLane* Lane = Tx->OrderingKey.IsEmpty() ? nullptr : Lanes.Find(Tx->OrderingKey))
+	{
+		ReleaseNext(*Lane);
+	}
+	// The crashed session may have sent it after all; a second copy would only be refused as a duplicate
+	if (Tx->bReplayed)
+	{
+		Tx->bReplayed = false;
+		if (LookUp(Tx, [Tx](UHazeTxSubmitter& This) { This.Transmit(Tx); })) return;
+	}
+	Transmit(Tx);
+}
+
+void UHazeTxSubmitter::Transmit(const FQueuedTxRef& Tx)
+{
+	Tx->Attempts++;
+
+	TWeakObjectPtr<UHazeTxSubmitter> WeakThis(this);
+	FHazeOnTransaction OnSent = [WeakThis, Tx](bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
+	{
+		if (UHazeTxSubmitter* This = WeakThis.Get())
+		{
+			This->OnSendComplete(Tx, bAccepted, Response, ResponseCode);
+		}
+		else
+		{
+			Tx->OnComplete(bAccepted, Response, ResponseCode);
+		}
+	};
+	if (Transport)
+	{
+		Transport(Tx->Json, MoveTemp(OnSent));
+		return;
+	}
+	Client->SubmitTransaction(Tx->Json, MoveTemp(OnSent));
+}
+
+void UHazeTxSubmitter::OnSendComplete(const FQueuedTxRef& Tx, bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
+{
+	// Still in flight while the lookup runs, so the lane and the window slot stay held
+	if (!bAccepted && ResponseCode >= 400 && ResponseCode < 500 && Tx->Attempts > 1
+		&& LookUp(Tx, [Tx, Response, ResponseCode](UHazeTxSubmitter& This) { This.CompleteSend(Tx, false, Response, ResponseCode); }))
+	{
+		return;
+	}
+	CompleteSend(Tx, bAccepted, Response, ResponseCode);
+}
+
+bool UHazeTxSubmitter::LookUp(const FQueuedTxRef& Tx, TFunction<void(UHazeTxSubmitter& This)> IfMissing)
+{
+	FHazeOnTransaction OnFound = [WeakThis = TWeakObjectPtr<UHazeTxSubmitter>(this), Tx, IfMissing = MoveTemp(IfMissing)]
+		(bool bFound, const FTransactionResponse& Response, int32 ResponseCode)
+	{
+		UHazeTxSubmitter* This = WeakThis.Get();
+		if (!This)
+		{
+			Tx->OnComplete(bFound, Response, ResponseCode);
+		}
+		else if (bFound)
+		{
+			This->CompleteSend(Tx, true, Response, ResponseCode);
+		}
+		else
+		{
+			IfMissing(*This);
+		}
+	};
+	if (Lookup) return Lookup(Tx->Json, MoveTemp(OnFound));
+	return Client && Client->FetchSubmittedTransaction(Tx->Json, MoveTemp(OnFound));
+}
+
+void UHazeTxSubmitter::CompleteSend(const FQueuedTxRef& Tx, bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)
+{
+	InFlight--;
+	Tx->bInFlight = false;
+	if (CongestionWindow <= 0.f) CongestionWindow = MaxInFlight;
+
+	if (!bAccepted && IsRetryable(ResponseCode) && Tx->Attempts <= MaxRetries)
+	{
+		if (ResponseCode == 429 || ResponseCode == 503)
+		{
+			CongestionWindow = FMath::Max(1.f, CongestionWindow * 0.5f);
+		}
+		RetryTotal++;
+		QueuedCount++;
+		Tx->NotBefore = FPlatformTime::Seconds() + BackoffSeconds(Tx->Attempts);
+		Delayed.Add(Tx);
+		EnsureTicking();
+		Pump();
+		return;
+	}
+
+	// It may have overtaken an earlier nonce of its sender on the way: send it again once those are answered
+	const FLane* Lane = Tx->OrderingKey.IsEmpty() ? nullptr : Lanes.Find(Tx->OrderingKey);
+	const bool bEarlierUnanswered = Lane && ((Lane->Active.Num() > 0 && Lane->Active[0] != Tx)
+		|| (Lane->Waiting.Num() > 0 && Lane->Waiting[0]->Sequence < Tx->Sequence));
+	if (!bAccepted && ResponseCode >= 400 && ResponseCode < 500 && bEarlierUnanswered && Tx->Attempts <= MaxRetries)
+	{
+		RetryTotal++;
+		QueuedCount++;
+		Requeue(Tx);
+		Pump();
+		return;
+	}
+
+	TArray<FQueuedTxRef> Dropped;
+	if (bAccepted)
+	{
+		AcceptedTotal++;
+		AcceptedInSample++;
+		CongestionWindow = FMath::Min<float>(MaxInFlight, CongestionWindow + 1.f / CongestionWindow);
+	}
+	else
+	{
+		RejectedTotal++;
+	}
+	// Answered: a retry after a restart would only be reported as a duplicate. Never answered (0): keep it for replay.
+	if (ResponseCode != 0)
+	{
+		Acknowledge(*Tx);
+	}
+	ReleaseLane(Tx, !bAccepted, Dropped);
+	Pump();
+	UpdateBackpressure();
+
+	// Callbacks last: they may enqueue more work
+	Tx->OnComplete(bAccepted, Response, ResponseCode);
+	CompleteDropped(Dropped);
+}
+
+void UHazeTxSubmitter::ReleaseLane(const FQueuedTxRef& Tx, bool bFailed, TArray<FQueuedTxRef>& OutDropped)
+{
+	if (Tx->OrderingKey.IsEmpty()) return;
+	FLane* Lane = Lanes.Find(Tx->OrderingKey);
+	if (!Lane) return;
+	Lane->Active.RemoveSingle(Tx);
+
+	if (bFailed)
+	{
+		// Later nonces from this sender cannot be accepted once this one is gone. Those already sent are answered as
+		// they are; the rest are not sent.
+		bool bFromReady = false;
+		for (int32 i = Lane->Active.Num() - 1; i >= 0; i--)
+		{
+			const FQueuedTxRef Unsent = Lane->Active[i];
+			if (Unsent->bInFlight || Unsent->Sequence < Tx->Sequence) continue;
+			bFromReady |= Ready.RemoveSingle(Unsent) > 0;
+			Delayed.RemoveSingleSwap(Unsent);
+			Lane->Active.RemoveAt(i);
+			OutDropped.Add(Unsent);
+		}
+		if (bFromReady)
+		{
+			Ready.Heapify(FSendOrder<FQueuedTxRef>());
+		}
+		for (int32 i = Lane->Waiting.Num() - 1; i >= 0; i--)
+		{
+			if (Lane->Waiting[i]->Sequence > Tx->Sequence)
+			{
+				OutDropped.Add(Lane->Waiting[i]);
+				Lane->Waiting.RemoveAt(i);
+			}
+		}
+		OutDropped.Sort([](const FQueuedTxRef& A, const FQueuedTxRef& B) { return A->Sequence < B->Sequence; });
+	}
+	ReleaseNext(*Lane);
+
+	if (Lane->Active.Num() == 0 && Lane->Waiting.Num() == 0)
+	{
+		Lanes.Remove(Tx->OrderingKey);
+	}
+}
+
+void UHazeTxSubmitter::ReleaseNext(FLane& Lane)
+{
+	if (Lane.Waiting.Num() == 0 || Lane.Active.Num() >= FMath::Max(1, MaxInFlightPerKey)) return;
+	// One at a time into Ready, so the heap cannot send a key's transactions out of order
+	for (const FQueuedTxRef& Released : Lane.Active)
+	{
+		if (!Released->bInFlight) return;
+	}
+	const FQueuedTxRef Next = Lane.Waiting[0];
+	if (Next->bAfterEarlier && Lane.Active.Num() > 0) return;
+	Next->bAfterEarlier = false;
+	Lane.Waiting.RemoveAt(0);
+	Lane.Active.Add(Next);
+	PushReady(Next);
+}
+
+void UHazeTxSubmitter::Requeue(const FQueuedTxRef& Tx)
+{
+	FLane& Lane = Lanes.FindChecked(Tx->OrderingKey);
+	Lane.Active.RemoveSingle(Tx);
+	Tx->bAfterEarlier = true;
+	// Lanes stay in enqueue order; others refused the same way may wait already
+	int32 Index = 0;
+	while (Index < Lane.Waiting.Num() && Lane.Waiting[Index]->Sequence < Tx->Sequence)
+	{
+		Index++;
+	}
+	Lane.Waiting.Insert(Tx, Index);
+	// Its removal may have left an earlier refused one free to go
+	ReleaseNext(Lane);
+}
+
+void UHazeTxSubmitter::CompleteDropped(TArray<FQueuedTxRef>& Dropped)
+{
+	if (Dropped.Num() == 0) return;
+	QueuedCount -= Dropped.Num();
+	DroppedTotal += Dropped.Num();
+	UpdateBackpressure();
+
+	FTransactionResponse DroppedResponse;
+	DroppedResponse.Status = TEXT("dropped");
+	for (const FQueuedTxRef& Tx : Dropped)
+	{
+		// The caller re-signs dropped transactions with fresh nonces; replaying the old ones would only be rejected
+		Acknowledge(*Tx);
+		Tx->OnComplete(false, DroppedResponse, 0);
+	}
+}
+
+void UHazeTxSubmitter::UpdateBackpressure()
+{
+	if (!bSaturated && QueuedCount >= HighWaterMark)
+	{
+		bSaturated = true;
+		OnBackpressure.Broadcast(true, QueuedCount);
+	}
+	else if (bSaturated && QueuedCount <= LowWaterMark)
+	{
+		bSaturated = false;
+		OnBackpressure.Broadcast(false, QueuedCount);
+	}
+}
+
+void UHazeTxSubmitter::EnsureTicking()
+{
+	if (TickHandle.IsValid()) return;
+	SampleStart = FPlatformTime::Seconds();
+	AcceptedInSample = 0;
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UHazeTxSubmitter::Tick));
+}
+
+void UHazeTxSubmitter::ResumeRetries(double Now)
+{
+	bool bPromoted = false;
+	for (int32 i = Delayed.Num() - 1; i >= 0; i--)
+	{
+		if (Delayed[i]->NotBefore <= Now)
+		{
+			PushReady(Delayed[i]);
+			Delayed.RemoveAtSwap(i);
+			bPromoted = true;
+		}
+	}
+	if (bPromoted)
+	{
+		Pump();
+	}
+}
+
+bool UHazeTxSubmitter::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	ResumeRetries(Now);
+
+	const double Elapsed = Now - SampleStart;
+	if (Elapsed >= 1.0)
+	{
+		const float Rate = static_cast<float>(AcceptedInSample / Elapsed);
+		AcceptedPerSecond = AcceptedPerSecond > 0.f ? 0.5f * (AcceptedPerSecond + Rate) : Rate;
+		AcceptedInSample = 0;
+		SampleStart = Now;
+	}
+
+	if (QueuedCount == 0 && InFlight == 0)
+	{
+		AcceptedPerSecond = 0.f;
+		TickHandle.Reset();
+		return false;
+	}
+	return true;
+}
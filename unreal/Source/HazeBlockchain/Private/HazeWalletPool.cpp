@@ -0,0 +1,266 @@
+// Copyright HAZE Blockchain. Contiguous pool of Ed25519 wallets for server-side bulk signing.
+
+#include "HazeWalletPool.h"
+#include "HazeHex.h"
+#include "HazeSecureMemory.h"
+#include "KeyPair.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+namespace
+{
+	/** Below this many wallets the work runs on the calling thread; task dispatch would cost more than it saves. */
+	constexpr int32 MinParallelBatch = 4;
+
+	EParallelForFlags BatchFlags(int32 Num)
+	{
+		return Num < MinParallelBatch ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	}
+}
+
+FHazeWalletPool::~FHazeWalletPool()
+{
+	for (FSlot* Chunk : Chunks)
+	{
+		HazeSecureMemory::Free(Chunk, SlotsPerChunk * sizeof(FSlot));
+	}
+}
+
+FHazeWalletPool::FSlot& FHazeWalletPool::SlotAt(int32 Index) const
+{
+	return Chunks[Index / SlotsPerChunk][Index % SlotsPerChunk];
+}
+
+const FHazeWalletPool::FSlot* FHazeWalletPool::Find(FHazeWalletHandle Wallet) const
+{
+	if (Wallet.Index < 0 || Wallet.Index >= Generations.Num()) return nullptr;
+	if (!Live[Wallet.Index] || Generations[Wallet.Index] != Wallet.Generation) return nullptr;
+	return &SlotAt(Wallet.Index);
+}
+
+void FHazeWalletPool::Release(int32 Index)
+{
+	HazeSecureMemory::Zero(&SlotAt(Index), sizeof(FSlot));
+	Generations[Index]++;
+	FreeSlots.Add(Index);
+}
+
+TArray<FHazeWalletHandle> FHazeWalletPool::Add(int32 Count, TFunctionRef<bool(int32 Index, uint8* OutSeed)> FillSeed)
+{
+	TArray<FHazeWalletHandle> Handles;
+	Handles.SetNum(FMath::Max(0, Count));
+	if (Handles.Num() == 0) return Handles;
+
+	// Reserve and seed the slots; nobody else touches a slot until it is published, and chunks never move
+	TArray<FSlot*> Slots;
+	Slots.SetNumZeroed(Handles.Num());
+	{
+		FWriteScopeLock ScopeLock(Lock);
+		for (int32 i = 0; i < Handles.Num(); i++)
+		{
+			int32 Index;
+			if (FreeSlots.Num() > 0)
+			{
+				Index = FreeSlots.Pop();
+			}
+			else
+			{
+				Index = Generations.Num();
+				if (Index % SlotsPerChunk == 0)
+				{
+					FSlot* Chunk = static_cast<FSlot*>(HazeSecureMemory::Allocate(SlotsPerChunk * sizeof(FSlot)));
+					if (!Chunk) break;
+					Chunks.Add(Chunk);
+				}
+				Generations.Add(0);
+				Live.Add(false);
+			}
+			if (FillSeed(i, SlotAt(Index).Seed))
+			{
+				Slots[i] = &SlotAt(Index);
+				Handles[i].Index = Index;
+				Handles[i].Generation = Generations[Index];
+			}
+			else
+			{
+				Release(Index);
+			}
+		}
+	}
+
+	// Derivation (SHA-512 and a scalar multiplication per key) runs without the lock
+	TArray<bool> Derived;
+	Derived.SetNumZeroed(Handles.Num());
+	ParallelFor(Handles.Num(), [&](int32 i)
+	{
+		if (FSlot* Slot = Slots[i])
+		{
+			Derived[i] = FHazeSignerContext::DeriveKeys(Slot->Seed, Slot->PublicKey, Slot->ExpandedKey);
+		}
+	}, BatchFlags(Handles.Num()));
+
+	FWriteScopeLock ScopeLock(Lock);
+	for (int32 i = 0; i < Handles.Num(); i++)
+	{
+		if (!Handles[i].IsSet()) continue;
+		if (Derived[i])
+		{
+			Live[Handles[i].Index] = true;
+			LiveCount++;
+		}
+		else
+		{
+			Release(Handles[i].Index);
+			Handles[i] = FHazeWalletHandle();
+		}
+	}
+	return Handles;
+}
+
+TArray<FHazeWalletHandle> FHazeWalletPool::Generate(int32 Count)
+{
+	return Add(Count, [](int32, uint8* OutSeed)
+	{
+		FPlatformMisc::GenRandom(OutSeed, FHazeSignerContext::SeedSize);
+		return true;
+	});
+}
+
+TArray<FHazeWalletHandle> FHazeWalletPool::Import(TArrayView<const uint8> Seeds)
+{
+	return Add(Seeds.Num() / FHazeSignerContext::SeedSize, [&Seeds](int32 i, uint8* OutSeed)
+	{
+		FMemory::Memcpy(OutSeed, Seeds.GetData() + i * FHazeSignerContext::SeedSize, FHazeSignerContext::SeedSize);
+		return true;
+	});
+}
+
+TArray<FHazeWalletHandle> FHazeWalletPool::ImportHex(TArrayView<const FString> SeedsHex)
+{
+	return Add(SeedsHex.Num(), [&SeedsHex](int32 i, uint8* OutSeed)
+	{
+		return FHazeHex::DecodeLenient(SeedsHex[i], OutSeed, FHazeSignerContext::SeedSize) == FHazeSignerContext::SeedSize;
+	});
+}
+
+FHazeWalletHandle FHazeWalletPool::Import(const UHazeKeyPair* KeyPair)
+{
+	if (!KeyPair || KeyPair->PrivateKey.Num() != FHazeSignerContext::SeedSize) return FHazeWalletHandle();
+	return Import(MakeArrayView(KeyPair->PrivateKey))[0];
+}
+
+bool FHazeWalletPool::Remove(FHazeWalletHandle Wallet)
+{
+	FWriteScopeLock ScopeLock(Lock);
+	if (!Find(Wallet)) return false;
+	Live[Wallet.Index] = false;
+	LiveCount--;
+	Release(Wallet.Index);
+	return true;
+}
+
+bool FHazeWalletPool::IsValid(FHazeWalletHandle Wallet) const
+{
+	FReadScopeLock ScopeLock(Lock);
+	return Find(Wallet) != nullptr;
+}
+
+int32 FHazeWalletPool::Num() const
+{
+	FReadScopeLock ScopeLock(Lock);
+	return LiveCount;
+}
+
+int32 FHazeWalletPool::GetSlotCount() const
+{
+	FReadScopeLock ScopeLock(Lock);
+	return Generations.Num();
+}
+
+FHazeWalletHandle FHazeWalletPool::GetHandle(int32 Index) const
+{
+	FReadScopeLock ScopeLock(Lock);
+	FHazeWalletHandle Wallet;
+	if (Index >= 0 && Index < Generations.Num() && Live[Index])
+	{
+		Wallet.Index = Index;
+		Wallet.Generation = Generations[Index];
+	}
+	return Wallet;
+}
+
+FHazeSignerView FHazeWalletPool::GetSigner(FHazeWalletHandle Wallet) const
+{
+	FReadScopeLock ScopeLock(Lock);
+	const FSlot* Slot = Find(Wallet);
+	return Slot ? FHazeSignerView(Slot->PublicKey, Slot->ExpandedKey) : FHazeSignerView();
+}
+
+TArray<FHazeSignerView> FHazeWalletPool::GetSigners(TArrayView<const FHazeWalletHandle> Wallets) const
+{
+	TArray<FHazeSignerView> Signers;
+	Signers.SetNum(Wallets.Num());
+	FReadScopeLock ScopeLock(Lock);
+	for (int32 i = 0; i < Wallets.Num(); i++)
+	{
+		if (const FSlot* Slot = Find(Wallets[i]))
+		{
+			Signers[i] = FHazeSignerView(Slot->PublicKey, Slot->ExpandedKey);
+		}
+	}
+	return Signers;
+}
+
+FString FHazeWalletPool::GetAddressHex(FHazeWalletHandle Wallet) const
+{
+	const FHazeSignerView Signer = GetSigner(Wallet);
+	return Signer.IsValid() ? FHazeHex::ToHex(Signer.GetPublicKey()) : FString();
+}
+
+bool FHazeWalletPool::Sign(FHazeWalletHandle Wallet, const uint8* Message, int32 MessageLen, uint8* OutSignature) const
+{
+	return GetSigner(Wallet).Sign(Message, MessageLen, OutSignature);
+}
+
+int32 FHazeWalletPool::SignBatch(TArrayView<const FHazeWalletHandle> Wallets, TArrayView<const TArrayView<const uint8>> Messages, TArray<uint8>& OutSignatures) const
+{
+	const int32 Num = FMath::Min(Wallets.Num(), Messages.Num());
+	OutSignatures.SetNumZeroed(Num * FHazeSignerContext::SignatureSize);
+	const TArray<FHazeSignerView> Signers = GetSigners(Wallets.Slice(0, Num));
+
+	std::atomic<int32> Signed{0};
+	ParallelFor(Num, [&](int32 i)
+	{
+		uint8* Signature = OutSignatures.GetData() + i * FHazeSignerContext::SignatureSize;
+		if (Signers[i].Sign(Messages[i].GetData(), Messages[i].Num(), Signature))
+		{
+			Signed++;
+		}
+		else
+		{
+			FMemory::Memzero(Signature, FHazeSignerContext::SignatureSize);
+		}
+	}, BatchFlags(Num));
+	return Signed;
+}
+
+UHazeKeyPair* FHazeWalletPool::CreateKeyPair(FHazeWalletHandle Wallet) const
+{
+	check(IsInGameThread());
+	uint8 Seed[FHazeSignerContext::SeedSize];
+	uint8 PublicKey[FHazeSignerContext::PublicKeySize];
+	{
+		FReadScopeLock ScopeLock(Lock);
+		const FSlot* Slot = Find(Wallet);
+		if (!Slot) return nullptr;
+		FMemory::Memcpy(Seed, Slot->Seed, sizeof(Seed));
+		FMemory::Memcpy(PublicKey, Slot->PublicKey, sizeof(PublicKey));
+	}
+	UHazeKeyPair* KeyPair = NewObject<UHazeKeyPair>();
+	KeyPair->PrivateKey.Append(Seed, sizeof(Seed));
+	KeyPair->PublicKey.Append(PublicKey, sizeof(PublicKey));
+	HazeSecureMemory::Zero(Seed, sizeof(Seed));
+	return KeyPair;
+}
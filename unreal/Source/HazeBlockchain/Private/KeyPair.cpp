@@ -2,42 +2,11 @@
 
 #include "KeyPair.h"
 #include "TransactionSigning.h"
-#include "Misc/Parse.h"
+#include "HazeHex.h"
+#include "HazeSecureMemory.h"
 #include "Misc/SecureHash.h"
 #include "HAL/PlatformMisc.h"
-
-// Optional: link against ThirdParty/ed25519 when available
-#if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
-extern "C" {
-	void ed25519_seed_keypair(const uint8_t seed[32], uint8_t public_key[32], uint8_t private_key[64]);
-	void ed25519_sign(uint8_t signature[64], const uint8_t* message, size_t message_len, const uint8_t public_key[32], const uint8_t private_key[64]);
-}
-#endif
-
-static TArray<uint8> HexToBytes(const FString& Hex)
-{
-	TArray<uint8> Out;
-	Out.SetNum(Hex.Len() / 2);
-	for (int32 i = 0; i < Out.Num(); i++)
-	{
-		int32 A = FParse::HexDigit(Hex[i * 2]);
-		int32 B = FParse::HexDigit(Hex[i * 2 + 1]);
-		if (A < 0 || B < 0) return TArray<uint8>();
-		Out[i] = static_cast<uint8>((A << 4) | B);
-	}
-	return Out;
-}
-
-static FString BytesToHex(const TArray<uint8>& Bytes)
-{
-	FString Hex;
-	Hex.Reserve(Bytes.Num() * 2);
-	for (uint8 B : Bytes)
-	{
-		Hex += FString::Printf(TEXT("%02x"), B);
-	}
-	return Hex;
-}
+#include "Misc/ScopeLock.h"
 
 bool UHazeKeyPair::IsSigningAvailable()
 {
@@ -56,12 +25,11 @@ UHazeKeyPair* UHazeKeyPair::Generate()
 	FPlatformMisc::GenRandom(K->PrivateKey.GetData(), 32);
 
 #if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
-	uint8 PublicKey[32];
-	uint8 PrivateKeyExpanded[64];
-	ed25519_seed_keypair(K->PrivateKey.GetData(), PublicKey, PrivateKeyExpanded);
+	// Keep only 32-byte seed in PrivateKey (our API); the 64-byte expanded key stays in the signer context
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Ctx = K->GetSigner();
+	if (!Ctx) return nullptr;
 	K->PublicKey.SetNum(32);
-	FMemory::Memcpy(K->PublicKey.GetData(), PublicKey, 32);
-	// Keep only 32-byte seed in PrivateKey (our API); ed25519 uses 64-byte expanded internally but we restore from 32-byte seed)
+	FMemory::Memcpy(K->PublicKey.GetData(), Ctx->GetPublicKey(), 32);
 #else
 	// Stub: no Ed25519; use hash of seed as fake "address" for display only
 	K->PublicKey.SetNum(32);
@@ -75,20 +43,23 @@ UHazeKeyPair* UHazeKeyPair::Generate()
 
 UHazeKeyPair* UHazeKeyPair::FromPrivateKeyHex(const FString& PrivateKeyHex)
 {
-	FString Hex = PrivateKeyHex.TrimStartAndEnd().Replace(TEXT(" "), TEXT(""));
-	if (Hex.Len() != 64) return nullptr;
-	TArray<uint8> Seed = HexToBytes(Hex);
-	if (Seed.Num() != 32) return nullptr;
+	uint8 Seed[32];
+	if (FHazeHex::DecodeLenient(PrivateKeyHex, Seed, 32) != 32)
+	{
+		// A failed decode can still leave part of the key behind
+		HazeSecureMemory::Zero(Seed, sizeof(Seed));
+		return nullptr;
+	}
 
 	UHazeKeyPair* K = NewObject<UHazeKeyPair>();
-	K->PrivateKey = MoveTemp(Seed);
+	K->PrivateKey.Append(Seed, 32);
+	HazeSecureMemory::Zero(Seed, sizeof(Seed));
 
 #if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
-	uint8 PublicKey[32];
-	uint8 PrivateKeyExpanded[64];
-	ed25519_seed_keypair(K->PrivateKey.GetData(), PublicKey, PrivateKeyExpanded);
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Ctx = K->GetSigner();
+	if (!Ctx) return nullptr;
 	K->PublicKey.SetNum(32);
-	FMemory::Memcpy(K->PublicKey.GetData(), PublicKey, 32);
+	FMemory::Memcpy(K->PublicKey.GetData(), Ctx->GetPublicKey(), 32);
 #else
 	K->PublicKey.SetNum(32);
 	uint8 Hash[32];
@@ -101,22 +72,50 @@ UHazeKeyPair* UHazeKeyPair::FromPrivateKeyHex(const FString& PrivateKeyHex)
 
 FString UHazeKeyPair::GetAddressHex() const
 {
-	return BytesToHex(PublicKey);
+	return FHazeHex::ToHex(PublicKey);
+}
+
+TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> UHazeKeyPair::GetSigner() const
+{
+	if (PrivateKey.Num() != 32) return nullptr;
+	FScopeLock Lock(&SignerLock);
+	if (Signer.IsValid() && Signer->MatchesSeed(PrivateKey.GetData()))
+	{
+		return Signer;
+	}
+	// Contexts other threads still sign with stay as they are; the old one is freed with its last holder
+	TSharedRef<FHazeSignerContext, ESPMode::ThreadSafe> Fresh = MakeShared<FHazeSignerContext, ESPMode::ThreadSafe>();
+	if (!Fresh->Initialize(PrivateKey.GetData()))
+	{
+		return nullptr;
+	}
+	Signer = Fresh;
+	return Signer;
+}
+
+bool UHazeKeyPair::SignTo(const uint8* Message, int32 MessageLen, uint8* OutSignature) const
+{
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Ctx = GetSigner();
+	return Ctx && Ctx->Sign(Message, MessageLen, OutSignature);
 }
 
 TArray<uint8> UHazeKeyPair::Sign(const TArray<uint8>& Message) const
 {
 	TArray<uint8> Signature;
-#if defined(HAZE_HAS_ED25519) && HAZE_HAS_ED25519
-	if (PrivateKey.Num() != 32) return Signature;
-	uint8 PublicKeyBuf[32];
-	uint8 PrivateKeyExpanded[64];
-	ed25519_seed_keypair(PrivateKey.GetData(), PublicKeyBuf, PrivateKeyExpanded);
-	Signature.SetNum(64);
-	ed25519_sign(Signature.GetData(), Message.GetData(), Message.Num(), PublicKeyBuf, PrivateKeyExpanded);
-#else
-	// Stub: return empty when Ed25519 not linked
-	(void)Message;
-#endif
+	Signature.SetNumUninitialized(FHazeSignerContext::SignatureSize);
+	if (!SignTo(Message.GetData(), Message.Num(), Signature.GetData()))
+	{
+		// Stub: return empty when Ed25519 not linked
+		Signature.Reset();
+	}
 	return Signature;
 }
+
+void UHazeKeyPair::BeginDestroy()
+{
+	{
+		FScopeLock Lock(&SignerLock);
+		Signer.Reset();
+	}
+	Super::BeginDestroy();
+}
@@ -0,0 +1,125 @@
+// Copyright HAZE Blockchain. Projected balances over pending transfers, settlement and rollback.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAccountLedger.h"
+#include "HazeAsync.h"
+#include "HazeChainFollower.h"
+
+namespace
+{
+	const TCHAR* const Alice = TEXT("aa00");
+	const TCHAR* const Bob = TEXT("bb00");
+
+	FAccountInfo MakeAccount(uint64 Balance, int32 Nonce)
+	{
+		FAccountInfo Info;
+		Info.Balance = FHazeAmount(Balance);
+		Info.Nonce = Nonce;
+		return Info;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAccountLedgerProjectionTest, "HAZE.Ledger.Projection", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAccountLedgerProjectionTest::RunTest(const FString& Parameters)
+{
+	// No client: nothing is fetched, accounts arrive through ApplyAccount
+	UHazeAccountLedger* Ledger = UHazeAccountLedger::CreateAccountLedger(nullptr);
+	Ledger->Watch(TEXT("AA00"));
+	Ledger->Watch(Bob);
+	FAccountInfo Info;
+	TestFalse(TEXT("Nothing fetched yet"), Ledger->GetConfirmedAccount(Alice, Info));
+	Ledger->ApplyAccount(Alice, MakeAccount(1000, 4));
+	Ledger->ApplyAccount(Bob, MakeAccount(50, 0));
+	TestTrue(TEXT("Confirmed"), Ledger->GetConfirmedAccount(TEXT("AA00"), Info) && Info.Balance == FHazeAmount(1000));
+
+	const int64 Transfer = Ledger->AddPendingTransfer(Alice, Bob, FHazeAmount(300), FHazeAmount(10));
+	TestTrue(TEXT("Entry"), Transfer > 0);
+	TestTrue(TEXT("Sender pays amount and fee"), Ledger->GetProjectedBalance(Alice) == FHazeAmount(690));
+	TestTrue(TEXT("Receiver credited"), Ledger->GetProjectedBalance(Bob) == FHazeAmount(350));
+	TestEqual(TEXT("Projected nonce"), Ledger->GetProjectedNonce(Alice), 5ll);
+	TestEqual(TEXT("Incoming does not use a nonce"), Ledger->GetProjectedNonce(Bob), 0ll);
+
+	// Incoming funds outgoing; an overdraft shows zero
+	Ledger->AddPendingTransfer(Bob, TEXT("cc00"), FHazeAmount(340), FHazeAmount(10));
+	TestTrue(TEXT("Incoming funds outgoing"), Ledger->GetProjectedBalance(Bob).IsZero());
+	const int64 Overdraft = Ledger->AddPendingTransfer(Alice, TEXT("cc00"), FHazeAmount(5000), FHazeAmount(0));
+	TestTrue(TEXT("Never below zero"), Ledger->GetProjectedBalance(Alice).IsZero());
+	TestEqual(TEXT("Unwatched addresses"), Ledger->AddPendingTransfer(TEXT("cc00"), TEXT("dd00"), FHazeAmount(1), FHazeAmount(1)), 0ll);
+
+	// Rejected: rolled back
+	Ledger->Fail(Overdraft);
+	TestTrue(TEXT("Rolled back"), Ledger->GetProjectedBalance(Alice) == FHazeAmount(690));
+	Ledger->Fail(Overdraft);
+	TestEqual(TEXT("Fail once"), Ledger->GetPendingCount(Alice), 1);
+
+	// Not included yet: a fetch keeps the entry on top of the new confirmed state
+	Ledger->SetTransactionHash(Transfer, TEXT("TX01"));
+	Ledger->ApplyAccount(Alice, MakeAccount(1200, 4));
+	TestTrue(TEXT("Still pending over the new balance"), Ledger->GetProjectedBalance(Alice) == FHazeAmount(890));
+
+	// Included: the next fetch has it, per account
+	Ledger->MarkIncluded(TEXT("tx01"));
+	TestEqual(TEXT("Projected until fetched"), Ledger->GetPendingCount(Alice), 1);
+	Ledger->ApplyAccount(Alice, MakeAccount(890, 5));
+	TestEqual(TEXT("Settled for the sender"), Ledger->GetPendingCount(Alice), 0);
+	TestTrue(TEXT("Confirmed balance"), Ledger->GetProjectedBalance(Alice) == FHazeAmount(890));
+	TestEqual(TEXT("Receiver still counts it"), Ledger->GetPendingCount(Bob), 2);
+	Ledger->ApplyAccount(Bob, MakeAccount(350, 0));
+	TestEqual(TEXT("Settled for the receiver"), Ledger->GetPendingCount(Bob), 1);
+
+	Ledger->Unwatch(Bob);
+	TestTrue(TEXT("Unwatched"), Ledger->GetProjectedBalance(Bob).IsZero() && Ledger->GetPendingCount(Bob) == 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAccountLedgerFollowerTest, "HAZE.Ledger.Follower", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAccountLedgerFollowerTest::RunTest(const FString& Parameters)
+{
+	UHazeAccountLedger* Ledger = UHazeAccountLedger::CreateAccountLedger(nullptr);
+	UHazeChainFollower* Follower = UHazeChainFollower::CreateChainFollower(nullptr);
+	Ledger->Watch(Alice);
+	Ledger->ApplyAccount(Alice, MakeAccount(100, 0));
+
+	const int64 Entry = Ledger->AddPendingTransfer(Alice, Bob, FHazeAmount(40), FHazeAmount(1));
+	Ledger->SetTransactionHash(Entry, TEXT("aa01"));
+	// Entries with a hash before binding are tracked too
+	Ledger->BindChainFollower(Follower);
+	TestEqual(TEXT("Tracked on the follower"), Follower->GetTrackedCount(), 1);
+	// Someone else waiting on the same hash does not take the ledger's place
+	THazeFuture<FHazeReceipt> Waited = HazeAsync::WaitForReceipt(Follower, TEXT("aa01"));
+
+	FHazeBlockInfo Block;
+	Block.Height = 5;
+	Block.Hash = TEXT("a-5");
+	Block.Transactions = { TEXT("aa01") };
+	Follower->ApplyBlock(Block);
+	TestTrue(TEXT("Waiter confirmed"), Waited.IsReady() && Waited.Get());
+
+	// The block was replaced before the account was fetched: the entry keeps counting
+	FHazeBlockInfo Replacement;
+	Replacement.Height = 5;
+	Replacement.Hash = TEXT("b-5");
+	Follower->ApplyBlock(Replacement);
+	Ledger->ApplyAccount(Alice, MakeAccount(100, 0));
+	TestTrue(TEXT("Reverted stays projected"), Ledger->GetPendingCount(Alice) == 1 && Ledger->GetProjectedBalance(Alice) == FHazeAmount(59));
+
+	Block.Height = 6;
+	Block.Hash = TEXT("b-6");
+	Block.ParentHash = TEXT("b-5");
+	Follower->ApplyBlock(Block);
+	Ledger->ApplyAccount(Alice, MakeAccount(59, 1));
+	TestEqual(TEXT("Settled"), Ledger->GetPendingCount(Alice), 0);
+	// The waiter tracked it too, so the follower keeps it until final
+	TestEqual(TEXT("Still followed for the waiter"), Follower->GetTrackedCount(), 1);
+	Follower->ApplyFinalizedHeight(6);
+	TestEqual(TEXT("Dropped once final"), Follower->GetTrackedCount(), 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright HAZE Blockchain. Local swap quotes against the node's own vectors, and pool decoding.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAmm.h"
+#include "HazeResponseParser.h"
+#include "HazeTestResponses.h"
+
+using HazeTestResponses::Utf8;
+
+namespace
+{
+	/** The pool of test_swap_quote_vectors in src/economy.rs */
+	FLiquidityPool GoldPool()
+	{
+		FLiquidityPool Pool;
+		Pool.PoolId = TEXT("pool:HAZE:GOLD");
+		Pool.Asset1 = TEXT("HAZE");
+		Pool.Asset2 = TEXT("GOLD");
+		Pool.Reserve1 = FHazeAmount(1000000);
+		Pool.Reserve2 = FHazeAmount(2000000);
+		Pool.FeeRate = 30;
+		return Pool;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAmmQuoteTest, "HAZE.Amm.Quote", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAmmQuoteTest::RunTest(const FString& Parameters)
+{
+	// Same sequence as the node's test, so the two cannot drift apart unnoticed
+	FLiquidityPool Pool = GoldPool();
+	FHazeSwapQuote Quote;
+	TestTrue(TEXT("HAZE in"), FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), FHazeAmount(10000), Quote) == EHazeSwapQuoteStatus::Ok);
+	TestTrue(TEXT("Fee"), Quote.Fee == FHazeAmount(30));
+	TestTrue(TEXT("Out"), Quote.AmountOut == FHazeAmount(19744));
+	TestEqual(TEXT("Asset out"), Quote.AssetOut, TEXT("GOLD"));
+	TestTrue(TEXT("Price impact"), Quote.PriceImpact > 0.012f && Quote.PriceImpact < 0.013f);
+	FHazeAmm::ApplyQuote(Pool, Quote);
+	TestTrue(TEXT("Reserves after HAZE in"), Pool.Reserve1 == FHazeAmount(1009970) && Pool.Reserve2 == FHazeAmount(1980256));
+
+	TestTrue(TEXT("GOLD in"), FHazeAmm::QuoteExactIn(Pool, TEXT("GOLD"), FHazeAmount(333), Quote) == EHazeSwapQuoteStatus::Ok);
+	TestTrue(TEXT("Out (floored)"), Quote.AmountOut == FHazeAmount(170));
+	FHazeAmm::ApplyQuote(Pool, Quote);
+	TestTrue(TEXT("Reserves after GOLD in"), Pool.Reserve1 == FHazeAmount(1009800) && Pool.Reserve2 == FHazeAmount(1980589));
+
+	TestTrue(TEXT("One unit"), FHazeAmm::QuoteExactIn(Pool, TEXT("GOLD"), FHazeAmount(1), Quote) == EHazeSwapQuoteStatus::Ok && Quote.AmountOut == FHazeAmount(1));
+	TestTrue(TEXT("Zero in"), FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), FHazeAmount(), Quote) == EHazeSwapQuoteStatus::InsufficientLiquidity);
+	TestTrue(TEXT("Unknown asset"), FHazeAmm::QuoteExactIn(Pool, TEXT("SILVER"), FHazeAmount(5), Quote) == EHazeSwapQuoteStatus::AssetNotInPool);
+	FHazeAmm::ApplyQuote(Pool, Quote);
+	TestTrue(TEXT("Invalid quote does not move reserves"), Pool.Reserve1 == FHazeAmount(1009800));
+
+	// amount_in * fee_rate and reserve_in + amount_in are u64 on the node
+	TestTrue(TEXT("Fee product overflows"), FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), FHazeAmount(MAX_uint64 / 2), Quote) == EHazeSwapQuoteStatus::OutOfRange);
+	Pool.FeeRate = 0;
+	TestTrue(TEXT("Reserve overflows"), FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), FHazeAmount(MAX_uint64), Quote) == EHazeSwapQuoteStatus::OutOfRange);
+	TestTrue(TEXT("Reserve wraps 128 bits"), FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), FHazeAmount::MaxValue() - Pool.Reserve1 + FHazeAmount(1), Quote) == EHazeSwapQuoteStatus::OutOfRange);
+	TestTrue(TEXT("Largest amount"), FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), FHazeAmount::MaxValue(), Quote) == EHazeSwapQuoteStatus::OutOfRange);
+
+	// Exact out is the least input that reaches the output
+	Pool = GoldPool();
+	TestTrue(TEXT("Exact out"), FHazeAmm::QuoteExactOut(Pool, TEXT("HAZE"), FHazeAmount(19744), Quote) == EHazeSwapQuoteStatus::Ok);
+	const FHazeAmount Needed = Quote.AmountIn;
+	TestTrue(TEXT("Exact out reaches"), Quote.AmountOut >= FHazeAmount(19744) && Needed <= FHazeAmount(10000));
+	FHazeAmm::QuoteExactIn(Pool, TEXT("HAZE"), Needed - FHazeAmount(1), Quote);
+	TestTrue(TEXT("Exact out is minimal"), Quote.AmountOut < FHazeAmount(19744));
+	TestTrue(TEXT("Exact out past reserve"), FHazeAmm::QuoteExactOut(Pool, TEXT("HAZE"), FHazeAmount(2000001), Quote) == EHazeSwapQuoteStatus::InsufficientLiquidity);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeParsePoolsTest, "HAZE.Response.Pools", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeParsePoolsTest::RunTest(const FString& Parameters)
+{
+	TArray<FLiquidityPool> Pools;
+	TestTrue(TEXT("Pools"), HazeResponse::ParseLiquidityPools(Utf8(HazeTestResponses::LiquidityPools), Pools));
+	if (TestEqual(TEXT("Pool count"), Pools.Num(), 2))
+	{
+		TestEqual(TEXT("Pool id"), Pools[0].PoolId, TEXT("pool:HAZE:GOLD"));
+		TestTrue(TEXT("Reserves"), Pools[0].Reserve1 == FHazeAmount(1000000) && Pools[0].Reserve2 == FHazeAmount(2000000));
+		TestEqual(TEXT("Fee rate"), Pools[0].FeeRate, 30);
+		TestTrue(TEXT("u64 reserve"), Pools[1].Reserve1 == FHazeAmount(MAX_uint64));
+	}
+
+	FLiquidityPool Pool;
+	TestTrue(TEXT("Pool"), HazeResponse::ParseLiquidityPool(Utf8(HazeTestResponses::LiquidityPool), Pool));
+	TestTrue(TEXT("Pool reserves"), Pool.Reserve1 == FHazeAmount(1009970) && Pool.Reserve2 == FHazeAmount(1980256));
+	TestFalse(TEXT("Missing pool"), HazeResponse::ParseLiquidityPool(Utf8(R"({"success":false,"data":null,"error":"Pool not found"})"), Pool));
+
+	FHazeStreamEvent Event;
+	TestTrue(TEXT("pool_updated"), HazeResponse::ParseStreamEvent(Utf8(HazeTestResponses::PoolUpdatedEvent), Event));
+	TestTrue(TEXT("Event type"), Event.Type == EHazeStreamEventType::PoolUpdated);
+	TestEqual(TEXT("Event pool"), Event.Pool.PoolId, TEXT("pool:HAZE:GOLD"));
+	TestTrue(TEXT("Event reserves"), Event.Pool.Reserve2 == FHazeAmount(1980256) && Event.Pool.FeeRate == 30);
+	return true;
+}
+
+#endif
@@ -0,0 +1,94 @@
+// Copyright HAZE Blockchain. FHazeAmount parse, format and arithmetic.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAmount.h"
+#include "HazeAmountLibrary.h"
+
+namespace
+{
+	const TCHAR* const MaxDecimal = TEXT("340282366920938463463374607431768211455");
+
+	FHazeAmount Amount(const TCHAR* Digits)
+	{
+		FHazeAmount Out;
+		verify(FHazeAmount::Parse(Digits, Out));
+		return Out;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAmountParseTest, "HAZE.Amount.ParseFormat", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAmountParseTest::RunTest(const FString& Parameters)
+{
+	for (const TCHAR* Digits : { TEXT("0"), TEXT("7"), TEXT("18446744073709551615"), TEXT("18446744073709551616"),
+		TEXT("1000000000000000000000000000000"), MaxDecimal })
+	{
+		TestEqual(Digits, Amount(Digits).ToString(), Digits);
+	}
+	TestTrue(TEXT("2^64"), Amount(TEXT("18446744073709551616")) == FHazeAmount::FromParts(1, 0));
+	TestTrue(TEXT("Max"), Amount(MaxDecimal) == FHazeAmount::MaxValue());
+	TestEqual(TEXT("Leading zeros"), Amount(TEXT("0000000000000000000000000000000000000000042")).ToString(), TEXT("42"));
+
+	FHazeAmount Out(5);
+	TestFalse(TEXT("Empty"), FHazeAmount::Parse(TEXT(""), Out));
+	TestFalse(TEXT("Sign"), FHazeAmount::Parse(TEXT("-1"), Out));
+	TestFalse(TEXT("Fraction"), FHazeAmount::Parse(TEXT("1.5"), Out));
+	TestFalse(TEXT("Exponent"), FHazeAmount::Parse(TEXT("1e18"), Out));
+	TestFalse(TEXT("One past max"), FHazeAmount::Parse(TEXT("340282366920938463463374607431768211456"), Out));
+	TestFalse(TEXT("40 digits"), FHazeAmount::Parse(TEXT("1000000000000000000000000000000000000000"), Out));
+	TestTrue(TEXT("Out unchanged on failure"), Out == FHazeAmount(5));
+
+	TCHAR Chars[FHazeAmount::MaxDigits];
+	TestEqual(TEXT("ToChars length"), FHazeAmount::MaxValue().ToChars(Chars), FHazeAmount::MaxDigits);
+
+	TestEqual(TEXT("Display"), Amount(TEXT("1234500000000000000")).ToDisplayString(), TEXT("1.2345"));
+	TestEqual(TEXT("Display truncates"), Amount(TEXT("1999999999999999999")).ToDisplayString(18, 2), TEXT("1.99"));
+	TestEqual(TEXT("Display whole"), Amount(TEXT("3000000000000000000")).ToDisplayString(), TEXT("3"));
+	TestEqual(TEXT("Display below one"), Amount(TEXT("5000000000000000")).ToDisplayString(), TEXT("0.005"));
+	TestEqual(TEXT("Display dust"), FHazeAmount(5).ToDisplayString(), TEXT("0"));
+	TestEqual(TEXT("Display no decimals"), FHazeAmount(1234).ToDisplayString(0, 4), TEXT("1234"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAmountArithmeticTest, "HAZE.Amount.Arithmetic", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAmountArithmeticTest::RunTest(const FString& Parameters)
+{
+	const FHazeAmount U64Max(MAX_uint64);
+	TestTrue(TEXT("Carry"), U64Max + FHazeAmount(1) == FHazeAmount::FromParts(1, 0));
+	TestTrue(TEXT("Borrow"), FHazeAmount::FromParts(1, 0) - FHazeAmount(1) == U64Max);
+	TestTrue(TEXT("Wraps"), FHazeAmount::MaxValue() + FHazeAmount(1) == FHazeAmount());
+	TestEqual(TEXT("u64 * u64"), (U64Max * U64Max).ToString(), TEXT("340282366920938463426481119284349108225"));
+	TestTrue(TEXT("Ordering"), FHazeAmount(MAX_uint64) < FHazeAmount::FromParts(1, 0));
+
+	// Constant product as the AMM computes it: k / (reserve_in + amount_in)
+	const FHazeAmount K = Amount(TEXT("1000000000000000000000")) * Amount(TEXT("2000000000000000000000"));
+	TestEqual(TEXT("k"), K.ToString(), TEXT("2000000000000000000000000000000000000000"));
+	TestEqual(TEXT("k / reserve"), (K / Amount(TEXT("1000000000000000000500"))).ToString(), TEXT("1999999999999999999000"));
+	TestEqual(TEXT("Remainder"), (FHazeAmount::MaxValue() % FHazeAmount(1000000007)).ToString(), TEXT("279632276"));
+	TestEqual(TEXT("Wide divisor"), (FHazeAmount::MaxValue() / FHazeAmount::FromParts(1, 0)).ToString(), TEXT("18446744073709551615"));
+	TestTrue(TEXT("Divide by zero"), (FHazeAmount(10) / FHazeAmount()).IsZero());
+
+	FHazeAmount Out;
+	TestFalse(TEXT("Add overflow"), FHazeAmount::TryAdd(FHazeAmount::MaxValue(), FHazeAmount(1), Out));
+	TestFalse(TEXT("Subtract underflow"), FHazeAmount::TrySubtract(FHazeAmount(1), FHazeAmount(2), Out));
+	TestFalse(TEXT("Multiply overflow"), FHazeAmount::TryMultiply(FHazeAmount::FromParts(1, 0), FHazeAmount::FromParts(1, 0), Out));
+	TestFalse(TEXT("Multiply overflow (cross term)"), FHazeAmount::TryMultiply(FHazeAmount::FromParts(MAX_uint64, 0), FHazeAmount(2), Out));
+	TestTrue(TEXT("Multiply fits"), FHazeAmount::TryMultiply(FHazeAmount::FromParts(1, 0), U64Max, Out) && Out == FHazeAmount::FromParts(MAX_uint64, 0));
+	Out = FHazeAmount(10);
+	TestTrue(TEXT("Checked add in place"), FHazeAmount::TryAdd(Out, Out, Out) && Out == FHazeAmount(20));
+	FHazeAmount Remainder;
+	TestFalse(TEXT("Checked divide by zero"), FHazeAmount::TryDivide(Out, FHazeAmount(), Out, Remainder));
+
+	TestTrue(TEXT("Blueprint add saturates"), UHazeAmountLibrary::Add_HazeAmountHazeAmount(FHazeAmount::MaxValue(), FHazeAmount(1)) == FHazeAmount::MaxValue());
+	TestTrue(TEXT("Blueprint subtract stops at zero"), UHazeAmountLibrary::Subtract_HazeAmountHazeAmount(FHazeAmount(1), FHazeAmount(2)).IsZero());
+	TestEqual(TEXT("Blueprint to int64 clamps"), UHazeAmountLibrary::ToInt64(U64Max), MAX_int64);
+	TestTrue(TEXT("Blueprint from negative"), UHazeAmountLibrary::Conv_Int64ToHazeAmount(-5).IsZero());
+	return true;
+}
+
+#endif
@@ -0,0 +1,211 @@
+// Copyright HAZE Blockchain. Paging, prefetch, end of results and column lookups of the asset search cursor.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAssetCursor.h"
+
+namespace
+{
+	/** Frames a step may wait for its page before the test gives up on it */
+	constexpr int32 MaxStepFrames = 100;
+
+	/** Search over Total results that holds every page request until the test answers it */
+	struct FHeldSearch
+	{
+		int32 Total = 0;
+		/** Offset of each request, in order */
+		TArray<int64> Offsets;
+		TArray<TPair<int64, FHazeOnAssetSearchPage>> Held;
+
+		UHazeAssetCursor* MakeCursor(int32 PageSize, bool bPrefetch)
+		{
+			FHazeAssetSearchQuery Query;
+			Query.PageSize = PageSize;
+			Query.bPrefetch = bPrefetch;
+			UHazeAssetCursor* Cursor = UHazeAssetCursor::CreateAssetCursor(Query, [this](const FHazeAssetSearchQuery&, int64 Offset, FHazeOnAssetSearchPage OnComplete)
+			{
+				Offsets.Add(Offset);
+				Held.Emplace(Offset, MoveTemp(OnComplete));
+			});
+			Cursor->AddToRoot();
+			return Cursor;
+		}
+
+		/** Entry i of the results: id i + 1, owner i % 5, game ids alternating, label "Item i" */
+		TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe> MakePage(int64 Offset, int32 PageSize) const
+		{
+			TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe> Page = MakeShared<FHazeAssetPage, ESPMode::ThreadSafe>();
+			Page->SetOffset(Offset);
+			for (int64 i = Offset; i < FMath::Min<int64>(Offset + PageSize, Total); i++)
+			{
+				const int32 Entry = Page->AddEntry();
+				Page->GetMutableAssetId(Entry)[FHazeAssetPage::IdSize - 1] = static_cast<uint8>(i + 1);
+				Page->GetMutableOwner(Entry)[FHazeAssetPage::IdSize - 1] = static_cast<uint8>(i % 5);
+				Page->SetDensity(Entry, i % 2 ? EDensityLevel::Light : EDensityLevel::Ethereal);
+				Page->SetGameId(Entry, i % 2 ? TEXT("haze-rpg") : TEXT("haze-kart"));
+				Page->SetLabel(Entry, FString::Printf(TEXT("Item %lld"), i));
+			}
+			return Page;
+		}
+
+		/** Answer the oldest held request */
+		void Answer(int32 PageSize, bool bOk = true)
+		{
+			TPair<int64, FHazeOnAssetSearchPage> Request = MoveTemp(Held[0]);
+			Held.RemoveAt(0);
+			Request.Value(bOk, bOk ? MakePage(Request.Key, PageSize) : nullptr);
+		}
+	};
+
+	/** Outcome of one NextPage */
+	struct FPageResult
+	{
+		bool bDone = false;
+		bool bOk = false;
+		TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe> Page;
+	};
+
+	TSharedRef<FPageResult> NextPage(UHazeAssetCursor* Cursor)
+	{
+		TSharedRef<FPageResult> Result = MakeShared<FPageResult>();
+		Cursor->NextPage([Result](bool bOk, const TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe>& Page)
+		{
+			Result->bDone = true;
+			Result->bOk = bOk;
+			Result->Page = Page;
+		});
+		return Result;
+	}
+
+	/**
+	 * Run Step, then wait for the page it asked for and check it with Check. Pages already at the cursor are handed
+	 * out on a later game thread tick, so every step is a latent command.
+	 */
+	void AddStep(FAutomationTestBase& Test, TFunction<TSharedRef<FPageResult>()> Step, TFunction<void(const FPageResult&)> Check)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&Test, Step = MoveTemp(Step), Check = MoveTemp(Check),
+			Result = TSharedPtr<FPageResult>(), Frames = 0]() mutable -> bool
+		{
+			if (!Result)
+			{
+				Result = Step();
+			}
+			if (!Result->bDone && ++Frames < MaxStepFrames) return false;
+			if (Test.TestTrue(TEXT("Page delivered"), Result->bDone))
+			{
+				Check(*Result);
+			}
+			return true;
+		}));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetCursorPagingTest, "HAZE.Search.CursorPaging", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetCursorPagingTest::RunTest(const FString& Parameters)
+{
+	// Seven results in pages of three: 0-2, 3-5, then a short page 6 that ends the search
+	constexpr int32 PageSize = 3;
+	TSharedRef<FHeldSearch> Search = MakeShared<FHeldSearch>();
+	Search->Total = 7;
+	UHazeAssetCursor* Cursor = Search->MakeCursor(PageSize, true);
+	TestTrue(TEXT("More before the first page"), Cursor->HasMore());
+
+	// Nothing is prefetched yet: the first page is requested and delivered as soon as it arrives
+	TSharedRef<FPageResult> First = NextPage(Cursor);
+	TestTrue(TEXT("First page requested"), Search->Offsets == TArray<int64>({ 0 }));
+	Search->Answer(PageSize);
+	TestTrue(TEXT("First page"), First->bDone && First->bOk && First->Page && First->Page->Num() == 3);
+	TestTrue(TEXT("Handing it out prefetches the next"), Search->Offsets == TArray<int64>({ 0, 3 }));
+
+	// Columns, through the Blueprint getters
+	TestEqual(TEXT("Count"), Cursor->GetCount(), 3);
+	TestEqual(TEXT("Label"), Cursor->GetLabel(2), TEXT("Item 2"));
+	TestEqual(TEXT("Game id"), Cursor->GetGameId(1), TEXT("haze-rpg"));
+	TestTrue(TEXT("Density"), Cursor->GetDensity(1) == EDensityLevel::Light);
+	TestEqual(TEXT("Asset id"), Cursor->GetAssetIdHex(0), FString::Printf(TEXT("%064x"), 1));
+	TestEqual(TEXT("Owner"), Cursor->GetOwnerHex(2), FString::Printf(TEXT("%064x"), 2));
+	TestTrue(TEXT("Out of range is empty"), Cursor->GetLabel(3).IsEmpty() && Cursor->GetLabel(-1).IsEmpty() && Cursor->GetGameId(3).IsEmpty());
+	TestEqual(TEXT("Find"), First->Page->Find(First->Page->GetAssetId(1)), 1);
+
+	// The prefetch lands while nobody waits; the next page comes from it without another request
+	Search->Answer(PageSize);
+	TestTrue(TEXT("More while a page is prefetched"), Cursor->HasMore());
+	const int32 FirstGameId = First->Page->GetGameIdIndex(0);
+	AddStep(*this, [Cursor]() { return NextPage(Cursor); }, [this, Search, Cursor, FirstGameId](const FPageResult& Second)
+	{
+		TestTrue(TEXT("Second page"), Second.bOk && Second.Page && Second.Page->Num() == 3);
+		TestEqual(TEXT("Second page offset"), Second.Page ? Second.Page->GetOffset() : -1, int64(3));
+		TestEqual(TEXT("Second page label"), Cursor->GetLabel(0), TEXT("Item 3"));
+		// Entry 3 is odd (haze-rpg), entry 4 even like entry 0 (haze-kart): same index across pages
+		TestEqual(TEXT("Game ids shared across pages"), Second.Page ? Second.Page->GetGameIdIndex(1) : INDEX_NONE, FirstGameId);
+		TestTrue(TEXT("Then the third is prefetched"), Search->Offsets == TArray<int64>({ 0, 3, 6 }));
+
+		// A short page ends the search, but it is still handed out
+		Search->Answer(PageSize);
+		TestTrue(TEXT("More until the short page is handed out"), Cursor->HasMore());
+	});
+	AddStep(*this, [Cursor]() { return NextPage(Cursor); }, [this, Search, Cursor](const FPageResult& Third)
+	{
+		TestTrue(TEXT("Short page"), Third.bOk && Third.Page && Third.Page->Num() == 1);
+		TestEqual(TEXT("Short page label"), Cursor->GetLabel(0), TEXT("Item 6"));
+		TestFalse(TEXT("No more after the short page"), Cursor->HasMore());
+		TestEqual(TEXT("Nothing prefetched past the end"), Search->Offsets.Num(), 3);
+	});
+	AddStep(*this, [Cursor]() { return NextPage(Cursor); }, [this, Search, Cursor](const FPageResult& End)
+	{
+		TestTrue(TEXT("End: an empty page"), End.bOk && End.Page && End.Page->Num() == 0);
+		TestEqual(TEXT("End: no request"), Search->Offsets.Num(), 3);
+		TestEqual(TEXT("End: count"), Cursor->GetCount(), 0);
+		Cursor->RemoveFromRoot();
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetCursorFailureTest, "HAZE.Search.CursorFailure", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetCursorFailureTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 PageSize = 2;
+	TSharedRef<FHeldSearch> Search = MakeShared<FHeldSearch>();
+	Search->Total = 10;
+	UHazeAssetCursor* Cursor = Search->MakeCursor(PageSize, true);
+
+	// A failed page fails the Next waiting for it; the next Next asks again from the same offset
+	TSharedRef<FPageResult> Failed = NextPage(Cursor);
+	Search->Answer(PageSize, false);
+	TestTrue(TEXT("Failed page reported"), Failed->bDone && !Failed->bOk && !Failed->Page);
+	TestTrue(TEXT("Still more"), Cursor->HasMore());
+
+	TSharedRef<FPageResult> Retried = NextPage(Cursor);
+	TestTrue(TEXT("Retried at the same offset"), Search->Offsets == TArray<int64>({ 0, 0 }));
+	Search->Answer(PageSize);
+	TestTrue(TEXT("Retry delivered"), Retried->bOk && Retried->Page && Retried->Page->GetOffset() == 0);
+
+	// A failed prefetch is dropped silently; the Next after it asks for that page again
+	TestTrue(TEXT("Prefetch requested"), Search->Offsets == TArray<int64>({ 0, 0, 2 }));
+	Search->Answer(PageSize, false);
+	TSharedRef<FPageResult> AfterPrefetch = NextPage(Cursor);
+	TestTrue(TEXT("Page asked for again"), Search->Offsets == TArray<int64>({ 0, 0, 2, 2 }));
+	Search->Answer(PageSize);
+	TestTrue(TEXT("Delivered after a failed prefetch"), AfterPrefetch->bOk && AfterPrefetch->Page && AfterPrefetch->Page->GetOffset() == 2);
+
+	// One Next at a time: a second one while the first waits fails without a request
+	TestEqual(TEXT("Prefetch of the third page"), Search->Held.Num(), 1);
+	Search->Answer(PageSize);
+	TSharedRef<FPageResult> Waiting = NextPage(Cursor);
+	TSharedRef<FPageResult> Overlapping = NextPage(Cursor);
+	AddStep(*this, [Overlapping]() { return Overlapping; }, [this, Search, Cursor, Waiting](const FPageResult& Second)
+	{
+		TestFalse(TEXT("Overlapping Next fails"), Second.bOk);
+		TestTrue(TEXT("The first still delivered"), Waiting->bDone && Waiting->bOk);
+		TestTrue(TEXT("Only the delivered page's prefetch"), Search->Offsets == TArray<int64>({ 0, 0, 2, 2, 4, 6 }));
+		Cursor->RemoveFromRoot();
+	});
+	return true;
+}
+
+#endif
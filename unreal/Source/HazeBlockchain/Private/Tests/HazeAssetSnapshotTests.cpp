@@ -0,0 +1,171 @@
+// Copyright HAZE Blockchain. Binary asset snapshot format and the store that refreshes its stale entries.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformFileManager.h"
+#include "HazeAssetSnapshot.h"
+
+namespace
+{
+	const TCHAR* const SwordId = TEXT("2222222222222222222222222222222222222222222222222222222222222222");
+	const TCHAR* const ShieldId = TEXT("0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A0A");
+	const TCHAR* const Root = TEXT("5f7a2c0e9b3d4a1f8e6c2b7d0a9f3e1c5b8d2a6f4e0c9b7d3a1f5e8c2b6d0a4f");
+
+	FHazeAssetAttribute MakeAttribute(const TCHAR* Name, const TCHAR* Value, float Rarity)
+	{
+		FHazeAssetAttribute Attribute;
+		Attribute.Name = Name;
+		Attribute.Value = Value;
+		Attribute.Rarity = Rarity;
+		return Attribute;
+	}
+
+	FHazeAssetSnapshotEntry MakeEntry(const TCHAR* AssetId, const TCHAR* Name, const TCHAR* GameId, uint64 Fingerprint)
+	{
+		FHazeAssetSnapshotEntry Entry;
+		Entry.Fingerprint = Fingerprint;
+		FHazeAssetInfo& Asset = Entry.Asset;
+		Asset.AssetId = AssetId;
+		Asset.Owner = TEXT("1111111111111111111111111111111111111111111111111111111111111111");
+		Asset.Density = EDensityLevel::Dense;
+		Asset.GameId = GameId;
+		Asset.CreatedAt = 1700000000;
+		Asset.UpdatedAt = 1700000500;
+		Asset.CurrentVersion = 3;
+		Asset.Metadata = { { TEXT("name"), Name }, { TEXT("element"), TEXT("Fire") } };
+		Asset.Attributes.Add(MakeAttribute(TEXT("damage"), TEXT("42"), 0.25f));
+		Asset.Attributes.Add(MakeAttribute(TEXT("element"), TEXT("fire"), -1.f));
+		Asset.BlobRefs.Add(TEXT("model"), TEXT("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+		Asset.bPublicRead = true;
+		return Entry;
+	}
+
+	TArray<uint8> MakeSnapshot()
+	{
+		return FHazeAssetSnapshot::Write({ MakeEntry(SwordId, TEXT("Sword"), TEXT("haze-rpg"), 0x8000000000000001ull),
+			MakeEntry(ShieldId, TEXT("Shield"), TEXT(""), 5) }, 42, Root, 1700001000);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetSnapshotFormatTest, "HAZE.Snapshot.Format", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetSnapshotFormatTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> Bytes = MakeSnapshot();
+	TestEqual(TEXT("8-byte aligned"), Bytes.Num() % 8, 0);
+	TestTrue(TEXT("Magic"), Bytes.Num() > 8 && FMemory::Memcmp(Bytes.GetData(), "HAZESNAP", 8) == 0);
+
+	TUniquePtr<FHazeAssetSnapshot> Snapshot = FHazeAssetSnapshot::FromBytes(Bytes);
+	if (!TestTrue(TEXT("Valid"), Snapshot.IsValid())) return false;
+	TestEqual(TEXT("Assets"), Snapshot->Num(), 2);
+	TestEqual(TEXT("Height"), Snapshot->GetHeight(), int64(42));
+	TestEqual(TEXT("State root"), Snapshot->GetStateRootHex(), FString(Root));
+
+	// Index sorted by id, found in either case
+	TestEqual(TEXT("Sorted"), Snapshot->GetAssetId(0), FString(ShieldId).ToLower());
+	TestEqual(TEXT("Find"), Snapshot->Find(FString(SwordId).ToUpper()), 1);
+	TestEqual(TEXT("Unknown id"), Snapshot->Find(TEXT("3333333333333333333333333333333333333333333333333333333333333333")), INDEX_NONE);
+	TestEqual(TEXT("Not an id"), Snapshot->Find(TEXT("zz")), INDEX_NONE);
+	TestTrue(TEXT("Fingerprint"), Snapshot->GetFingerprint(1) == 0x8000000000000001ull);
+
+	FHazeAssetInfo Sword;
+	if (TestTrue(TEXT("Read"), Snapshot->Read(1, Sword)))
+	{
+		TestEqual(TEXT("Id"), Sword.AssetId, FString(SwordId));
+		TestEqual(TEXT("Name"), Sword.Metadata.FindRef(TEXT("name")), TEXT("Sword"));
+		TestEqual(TEXT("Game id"), Sword.GameId, TEXT("haze-rpg"));
+		TestEqual(TEXT("Version"), Sword.CurrentVersion, int64(3));
+		TestTrue(TEXT("Density"), Sword.Density == EDensityLevel::Dense);
+		TestTrue(TEXT("Public"), Sword.bPublicRead);
+		TestEqual(TEXT("Blob ref"), Sword.BlobRefs.FindRef(TEXT("model")), TEXT("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+		if (TestEqual(TEXT("Attributes"), Sword.Attributes.Num(), 2))
+		{
+			TestEqual(TEXT("Rarity"), Sword.Attributes[0].Rarity, 0.25f);
+			TestTrue(TEXT("No rarity"), Sword.Attributes[1].Rarity < 0.f);
+			// Interned case-sensitively: "Fire" in metadata, "fire" in the attribute
+			TestEqual(TEXT("Case kept"), Sword.Attributes[1].Value, TEXT("fire"));
+			TestTrue(TEXT("Case kept in metadata"), Sword.Metadata.FindRef(TEXT("element")).Equals(TEXT("Fire"), ESearchCase::CaseSensitive));
+		}
+	}
+	FHazeAssetInfo Shield;
+	TestTrue(TEXT("No game id"), Snapshot->Read(0, Shield) && Shield.GameId.IsEmpty());
+	TestFalse(TEXT("Out of range"), Snapshot->Read(2, Shield));
+
+	// Header damage is caught on open; a bad record only fails its own Read
+	TestFalse(TEXT("Truncated"), FHazeAssetSnapshot::IsValid(MakeArrayView(Bytes.GetData(), Bytes.Num() - 8)));
+	TArray<uint8> BadMagic = Bytes;
+	BadMagic[0] = 'X';
+	TestFalse(TEXT("Bad magic"), FHazeAssetSnapshot::IsValid(BadMagic));
+	TArray<uint8> BadRecord = Bytes;
+	BadRecord[FHazeAssetSnapshot::HeaderSize + FHazeAssetSnapshot::AssetRecordSize + 112] = 0xff;
+	TUniquePtr<FHazeAssetSnapshot> Damaged = FHazeAssetSnapshot::FromBytes(BadRecord);
+	if (TestTrue(TEXT("Header still valid"), Damaged.IsValid()))
+	{
+		TestFalse(TEXT("Bad record"), Damaged->Read(1, Sword));
+		TestTrue(TEXT("Other record"), Damaged->Read(0, Shield));
+	}
+
+	TestEqual(TEXT("Bad state root"), FHazeAssetSnapshot::Write({}, 0, TEXT("00"), 0).Num(), 0);
+	TestEqual(TEXT("Empty snapshot"), FHazeAssetSnapshot::Write({}, 0, Root, 0).Num(), FHazeAssetSnapshot::HeaderSize + 8);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetSnapshotStoreTest, "HAZE.Snapshot.Store", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetSnapshotStoreTest::RunTest(const FString& Parameters)
+{
+	// No client: stale checks and refetches are applied by hand
+	UHazeAssetSnapshotStore* Store = UHazeAssetSnapshotStore::CreateAssetSnapshotStore(nullptr);
+	if (!TestTrue(TEXT("Load"), Store->LoadBytes(MakeSnapshot()))) return false;
+	TestTrue(TEXT("Unverified"), Store->GetStatus(SwordId) == EHazeSnapshotEntryStatus::Unverified);
+	TestTrue(TEXT("Not in snapshot"), Store->GetStatus(TEXT("33")) == EHazeSnapshotEntryStatus::None);
+
+	FBlockchainInfo Info;
+	Info.StateRoot = FString(Root).ToUpper();
+	Store->Validate(Info);
+	TestTrue(TEXT("Same root: current"), Store->GetStatus(ShieldId) == EHazeSnapshotEntryStatus::Current);
+
+	FHazeSnapshotStalePage Page;
+	Page.Stale.Add({ FString(SwordId).ToUpper(), 7, false });
+	Page.Stale.Add({ ShieldId, 0, true });
+	Page.Stale.Add({ TEXT("3333333333333333333333333333333333333333333333333333333333333333"), 9, false });
+	const TArray<FHazeSnapshotStaleEntry> Refetch = Store->ApplyStalePage(Page);
+	if (TestEqual(TEXT("Refetch changed entry only"), Refetch.Num(), 1))
+	{
+		TestEqual(TEXT("Normalized id"), Refetch[0].AssetId, FString(SwordId));
+	}
+	TestTrue(TEXT("Stale"), Store->GetStatus(SwordId) == EHazeSnapshotEntryStatus::Stale);
+	TestTrue(TEXT("Removed"), Store->GetStatus(ShieldId) == EHazeSnapshotEntryStatus::Removed);
+	FHazeAssetInfo Asset;
+	TestFalse(TEXT("Removed asset"), Store->GetAsset(ShieldId, Asset));
+	TestTrue(TEXT("Stale asset still served"), Store->GetAsset(SwordId, Asset) && Asset.Metadata.FindRef(TEXT("name")) == TEXT("Sword"));
+	TestEqual(TEXT("Ids"), Store->GetAssetIds().Num(), 1);
+
+	FHazeAssetInfo Changed = MakeEntry(SwordId, TEXT("Sword+1"), TEXT("haze-rpg"), 7).Asset;
+	Store->ApplyRefreshed(Changed, 7);
+	TestTrue(TEXT("Refreshed"), Store->GetStatus(SwordId) == EHazeSnapshotEntryStatus::Current);
+	TestTrue(TEXT("Refreshed asset"), Store->GetAsset(SwordId, Asset) && Asset.Metadata.FindRef(TEXT("name")) == TEXT("Sword+1"));
+
+	// Saved with the refresh folded in; the next startup maps it as is
+	const FString Path = UHazeAssetSnapshotStore::GetDefaultPath(TEXT("HazeSnapshotTest"));
+	if (TestTrue(TEXT("Save"), Store->Save(Path)))
+	{
+		UHazeAssetSnapshotStore* Reloaded = UHazeAssetSnapshotStore::CreateAssetSnapshotStore(nullptr);
+		if (TestTrue(TEXT("Reload"), Reloaded->Load(Path)))
+		{
+			TestEqual(TEXT("Removed entry dropped"), Reloaded->Num(), 1);
+			TestEqual(TEXT("Root kept"), Reloaded->GetStateRoot(), FString(Root));
+			TestTrue(TEXT("New fingerprint"), Reloaded->GetSnapshot()->GetFingerprint(0) == 7);
+			TestTrue(TEXT("Merged asset"), Reloaded->GetAsset(SwordId, Asset) && Asset.Metadata.FindRef(TEXT("name")) == TEXT("Sword+1"));
+		}
+		// Reloaded's mapping goes with it; close it before deleting the file
+		Reloaded->LoadBytes(MakeSnapshot());
+		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Path);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,313 @@
+// Copyright HAZE Blockchain. Tier choice, load order, eviction delay and memory budget of the asset streamer.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAssetStreamer.h"
+
+namespace
+{
+	/** Transport that holds every fetch until the test answers it */
+	struct FHeldLoads
+	{
+		TArray<TPair<TArray<FString>, FHazeOnAssetSummaries>> Summaries;
+		TArray<TPair<FString, FHazeOnAsset>> Assets;
+		/** Ids in the order their full asset was requested */
+		TArray<FString> Requested;
+		/** Density each asset reports (Core when not listed) */
+		TMap<FString, EDensityLevel> Densities;
+		/** Characters of metadata in each asset's full view (none when not listed) */
+		TMap<FString, int32> MetadataChars;
+
+		void Attach(UHazeAssetStreamer* Streamer)
+		{
+			Streamer->SetTransport([this](const TArray<FString>& AssetIds, FHazeOnAssetSummaries OnComplete)
+			{
+				Summaries.Emplace(AssetIds, MoveTemp(OnComplete));
+			}, [this](const FString& AssetId, FHazeOnAsset OnComplete)
+			{
+				Requested.Add(AssetId);
+				Assets.Emplace(AssetId, MoveTemp(OnComplete));
+			});
+		}
+
+		FHazeAssetInfo MakeAsset(const FString& AssetId, bool bSummary) const
+		{
+			FHazeAssetInfo Asset;
+			Asset.AssetId = AssetId;
+			Asset.Density = Densities.Contains(AssetId) ? Densities.FindChecked(AssetId) : EDensityLevel::Core;
+			Asset.bIsSummary = bSummary;
+			if (!bSummary && MetadataChars.Contains(AssetId))
+			{
+				Asset.Metadata.Add(TEXT("lore"), FString::ChrN(MetadataChars.FindChecked(AssetId), TEXT('x')));
+			}
+			return Asset;
+		}
+
+		/** Answer the oldest held summary batch */
+		void AnswerSummaries(bool bOk = true)
+		{
+			TPair<TArray<FString>, FHazeOnAssetSummaries> Batch = MoveTemp(Summaries[0]);
+			Summaries.RemoveAt(0);
+			TArray<FHazeAssetInfo> Found;
+			for (const FString& AssetId : Batch.Key)
+			{
+				Found.Add(MakeAsset(AssetId, true));
+			}
+			Batch.Value(bOk, bOk ? Found : TArray<FHazeAssetInfo>());
+		}
+
+		/** Answer the oldest held full-asset fetch */
+		void AnswerAsset(bool bOk = true)
+		{
+			TPair<FString, FHazeOnAsset> Fetch = MoveTemp(Assets[0]);
+			Assets.RemoveAt(0);
+			Fetch.Value(bOk, bOk ? MakeAsset(Fetch.Key, false) : FHazeAssetInfo());
+		}
+
+		/** Update at Now and answer everything it requested, until every asset has reached its tier */
+		void Settle(UHazeAssetStreamer* Streamer, double Now)
+		{
+			// Every update climbs at most one tier per asset
+			for (int32 Step = 0; Step < 8; Step++)
+			{
+				Streamer->Update(Now);
+				while (Summaries.Num() > 0) AnswerSummaries();
+				while (Assets.Num() > 0) AnswerAsset();
+			}
+		}
+	};
+
+	bool HasTier(const UHazeAssetStreamer* Streamer, const FString& AssetId, EDensityLevel Tier)
+	{
+		EDensityLevel Loaded;
+		return Streamer->GetLoadedTier(AssetId, Loaded) && Loaded == Tier;
+	}
+
+	UHazeAssetStreamer* MakeStreamer(FHeldLoads& Held)
+	{
+		UHazeAssetStreamer* Streamer = UHazeAssetStreamer::CreateAssetStreamer(nullptr);
+		Streamer->CoreDistance = 100.f;
+		Streamer->DenseDistance = 200.f;
+		Streamer->LightDistance = 300.f;
+		Streamer->EvictDelaySeconds = 0.f;
+		Streamer->MaxConcurrentLoads = 8;
+		Held.Attach(Streamer);
+		return Streamer;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetStreamerTiersTest, "HAZE.Streamer.Tiers", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetStreamerTiersTest::RunTest(const FString& Parameters)
+{
+	FHeldLoads Held;
+	UHazeAssetStreamer* Streamer = MakeStreamer(Held);
+	const double Now = FPlatformTime::Seconds();
+
+	Streamer->Track(TEXT("near"), FVector(50.f, 0.f, 0.f));
+	Streamer->Track(TEXT("mid"), FVector(150.f, 0.f, 0.f));
+	Streamer->Track(TEXT("far"), FVector(250.f, 0.f, 0.f));
+	Streamer->Track(TEXT("out"), FVector(1000.f, 0.f, 0.f));
+	Streamer->Track(TEXT("hidden"), FVector::ZeroVector);
+	Streamer->SetAssetVisible(TEXT("hidden"), false);
+	Streamer->Track(TEXT("thin"), FVector::ZeroVector);
+	Held.Densities.Add(TEXT("thin"), EDensityLevel::Light);
+	Streamer->Track(TEXT("held"), FVector(1000.f, 0.f, 0.f));
+	Streamer->SetAssetVisible(TEXT("held"), false);
+	Streamer->SetRequiredTier(TEXT("held"), EDensityLevel::Core);
+
+	// Summaries first, in one batch; nothing is placed before they arrive
+	Streamer->Update(Now);
+	TestEqual(TEXT("One batch"), Held.Summaries.Num(), 1);
+	TestEqual(TEXT("Every asset summarized"), Held.Summaries.Num() > 0 ? Held.Summaries[0].Key.Num() : 0, 7);
+	TestEqual(TEXT("No full asset before its summary"), Held.Assets.Num(), 0);
+	EDensityLevel Tier;
+	TestFalse(TEXT("No tier before the summary"), Streamer->GetLoadedTier(TEXT("near"), Tier));
+	Held.AnswerSummaries();
+	TestTrue(TEXT("Summary is Ethereal"), HasTier(Streamer, TEXT("near"), EDensityLevel::Ethereal));
+	FHazeAssetInfo Asset;
+	TestTrue(TEXT("Summary view"), Streamer->GetAsset(TEXT("near"), Asset) && Asset.bIsSummary);
+
+	Held.Settle(Streamer, Now);
+	TestTrue(TEXT("Within CoreDistance"), HasTier(Streamer, TEXT("near"), EDensityLevel::Core));
+	TestTrue(TEXT("Within DenseDistance"), HasTier(Streamer, TEXT("mid"), EDensityLevel::Dense));
+	TestTrue(TEXT("Within LightDistance"), HasTier(Streamer, TEXT("far"), EDensityLevel::Light));
+	TestTrue(TEXT("Out of range"), HasTier(Streamer, TEXT("out"), EDensityLevel::Ethereal));
+	TestTrue(TEXT("Invisible keeps its required tier"), HasTier(Streamer, TEXT("hidden"), EDensityLevel::Ethereal));
+	TestTrue(TEXT("Capped at the asset's density"), HasTier(Streamer, TEXT("thin"), EDensityLevel::Light));
+	TestTrue(TEXT("Required tier regardless of distance"), HasTier(Streamer, TEXT("held"), EDensityLevel::Core));
+	TestTrue(TEXT("Full view from Light"), Streamer->GetAsset(TEXT("far"), Asset) && !Asset.bIsSummary);
+	TestFalse(TEXT("Untouched assets not fetched"), Held.Requested.Contains(TEXT("out")) || Held.Requested.Contains(TEXT("hidden")));
+
+	// Hidden assets drop back to their required tier
+	Streamer->SetAssetVisible(TEXT("near"), false);
+	Streamer->Update(Now);
+	TestTrue(TEXT("Hidden evicted"), HasTier(Streamer, TEXT("near"), EDensityLevel::Ethereal));
+	TestTrue(TEXT("Summary kept"), Streamer->GetAsset(TEXT("near"), Asset) && Asset.bIsSummary);
+
+	Streamer->Untrack(TEXT("held"));
+	TestFalse(TEXT("Untracked"), Streamer->GetLoadedTier(TEXT("held"), Tier));
+	Streamer->SetTransport(nullptr, nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetStreamerOrderTest, "HAZE.Streamer.Order", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetStreamerOrderTest::RunTest(const FString& Parameters)
+{
+	FHeldLoads Held;
+	UHazeAssetStreamer* Streamer = MakeStreamer(Held);
+	Streamer->MaxConcurrentLoads = 1;
+	const double Now = FPlatformTime::Seconds();
+
+	// Visible first, then priority, then distance
+	Streamer->Track(TEXT("a"), FVector(250.f, 0.f, 0.f));
+	Streamer->Track(TEXT("b"), FVector::ZeroVector);
+	Streamer->SetAssetVisible(TEXT("b"), false);
+	Streamer->SetRequiredTier(TEXT("b"), EDensityLevel::Light);
+	Streamer->Track(TEXT("c"), FVector(280.f, 0.f, 0.f));
+	Streamer->SetAssetPriority(TEXT("c"), 1);
+	Streamer->Track(TEXT("d"), FVector(100.f, 0.f, 0.f));
+
+	Streamer->Update(Now);
+	if (TestEqual(TEXT("One batch"), Held.Summaries.Num(), 1))
+	{
+		TestTrue(TEXT("Batch most important first"), Held.Summaries[0].Key == TArray<FString>({ TEXT("c"), TEXT("d"), TEXT("a"), TEXT("b") }));
+	}
+	Held.AnswerSummaries();
+
+	// One load at a time: each update starts the most important one still short of its tier
+	Streamer->Update(Now);
+	TestEqual(TEXT("Window of one"), Held.Assets.Num(), 1);
+	Streamer->Update(Now);
+	TestEqual(TEXT("Nothing more while it loads"), Held.Assets.Num(), 1);
+	Held.Settle(Streamer, Now);
+	TestTrue(TEXT("Loaded in importance order"), Held.Requested == TArray<FString>({ TEXT("c"), TEXT("d"), TEXT("a"), TEXT("b") }));
+	TestTrue(TEXT("Nearest reaches Core"), HasTier(Streamer, TEXT("d"), EDensityLevel::Core));
+	Streamer->SetTransport(nullptr, nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetStreamerEvictTest, "HAZE.Streamer.Evict", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetStreamerEvictTest::RunTest(const FString& Parameters)
+{
+	FHeldLoads Held;
+	UHazeAssetStreamer* Streamer = MakeStreamer(Held);
+	Streamer->EvictDelaySeconds = 5.f;
+	const double Now = FPlatformTime::Seconds();
+
+	Streamer->Track(TEXT("a"), FVector(50.f, 0.f, 0.f));
+	Streamer->Update(Now);
+	Held.AnswerSummaries();
+	const int64 SummaryBytes = Streamer->GetResidentBytes();
+	TestTrue(TEXT("Summary counted"), SummaryBytes > 0);
+	Held.Settle(Streamer, Now);
+	TestTrue(TEXT("Loaded"), HasTier(Streamer, TEXT("a"), EDensityLevel::Core));
+	TestTrue(TEXT("Full asset counted"), Streamer->GetResidentBytes() > SummaryBytes);
+
+	// Out of range: kept for EvictDelaySeconds, and the clock restarts if it comes back in the meantime
+	Streamer->SetAssetLocation(TEXT("a"), FVector(1000.f, 0.f, 0.f));
+	Streamer->Update(Now + 1.0);
+	Streamer->Update(Now + 5.0);
+	TestTrue(TEXT("Kept within the delay"), HasTier(Streamer, TEXT("a"), EDensityLevel::Core));
+	Streamer->SetAssetLocation(TEXT("a"), FVector(50.f, 0.f, 0.f));
+	Streamer->Update(Now + 5.5);
+	Streamer->SetAssetLocation(TEXT("a"), FVector(1000.f, 0.f, 0.f));
+	Streamer->Update(Now + 6.0);
+	Streamer->Update(Now + 10.0);
+	TestTrue(TEXT("Delay restarted"), HasTier(Streamer, TEXT("a"), EDensityLevel::Core));
+	Streamer->Update(Now + 11.0);
+	TestTrue(TEXT("Evicted after the delay"), HasTier(Streamer, TEXT("a"), EDensityLevel::Ethereal));
+	TestEqual(TEXT("Only the summary left"), Streamer->GetResidentBytes(), SummaryBytes);
+
+	// A load finishing after its asset was untracked is discarded
+	Streamer->SetAssetLocation(TEXT("a"), FVector(50.f, 0.f, 0.f));
+	Streamer->Update(Now + 12.0);
+	TestEqual(TEXT("Reloading"), Held.Assets.Num(), 1);
+	Streamer->Untrack(TEXT("a"));
+	TestEqual(TEXT("Nothing resident"), Streamer->GetResidentBytes(), int64(0));
+	Held.AnswerAsset();
+	EDensityLevel Tier;
+	TestFalse(TEXT("Late load discarded"), Streamer->GetLoadedTier(TEXT("a"), Tier));
+	TestEqual(TEXT("Still nothing resident"), Streamer->GetResidentBytes(), int64(0));
+	Streamer->SetTransport(nullptr, nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetStreamerBudgetTest, "HAZE.Streamer.Budget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetStreamerBudgetTest::RunTest(const FString& Parameters)
+{
+	FHeldLoads Held;
+	UHazeAssetStreamer* Streamer = MakeStreamer(Held);
+	const double Now = FPlatformTime::Seconds();
+
+	// "big" is the more important one and holds most of the memory
+	Held.MetadataChars.Add(TEXT("big"), 8192);
+	Streamer->Track(TEXT("big"), FVector(50.f, 0.f, 0.f));
+	Streamer->SetAssetPriority(TEXT("big"), 1);
+	Streamer->Track(TEXT("small"), FVector(50.f, 0.f, 0.f));
+	Held.Settle(Streamer, Now);
+	TestTrue(TEXT("Both loaded"), HasTier(Streamer, TEXT("big"), EDensityLevel::Core) && HasTier(Streamer, TEXT("small"), EDensityLevel::Core));
+	const int64 Resident = Streamer->GetResidentBytes();
+
+	// Over budget: the least important asset loses tiers until it fits; the summary stays
+	Streamer->MemoryBudgetBytes = Resident - 1;
+	Streamer->Update(Now);
+	TestTrue(TEXT("Fits"), Streamer->GetResidentBytes() <= Streamer->MemoryBudgetBytes);
+	TestTrue(TEXT("Important asset kept"), HasTier(Streamer, TEXT("big"), EDensityLevel::Core));
+	TestTrue(TEXT("Least important stripped"), HasTier(Streamer, TEXT("small"), EDensityLevel::Ethereal));
+
+	// Above the low-water mark the stripped asset does not climb back (no thrashing at the budget)
+	const int32 Fetched = Held.Requested.Num();
+	Held.Settle(Streamer, Now);
+	TestEqual(TEXT("Not reloaded near the budget"), Held.Requested.Num(), Fetched);
+	TestTrue(TEXT("Still stripped"), HasTier(Streamer, TEXT("small"), EDensityLevel::Ethereal));
+
+	// With headroom it loads again
+	Streamer->MemoryBudgetBytes = Resident * 4;
+	Held.Settle(Streamer, Now);
+	TestTrue(TEXT("Reloaded with headroom"), HasTier(Streamer, TEXT("small"), EDensityLevel::Core));
+	TestEqual(TEXT("Resident restored"), Streamer->GetResidentBytes(), Resident);
+	Streamer->SetTransport(nullptr, nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetStreamerRetryTest, "HAZE.Streamer.Retry", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetStreamerRetryTest::RunTest(const FString& Parameters)
+{
+	FHeldLoads Held;
+	UHazeAssetStreamer* Streamer = MakeStreamer(Held);
+	Streamer->RetryDelaySeconds = 5.f;
+	const double Now = FPlatformTime::Seconds();
+
+	// A failed summary batch is retried after RetryDelaySeconds, not on the next update
+	Streamer->Track(TEXT("a"), FVector(250.f, 0.f, 0.f));
+	Streamer->Update(Now);
+	Held.AnswerSummaries(false);
+	Streamer->Update(Now);
+	TestEqual(TEXT("Summary not retried at once"), Held.Summaries.Num(), 0);
+	Streamer->Update(Now + 6.0);
+	TestEqual(TEXT("Summary retried"), Held.Summaries.Num(), 1);
+	Held.AnswerSummaries();
+
+	// Likewise a failed tier load
+	Streamer->Update(Now + 6.0);
+	Held.AnswerAsset(false);
+	TestTrue(TEXT("Tier not loaded"), HasTier(Streamer, TEXT("a"), EDensityLevel::Ethereal));
+	Streamer->Update(Now);
+	TestEqual(TEXT("Load not retried at once"), Held.Assets.Num(), 0);
+	Streamer->Update(Now + 12.0);
+	TestEqual(TEXT("Load retried"), Held.Assets.Num(), 1);
+	Held.AnswerAsset();
+	TestTrue(TEXT("Loaded on retry"), HasTier(Streamer, TEXT("a"), EDensityLevel::Light));
+	Streamer->SetTransport(nullptr, nullptr);
+	return true;
+}
+
+#endif
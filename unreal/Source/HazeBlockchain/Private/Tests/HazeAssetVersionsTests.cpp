@@ -0,0 +1,167 @@
+// Copyright HAZE Blockchain. Merging and pruning of incremental asset version and history responses.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAssetVersions.h"
+
+namespace
+{
+	FHazeAssetVersionDelta MakeDelta(int64 Version, int64 Base, TMap<FString, FString> BlobRefs, TArray<FString> Removed = {})
+	{
+		FHazeAssetVersionDelta Delta;
+		Delta.Version.Version = Version;
+		Delta.Version.BlobRefs = MoveTemp(BlobRefs);
+		Delta.BlobRefsBase = Base;
+		Delta.RemovedBlobRefs = MoveTemp(Removed);
+		return Delta;
+	}
+
+	FHazeAssetHistoryEntry MakeEntry(int64 Index, const TCHAR* Action)
+	{
+		FHazeAssetHistoryEntry Entry;
+		Entry.Index = Index;
+		Entry.Action = Action;
+		return Entry;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetVersionsMergeTest, "HAZE.AssetVersions.Merge", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetVersionsMergeTest::RunTest(const FString& Parameters)
+{
+	const FString Mesh = TEXT("aa00000000000000000000000000000000000000000000000000000000000000");
+	const FString Texture = TEXT("bb00000000000000000000000000000000000000000000000000000000000000");
+	const FString Icon = TEXT("cc00000000000000000000000000000000000000000000000000000000000000");
+
+	// No client: nothing is fetched, responses are merged by hand
+	UHazeAssetVersionCache* Cache = UHazeAssetVersionCache::CreateAssetVersionCache(nullptr);
+	Cache->Track(TEXT("AB01"));
+	Cache->Track(TEXT("ab02"));
+
+	FHazeAssetVersionsPage First;
+	First.Versions.Add(MakeDelta(1, 0, { { TEXT("mesh"), Mesh }, { TEXT("icon"), Icon } }));
+	First.Versions.Add(MakeDelta(2, 1, { { TEXT("texture"), Texture } }, { TEXT("icon") }));
+	TestTrue(TEXT("Full then delta"), Cache->ApplyVersions(TEXT("ab01"), First));
+	TestEqual(TEXT("Known version"), Cache->GetKnownVersion(TEXT("ab01")), int64(2));
+
+	FHazeAssetVersion Latest;
+	TestTrue(TEXT("Latest"), Cache->GetLatestVersion(TEXT("ab01"), Latest));
+	TestEqual(TEXT("Unchanged ref kept"), Latest.BlobRefs.FindRef(TEXT("mesh")), Mesh);
+	TestEqual(TEXT("Changed ref added"), Latest.BlobRefs.FindRef(TEXT("texture")), Texture);
+	TestFalse(TEXT("Removed ref gone"), Latest.BlobRefs.Contains(TEXT("icon")));
+
+	FHazeAssetVersion Older;
+	TestTrue(TEXT("Older version kept"), Cache->GetVersion(TEXT("ab01"), 1, Older) && Older.BlobRefs.Num() == 2);
+
+	// Overlapping syncs deliver known versions again; a hash shared with another asset is held once
+	FHazeAssetVersionsPage Overlap;
+	Overlap.Versions.Add(MakeDelta(2, 1, { { TEXT("texture"), Icon } }));
+	TestTrue(TEXT("Overlap"), Cache->ApplyVersions(TEXT("ab01"), Overlap));
+	TestTrue(TEXT("Known version not replaced"), Cache->GetLatestVersion(TEXT("ab01"), Latest) && Latest.BlobRefs.FindRef(TEXT("texture")) == Texture);
+
+	FHazeAssetVersionsPage Other;
+	Other.Versions.Add(MakeDelta(1, 0, { { TEXT("mesh"), Mesh.ToUpper() } }));
+	TestTrue(TEXT("Other asset"), Cache->ApplyVersions(TEXT("ab02"), Other));
+	TestEqual(TEXT("Distinct hashes"), Cache->GetBlobHashCount(), 3);
+
+	// A delta against a version the cache does not hold drops the asset's versions
+	FHazeAssetVersionsPage Gap;
+	Gap.Versions.Add(MakeDelta(5, 4, { { TEXT("mesh"), Texture } }));
+	TestFalse(TEXT("Unknown base"), Cache->ApplyVersions(TEXT("ab02"), Gap));
+	TestEqual(TEXT("Versions dropped"), Cache->GetVersions(TEXT("ab02")).Num(), 0);
+	TestEqual(TEXT("Hashes still in use"), Cache->GetBlobHashCount(), 3);
+
+	Cache->Untrack(TEXT("AB01"));
+	TestEqual(TEXT("Hashes released"), Cache->GetBlobHashCount(), 0);
+	TestFalse(TEXT("Untracked"), Cache->ApplyVersions(TEXT("ab01"), First));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetVersionsHistoryTest, "HAZE.AssetVersions.History", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetVersionsHistoryTest::RunTest(const FString& Parameters)
+{
+	UHazeAssetVersionCache* Cache = UHazeAssetVersionCache::CreateAssetVersionCache(nullptr);
+	Cache->Track(TEXT("ab01"));
+
+	FHazeAssetHistoryPage First;
+	First.FirstIndex = 0;
+	First.NextIndex = 2;
+	First.Entries = { MakeEntry(0, TEXT("Create")), MakeEntry(1, TEXT("Update")) };
+	Cache->ApplyHistory(TEXT("ab01"), First);
+
+	// The node dropped entries 2..4 before this poll, and resends entry 1
+	FHazeAssetHistoryPage Next;
+	Next.FirstIndex = 1;
+	Next.NextIndex = 7;
+	Next.Entries = { MakeEntry(1, TEXT("Update")), MakeEntry(5, TEXT("Condense")), MakeEntry(6, TEXT("Update")) };
+	Cache->ApplyHistory(TEXT("ab01"), Next);
+
+	const TArray<FHazeAssetHistoryEntry> History = Cache->GetHistory(TEXT("ab01"));
+	if (TestEqual(TEXT("Entries without duplicates"), History.Num(), 4))
+	{
+		TestEqual(TEXT("Gap kept"), History[2].Index, int64(5));
+		TestEqual(TEXT("Action"), History[2].Action, TEXT("Condense"));
+	}
+
+	// An empty page leaves the next index where it was
+	Cache->ApplyHistory(TEXT("ab01"), FHazeAssetHistoryPage());
+	Next.Entries = { MakeEntry(6, TEXT("Update")) };
+	Cache->ApplyHistory(TEXT("ab01"), Next);
+	TestEqual(TEXT("No new entries"), Cache->GetHistory(TEXT("ab01")).Num(), 4);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAssetVersionsPruneTest, "HAZE.AssetVersions.Prune", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAssetVersionsPruneTest::RunTest(const FString& Parameters)
+{
+	const FString Mesh = TEXT("aa00000000000000000000000000000000000000000000000000000000000000");
+	const FString Texture = TEXT("bb00000000000000000000000000000000000000000000000000000000000000");
+
+	UHazeAssetVersionCache* Cache = UHazeAssetVersionCache::CreateAssetVersionCache(nullptr);
+	Cache->MaxVersions = 2;
+	Cache->MaxHistoryEntries = 3;
+	Cache->Track(TEXT("ab01"));
+
+	// Pruned after the whole page, so a delta on an older version of the same page still resolves
+	FHazeAssetVersionsPage Page;
+	Page.Versions.Add(MakeDelta(1, 0, { { TEXT("mesh"), Mesh } }));
+	Page.Versions.Add(MakeDelta(2, 1, { { TEXT("texture"), Texture } }));
+	Page.Versions.Add(MakeDelta(3, 1, {}));
+	TestTrue(TEXT("Page applied"), Cache->ApplyVersions(TEXT("ab01"), Page));
+	TArray<FHazeAssetVersion> Versions = Cache->GetVersions(TEXT("ab01"));
+	if (TestEqual(TEXT("Capped"), Versions.Num(), 2))
+	{
+		TestEqual(TEXT("Oldest dropped"), Versions[0].Version, int64(2));
+		TestTrue(TEXT("Delta on a pruned base resolved"), Versions[1].BlobRefs.Num() == 1 && Versions[1].BlobRefs.FindRef(TEXT("mesh")) == Mesh);
+	}
+
+	// The next delta is based on the newest version, which is always kept
+	FHazeAssetVersionsPage Next;
+	Next.Versions.Add(MakeDelta(4, 3, {}, { TEXT("mesh") }));
+	TestTrue(TEXT("Delta on the newest"), Cache->ApplyVersions(TEXT("ab01"), Next));
+	TestEqual(TEXT("Still capped"), Cache->GetVersions(TEXT("ab01")).Num(), 2);
+	TestEqual(TEXT("Released with the pruned versions"), Cache->GetBlobHashCount(), 1);
+
+	FHazeAssetHistoryPage History;
+	History.NextIndex = 5;
+	for (int32 i = 0; i < 5; i++)
+	{
+		History.Entries.Add(MakeEntry(i, TEXT("Update")));
+	}
+	Cache->ApplyHistory(TEXT("ab01"), History);
+	const TArray<FHazeAssetHistoryEntry> Kept = Cache->GetHistory(TEXT("ab01"));
+	if (TestEqual(TEXT("History capped"), Kept.Num(), 3))
+	{
+		TestEqual(TEXT("Oldest entries dropped"), Kept[0].Index, int64(2));
+	}
+	Cache->ApplyHistory(TEXT("ab01"), History);
+	TestEqual(TEXT("Dropped entries not taken again"), Cache->GetHistory(TEXT("ab01")).Num(), 3);
+	return true;
+}
+
+#endif
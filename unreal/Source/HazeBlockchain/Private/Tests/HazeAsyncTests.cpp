@@ -0,0 +1,69 @@
+// Copyright HAZE Blockchain. Future results, chaining and receipt waits.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeAsync.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAsyncChainTest, "HAZE.Async.Chain", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAsyncChainTest::RunTest(const FString& Parameters)
+{
+	// Nothing to send: completes at once, without touching the game thread
+	THazeFuture<FAccountInfo> NoClient = HazeAsync::FetchAccount(nullptr, TEXT("aa00"));
+	TestTrue(TEXT("Ready"), NoClient.IsReady());
+	TestTrue(TEXT("Invalid input"), !NoClient.Get() && NoClient.Get().Error->Kind == EHazeErrorKind::InvalidInput);
+
+	// A failed step short-circuits; the chained future is the one the continuation returned
+	bool bRan = false;
+	THazeFuture<FTransactionResponse> Sent = HazeAsync::Chain(MoveTemp(NoClient), [&bRan](const THazeResult<FAccountInfo>& Account)
+	{
+		bRan = true;
+		if (!Account) return HazeAsync::MakeFailed<FTransactionResponse>(Account.Error.GetValue());
+		return HazeAsync::SubmitTransaction(nullptr, TEXT("{}"));
+	});
+	TestTrue(TEXT("Continuation ran"), bRan);
+	TestTrue(TEXT("Flattened and ready"), Sent.IsReady());
+	TestTrue(TEXT("Error forwarded"), !Sent.Get() && Sent.Get().Error->Kind == EHazeErrorKind::InvalidInput);
+
+	// A successful step feeds the next one
+	TPromise<THazeResult<int32>> Height;
+	THazeFuture<FString> Label = HazeAsync::Chain(Height.GetFuture(), [](const THazeResult<int32>& Result)
+	{
+		return MakeFulfilledPromise<THazeResult<FString>>(THazeResult<FString>::Ok(FString::FromInt(*Result + 1))).GetFuture();
+	});
+	TestFalse(TEXT("Waits for the first step"), Label.IsReady());
+	Height.SetValue(THazeResult<int32>::Ok(41));
+	TestTrue(TEXT("Value passed along"), Label.IsReady() && Label.Get() && *Label.Get() == TEXT("42"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAsyncReceiptTest, "HAZE.Async.Receipt", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeAsyncReceiptTest::RunTest(const FString& Parameters)
+{
+	UHazeChainFollower* Follower = UHazeChainFollower::CreateChainFollower(nullptr);
+	THazeFuture<FHazeReceipt> Confirmed = HazeAsync::WaitForReceipt(Follower, TEXT("AA01"));
+	THazeFuture<FHazeReceipt> Dropped = HazeAsync::WaitForReceipt(Follower, TEXT("bb02"));
+	TestFalse(TEXT("Pending"), Confirmed.IsReady());
+
+	FHazeBlockInfo Block;
+	Block.Height = 7;
+	Block.Hash = TEXT("a-7");
+	Block.Transactions = { TEXT("aa01") };
+	Follower->ApplyBlock(Block);
+	TestTrue(TEXT("Confirmed"), Confirmed.IsReady() && Confirmed.Get() && Confirmed.Get()->BlockHeight == 7);
+
+	// Already in a block: resolves at once
+	THazeFuture<FHazeReceipt> Again = HazeAsync::WaitForReceipt(Follower, TEXT("aa01"));
+	TestTrue(TEXT("Known receipt"), Again.IsReady() && Again.Get() && Again.Get()->Status == EHazeReceiptStatus::Confirmed);
+
+	// Untracked before it landed: the future still completes
+	Follower->UntrackTransaction(TEXT("bb02"));
+	TestTrue(TEXT("Abandoned"), Dropped.IsReady() && !Dropped.Get() && Dropped.Get().Error->Kind == EHazeErrorKind::Abandoned);
+	return true;
+}
+
+#endif
@@ -0,0 +1,154 @@
+// Copyright HAZE Blockchain. Micro-benchmark harness for the plugin's automation tests.
+
+#include "HazeBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+namespace
+{
+	/** Forwards everything to the allocator it replaced, counting calls from one thread */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner = nullptr;
+		uint32 ThreadId = 0;
+		std::atomic<int64> Allocs{0};
+		std::atomic<int64> Bytes{0};
+
+		void Count(SIZE_T Size)
+		{
+			if (FPlatformTLS::GetCurrentThreadId() != ThreadId) return;
+			Allocs.fetch_add(1, std::memory_order_relaxed);
+			Bytes.fetch_add(static_cast<int64>(Size), std::memory_order_relaxed);
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			this->Count(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			this->Count(Count);
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			// Shrinks and frees through Realloc are not new allocations
+			SIZE_T OldSize = 0;
+			if (Count > 0 && (!Original || !Inner->GetAllocationSize(Original, OldSize) || Count > OldSize)) this->Count(Count);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			SIZE_T OldSize = 0;
+			if (Count > 0 && (!Original || !Inner->GetAllocationSize(Original, OldSize) || Count > OldSize)) this->Count(Count);
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("HazeCountingMalloc"); }
+	};
+
+	/** Never destroyed: blocks allocated through it may be freed after the scope (they go to Inner either way) */
+	FCountingMalloc& CountingMalloc()
+	{
+		static FCountingMalloc* Instance = new FCountingMalloc();
+		return *Instance;
+	}
+}
+
+FHazeAllocScope::FHazeAllocScope()
+{
+	FCountingMalloc& Counter = CountingMalloc();
+	check(GMalloc != &Counter);
+	Counter.Inner = GMalloc;
+	Counter.ThreadId = FPlatformTLS::GetCurrentThreadId();
+	Counter.Allocs = 0;
+	Counter.Bytes = 0;
+	GMalloc = &Counter;
+}
+
+FHazeAllocScope::~FHazeAllocScope()
+{
+	GMalloc = CountingMalloc().Inner;
+}
+
+FHazeAllocCount FHazeAllocScope::Get() const
+{
+	const FCountingMalloc& Counter = CountingMalloc();
+	return { Counter.Allocs.load(std::memory_order_relaxed), Counter.Bytes.load(std::memory_order_relaxed) };
+}
+
+namespace HazeBenchmark
+{
+	FHazeBenchmarkResult Run(FAutomationTestBase& Test, const TCHAR* Name, TFunctionRef<void()> Body,
+		double MinSeconds, int32 AllocIterations)
+	{
+		FHazeBenchmarkResult Result;
+		Result.Name = Name;
+
+		// Warm caches and lazily built state (signer contexts, string tables) before timing
+		Body();
+
+		// Grow the batch until one takes about a millisecond, so reading the clock does not dominate
+		int64 Batch = 1;
+		const double Start = FPlatformTime::Seconds();
+		double Elapsed = 0.0;
+		while (Elapsed < MinSeconds)
+		{
+			const double BatchStart = FPlatformTime::Seconds();
+			for (int64 i = 0; i < Batch; i++)
+			{
+				Body();
+			}
+			const double Now = FPlatformTime::Seconds();
+			Result.Iterations += Batch;
+			Elapsed = Now - Start;
+			if (Now - BatchStart < 0.001 && Batch < (int64(1) << 24)) Batch *= 2;
+		}
+		Result.Seconds = Elapsed;
+		Result.OpsPerSecond = Result.Iterations / Elapsed;
+
+		if (AllocIterations > 0)
+		{
+			FHazeAllocScope Scope;
+			for (int32 i = 0; i < AllocIterations; i++)
+			{
+				Body();
+			}
+			const FHazeAllocCount Count = Scope.Get();
+			Result.AllocsPerOp = static_cast<double>(Count.Allocs) / AllocIterations;
+			Result.BytesPerOp = static_cast<double>(Count.Bytes) / AllocIterations;
+		}
+
+		Test.AddInfo(FString::Printf(TEXT("%-36s %12.0f ops/s %10.3f us/op %8.2f allocs/op %10.1f B/op"),
+			Name, Result.OpsPerSecond, 1e6 / Result.OpsPerSecond, Result.AllocsPerOp, Result.BytesPerOp));
+		return Result;
+	}
+
+	double MinSecondsFromCommandLine()
+	{
+		double Seconds = 0.25;
+		FParse::Value(FCommandLine::Get(), TEXT("HazeBenchSeconds="), Seconds);
+		return FMath::Max(Seconds, 0.01);
+	}
+}
+
+#endif
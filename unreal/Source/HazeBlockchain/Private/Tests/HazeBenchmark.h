@@ -0,0 +1,56 @@
+// Copyright HAZE Blockchain. Micro-benchmark harness for the plugin's automation tests.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class FAutomationTestBase;
+
+/** Allocations made on the measuring thread while a FHazeAllocScope was alive */
+struct FHazeAllocCount
+{
+	int64 Allocs = 0;
+	int64 Bytes = 0;
+};
+
+/**
+ * Counts GMalloc calls (Malloc and growing Realloc) made by the current thread. Installs a forwarding
+ * FMalloc over GMalloc for its lifetime, so only use it around short measured loops in dev builds.
+ * Scopes do not nest.
+ */
+class FHazeAllocScope
+{
+public:
+	FHazeAllocScope();
+	~FHazeAllocScope();
+
+	FHazeAllocCount Get() const;
+};
+
+struct FHazeBenchmarkResult
+{
+	FString Name;
+	int64 Iterations = 0;
+	double Seconds = 0.0;
+	double OpsPerSecond = 0.0;
+	double AllocsPerOp = 0.0;
+	double BytesPerOp = 0.0;
+};
+
+namespace HazeBenchmark
+{
+	/**
+	 * Run Body repeatedly for at least MinSeconds and report ops/sec, then run AllocIterations more under a
+	 * FHazeAllocScope for allocations per op (kept separate so counting does not skew the timing).
+	 * The result is also added to Test as an info line.
+	 */
+	FHazeBenchmarkResult Run(FAutomationTestBase& Test, const TCHAR* Name, TFunctionRef<void()> Body,
+		double MinSeconds = 0.25, int32 AllocIterations = 64);
+
+	/** Seconds to spend per benchmark: -HazeBenchSeconds=<s> on the command line, default 0.25 */
+	double MinSecondsFromCommandLine();
+}
+
+#endif
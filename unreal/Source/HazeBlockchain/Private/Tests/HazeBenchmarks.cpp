@@ -0,0 +1,356 @@
+// Copyright HAZE Blockchain. Throughput and allocation benchmarks for the plugin's hot paths.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeBenchmark.h"
+#include "HazeTestResponses.h"
+#include "TransactionSigning.h"
+#include "TransactionBuilder.h"
+#include "KeyPair.h"
+#include "HazeHex.h"
+#include "HazeAmount.h"
+#include "HazeAmm.h"
+#include "HazeAssetPage.h"
+#include "HazeResponseParser.h"
+
+using HazeTestResponses::Utf8;
+
+namespace
+{
+	/**
+	 * Paths documented as allocation-free must stay that way; timings are only reported, since they vary by
+	 * machine. Run with stats capture off: an active `stat` session allocates from inside the scopes.
+	 */
+	void ExpectNoAllocations(FAutomationTestBase& Test, const FHazeBenchmarkResult& Result)
+	{
+		if (Result.AllocsPerOp > 0.0)
+		{
+			Test.AddError(FString::Printf(TEXT("%s allocates (%.2f per op, %.0f bytes)"), *Result.Name, Result.AllocsPerOp, Result.BytesPerOp));
+		}
+	}
+
+	TArray<uint8> TestAddress(uint8 Fill)
+	{
+		TArray<uint8> Bytes;
+		Bytes.Init(Fill, 32);
+		return Bytes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeSigningPayloadBenchmark, "HAZE.Benchmark.SigningPayload", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHazeSigningPayloadBenchmark::RunTest(const FString& Parameters)
+{
+	const double Seconds = HazeBenchmark::MinSecondsFromCommandLine();
+	const TArray<uint8> From = TestAddress(0x11);
+	const TArray<uint8> To = TestAddress(0x22);
+	TMap<FString, FString> Split;
+	Split.Add(TEXT("_components"), TEXT("3333333333333333333333333333333333333333333333333333333333333333,4444444444444444444444444444444444444444444444444444444444444444"));
+	const TMap<FString, FString> None;
+
+	uint8 Buffer[FHazeTransferPayloadLayout::MaxSize + FHazeMistbornPayloadLayout::FixedMaxSize];
+	int32 Sink = 0;
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("WriteTransferPayload"), [&]
+	{
+		Sink += FTransactionSigning::WriteTransferPayload(Buffer, From, To, 1000000, 1000, 5, 1ull, 500ull);
+	}, Seconds));
+
+	FHazeTransferPayload Inline;
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("BuildTransferPayloadInto (inline)"), [&]
+	{
+		FTransactionSigning::BuildTransferPayloadInto(Inline, From, To, 1000000, 1000, 5, 1ull, 500ull);
+		Sink += Inline.Num();
+	}, Seconds));
+
+	HazeBenchmark::Run(*this, TEXT("BuildTransferPayload (TArray)"), [&]
+	{
+		Sink += FTransactionSigning::BuildTransferPayload(From, To, 1000000, 1000, 5).Num();
+	}, Seconds);
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("WriteMistbornAssetPayload (Create)"), [&]
+	{
+		Sink += FTransactionSigning::WriteMistbornAssetPayload(Buffer, UE_ARRAY_COUNT(Buffer), From, EAssetAction::Create, To, From,
+			EDensityLevel::Light, 10, 3, None, 1ull);
+	}, Seconds));
+
+	FHazeMistbornPayload Mistborn;
+	HazeBenchmark::Run(*this, TEXT("BuildMistbornAssetPayloadInto (Split)"), [&]
+	{
+		FTransactionSigning::BuildMistbornAssetPayloadInto(Mistborn, From, EAssetAction::Split, To, From, EDensityLevel::Core, 10, 3, Split);
+		Sink += Mistborn.Num();
+	}, Seconds);
+
+	TestTrue(TEXT("Payloads were built"), Sink > 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeSignBenchmark, "HAZE.Benchmark.Sign", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHazeSignBenchmark::RunTest(const FString& Parameters)
+{
+	UHazeKeyPair* Key = UHazeKeyPair::Generate();
+	if (!Key)
+	{
+		AddInfo(TEXT("Ed25519 is not linked (HAZE_HAS_ED25519); signing benchmarks skipped"));
+		return true;
+	}
+
+	const double Seconds = HazeBenchmark::MinSecondsFromCommandLine();
+	uint8 Payload[FHazeTransferPayloadLayout::MaxSize];
+	const int32 PayloadLen = FTransactionSigning::WriteTransferPayload(Payload, Key->PublicKey, TestAddress(0x22), 1000000, 1000, 5, 1ull, 500ull);
+	const TArray<uint8> Message(Payload, PayloadLen);
+	uint8 Signature[FHazeSignerContext::SignatureSize];
+	int32 Sink = 0;
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("UHazeKeyPair::SignTo"), [&]
+	{
+		Sink += Key->SignTo(Payload, PayloadLen, Signature) ? 1 : 0;
+	}, Seconds));
+
+	HazeBenchmark::Run(*this, TEXT("UHazeKeyPair::Sign"), [&]
+	{
+		Sink += Key->Sign(Message).Num();
+	}, Seconds);
+
+	TestTrue(TEXT("Signatures were produced"), Sink > 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeHexBenchmark, "HAZE.Benchmark.Hex", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHazeHexBenchmark::RunTest(const FString& Parameters)
+{
+	const double Seconds = HazeBenchmark::MinSecondsFromCommandLine();
+	uint8 Bytes[64];
+	for (int32 i = 0; i < UE_ARRAY_COUNT(Bytes); i++)
+	{
+		Bytes[i] = static_cast<uint8>(i * 37 + 11);
+	}
+	const FString AddressHex = FHazeHex::ToHex(MakeArrayView(Bytes, 32));
+	const FString PastedHex = TEXT("  ") + AddressHex + TEXT("\r\n");
+	TCHAR Chars[128];
+	UTF8CHAR Utf8[128];
+	uint8 Decoded[32];
+	int32 Sink = 0;
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("Encode 32 bytes (TCHAR)"), [&]
+	{
+		FHazeHex::Encode(Bytes, 32, Chars);
+		Sink += Chars[0];
+	}, Seconds));
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("Encode 64 bytes (UTF-8)"), [&]
+	{
+		FHazeHex::Encode(Bytes, 64, Utf8);
+		Sink += Utf8[0];
+	}, Seconds));
+
+	HazeBenchmark::Run(*this, TEXT("ToHex 32 bytes"), [&]
+	{
+		Sink += FHazeHex::ToHex(MakeArrayView(Bytes, 32)).Len();
+	}, Seconds);
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("Decode 64 digits"), [&]
+	{
+		Sink += FHazeHex::Decode(AddressHex, Decoded, 32) ? 1 : 0;
+	}, Seconds));
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("DecodeLenient 64 digits + whitespace"), [&]
+	{
+		Sink += FHazeHex::DecodeLenient(PastedHex, Decoded, 32);
+	}, Seconds));
+
+	TestTrue(TEXT("Hex was processed"), Sink > 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTransactionJsonBenchmark, "HAZE.Benchmark.TransactionBuild", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHazeTransactionJsonBenchmark::RunTest(const FString& Parameters)
+{
+	UHazeKeyPair* Key = UHazeKeyPair::Generate();
+	if (!Key)
+	{
+		AddInfo(TEXT("Ed25519 is not linked (HAZE_HAS_ED25519); transaction build benchmarks skipped"));
+		return true;
+	}
+
+	const double Seconds = HazeBenchmark::MinSecondsFromCommandLine();
+	const FString To = FHazeHex::ToHex(TestAddress(0x22));
+	const FString AssetId = FHazeHex::ToHex(TestAddress(0x33));
+	TMap<FString, FString> Metadata;
+	Metadata.Add(TEXT("name"), TEXT("Sword of Dawn"));
+	Metadata.Add(TEXT("class"), TEXT("weapon"));
+	int64 Sink = 0;
+
+	HazeBenchmark::Run(*this, TEXT("BuildSignedTransfer (FString)"), [&]
+	{
+		Sink += FTransactionBuilder::BuildSignedTransfer(Key, To, 1000000, 1000, 5, 1ull, 500ull).Len();
+	}, Seconds);
+
+	TArray<uint8> Body;
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("WriteSignedTransferRequest (reused)"), [&]
+	{
+		FTransactionBuilder::WriteSignedTransferRequest(Body, Key, To, 1000000, 1000, 5, 1ull, 500ull);
+		Sink += Body.Num();
+	}, Seconds));
+
+	HazeBenchmark::Run(*this, TEXT("BuildSignedTransferBinary"), [&]
+	{
+		Sink += FTransactionBuilder::BuildSignedTransferBinary(Key, To, 1000000, 1000, 5, 1ull, 500ull).Num();
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("WriteSignedMistbornCreateRequest"), [&]
+	{
+		FTransactionBuilder::WriteSignedMistbornCreateRequest(Body, Key, AssetId, EDensityLevel::Light, Metadata, TEXT("haze-rpg"), 10, 3);
+		Sink += Body.Num();
+	}, Seconds);
+
+	TArray<FHazeTransferIntent> Intents;
+	Intents.SetNum(256);
+	for (int32 i = 0; i < Intents.Num(); i++)
+	{
+		Intents[i].ToAddressHex = To;
+		Intents[i].Amount = 1000;
+		Intents[i].Fee = 10;
+		Intents[i].Nonce = i;
+	}
+	const FHazeBenchmarkResult Batch = HazeBenchmark::Run(*this, TEXT("BuildSignedTransferBatch (256)"), [&]
+	{
+		Sink += FTransactionBuilder::BuildSignedTransferBatch(Key, Intents).Num();
+	}, Seconds, 4);
+	AddInfo(FString::Printf(TEXT("BuildSignedTransferBatch: %.0f transactions/s"), Batch.OpsPerSecond * Intents.Num()));
+
+	TestTrue(TEXT("Transactions were built"), Sink > 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeAmountBenchmark, "HAZE.Benchmark.Amount", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHazeAmountBenchmark::RunTest(const FString& Parameters)
+{
+	const double Seconds = HazeBenchmark::MinSecondsFromCommandLine();
+	const FString Small = TEXT("1000000000");
+	const FString Wide = TEXT("340282366920938463463374607431768211455");
+	const FHazeAmount Reserve = FHazeAmount::FromParts(3, 12345);
+	TCHAR Chars[FHazeAmount::MaxDigits];
+	FHazeAmount Value;
+	int64 Sink = 0;
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("FHazeAmount::Parse (10 digits)"), [&]
+	{
+		Sink += FHazeAmount::Parse(Small, Value) ? 1 : 0;
+	}, Seconds));
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("FHazeAmount::Parse (39 digits)"), [&]
+	{
+		Sink += FHazeAmount::Parse(Wide, Value) ? 1 : 0;
+	}, Seconds));
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("FHazeAmount::ToChars (39 digits)"), [&]
+	{
+		Sink += FHazeAmount::MaxValue().ToChars(Chars);
+	}, Seconds));
+
+	HazeBenchmark::Run(*this, TEXT("FHazeAmount::ToDisplayString"), [&]
+	{
+		Sink += Reserve.ToDisplayString().Len();
+	}, Seconds);
+
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("FHazeAmount a * b / c"), [&]
+	{
+		Value = Reserve * FHazeAmount(1000000007) / (Reserve + FHazeAmount(Sink));
+		Sink += static_cast<int64>(Value.Low & 1);
+	}, Seconds));
+
+	// A swap preview requotes on every input change
+	FHazeSwapQuote Quote;
+	ExpectNoAllocations(*this, HazeBenchmark::Run(*this, TEXT("FHazeAmm::QuoteExactIn"), [&]
+	{
+		FHazeAmm::QuoteExactIn(FHazeAmount(1000000000000), FHazeAmount(2000000000000), 30, FHazeAmount(1000 + (Sink & 1023)), Quote);
+		Sink += static_cast<int64>(Quote.AmountOut.Low & 1) + 1;
+	}, Seconds));
+
+	TestTrue(TEXT("Amounts were processed"), Sink > 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeResponseBenchmark, "HAZE.Benchmark.ResponseParse", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHazeResponseBenchmark::RunTest(const FString& Parameters)
+{
+	const double Seconds = HazeBenchmark::MinSecondsFromCommandLine();
+	int64 Sink = 0;
+
+	HazeBenchmark::Run(*this, TEXT("ParseHealth"), [&]
+	{
+		FString Health;
+		Sink += HazeResponse::ParseHealth(Utf8(HazeTestResponses::Health), Health);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseBlockchainInfo"), [&]
+	{
+		FBlockchainInfo Info;
+		Sink += HazeResponse::ParseBlockchainInfo(Utf8(HazeTestResponses::BlockchainInfo), Info);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseBalance"), [&]
+	{
+		FHazeAmount Balance;
+		Sink += HazeResponse::ParseBalance(Utf8(HazeTestResponses::Balance), Balance);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseAccount"), [&]
+	{
+		FAccountInfo Account;
+		Sink += HazeResponse::ParseAccount(Utf8(HazeTestResponses::Account), Account);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseTransaction"), [&]
+	{
+		FTransactionResponse Response;
+		Sink += HazeResponse::ParseTransaction(Utf8(HazeTestResponses::Transaction), Response);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseTransactionBatch (3)"), [&]
+	{
+		TArray<FBatchTransactionResult> Results;
+		Sink += HazeResponse::ParseTransactionBatch(Utf8(HazeTestResponses::TransactionBatch), Results);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseAsset"), [&]
+	{
+		FHazeAssetInfo Asset;
+		Sink += HazeResponse::ParseAsset(Utf8(HazeTestResponses::Asset), Asset);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseAssetBlobRef"), [&]
+	{
+		FString BlobHash;
+		Sink += HazeResponse::ParseAssetBlobRef(Utf8(HazeTestResponses::Asset), TEXT("model"), BlobHash);
+	}, Seconds);
+
+	HazeBenchmark::Run(*this, TEXT("ParseAssetSummaries (2)"), [&]
+	{
+		TArray<FHazeAssetInfo> Assets;
+		Sink += HazeResponse::ParseAssetSummaries(Utf8(HazeTestResponses::AssetSummaries), Assets);
+	}, Seconds);
+
+	const TArray<uint8> SearchBody = HazeTestResponses::SearchPage(1000);
+	const FHazeBenchmarkResult Search = HazeBenchmark::Run(*this, TEXT("ParseAssetSearchPage (1000)"), [&]
+	{
+		FHazeAssetPage Page;
+		Page.Reserve(1000);
+		Sink += HazeResponse::ParseAssetSearchPage(SearchBody, Page, TEXT("name"));
+	}, Seconds, 4);
+	AddInfo(FString::Printf(TEXT("ParseAssetSearchPage: %.1f MB/s"), Search.OpsPerSecond * SearchBody.Num() / (1024.0 * 1024.0)));
+
+	TestTrue(TEXT("Responses were parsed"), Sink > 0);
+	return true;
+}
+
+#endif
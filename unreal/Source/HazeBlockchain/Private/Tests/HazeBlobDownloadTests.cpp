@@ -0,0 +1,233 @@
+// Copyright HAZE Blockchain. Content-Range parsing, ignored ranges, resume and verification of blob downloads.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeBlobCache.h"
+#include "HazeBlobDownload.h"
+#include "HazeSha256.h"
+#include "Async/Async.h"
+#include "HAL/PlatformFileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	/** The smallest chunk FHazeBlobDownload uses; blobs below are sized against it */
+	constexpr int32 ChunkSize = 64 * 1024;
+
+	/** Seconds a download may take before the test gives up on it */
+	constexpr double DownloadTimeout = 10.0;
+
+	/** Random bytes, so no earlier run left this blob (or its partial file) in the cache */
+	TArray<uint8> MakeBlob(int32 Size)
+	{
+		FRandomStream Stream(static_cast<int32>(FPlatformTime::Cycles()));
+		TArray<uint8> Blob;
+		Blob.SetNumUninitialized(Size);
+		for (uint8& Byte : Blob)
+		{
+			Byte = static_cast<uint8>(Stream.RandRange(0, 255));
+		}
+		return Blob;
+	}
+
+	/** Node that serves Served for every request, honouring Range unless bIgnoreRange */
+	struct FFakeBlobNode : TSharedFromThis<FFakeBlobNode, ESPMode::ThreadSafe>
+	{
+		TArray<uint8> Served;
+		bool bIgnoreRange = false;
+		/** Range header of each request, in order */
+		TArray<FString> Ranges;
+
+		FHazeBlobTransport Transport()
+		{
+			return [This = AsShared()](const TMap<FString, FString>& Headers, TFunction<void(FHazeBlobResponse&&)> OnResponse)
+			{
+				const FString Range = Headers.FindRef(TEXT("Range"));
+				This->Ranges.Add(Range);
+
+				FHazeBlobResponse Response;
+				FString Spec, StartText, EndText;
+				const int64 Size = This->Served.Num();
+				if (This->bIgnoreRange || !Range.Split(TEXT("="), nullptr, &Spec) || !Spec.Split(TEXT("-"), &StartText, &EndText))
+				{
+					Response.Code = 200;
+					Response.Body = This->Served;
+				}
+				else if (FCString::Atoi64(*StartText) >= Size)
+				{
+					Response.Code = 416;
+					Response.ContentRange = FString::Printf(TEXT("bytes */%lld"), Size);
+				}
+				else
+				{
+					const int64 Start = FCString::Atoi64(*StartText);
+					const int64 End = FMath::Min(FCString::Atoi64(*EndText), Size - 1);
+					Response.Code = 206;
+					Response.ContentRange = FString::Printf(TEXT("bytes %lld-%lld/%lld"), Start, End, Size);
+					Response.Body.Append(This->Served.GetData() + Start, static_cast<int32>(End - Start + 1));
+				}
+				AsyncTask(ENamedThreads::GameThread, [OnResponse = MoveTemp(OnResponse), Response = MoveTemp(Response)]() mutable
+				{
+					OnResponse(MoveTemp(Response));
+				});
+			};
+		}
+	};
+
+	/** One download against a fake node and its outcome */
+	struct FBlobRun
+	{
+		FString Hash;
+		TArray<uint8> Blob;
+		TSharedRef<FFakeBlobNode, ESPMode::ThreadSafe> Node = MakeShared<FFakeBlobNode, ESPMode::ThreadSafe>();
+		TSharedPtr<FHazeBlobDownload, ESPMode::ThreadSafe> Download;
+		double Started = 0.0;
+		bool bDone = false;
+		bool bOk = false;
+		/** The download's owner was told it finished */
+		bool bReleased = false;
+		bool bReleasedBeforeWaiter = false;
+		FHazeBlobDownloadResult Result;
+
+		explicit FBlobRun(int32 Size)
+			: Blob(MakeBlob(Size))
+		{
+			Hash = FHazeSha256::HashHex(Blob);
+			Node->Served = Blob;
+		}
+
+		bool HasPartialFile() const { return FPlatformFileManager::Get().GetPlatformFile().FileExists(*FHazeBlobCache::GetPartialPath(Hash)); }
+	};
+
+	void StartDownload(const TSharedRef<FBlobRun>& Run)
+	{
+		Run->Started = FPlatformTime::Seconds();
+		Run->Download = MakeShared<FHazeBlobDownload, ESPMode::ThreadSafe>(Run->Hash, ChunkSize, Run->Node->Transport());
+		Run->Download->AddWaiter([Run](bool bOk, const FHazeBlobDownloadResult& Result)
+		{
+			Run->bDone = true;
+			Run->bOk = bOk;
+			Run->Result = Result;
+			Run->bReleasedBeforeWaiter = Run->bReleased;
+		}, nullptr);
+		Run->Download->Start([Run]() { Run->bReleased = true; });
+	}
+
+	/** Wait for Run, check it with Check, then clear its cache entries */
+	void WaitForDownload(FAutomationTestBase& Test, const TSharedRef<FBlobRun>& Run, TFunction<void(FBlobRun&)> Check)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&Test, Run, Check = MoveTemp(Check)]() -> bool
+		{
+			if (!Run->bDone && FPlatformTime::Seconds() - Run->Started < DownloadTimeout) return false;
+			if (Test.TestTrue(TEXT("Download finished"), Run->bDone))
+			{
+				Test.TestTrue(TEXT("Owner released the download before the waiters ran"), Run->bReleasedBeforeWaiter);
+				Check(*Run);
+			}
+			FHazeBlobCache::Remove(Run->Hash);
+			return true;
+		}));
+	}
+
+	/** The verified file holds exactly Run's blob */
+	void TestCachedBlob(FAutomationTestBase& Test, const FBlobRun& Run)
+	{
+		TArray<uint8> Cached;
+		Test.TestTrue(TEXT("Cached"), FFileHelper::LoadFileToArray(Cached, *FHazeBlobCache::GetBlobPath(Run.Hash)));
+		Test.TestTrue(TEXT("Cached bytes"), Cached == Run.Blob);
+		Test.TestEqual(TEXT("Size"), Run.Result.Size, static_cast<int64>(Run.Blob.Num()));
+		Test.TestFalse(TEXT("No partial file left"), Run.HasPartialFile());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeBlobContentRangeTest, "HAZE.Blob.ContentRange", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeBlobContentRangeTest::RunTest(const FString& Parameters)
+{
+	int64 Start = 0, End = 0, Total = 0;
+	TestTrue(TEXT("Range"), FHazeBlobDownload::ParseContentRange(TEXT("bytes 0-99/1000"), Start, End, Total)
+		&& Start == 0 && End == 99 && Total == 1000);
+	TestTrue(TEXT("Last byte"), FHazeBlobDownload::ParseContentRange(TEXT(" bytes 999-999/1000 "), Start, End, Total)
+		&& Start == 999 && End == 999 && Total == 1000);
+	TestTrue(TEXT("Unsatisfiable form"), FHazeBlobDownload::ParseContentRange(TEXT("bytes */1000"), Start, End, Total)
+		&& Start == -1 && End == -1 && Total == 1000);
+
+	for (const TCHAR* Malformed : {
+		TEXT(""), TEXT("bytes"), TEXT("bytes 0-99"), TEXT("bytes 0-99/*"), TEXT("items 0-99/1000"), TEXT("bytes=0-99/1000"),
+		TEXT("bytes 99-0/1000"), TEXT("bytes 0-1000/1000"), TEXT("bytes a-b/1000"), TEXT("bytes -5/1000"), TEXT("bytes */") })
+	{
+		TestFalse(FString::Printf(TEXT("Malformed '%s'"), Malformed), FHazeBlobDownload::ParseContentRange(Malformed, Start, End, Total));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeBlobIgnoredRangeTest, "HAZE.Blob.IgnoredRange", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeBlobIgnoredRangeTest::RunTest(const FString& Parameters)
+{
+	// The node answers the first range with 200 and the whole blob: nothing more is requested
+	TSharedRef<FBlobRun> Run = MakeShared<FBlobRun>(ChunkSize + ChunkSize / 2);
+	Run->Node->bIgnoreRange = true;
+	StartDownload(Run);
+	WaitForDownload(*this, Run, [this](FBlobRun& Done)
+	{
+		TestTrue(TEXT("Downloaded"), Done.bOk);
+		TestFalse(TEXT("Not from the cache"), Done.Result.bFromCache);
+		TestCachedBlob(*this, Done);
+		if (TestEqual(TEXT("One request"), Done.Node->Ranges.Num(), 1))
+		{
+			TestEqual(TEXT("First chunk asked for"), Done.Node->Ranges[0], FString::Printf(TEXT("bytes=0-%d"), ChunkSize - 1));
+		}
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeBlobResumeTest, "HAZE.Blob.Resume", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeBlobResumeTest::RunTest(const FString& Parameters)
+{
+	// An earlier session wrote the first 30000 bytes: the download asks for the rest only
+	constexpr int32 Resumed = 30000;
+	TSharedRef<FBlobRun> Run = MakeShared<FBlobRun>(100000);
+	if (!TestTrue(TEXT("Partial file"), FFileHelper::SaveArrayToFile(MakeArrayView(Run->Blob.GetData(), Resumed), *FHazeBlobCache::GetPartialPath(Run->Hash))))
+	{
+		return false;
+	}
+	StartDownload(Run);
+	WaitForDownload(*this, Run, [this, Resumed](FBlobRun& Done)
+	{
+		TestTrue(TEXT("Downloaded"), Done.bOk);
+		TestCachedBlob(*this, Done);
+		if (TestEqual(TEXT("Two chunks"), Done.Node->Ranges.Num(), 2))
+		{
+			TestEqual(TEXT("Resumed at the partial file's end"), Done.Node->Ranges[0], FString::Printf(TEXT("bytes=%d-%d"), Resumed, Resumed + ChunkSize - 1));
+			TestEqual(TEXT("Then the next chunk"), Done.Node->Ranges[1], FString::Printf(TEXT("bytes=%d-%d"), Resumed + ChunkSize, Resumed + 2 * ChunkSize - 1));
+		}
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeBlobHashMismatchTest, "HAZE.Blob.HashMismatch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeBlobHashMismatchTest::RunTest(const FString& Parameters)
+{
+	// The node serves other bytes than the hash names: nothing is cached and the partial file goes
+	TSharedRef<FBlobRun> Run = MakeShared<FBlobRun>(ChunkSize + 1000);
+	Run->Node->Served[ChunkSize + 10] ^= 0xff;
+	StartDownload(Run);
+	WaitForDownload(*this, Run, [this](FBlobRun& Done)
+	{
+		TestFalse(TEXT("Failed"), Done.bOk);
+		TestTrue(TEXT("Hash mismatch"), Done.Result.Error.StartsWith(TEXT("hash mismatch")));
+		TestTrue(TEXT("No file path"), Done.Result.FilePath.IsEmpty());
+		TestFalse(TEXT("Not cached"), FHazeBlobCache::Contains(Done.Hash));
+		TestFalse(TEXT("Partial file deleted"), Done.HasPartialFile());
+	});
+	return true;
+}
+
+#endif
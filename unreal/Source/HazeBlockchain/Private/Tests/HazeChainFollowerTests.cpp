@@ -0,0 +1,172 @@
+// Copyright HAZE Blockchain. Receipt tracking from recent blocks, reorgs and block decoding.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeChainFollower.h"
+#include "HazeResponseParser.h"
+#include "HazeTestResponses.h"
+
+using HazeTestResponses::Utf8;
+
+namespace
+{
+	/** Block at Height on fork Fork (hashes "<fork>-<height>"), parent on the same fork */
+	FHazeBlockInfo MakeBlock(int64 Height, TArray<FString> Transactions = {}, const TCHAR* Fork = TEXT("a"))
+	{
+		FHazeBlockInfo Block;
+		Block.Height = Height;
+		Block.Hash = FString::Printf(TEXT("%s-%lld"), Fork, Height);
+		Block.ParentHash = FString::Printf(TEXT("%s-%lld"), Fork, Height - 1);
+		Block.Transactions = MoveTemp(Transactions);
+		return Block;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeChainFollowerReceiptTest, "HAZE.Follower.Receipts", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeChainFollowerReceiptTest::RunTest(const FString& Parameters)
+{
+	UHazeChainFollower* Follower = UHazeChainFollower::CreateChainFollower(nullptr);
+	Follower->RecentBlocks = 4;
+
+	TArray<FHazeReceipt> Updates;
+	Follower->TrackTransactionNative(TEXT("AA01"), [&Updates](const FHazeReceipt& Receipt) { Updates.Add(Receipt); });
+	Follower->TrackTransaction(TEXT("bb02"));
+	TestEqual(TEXT("Tracked"), Follower->GetTrackedCount(), 2);
+
+	TestTrue(TEXT("First block positions"), Follower->ApplyBlock(MakeBlock(10)));
+	TestTrue(TEXT("Next block"), Follower->ApplyBlock(MakeBlock(11, { TEXT("aa01"), TEXT("cc03") })));
+	TestFalse(TEXT("Duplicate"), Follower->ApplyBlock(MakeBlock(11, { TEXT("aa01"), TEXT("cc03") })));
+	TestFalse(TEXT("Gap"), Follower->ApplyBlock(MakeBlock(13)));
+	TestEqual(TEXT("Head"), Follower->GetHeadHeight(), 11ll);
+
+	FHazeReceipt Receipt;
+	TestTrue(TEXT("Receipt"), Follower->GetReceipt(TEXT("aa01"), Receipt));
+	TestTrue(TEXT("Confirmed"), Receipt.Status == EHazeReceiptStatus::Confirmed && Receipt.BlockHeight == 11 && Receipt.BlockHash == TEXT("a-11"));
+	TestEqual(TEXT("Callback on confirm"), Updates.Num(), 1);
+	TestTrue(TEXT("Other still pending"), Follower->GetReceipt(TEXT("bb02"), Receipt) && Receipt.Status == EHazeReceiptStatus::Pending);
+
+	// Tracked after its block arrived: resolved from the buffer
+	Follower->TrackTransaction(TEXT("cc03"));
+	TestTrue(TEXT("Late track"), Follower->GetReceipt(TEXT("cc03"), Receipt) && Receipt.Status == EHazeReceiptStatus::Confirmed);
+
+	// Finality drops the receipts it settles
+	Follower->ApplyFinalizedHeight(11);
+	TestFalse(TEXT("Finalized receipt dropped"), Follower->GetReceipt(TEXT("aa01"), Receipt));
+	if (TestEqual(TEXT("Callback on finalize"), Updates.Num(), 2))
+	{
+		TestTrue(TEXT("Finalized"), Updates[1].Status == EHazeReceiptStatus::Finalized && Updates[1].BlockHeight == 11);
+	}
+	TestEqual(TEXT("Only the pending one left"), Follower->GetTrackedCount(), 1);
+
+	// Blocks at or below finality settle straight away
+	Follower->ApplyFinalizedHeight(12);
+	Follower->ApplyBlock(MakeBlock(12, { TEXT("bb02") }));
+	TestEqual(TEXT("Confirmed and finalized at once"), Follower->GetTrackedCount(), 0);
+
+	// The buffer keeps RecentBlocks blocks
+	for (int64 Height = 13; Height <= 16; Height++)
+	{
+		Follower->ApplyBlock(MakeBlock(Height));
+	}
+	TestNull(TEXT("Evicted"), Follower->FindBlock(12));
+	TestNotNull(TEXT("Kept"), Follower->FindBlock(13));
+	Follower->TrackTransaction(TEXT("bb02"));
+	TestTrue(TEXT("Evicted transactions are unknown"), Follower->GetReceipt(TEXT("bb02"), Receipt) && Receipt.Status == EHazeReceiptStatus::Pending);
+	Follower->UntrackTransaction(TEXT("bb02"));
+	TestEqual(TEXT("Untracked"), Follower->GetTrackedCount(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeChainFollowerListenersTest, "HAZE.Follower.Listeners", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeChainFollowerListenersTest::RunTest(const FString& Parameters)
+{
+	UHazeChainFollower* Follower = UHazeChainFollower::CreateChainFollower(nullptr);
+	TArray<FString> Heard;
+	const uint64 Ledger = Follower->TrackTransactionNative(TEXT("aa01"), [&Heard](const FHazeReceipt&) { Heard.Add(TEXT("ledger")); });
+	const uint64 Waiter = Follower->TrackTransactionNative(TEXT("AA01"), [&Heard](const FHazeReceipt&) { Heard.Add(TEXT("waiter")); });
+	TestTrue(TEXT("Distinct handles"), Ledger != 0 && Waiter != 0 && Ledger != Waiter);
+	TestEqual(TEXT("No handle without a callback"), Follower->TrackTransactionNative(TEXT("bb02"), nullptr), uint64(0));
+	TestEqual(TEXT("One entry per hash"), Follower->GetTrackedCount(), 2);
+
+	// A second caller does not replace the first one's callback
+	Follower->ApplyBlock(MakeBlock(30));
+	Follower->ApplyBlock(MakeBlock(31, { TEXT("aa01") }));
+	TestTrue(TEXT("Both heard"), Heard == TArray<FString>({ TEXT("ledger"), TEXT("waiter") }));
+
+	// Removing one listener keeps the other and the tracking
+	Follower->RemoveReceiptListener(TEXT("aa01"), Waiter);
+	Follower->ApplyFinalizedHeight(31);
+	TestTrue(TEXT("Only the ledger"), Heard == TArray<FString>({ TEXT("ledger"), TEXT("waiter"), TEXT("ledger") }));
+
+	// The last listener leaving untracks, unless the hash was also tracked without one
+	Follower->TrackTransaction(TEXT("bb02"));
+	const uint64 OnPlain = Follower->TrackTransactionNative(TEXT("bb02"), [](const FHazeReceipt&) {});
+	Follower->RemoveReceiptListener(TEXT("bb02"), OnPlain);
+	TestEqual(TEXT("Plain tracking kept"), Follower->GetTrackedCount(), 1);
+	const uint64 Only = Follower->TrackTransactionNative(TEXT("cc03"), [](const FHazeReceipt&) {});
+	Follower->RemoveReceiptListener(TEXT("cc03"), Ledger);
+	TestEqual(TEXT("Unknown handle ignored"), Follower->GetTrackedCount(), 2);
+	Follower->RemoveReceiptListener(TEXT("cc03"), Only);
+	TestEqual(TEXT("Last listener untracks"), Follower->GetTrackedCount(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeChainFollowerReorgTest, "HAZE.Follower.Reorg", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeChainFollowerReorgTest::RunTest(const FString& Parameters)
+{
+	UHazeChainFollower* Follower = UHazeChainFollower::CreateChainFollower(nullptr);
+	TArray<EHazeReceiptStatus> Updates;
+	Follower->TrackTransactionNative(TEXT("aa01"), [&Updates](const FHazeReceipt& Receipt) { Updates.Add(Receipt.Status); });
+
+	Follower->ApplyBlock(MakeBlock(20));
+	Follower->ApplyBlock(MakeBlock(21, { TEXT("aa01") }));
+	Follower->ApplyFinalizedHeight(20);
+
+	// Fork b replaced 21: its child does not link to the held 21, which is rolled back
+	TestTrue(TEXT("Parent mismatch rolls back"), Follower->ApplyBlock(MakeBlock(22, {}, TEXT("b"))));
+	TestEqual(TEXT("Head back to the final block"), Follower->GetHeadHeight(), 20ll);
+	FHazeReceipt Receipt;
+	TestTrue(TEXT("Reverted"), Follower->GetReceipt(TEXT("aa01"), Receipt) && Receipt.Status == EHazeReceiptStatus::Pending);
+
+	FHazeBlockInfo Replacement = MakeBlock(21, { TEXT("aa01") }, TEXT("b"));
+	Replacement.ParentHash = TEXT("a-20");
+	TestTrue(TEXT("Replacement"), Follower->ApplyBlock(Replacement));
+	TestTrue(TEXT("Confirmed again"), Follower->GetReceipt(TEXT("aa01"), Receipt) && Receipt.BlockHash == TEXT("b-21"));
+	TestTrue(TEXT("Confirm, revert, confirm"), Updates == TArray<EHazeReceiptStatus>({ EHazeReceiptStatus::Confirmed, EHazeReceiptStatus::Pending, EHazeReceiptStatus::Confirmed }));
+
+	// A final block is never replaced
+	FHazeBlockInfo Conflict = MakeBlock(20, {}, TEXT("c"));
+	TestFalse(TEXT("Finalized block kept"), Follower->ApplyBlock(Conflict));
+	TestEqual(TEXT("Held hash"), Follower->FindBlock(20)->Hash, TEXT("a-20"));
+
+	// An event (no parent hash) with another hash at an unfinalized height replaces it and everything above
+	FHazeBlockInfo Event;
+	Event.Height = 21;
+	Event.Hash = TEXT("d-21");
+	TestTrue(TEXT("Event replaces the tip"), Follower->ApplyBlock(Event));
+	TestTrue(TEXT("Not in the new block"), Follower->GetReceipt(TEXT("aa01"), Receipt) && Receipt.Status == EHazeReceiptStatus::Pending);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeParseBlockTest, "HAZE.Response.Block", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeParseBlockTest::RunTest(const FString& Parameters)
+{
+	FHazeBlockInfo Block;
+	TestTrue(TEXT("Block"), HazeResponse::ParseBlock(Utf8(HazeTestResponses::Block), Block));
+	TestEqual(TEXT("Hash"), Block.Hash, TEXT("0b0b"));
+	TestEqual(TEXT("Parent"), Block.ParentHash, TEXT("0a0a"));
+	TestEqual(TEXT("Height"), Block.Height, 42ll);
+	TestEqual(TEXT("Wave"), Block.WaveNumber, 7ll);
+	TestTrue(TEXT("Transactions in order"), Block.Transactions == TArray<FString>({ TEXT("aa01"), TEXT("aa02") }));
+	TestFalse(TEXT("Unknown height"), HazeResponse::ParseBlock(Utf8(R"({"success":false,"data":null,"error":"Not found"})"), Block));
+	return true;
+}
+
+#endif
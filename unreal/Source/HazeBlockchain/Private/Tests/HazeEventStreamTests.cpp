@@ -0,0 +1,76 @@
+// Copyright HAZE Blockchain. Several consumers sharing one event stream.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeEventStream.h"
+#include "HazeAssetStreamer.h"
+#include "HazeChainFollower.h"
+#include "HazeClient.h"
+#include "HazePoolBook.h"
+
+namespace
+{
+	bool HasType(const UHazeEventStream* Stream, EHazeStreamEventType Type)
+	{
+		return Stream->GetSubscriptions().ContainsByPredicate([Type](const FHazeStreamSubscription& Sub) { return Sub.Type == Type; });
+	}
+
+	FHazeStreamSubscription MakeSubscription(EHazeStreamEventType Type)
+	{
+		FHazeStreamSubscription Subscription;
+		Subscription.Type = Type;
+		return Subscription;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeEventStreamSharedTest, "HAZE.EventStream.Shared", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeEventStreamSharedTest::RunTest(const FString& Parameters)
+{
+	UHazeEventStream* Stream = UHazeEventStream::CreateEventStream(TEXT("http://127.0.0.1:1"));
+	UHazePoolBook* Book = UHazePoolBook::CreatePoolBook(nullptr);
+	UHazeChainFollower* Follower = UHazeChainFollower::CreateChainFollower(nullptr);
+	UHazeClient* Client = UHazeClient::CreateClient(TEXT("http://127.0.0.1:1"));
+	UHazeAssetStreamer* Streamer = UHazeAssetStreamer::CreateAssetStreamer(nullptr);
+
+	// Each binder adds its own types; none narrows the filter under another
+	Book->BindEventStream(Stream);
+	Follower->BindEventStream(Stream);
+	Client->BindCacheInvalidation(Stream);
+	Streamer->BindInvalidation(Stream);
+	TestTrue(TEXT("Pool events"), HasType(Stream, EHazeStreamEventType::PoolUpdated));
+	TestTrue(TEXT("Block events"), HasType(Stream, EHazeStreamEventType::BlockApplied));
+	TestTrue(TEXT("Asset events"), HasType(Stream, EHazeStreamEventType::AssetUpdated) && HasType(Stream, EHazeStreamEventType::AssetVersionCreated));
+	const int32 Count = Stream->GetSubscriptions().Num();
+	TestEqual(TEXT("Shared filter listed once"), Stream->GetSubscriptions().FilterByPredicate([](const FHazeStreamSubscription& Sub) { return Sub.Type == EHazeStreamEventType::BlockApplied; }).Num(), 1);
+
+	// Both consumers see their events from the one stream
+	FHazeStreamEvent Pool;
+	Pool.Type = EHazeStreamEventType::PoolUpdated;
+	Pool.Pool.PoolId = TEXT("pool-1");
+	Stream->OnEventNative().Broadcast(Pool);
+	FHazeStreamEvent Block;
+	Block.Type = EHazeStreamEventType::BlockApplied;
+	Block.Height = 7;
+	Block.BlockHash = TEXT("a-7");
+	Stream->OnEventNative().Broadcast(Block);
+	FLiquidityPool Found;
+	TestTrue(TEXT("Pool book applied"), Book->GetPool(TEXT("pool-1"), Found));
+	TestEqual(TEXT("Follower applied"), Follower->GetHeadHeight(), 7ll);
+
+	// BlockApplied is held by the follower and the client: one release keeps it
+	Stream->Unsubscribe(MakeSubscription(EHazeStreamEventType::BlockApplied));
+	TestTrue(TEXT("Still held"), HasType(Stream, EHazeStreamEventType::BlockApplied));
+	Stream->Unsubscribe(MakeSubscription(EHazeStreamEventType::BlockApplied));
+	TestFalse(TEXT("Released"), HasType(Stream, EHazeStreamEventType::BlockApplied));
+	TestEqual(TEXT("Others untouched"), Stream->GetSubscriptions().Num(), Count - 1);
+
+	Stream->ClearSubscriptions();
+	TestEqual(TEXT("Cleared"), Stream->GetSubscriptions().Num(), 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,93 @@
+// Copyright HAZE Blockchain. Local gas estimates against the node's calculate_asset_operation_gas.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeGasEstimator.h"
+#include "HazeResponseParser.h"
+#include "HazeTestResponses.h"
+
+using HazeTestResponses::Utf8;
+
+namespace
+{
+	struct FGasVector
+	{
+		EAssetAction Action;
+		EDensityLevel Density;
+		const TCHAR* Key;
+		FString Value;
+		uint64 Expected;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeGasVectorsTest, "HAZE.Gas.Vectors", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeGasVectorsTest::RunTest(const FString& Parameters)
+{
+	FHazeGasSchedule Schedule;
+	if (!TestTrue(TEXT("Schedule"), HazeResponse::ParseGasSchedule(Utf8(HazeTestResponses::GasSchedule), Schedule))) return false;
+	TestEqual(TEXT("Version"), Schedule.Version, int64(4503599627370495));
+	TestEqual(TEXT("Core multiplier"), Schedule.CondenseMultiplierCore, int64(5));
+
+	// test_asset_gas_vectors in src/assets.rs
+	const FGasVector Vectors[] =
+	{
+		{ EAssetAction::Create, EDensityLevel::Ethereal, nullptr, FString(), 10000 },
+		{ EAssetAction::Create, EDensityLevel::Ethereal, TEXT("name"), TEXT("Sword"), 10100 },
+		// 513 two-byte characters: 1026 UTF-8 bytes, two KB
+		{ EAssetAction::Create, EDensityLevel::Ethereal, TEXT("name"), FString::ChrN(513, TCHAR(0x03A9)), 10200 },
+		{ EAssetAction::Update, EDensityLevel::Light, TEXT("bio"), FString::ChrN(1024, TEXT('a')), 5050 },
+		{ EAssetAction::Update, EDensityLevel::Light, TEXT("bio"), FString::ChrN(1025, TEXT('a')), 5100 },
+		{ EAssetAction::Condense, EDensityLevel::Dense, TEXT("name"), FString::ChrN(10, TEXT('a')), 30200 },
+		{ EAssetAction::Condense, EDensityLevel::Core, TEXT("model"), FString::ChrN(2048, TEXT('a')), 75400 },
+		{ EAssetAction::Evaporate, EDensityLevel::Ethereal, TEXT("name"), FString::ChrN(5000, TEXT('a')), 2000 },
+		{ EAssetAction::Merge, EDensityLevel::Light, nullptr, FString(), 20000 },
+		{ EAssetAction::Merge, EDensityLevel::Light, TEXT("_other_asset_id"), FString::ChrN(64, TEXT('a')), 20150 },
+		{ EAssetAction::Split, EDensityLevel::Light, TEXT("name"), TEXT("x"), 20100 },
+		{ EAssetAction::Split, EDensityLevel::Light, TEXT("_components"), TEXT("a, b,,c"), 30300 },
+		{ EAssetAction::Split, EDensityLevel::Light, TEXT("_components"), TEXT(" ,"), 15000 },
+	};
+	int32 Index = 0;
+	for (const FGasVector& Vector : Vectors)
+	{
+		TMap<FString, FString> Metadata;
+		if (Vector.Key) Metadata.Add(Vector.Key, Vector.Value);
+		TestEqual(FString::Printf(TEXT("Vector %d"), Index++), FHazeGasEstimate::GasCost(Schedule, Vector.Action, Vector.Density, Metadata), Vector.Expected);
+	}
+
+	TestEqual(TEXT("Components"), FHazeGasEstimate::CountComponents(TEXT("sword,,  hilt , gem")), uint64(3));
+	TestEqual(TEXT("UTF-8 bytes"), FHazeGasEstimate::MetadataBytes({ { TEXT("a"), TEXT("ab") }, { TEXT("b"), FString::ChrN(2, TCHAR(0x03A9)) } }), uint64(6));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeGasEstimatorTest, "HAZE.Gas.Estimator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeGasEstimatorTest::RunTest(const FString& Parameters)
+{
+	UHazeGasEstimator* Estimator = UHazeGasEstimator::CreateGasEstimator(nullptr);
+	TestFalse(TEXT("Not ready"), Estimator->IsReady());
+	TestFalse(TEXT("No schedule, no quote"), Estimator->Estimate(EAssetAction::Evaporate, EDensityLevel::Ethereal, {}).bValid);
+
+	FHazeGasSchedule Schedule;
+	HazeResponse::ParseGasSchedule(Utf8(HazeTestResponses::GasSchedule), Schedule);
+	Schedule.GasPrice = 3;
+	TestTrue(TEXT("Adopted"), Estimator->ApplySchedule(Schedule));
+	TestFalse(TEXT("Same version"), Estimator->ApplySchedule(Schedule));
+	TestFalse(TEXT("Never fetched"), Estimator->ApplySchedule(FHazeGasSchedule()));
+
+	const FHazeGasQuote Quote = Estimator->Estimate(EAssetAction::Condense, EDensityLevel::Core, { { TEXT("model"), FString::ChrN(2048, TEXT('a')) } });
+	TestTrue(TEXT("Valid"), Quote.bValid);
+	TestEqual(TEXT("Cost"), Quote.GasCost, int64(75400));
+	TestTrue(TEXT("Fee"), Quote.GasFee == FHazeAmount(226200));
+	TestEqual(TEXT("Priced with"), Quote.ScheduleVersion, Schedule.Version);
+
+	// The precomputed path agrees with the metadata one
+	const FHazeGasQuote Sized = Estimator->EstimateSized(EAssetAction::Split, EDensityLevel::Light, 7, false, 3);
+	TestEqual(TEXT("Sized"), Sized.GasCost, int64(30300));
+	return true;
+}
+
+#endif
@@ -0,0 +1,141 @@
+// Copyright HAZE Blockchain. Node choice for reads and submissions across several nodes.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeNodeRouter.h"
+
+namespace
+{
+	FBlockchainInfo Finalized(int64 Height)
+	{
+		FBlockchainInfo Info;
+		Info.CurrentHeight = Height + 1;
+		Info.LastFinalizedHeight = Height;
+		return Info;
+	}
+
+	/** Three probed nodes: 40ms, 10ms and 25ms, all caught up at height 100 */
+	void ThreeNodes(FHazeNodeRouter& Router)
+	{
+		Router.SetNodes({ TEXT("http://a:8080/"), TEXT("http://b:8081"), TEXT("http://c:8082") });
+		const double Latencies[] = { 40.0, 10.0, 25.0 };
+		for (int32 i = 0; i < 3; i++)
+		{
+			Router.RecordProbe(i, true, Latencies[i]);
+			Router.RecordInfo(i, Finalized(100));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeNodeRouterReadTest, "HAZE.Nodes.Reads", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeNodeRouterReadTest::RunTest(const FString& Parameters)
+{
+	FHazeNodeRouter Router;
+	ThreeNodes(Router);
+	TestEqual(TEXT("Trailing slash dropped"), Router.GetUrl(0), TEXT("http://a:8080"));
+	TestEqual(TEXT("Fastest"), Router.PickRead(), 1);
+	TestEqual(TEXT("Fastest not yet tried"), Router.PickRead(1ull << 1), 2);
+	TestEqual(TEXT("All tried"), Router.PickRead(0b111), INDEX_NONE);
+
+	// A node that has not caught up only serves reads when nothing else is left
+	Router.RecordInfo(1, Finalized(97));
+	TestFalse(TEXT("Behind"), Router.IsCaughtUp(1));
+	TestEqual(TEXT("Skips the node behind"), Router.PickRead(), 2);
+	TestEqual(TEXT("Behind beats nothing"), Router.PickRead(0b101), 1);
+	Router.RecordInfo(1, Finalized(98));
+	TestTrue(TEXT("Within MaxFinalizedLag"), Router.IsCaughtUp(1));
+
+	// Down after FailuresBeforeDown failures, back on the next good probe
+	Router.MarkStarted(1);
+	Router.MarkFinished(1, false);
+	TestEqual(TEXT("One failure is not down"), Router.PickRead(), 1);
+	Router.MarkStarted(1);
+	Router.MarkFinished(1, false);
+	TestFalse(TEXT("Down"), Router.GetStatus()[1].bHealthy);
+	TestEqual(TEXT("Fails over"), Router.PickRead(), 2);
+	Router.RecordProbe(1, true, 10.0);
+	TestEqual(TEXT("Recovered"), Router.PickRead(), 1);
+
+	// A down node does not hold back the caught-up height of the others
+	Router.RecordInfo(0, Finalized(500));
+	Router.RecordProbe(0, false, 0.0);
+	Router.RecordProbe(0, false, 0.0);
+	TestTrue(TEXT("Height of a down node ignored"), Router.IsCaughtUp(1));
+
+	TestEqual(TEXT("Longest prefix"), Router.FindNode(TEXT("http://c:8082/api/v1/blockchain/info")), 2);
+	TestEqual(TEXT("Unknown node"), Router.FindNode(TEXT("http://d:8083/health")), INDEX_NONE);
+
+	// State follows the URL across a new node list
+	Router.SetNodes({ TEXT("http://c:8082"), TEXT("http://b:8081") });
+	TestEqual(TEXT("Kept latency"), Router.GetStatus()[0].LatencyMs, 25.f);
+	TestEqual(TEXT("Fastest after reorder"), Router.PickRead(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeNodeRouterSubmitTest, "HAZE.Nodes.Submissions", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeNodeRouterSubmitTest::RunTest(const FString& Parameters)
+{
+	FHazeNodeRouter Router;
+	ThreeNodes(Router);
+
+	// Round robin while nothing is in flight, whatever the latency
+	TestEqual(TEXT("First"), Router.PickSubmit(), 0);
+	TestEqual(TEXT("Second"), Router.PickSubmit(), 1);
+	TestEqual(TEXT("Third"), Router.PickSubmit(), 2);
+	TestEqual(TEXT("Wraps"), Router.PickSubmit(), 0);
+
+	// Fewest in flight wins
+	Router.MarkStarted(1);
+	Router.MarkStarted(2);
+	TestEqual(TEXT("Least loaded"), Router.PickSubmit(), 0);
+	Router.MarkStarted(0);
+	Router.MarkStarted(0);
+	TestEqual(TEXT("Least loaded after rotation"), Router.PickSubmit(), 1);
+
+	// Down nodes and tried nodes are skipped
+	Router.RecordProbe(1, false, 0.0);
+	Router.RecordProbe(1, false, 0.0);
+	TestEqual(TEXT("Skips down"), Router.PickSubmit(), 2);
+	TestEqual(TEXT("Excluded"), Router.PickSubmit(1ull << 2), 0);
+	TestEqual(TEXT("Down beats nothing"), Router.PickSubmit(0b101), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeNodeRouterSenderTest, "HAZE.Nodes.SubmissionSender", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeNodeRouterSenderTest::RunTest(const FString& Parameters)
+{
+	FHazeNodeRouter Router;
+	ThreeNodes(Router);
+	const FString Alice = TEXT("aa00");
+
+	// Back-to-back submissions from one sender: the first is still in flight, yet the second follows it
+	const int32 First = Router.PickSubmitFor(Alice);
+	Router.MarkStarted(First);
+	TestEqual(TEXT("Same node while the first is in flight"), Router.PickSubmitFor(TEXT(" AA00 ")), First);
+	TestNotEqual(TEXT("Another sender is balanced away"), Router.PickSubmitFor(TEXT("bb11")), First);
+	TestEqual(TEXT("Empty sender round robins"), Router.PickSubmitFor(FString()), (First + 2) % 3);
+
+	// Lagging is not enough to move; only a node that is down or excluded gives the sender up
+	Router.RecordInfo(First, Finalized(90));
+	TestEqual(TEXT("Kept while behind"), Router.PickSubmitFor(Alice), First);
+	TestNotEqual(TEXT("Moved off an excluded node"), Router.PickSubmitFor(Alice, 1ull << First), First);
+	const int32 Moved = Router.PickSubmitFor(Alice);
+	TestNotEqual(TEXT("Stays on the node it moved to"), Moved, First);
+	Router.RecordProbe(Moved, false, 0.0);
+	Router.RecordProbe(Moved, false, 0.0);
+	const int32 AfterDown = Router.PickSubmitFor(Alice);
+	TestTrue(TEXT("Moved off a down node"), AfterDown != Moved && AfterDown != INDEX_NONE);
+
+	// A node dropped from the list releases its senders
+	Router.SetNodes({ Router.GetUrl((AfterDown + 1) % 3) });
+	TestEqual(TEXT("Re-picked after the node list changed"), Router.PickSubmitFor(Alice), 0);
+	return true;
+}
+
+#endif
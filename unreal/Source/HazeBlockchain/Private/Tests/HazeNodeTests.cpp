@@ -0,0 +1,215 @@
+// Copyright HAZE Blockchain. End-to-end submit throughput against a running node.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Tests/AutomationCommon.h"
+#include "HazeClient.h"
+#include "KeyPair.h"
+#include "HazeHex.h"
+#include "TransactionBuilder.h"
+
+namespace
+{
+	/** Submissions per mode; one batch request carries all of them */
+	constexpr int32 NodeSubmitCount = 200;
+
+	enum class ENodePhase : uint8
+	{
+		Health,
+		Account,
+		Single,
+		Batch,
+		BatchBinary,
+		Done
+	};
+
+	struct FNodeThroughputRun
+	{
+		UHazeClient* Client = nullptr;
+		UHazeKeyPair* Key = nullptr;
+		FString ToHex;
+		ENodePhase Phase = ENodePhase::Health;
+		bool bWaiting = false;
+		bool bReachable = false;
+		uint64 Nonce = 0;
+		int32 Responses = 0;
+		int32 Accepted = 0;
+		double Start = 0.0;
+
+		~FNodeThroughputRun()
+		{
+			if (Client) Client->RemoveFromRoot();
+			if (Key) Key->RemoveFromRoot();
+		}
+	};
+
+	TArray<FHazeTransferIntent> MakeIntents(const FNodeThroughputRun& Run)
+	{
+		TArray<FHazeTransferIntent> Intents;
+		Intents.SetNum(NodeSubmitCount);
+		for (int32 i = 0; i < Intents.Num(); i++)
+		{
+			Intents[i].ToAddressHex = Run.ToHex;
+			Intents[i].Amount = 1;
+			Intents[i].Fee = 1;
+			Intents[i].Nonce = Run.Nonce + i;
+		}
+		return Intents;
+	}
+
+	void Report(FAutomationTestBase& Test, FNodeThroughputRun& Run, const TCHAR* Mode)
+	{
+		const double Seconds = FPlatformTime::Seconds() - Run.Start;
+		Test.AddInfo(FString::Printf(TEXT("%-24s %8.0f submits/s (%d accepted of %d, %.1f ms total)"),
+			Mode, NodeSubmitCount / Seconds, Run.Accepted, NodeSubmitCount, Seconds * 1000.0));
+		Run.Nonce += NodeSubmitCount;
+		Run.Accepted = 0;
+		Run.Responses = 0;
+	}
+}
+
+/**
+ * Needs a node: -HazeNode=<url> (default http://127.0.0.1:8080). Without -HazeNodeKey=<private key hex> of a
+ * funded account the transfers are signed by a fresh key and rejected, which still measures the round trip.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeNodeThroughputTest, "HAZE.Node.SubmitThroughput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FHazeNodeThroughputTest::RunTest(const FString& Parameters)
+{
+	if (!UHazeKeyPair::IsSigningAvailable())
+	{
+		AddInfo(TEXT("Ed25519 is not linked (HAZE_HAS_ED25519); node throughput skipped"));
+		return true;
+	}
+
+	FString NodeUrl = TEXT("http://127.0.0.1:8080");
+	FParse::Value(FCommandLine::Get(), TEXT("HazeNode="), NodeUrl);
+	FString KeyHex;
+	FParse::Value(FCommandLine::Get(), TEXT("HazeNodeKey="), KeyHex);
+
+	TSharedRef<FNodeThroughputRun> Run = MakeShared<FNodeThroughputRun>();
+	Run->Client = UHazeClient::CreateClient(NodeUrl);
+	Run->Client->AddToRoot();
+	Run->Key = KeyHex.IsEmpty() ? UHazeKeyPair::Generate() : UHazeKeyPair::FromPrivateKeyHex(KeyHex);
+	if (!Run->Key)
+	{
+		AddError(TEXT("-HazeNodeKey is not a 32-byte private key in hex"));
+		return false;
+	}
+	Run->Key->AddToRoot();
+	Run->ToHex = FHazeHex::ToHex(UHazeKeyPair::Generate()->PublicKey);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run, NodeUrl, bFunded = !KeyHex.IsEmpty()]() -> bool
+	{
+		if (Run->bWaiting) return false;
+
+		switch (Run->Phase)
+		{
+		case ENodePhase::Health:
+			if (Run->Start == 0.0)
+			{
+				Run->bWaiting = true;
+				Run->Start = FPlatformTime::Seconds();
+				Run->Client->FetchHealth([Run](bool bOk, const FString&)
+				{
+					Run->bReachable = bOk;
+					Run->bWaiting = false;
+				});
+				return false;
+			}
+			if (!Run->bReachable)
+			{
+				AddInfo(FString::Printf(TEXT("No node at %s; pass -HazeNode=<url> to measure submit throughput"), *NodeUrl));
+				return true;
+			}
+			Run->Phase = bFunded ? ENodePhase::Account : ENodePhase::Single;
+			return false;
+
+		case ENodePhase::Account:
+			Run->bWaiting = true;
+			Run->Client->FetchAccount(Run->Key->GetAddressHex(), [Run](bool bOk, const FAccountInfo& Info)
+			{
+				if (bOk) Run->Nonce = static_cast<uint64>(Info.Nonce);
+				Run->Phase = ENodePhase::Single;
+				Run->bWaiting = false;
+			});
+			return false;
+
+		case ENodePhase::Single:
+		{
+			// Build every body first so the measurement is the client and node, not signing
+			TArray<TArray<uint8>> Bodies;
+			Bodies.SetNum(NodeSubmitCount);
+			for (int32 i = 0; i < NodeSubmitCount; i++)
+			{
+				FTransactionBuilder::WriteSignedTransferRequest(Bodies[i], Run->Key, Run->ToHex, 1, 1, Run->Nonce + i);
+			}
+			Run->bWaiting = true;
+			Run->Start = FPlatformTime::Seconds();
+			for (TArray<uint8>& Body : Bodies)
+			{
+				Run->Client->SubmitTransactionBody(MoveTemp(Body), [this, Run](bool bAccepted, const FTransactionResponse&, int32)
+				{
+					Run->Accepted += bAccepted ? 1 : 0;
+					if (++Run->Responses == NodeSubmitCount)
+					{
+						Report(*this, *Run, TEXT("SubmitTransactionBody"));
+						Run->Phase = ENodePhase::Batch;
+						Run->bWaiting = false;
+					}
+				});
+			}
+			return false;
+		}
+
+		case ENodePhase::Batch:
+		{
+			const TArray<FString> Jsons = FTransactionBuilder::BuildSignedTransferBatch(Run->Key, MakeIntents(*Run));
+			Run->bWaiting = true;
+			Run->Start = FPlatformTime::Seconds();
+			Run->Client->SubmitTransactionBatch(Jsons, [this, Run](bool bOk, const TArray<FBatchTransactionResult>& Results, int32)
+			{
+				for (const FBatchTransactionResult& Result : Results) Run->Accepted += Result.IsAccepted() ? 1 : 0;
+				Report(*this, *Run, TEXT("SubmitTransactionBatch"));
+				Run->Phase = ENodePhase::BatchBinary;
+				Run->bWaiting = false;
+			});
+			return false;
+		}
+
+		case ENodePhase::BatchBinary:
+		{
+			const TArray<TArray<uint8>> Transactions = FTransactionBuilder::BuildSignedTransferBatchBinary(Run->Key, MakeIntents(*Run));
+			Run->bWaiting = true;
+			Run->Start = FPlatformTime::Seconds();
+			Run->Client->SubmitTransactionBatchBinary(Transactions, [this, Run](bool bOk, const TArray<FBatchTransactionResult>& Results, int32)
+			{
+				for (const FBatchTransactionResult& Result : Results) Run->Accepted += Result.IsAccepted() ? 1 : 0;
+				Report(*this, *Run, TEXT("SubmitTransactionBatchBinary"));
+				Run->Phase = ENodePhase::Done;
+				Run->bWaiting = false;
+			});
+			return false;
+		}
+
+		case ENodePhase::Done:
+		default:
+			for (EHazeEndpoint Endpoint : { EHazeEndpoint::SubmitTransaction, EHazeEndpoint::SubmitTransactionBatch })
+			{
+				const FHazeEndpointStats Stats = Run->Client->GetEndpointStats(Endpoint);
+				AddInfo(FString::Printf(TEXT("%-24s p50 %.1f ms  p99 %.1f ms  first byte %.1f ms  parse %.2f ms  (%lld requests, %lld failed)"),
+					Endpoint == EHazeEndpoint::SubmitTransaction ? TEXT("submit") : TEXT("submit batch"),
+					Stats.P50Ms, Stats.P99Ms, Stats.FirstByteMs, Stats.ParseMs, Stats.Completed, Stats.Failed));
+			}
+			return true;
+		}
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright HAZE Blockchain. Nonce reservation and the Resync walk over gaps, orphans and confirmations.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeNonceManager.h"
+
+namespace
+{
+	const TCHAR* const Alice = TEXT("aa00");
+
+	/** Reserve Count nonces, marking each one accepted */
+	void ReserveAccepted(FHazeNonceManager& Nonces, const FString& Address, int32 Count)
+	{
+		for (int32 i = 0; i < Count; i++)
+		{
+			uint64 Nonce = 0;
+			if (Nonces.Reserve(Address, Nonce))
+			{
+				Nonces.MarkAccepted(Address, Nonce);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeNonceManagerReserveTest, "HAZE.Nonces.Reserve", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeNonceManagerReserveTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FHazeNonceManager, ESPMode::ThreadSafe> Nonces = MakeShared<FHazeNonceManager, ESPMode::ThreadSafe>();
+	uint64 Nonce = 0;
+	TestFalse(TEXT("Unseeded"), Nonces->Reserve(Alice, Nonce));
+
+	Nonces->Seed(TEXT(" AA00 "), 7);
+	Nonces->Seed(Alice, 100);
+	TestTrue(TEXT("Seeded, case-insensitive"), Nonces->IsSeeded(Alice));
+	TestTrue(TEXT("First"), Nonces->Reserve(Alice, Nonce) && Nonce == 7);
+	TestTrue(TEXT("Second seed ignored"), Nonces->Reserve(Alice, Nonce) && Nonce == 8);
+	TestEqual(TEXT("Pending"), Nonces->GetPendingCount(Alice), 2);
+
+	Nonces->MarkConfirmed(Alice, 7);
+	TestEqual(TEXT("Confirmed drops out"), Nonces->GetPendingCount(Alice), 1);
+	Nonces->MarkRejected(Alice, 99);
+	TestFalse(TEXT("Unknown nonce ignored"), Nonces->NeedsResync(Alice));
+	Nonces->MarkRejected(Alice, 8);
+	TestTrue(TEXT("Rejection flags the address"), Nonces->NeedsResync(Alice));
+	TestFalse(TEXT("No nonces until resync"), Nonces->Reserve(Alice, Nonce));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeNonceManagerResyncTest, "HAZE.Nonces.Resync", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeNonceManagerResyncTest::RunTest(const FString& Parameters)
+{
+	// Rejection in the middle of a run: 10 and 11 in the pool, 12 rejected, 13 accepted behind it
+	{
+		const TSharedRef<FHazeNonceManager, ESPMode::ThreadSafe> Nonces = MakeShared<FHazeNonceManager, ESPMode::ThreadSafe>();
+		Nonces->Seed(Alice, 10);
+		ReserveAccepted(*Nonces, Alice, 4);
+		Nonces->MarkRejected(Alice, 12);
+
+		const FHazeNonceResync Result = Nonces->Resync(Alice, 10);
+		TestEqual(TEXT("Mid-run: nothing executed"), Result.Confirmed.Num(), 0);
+		TestTrue(TEXT("Mid-run: gap at the rejection"), Result.Gap.IsSet() && Result.Gap.GetValue() == 12);
+		TestTrue(TEXT("Mid-run: rejected and later nonces orphaned"), Result.Orphaned == TArray<uint64>({ 12, 13 }));
+		TestEqual(TEXT("Mid-run: restart at the gap"), Result.NextNonce, uint64(12));
+		TestEqual(TEXT("Mid-run: the run before the gap stays pending"), Nonces->GetPendingCount(Alice), 2);
+		TestFalse(TEXT("Mid-run: cleared"), Nonces->NeedsResync(Alice));
+
+		// Reserving after the resync continues at the gap, behind the surviving run
+		uint64 Nonce = 0;
+		TestTrue(TEXT("Reserve after resync"), Nonces->Reserve(Alice, Nonce) && Nonce == 12);
+		TestTrue(TEXT("Then in sequence"), Nonces->Reserve(Alice, Nonce) && Nonce == 13);
+		TestEqual(TEXT("Pending after reserving"), Nonces->GetPendingCount(Alice), 4);
+
+		// The surviving run executes; the new reservations continue from it
+		const FHazeNonceResync Later = Nonces->Resync(Alice, 12);
+		TestTrue(TEXT("Survivors confirmed"), Later.Confirmed == TArray<uint64>({ 10, 11 }));
+		TestFalse(TEXT("Reserved nonces are no gap"), Later.Gap.IsSet());
+		TestEqual(TEXT("Next after the reservations"), Later.NextNonce, uint64(14));
+	}
+
+	// Missing nonce: 1 dropped locally, so 2 can never be accepted
+	{
+		const TSharedRef<FHazeNonceManager, ESPMode::ThreadSafe> Nonces = MakeShared<FHazeNonceManager, ESPMode::ThreadSafe>();
+		Nonces->Seed(Alice, 0);
+		ReserveAccepted(*Nonces, Alice, 3);
+		Nonces->MarkConfirmed(Alice, 1);
+
+		const FHazeNonceResync Result = Nonces->Resync(Alice, 0);
+		TestTrue(TEXT("Missing: gap at the missing nonce"), Result.Gap.IsSet() && Result.Gap.GetValue() == 1);
+		TestTrue(TEXT("Missing: nonces after it orphaned"), Result.Orphaned == TArray<uint64>({ 2 }));
+		TestEqual(TEXT("Missing: restart at the gap"), Result.NextNonce, uint64(1));
+		TestEqual(TEXT("Missing: nonce before it stays pending"), Nonces->GetPendingCount(Alice), 1);
+	}
+
+	// Account nonce ahead of every pending nonce: all executed, including ones sent elsewhere
+	{
+		const TSharedRef<FHazeNonceManager, ESPMode::ThreadSafe> Nonces = MakeShared<FHazeNonceManager, ESPMode::ThreadSafe>();
+		Nonces->Seed(Alice, 5);
+		ReserveAccepted(*Nonces, Alice, 3);
+
+		const FHazeNonceResync Result = Nonces->Resync(Alice, 9);
+		TestTrue(TEXT("Ahead: all confirmed"), Result.Confirmed == TArray<uint64>({ 5, 6, 7 }));
+		TestEqual(TEXT("Ahead: nothing orphaned"), Result.Orphaned.Num(), 0);
+		TestFalse(TEXT("Ahead: no gap"), Result.Gap.IsSet());
+		TestEqual(TEXT("Ahead: next is the account nonce"), Result.NextNonce, uint64(9));
+		TestEqual(TEXT("Ahead: nothing pending"), Nonces->GetPendingCount(Alice), 0);
+
+		uint64 Nonce = 0;
+		TestTrue(TEXT("Ahead: reserve from the account nonce"), Nonces->Reserve(Alice, Nonce) && Nonce == 9);
+	}
+
+	// Resync seeds an address it has never seen
+	{
+		const TSharedRef<FHazeNonceManager, ESPMode::ThreadSafe> Nonces = MakeShared<FHazeNonceManager, ESPMode::ThreadSafe>();
+		TestEqual(TEXT("Unseeded: next is the account nonce"), Nonces->Resync(Alice, 3).NextNonce, uint64(3));
+		uint64 Nonce = 0;
+		TestTrue(TEXT("Unseeded: seeded by resync"), Nonces->Reserve(Alice, Nonce) && Nonce == 3);
+	}
+	return true;
+}
+
+#endif
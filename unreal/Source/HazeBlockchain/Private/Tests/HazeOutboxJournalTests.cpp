@@ -0,0 +1,129 @@
+// Copyright HAZE Blockchain. Outbox journal recovery, acknowledgement and torn-write handling.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "HazeOutboxJournal.h"
+
+namespace
+{
+	const TCHAR* const TestJournal = TEXT("AutomationOutboxTest");
+
+	/** Journals Open could not read and moved aside */
+	TArray<FString> FindUnread()
+	{
+		TArray<FString> Names;
+		IFileManager::Get().FindFiles(Names, *(FHazeOutboxJournal::GetJournalPath(TestJournal) + TEXT(".*.unread")), true, false);
+		for (FString& Name : Names)
+		{
+			Name = FPaths::Combine(FHazeOutboxJournal::GetJournalDirectory(), Name);
+		}
+		return Names;
+	}
+
+	void DeleteTestJournal()
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const FString Path = FHazeOutboxJournal::GetJournalPath(TestJournal);
+		PlatformFile.DeleteFile(*Path);
+		PlatformFile.DeleteFile(*(Path + TEXT(".tmp")));
+		for (const FString& Unread : FindUnread())
+		{
+			PlatformFile.DeleteFile(*Unread);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeOutboxJournalTest, "HAZE.Outbox.Journal", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeOutboxJournalTest::RunTest(const FString& Parameters)
+{
+	DeleteTestJournal();
+	const FString Path = FHazeOutboxJournal::GetJournalPath(TestJournal);
+
+	uint64 Second = 0;
+	{
+		TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Journal = FHazeOutboxJournal::Open(TestJournal);
+		if (!TestTrue(TEXT("Open"), Journal.IsValid())) return false;
+		TestEqual(TEXT("Nothing recovered from a new journal"), Journal->TakeRecovered().Num(), 0);
+		const uint64 First = Journal->Append(TEXT("alice"), 7ull, 2, TEXT("{\"Transfer\":{\"nonce\":7}}"));
+		Second = Journal->Append(TEXT("alice"), 8ull, 2, TEXT("{\"Transfer\":{\"nonce\":8}}"));
+		Journal->Append(TEXT("bob"), TOptional<uint64>(), 1, TEXT("{\"Transfer\":{\"nonce\":0}}"));
+		TestTrue(TEXT("Ids"), First > 0 && Second > First);
+		Journal->Acknowledge(First);
+		Journal->Acknowledge(First);
+		TestEqual(TEXT("Pending"), Journal->GetPendingCount(), 2);
+		// Closed without acknowledging the rest, as a crash would leave it
+	}
+
+	// A record torn by a crash mid-write is ignored, and so is anything after it
+	TArray<uint8> Bytes;
+	FFileHelper::LoadFileToArray(Bytes, *Path);
+	const int32 CleanSize = Bytes.Num();
+	Bytes.Append({ 0x48, 0x5A, 0x4F, 0x4A, 0x01, 0xFF, 0x00 });
+	FFileHelper::SaveArrayToFile(Bytes, *Path);
+
+	{
+		TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Journal = FHazeOutboxJournal::Open(TestJournal);
+		if (!TestTrue(TEXT("Reopen"), Journal.IsValid())) return false;
+		TestTrue(TEXT("Compacted"), Journal->GetFileSize() < CleanSize);
+		TArray<FHazeOutboxEntry> Recovered = Journal->TakeRecovered();
+		if (TestEqual(TEXT("Recovered"), Recovered.Num(), 2))
+		{
+			TestEqual(TEXT("Append order"), Recovered[0].Id, Second);
+			TestEqual(TEXT("Ordering key"), Recovered[0].OrderingKey, TEXT("alice"));
+			TestTrue(TEXT("Nonce"), Recovered[0].Nonce == TOptional<uint64>(8ull));
+			TestEqual(TEXT("Priority"), static_cast<int32>(Recovered[0].Priority), 2);
+			TestEqual(TEXT("Body"), Recovered[0].TransactionJson, TEXT("{\"Transfer\":{\"nonce\":8}}"));
+			TestFalse(TEXT("No nonce"), Recovered[1].Nonce.IsSet());
+		}
+		TestEqual(TEXT("Handed out once"), Journal->TakeRecovered().Num(), 0);
+		TestEqual(TEXT("Still pending until acknowledged"), Journal->GetPendingCount(), 2);
+		const uint64 Third = Journal->Append(TEXT("alice"), 9ull, 2, TEXT("{}"));
+		TestTrue(TEXT("Ids keep growing across sessions"), Third > Second);
+		for (const FHazeOutboxEntry& Entry : Recovered)
+		{
+			Journal->Acknowledge(Entry.Id);
+		}
+		Journal->Acknowledge(Third);
+		Journal->Sync();
+	}
+
+	{
+		TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Journal = FHazeOutboxJournal::Open(TestJournal);
+		TestEqual(TEXT("Everything acknowledged"), Journal.IsValid() ? Journal->TakeRecovered().Num() : -1, 0);
+	}
+
+	// Garbage in place of a journal recovers nothing
+	uint64 MaxId = 0;
+	const uint8 Garbage[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+	int32 ReadBytes = -1;
+	TestEqual(TEXT("Garbage"), FHazeOutboxJournal::ReadPending(Garbage, MaxId, &ReadBytes).Num(), 0);
+	TestEqual(TEXT("No whole record"), ReadBytes, 0);
+
+	// ...and Open keeps it aside instead of truncating it
+	FFileHelper::SaveArrayToFile(Garbage, *Path);
+	{
+		TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Journal = FHazeOutboxJournal::Open(TestJournal);
+		if (!TestTrue(TEXT("Open over an unreadable journal"), Journal.IsValid())) return false;
+		TestEqual(TEXT("Nothing recovered"), Journal->TakeRecovered().Num(), 0);
+		TestEqual(TEXT("Fresh journal"), Journal->GetFileSize(), 0ll);
+	}
+	const TArray<FString> Unread = FindUnread();
+	TArray<uint8> Kept;
+	if (TestEqual(TEXT("Moved aside"), Unread.Num(), 1) && TestTrue(TEXT("Readable"), FFileHelper::LoadFileToArray(Kept, *Unread[0])))
+	{
+		TestEqual(TEXT("Kept intact"), Kept.Num(), static_cast<int32>(UE_ARRAY_COUNT(Garbage)));
+	}
+
+	DeleteTestJournal();
+	return true;
+}
+
+#endif
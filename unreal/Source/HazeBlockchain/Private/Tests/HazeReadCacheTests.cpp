@@ -0,0 +1,125 @@
+// Copyright HAZE Blockchain. Read cache lifetimes, coalescing of reads in flight and invalidation.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeReadCache.h"
+
+namespace
+{
+	/** Callback recording what it was completed with into Results */
+	THazeReadCache<int32>::FCallback Record(TArray<int32>& Results)
+	{
+		return [&Results](bool bOk, const int32& Value) { Results.Add(bOk ? Value : -1); };
+	}
+
+	void Run(const TArray<THazeReadCache<int32>::FCallback>& Waiters, bool bOk, int32 Value)
+	{
+		for (const THazeReadCache<int32>::FCallback& Waiter : Waiters)
+		{
+			Waiter(bOk, Value);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeReadCacheLifetimeTest, "HAZE.ReadCache.Lifetime", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeReadCacheLifetimeTest::RunTest(const FString& Parameters)
+{
+	THazeReadCache<int32> Cache;
+	TArray<int32> Results;
+	TestNull(TEXT("Empty"), Cache.FindFresh(TEXT("a"), 0.0));
+
+	TestFalse(TEXT("First caller sends"), Cache.JoinOrStart(TEXT("a"), Record(Results), 10.0));
+	TestNull(TEXT("Nothing cached while in flight"), Cache.FindFresh(TEXT("a"), 10.0));
+	Run(Cache.Complete(TEXT("a"), true, 7, 10.5, 2.0), true, 7);
+	TestTrue(TEXT("Caller answered"), Results == TArray<int32>({ 7 }));
+
+	// Fresh until the TTL runs out, counted from the response
+	const int32* Hit = Cache.FindFresh(TEXT("a"), 12.4);
+	TestTrue(TEXT("Fresh"), Hit && *Hit == 7);
+	TestNull(TEXT("Expired"), Cache.FindFresh(TEXT("a"), 12.5));
+
+	// An expired entry is refetched; the new value replaces it
+	TestFalse(TEXT("Expired entry refetched"), Cache.JoinOrStart(TEXT("a"), Record(Results), 13.0));
+	Run(Cache.Complete(TEXT("a"), true, 8, 13.0, 2.0), true, 8);
+	Hit = Cache.FindFresh(TEXT("a"), 14.0);
+	TestTrue(TEXT("Refreshed"), Hit && *Hit == 8);
+
+	// A failure keeps nothing; a TTL of 0 coalesces but never caches
+	TestFalse(TEXT("Other key"), Cache.JoinOrStart(TEXT("b"), Record(Results), 20.0));
+	Run(Cache.Complete(TEXT("b"), false, 0, 20.0, 2.0), false, 0);
+	TestNull(TEXT("Failure not cached"), Cache.FindFresh(TEXT("b"), 20.0));
+	TestFalse(TEXT("Uncached"), Cache.JoinOrStart(TEXT("c"), Record(Results), 30.0));
+	Run(Cache.Complete(TEXT("c"), true, 9, 30.0, 0.0), true, 9);
+	TestNull(TEXT("TTL 0"), Cache.FindFresh(TEXT("c"), 30.0));
+	TestTrue(TEXT("Every caller answered"), Results == TArray<int32>({ 7, 8, -1, 9 }));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeReadCacheCoalesceTest, "HAZE.ReadCache.Coalesce", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeReadCacheCoalesceTest::RunTest(const FString& Parameters)
+{
+	THazeReadCache<int32> Cache;
+	TArray<int32> Results;
+
+	// Callers arriving while the read is in flight join it instead of sending their own
+	TestFalse(TEXT("First sends"), Cache.JoinOrStart(TEXT("a"), Record(Results), 0.0));
+	TestTrue(TEXT("Second joins"), Cache.JoinOrStart(TEXT("a"), Record(Results), 0.1));
+	TestTrue(TEXT("Third joins"), Cache.JoinOrStart(TEXT("a"), Record(Results), 0.2));
+	TestFalse(TEXT("Other keys are separate"), Cache.JoinOrStart(TEXT("b"), Record(Results), 0.2));
+
+	Cache.SetFlightTag(TEXT("a"), 42);
+	TestEqual(TEXT("Flight tagged"), Cache.GetFlightTag(TEXT("a")), uint64(42));
+
+	TArray<THazeReadCache<int32>::FCallback> Waiters = Cache.Complete(TEXT("a"), true, 5, 0.5, 10.0);
+	TestEqual(TEXT("One result for every caller"), Waiters.Num(), 3);
+	Run(Waiters, true, 5);
+	TestTrue(TEXT("Fanned out"), Results == TArray<int32>({ 5, 5, 5 }));
+	TestEqual(TEXT("Tag ends with the flight"), Cache.GetFlightTag(TEXT("a")), uint64(0));
+
+	// The next caller after the flight reads the cache; completing twice delivers nothing more
+	TestTrue(TEXT("Cached"), Cache.FindFresh(TEXT("a"), 1.0) != nullptr);
+	TestEqual(TEXT("Completed once"), Cache.Complete(TEXT("a"), true, 6, 1.0, 10.0).Num(), 0);
+	Run(Cache.Complete(TEXT("b"), true, 1, 1.0, 10.0), true, 1);
+	TestTrue(TEXT("Other key answered alone"), Results == TArray<int32>({ 5, 5, 5, 1 }));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeReadCacheInvalidateTest, "HAZE.ReadCache.Invalidate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeReadCacheInvalidateTest::RunTest(const FString& Parameters)
+{
+	THazeReadCache<int32> Cache;
+	TArray<int32> Results;
+	Cache.JoinOrStart(TEXT("a"), Record(Results), 0.0);
+	Run(Cache.Complete(TEXT("a"), true, 1, 0.0, 60.0), true, 1);
+	Cache.JoinOrStart(TEXT("b"), Record(Results), 0.0);
+	Run(Cache.Complete(TEXT("b"), true, 2, 0.0, 60.0), true, 2);
+
+	Cache.Invalidate(TEXT("a"));
+	TestNull(TEXT("Invalidated"), Cache.FindFresh(TEXT("a"), 1.0));
+	TestTrue(TEXT("Others kept"), Cache.FindFresh(TEXT("b"), 1.0) != nullptr);
+
+	// Invalidated mid-flight: the answer still reaches the waiters but may predate the change, so it is not kept
+	TestFalse(TEXT("Refetch"), Cache.JoinOrStart(TEXT("a"), Record(Results), 2.0));
+	Cache.Invalidate(TEXT("a"));
+	TestTrue(TEXT("A caller after the change joins"), Cache.JoinOrStart(TEXT("a"), Record(Results), 2.1));
+	Run(Cache.Complete(TEXT("a"), true, 3, 2.5, 60.0), true, 3);
+	TestTrue(TEXT("Delivered"), Results == TArray<int32>({ 1, 2, 3, 3 }));
+	TestNull(TEXT("Not cached"), Cache.FindFresh(TEXT("a"), 3.0));
+
+	// InvalidateAll: cached values go, a read in flight finishes uncached
+	TestFalse(TEXT("In flight"), Cache.JoinOrStart(TEXT("c"), Record(Results), 4.0));
+	Cache.InvalidateAll();
+	TestNull(TEXT("All dropped"), Cache.FindFresh(TEXT("b"), 4.0));
+	Run(Cache.Complete(TEXT("c"), true, 4, 4.0, 60.0), true, 4);
+	TestNull(TEXT("Flight result not cached"), Cache.FindFresh(TEXT("c"), 4.0));
+	TestFalse(TEXT("Next read sends again"), Cache.JoinOrStart(TEXT("c"), Record(Results), 5.0));
+	return true;
+}
+
+#endif
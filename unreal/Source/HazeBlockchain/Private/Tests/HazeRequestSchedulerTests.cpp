@@ -0,0 +1,172 @@
+// Copyright HAZE Blockchain. Priority classes, budgets and superseding of a client's requests.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeRequestScheduler.h"
+
+namespace
+{
+	/** Requests enqueued by name; Started and Superseded record the order things happened in */
+	struct FSchedulerLog
+	{
+		FHazeRequestScheduler Scheduler;
+		TArray<FString> Started;
+		TArray<FString> Superseded;
+		TMap<FString, uint64> Tickets;
+
+		void Enqueue(const FString& Name, EHazeRequestPriority Priority, const FString& SupersedeKey = FString())
+		{
+			Scheduler.Enqueue(Priority, SupersedeKey, [this, Name](uint64 Ticket)
+			{
+				Started.Add(Name);
+				Tickets.Add(Name, Ticket);
+			}, [this, Name]() { Superseded.Add(Name); });
+		}
+
+		void Finish(const FString& Name) { Scheduler.Finish(Tickets.FindChecked(Name)); }
+	};
+
+	/** Enqueue on Log and return the ticket (Tickets only has started requests) */
+	uint64 EnqueueTicket(FSchedulerLog& Log, const FString& Name, EHazeRequestPriority Priority, const FString& SupersedeKey = FString())
+	{
+		return Log.Scheduler.Enqueue(Priority, SupersedeKey, [&Log, Name](uint64 Ticket)
+		{
+			Log.Started.Add(Name);
+			Log.Tickets.Add(Name, Ticket);
+		}, [&Log, Name]() { Log.Superseded.Add(Name); });
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeRequestSchedulerBudgetTest, "HAZE.Scheduler.Budgets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeRequestSchedulerBudgetTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Submissions critical"), FHazeRequestScheduler::DefaultPriority(EHazeEndpoint::SubmitTransaction) == EHazeRequestPriority::Critical);
+	TestTrue(TEXT("Balance interactive"), FHazeRequestScheduler::DefaultPriority(EHazeEndpoint::Balance) == EHazeRequestPriority::Interactive);
+	TestTrue(TEXT("Versions background"), FHazeRequestScheduler::DefaultPriority(EHazeEndpoint::AssetVersions) == EHazeRequestPriority::Background);
+
+	FSchedulerLog Log;
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Critical, 1);
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Interactive, 1);
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Background, 0);
+	TestEqual(TEXT("Budget at least 1"), Log.Scheduler.GetBudget(EHazeRequestPriority::Background), 1);
+
+	// A background burst fills its own budget only
+	for (int32 i = 0; i < 4; i++)
+	{
+		Log.Enqueue(FString::Printf(TEXT("bg%d"), i), EHazeRequestPriority::Background);
+	}
+	TestEqual(TEXT("One background started"), Log.Started.Num(), 1);
+	TestEqual(TEXT("Background queued"), Log.Scheduler.GetQueued(EHazeRequestPriority::Background), 3);
+
+	Log.Enqueue(TEXT("submit"), EHazeRequestPriority::Critical);
+	Log.Enqueue(TEXT("balance"), EHazeRequestPriority::Interactive);
+	TestTrue(TEXT("Submission not behind the burst"), Log.Started == TArray<FString>({ TEXT("bg0"), TEXT("submit"), TEXT("balance") }));
+
+	// Queued in order; a free slot goes to the most urgent class waiting
+	Log.Enqueue(TEXT("submit2"), EHazeRequestPriority::Critical);
+	Log.Enqueue(TEXT("account"), EHazeRequestPriority::Interactive);
+	Log.Finish(TEXT("bg0"));
+	TestEqual(TEXT("Next background"), Log.Started.Last(), TEXT("bg1"));
+	Log.Finish(TEXT("submit"));
+	TestEqual(TEXT("Next submission"), Log.Started.Last(), TEXT("submit2"));
+	TestEqual(TEXT("In flight"), Log.Scheduler.GetInFlight(EHazeRequestPriority::Critical), 1);
+	Log.Finish(TEXT("submit"));
+	TestEqual(TEXT("Finished twice is ignored"), Log.Scheduler.GetInFlight(EHazeRequestPriority::Critical), 1);
+
+	// A raised budget starts queued requests at once
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Background, 3);
+	TestEqual(TEXT("Raised budget"), Log.Scheduler.GetQueued(EHazeRequestPriority::Background), 0);
+	TestEqual(TEXT("Background in flight"), Log.Scheduler.GetInFlight(EHazeRequestPriority::Background), 3);
+
+	// A request finishing from inside Start frees its slot for the next one
+	FHazeRequestScheduler& Scheduler = Log.Scheduler;
+	int32 Immediate = 0;
+	for (int32 i = 0; i < 3; i++)
+	{
+		Scheduler.Enqueue(EHazeRequestPriority::Critical, FString(), [&Scheduler, &Immediate](uint64 Ticket)
+		{
+			Immediate++;
+			Scheduler.Finish(Ticket);
+		}, nullptr);
+	}
+	TestEqual(TEXT("Still behind submit2"), Immediate, 0);
+	Log.Finish(TEXT("submit2"));
+	TestEqual(TEXT("Finished inside Start"), Immediate, 3);
+	TestEqual(TEXT("Critical idle"), Scheduler.GetInFlight(EHazeRequestPriority::Critical), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeRequestSchedulerSupersedeTest, "HAZE.Scheduler.Supersede", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeRequestSchedulerSupersedeTest::RunTest(const FString& Parameters)
+{
+	FSchedulerLog Log;
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Interactive, 1);
+	Log.Enqueue(TEXT("search a"), EHazeRequestPriority::Interactive, TEXT("search"));
+	Log.Enqueue(TEXT("search ab"), EHazeRequestPriority::Interactive, TEXT("search"));
+	Log.Enqueue(TEXT("balance"), EHazeRequestPriority::Interactive);
+	Log.Enqueue(TEXT("search abc"), EHazeRequestPriority::Interactive, TEXT("search"));
+
+	// The one in flight is left to finish; only the queued one is dropped
+	TestTrue(TEXT("Sent one kept"), Log.Started == TArray<FString>({ TEXT("search a") }));
+	TestTrue(TEXT("Queued one dropped"), Log.Superseded == TArray<FString>({ TEXT("search ab") }));
+	TestEqual(TEXT("Queue"), Log.Scheduler.GetQueued(EHazeRequestPriority::Interactive), 2);
+
+	Log.Finish(TEXT("search a"));
+	Log.Finish(TEXT("balance"));
+	TestTrue(TEXT("Order kept"), Log.Started == TArray<FString>({ TEXT("search a"), TEXT("balance"), TEXT("search abc") }));
+
+	// Keys supersede across classes
+	Log.Enqueue(TEXT("prefetch"), EHazeRequestPriority::Interactive, TEXT("page 2"));
+	Log.Enqueue(TEXT("page now"), EHazeRequestPriority::Critical, TEXT("page 2"));
+	TestEqual(TEXT("Across classes"), Log.Superseded.Last(), TEXT("prefetch"));
+	TestEqual(TEXT("Started at once"), Log.Started.Last(), TEXT("page now"));
+
+	Log.Enqueue(TEXT("left 1"), EHazeRequestPriority::Interactive);
+	Log.Enqueue(TEXT("left 2"), EHazeRequestPriority::Interactive);
+	Log.Scheduler.CancelQueued();
+	TestEqual(TEXT("Cancelled"), Log.Superseded.Num(), 4);
+	TestEqual(TEXT("Nothing queued"), Log.Scheduler.GetQueued(EHazeRequestPriority::Interactive), 0);
+	Log.Finish(TEXT("search abc"));
+	TestEqual(TEXT("Nothing left to start"), Log.Started.Num(), 4);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeRequestSchedulerSharedTest, "HAZE.Scheduler.Shared", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeRequestSchedulerSharedTest::RunTest(const FString& Parameters)
+{
+	FSchedulerLog Log;
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Interactive, 1);
+	Log.Scheduler.SetBudget(EHazeRequestPriority::Background, 1);
+	Log.Enqueue(TEXT("busy"), EHazeRequestPriority::Interactive);
+	Log.Enqueue(TEXT("sync"), EHazeRequestPriority::Background);
+	Log.Enqueue(TEXT("balance"), EHazeRequestPriority::Interactive);
+	const uint64 Prefetch = EnqueueTicket(Log, TEXT("prefetch"), EHazeRequestPriority::Background, TEXT("account"));
+	TestEqual(TEXT("Prefetch queued"), Log.Scheduler.GetQueued(EHazeRequestPriority::Background), 1);
+
+	// An interactive caller joins the background read: it moves to the back of the interactive queue
+	Log.Scheduler.Promote(Prefetch, EHazeRequestPriority::Interactive);
+	TestEqual(TEXT("Left background"), Log.Scheduler.GetQueued(EHazeRequestPriority::Background), 0);
+	TestEqual(TEXT("Joined interactive"), Log.Scheduler.GetQueued(EHazeRequestPriority::Interactive), 2);
+	Log.Scheduler.Promote(Prefetch, EHazeRequestPriority::Background);
+	TestEqual(TEXT("Never demoted"), Log.Scheduler.GetQueued(EHazeRequestPriority::Interactive), 2);
+
+	// Shared: a newer read with its key no longer drops it
+	Log.Scheduler.Share(Prefetch);
+	Log.Enqueue(TEXT("newer"), EHazeRequestPriority::Interactive, TEXT("account"));
+	TestEqual(TEXT("Shared read kept"), Log.Superseded.Num(), 0);
+
+	Log.Finish(TEXT("busy"));
+	Log.Finish(TEXT("balance"));
+	TestTrue(TEXT("Promoted in order"), Log.Started == TArray<FString>({ TEXT("busy"), TEXT("sync"), TEXT("balance"), TEXT("prefetch") }));
+	Log.Scheduler.Promote(Prefetch, EHazeRequestPriority::Critical);
+	TestEqual(TEXT("Started requests stay put"), Log.Scheduler.GetInFlight(EHazeRequestPriority::Interactive), 1);
+	return true;
+}
+
+#endif
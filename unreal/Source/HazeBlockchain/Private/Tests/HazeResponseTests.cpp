@@ -0,0 +1,153 @@
+// Copyright HAZE Blockchain. Decoding of each UHazeClient endpoint's response.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HazeResponseParser.h"
+#include "HazeAssetPage.h"
+#include "HazeBincode.h"
+#include "HazeTestResponses.h"
+
+using HazeTestResponses::Utf8;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeParseChainTest, "HAZE.Response.Chain", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeParseChainTest::RunTest(const FString& Parameters)
+{
+	FString Health;
+	TestTrue(TEXT("Health"), HazeResponse::ParseHealth(Utf8(HazeTestResponses::Health), Health));
+	TestEqual(TEXT("Health data"), Health, TEXT("OK"));
+
+	FBlockchainInfo Info;
+	TestTrue(TEXT("BlockchainInfo"), HazeResponse::ParseBlockchainInfo(Utf8(HazeTestResponses::BlockchainInfo), Info));
+	TestEqual(TEXT("CurrentHeight"), Info.CurrentHeight, int64(12345));
+	TestEqual(TEXT("TotalSupply keeps every digit"), Info.TotalSupply.ToString(), TEXT("18446744073709551615"));
+	TestEqual(TEXT("LastFinalizedWave"), Info.LastFinalizedWave, int64(76));
+
+	FHazeAmount Balance;
+	TestTrue(TEXT("Balance"), HazeResponse::ParseBalance(Utf8(HazeTestResponses::Balance), Balance));
+	TestTrue(TEXT("u64 balance does not round through double"), Balance == FHazeAmount(MAX_uint64));
+	TestTrue(TEXT("Balance above u64"), HazeResponse::ParseBalance(Utf8(R"({"success":true,"data":"36893488147419103232","error":null})"), Balance));
+	TestTrue(TEXT("Decimal string balance"), Balance == FHazeAmount::FromParts(2, 0));
+
+	FAccountInfo Account;
+	TestTrue(TEXT("Account"), HazeResponse::ParseAccount(Utf8(HazeTestResponses::Account), Account));
+	TestTrue(TEXT("Account balance"), Account.Balance == FHazeAmount(1000000000));
+	TestEqual(TEXT("Account nonce"), Account.Nonce, 42);
+	TestTrue(TEXT("Account staked"), Account.Staked == FHazeAmount(5000));
+
+	TestFalse(TEXT("Truncated body"), HazeResponse::ParseAccount(Utf8(R"({"success":true,"data":{"balance":)"), Account));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeParseTransactionTest, "HAZE.Response.Transactions", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeParseTransactionTest::RunTest(const FString& Parameters)
+{
+	FTransactionResponse Response;
+	TestTrue(TEXT("Accepted"), HazeResponse::ParseTransaction(Utf8(HazeTestResponses::Transaction), Response));
+	TestEqual(TEXT("Status"), Response.Status, TEXT("pending"));
+	TestEqual(TEXT("Hash"), Response.Hash.Len(), 64);
+	TestFalse(TEXT("Rejected"), HazeResponse::ParseTransaction(Utf8(HazeTestResponses::TransactionRejected), Response));
+
+	TArray<FBatchTransactionResult> Results;
+	TestTrue(TEXT("Batch"), HazeResponse::ParseTransactionBatch(Utf8(HazeTestResponses::TransactionBatch), Results));
+	if (TestEqual(TEXT("Batch entries"), Results.Num(), 3))
+	{
+		TestTrue(TEXT("First accepted"), Results[0].IsAccepted());
+		TestEqual(TEXT("Second error"), Results[1].Error, TEXT("Insufficient balance"));
+		TestTrue(TEXT("Third has no hash"), Results[2].Hash.IsEmpty());
+		TestEqual(TEXT("Third status"), Results[2].Status, TEXT("invalid"));
+	}
+
+	// ApiResponse<TransactionResponse> as bincode
+	TArray<uint8> Binary;
+	FHazeBincodeWriter W(Binary);
+	W.WriteBool(true);
+	W.WriteU8(1);
+	W.WriteString(TEXT("9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08"));
+	W.WriteString(TEXT("pending"));
+	W.WriteOptionString(FString());
+	FTransactionResponse BinaryResponse;
+	TestTrue(TEXT("Binary"), HazeResponse::ParseTransactionBinary(Binary, BinaryResponse));
+	TestEqual(TEXT("Binary status"), BinaryResponse.Status, TEXT("pending"));
+	Binary.Add(0);
+	TestFalse(TEXT("Binary trailing bytes"), HazeResponse::ParseTransactionBinary(Binary, BinaryResponse));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeParseAssetTest, "HAZE.Response.Assets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeParseAssetTest::RunTest(const FString& Parameters)
+{
+	FHazeAssetInfo Asset;
+	TestTrue(TEXT("Asset"), HazeResponse::ParseAsset(Utf8(HazeTestResponses::Asset), Asset));
+	TestTrue(TEXT("Density"), Asset.Density == EDensityLevel::Dense);
+	TestEqual(TEXT("Escaped metadata"), Asset.Metadata.FindRef(TEXT("name")), TEXT("Sword of \"Dawn\""));
+	TestEqual(TEXT("Attributes"), Asset.Attributes.Num(), 2);
+	TestEqual(TEXT("Version"), Asset.CurrentVersion, int64(3));
+	TestTrue(TEXT("Public read"), Asset.bPublicRead);
+	TestFalse(TEXT("Full view"), Asset.bIsSummary);
+
+	FString BlobHash;
+	TestTrue(TEXT("Blob ref"), HazeResponse::ParseAssetBlobRef(Utf8(HazeTestResponses::Asset), TEXT("model"), BlobHash));
+	TestEqual(TEXT("Blob hash"), BlobHash, TEXT("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+	TestFalse(TEXT("Missing blob"), HazeResponse::ParseAssetBlobRef(Utf8(HazeTestResponses::Asset), TEXT("texture"), BlobHash));
+
+	FHazeAssetVersionsPage Versions;
+	TestTrue(TEXT("Versions since"), HazeResponse::ParseAssetVersionsPage(Utf8(HazeTestResponses::AssetVersionsSince), Versions));
+	TestEqual(TEXT("Current version"), Versions.CurrentVersion, int64(3));
+	if (TestEqual(TEXT("Versions after since"), Versions.Versions.Num(), 2))
+	{
+		TestEqual(TEXT("Delta base"), Versions.Versions[0].BlobRefsBase, int64(1));
+		TestEqual(TEXT("Changed refs only"), Versions.Versions[0].Version.BlobRefs.Num(), 1);
+		TestEqual(TEXT("Removed refs"), Versions.Versions[0].RemovedBlobRefs, TArray<FString>{ TEXT("icon") });
+		TestEqual(TEXT("Version attributes"), Versions.Versions[0].Version.Attributes.Num(), 1);
+		TestTrue(TEXT("Version density"), Versions.Versions[1].Version.Density == EDensityLevel::Dense);
+	}
+
+	FHazeAssetHistoryPage History;
+	TestTrue(TEXT("History since"), HazeResponse::ParseAssetHistoryPage(Utf8(HazeTestResponses::AssetHistorySince), History));
+	TestEqual(TEXT("Next index"), History.NextIndex, int64(107));
+	if (TestEqual(TEXT("History entries"), History.Entries.Num(), 2))
+	{
+		TestEqual(TEXT("Absolute index"), History.Entries[1].Index, int64(106));
+		TestEqual(TEXT("Changes"), History.Entries[0].Changes.FindRef(TEXT("damage")), TEXT("40"));
+	}
+
+	FHazeSnapshotStalePage StalePage;
+	TestTrue(TEXT("Snapshot stale"), HazeResponse::ParseSnapshotStalePage(Utf8(HazeTestResponses::SnapshotStale), StalePage));
+	TestEqual(TEXT("Stale height"), StalePage.CurrentHeight, int64(12345));
+	if (TestEqual(TEXT("Stale entries"), StalePage.Stale.Num(), 2))
+	{
+		TestTrue(TEXT("Fingerprint above 2^63"), StalePage.Stale[0].Fingerprint == 0x8000000000000001ull && !StalePage.Stale[0].bRemoved);
+		TestTrue(TEXT("Removed"), StalePage.Stale[1].bRemoved);
+	}
+
+	TArray<FHazeAssetInfo> Summaries;
+	TestTrue(TEXT("Summaries"), HazeResponse::ParseAssetSummaries(Utf8(HazeTestResponses::AssetSummaries), Summaries));
+	if (TestEqual(TEXT("One entry per requested id"), Summaries.Num(), 2))
+	{
+		TestTrue(TEXT("Summary view"), Summaries[0].bIsSummary);
+		TestTrue(TEXT("Truncated"), Summaries[0].bMetadataTruncated);
+		TestEqual(TEXT("Attribute count"), Summaries[0].AttributeCount, 2);
+		TestTrue(TEXT("Unknown id"), Summaries[1].AssetId.IsEmpty());
+	}
+
+	const TArray<uint8> Body = HazeTestResponses::SearchPage(50);
+	FHazeAssetPage Page;
+	TestTrue(TEXT("Search page"), HazeResponse::ParseAssetSearchPage(Body, Page, TEXT("name")));
+	if (TestEqual(TEXT("Search entries"), Page.Num(), 50))
+	{
+		TestEqual(TEXT("Label"), FString(Page.GetLabel(7)), TEXT("Item 7"));
+		TestTrue(TEXT("Density"), Page.GetDensity(1) == EDensityLevel::Light);
+		TestEqual(TEXT("Interned game ids"), Page.GetStrings().Num(), 2);
+		TestEqual(TEXT("Asset id"), Page.GetAssetIdHex(0), FString::Printf(TEXT("%064x"), 1));
+		TestEqual(TEXT("Find"), Page.Find(Page.GetAssetId(49)), 49);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright HAZE Blockchain. Canned node responses shared by the parser tests and benchmarks.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Bodies as the node sends them (ApiResponse envelope, src/api.rs), one per UHazeClient endpoint */
+namespace HazeTestResponses
+{
+	inline TArrayView<const uint8> Utf8(const ANSICHAR* Body)
+	{
+		return MakeArrayView(reinterpret_cast<const uint8*>(Body), FCStringAnsi::Strlen(Body));
+	}
+
+	inline const ANSICHAR* const Health =
+		R"({"success":true,"data":"OK","error":null})";
+
+	inline const ANSICHAR* const BlockchainInfo =
+		R"({"success":true,"data":{"current_height":12345,"total_supply":"18446744073709551615","current_wave":77,)"
+		R"("state_root":"5f7a2c0e9b3d4a1f8e6c2b7d0a9f3e1c5b8d2a6f4e0c9b7d3a1f5e8c2b6d0a4f","last_finalized_height":12340,)"
+		R"("last_finalized_wave":76,"pending_transactions":3},"error":null})";
+
+	inline const ANSICHAR* const Balance =
+		R"({"success":true,"data":18446744073709551615,"error":null})";
+
+	inline const ANSICHAR* const Account =
+		R"({"success":true,"data":{"address":"d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",)"
+		R"("balance":"1000000000","nonce":42,"staked":"5000"},"error":null})";
+
+	inline const ANSICHAR* const Transaction =
+		R"({"success":true,"data":{"hash":"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08","status":"pending"},"error":null})";
+
+	inline const ANSICHAR* const TransactionRejected =
+		R"({"success":false,"data":null,"error":"Invalid nonce: expected 4, got 5"})";
+
+	inline const ANSICHAR* const TransactionBatch =
+		R"({"success":true,"data":[)"
+		R"({"hash":"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08","status":"pending","error":null},)"
+		R"({"hash":"60303ae22b998861bce3b28f33eec1be758a213c86c93c076dbe9f558c11c752","status":"rejected","error":"Insufficient balance"},)"
+		R"({"hash":null,"status":"invalid","error":"missing field `signature`"}],"error":null})";
+
+	inline const ANSICHAR* const Asset =
+		R"({"success":true,"data":{"asset_id":"2222222222222222222222222222222222222222222222222222222222222222",)"
+		R"("owner":"1111111111111111111111111111111111111111111111111111111111111111","density":"Dense",)"
+		R"("metadata":{"name":"Sword of \"Dawn\"","class":"weapon","icon":"https://cdn.example/i/1.png"},)"
+		R"("attributes":[{"name":"damage","value":"42","rarity":0.25},{"name":"element","value":"fire","rarity":null}],)"
+		R"("game_id":"haze-rpg","created_at":1700000000,"updated_at":1700000500,"current_version":3,)"
+		R"("blob_refs":{"model":"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},"public_read":true},"error":null})";
+
+	inline const ANSICHAR* const AssetVersionsSince =
+		R"({"success":true,"data":{"since":1,"current_version":3,"versions":[)"
+		R"({"version":2,"timestamp":1700000200,"density":"Light","metadata":{"name":"Sword"},"attributes":[{"name":"damage","value":"40","rarity":null}],)"
+		R"("game_id":"haze-rpg","blob_refs":{"texture":"AAAA000000000000000000000000000000000000000000000000000000000000"},"blob_refs_base":1,"removed_blob_refs":["icon"]},)"
+		R"({"version":3,"timestamp":1700000300,"density":"Dense","metadata":{"name":"Sword"},"attributes":[],)"
+		R"("game_id":"haze-rpg","blob_refs":{},"blob_refs_base":2,"removed_blob_refs":[]}]},"error":null})";
+
+	inline const ANSICHAR* const AssetHistorySince =
+		R"({"success":true,"data":{"first_index":105,"next_index":107,"entries":[)"
+		R"({"timestamp":1700000200,"action":"Update","changes":{"damage":"40"}},)"
+		R"({"timestamp":1700000300,"action":"Condense","changes":{}}]},"error":null})";
+
+	inline const ANSICHAR* const SnapshotStale =
+		R"({"success":true,"data":{"state_root":"5f7a2c0e9b3d4a1f8e6c2b7d0a9f3e1c5b8d2a6f4e0c9b7d3a1f5e8c2b6d0a4f","current_height":12345,"stale":[)"
+		R"({"asset_id":"2222222222222222222222222222222222222222222222222222222222222222","fingerprint":"8000000000000001"},)"
+		R"({"asset_id":"3333333333333333333333333333333333333333333333333333333333333333","fingerprint":null}]},"error":null})";
+
+	inline const ANSICHAR* const AssetSummaries =
+		R"({"success":true,"data":[)"
+		R"({"asset_id":"2222222222222222222222222222222222222222222222222222222222222222","owner":"1111111111111111111111111111111111111111111111111111111111111111",)"
+		R"("density":"Ethereal","metadata":{"name":"Sword"},"metadata_bytes":180,"metadata_truncated":true,"attribute_count":2,)"
+		R"("game_id":"haze-rpg","created_at":1700000000,"updated_at":1700000500},)"
+		R"(null],"error":null})";
+
+	inline const ANSICHAR* const Block =
+		R"({"success":true,"data":{"hash":"0b0b","parent_hash":"0a0a","height":42,"timestamp":1700000042,"validator":"0909",)"
+		R"("transaction_count":2,"wave_number":7,"transactions":["aa01","aa02"]},"error":null})";
+
+	inline const ANSICHAR* const LiquidityPools =
+		R"({"success":true,"data":[)"
+		R"({"pool_id":"pool:HAZE:GOLD","asset1":"HAZE","asset2":"GOLD","reserve1":1000000,"reserve2":2000000,"fee_rate":30,"total_liquidity":1414213},)"
+		R"({"pool_id":"pool:HAZE:GEM","asset1":"HAZE","asset2":"GEM","reserve1":18446744073709551615,"reserve2":7,"fee_rate":0,"total_liquidity":0}],"error":null})";
+
+	inline const ANSICHAR* const LiquidityPool =
+		R"({"success":true,"data":{"pool_id":"pool:HAZE:GOLD","asset1":"HAZE","asset2":"GOLD","reserve1":1009970,"reserve2":1980256,)"
+		R"("fee_rate":30,"total_liquidity":1414213},"error":null})";
+
+	/** Config::default() asset_gas and gas_price (src/config.rs) */
+	inline const ANSICHAR* const GasSchedule =
+		R"({"success":true,"data":{"version":4503599627370495,"gas_price":1,"create_base":10000,"create_per_kb":100,)"
+		R"("update_base":5000,"update_per_kb":50,"condense_base":15000,"condense_multiplier_ethereal":1,"condense_multiplier_light":1,)"
+		R"("condense_multiplier_dense":2,"condense_multiplier_core":5,"condense_per_kb":200,"evaporate_base":2000,"merge_base":20000,)"
+		R"("merge_per_kb":150,"split_base":15000,"split_per_component":5000,"split_per_kb":100},"error":null})";
+
+	inline const ANSICHAR* const PoolUpdatedEvent =
+		R"({"type":"pool_updated","pool_id":"pool:HAZE:GOLD","asset1":"HAZE","asset2":"GOLD","reserve1":1009970,"reserve2":1980256,)"
+		R"("fee_rate":30,"total_liquidity":1414213})";
+
+	/** Search page (summary view) of Count assets with distinct ids, two game ids and a name each */
+	inline TArray<uint8> SearchPage(int32 Count)
+	{
+		FString Json = TEXT("{\"success\":true,\"data\":[");
+		for (int32 i = 0; i < Count; i++)
+		{
+			if (i > 0) Json += TEXT(",");
+			Json += FString::Printf(
+				TEXT("{\"asset_id\":\"%064x\",\"owner\":\"%064x\",\"density\":\"%s\",\"metadata\":{\"name\":\"Item %d\",\"class\":\"weapon\"},")
+				TEXT("\"metadata_bytes\":30,\"metadata_truncated\":false,\"attribute_count\":3,\"game_id\":\"%s\",\"created_at\":%d,\"updated_at\":%d}"),
+				i + 1, i % 7, i % 2 ? TEXT("Light") : TEXT("Ethereal"), i, i % 3 ? TEXT("haze-rpg") : TEXT("haze-kart"),
+				1700000000 + i, 1700000000 + 2 * i);
+		}
+		Json += TEXT("],\"error\":null}");
+		FTCHARToUTF8 Utf8Json(*Json);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8Json.Get()), Utf8Json.Length());
+	}
+}
+
+#endif
@@ -0,0 +1,333 @@
+// Copyright HAZE Blockchain. Byte-exact signing vectors, hex and JSON writer tests.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "TransactionSigning.h"
+#include "TransactionBuilder.h"
+#include "KeyPair.h"
+#include "HazeWalletPool.h"
+#include "HazeHex.h"
+#include "HazeJsonWriter.h"
+#include "HazeSha256.h"
+
+namespace
+{
+	// Vectors pinned by test_signing_payload_vectors in src/consensus.rs (and docs/API_TRANSACTIONS.md)
+	const TCHAR* const TransferVector =
+		TEXT("5472616e736665720100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000040420f0000000000e8030000000000000500000000000000");
+	const TCHAR* const TransferChainVector =
+		TEXT("5472616e736665720100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000040420f0000000000e80300000000000005000000000000000100000000000000f401000000000000");
+	const TCHAR* const MistbornCreateVector =
+		TEXT("4d697374626f726e417373657411111111111111111111111111111111111111111111111111111111111111110022222222222222222222222222222222222222222222222222222222222222221111111111111111111111111111111111111111111111111111111111111111010a000000000000000300000000000000");
+	const TCHAR* const MistbornMergeVector =
+		TEXT("4d697374626f726e4173736574111111111111111111111111111111111111111111111111111111111111111104222222222222222222222222222222222222222222222222222222222222222211111111111111111111111111111111111111111111111111111111111111110233333333333333333333333333333333333333333333333333333333333333330a0000000000000003000000000000000700000000000000");
+	const TCHAR* const MistbornSplitVector =
+		TEXT("4d697374626f726e4173736574111111111111111111111111111111111111111111111111111111111111111105222222222222222222222222222222222222222222222222222222222222222211111111111111111111111111111111111111111111111111111111111111110361612c62620a000000000000000300000000000000");
+
+	// RFC 8032 section 7.1, test 1
+	const TCHAR* const RfcSeed = TEXT("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60");
+	const TCHAR* const RfcPublicKey = TEXT("d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a");
+	const TCHAR* const RfcEmptySignature =
+		TEXT("e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b");
+
+	/** The RFC key's signature over TransferChainVector with `from` set to its own address */
+	const TCHAR* const SignedTransferSignature =
+		TEXT("09faf1afd4ccb2740d014078cdd1aa4405e4d36742127b7428385c2210e2e5bacb74a72dc35c70018bb4b49c6dee503f579e07d54d7a1208b6c2227b2f563d01");
+	const TCHAR* const SignedTransferBincode =
+		TEXT("00000000d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a020000000000000000000000000000000000000000000000000000000000000040420f0000000000e803000000000000050000000000000001010000000000000001f401000000000000400000000000000009faf1afd4ccb2740d014078cdd1aa4405e4d36742127b7428385c2210e2e5bacb74a72dc35c70018bb4b49c6dee503f579e07d54d7a1208b6c2227b2f563d01");
+
+	TArray<uint8> Address(uint8 First, uint8 Fill = 0)
+	{
+		TArray<uint8> Bytes;
+		Bytes.Init(Fill, 32);
+		Bytes[0] = First;
+		return Bytes;
+	}
+
+	bool SameBytes(TArrayView<const uint8> A, TArrayView<const uint8> B)
+	{
+		return A.Num() == B.Num() && FMemory::Memcmp(A.GetData(), B.GetData(), A.Num()) == 0;
+	}
+
+	FString Utf8ToString(TArrayView<const uint8> Utf8)
+	{
+		if (Utf8.Num() == 0) return FString();
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTransferPayloadTest, "HAZE.Signing.TransferPayload", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTransferPayloadTest::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> From = Address(0x01);
+	const TArray<uint8> To = Address(0x02);
+
+	TestEqual(TEXT("Transfer"), FHazeHex::ToHex(FTransactionSigning::BuildTransferPayload(From, To, 1000000, 1000, 5)), TransferVector);
+	TestEqual(TEXT("Transfer with chain fields"),
+		FHazeHex::ToHex(FTransactionSigning::BuildTransferPayload(From, To, 1000000, 1000, 5, 1ull, 500ull)), TransferChainVector);
+
+	uint8 Out[FHazeTransferPayloadLayout::MaxSize];
+	const int32 Len = FTransactionSigning::WriteTransferPayload(Out, From, To, 1000000, 1000, 5, 1ull, 500ull);
+	TestEqual(TEXT("WriteTransferPayload size"), Len, FHazeTransferPayloadLayout::Size(true, true));
+	TestEqual(TEXT("WriteTransferPayload bytes"), FHazeHex::ToHex(MakeArrayView(Out, Len)), TransferChainVector);
+
+	TestEqual(TEXT("Short address is rejected"), FTransactionSigning::WriteTransferPayload(Out, MakeArrayView(From.GetData(), 31), To, 1, 1, 1), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeMistbornPayloadTest, "HAZE.Signing.MistbornPayload", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeMistbornPayloadTest::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> From = Address(0x11, 0x11);
+	const TArray<uint8> AssetId = Address(0x22, 0x22);
+	const TMap<FString, FString> None;
+
+	TestEqual(TEXT("Create"), FHazeHex::ToHex(FTransactionSigning::BuildMistbornAssetPayload(
+		From, EAssetAction::Create, AssetId, From, EDensityLevel::Light, 10, 3, None)), MistbornCreateVector);
+
+	TMap<FString, FString> Merge;
+	Merge.Add(TEXT("_other_asset_id"), FString::ChrN(64, TEXT('3')));
+	TestEqual(TEXT("Merge"), FHazeHex::ToHex(FTransactionSigning::BuildMistbornAssetPayload(
+		From, EAssetAction::Merge, AssetId, From, EDensityLevel::Dense, 10, 3, Merge, 7ull)), MistbornMergeVector);
+
+	TMap<FString, FString> Split;
+	Split.Add(TEXT("_components"), TEXT("aa,bb"));
+	TestEqual(TEXT("Split"), FHazeHex::ToHex(FTransactionSigning::BuildMistbornAssetPayload(
+		From, EAssetAction::Split, AssetId, From, EDensityLevel::Core, 10, 3, Split)), MistbornSplitVector);
+
+	// Write into a buffer too small for the Split components: nothing written, size reported
+	uint8 Small[FHazeMistbornPayloadLayout::HeaderSize];
+	const int32 Needed = FTransactionSigning::WriteMistbornAssetPayload(
+		Small, UE_ARRAY_COUNT(Small), From, EAssetAction::Split, AssetId, From, EDensityLevel::Core, 10, 3, Split);
+	TestEqual(TEXT("Split size reported when it does not fit"), Needed, FCString::Strlen(MistbornSplitVector) / 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTransferHashTest, "HAZE.Signing.TransferHash", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTransferHashTest::RunTest(const FString& Parameters)
+{
+	// The node hashes the bincode encoding, so the JSON form must hash like SignedTransferBincode
+	const FString To = FHazeHex::ToHex(Address(0x02));
+	const FString Json = FString::Printf(
+		TEXT("{\"Transfer\":{\"from\":\"%s\",\"to\":\"%s\",\"amount\":\"1000000\",\"fee\":\"1000\",\"nonce\":5,")
+		TEXT("\"chain_id\":1,\"valid_until_height\":500,\"signature\":\"%s\"}}"),
+		RfcPublicKey, *To, SignedTransferSignature);
+	TestEqual(TEXT("Transfer"), FTransactionBuilder::TransferHash(Json), FHazeSha256::HashHex(FHazeHex::ToBytes(SignedTransferBincode)));
+
+	TestTrue(TEXT("Other variants"), FTransactionBuilder::TransferHash(TEXT("{\"MistbornAsset\":{}}")).IsEmpty());
+	TestTrue(TEXT("Missing nonce"), FTransactionBuilder::TransferHash(Json.Replace(TEXT("\"nonce\":5,"), TEXT(""))).IsEmpty());
+	TestTrue(TEXT("Short address"), FTransactionBuilder::TransferHash(Json.Replace(*To, TEXT("02"))).IsEmpty());
+	TestTrue(TEXT("Not JSON"), FTransactionBuilder::TransferHash(TEXT("a1")).IsEmpty());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeSignedTransactionTest, "HAZE.Signing.SignedTransaction", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeSignedTransactionTest::RunTest(const FString& Parameters)
+{
+	if (!UHazeKeyPair::IsSigningAvailable())
+	{
+		AddInfo(TEXT("Ed25519 is not linked (HAZE_HAS_ED25519); signature vectors skipped"));
+		return true;
+	}
+
+	UHazeKeyPair* Key = UHazeKeyPair::FromPrivateKeyHex(RfcSeed);
+	if (!TestNotNull(TEXT("RFC 8032 key"), Key)) return false;
+	TestEqual(TEXT("Address is the RFC public key"), Key->GetAddressHex(), RfcPublicKey);
+	TestEqual(TEXT("RFC 8032 empty-message signature"), FHazeHex::ToHex(Key->Sign(TArray<uint8>())), RfcEmptySignature);
+
+	const FString To = FHazeHex::ToHex(Address(0x02));
+	const FString ExpectedJson = FString::Printf(
+		TEXT("{\"Transfer\":{\"from\":\"%s\",\"to\":\"%s\",\"amount\":\"1000000\",\"fee\":\"1000\",\"nonce\":5,")
+		TEXT("\"chain_id\":1,\"valid_until_height\":500,\"signature\":\"%s\"}}"),
+		RfcPublicKey, *To, SignedTransferSignature);
+	TestEqual(TEXT("BuildSignedTransfer"), FTransactionBuilder::BuildSignedTransfer(Key, To, 1000000, 1000, 5, 1ull, 500ull), ExpectedJson);
+
+	TArray<uint8> Body;
+	TestTrue(TEXT("WriteSignedTransferRequest"), FTransactionBuilder::WriteSignedTransferRequest(Body, Key, To, 1000000, 1000, 5, 1ull, 500ull));
+	TestEqual(TEXT("Request body"), Utf8ToString(Body), FString::Printf(TEXT("{\"transaction\":%s}"), *ExpectedJson));
+
+	TestEqual(TEXT("BuildSignedTransferBinary"),
+		FHazeHex::ToHex(FTransactionBuilder::BuildSignedTransferBinary(Key, To, 1000000, 1000, 5, 1ull, 500ull)), SignedTransferBincode);
+
+	TArray<FHazeTransferIntent> Intents;
+	Intents.SetNum(8);
+	for (FHazeTransferIntent& Intent : Intents)
+	{
+		Intent.ToAddressHex = To;
+		Intent.Amount = 1000000;
+		Intent.Fee = 1000;
+		Intent.Nonce = 5;
+		Intent.ChainId = 1;
+		Intent.ValidUntilHeight = 500;
+	}
+	for (const FString& Json : FTransactionBuilder::BuildSignedTransferBatch(Key, Intents))
+	{
+		TestEqual(TEXT("Batch entry matches the single build"), Json, ExpectedJson);
+	}
+
+	// A new PrivateKey swaps in a new context; a signer already handed out keeps signing with the old key
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Held = Key->GetSigner();
+	TestTrue(TEXT("Same context while the key is unchanged"), Held == Key->GetSigner());
+	Key->PrivateKey = Address(0x07, 0x07);
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Rekeyed = Key->GetSigner();
+	TestTrue(TEXT("New context"), Rekeyed.IsValid() && Rekeyed != Held);
+	uint8 Signature[FHazeSignerContext::SignatureSize];
+	TestTrue(TEXT("Held signer still signs"), Held->Sign(nullptr, 0, Signature));
+	TestEqual(TEXT("With the old key"), FHazeHex::ToHex(MakeArrayView(Signature, FHazeSignerContext::SignatureSize)), RfcEmptySignature);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeWalletPoolTest, "HAZE.Signing.WalletPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeWalletPoolTest::RunTest(const FString& Parameters)
+{
+	FHazeWalletPool Pool;
+	if (!UHazeKeyPair::IsSigningAvailable())
+	{
+		TestFalse(TEXT("No wallets without Ed25519"), Pool.Generate(2)[0].IsSet());
+		TestEqual(TEXT("Empty"), Pool.Num(), 0);
+		AddInfo(TEXT("Ed25519 is not linked (HAZE_HAS_ED25519); wallet pool signing skipped"));
+		return true;
+	}
+
+	const TArray<FString> Seeds = { RfcSeed, TEXT("not hex"), RfcSeed };
+	const TArray<FHazeWalletHandle> Imported = Pool.ImportHex(Seeds);
+	if (!TestEqual(TEXT("One handle per seed"), Imported.Num(), 3)) return false;
+	TestTrue(TEXT("Bad seed"), Imported[0].IsSet() && !Imported[1].IsSet() && Imported[2].IsSet());
+	TestEqual(TEXT("Address is the RFC public key"), Pool.GetAddressHex(Imported[0]), RfcPublicKey);
+	uint8 Signature[FHazeSignerContext::SignatureSize];
+	TestTrue(TEXT("Sign"), Pool.Sign(Imported[0], nullptr, 0, Signature));
+	TestEqual(TEXT("RFC 8032 empty-message signature"), FHazeHex::ToHex(MakeArrayView(Signature)), RfcEmptySignature);
+
+	// Many wallets span several chunks; each keeps its own key
+	const TArray<FHazeWalletHandle> Generated = Pool.Generate(FHazeWalletPool::SlotsPerChunk + 3);
+	TestEqual(TEXT("Generated"), Pool.Num(), FHazeWalletPool::SlotsPerChunk + 5);
+	TestNotEqual(TEXT("Distinct keys"), Pool.GetAddressHex(Generated[0]), Pool.GetAddressHex(Generated.Last()));
+	UHazeKeyPair* Wrapper = Pool.CreateKeyPair(Generated.Last());
+	if (TestNotNull(TEXT("Wrapper on demand"), Wrapper))
+	{
+		TestEqual(TEXT("Wrapper address"), Wrapper->GetAddressHex(), Pool.GetAddressHex(Generated.Last()));
+	}
+
+	// Removed wallets go stale, and their slot is reused under a new handle
+	TestTrue(TEXT("Remove"), Pool.Remove(Imported[2]));
+	TestFalse(TEXT("Remove once"), Pool.Remove(Imported[2]));
+	TestFalse(TEXT("Stale"), Pool.IsValid(Imported[2]) || Pool.GetSigner(Imported[2]).IsValid());
+	const FHazeWalletHandle Reused = Pool.Import(UHazeKeyPair::FromPrivateKeyHex(RfcSeed));
+	TestTrue(TEXT("Slot reused"), Reused.Index == Imported[2].Index && Reused != Imported[2]);
+	TestTrue(TEXT("By index"), Pool.GetHandle(Reused.Index) == Reused);
+
+	// Pool batches sign exactly as a key pair does
+	const FString To = FHazeHex::ToHex(Address(0x02));
+	TArray<FHazeWalletTransferIntent> Intents;
+	Intents.SetNum(6);
+	for (FHazeWalletTransferIntent& Intent : Intents)
+	{
+		Intent.From = Imported[0];
+		Intent.ToAddressHex = To;
+		Intent.Amount = 1000000;
+		Intent.Fee = 1000;
+		Intent.Nonce = 5;
+		Intent.ChainId = 1;
+		Intent.ValidUntilHeight = 500;
+	}
+	Intents[5].From = Imported[2];
+	const FString Expected = FTransactionBuilder::BuildSignedTransfer(UHazeKeyPair::FromPrivateKeyHex(RfcSeed), To, 1000000, 1000, 5, 1ull, 500ull);
+	const TArray<FString> Jsons = FTransactionBuilder::BuildSignedTransferBatch(Pool, Intents);
+	TestEqual(TEXT("Pooled batch matches the key pair"), Jsons[0], Expected);
+	TestTrue(TEXT("Stale wallet leaves its entry empty"), Jsons[5].IsEmpty());
+	TestEqual(TEXT("Pooled binary"), FHazeHex::ToHex(FTransactionBuilder::BuildSignedTransferBatchBinary(Pool, Intents)[1]), SignedTransferBincode);
+
+	const TArray<FHazeWalletHandle> Wallets = { Imported[0], Imported[2] };
+	const TArray<TArrayView<const uint8>> Messages = { TArrayView<const uint8>(), TArrayView<const uint8>() };
+	TArray<uint8> Signatures;
+	TestEqual(TEXT("SignBatch skips stale wallets"), Pool.SignBatch(Wallets, Messages, Signatures), 1);
+	TestEqual(TEXT("SignBatch signature"), FHazeHex::ToHex(MakeArrayView(Signatures.GetData(), FHazeSignerContext::SignatureSize)), RfcEmptySignature);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeHexTest, "HAZE.Hex.EncodeDecode", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeHexTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> Bytes;
+	for (int32 i = 0; i < 256; i++)
+	{
+		Bytes.Add(static_cast<uint8>(i * 37 + 11));
+	}
+
+	// Lengths around the 16-byte SIMD blocks
+	for (int32 Len : { 0, 1, 15, 16, 17, 31, 32, 33, 64, 255 })
+	{
+		const TArrayView<const uint8> View(Bytes.GetData(), Len);
+		FString Expected;
+		for (uint8 B : View)
+		{
+			Expected += FString::Printf(TEXT("%02x"), B);
+		}
+		TestEqual(FString::Printf(TEXT("ToHex, %d bytes"), Len), FHazeHex::ToHex(View), Expected);
+
+		TArray<uint8> Utf8;
+		Utf8.SetNumUninitialized(Len * 2);
+		FHazeHex::Encode(View.GetData(), Len, reinterpret_cast<UTF8CHAR*>(Utf8.GetData()));
+		TestEqual(FString::Printf(TEXT("UTF-8 encode, %d bytes"), Len), Utf8ToString(Utf8), Expected);
+
+		TArray<uint8> Decoded;
+		Decoded.SetNumUninitialized(Len);
+		TestTrue(FString::Printf(TEXT("Decode, %d bytes"), Len), FHazeHex::Decode(Expected.ToUpper(), Decoded.GetData(), Len));
+		TestTrue(FString::Printf(TEXT("Round trip, %d bytes"), Len), Decoded == TArray<uint8>(View));
+	}
+
+	uint8 Out[4];
+	TestFalse(TEXT("Invalid digit"), FHazeHex::Decode(TEXT("0g"), Out, 1));
+	TestFalse(TEXT("Wrong length"), FHazeHex::Decode(TEXT("012"), Out, 1));
+	TestEqual(TEXT("Lenient skips whitespace"), FHazeHex::DecodeLenient(TEXT(" de ad\r\nbe ef\n"), Out, 4), 4);
+	TestEqual(TEXT("Lenient value"), FHazeHex::ToHex(MakeArrayView(Out, 4)), FString(TEXT("deadbeef")));
+	TestEqual(TEXT("Lenient odd digit count"), FHazeHex::DecodeLenient(TEXT("abc"), Out, 4), -1);
+	TestEqual(TEXT("Lenient overflow"), FHazeHex::DecodeLenient(TEXT("0011223344"), Out, 4), -1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeJsonWriterTest, "HAZE.Json.Writer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeJsonWriterTest::RunTest(const FString& Parameters)
+{
+	TArray<uint8> Out;
+	FHazeJsonWriter W(Out);
+	W.BeginObject();
+	W.Field(TEXT("quote"), TEXT("a\"b\\c"));
+	W.Field(TEXT("control"), TEXT("\n\t\x01"));
+	W.Field(TEXT("utf8"), TEXT("\u00e9\u20ac\U0001F600"));
+	W.Key(TEXT("list"));
+	W.BeginArray();
+	W.Number(0);
+	W.Number(18446744073709551615ull);
+	W.NumberString(42);
+	W.Null();
+	W.RawValue(TEXT("{\"x\":1}"));
+	W.EndArray();
+	W.OptionalNumberField(TEXT("absent"), {});
+	const uint8 HexBytes[] = { 0xab, 0x00 };
+	W.HexField(TEXT("hex"), MakeArrayView(HexBytes));
+	W.EndObject();
+
+	const char* Expected =
+		"{\"quote\":\"a\\\"b\\\\c\",\"control\":\"\\n\\t\\u0001\",\"utf8\":\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\","
+		"\"list\":[0,18446744073709551615,\"42\",null,{\"x\":1}],\"hex\":\"ab00\"}";
+	const TArrayView<const uint8> ExpectedBytes(reinterpret_cast<const uint8*>(Expected), FCStringAnsi::Strlen(Expected));
+	if (!SameBytes(Out, ExpectedBytes))
+	{
+		AddError(FString::Printf(TEXT("Escaped UTF-8 output differs, got %s"), *Utf8ToString(Out)));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,417 @@
+// Copyright HAZE Blockchain. Submission window, ordering lanes, retries and lookups, outbox replay, backpressure and cancellation of queued transactions.
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformFileManager.h"
+#include "HazeTxSubmitter.h"
+
+namespace
+{
+	/** Transport that holds every send until the test answers it */
+	struct FHeldSends
+	{
+		TArray<TPair<FString, FHazeOnTransaction>> Sends;
+
+		void Attach(UHazeTxSubmitter* Submitter)
+		{
+			Submitter->SetTransport([this](const FString& Json, FHazeOnTransaction OnComplete)
+			{
+				Sends.Emplace(Json, MoveTemp(OnComplete));
+			});
+		}
+
+		/** Answer the oldest held send, or the one at Index */
+		void Answer(bool bAccepted, int32 ResponseCode, int32 Index = 0)
+		{
+			TPair<FString, FHazeOnTransaction> Send = MoveTemp(Sends[Index]);
+			Sends.RemoveAt(Index);
+			FTransactionResponse Response;
+			Response.Status = bAccepted ? TEXT("pending") : TEXT("rejected");
+			Send.Value(bAccepted, Response, ResponseCode);
+		}
+	};
+
+	/** Submit Json under Key, recording its final status in Results. False if the queue refused it. */
+	bool SubmitTracked(UHazeTxSubmitter* Submitter, const FString& Json, const FString& Key, TMap<FString, FString>& Results,
+		EHazeTxPriority Priority = EHazeTxPriority::Normal)
+	{
+		return Submitter->Submit(Json, Priority, Key, [&Results, Json](bool bAccepted, const FTransactionResponse& Response, int32)
+		{
+			Results.Add(Json, bAccepted ? TEXT("accepted") : Response.Status);
+		});
+	}
+
+	/** Keys of the held sends, oldest first */
+	TArray<FString> SentKeys(const FHeldSends& Held)
+	{
+		TArray<FString> Keys;
+		for (const TPair<FString, FHazeOnTransaction>& Send : Held.Sends)
+		{
+			Keys.Add(Send.Key);
+		}
+		return Keys;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterCancelTest, "HAZE.Submitter.Cancel", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterCancelTest::RunTest(const FString& Parameters)
+{
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	Submitter->MaxInFlight = 1;
+	FHeldSends Held;
+	Held.Attach(Submitter);
+
+	// a1 is in flight with a2 queued after it; lane b waits with its head ready and two behind it
+	TMap<FString, FString> Results;
+	SubmitTracked(Submitter, TEXT("a1"), TEXT("a"), Results);
+	SubmitTracked(Submitter, TEXT("b1"), TEXT("b"), Results);
+	SubmitTracked(Submitter, TEXT("b2"), TEXT("b"), Results);
+	SubmitTracked(Submitter, TEXT("b3"), TEXT("b"), Results);
+	SubmitTracked(Submitter, TEXT("a2"), TEXT("a"), Results);
+	SubmitTracked(Submitter, TEXT("free"), FString(), Results);
+	TestEqual(TEXT("Sent"), Held.Sends.Num(), 1);
+	TestEqual(TEXT("Queued"), Submitter->GetQueueDepth(), 5);
+
+	Submitter->CancelPending();
+	TestEqual(TEXT("Every queued tx completes"), Results.Num(), 5);
+	for (const TCHAR* Json : { TEXT("b1"), TEXT("b2"), TEXT("b3"), TEXT("a2"), TEXT("free") })
+	{
+		TestEqual(FString::Printf(TEXT("%s dropped"), Json), Results.FindRef(Json), TEXT("dropped"));
+	}
+	TestEqual(TEXT("Queue empty"), Submitter->GetQueueDepth(), 0);
+	TestEqual(TEXT("Dropped count"), Submitter->GetStats().Dropped, int64(5));
+
+	// Lane b was freed with its head: a new tx for it is sent as soon as the window allows
+	SubmitTracked(Submitter, TEXT("b4"), TEXT("b"), Results);
+	// Lane a keeps a1 in flight; a3 queues after b4
+	SubmitTracked(Submitter, TEXT("a3"), TEXT("a"), Results);
+	Held.Answer(true, 200);
+	TestEqual(TEXT("In flight completes"), Results.FindRef(TEXT("a1")), TEXT("accepted"));
+	if (TestEqual(TEXT("Next send"), Held.Sends.Num(), 1))
+	{
+		TestEqual(TEXT("Freed lane sends"), Held.Sends[0].Key, TEXT("b4"));
+	}
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Busy lane follows"), Held.Sends.Num() > 0 ? Held.Sends[0].Key : FString(), TEXT("a3"));
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Drained"), Submitter->GetQueueDepth(), 0);
+	Submitter->SetTransport(nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterWindowTest, "HAZE.Submitter.Window", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterWindowTest::RunTest(const FString& Parameters)
+{
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	Submitter->MaxInFlight = 2;
+	FHeldSends Held;
+	Held.Attach(Submitter);
+
+	// Never more than the window in flight; a free slot goes to the highest priority waiting
+	TMap<FString, FString> Results;
+	SubmitTracked(Submitter, TEXT("n1"), FString(), Results);
+	SubmitTracked(Submitter, TEXT("n2"), FString(), Results);
+	SubmitTracked(Submitter, TEXT("n3"), FString(), Results);
+	SubmitTracked(Submitter, TEXT("h"), FString(), Results, EHazeTxPriority::High);
+	TestEqual(TEXT("Window full"), Held.Sends.Num(), 2);
+	TestEqual(TEXT("Queued"), Submitter->GetQueueDepth(), 2);
+	TestEqual(TEXT("In flight"), Submitter->GetStats().InFlight, 2);
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Priority first"), Held.Sends.Last().Key, TEXT("h"));
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Then enqueue order"), Held.Sends.Last().Key, TEXT("n3"));
+	Held.Answer(true, 200);
+	Held.Answer(true, 200);
+	TestEqual(TEXT("All accepted"), Submitter->GetStats().Accepted, int64(4));
+
+	// One at a time per ordering key when asked, even with slots free; a failure drops the lane behind it
+	Submitter->MaxInFlightPerKey = 1;
+	SubmitTracked(Submitter, TEXT("s1"), TEXT("s"), Results);
+	SubmitTracked(Submitter, TEXT("s2"), TEXT("s"), Results);
+	SubmitTracked(Submitter, TEXT("s3"), TEXT("s"), Results);
+	SubmitTracked(Submitter, TEXT("free"), FString(), Results);
+	if (TestEqual(TEXT("Lane head and free tx"), Held.Sends.Num(), 2))
+	{
+		TestEqual(TEXT("Lane waits"), Held.Sends[1].Key, TEXT("free"));
+	}
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Lane advances"), Held.Sends.Last().Key, TEXT("s2"));
+	Held.Answer(true, 200);
+	Held.Answer(false, 400);
+	TestEqual(TEXT("Rejected"), Results.FindRef(TEXT("s2")), TEXT("rejected"));
+	TestEqual(TEXT("Behind it dropped"), Results.FindRef(TEXT("s3")), TEXT("dropped"));
+	TestEqual(TEXT("Nothing sent after the failure"), Held.Sends.Num(), 0);
+	TestEqual(TEXT("Drained"), Submitter->GetQueueDepth(), 0);
+	Submitter->SetTransport(nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterLanePipeliningTest, "HAZE.Submitter.LanePipelining", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterLanePipeliningTest::RunTest(const FString& Parameters)
+{
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	Submitter->MaxInFlight = 8;
+	Submitter->MaxInFlightPerKey = 3;
+	Submitter->MaxRetries = 2;
+	FHeldSends Held;
+	Held.Attach(Submitter);
+
+	// Up to MaxInFlightPerKey of one key on the wire at once, in enqueue order
+	TMap<FString, FString> Results;
+	for (const TCHAR* Json : { TEXT("p1"), TEXT("p2"), TEXT("p3"), TEXT("p4"), TEXT("p5") })
+	{
+		SubmitTracked(Submitter, Json, TEXT("p"), Results);
+	}
+	TestTrue(TEXT("Three in flight"), SentKeys(Held) == TArray<FString>({ TEXT("p1"), TEXT("p2"), TEXT("p3") }));
+	TestEqual(TEXT("Rest queued"), Submitter->GetQueueDepth(), 2);
+
+	// p2 reached the node before p1 and was refused: it waits until p1 is answered, and nothing passes it
+	Held.Answer(false, 400, 1);
+	TestFalse(TEXT("Refused follower not completed"), Results.Contains(TEXT("p2")));
+	TestEqual(TEXT("Counted as a retry"), Submitter->GetStats().Retries, int64(1));
+	TestTrue(TEXT("Nothing sent past it"), SentKeys(Held) == TArray<FString>({ TEXT("p1"), TEXT("p3") }));
+	Held.Answer(true, 200);
+	TestTrue(TEXT("Still waits for p3"), SentKeys(Held) == TArray<FString>({ TEXT("p3") }));
+
+	// p3 arrived while p2 was missing: refused too, and p2 goes out again ahead of it
+	Held.Answer(false, 400);
+	TestTrue(TEXT("p2 resent alone"), SentKeys(Held) == TArray<FString>({ TEXT("p2") }));
+	Held.Answer(true, 200);
+	TestTrue(TEXT("Then the lane opens up again"), SentKeys(Held) == TArray<FString>({ TEXT("p3"), TEXT("p4"), TEXT("p5") }));
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Resent follower accepted"), Results.FindRef(TEXT("p2")), TEXT("accepted"));
+	TestEqual(TEXT("Second resent follower accepted"), Results.FindRef(TEXT("p3")), TEXT("accepted"));
+
+	// A refusal with nothing earlier unanswered is final: followers not yet sent are dropped, those sent are answered
+	SubmitTracked(Submitter, TEXT("p6"), TEXT("p"), Results);
+	SubmitTracked(Submitter, TEXT("p7"), TEXT("p"), Results);
+	TestTrue(TEXT("Window per key full"), SentKeys(Held) == TArray<FString>({ TEXT("p4"), TEXT("p5"), TEXT("p6") }));
+	Held.Answer(false, 400);
+	TestEqual(TEXT("Final failure"), Results.FindRef(TEXT("p4")), TEXT("rejected"));
+	TestEqual(TEXT("Unsent follower dropped"), Results.FindRef(TEXT("p7")), TEXT("dropped"));
+	TestTrue(TEXT("Sent followers still in flight"), SentKeys(Held) == TArray<FString>({ TEXT("p5"), TEXT("p6") }));
+	Held.Answer(false, 400);
+	Held.Answer(false, 400);
+	TestEqual(TEXT("Sent follower rejected"), Results.FindRef(TEXT("p6")), TEXT("rejected"));
+	TestEqual(TEXT("No more retries"), Submitter->GetStats().Retries, int64(2));
+	TestEqual(TEXT("Drained"), Submitter->GetQueueDepth(), 0);
+	TestEqual(TEXT("Nothing in flight"), Submitter->GetStats().InFlight, 0);
+	Submitter->SetTransport(nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterRetryTest, "HAZE.Submitter.Retry", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterRetryTest::RunTest(const FString& Parameters)
+{
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	Submitter->MaxInFlight = 4;
+	Submitter->MaxRetries = 1;
+	Submitter->InitialBackoffSeconds = 1.f;
+	Submitter->MaxBackoffSeconds = 1.f;
+	FHeldSends Held;
+	Held.Attach(Submitter);
+
+	TMap<FString, FString> Results;
+	SubmitTracked(Submitter, TEXT("a"), FString(), Results);
+	SubmitTracked(Submitter, TEXT("b"), FString(), Results);
+
+	// 503: retried after a backoff, and the window halves
+	const double Before = FPlatformTime::Seconds();
+	Held.Answer(false, 503);
+	TestFalse(TEXT("Not completed"), Results.Contains(TEXT("a")));
+	TestEqual(TEXT("Waits in the queue"), Submitter->GetQueueDepth(), 1);
+	TestEqual(TEXT("Retry counted"), Submitter->GetStats().Retries, int64(1));
+	TestEqual(TEXT("Window halved"), Submitter->GetStats().Window, 2);
+	Submitter->ResumeRetries(Before - 1.0);
+	TestEqual(TEXT("Not before its backoff"), Held.Sends.Num(), 1);
+	Submitter->ResumeRetries(FPlatformTime::Seconds() + 2.0);
+	if (TestEqual(TEXT("Resent"), Held.Sends.Num(), 2))
+	{
+		TestEqual(TEXT("Retry sent"), Held.Sends[1].Key, TEXT("a"));
+	}
+
+	// Out of retries: the failure is final
+	Held.Answer(true, 200);
+	Held.Answer(false, 503);
+	TestEqual(TEXT("Final failure"), Results.FindRef(TEXT("a")), TEXT("rejected"));
+	TestEqual(TEXT("No more retries"), Submitter->GetStats().Retries, int64(1));
+
+	// Client errors are never retried; transport failures (0) are
+	SubmitTracked(Submitter, TEXT("c"), FString(), Results);
+	Held.Answer(false, 400);
+	TestEqual(TEXT("400 not retried"), Results.FindRef(TEXT("c")), TEXT("rejected"));
+	SubmitTracked(Submitter, TEXT("d"), FString(), Results);
+	Held.Answer(false, 0);
+	TestFalse(TEXT("0 retried"), Results.Contains(TEXT("d")));
+	TestEqual(TEXT("Retry counted again"), Submitter->GetStats().Retries, int64(2));
+
+	// A retry waiting out its backoff is still pending, so CancelPending drops it
+	Submitter->CancelPending();
+	TestEqual(TEXT("Waiting retry dropped"), Results.FindRef(TEXT("d")), TEXT("dropped"));
+	TestEqual(TEXT("Queue empty"), Submitter->GetQueueDepth(), 0);
+	Submitter->ResumeRetries(FPlatformTime::Seconds() + 2.0);
+	TestEqual(TEXT("Dropped retry not sent"), Held.Sends.Num(), 0);
+	Submitter->SetTransport(nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterLookupTest, "HAZE.Submitter.RetryLookup", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterLookupTest::RunTest(const FString& Parameters)
+{
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	Submitter->MaxRetries = 2;
+	Submitter->MaxInFlightPerKey = 1;
+	FHeldSends Held;
+	Held.Attach(Submitter);
+
+	// The node has whatever is in Landed; each lookup answers at once
+	TSet<FString> Landed;
+	TArray<FString> LookedUp;
+	Submitter->SetLookup([&Landed, &LookedUp](const FString& Json, FHazeOnTransaction OnComplete)
+	{
+		LookedUp.Add(Json);
+		FTransactionResponse Response;
+		Response.Status = TEXT("pending");
+		OnComplete(Landed.Contains(Json), Response, Landed.Contains(Json) ? 200 : 404);
+		return true;
+	});
+
+	// s1 timed out but landed; its retry is refused as a duplicate. The lane goes on to s2.
+	TMap<FString, FString> Results;
+	SubmitTracked(Submitter, TEXT("s1"), TEXT("s"), Results);
+	SubmitTracked(Submitter, TEXT("s2"), TEXT("s"), Results);
+	Landed.Add(TEXT("s1"));
+	Held.Answer(false, 0);
+	Submitter->ResumeRetries(FPlatformTime::Seconds() + 60.0);
+	Held.Answer(false, 400);
+	TestTrue(TEXT("Refused retry looked up"), LookedUp == TArray<FString>({ TEXT("s1") }));
+	TestEqual(TEXT("Landed after all"), Results.FindRef(TEXT("s1")), TEXT("accepted"));
+	if (TestEqual(TEXT("Lane not dropped"), Held.Sends.Num(), 1))
+	{
+		TestEqual(TEXT("Next in the lane sent"), Held.Sends[0].Key, TEXT("s2"));
+	}
+
+	// s2 never landed: the refusal stands and what waits behind it is dropped
+	SubmitTracked(Submitter, TEXT("s3"), TEXT("s"), Results);
+	Held.Answer(false, 0);
+	Submitter->ResumeRetries(FPlatformTime::Seconds() + 60.0);
+	Held.Answer(false, 400);
+	TestEqual(TEXT("Not on the node"), Results.FindRef(TEXT("s2")), TEXT("rejected"));
+	TestEqual(TEXT("Behind it dropped"), Results.FindRef(TEXT("s3")), TEXT("dropped"));
+
+	// A first attempt refused with a 4xx, or a 408, is final without a lookup
+	SubmitTracked(Submitter, TEXT("t1"), FString(), Results);
+	Held.Answer(false, 400);
+	SubmitTracked(Submitter, TEXT("t2"), FString(), Results);
+	Held.Answer(false, 408);
+	TestEqual(TEXT("400 rejected"), Results.FindRef(TEXT("t1")), TEXT("rejected"));
+	TestEqual(TEXT("408 not retried"), Results.FindRef(TEXT("t2")), TEXT("rejected"));
+	TestEqual(TEXT("Two lookups"), LookedUp.Num(), 2);
+	TestEqual(TEXT("Drained"), Submitter->GetQueueDepth(), 0);
+	TestEqual(TEXT("Nothing in flight"), Submitter->GetStats().InFlight, 0);
+	Submitter->SetTransport(nullptr);
+	Submitter->SetLookup(nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterReplayTest, "HAZE.Submitter.Replay", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterReplayTest::RunTest(const FString& Parameters)
+{
+	const TCHAR* const JournalName = TEXT("AutomationReplayTest");
+	const FString Path = FHazeOutboxJournal::GetJournalPath(JournalName);
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Path);
+
+	// A crashed session journaled r1 and r2 and never heard back
+	{
+		TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Journal = FHazeOutboxJournal::Open(JournalName);
+		if (!TestTrue(TEXT("Open"), Journal.IsValid())) return false;
+		Journal->Append(TEXT("r"), 1ull, 1, TEXT("r1"));
+		Journal->Append(TEXT("r"), 2ull, 1, TEXT("r2"));
+	}
+
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	FHeldSends Held;
+	Held.Attach(Submitter);
+	TArray<FString> LookedUp;
+	Submitter->SetLookup([&LookedUp](const FString& Json, FHazeOnTransaction OnComplete)
+	{
+		// r1 reached the node before the crash; r2 did not
+		LookedUp.Add(Json);
+		FTransactionResponse Response;
+		Response.Status = TEXT("pending");
+		OnComplete(Json == TEXT("r1"), Response, Json == TEXT("r1") ? 200 : 404);
+		return true;
+	});
+	Submitter->SetOutbox(FHazeOutboxJournal::Open(JournalName));
+	TestEqual(TEXT("Replayed"), Submitter->ReplayOutbox(), 2);
+
+	TestTrue(TEXT("Both looked up, in order"), LookedUp == TArray<FString>({ TEXT("r1"), TEXT("r2") }));
+	if (TestEqual(TEXT("Only the missing one resent"), Held.Sends.Num(), 1))
+	{
+		TestEqual(TEXT("Resent"), Held.Sends[0].Key, TEXT("r2"));
+	}
+	TestEqual(TEXT("Found one acknowledged"), Submitter->GetOutbox()->GetPendingCount(), 1);
+	TestEqual(TEXT("Found one counted accepted"), Submitter->GetStats().Accepted, int64(1));
+
+	// A refusal of the first resend is final: the lookup already happened
+	Held.Answer(false, 400);
+	TestEqual(TEXT("No second lookup"), LookedUp.Num(), 2);
+	TestEqual(TEXT("Answered, so acknowledged"), Submitter->GetOutbox()->GetPendingCount(), 0);
+
+	Submitter->SetOutbox(nullptr);
+	Submitter->SetTransport(nullptr);
+	Submitter->SetLookup(nullptr);
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Path);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHazeTxSubmitterBackpressureTest, "HAZE.Submitter.Backpressure", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FHazeTxSubmitterBackpressureTest::RunTest(const FString& Parameters)
+{
+	UHazeTxSubmitter* Submitter = UHazeTxSubmitter::CreateSubmitter(nullptr);
+	Submitter->MaxInFlight = 1;
+	Submitter->MaxQueueDepth = 4;
+	Submitter->HighWaterMark = 3;
+	Submitter->LowWaterMark = 1;
+	FHeldSends Held;
+	Held.Attach(Submitter);
+
+	// t0 goes out at once; the rest wait
+	TMap<FString, FString> Results;
+	SubmitTracked(Submitter, TEXT("t0"), FString(), Results);
+	SubmitTracked(Submitter, TEXT("t1"), FString(), Results);
+	SubmitTracked(Submitter, TEXT("t2"), FString(), Results);
+	TestFalse(TEXT("Below the high-water mark"), Submitter->IsSaturated());
+	SubmitTracked(Submitter, TEXT("t3"), FString(), Results);
+	TestTrue(TEXT("Saturated at the high-water mark"), Submitter->IsSaturated());
+	TestTrue(TEXT("Room left"), SubmitTracked(Submitter, TEXT("t4"), FString(), Results));
+	TestFalse(TEXT("Refused at MaxQueueDepth"), SubmitTracked(Submitter, TEXT("t5"), FString(), Results));
+	TestEqual(TEXT("Depth capped"), Submitter->GetQueueDepth(), 4);
+
+	// Stays saturated until the queue drains to the low-water mark
+	Held.Answer(true, 200);
+	Held.Answer(true, 200);
+	TestEqual(TEXT("Draining"), Submitter->GetQueueDepth(), 2);
+	TestTrue(TEXT("Still saturated"), Submitter->IsSaturated());
+	Held.Answer(true, 200);
+	TestFalse(TEXT("Released at the low-water mark"), Submitter->IsSaturated());
+	TestTrue(TEXT("Accepted again"), SubmitTracked(Submitter, TEXT("t5"), FString(), Results));
+
+	while (Held.Sends.Num() > 0) Held.Answer(true, 200);
+	TestEqual(TEXT("Every admitted tx completes"), Results.Num(), 6);
+	TestEqual(TEXT("Drained"), Submitter->GetQueueDepth(), 0);
+	Submitter->SetTransport(nullptr);
+	return true;
+}
+
+#endif
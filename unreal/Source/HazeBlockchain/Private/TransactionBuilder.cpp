@@ -2,32 +2,356 @@
 
 #include "TransactionBuilder.h"
 #include "TransactionSigning.h"
-#include "Misc/Parse.h"
+#include "HazeHex.h"
+#include "HazeBincode.h"
+#include "HazeJsonWriter.h"
+#include "HazeSha256.h"
+#include "HazeStats.h"
+#include "Algo/AllOf.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 FString FTransactionBuilder::BytesToHex(const TArray<uint8>& Bytes)
 {
-	FString Hex;
-	Hex.Reserve(Bytes.Num() * 2);
-	for (uint8 B : Bytes)
-	{
-		Hex += FString::Printf(TEXT("%02x"), B);
-	}
-	return Hex;
+	return FHazeHex::ToHex(Bytes);
 }
 
 TArray<uint8> FTransactionBuilder::HexToBytes(const FString& Hex)
 {
-	TArray<uint8> Out;
-	FString H = Hex.TrimStartAndEnd().Replace(TEXT(" "), TEXT(""));
-	Out.SetNum(H.Len() / 2);
-	for (int32 i = 0; i < Out.Num(); i++)
+	return FHazeHex::ToBytes(Hex);
+}
+
+namespace
+{
+	/** Below this many intents the batch runs on the calling thread; task dispatch would cost more than it saves. */
+	constexpr int32 MinParallelBatch = 4;
+
+	/** bincode variant indices of the node's Transaction enum (src/types.rs) */
+	constexpr uint32 TransferVariant = 0;
+	constexpr uint32 MistbornAssetVariant = 3;
+
+	/** Largest bincode Transfer: variant, two addresses, three u64, two Some(u64), a 64-byte signature vec */
+	constexpr int32 MaxTransferBinarySize = 4 + 2 * 32 + 3 * 8 + 2 * 9 + 8 + FHazeSignerContext::SignatureSize;
+
+	/** Largest Transfer JSON: three 64-digit hex fields, one 128-digit signature, five u64 and the keys */
+	constexpr int32 MaxTransferJsonSize = 512;
+
+	/** Sign a Transfer; fills ToBytes and Sig. False on a bad address or signer failure. */
+	bool SignTransferCore(
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& ToAddressHex,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight,
+		uint8 (&ToBytes)[32],
+		uint8 (&Sig)[FHazeSignerContext::SignatureSize])
+	{
+		if (FHazeHex::DecodeLenient(ToAddressHex, ToBytes, 32) != 32) return false;
+
+		uint8 Payload[FHazeTransferPayloadLayout::MaxSize];
+		const int32 PayloadLen = FTransactionSigning::WriteTransferPayload(
+			Payload, FromAddress, MakeArrayView(ToBytes), Amount, Fee, Nonce, ChainId, ValidUntilHeight);
+		return PayloadLen != 0 && Signer.Sign(Payload, PayloadLen, Sig);
+	}
+
+	/** Encoded JSON as an FString (for the FString builders) */
+	FString Utf8ToString(const TArray<uint8>& Utf8)
+	{
+		if (Utf8.Num() == 0) return FString();
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	/** Write the signed Transfer object. Nothing is written on failure. */
+	bool WriteTransfer(
+		FHazeJsonWriter& W,
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& ToAddressHex,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight)
+	{
+		uint8 ToBytes[32];
+		uint8 Sig[FHazeSignerContext::SignatureSize];
+		if (!SignTransferCore(Signer, FromAddress, ToAddressHex, Amount, Fee, Nonce, ChainId, ValidUntilHeight, ToBytes, Sig)) return false;
+
+		HAZE_SCOPE(STAT_HazeBuildJson, HazeBuildJson);
+		W.BeginObject();
+		W.Key(TEXT("Transfer"));
+		W.BeginObject();
+		W.HexField(TEXT("from"), FromAddress);
+		W.HexField(TEXT("to"), MakeArrayView(ToBytes));
+		W.Key(TEXT("amount"));
+		W.NumberString(Amount);
+		W.Key(TEXT("fee"));
+		W.NumberString(Fee);
+		W.NumberField(TEXT("nonce"), Nonce);
+		W.OptionalNumberField(TEXT("chain_id"), ChainId);
+		W.OptionalNumberField(TEXT("valid_until_height"), ValidUntilHeight);
+		W.HexField(TEXT("signature"), MakeArrayView(Sig));
+		W.EndObject();
+		W.EndObject();
+		return true;
+	}
+
+	FString SignTransfer(
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& ToAddressHex,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight)
+	{
+		TArray<uint8> Json;
+		Json.Reserve(MaxTransferJsonSize);
+		FHazeJsonWriter W(Json);
+		WriteTransfer(W, Signer, FromAddress, ToAddressHex, Amount, Fee, Nonce, ChainId, ValidUntilHeight);
+		return Utf8ToString(Json);
+	}
+
+	TArray<uint8> SignTransferBinary(
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& ToAddressHex,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight)
+	{
+		TArray<uint8> Out;
+		uint8 ToBytes[32];
+		uint8 Sig[FHazeSignerContext::SignatureSize];
+		if (!SignTransferCore(Signer, FromAddress, ToAddressHex, Amount, Fee, Nonce, ChainId, ValidUntilHeight, ToBytes, Sig)) return Out;
+
+		HAZE_SCOPE(STAT_HazeBuildBinary, HazeBuildBinary);
+		Out.Reserve(MaxTransferBinarySize);
+		FHazeBincodeWriter W(Out);
+		W.WriteVariant(TransferVariant);
+		W.WriteFixed(FromAddress);
+		W.WriteFixed(MakeArrayView(ToBytes));
+		W.WriteU64(Amount);
+		W.WriteU64(Fee);
+		W.WriteU64(Nonce);
+		W.WriteOptionU64(ChainId);
+		W.WriteOptionU64(ValidUntilHeight);
+		W.WriteBytes(MakeArrayView(Sig));
+		return Out;
+	}
+
+	/** Sign a MistbornAsset Create; fills AssetIdBytes and Sig. False on a bad id or signer failure. */
+	bool SignMistbornCreateCore(
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight,
+		uint8 (&AssetIdBytes)[32],
+		uint8 (&Sig)[FHazeSignerContext::SignatureSize])
+	{
+		if (FHazeHex::DecodeLenient(AssetIdHex, AssetIdBytes, 32) != 32) return false;
+
+		TMap<FString, FString> MergeSplit; // empty for Create
+		FHazeMistbornPayload Payload;
+		FTransactionSigning::BuildMistbornAssetPayloadInto(
+			Payload, FromAddress, EAssetAction::Create, MakeArrayView(AssetIdBytes), FromAddress,
+			Density, Fee, Nonce, MergeSplit, ChainId, ValidUntilHeight);
+		return Payload.Num() != 0 && Signer.Sign(Payload.GetData(), Payload.Num(), Sig);
+	}
+
+	/** u64 written as a number or a decimal string; unset if the field is missing or null */
+	bool ReadU64(const FJsonObject& Object, const TCHAR* Field, TOptional<uint64>& Out)
+	{
+		const TSharedPtr<FJsonValue> Value = Object.TryGetField(Field);
+		if (!Value.IsValid() || Value->IsNull()) return true;
+		uint64 Number = 0;
+		if (Value->Type == EJson::String)
+		{
+			const FString Text = Value->AsString();
+			if (Text.IsEmpty() || !Algo::AllOf(Text, [](TCHAR C) { return FChar::IsDigit(C); })) return false;
+			Number = FCString::Strtoui64(*Text, nullptr, 10);
+		}
+		else if (!Value->TryGetNumber(Number))
+		{
+			return false;
+		}
+		Out = Number;
+		return true;
+	}
+
+	/** Upper bound of the Mistborn JSON when the strings are ASCII and need no escaping */
+	int32 MistbornJsonSize(const TMap<FString, FString>& Metadata, const FString& GameId)
+	{
+		int32 Size = 640 + GameId.Len();
+		for (const auto& Pair : Metadata)
+		{
+			Size += Pair.Key.Len() + Pair.Value.Len() + 6;
+		}
+		return Size;
+	}
+
+	/** Write the signed MistbornAsset Create object. Nothing is written on failure. */
+	bool WriteMistbornCreate(
+		FHazeJsonWriter& W,
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		const TMap<FString, FString>& Metadata,
+		const FString& GameId,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight)
+	{
+		uint8 AssetIdBytes[32];
+		uint8 Sig[FHazeSignerContext::SignatureSize];
+		if (!SignMistbornCreateCore(Signer, FromAddress, AssetIdHex, Density, Fee, Nonce, ChainId, ValidUntilHeight, AssetIdBytes, Sig)) return false;
+
+		HAZE_SCOPE(STAT_HazeBuildJson, HazeBuildJson);
+		const TCHAR* DensityStr = TEXT("Ethereal");
+		switch (Density)
+		{
+			case EDensityLevel::Light: DensityStr = TEXT("Light"); break;
+			case EDensityLevel::Dense: DensityStr = TEXT("Dense"); break;
+			case EDensityLevel::Core: DensityStr = TEXT("Core"); break;
+			default: break;
+		}
+
+		W.BeginObject();
+		W.Key(TEXT("MistbornAsset"));
+		W.BeginObject();
+		W.HexField(TEXT("from"), FromAddress);
+		W.Field(TEXT("action"), TEXT("Create"));
+		W.HexField(TEXT("asset_id"), MakeArrayView(AssetIdBytes));
+
+		W.Key(TEXT("data"));
+		W.BeginObject();
+		W.Field(TEXT("density"), DensityStr);
+		W.Key(TEXT("metadata"));
+		W.BeginObject();
+		for (const auto& Pair : Metadata)
+		{
+			W.Field(Pair.Key, Pair.Value);
+		}
+		W.EndObject();
+		W.Key(TEXT("attributes"));
+		W.BeginArray();
+		W.EndArray();
+		W.Key(TEXT("game_id"));
+		if (GameId.IsEmpty()) W.Null();
+		else W.String(GameId);
+		W.HexField(TEXT("owner"), FromAddress);
+		W.EndObject();
+
+		W.NumberField(TEXT("fee"), Fee);
+		W.NumberField(TEXT("nonce"), Nonce);
+		W.OptionalNumberField(TEXT("chain_id"), ChainId);
+		W.OptionalNumberField(TEXT("valid_until_height"), ValidUntilHeight);
+		W.HexField(TEXT("signature"), MakeArrayView(Sig));
+		W.EndObject();
+		W.EndObject();
+		return true;
+	}
+
+	FString SignMistbornCreate(
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		const TMap<FString, FString>& Metadata,
+		const FString& GameId,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight)
+	{
+		TArray<uint8> Json;
+		Json.Reserve(MistbornJsonSize(Metadata, GameId));
+		FHazeJsonWriter W(Json);
+		WriteMistbornCreate(W, Signer, FromAddress, AssetIdHex, Density, Metadata, GameId, Fee, Nonce, ChainId, ValidUntilHeight);
+		return Utf8ToString(Json);
+	}
+
+	TArray<uint8> SignMistbornCreateBinary(
+		const FHazeSignerView& Signer,
+		TArrayView<const uint8> FromAddress,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		const TMap<FString, FString>& Metadata,
+		const FString& GameId,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId,
+		TOptional<uint64> ValidUntilHeight)
+	{
+		TArray<uint8> Out;
+		uint8 AssetIdBytes[32];
+		uint8 Sig[FHazeSignerContext::SignatureSize];
+		if (!SignMistbornCreateCore(Signer, FromAddress, AssetIdHex, Density, Fee, Nonce, ChainId, ValidUntilHeight, AssetIdBytes, Sig)) return Out;
+
+		HAZE_SCOPE(STAT_HazeBuildBinary, HazeBuildBinary);
+		FHazeBincodeWriter W(Out);
+		W.WriteVariant(MistbornAssetVariant);
+		W.WriteFixed(FromAddress);
+		W.WriteVariant(static_cast<uint32>(EAssetAction::Create));
+		W.WriteFixed(MakeArrayView(AssetIdBytes));
+		// AssetData { density, metadata, attributes, game_id, owner }
+		W.WriteVariant(static_cast<uint32>(Density));
+		W.WriteLength(Metadata.Num());
+		for (const auto& Pair : Metadata)
+		{
+			W.WriteString(Pair.Key);
+			W.WriteString(Pair.Value);
+		}
+		W.WriteLength(0);
+		W.WriteOptionString(GameId);
+		W.WriteFixed(FromAddress);
+		W.WriteU64(Fee);
+		W.WriteU64(Nonce);
+		W.WriteOptionU64(ChainId);
+		W.WriteOptionU64(ValidUntilHeight);
+		W.WriteBytes(MakeArrayView(Sig));
+		return Out;
+	}
+
+	/** Returns the key's signer if it can sign for its PublicKey, else null. Hold it while signing: a re-derived key
+	 *  swaps in a new context, and the old one lives as long as this pointer. */
+	TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> SignerFor(const UHazeKeyPair* KeyPair)
+	{
+		if (!KeyPair || KeyPair->PrivateKey.Num() != 32 || KeyPair->PublicKey.Num() != 32) return nullptr;
+		return KeyPair->GetSigner();
+	}
+
+	EParallelForFlags BatchFlags(int32 Num)
+	{
+		return Num < MinParallelBatch ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+	}
+
+	/** Signers of the intents' wallets, resolved under one pool lock */
+	TArray<FHazeSignerView> SignersFor(const FHazeWalletPool& Pool, const TArray<FHazeWalletTransferIntent>& Intents)
 	{
-		int32 A = FParse::HexDigit(H[i * 2]);
-		int32 B = FParse::HexDigit(H[i * 2 + 1]);
-		if (A < 0 || B < 0) return TArray<uint8>();
-		Out[i] = static_cast<uint8>((A << 4) | B);
+		TArray<FHazeWalletHandle> Wallets;
+		Wallets.Reserve(Intents.Num());
+		for (const FHazeWalletTransferIntent& I : Intents)
+		{
+			Wallets.Add(I.From);
+		}
+		return Pool.GetSigners(Wallets);
 	}
-	return Out;
 }
 
 FString FTransactionBuilder::BuildSignedTransfer(
@@ -39,21 +363,25 @@ FString FTransactionBuilder::BuildSignedTransfer(
 	TOptional<uint64> ChainId,
 	TOptional<uint64> ValidUntilHeight)
 {
-	if (!KeyPair || KeyPair->PrivateKey.Num() != 32 || KeyPair->PublicKey.Num() != 32) return FString();
-	TArray<uint8> ToBytes = HexToBytes(ToAddressHex);
-	if (ToBytes.Num() != 32) return FString();
-
-	TArray<uint8> Payload = FTransactionSigning::BuildTransferPayload(
-		KeyPair->PublicKey, ToBytes, Amount, Fee, Nonce, ChainId, ValidUntilHeight);
-	TArray<uint8> Sig = KeyPair->Sign(Payload);
-	if (Sig.Num() != 64) return FString();
-
-	FString FromHex = FTransactionBuilder::BytesToHex(KeyPair->PublicKey);
-	FString ToHex = ToAddressHex.TrimStartAndEnd();
-	FString SigHex = FTransactionBuilder::BytesToHex(Sig);
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return FString();
+	return SignTransfer(*Signer, KeyPair->PublicKey, ToAddressHex, Amount, Fee, Nonce, ChainId, ValidUntilHeight);
+}
 
-	return FString::Printf(TEXT("{\"Transfer\":{\"from\":\"%s\",\"to\":\"%s\",\"amount\":\"%llu\",\"fee\":\"%llu\",\"nonce\":%llu,\"signature\":\"%s\"}}"),
-		*FromHex, *ToHex, Amount, Fee, Nonce, *SigHex);
+FString FTransactionBuilder::BuildSignedMistbornCreate(
+	UHazeKeyPair* KeyPair,
+	const FString& AssetIdHex,
+	EDensityLevel Density,
+	const TMap<FString, FString>& Metadata,
+	const FString& GameId,
+	uint64 Fee,
+	uint64 Nonce,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return FString();
+	return SignMistbornCreate(*Signer, KeyPair->PublicKey, AssetIdHex, Density, Metadata, GameId, Fee, Nonce, ChainId, ValidUntilHeight);
 }
 
 FString FTransactionBuilder::BuildSignedMistbornCreate(
@@ -68,40 +396,238 @@ FString FTransactionBuilder::BuildSignedMistbornCreate(
 	TOptional<uint64> ChainId,
 	TOptional<uint64> ValidUntilHeight)
 {
-	if (!KeyPair || KeyPair->PublicKey.Num() != 32) return FString();
-	TArray<uint8> AssetIdBytes = HexToBytes(AssetIdHex);
-	if (AssetIdBytes.Num() != 32) return FString();
+	// Signing a create without the attributes the caller asked for would put the wrong asset on chain
+	if (Attributes.Num() > 0) return FString();
+	return BuildSignedMistbornCreate(KeyPair, AssetIdHex, Density, Metadata, GameId, Fee, Nonce, ChainId, ValidUntilHeight);
+}
 
-	TMap<FString, FString> MergeSplit; // empty for Create
-	TArray<uint8> Payload = FTransactionSigning::BuildMistbornAssetPayload(
-		KeyPair->PublicKey, EAssetAction::Create, AssetIdBytes, KeyPair->PublicKey,
-		Density, Fee, Nonce, MergeSplit, ChainId, ValidUntilHeight);
-	TArray<uint8> Sig = KeyPair->Sign(Payload);
-	if (Sig.Num() != 64) return FString();
+TArray<FString> FTransactionBuilder::BuildSignedTransferBatch(
+	UHazeKeyPair* KeyPair,
+	const TArray<FHazeTransferIntent>& Intents)
+{
+	TArray<FString> Results;
+	Results.SetNum(Intents.Num());
+	// Resolve the signer once on the calling thread so workers never touch the UObject's lock
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return Results;
 
-	FString FromHex = FTransactionBuilder::BytesToHex(KeyPair->PublicKey);
-	FString SigHex = FTransactionBuilder::BytesToHex(Sig);
+	const TArray<uint8>& FromAddress = KeyPair->PublicKey;
+	ParallelFor(Intents.Num(), [&](int32 Index)
+	{
+		const FHazeTransferIntent& I = Intents[Index];
+		Results[Index] = SignTransfer(*Signer, FromAddress, I.ToAddressHex, I.Amount, I.Fee, I.Nonce, I.ChainId, I.ValidUntilHeight);
+	}, BatchFlags(Intents.Num()));
+	return Results;
+}
 
-	// Density string
-	const TCHAR* DensityStr = TEXT("Ethereal");
-	switch (Density)
+TArray<FString> FTransactionBuilder::BuildSignedTransferBatch(
+	const FHazeWalletPool& Pool,
+	const TArray<FHazeWalletTransferIntent>& Intents)
+{
+	TArray<FString> Results;
+	Results.SetNum(Intents.Num());
+	const TArray<FHazeSignerView> Signers = SignersFor(Pool, Intents);
+	ParallelFor(Intents.Num(), [&](int32 Index)
+	{
+		const FHazeWalletTransferIntent& I = Intents[Index];
+		const FHazeSignerView& Signer = Signers[Index];
+		if (!Signer.IsValid()) return;
+		Results[Index] = SignTransfer(Signer, Signer.GetPublicKey(), I.ToAddressHex, I.Amount, I.Fee, I.Nonce, I.ChainId, I.ValidUntilHeight);
+	}, BatchFlags(Intents.Num()));
+	return Results;
+}
+
+TArray<FString> FTransactionBuilder::BuildSignedMistbornBatch(
+	UHazeKeyPair* KeyPair,
+	const TArray<FHazeMistbornCreateIntent>& Intents)
+{
+	TArray<FString> Results;
+	Results.SetNum(Intents.Num());
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return Results;
+
+	const TArray<uint8>& FromAddress = KeyPair->PublicKey;
+	ParallelFor(Intents.Num(), [&](int32 Index)
+	{
+		const FHazeMistbornCreateIntent& I = Intents[Index];
+		Results[Index] = SignMistbornCreate(*Signer, FromAddress, I.AssetIdHex, I.Density, I.Metadata, I.GameId, I.Fee, I.Nonce, I.ChainId, I.ValidUntilHeight);
+	}, BatchFlags(Intents.Num()));
+	return Results;
+}
+
+TArray<uint8> FTransactionBuilder::BuildSignedTransferBinary(
+	UHazeKeyPair* KeyPair,
+	const FString& ToAddressHex,
+	uint64 Amount,
+	uint64 Fee,
+	uint64 Nonce,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return TArray<uint8>();
+	return SignTransferBinary(*Signer, KeyPair->PublicKey, ToAddressHex, Amount, Fee, Nonce, ChainId, ValidUntilHeight);
+}
+
+TArray<uint8> FTransactionBuilder::BuildSignedMistbornCreateBinary(
+	UHazeKeyPair* KeyPair,
+	const FString& AssetIdHex,
+	EDensityLevel Density,
+	const TMap<FString, FString>& Metadata,
+	const FString& GameId,
+	uint64 Fee,
+	uint64 Nonce,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return TArray<uint8>();
+	return SignMistbornCreateBinary(*Signer, KeyPair->PublicKey, AssetIdHex, Density, Metadata, GameId, Fee, Nonce, ChainId, ValidUntilHeight);
+}
+
+TArray<TArray<uint8>> FTransactionBuilder::BuildSignedTransferBatchBinary(
+	UHazeKeyPair* KeyPair,
+	const TArray<FHazeTransferIntent>& Intents)
+{
+	TArray<TArray<uint8>> Results;
+	Results.SetNum(Intents.Num());
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return Results;
+
+	const TArray<uint8>& FromAddress = KeyPair->PublicKey;
+	ParallelFor(Intents.Num(), [&](int32 Index)
 	{
-		case EDensityLevel::Light: DensityStr = TEXT("Light"); break;
-		case EDensityLevel::Dense: DensityStr = TEXT("Dense"); break;
-		case EDensityLevel::Core: DensityStr = TEXT("Core"); break;
-		default: break;
+		const FHazeTransferIntent& I = Intents[Index];
+		Results[Index] = SignTransferBinary(*Signer, FromAddress, I.ToAddressHex, I.Amount, I.Fee, I.Nonce, I.ChainId, I.ValidUntilHeight);
+	}, BatchFlags(Intents.Num()));
+	return Results;
+}
+
+TArray<TArray<uint8>> FTransactionBuilder::BuildSignedTransferBatchBinary(
+	const FHazeWalletPool& Pool,
+	const TArray<FHazeWalletTransferIntent>& Intents)
+{
+	TArray<TArray<uint8>> Results;
+	Results.SetNum(Intents.Num());
+	const TArray<FHazeSignerView> Signers = SignersFor(Pool, Intents);
+	ParallelFor(Intents.Num(), [&](int32 Index)
+	{
+		const FHazeWalletTransferIntent& I = Intents[Index];
+		const FHazeSignerView& Signer = Signers[Index];
+		if (!Signer.IsValid()) return;
+		Results[Index] = SignTransferBinary(Signer, Signer.GetPublicKey(), I.ToAddressHex, I.Amount, I.Fee, I.Nonce, I.ChainId, I.ValidUntilHeight);
+	}, BatchFlags(Intents.Num()));
+	return Results;
+}
+
+TArray<TArray<uint8>> FTransactionBuilder::BuildSignedMistbornBatchBinary(
+	UHazeKeyPair* KeyPair,
+	const TArray<FHazeMistbornCreateIntent>& Intents)
+{
+	TArray<TArray<uint8>> Results;
+	Results.SetNum(Intents.Num());
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return Results;
+
+	const TArray<uint8>& FromAddress = KeyPair->PublicKey;
+	ParallelFor(Intents.Num(), [&](int32 Index)
+	{
+		const FHazeMistbornCreateIntent& I = Intents[Index];
+		Results[Index] = SignMistbornCreateBinary(*Signer, FromAddress, I.AssetIdHex, I.Density, I.Metadata, I.GameId, I.Fee, I.Nonce, I.ChainId, I.ValidUntilHeight);
+	}, BatchFlags(Intents.Num()));
+	return Results;
+}
+
+FString FTransactionBuilder::TransferHash(const FString& TransactionJson)
+{
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<TCHAR>::Create(TransactionJson), Root) || !Root.IsValid()) return FString();
+	const TSharedPtr<FJsonObject>* Transfer = nullptr;
+	if (Root->Values.Num() != 1 || !Root->TryGetObjectField(TEXT("Transfer"), Transfer)) return FString();
+
+	uint8 From[32];
+	uint8 To[32];
+	FString FromHex, ToHex, SignatureHex;
+	TOptional<uint64> Amount, Fee, Nonce, ChainId, ValidUntilHeight;
+	if (!(*Transfer)->TryGetStringField(TEXT("from"), FromHex) || !FHazeHex::Decode(FromHex, From, 32)
+		|| !(*Transfer)->TryGetStringField(TEXT("to"), ToHex) || !FHazeHex::Decode(ToHex, To, 32)
+		|| !(*Transfer)->TryGetStringField(TEXT("signature"), SignatureHex)
+		|| !ReadU64(**Transfer, TEXT("amount"), Amount) || !ReadU64(**Transfer, TEXT("fee"), Fee) || !ReadU64(**Transfer, TEXT("nonce"), Nonce)
+		|| !ReadU64(**Transfer, TEXT("chain_id"), ChainId) || !ReadU64(**Transfer, TEXT("valid_until_height"), ValidUntilHeight)
+		|| !Amount.IsSet() || !Fee.IsSet() || !Nonce.IsSet())
+	{
+		return FString();
 	}
+	const TArray<uint8> Signature = FHazeHex::ToBytes(SignatureHex);
+	if (Signature.Num() == 0) return FString();
 
-	// Metadata JSON object
-	FString MetaJson;
-	for (const auto& Pair : Metadata)
+	TArray<uint8> Encoded;
+	Encoded.Reserve(MaxTransferBinarySize);
+	FHazeBincodeWriter W(Encoded);
+	W.WriteVariant(TransferVariant);
+	W.WriteFixed(MakeArrayView(From));
+	W.WriteFixed(MakeArrayView(To));
+	W.WriteU64(Amount.GetValue());
+	W.WriteU64(Fee.GetValue());
+	W.WriteU64(Nonce.GetValue());
+	W.WriteOptionU64(ChainId);
+	W.WriteOptionU64(ValidUntilHeight);
+	W.WriteBytes(Signature);
+	return FHazeSha256::HashHex(Encoded);
+}
+
+bool FTransactionBuilder::WriteSignedTransferRequest(
+	TArray<uint8>& OutBody,
+	UHazeKeyPair* KeyPair,
+	const FString& ToAddressHex,
+	uint64 Amount,
+	uint64 Fee,
+	uint64 Nonce,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	OutBody.Reset();
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return false;
+
+	OutBody.Reserve(MaxTransferJsonSize + 20);
+	FHazeJsonWriter W(OutBody);
+	W.BeginObject();
+	W.Key(TEXT("transaction"));
+	if (!WriteTransfer(W, *Signer, KeyPair->PublicKey, ToAddressHex, Amount, Fee, Nonce, ChainId, ValidUntilHeight))
 	{
-		if (MetaJson.Len()) MetaJson += TEXT(",");
-		MetaJson += FString::Printf(TEXT("\"%s\":\"%s\""), *Pair.Key.Replace(TEXT("\""), TEXT("\\\"")), *Pair.Value.Replace(TEXT("\""), TEXT("\\\"")));
+		OutBody.Reset();
+		return false;
 	}
-	FString DataJson = FString::Printf(TEXT("\"density\":\"%s\",\"metadata\":{%s},\"attributes\":[],\"game_id\":%s,\"owner\":\"%s\""),
-		DensityStr, *MetaJson, GameId.IsEmpty() ? TEXT("null") : *FString::Printf(TEXT("\"%s\""), *GameId), *FromHex);
+	W.EndObject();
+	return true;
+}
+
+bool FTransactionBuilder::WriteSignedMistbornCreateRequest(
+	TArray<uint8>& OutBody,
+	UHazeKeyPair* KeyPair,
+	const FString& AssetIdHex,
+	EDensityLevel Density,
+	const TMap<FString, FString>& Metadata,
+	const FString& GameId,
+	uint64 Fee,
+	uint64 Nonce,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	OutBody.Reset();
+	const TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer = SignerFor(KeyPair);
+	if (!Signer) return false;
 
-	return FString::Printf(TEXT("{\"MistbornAsset\":{\"from\":\"%s\",\"action\":\"Create\",\"asset_id\":\"%s\",\"data\":{%s},\"fee\":%llu,\"nonce\":%llu,\"signature\":\"%s\"}}"),
-		*FromHex, *AssetIdHex.TrimStartAndEnd(), *DataJson, Fee, Nonce, *SigHex);
+	OutBody.Reserve(MistbornJsonSize(Metadata, GameId) + 20);
+	FHazeJsonWriter W(OutBody);
+	W.BeginObject();
+	W.Key(TEXT("transaction"));
+	if (!WriteMistbornCreate(W, *Signer, KeyPair->PublicKey, AssetIdHex, Density, Metadata, GameId, Fee, Nonce, ChainId, ValidUntilHeight))
+	{
+		OutBody.Reset();
+		return false;
+	}
+	W.EndObject();
+	return true;
 }
@@ -1,47 +1,86 @@
 // Copyright HAZE Blockchain. Canonical payload construction.
 
 #include "TransactionSigning.h"
-#include "Misc/Parse.h"
+#include "HazeHex.h"
+#include "HazeStats.h"
 
-void FTransactionSigning::AppendChainFields(TArray<uint8>& Payload, TOptional<uint64> ChainId, TOptional<uint64> ValidUntilHeight)
+static_assert(FHazeTransferPayloadLayout::BaseSize == 96, "Transfer payload must match Rust get_transaction_data_for_signing");
+static_assert(FHazeMistbornPayloadLayout::HeaderSize == 111, "MistbornAsset header must match Rust get_transaction_data_for_signing");
+
+namespace
 {
-	if (ChainId.IsSet())
+	constexpr ANSICHAR TransferTag[] = "Transfer";
+	constexpr ANSICHAR MistbornTag[] = "MistbornAsset";
+	static_assert(sizeof(TransferTag) - 1 == FHazeTransferPayloadLayout::TagSize, "Transfer tag size");
+	static_assert(sizeof(MistbornTag) - 1 == FHazeMistbornPayloadLayout::TagSize, "MistbornAsset tag size");
+
+	/** Explicit little-endian store, independent of host byte order. */
+	FORCEINLINE uint8* StoreLE64(uint8* P, uint64 V)
+	{
+		for (int32 i = 0; i < 8; i++)
+		{
+			P[i] = static_cast<uint8>(V >> (i * 8));
+		}
+		return P + 8;
+	}
+
+	FORCEINLINE uint8* StoreBytes(uint8* P, const void* Src, int32 Len)
 	{
-		uint64 C = ChainId.GetValue();
-		Payload.Append(reinterpret_cast<uint8*>(&C), sizeof(uint64));
+		FMemory::Memcpy(P, Src, Len);
+		return P + Len;
 	}
-	if (ValidUntilHeight.IsSet())
+
+	FORCEINLINE int32 ChainFieldsSize(const TOptional<uint64>& ChainId, const TOptional<uint64>& ValidUntilHeight)
 	{
-		uint64 V = ValidUntilHeight.GetValue();
-		Payload.Append(reinterpret_cast<uint8*>(&V), sizeof(uint64));
+		return (ChainId.IsSet() ? 8 : 0) + (ValidUntilHeight.IsSet() ? 8 : 0);
+	}
+
+	FORCEINLINE uint8* StoreChainFields(uint8* P, const TOptional<uint64>& ChainId, const TOptional<uint64>& ValidUntilHeight)
+	{
+		if (ChainId.IsSet()) P = StoreLE64(P, ChainId.GetValue());
+		if (ValidUntilHeight.IsSet()) P = StoreLE64(P, ValidUntilHeight.GetValue());
+		return P;
 	}
 }
 
-TArray<uint8> FTransactionSigning::BuildTransferPayload(
-	const TArray<uint8>& FromAddress,
-	const TArray<uint8>& ToAddress,
+void FTransactionSigning::AppendChainFields(TArray<uint8>& Payload, TOptional<uint64> ChainId, TOptional<uint64> ValidUntilHeight)
+{
+	const int32 Offset = Payload.Num();
+	Payload.AddUninitialized(ChainFieldsSize(ChainId, ValidUntilHeight));
+	StoreChainFields(Payload.GetData() + Offset, ChainId, ValidUntilHeight);
+}
+
+int32 FTransactionSigning::WriteTransferPayload(
+	uint8* Out,
+	TArrayView<const uint8> FromAddress,
+	TArrayView<const uint8> ToAddress,
 	uint64 Amount,
 	uint64 Fee,
 	uint64 Nonce,
 	TOptional<uint64> ChainId,
 	TOptional<uint64> ValidUntilHeight)
 {
-	TArray<uint8> Data;
-	Data.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8("Transfer")), 8);
-	if (FromAddress.Num() >= 32) Data.Append(FromAddress.GetData(), 32);
-	if (ToAddress.Num() >= 32) Data.Append(ToAddress.GetData(), 32);
-	Data.Append(reinterpret_cast<uint8*>(&Amount), sizeof(uint64));
-	Data.Append(reinterpret_cast<uint8*>(&Fee), sizeof(uint64));
-	Data.Append(reinterpret_cast<uint8*>(&Nonce), sizeof(uint64));
-	AppendChainFields(Data, ChainId, ValidUntilHeight);
-	return Data;
+	HAZE_SCOPE(STAT_HazeBuildPayload, HazeBuildPayload);
+	using L = FHazeTransferPayloadLayout;
+	if (FromAddress.Num() < L::AddressSize || ToAddress.Num() < L::AddressSize) return 0;
+
+	StoreBytes(Out + L::TagOffset, TransferTag, L::TagSize);
+	StoreBytes(Out + L::FromOffset, FromAddress.GetData(), L::AddressSize);
+	StoreBytes(Out + L::ToOffset, ToAddress.GetData(), L::AddressSize);
+	StoreLE64(Out + L::AmountOffset, Amount);
+	StoreLE64(Out + L::FeeOffset, Fee);
+	StoreLE64(Out + L::NonceOffset, Nonce);
+	uint8* End = StoreChainFields(Out + L::BaseSize, ChainId, ValidUntilHeight);
+	return static_cast<int32>(End - Out);
 }
 
-TArray<uint8> FTransactionSigning::BuildMistbornAssetPayload(
-	const TArray<uint8>& FromAddress,
+int32 FTransactionSigning::WriteMistbornAssetPayload(
+	uint8* Out,
+	int32 Capacity,
+	TArrayView<const uint8> FromAddress,
 	EAssetAction Action,
-	const TArray<uint8>& AssetId,
-	const TArray<uint8>& DataOwner,
+	TArrayView<const uint8> AssetId,
+	TArrayView<const uint8> DataOwner,
 	EDensityLevel Density,
 	uint64 Fee,
 	uint64 Nonce,
@@ -49,44 +88,73 @@ TArray<uint8> FTransactionSigning::BuildMistbornAssetPayload(
 	TOptional<uint64> ChainId,
 	TOptional<uint64> ValidUntilHeight)
 {
-	TArray<uint8> Data;
-	Data.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8("MistbornAsset")), 13);
-	if (FromAddress.Num() >= 32) Data.Append(FromAddress.GetData(), 32);
-	uint8 ActionByte = static_cast<uint8>(Action);
-	Data.Add(ActionByte);
-	if (AssetId.Num() >= 32) Data.Append(AssetId.GetData(), 32);
-	if (DataOwner.Num() >= 32) Data.Append(DataOwner.GetData(), 32);
-	uint8 DensityByte = static_cast<uint8>(Density);
-	Data.Add(DensityByte);
+	HAZE_SCOPE(STAT_HazeBuildPayload, HazeBuildPayload);
+	using L = FHazeMistbornPayloadLayout;
+	if (FromAddress.Num() < L::AddressSize || AssetId.Num() < L::AddressSize || DataOwner.Num() < L::AddressSize) return 0;
 
+	uint8 OtherAssetId[L::MergeExtraSize];
+	bool bHasOther = false;
 	if (Action == EAssetAction::Merge)
 	{
 		const FString* OtherId = MetadataMergeSplit.Find(TEXT("_other_asset_id"));
-		if (OtherId && OtherId->Len() >= 64)
-		{
-			// Decode hex to 32 bytes and append
-			TArray<uint8> OtherBytes;
-			OtherBytes.SetNum(32);
-			for (int32 i = 0; i < 32; i++)
-			{
-				int32 A = FParse::HexDigit((*OtherId)[i * 2]);
-				int32 B = FParse::HexDigit((*OtherId)[i * 2 + 1]);
-				OtherBytes[i] = static_cast<uint8>((A << 4) | B);
-			}
-			Data.Append(OtherBytes);
-		}
-	}
-	if (Action == EAssetAction::Split)
-	{
-		const FString* Components = MetadataMergeSplit.Find(TEXT("_components"));
-		if (Components)
-		{
-			Data.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8(**Components)), Components->Len());
-		}
+		// Rust appends it only when it is exactly 32 bytes of valid hex
+		bHasOther = OtherId && FHazeHex::Decode(*OtherId, OtherAssetId, L::MergeExtraSize);
 	}
 
-	Data.Append(reinterpret_cast<uint8*>(&Fee), sizeof(uint64));
-	Data.Append(reinterpret_cast<uint8*>(&Nonce), sizeof(uint64));
-	AppendChainFields(Data, ChainId, ValidUntilHeight);
+	const FString* Components = Action == EAssetAction::Split ? MetadataMergeSplit.Find(TEXT("_components")) : nullptr;
+	// Components are signed as UTF-8 bytes, so size them after conversion (not FString::Len)
+	FTCHARToUTF8 ComponentsUtf8(Components ? **Components : TEXT(""));
+	const int32 ComponentsLen = Components ? ComponentsUtf8.Length() : 0;
+
+	const int32 Size = L::HeaderSize + (bHasOther ? L::MergeExtraSize : 0) + ComponentsLen
+		+ 2 * L::U64Size + ChainFieldsSize(ChainId, ValidUntilHeight);
+	if (Size > Capacity || !Out) return Size;
+
+	StoreBytes(Out + L::TagOffset, MistbornTag, L::TagSize);
+	StoreBytes(Out + L::FromOffset, FromAddress.GetData(), L::AddressSize);
+	Out[L::ActionOffset] = static_cast<uint8>(Action);
+	StoreBytes(Out + L::AssetIdOffset, AssetId.GetData(), L::AddressSize);
+	StoreBytes(Out + L::OwnerOffset, DataOwner.GetData(), L::AddressSize);
+	Out[L::DensityOffset] = static_cast<uint8>(Density);
+
+	uint8* P = Out + L::HeaderSize;
+	if (bHasOther) P = StoreBytes(P, OtherAssetId, L::MergeExtraSize);
+	if (ComponentsLen > 0) P = StoreBytes(P, ComponentsUtf8.Get(), ComponentsLen);
+	P = StoreLE64(P, Fee);
+	P = StoreLE64(P, Nonce);
+	P = StoreChainFields(P, ChainId, ValidUntilHeight);
+	check(P - Out == Size);
+	return Size;
+}
+
+TArray<uint8> FTransactionSigning::BuildTransferPayload(
+	TArrayView<const uint8> FromAddress,
+	TArrayView<const uint8> ToAddress,
+	uint64 Amount,
+	uint64 Fee,
+	uint64 Nonce,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	TArray<uint8> Data;
+	BuildTransferPayloadInto(Data, FromAddress, ToAddress, Amount, Fee, Nonce, ChainId, ValidUntilHeight);
+	return Data;
+}
+
+TArray<uint8> FTransactionSigning::BuildMistbornAssetPayload(
+	TArrayView<const uint8> FromAddress,
+	EAssetAction Action,
+	TArrayView<const uint8> AssetId,
+	TArrayView<const uint8> DataOwner,
+	EDensityLevel Density,
+	uint64 Fee,
+	uint64 Nonce,
+	const TMap<FString, FString>& MetadataMergeSplit,
+	TOptional<uint64> ChainId,
+	TOptional<uint64> ValidUntilHeight)
+{
+	TArray<uint8> Data;
+	BuildMistbornAssetPayloadInto(Data, FromAddress, Action, AssetId, DataOwner, Density, Fee, Nonce,
+		MetadataMergeSplit, ChainId, ValidUntilHeight);
 	return Data;
 }
@@ -0,0 +1,160 @@
+// Copyright HAZE Blockchain. Optimistic balances: pending transfers projected over the node's last account state.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeClient.h"
+#include "HazeAccountLedger.generated.h"
+
+class UHazeEventStream;
+class UHazeChainFollower;
+class UHazeTxSubmitter;
+struct FHazeReceipt;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeProjectedBalanceDelegate, const FString&, Address, const FHazeAmount&, ProjectedBalance);
+
+/**
+ * Per watched address: the last FAccountInfo fetched from the node plus every pending transfer touching it, so a
+ * HUD reads the balance the player will have (GetProjectedBalance) at once and without a request.
+ *
+ *   Ledger->Watch(Address);
+ *   Ledger->BindEventStream(Stream);        // or BindChainFollower
+ *   Ledger->SubmitTransfer(Submitter, TxJson, Address, To, Amount, Fee, OnDone);
+ *
+ * An entry is projected from the moment it is added. Rejected or dropped submissions roll it back. Once its
+ * transaction is seen in a block (block_applied or a chain follower receipt), each watched account it touches is
+ * refetched, and the entry stops counting for that account when a fetch sent after the block answers. Balances
+ * touched by anyone else's transactions are refetched on block_applied as well. Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeAccountLedger : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a ledger that fetches accounts through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger", meta = (DisplayName = "Create Haze Account Ledger"))
+	static UHazeAccountLedger* CreateAccountLedger(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Ledger")
+	TObjectPtr<UHazeClient> Client;
+
+	/** A watched address's projected balance changed (pending entry added, settled or rolled back, or account fetched) */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Ledger")
+	FHazeProjectedBalanceDelegate OnBalanceChanged;
+
+	/** Keep a projected balance for Address (fetches its account) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void Watch(const FString& Address);
+
+	/** Forget Address and its pending entries */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void Unwatch(const FString& Address);
+
+	/** Refetch an account (the ledger does this itself after blocks; for anything else) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void Refresh(const FString& Address);
+
+	/** Settle entries from block_applied events and refetch watched accounts they touch; subscribes Stream to them */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void BindEventStream(UHazeEventStream* Stream);
+
+	/** Settle entries from a chain follower's receipts (every entry with a hash is tracked on it) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void BindChainFollower(UHazeChainFollower* InFollower);
+
+	/** Confirmed balance plus pending incoming minus pending outgoing (amount and fee); zero if not watched */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Ledger")
+	FHazeAmount GetProjectedBalance(const FString& Address) const;
+
+	/** Next nonce after the pending outgoing transfers */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Ledger")
+	int64 GetProjectedNonce(const FString& Address) const;
+
+	/** The node's account as last fetched. False until the first fetch answered. */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Ledger")
+	bool GetConfirmedAccount(const FString& Address, FAccountInfo& OutInfo) const;
+
+	/** Pending entries counted in Address's projection */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Ledger")
+	int32 GetPendingCount(const FString& Address) const;
+
+	/**
+	 * Project a transfer before it is sent: From is debited Amount + Fee, To credited Amount (whichever is watched).
+	 * Returns the entry id for SetTransactionHash / Fail, or 0 if neither address is watched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	int64 AddPendingTransfer(const FString& From, const FString& To, const FHazeAmount& Amount, const FHazeAmount& Fee);
+
+	/** The node accepted the entry's transaction under TxHash */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void SetTransactionHash(int64 EntryId, const FString& TxHash);
+
+	/** The entry's transaction was rejected or abandoned: roll it back */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Ledger")
+	void Fail(int64 EntryId);
+
+	/** C++: AddPendingTransfer, then Submitter->Submit, with the hash set or the entry rolled back from the answer */
+	bool SubmitTransfer(UHazeTxSubmitter* Submitter, const FString& TransactionJson, const FString& From, const FString& To,
+		const FHazeAmount& Amount, const FHazeAmount& Fee, FHazeOnTransaction OnComplete, TOptional<uint64> Nonce = TOptional<uint64>());
+
+	/** C++: the transaction is in a block; its entry settles with the next account fetch */
+	void MarkIncluded(const FString& TxHash);
+
+	/** C++: the transaction's block was replaced; its entry counts again until it is included anew */
+	void MarkReverted(const FString& TxHash);
+
+	/** C++: an account fetched now, as Refresh would deliver it */
+	void ApplyAccount(const FString& Address, const FAccountInfo& Info);
+
+private:
+	struct FEntry
+	{
+		FString TxHash;
+		/** Watched accounts still counting this entry */
+		TArray<FString> Accounts;
+		/** Clock when last seen in a block, or 0 */
+		uint64 IncludedAt = 0;
+		/** TrackTransactionNative handle on BoundFollower, or 0 */
+		uint64 FollowerListener = 0;
+	};
+
+	struct FDelta
+	{
+		int64 EntryId = 0;
+		FHazeAmount Credit;
+		FHazeAmount Debit;
+		bool bOutgoing = false;
+	};
+
+	struct FAccount
+	{
+		FAccountInfo Confirmed;
+		bool bLoaded = false;
+		TArray<FDelta> Pending;
+		bool bFetching = false;
+		/** Clock when the fetch in flight was sent */
+		uint64 RequestedAt = 0;
+		/** Another fetch is needed once the one in flight answers (it may predate a block) */
+		bool bRefetch = false;
+	};
+
+	static FString KeyFor(const FString& Address);
+
+	void AddDelta(const FString& Key, int64 EntryId, const FHazeAmount& Credit, const FHazeAmount& Debit, bool bOutgoing);
+	/** Apply an account fetched at RequestedAt; settles entries included before then */
+	void ApplyFetched(const FString& Key, const FAccountInfo& Info, uint64 RequestedAt);
+	void RemoveEntry(int64 EntryId);
+	void RefreshEntryAccounts(const FEntry& Entry);
+	void Broadcast(const FString& Key);
+
+	void HandleStreamEvent(const FHazeStreamEvent& Event);
+	void TrackOnFollower(int64 EntryId);
+
+	TMap<FString, FAccount> Accounts;
+	TMap<int64, FEntry> Entries;
+	TMap<FString, int64> EntryByHash;
+	int64 NextEntryId = 1;
+	/** Orders inclusions against account fetches */
+	uint64 Clock = 0;
+	TWeakObjectPtr<UHazeChainFollower> BoundFollower;
+};
@@ -0,0 +1,70 @@
+// Copyright HAZE Blockchain. Local constant-product swap quotes, matching the node's pool math.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeTypes.h"
+#include "HazeAmm.generated.h"
+
+UENUM(BlueprintType)
+enum class EHazeSwapQuoteStatus : uint8
+{
+	Ok = 0,
+	/** Pool not known (not fetched yet, or no pool for the pair) */
+	UnknownPool = 1,
+	/** AssetIn is neither side of the pool */
+	AssetNotInPool = 2,
+	/** The swap would pay out nothing (input too small), or a wanted output is not reachable */
+	InsufficientLiquidity = 3,
+	/** Outside what the node's 64-bit math accepts (amount * fee rate or the new reserve overflows, fee over 100%) */
+	OutOfRange = 4
+};
+
+/** Result of a swap quote, in base units. The node executes the same swap to the unit while the reserves are unchanged. */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeSwapQuote
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) EHazeSwapQuoteStatus Status = EHazeSwapQuoteStatus::UnknownPool;
+	UPROPERTY(BlueprintReadOnly) FString PoolId;
+	UPROPERTY(BlueprintReadOnly) FString AssetIn;
+	UPROPERTY(BlueprintReadOnly) FString AssetOut;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount AmountIn;
+	/** AmountIn * FeeRate / 10000, kept by the pool */
+	UPROPERTY(BlueprintReadOnly) FHazeAmount Fee;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount AmountOut;
+	/** Reserves after the swap, on the input and output side */
+	UPROPERTY(BlueprintReadOnly) FHazeAmount NewReserveIn;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount NewReserveOut;
+	/** 1 - execution price / spot price, fee included (0.01 = 1% worse than spot) */
+	UPROPERTY(BlueprintReadOnly) float PriceImpact = 0.f;
+
+	bool IsValid() const { return Status == EHazeSwapQuoteStatus::Ok; }
+};
+
+/**
+ * FogEconomy::swap_assets (src/economy.rs) without the round trip, for previews and slippage limits:
+ *
+ *   fee = amount_in * fee_rate / 10000, new_in = reserve_in + amount_in - fee,
+ *   new_out = reserve_in * reserve_out / new_in, amount_out = reserve_out - new_out
+ *
+ * with the node's floor division and 64-bit limits. Does not allocate beyond the quote's strings.
+ */
+struct HAZEBLOCKCHAIN_API FHazeAmm
+{
+	/** fee_rate is in basis points */
+	static constexpr int32 FeeDenominator = 10000;
+
+	/** Swap AmountIn of AssetIn through Pool. Asset1 is matched first, as on the node. */
+	static EHazeSwapQuoteStatus QuoteExactIn(const FLiquidityPool& Pool, const FString& AssetIn, const FHazeAmount& AmountIn, FHazeSwapQuote& Out);
+
+	/** The same on bare reserves; Out's pool and asset fields are left alone */
+	static EHazeSwapQuoteStatus QuoteExactIn(const FHazeAmount& ReserveIn, const FHazeAmount& ReserveOut, int32 FeeRate,
+		const FHazeAmount& AmountIn, FHazeSwapQuote& Out);
+
+	/** Smallest AmountIn whose exact-in quote pays at least AmountOut (searched over QuoteExactIn, so rounding agrees) */
+	static EHazeSwapQuoteStatus QuoteExactOut(const FLiquidityPool& Pool, const FString& AssetIn, const FHazeAmount& AmountOut, FHazeSwapQuote& Out);
+
+	/** Move Pool's reserves as the node does when the quoted swap executes (no-op for an invalid quote) */
+	static void ApplyQuote(FLiquidityPool& Pool, const FHazeSwapQuote& Quote);
+};
@@ -0,0 +1,102 @@
+// Copyright HAZE Blockchain. Unsigned 128-bit token amount (balances, supply, pool reserves).
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeAmount.generated.h"
+
+/**
+ * Unsigned 128-bit integer in base units, decoded straight from the node's JSON numbers and decimal strings.
+ * Wide enough for balances, supply and AMM products (reserve1 * reserve2) without rounding through double.
+ * C++ operators wrap modulo 2^128 like built-in unsigned types; use the Try* functions when overflow matters.
+ * Blueprints go through UHazeAmountLibrary, whose operators saturate instead.
+ */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeAmount
+{
+	GENERATED_BODY()
+
+	/** Decimal digits of the largest value (340282366920938463463374607431768211455) */
+	static constexpr int32 MaxDigits = 39;
+
+	UPROPERTY()
+	uint64 Low = 0;
+
+	UPROPERTY()
+	uint64 High = 0;
+
+	FHazeAmount() = default;
+	explicit FHazeAmount(uint64 InLow) : Low(InLow) {}
+	static FHazeAmount FromParts(uint64 InHigh, uint64 InLow) { FHazeAmount A; A.High = InHigh; A.Low = InLow; return A; }
+	static FHazeAmount MaxValue() { return FromParts(MAX_uint64, MAX_uint64); }
+
+	/** Decimal digits only (no sign, whitespace or exponent). False, with Out unchanged, if empty, invalid or over 2^128-1. */
+	static bool Parse(FStringView Text, FHazeAmount& Out);
+
+	/** Write the decimal digits into Out (at least MaxDigits chars, not terminated); returns how many. Does not allocate. */
+	int32 ToChars(TCHAR* Out) const;
+	void AppendTo(FString& Out) const;
+	FString ToString() const;
+
+	/**
+	 * Base units as a decimal token amount: Decimals places of fraction (18 for HAZE), truncated after
+	 * MaxFractionDigits and without trailing zeros. 1234500000000000000 -> "1.2345".
+	 */
+	FString ToDisplayString(int32 Decimals = 18, int32 MaxFractionDigits = 4) const;
+
+	bool IsZero() const { return (Low | High) == 0; }
+	bool FitsUint64() const { return High == 0; }
+	/** Low 64 bits, or MAX_uint64 if the value does not fit */
+	uint64 ToUint64Clamped() const { return High ? MAX_uint64 : Low; }
+	/** Nearest double, for ratios and progress bars; never for arithmetic on balances */
+	double ToDouble() const { return static_cast<double>(High) * 18446744073709551616.0 + static_cast<double>(Low); }
+
+	/** Checked arithmetic: false on overflow, underflow or division by zero (Out is then unspecified) */
+	static bool TryAdd(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& Out);
+	static bool TrySubtract(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& Out);
+	static bool TryMultiply(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& Out);
+	/** Quotient and remainder in one pass */
+	static bool TryDivide(const FHazeAmount& A, const FHazeAmount& B, FHazeAmount& OutQuotient, FHazeAmount& OutRemainder);
+
+	FHazeAmount& operator+=(const FHazeAmount& B)
+	{
+		const uint64 Sum = Low + B.Low;
+		High += B.High + (Sum < Low ? 1 : 0);
+		Low = Sum;
+		return *this;
+	}
+
+	FHazeAmount& operator-=(const FHazeAmount& B)
+	{
+		const uint64 Diff = Low - B.Low;
+		High -= B.High + (Low < B.Low ? 1 : 0);
+		Low = Diff;
+		return *this;
+	}
+
+	FHazeAmount& operator*=(const FHazeAmount& B);
+	/** Division by zero yields zero */
+	FHazeAmount& operator/=(const FHazeAmount& B);
+	FHazeAmount& operator%=(const FHazeAmount& B);
+
+	friend FHazeAmount operator+(FHazeAmount A, const FHazeAmount& B) { return A += B; }
+	friend FHazeAmount operator-(FHazeAmount A, const FHazeAmount& B) { return A -= B; }
+	friend FHazeAmount operator*(FHazeAmount A, const FHazeAmount& B) { return A *= B; }
+	friend FHazeAmount operator/(FHazeAmount A, const FHazeAmount& B) { return A /= B; }
+	friend FHazeAmount operator%(FHazeAmount A, const FHazeAmount& B) { return A %= B; }
+
+	friend bool operator==(const FHazeAmount& A, const FHazeAmount& B) { return A.Low == B.Low && A.High == B.High; }
+	friend bool operator!=(const FHazeAmount& A, const FHazeAmount& B) { return !(A == B); }
+	friend bool operator<(const FHazeAmount& A, const FHazeAmount& B) { return A.High != B.High ? A.High < B.High : A.Low < B.Low; }
+	friend bool operator>(const FHazeAmount& A, const FHazeAmount& B) { return B < A; }
+	friend bool operator<=(const FHazeAmount& A, const FHazeAmount& B) { return !(B < A); }
+	friend bool operator>=(const FHazeAmount& A, const FHazeAmount& B) { return !(A < B); }
+
+	friend uint32 GetTypeHash(const FHazeAmount& A) { return HashCombine(GetTypeHash(A.Low), GetTypeHash(A.High)); }
+};
+
+template <>
+struct TStructOpsTypeTraits<FHazeAmount> : public TStructOpsTypeTraitsBase2<FHazeAmount>
+{
+	enum { WithIdenticalViaEquality = true };
+};
@@ -0,0 +1,84 @@
+// Copyright HAZE Blockchain. Blueprint operators and conversions for FHazeAmount.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "HazeAmount.h"
+#include "HazeAmountLibrary.generated.h"
+
+/**
+ * HAZE Amount math for Blueprints. Add and Multiply saturate at the maximum, Subtract stops at zero and
+ * Divide by zero returns zero, so a HUD never shows a wrapped balance.
+ */
+UCLASS()
+class HAZEBLOCKCHAIN_API UHazeAmountLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+public:
+	/** Parse base units from decimal digits (a node balance string). False and zero if invalid or too large. */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Parse Amount"))
+	static bool ParseAmount(const FString& Text, FHazeAmount& Amount);
+
+	/** Negative values become zero */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "To Amount (Integer64)", CompactNodeTitle = "->", BlueprintAutocast))
+	static FHazeAmount Conv_Int64ToHazeAmount(int64 Value);
+
+	/** Base units as decimal digits */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "To String (Amount)", CompactNodeTitle = "->", BlueprintAutocast))
+	static FString Conv_HazeAmountToString(const FHazeAmount& Amount);
+
+	/** Clamped to the int64 range (e.g. for Build Signed Transfer) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "To Integer64 (Amount)"))
+	static int64 ToInt64(const FHazeAmount& Amount);
+
+	/** Approximate value, for ratios and progress bars */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "To Float (Amount)"))
+	static double ToFloat(const FHazeAmount& Amount);
+
+	/** Token amount for display: Decimals places (18 for HAZE), at most MaxFractionDigits shown, trailing zeros trimmed */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "To Display String (Amount)"))
+	static FString ToDisplayString(const FHazeAmount& Amount, int32 Decimals = 18, int32 MaxFractionDigits = 4);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount + Amount", CompactNodeTitle = "+", Keywords = "+ add plus", CommutativeAssociativeBinaryOperator = "true"))
+	static FHazeAmount Add_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount - Amount", CompactNodeTitle = "-", Keywords = "- subtract minus"))
+	static FHazeAmount Subtract_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount * Amount", CompactNodeTitle = "*", Keywords = "* multiply", CommutativeAssociativeBinaryOperator = "true"))
+	static FHazeAmount Multiply_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount / Amount", CompactNodeTitle = "/", Keywords = "/ divide division"))
+	static FHazeAmount Divide_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount % Amount", CompactNodeTitle = "%", Keywords = "% modulus"))
+	static FHazeAmount Percent_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Equal (Amount)", CompactNodeTitle = "==", Keywords = "== equal"))
+	static bool EqualEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Not Equal (Amount)", CompactNodeTitle = "!=", Keywords = "!= not equal"))
+	static bool NotEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount < Amount", CompactNodeTitle = "<", Keywords = "< less"))
+	static bool Less_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount <= Amount", CompactNodeTitle = "<=", Keywords = "<= less"))
+	static bool LessEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount > Amount", CompactNodeTitle = ">", Keywords = "> greater"))
+	static bool Greater_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Amount >= Amount", CompactNodeTitle = ">=", Keywords = ">= greater"))
+	static bool GreaterEqual_HazeAmountHazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Min (Amount)", CompactNodeTitle = "MIN"))
+	static FHazeAmount Min_HazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Max (Amount)", CompactNodeTitle = "MAX"))
+	static FHazeAmount Max_HazeAmount(const FHazeAmount& A, const FHazeAmount& B);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Amount", meta = (DisplayName = "Is Zero (Amount)"))
+	static bool IsZero(const FHazeAmount& Amount);
+};
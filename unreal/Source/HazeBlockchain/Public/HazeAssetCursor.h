@@ -0,0 +1,99 @@
+// Copyright HAZE Blockchain. Paged asset search with next-page prefetch.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeClient.h"
+#include "HazeAssetPage.h"
+#include "HazeAssetCursor.generated.h"
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeAssetPageDelegate, bool, bSuccess, int32, Count);
+
+/** bOk is false on transport, HTTP or decode failure (Next can be called again to retry). Fires on the game thread. */
+using FHazeOnAssetPage = TFunction<void(bool bOk, const TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe>& Page)>;
+/** Fetches the page at Offset and reports it as UHazeClient::FetchAssetSearchPage does */
+using FHazeAssetSearchTransport = TFunction<void(const FHazeAssetSearchQuery& Query, int64 Offset, FHazeOnAssetSearchPage OnComplete)>;
+
+/**
+ * Walks the results of one search (UHazeClient::SearchAssets) page by page. Pages use the summary view and are
+ * decoded off the game thread into FHazeAssetPage columns. With bPrefetch, handing out a page starts the request
+ * for the next one, so an inventory screen that pages forward rarely waits. At most the current and the prefetched
+ * page are held by the cursor.
+ *
+ * Paging is by offset. The node orders ties by asset id so pages do not overlap, but assets created or changed
+ * between requests can still shift later pages.
+ *
+ * Game thread only; one Next at a time.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeAssetCursor : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** C++: a cursor over Query that fetches its pages through Transport instead of a client, e.g. in tests */
+	static UHazeAssetCursor* CreateAssetCursor(const FHazeAssetSearchQuery& Query, FHazeAssetSearchTransport Transport);
+
+	/** C++: deliver the next page. An empty page (bOk true) means the end was reached. */
+	void NextPage(FHazeOnAssetPage OnPage);
+
+	/** Blueprint: fetch the next page, then read it with the getters below */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Search")
+	void Next(const FHazeAssetPageDelegate& OnComplete);
+
+	/** False once a short page has been seen */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	bool HasMore() const { return !bExhausted || Prefetched.IsValid(); }
+
+	const FHazeAssetSearchQuery& GetQuery() const { return Query; }
+	/** The page last handed out (null before the first) */
+	TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe> GetCurrentPage() const { return Current; }
+
+	// Current page, Blueprint access by index
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	int32 GetCount() const { return Current ? Current->Num() : 0; }
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	FString GetAssetIdHex(int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	FString GetOwnerHex(int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	EDensityLevel GetDensity(int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	FString GetGameId(int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Search")
+	FString GetLabel(int32 Index) const;
+
+private:
+	friend class UHazeClient;
+
+	void Init(UHazeClient* InClient, const FHazeAssetSearchQuery& InQuery);
+	void Request();
+	void OnPageArrived(bool bOk, TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe> Page);
+	void Deliver(const TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe>& Page);
+	bool IsValidIndex(int32 Index) const { return Current && Index >= 0 && Index < Current->Num(); }
+
+	UPROPERTY()
+	TObjectPtr<UHazeClient> Client;
+	/** Used instead of Client when set */
+	FHazeAssetSearchTransport Transport;
+
+	FHazeAssetSearchQuery Query;
+	/** Offset of the next page to request */
+	int64 NextOffset = 0;
+	bool bExhausted = false;
+	bool bRequesting = false;
+	/** Scheduler ticket of the page request, so a Next joining a queued prefetch can promote it */
+	uint64 RequestTicket = 0;
+
+	TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe> Current;
+	TSharedPtr<const FHazeAssetPage, ESPMode::ThreadSafe> Prefetched;
+	/** Waiting for the page being requested */
+	FHazeOnAssetPage Waiting;
+	/** Game ids of every page of this search */
+	TSharedRef<FHazeStringTable> Strings = MakeShared<FHazeStringTable>();
+};
@@ -0,0 +1,97 @@
+// Copyright HAZE Blockchain. Compact column storage for asset search results.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeTypes.h"
+
+/** Interned strings, referenced by index. Used for the few distinct game ids shared by thousands of assets. */
+class HAZEBLOCKCHAIN_API FHazeStringTable
+{
+public:
+	/** Index of Value, adding it if new. The empty string is always INDEX_NONE. */
+	int32 Intern(const FString& Value);
+
+	/** Value at Index; empty for INDEX_NONE */
+	const FString& Get(int32 Index) const;
+
+	int32 Num() const { return Strings.Num(); }
+	SIZE_T GetAllocatedSize() const { return Strings.GetAllocatedSize() + Lookup.GetAllocatedSize(); }
+
+private:
+	TArray<FString> Strings;
+	TMap<FString, int32> Lookup;
+};
+
+/**
+ * One page of GET /api/v1/assets/search (summary view), stored as columns rather than one struct per asset:
+ * ids and owners as raw 32-byte values, densities as bytes, game ids interned, labels in one character pool.
+ * About 100 bytes per asset plus its label, with a fixed number of allocations per page.
+ *
+ * Pages are decoded off the game thread, then handed out read-only; UHazeAssetCursor makes the pages of one search
+ * share a string table so game ids compare by index across pages.
+ */
+class HAZEBLOCKCHAIN_API FHazeAssetPage
+{
+public:
+	static constexpr int32 IdSize = 32;
+
+	FHazeAssetPage();
+
+	int32 Num() const { return Densities.Num(); }
+	/** Position of entry 0 in the whole result */
+	int64 GetOffset() const { return Offset; }
+
+	TArrayView<const uint8> GetAssetId(int32 Index) const { return MakeArrayView(AssetIds.GetData() + Index * IdSize, IdSize); }
+	FString GetAssetIdHex(int32 Index) const;
+	TArrayView<const uint8> GetOwner(int32 Index) const { return MakeArrayView(Owners.GetData() + Index * IdSize, IdSize); }
+	EDensityLevel GetDensity(int32 Index) const { return static_cast<EDensityLevel>(Densities[Index]); }
+	/** Index into GetStrings(), or INDEX_NONE */
+	int32 GetGameIdIndex(int32 Index) const { return GameIdIndices[Index]; }
+	const FString& GetGameId(int32 Index) const { return Strings->Get(GameIdIndices[Index]); }
+	/** The metadata value under the query's LabelKey, or empty */
+	FStringView GetLabel(int32 Index) const { return FStringView(LabelChars.GetData() + LabelStarts[Index], LabelLengths[Index]); }
+	int64 GetCreatedAt(int32 Index) const { return CreatedAt[Index]; }
+	int64 GetUpdatedAt(int32 Index) const { return UpdatedAt[Index]; }
+	int32 GetAttributeCount(int32 Index) const { return AttributeCounts[Index]; }
+	int32 GetBlobCount(int32 Index) const { return BlobCounts[Index]; }
+
+	/** Entry whose id is AssetId, or INDEX_NONE */
+	int32 Find(TArrayView<const uint8> AssetId) const;
+
+	const FHazeStringTable& GetStrings() const { return *Strings; }
+	SIZE_T GetAllocatedSize() const;
+
+	// Building (decoder and cursor)
+
+	void SetOffset(int64 InOffset) { Offset = InOffset; }
+	void Reserve(int32 Count);
+	/** Append a blank entry (zero ids, no game id, empty label) and return its index */
+	int32 AddEntry();
+	uint8* GetMutableAssetId(int32 Index) { return AssetIds.GetData() + Index * IdSize; }
+	uint8* GetMutableOwner(int32 Index) { return Owners.GetData() + Index * IdSize; }
+	void SetDensity(int32 Index, EDensityLevel Density) { Densities[Index] = static_cast<uint8>(Density); }
+	void SetGameId(int32 Index, const FString& GameId) { GameIdIndices[Index] = Strings->Intern(GameId); }
+	/** Labels go into a shared pool; setting one again leaves the old characters unused */
+	void SetLabel(int32 Index, FStringView Label);
+	void SetTimes(int32 Index, int64 InCreatedAt, int64 InUpdatedAt) { CreatedAt[Index] = InCreatedAt; UpdatedAt[Index] = InUpdatedAt; }
+	void SetCounts(int32 Index, int32 Attributes, int32 Blobs) { AttributeCounts[Index] = Attributes; BlobCounts[Index] = Blobs; }
+
+	/** Move game ids into Table (remapping indices). Game thread, once per page, before the page is shared. */
+	void ShareStrings(const TSharedRef<FHazeStringTable>& Table);
+
+private:
+	int64 Offset = 0;
+	TArray<uint8> AssetIds;
+	TArray<uint8> Owners;
+	TArray<uint8> Densities;
+	TArray<int32> GameIdIndices;
+	TArray<int64> CreatedAt;
+	TArray<int64> UpdatedAt;
+	TArray<int32> AttributeCounts;
+	TArray<int32> BlobCounts;
+	TArray<TCHAR> LabelChars;
+	TArray<int32> LabelStarts;
+	TArray<int32> LabelLengths;
+	TSharedRef<FHazeStringTable> Strings;
+};
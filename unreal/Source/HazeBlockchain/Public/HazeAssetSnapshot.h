@@ -0,0 +1,253 @@
+// Copyright HAZE Blockchain. Pre-baked binary asset snapshots, memory-mapped for fast startup.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeClient.h"
+#include "HazeAssetSnapshot.generated.h"
+
+class FHazeMappedBlob;
+
+/** One entry of a POST /api/v1/snapshots/assets/stale answer */
+struct FHazeSnapshotStaleEntry
+{
+	FString AssetId;
+	/** The asset's current fingerprint; 0 if it was removed */
+	uint64 Fingerprint = 0;
+	/** The asset no longer exists */
+	bool bRemoved = false;
+};
+
+/** POST /api/v1/snapshots/assets/stale: the entries that changed, and the chain they were checked against */
+struct FHazeSnapshotStalePage
+{
+	FString StateRoot;
+	int64 CurrentHeight = 0;
+	TArray<FHazeSnapshotStaleEntry> Stale;
+};
+
+/** An asset as a snapshot stores it: the fields of the full view (no history or permissions) and its fingerprint */
+struct FHazeAssetSnapshotEntry
+{
+	FHazeAssetInfo Asset;
+	uint64 Fingerprint = 0;
+};
+
+/**
+ * A snapshot in the node's format (src/asset_snapshot.rs), read in place: a 128-byte header, 128-byte asset
+ * records sorted by asset id, fixed-size metadata / attribute / blob ref records and one interned UTF-8 string
+ * table, all little-endian. Opening touches only the header; Find is a binary search over the records and Read
+ * decodes one asset, so startup costs a file map rather than a parse of every asset.
+ *
+ * Open checks the header and that the sections it declares fit the file. Records are bounds-checked as they are
+ * read, so a corrupt entry fails its own Read without the file being scanned up front.
+ */
+class HAZEBLOCKCHAIN_API FHazeAssetSnapshot
+{
+public:
+	static constexpr int32 HeaderSize = 128;
+	static constexpr int32 AssetRecordSize = 128;
+	static constexpr uint32 FormatVersion = 1;
+
+	/** Map a snapshot file read-only. Null if it is missing, cannot be mapped or has an invalid header. */
+	static TUniquePtr<FHazeAssetSnapshot> Open(const FString& Path);
+
+	/** A snapshot held in memory (a fresh download). Null if the header is invalid. */
+	static TUniquePtr<FHazeAssetSnapshot> FromBytes(TArray<uint8> Bytes);
+
+	/** Header and section bounds check alone */
+	static bool IsValid(TArrayView<const uint8> Bytes);
+
+	/** Encode Entries (any order, distinct ids) as write_asset_snapshot does; empty if a state root or id is not 32-byte hex */
+	static TArray<uint8> Write(TArray<FHazeAssetSnapshotEntry> Entries, int64 Height, const FString& StateRootHex, int64 CreatedAt);
+
+	~FHazeAssetSnapshot();
+
+	int32 Num() const { return AssetCount; }
+	int64 GetHeight() const { return Height; }
+	int64 GetCreatedAt() const { return CreatedAt; }
+	/** State root the snapshot was taken at (lowercase hex) */
+	FString GetStateRootHex() const;
+
+	/** Index of an asset (hex id, either case), or INDEX_NONE */
+	int32 Find(FStringView AssetIdHex) const;
+
+	/** Lowercase hex id of the asset at Index (0 <= Index < Num) */
+	FString GetAssetId(int32 Index) const;
+
+	/** asset_fingerprint of the asset at Index, as the node computed it when the snapshot was taken */
+	uint64 GetFingerprint(int32 Index) const;
+
+	/** Decode the asset at Index. False if its records or strings point outside the file. */
+	bool Read(int32 Index, FHazeAssetInfo& OutAsset) const;
+
+	TArrayView<const uint8> GetView() const { return Bytes; }
+
+private:
+	FHazeAssetSnapshot() = default;
+
+	/** Read the header of Bytes into the section offsets */
+	bool ParseHeader();
+
+	bool ReadString(uint32 Id, FString& OutString) const;
+
+	TUniquePtr<FHazeMappedBlob> Mapping;
+	TArray<uint8> Owned;
+	TArrayView<const uint8> Bytes;
+
+	int32 AssetCount = 0;
+	uint32 MetadataCount = 0;
+	uint32 AttributeCount = 0;
+	uint32 BlobRefCount = 0;
+	uint32 StringCount = 0;
+	uint64 StringBytes = 0;
+	int64 Height = 0;
+	int64 CreatedAt = 0;
+	uint64 RecordsOffset = 0;
+	uint64 MetadataOffset = 0;
+	uint64 AttributesOffset = 0;
+	uint64 BlobRefsOffset = 0;
+	uint64 StringOffsetsOffset = 0;
+	uint64 StringBytesOffset = 0;
+};
+
+UENUM(BlueprintType)
+enum class EHazeSnapshotEntryStatus : uint8
+{
+	/** Not in the snapshot */
+	None = 0,
+	/** From a snapshot that has not been validated yet */
+	Unverified,
+	/** Matched the chain at the last validation */
+	Current,
+	/** Changed on chain; being refetched (the snapshot's copy is served until then) */
+	Stale,
+	/** No longer exists on chain */
+	Removed
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeSnapshotValidatedDelegate, bool, bSuccess, int32, RefreshedCount);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeSnapshotDownloadedDelegate, bool, bSuccess);
+
+/**
+ * A player's (or a game's) assets from a snapshot on disk, usable the moment the file is mapped and brought up to
+ * date lazily: Validate compares the snapshot's state root with the chain's and, when they differ, asks the node
+ * which entries changed (POST /api/v1/snapshots/assets/stale, by fingerprint) and refetches only those.
+ *
+ *   Store->Load(Path);                      // on startup, before any request
+ *   Client->GetBlockchainInfo(...);         // then, with the info: Store->Validate(Info)
+ *   Store->GetAsset(AssetId, Asset);        // served from the snapshot, or the refetched copy
+ *   Store->Save(Path);                      // on exit, so the next startup has less to refresh
+ *
+ * The state root covers every account and asset and the height, so it only matches when no block was applied
+ * since the snapshot; the per-asset fingerprints keep the refresh to the assets that actually changed. Download
+ * replaces the snapshot with a fresh one from GET /api/v1/snapshots/assets. Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeAssetSnapshotStore : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a store that fetches through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets", meta = (DisplayName = "Create Haze Asset Snapshot Store"))
+	static UHazeAssetSnapshotStore* CreateAssetSnapshotStore(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Assets")
+	TObjectPtr<UHazeClient> Client;
+
+	/** A Validate finished; RefreshedCount assets were refetched or found removed */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Assets")
+	FHazeSnapshotValidatedDelegate OnValidated;
+
+	/** A Download finished */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Assets")
+	FHazeSnapshotDownloadedDelegate OnDownloaded;
+
+	/** Saved/HazeSnapshots/<Name>.hazesnap */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	static FString GetDefaultPath(const FString& Name);
+
+	/** Map a snapshot file in place of whatever the store held. False (keeping it) if the file is missing or invalid. */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	bool Load(const FString& Path);
+
+	/** Fetch a new snapshot of OwnerHex's assets (or, with OwnerHex empty, GameId's), keep it in Path and load it */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void Download(const FString& OwnerHex, const FString& GameId, const FString& Path);
+
+	/** Bring the snapshot up to Info's state; a Validate already in flight runs once more when it finishes */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void Validate(const FBlockchainInfo& Info);
+
+	/**
+	 * Write the snapshot with the refetched and removed assets folded in, at the state of the last validation. The
+	 * store then reads the merged copy from memory, so Path may be the file Load mapped. False while validating.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	bool Save(const FString& Path);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	bool IsLoaded() const { return Snapshot.IsValid(); }
+
+	/** Assets in the snapshot, removed ones included */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	int32 Num() const { return Snapshot ? Snapshot->Num() : 0; }
+
+	/** State root the held assets are known to match (the snapshot's until a validation moves it) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	FString GetStateRoot() const { return StateRoot; }
+
+	/** The asset's latest known state. False if the snapshot does not hold it or it was removed. */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	bool GetAsset(const FString& AssetIdHex, FHazeAssetInfo& OutAsset) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	EHazeSnapshotEntryStatus GetStatus(const FString& AssetIdHex) const;
+
+	/** Ids of the assets not removed, in snapshot (id) order */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	TArray<FString> GetAssetIds() const;
+
+	/** C++: hold an in-memory snapshot, as Load does for a file. False if the header is invalid. */
+	bool LoadBytes(TArray<uint8> Bytes);
+
+	/** C++: apply a stale check, as Validate does; returns the entries to refetch (removals take effect at once) */
+	TArray<FHazeSnapshotStaleEntry> ApplyStalePage(const FHazeSnapshotStalePage& Page);
+
+	/** C++: adopt a refetched asset with its current fingerprint, as Validate does */
+	void ApplyRefreshed(const FHazeAssetInfo& Asset, uint64 Fingerprint);
+
+	/** C++: the mapped snapshot, for bulk reads (null when nothing is loaded) */
+	const FHazeAssetSnapshot* GetSnapshot() const { return Snapshot.Get(); }
+
+private:
+	/** Adopt Loaded (dropping everything learnt about the old snapshot) */
+	bool Adopt(TUniquePtr<FHazeAssetSnapshot> Loaded);
+
+	/** One round of stale checks finished; adopts Root if every batch saw the same one */
+	void FinishValidate();
+
+	TUniquePtr<FHazeAssetSnapshot> Snapshot;
+	/** Refetched assets by lowercase id, with their current fingerprint */
+	TMap<FString, FHazeAssetSnapshotEntry> Refreshed;
+	TSet<FString> Stale;
+	TSet<FString> Removed;
+	FString StateRoot;
+	int64 Height = 0;
+	bool bVerified = false;
+
+	/** Bumped by every Load, so completions for an older snapshot are dropped */
+	uint32 Generation = 0;
+	bool bValidating = false;
+	bool bValidateAgain = false;
+	FBlockchainInfo NextInfo;
+	int32 PendingRequests = 0;
+	int32 RefreshedThisRound = 0;
+	bool bRoundFailed = false;
+	bool bRootsAgree = true;
+	FString RoundRoot;
+	int64 RoundHeight = 0;
+
+	/** Query of the last Download, so its state root is only sent as If-None-Match for the same query */
+	FString DownloadedQuery;
+};
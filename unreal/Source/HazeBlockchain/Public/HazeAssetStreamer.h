@@ -0,0 +1,224 @@
+// Copyright HAZE Blockchain. Density-tiered, budgeted streaming of Mistborn assets.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HazeClient.h"
+#include "HazeAssetStreamer.generated.h"
+
+class FHazeMappedBlob;
+class UHazeEventStream;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeAssetTierDelegate, const FString&, AssetId, EDensityLevel, Tier);
+
+/** Fetches summaries and reports them as UHazeClient::FetchAssetSummaries does */
+using FHazeAssetSummaryTransport = TFunction<void(const TArray<FString>& AssetIds, FHazeOnAssetSummaries OnComplete)>;
+/** Fetches one full asset and reports it as UHazeClient::FetchAsset does */
+using FHazeAssetTransport = TFunction<void(const FString& AssetId, FHazeOnAsset OnComplete)>;
+
+/**
+ * Keeps tracked assets loaded at the density tier their distance, visibility and priority call for, like a
+ * level-of-detail system for chain data:
+ *
+ * - Ethereal: the summary (POST /api/v1/assets/summaries, batched). Requested for every tracked asset first,
+ *   visible ones ahead of the rest, and never evicted while the asset is tracked.
+ * - Light: the full asset (GET /api/v1/assets/{id}): all metadata and attributes.
+ * - Dense: Light plus every blob in the asset's blob_refs downloaded into FHazeBlobCache (disk, not memory).
+ * - Core: Dense plus the blobs mapped into memory (FindBlob).
+ *
+ * The wanted tier is the higher of the distance tier (CoreDistance / DenseDistance / LightDistance from the view
+ * location) and the asset's RequiredTier, capped at the asset's own density; assets that are not visible only keep
+ * their RequiredTier. Tiers are loaded one step at a time, at most MaxConcurrentLoads at once, most important asset
+ * first (visible, then priority, then distance). Tiers above the wanted one are dropped once they have been unwanted
+ * for EvictDelaySeconds, and whenever the resident estimate (GetResidentBytes) exceeds MemoryBudgetBytes the least
+ * important assets lose tiers until it fits again.
+ *
+ * Game thread only; OnTierLoaded / OnTierEvicted fire from the streamer's update.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeAssetStreamer : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a streamer that loads through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE", meta = (DisplayName = "Create Haze Asset Streamer"))
+	static UHazeAssetStreamer* CreateAssetStreamer(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE")
+	TObjectPtr<UHazeClient> Client;
+
+	/** Upper bound for the estimated memory held by loaded tiers (asset JSON and mapped blobs) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	int64 MemoryBudgetBytes = 256 * 1024 * 1024;
+
+	/** Tier loads (full asset, blob set, mapping) in flight at once; summary batches count as one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxConcurrentLoads = 4;
+
+	/** Within this distance of the view an asset wants Light */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	float LightDistance = 20000.f;
+
+	/** Within this distance an asset wants Dense */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	float DenseDistance = 5000.f;
+
+	/** Within this distance an asset wants Core */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	float CoreDistance = 1500.f;
+
+	/** How long a tier may stay loaded after it stops being wanted (hides flicker at distance boundaries) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	float EvictDelaySeconds = 5.f;
+
+	/** Seconds between streaming updates */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	float UpdateIntervalSeconds = 0.1f;
+
+	/** Seconds before a failed tier load is tried again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Streaming", meta = (ClampMin = "0"))
+	float RetryDelaySeconds = 5.f;
+
+	/** A tier finished loading (Ethereal: the summary arrived) */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE")
+	FHazeAssetTierDelegate OnTierLoaded;
+
+	/** A tier was dropped (out of view, over budget, untracked or invalidated) */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE")
+	FHazeAssetTierDelegate OnTierEvicted;
+
+	/** Start streaming an asset. Tracking an asset again just moves it. */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void Track(const FString& AssetIdHex, const FVector& Location);
+
+	/** Stop streaming an asset and drop everything loaded for it */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void Untrack(const FString& AssetIdHex);
+
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void SetAssetLocation(const FString& AssetIdHex, const FVector& Location);
+
+	/** Invisible assets keep only their RequiredTier (and sort behind visible ones) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void SetAssetVisible(const FString& AssetIdHex, bool bVisible);
+
+	/** Higher loads first and is evicted last; ties are broken by distance */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void SetAssetPriority(const FString& AssetIdHex, int32 Priority);
+
+	/** Minimum tier regardless of distance or visibility (e.g. Core for the asset the player is holding) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void SetRequiredTier(const FString& AssetIdHex, EDensityLevel Tier);
+
+	/** Where distances are measured from (normally the camera) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void SetViewLocation(const FVector& Location);
+
+	/** Highest loaded tier. False if the asset is untracked or its summary has not arrived yet. */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Streaming")
+	bool GetLoadedTier(const FString& AssetIdHex, EDensityLevel& OutTier) const;
+
+	/** The most complete view loaded: the full asset from Light up, else the summary (bIsSummary) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Streaming")
+	bool GetAsset(const FString& AssetIdHex, FHazeAssetInfo& OutAsset) const;
+
+	/** Estimated bytes held by loaded tiers */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Streaming")
+	int64 GetResidentBytes() const { return ResidentBytes; }
+
+	/** Refetch assets named by asset events on Stream (subscribes Stream to the asset event types) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Streaming")
+	void BindInvalidation(UHazeEventStream* Stream);
+
+	/** C++: a mapped blob of a Core-tier asset, or null. The mapping stays valid while the pointer is held. */
+	TSharedPtr<FHazeMappedBlob, ESPMode::ThreadSafe> FindBlob(const FString& AssetIdHex, const FString& BlobKey) const;
+
+	/**
+	 * C++: fetch summaries and full assets through these instead of Client (null for the client again), e.g. in tests.
+	 * Blob tiers (Dense and Core of assets with blob_refs) still load through Client.
+	 */
+	void SetTransport(FHazeAssetSummaryTransport InSummaries, FHazeAssetTransport InAssets)
+	{
+		SummaryTransport = MoveTemp(InSummaries);
+		AssetTransport = MoveTemp(InAssets);
+	}
+
+	/** C++: run one streaming update at Now (FPlatformTime::Seconds), as the ticker does */
+	void Update(double Now);
+
+	virtual void BeginDestroy() override;
+
+private:
+	using FMappedBlobs = TMap<FString, TSharedPtr<FHazeMappedBlob, ESPMode::ThreadSafe>>;
+
+	struct FEntry
+	{
+		FVector Location = FVector::ZeroVector;
+		bool bVisible = true;
+		int32 Priority = 0;
+		EDensityLevel RequiredTier = EDensityLevel::Ethereal;
+
+		/** Loaded data; Full is valid from Light, Blobs from Core */
+		FHazeAssetInfo Summary;
+		FHazeAssetInfo Full;
+		FMappedBlobs Blobs;
+		bool bHasSummary = false;
+		EDensityLevel LoadedTier = EDensityLevel::Ethereal;
+		int64 SummaryBytes = 0;
+		int64 FullBytes = 0;
+		int64 BlobBytes = 0;
+
+		/** Per-update state */
+		float Distance = 0.f;
+		EDensityLevel WantedTier = EDensityLevel::Ethereal;
+		/** When LoadedTier first exceeded WantedTier (0 while it does not) */
+		double UnwantedSince = 0.0;
+		/** Highest tier allowed back after a budget eviction, until resident memory falls to the low-water mark */
+		EDensityLevel BudgetCap = EDensityLevel::Core;
+
+		bool bSummaryQueued = false;
+		bool bLoading = false;
+		double RetryAt = 0.0;
+		/** Renewed whenever loaded state is dropped, so late completions are discarded */
+		uint32 Generation = 0;
+
+		int64 GetBytes() const { return SummaryBytes + FullBytes + BlobBytes; }
+	};
+
+	FEntry* FindEntry(const FString& AssetIdHex);
+	const FEntry* FindEntry(const FString& AssetIdHex) const;
+	void EnsureTicking();
+	bool Tick(float DeltaTime);
+	EDensityLevel ComputeWantedTier(const FEntry& Entry) const;
+	/** Sort key: visible first, then priority, then distance */
+	static bool IsMoreImportant(const FEntry& A, const FEntry& B);
+
+	void RequestSummaries(const TArray<FString>& Order, double Now);
+	void OnSummaries(const TArray<FString>& AssetIds, const TArray<uint32>& Generations, bool bOk, const TArray<FHazeAssetInfo>& Assets);
+	void LoadNextTier(const FString& AssetId, FEntry& Entry);
+	void LoadFull(const FString& AssetId, FEntry& Entry);
+	void LoadBlobsToDisk(const FString& AssetId, FEntry& Entry);
+	void MapBlobs(const FString& AssetId, FEntry& Entry);
+	/** Complete the load started at Generation; false if it was superseded */
+	FEntry* FinishLoad(const FString& AssetId, uint32 Generation, bool bOk);
+	void SetLoadedTier(const FString& AssetId, FEntry& Entry, EDensityLevel Tier);
+	/** Drop tiers above Tier, or everything including the summary (broadcasting each), and invalidate loads in flight */
+	void EvictTo(const FString& AssetId, FEntry& Entry, EDensityLevel Tier, bool bDropSummary = false);
+	/** Strip tiers from the least important assets (end of Order) until resident memory fits the budget */
+	void EnforceBudget(const TArray<FString>& Order);
+	void HandleStreamEvent(const FHazeStreamEvent& Event);
+
+	static FString AssetKey(const FString& AssetIdHex);
+
+	TMap<FString, FEntry> Entries;
+	FVector ViewLocation = FVector::ZeroVector;
+	int64 ResidentBytes = 0;
+	int32 LoadsInFlight = 0;
+	uint32 GenerationCounter = 0;
+
+	FHazeAssetSummaryTransport SummaryTransport;
+	FHazeAssetTransport AssetTransport;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
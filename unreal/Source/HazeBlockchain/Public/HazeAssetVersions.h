@@ -0,0 +1,175 @@
+// Copyright HAZE Blockchain. Incremental sync of asset versions and history.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeClient.h"
+#include "HazeAssetVersions.generated.h"
+
+class UHazeEventStream;
+
+/** One version of a GET /api/v1/assets/{id}/versions?since= response, as sent */
+struct FHazeAssetVersionDelta
+{
+	/** BlobRefs holds only the keys that are new or changed since BlobRefsBase */
+	FHazeAssetVersion Version;
+	/** Version the blob refs are relative to; 0: BlobRefs is the full map */
+	int64 BlobRefsBase = 0;
+	TArray<FString> RemovedBlobRefs;
+};
+
+/** GET /api/v1/assets/{id}/versions?since=N: the versions after N, oldest first */
+struct FHazeAssetVersionsPage
+{
+	int64 Since = 0;
+	int64 CurrentVersion = 0;
+	TArray<FHazeAssetVersionDelta> Versions;
+};
+
+/** GET /api/v1/assets/{id}/history?since=N */
+struct FHazeAssetHistoryPage
+{
+	/** Index of Entries[0] (or NextIndex when empty); above the requested index when older entries were dropped */
+	int64 FirstIndex = 0;
+	int64 NextIndex = 0;
+	/** Oldest first, Index filled in */
+	TArray<FHazeAssetHistoryEntry> Entries;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FHazeAssetVersionsSyncedDelegate, const FString&, AssetId, bool, bSuccess, bool, bChanged);
+
+/**
+ * Known versions and history of tracked assets, kept current by fetching only what is new: versions after the
+ * newest one held (?since=), with blob refs as deltas against the version before, and history entries from the
+ * next index on. Blob refs are stored once per distinct key and hash across all versions and assets, so long-lived
+ * Mistborn assets with many versions sharing most of their blobs stay cheap to hold and to keep in sync.
+ *
+ *   Versions->Track(AssetId);              // first sync fetches everything the node keeps
+ *   Versions->BindEventStream(Stream);     // asset_version_created / asset_updated trigger a delta sync
+ *   Versions->GetLatestVersion(AssetId, Latest);
+ *
+ * Versions and history entries the node has dropped (it keeps the last 10 versions and 100 entries) stay in the
+ * cache, up to MaxVersions and MaxHistoryEntries per asset; beyond that the oldest are dropped. Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeAssetVersionCache : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a cache that fetches through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets", meta = (DisplayName = "Create Haze Asset Version Cache"))
+	static UHazeAssetVersionCache* CreateAssetVersionCache(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Assets")
+	TObjectPtr<UHazeClient> Client;
+
+	/** Versions kept per asset, oldest dropped first (0: no limit) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Assets", meta = (ClampMin = "0"))
+	int32 MaxVersions = 64;
+
+	/** History entries kept per asset, oldest dropped first (0: no limit) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Assets", meta = (ClampMin = "0"))
+	int32 MaxHistoryEntries = 1000;
+
+	/** A sync finished; bChanged if it brought new versions or history entries */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Assets")
+	FHazeAssetVersionsSyncedDelegate OnSynced;
+
+	/** Start keeping an asset's versions and history, and sync it */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void Track(const FString& AssetId);
+
+	/** Forget an asset (its blob refs are released) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void Untrack(const FString& AssetId);
+
+	/** Fetch what is new for a tracked asset; a sync already in flight runs once more when it finishes */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void Sync(const FString& AssetId);
+
+	/** Sync every tracked asset */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void SyncAll();
+
+	/** Sync tracked assets named by asset events from Stream (asset_version_created, asset_updated and the other asset changes) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void BindEventStream(UHazeEventStream* Stream);
+
+	/** Every known version, oldest first */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	TArray<FHazeAssetVersion> GetVersions(const FString& AssetId) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	bool GetVersion(const FString& AssetId, int64 Version, FHazeAssetVersion& OutVersion) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	bool GetLatestVersion(const FString& AssetId, FHazeAssetVersion& OutVersion) const;
+
+	/** Newest version held, 0 if none */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	int64 GetKnownVersion(const FString& AssetId) const;
+
+	/** Known history entries, oldest first (gaps where the node dropped entries before they were fetched) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	TArray<FHazeAssetHistoryEntry> GetHistory(const FString& AssetId) const;
+
+	/** Distinct blob hashes referenced by the cached versions of all assets */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	int32 GetBlobHashCount() const;
+
+	/**
+	 * C++: merge a versions response, as a fetch would. False if a delta's base version is not held: the asset's
+	 * versions are dropped and the next sync fetches them from scratch.
+	 */
+	bool ApplyVersions(const FString& AssetId, const FHazeAssetVersionsPage& Page);
+
+	/** C++: merge a history response, as a fetch would */
+	void ApplyHistory(const FString& AssetId, const FHazeAssetHistoryPage& Page);
+
+private:
+	/** Strings held once and shared by id, counted by the versions using them */
+	struct FStringTable
+	{
+		TArray<FString> Values;
+		TArray<int32> RefCounts;
+		TMap<FString, int32> Ids;
+		TArray<int32> FreeIds;
+
+		int32 Add(const FString& Value);
+		void Release(int32 Id);
+	};
+
+	/** A version without its blob refs, plus the refs as (key id, hash id) */
+	struct FStoredVersion
+	{
+		FHazeAssetVersion Header;
+		TArray<TPair<int32, int32>> BlobRefs;
+	};
+
+	struct FTracked
+	{
+		/** Oldest first */
+		TArray<FStoredVersion> Versions;
+		TArray<FHazeAssetHistoryEntry> History;
+		int64 NextHistoryIndex = 0;
+		/** Requests of the sync in flight not answered yet */
+		int32 Pending = 0;
+		/** Sync again once the one in flight is done */
+		bool bResync = false;
+		bool bSyncOk = true;
+		bool bChanged = false;
+	};
+
+	void HandleStreamEvent(const FHazeStreamEvent& Event);
+	void FinishRequest(const FString& Key, bool bOk);
+	void ReleaseVersion(const FStoredVersion& Stored);
+	void ReleaseVersions(FTracked& Entry);
+	/** Drop the oldest versions and history entries over MaxVersions / MaxHistoryEntries */
+	void Prune(FTracked& Entry);
+	FHazeAssetVersion Materialize(const FStoredVersion& Stored) const;
+
+	/** Keyed by lower-case asset id */
+	TMap<FString, FTracked> Tracked;
+	FStringTable BlobKeys;
+	FStringTable BlobHashes;
+};
@@ -0,0 +1,153 @@
+// Copyright HAZE Blockchain. Future-based C++ API over UHazeClient and UHazeChainFollower.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Tasks/Task.h"
+#include "HazeClient.h"
+#include "HazeChainFollower.h"
+
+/** Why an async call produced no value */
+enum class EHazeErrorKind : uint8
+{
+	None,
+	/** Transport failure, unexpected HTTP status or a body that did not decode */
+	Request,
+	/** The node answered and refused (a rejected transaction: 4xx) */
+	Rejected,
+	/** The client or follower was destroyed before the call finished */
+	Abandoned,
+	/** Nothing was sent (null client, empty transaction) */
+	InvalidInput
+};
+
+struct FHazeError
+{
+	EHazeErrorKind Kind = EHazeErrorKind::None;
+	/** HTTP status where the node answered, else 0 */
+	int32 ResponseCode = 0;
+	FString Message;
+};
+
+/** Value of an async call, or why there is none */
+template <typename ValueType>
+struct THazeResult
+{
+	ValueType Value{};
+	TOptional<FHazeError> Error;
+	/** HTTP status where the call reports one (submissions), else 0 */
+	int32 ResponseCode = 0;
+
+	bool IsOk() const { return !Error.IsSet(); }
+	explicit operator bool() const { return IsOk(); }
+
+	const ValueType& operator*() const { return Value; }
+	const ValueType* operator->() const { return &Value; }
+
+	static THazeResult Ok(ValueType InValue, int32 InResponseCode = 0)
+	{
+		THazeResult Result;
+		Result.Value = MoveTemp(InValue);
+		Result.ResponseCode = InResponseCode;
+		return Result;
+	}
+
+	static THazeResult Fail(FHazeError InError)
+	{
+		THazeResult Result;
+		Result.ResponseCode = InError.ResponseCode;
+		Result.Error = MoveTemp(InError);
+		return Result;
+	}
+};
+
+template <typename ValueType>
+using THazeFuture = TFuture<THazeResult<ValueType>>;
+
+/**
+ * The UHazeClient calls as futures of typed results, for C++ flows that chain requests (read the account, sign,
+ * submit, wait for the receipt) without a reflected delegate or a callback nesting level per step:
+ *
+ *   HazeAsync::Chain(HazeAsync::FetchAccount(Client, Sender), [=](const THazeResult<FAccountInfo>& Account)
+ *   {
+ *       if (!Account) return HazeAsync::MakeFailed<FTransactionResponse>(Account.Error.GetValue());
+ *       return HazeAsync::SubmitTransaction(Client, FTransactionBuilder::BuildSignedTransfer(Key, To, Amount, Fee, Account->Nonce));
+ *   }).Next([](const THazeResult<FTransactionResponse>& Sent) { ... });
+ *
+ * Each call costs the promise state and the C++ callback of the Fetch* call it wraps. They may be started from any
+ * thread (the request is started on the game thread) and complete on the game thread, so Next / Then continuations
+ * run there; ToTask moves a chain onto task-graph workers. Every future completes: a client destroyed mid-call
+ * yields EHazeErrorKind::Abandoned.
+ */
+namespace HazeAsync
+{
+	HAZEBLOCKCHAIN_API THazeFuture<FString> FetchHealth(UHazeClient* Client);
+	HAZEBLOCKCHAIN_API THazeFuture<FBlockchainInfo> FetchBlockchainInfo(UHazeClient* Client);
+	HAZEBLOCKCHAIN_API THazeFuture<FHazeAmount> FetchBalance(UHazeClient* Client, const FString& AddressHex);
+	HAZEBLOCKCHAIN_API THazeFuture<FAccountInfo> FetchAccount(UHazeClient* Client, const FString& AddressHex);
+	HAZEBLOCKCHAIN_API THazeFuture<FHazeBlockInfo> FetchBlockByHeight(UHazeClient* Client, int64 Height);
+	HAZEBLOCKCHAIN_API THazeFuture<FHazeAssetInfo> FetchAsset(UHazeClient* Client, const FString& AssetIdHex);
+	HAZEBLOCKCHAIN_API THazeFuture<TArray<FHazeAssetInfo>> FetchAssetSummaries(UHazeClient* Client, const TArray<FString>& AssetIdsHex);
+	HAZEBLOCKCHAIN_API THazeFuture<FHazeBlobDownloadResult> FetchAssetBlob(UHazeClient* Client, const FString& AssetIdHex, const FString& BlobKey);
+	HAZEBLOCKCHAIN_API THazeFuture<TArray<FLiquidityPool>> FetchLiquidityPools(UHazeClient* Client);
+	HAZEBLOCKCHAIN_API THazeFuture<FLiquidityPool> FetchLiquidityPool(UHazeClient* Client, const FString& PoolId);
+
+	/** A transaction the node refused (4xx) fails as EHazeErrorKind::Rejected with its HTTP status */
+	HAZEBLOCKCHAIN_API THazeFuture<FTransactionResponse> SubmitTransaction(UHazeClient* Client, const FString& TransactionJson);
+	HAZEBLOCKCHAIN_API THazeFuture<FTransactionResponse> SubmitTransactionBinary(UHazeClient* Client, TArray<uint8> Transaction);
+	/** Ok when the batch request succeeded; per-transaction outcomes are in the results */
+	HAZEBLOCKCHAIN_API THazeFuture<TArray<FBatchTransactionResult>> SubmitTransactionBatch(UHazeClient* Client, const TArray<FString>& TransactionJsons);
+	HAZEBLOCKCHAIN_API THazeFuture<TArray<FBatchTransactionResult>> SubmitTransactionBatchBinary(UHazeClient* Client, const TArray<TArray<uint8>>& Transactions);
+
+	/**
+	 * Track TxHash on Follower and complete once it reaches Status (Confirmed or Finalized). Adds a listener of its
+	 * own, next to any other TrackTransactionNative callback for that hash (an account ledger bound to the same
+	 * follower keeps settling). Abandoned if the follower is destroyed or the transaction untracked first. Game thread
+	 * only.
+	 */
+	HAZEBLOCKCHAIN_API THazeFuture<FHazeReceipt> WaitForReceipt(UHazeChainFollower* Follower, const FString& TxHash,
+		EHazeReceiptStatus Status = EHazeReceiptStatus::Confirmed);
+
+	/** A future that has already failed, for short-circuiting a Chain step */
+	template <typename ValueType>
+	THazeFuture<ValueType> MakeFailed(FHazeError Error)
+	{
+		return MakeFulfilledPromise<THazeResult<ValueType>>(THazeResult<ValueType>::Fail(MoveTemp(Error))).GetFuture();
+	}
+
+	/**
+	 * Run Continuation with Future's result when it is ready and forward the future Continuation returns
+	 * (TFuture::Next would give a future of a future). Continuation runs on the thread that completed Future.
+	 */
+	template <typename ResultType, typename FnType>
+	auto Chain(TFuture<ResultType>&& Future, FnType&& Continuation) -> decltype(Continuation(DeclVal<const ResultType&>()))
+	{
+		using FNextFuture = decltype(Continuation(DeclVal<const ResultType&>()));
+		using FNextResult = typename TDecay<decltype(DeclVal<FNextFuture>().Get())>::Type;
+		TSharedRef<TPromise<FNextResult>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<FNextResult>, ESPMode::ThreadSafe>();
+		FNextFuture Next = Promise->GetFuture();
+		Future.Then([Promise, Continuation = Forward<FnType>(Continuation)](TFuture<ResultType> Done) mutable
+		{
+			Continuation(Done.Get()).Then([Promise](TFuture<FNextResult> Inner)
+			{
+				Promise->SetValue(Inner.Get());
+			});
+		});
+		return Next;
+	}
+
+	/** A task holding Future's result, so UE::Tasks prerequisites and continuations can run chains on workers */
+	template <typename ResultType>
+	UE::Tasks::TTask<ResultType> ToTask(TFuture<ResultType>&& Future)
+	{
+		UE::Tasks::FTaskEvent Ready(TEXT("HazeAsync"));
+		TSharedRef<TOptional<ResultType>, ESPMode::ThreadSafe> Value = MakeShared<TOptional<ResultType>, ESPMode::ThreadSafe>();
+		Future.Then([Ready, Value](TFuture<ResultType> Done) mutable
+		{
+			Value->Emplace(Done.Get());
+			Ready.Trigger();
+		});
+		return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Value]() { return MoveTemp(Value->GetValue()); }, Ready);
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright HAZE Blockchain. bincode 1.x encoding of node types (application/x-haze-bincode).
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Writes values the way the node's bincode (default options) reads them: integers little-endian at full width,
+ * enum variants as u32, Option as a u8 tag, strings and byte vectors as a u64 length followed by the bytes,
+ * fixed arrays ([u8; 32]) as raw bytes. Appends to a caller-owned array.
+ */
+class HAZEBLOCKCHAIN_API FHazeBincodeWriter
+{
+public:
+	explicit FHazeBincodeWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+	void WriteU8(uint8 Value) { Out.Add(Value); }
+	void WriteBool(bool bValue) { Out.Add(bValue ? 1 : 0); }
+	void WriteU32(uint32 Value);
+	void WriteU64(uint64 Value);
+	/** Enum variant index */
+	void WriteVariant(uint32 Index) { WriteU32(Index); }
+	/** Fixed-size array, no length */
+	void WriteFixed(TArrayView<const uint8> Bytes) { Out.Append(Bytes.GetData(), Bytes.Num()); }
+	/** Vec<u8> */
+	void WriteBytes(TArrayView<const uint8> Bytes);
+	/** String, as UTF-8 */
+	void WriteString(FStringView Value);
+	void WriteOptionU64(TOptional<uint64> Value);
+	/** Option<String>; empty is None */
+	void WriteOptionString(FStringView Value);
+	/** Length of a Vec or map whose elements follow */
+	void WriteLength(int32 Num) { WriteU64(static_cast<uint64>(Num)); }
+
+private:
+	TArray<uint8>& Out;
+};
+
+/**
+ * Reads bincode produced by the node. Every read checks the remaining length; after the first failure IsOk()
+ * stays false and reads return zero or empty values, so decoders can read a whole struct and check once.
+ */
+class HAZEBLOCKCHAIN_API FHazeBincodeReader
+{
+public:
+	explicit FHazeBincodeReader(TArrayView<const uint8> InData) : Data(InData) {}
+
+	bool IsOk() const { return bOk; }
+	/** True once everything was read without error */
+	bool IsDone() const { return bOk && Offset == Data.Num(); }
+
+	uint8 ReadU8();
+	bool ReadBool();
+	uint32 ReadU32();
+	uint64 ReadU64();
+	/** Option tag; false for None */
+	bool ReadSome();
+	FString ReadString();
+	/** Option<String>; None reads as empty */
+	FString ReadOptionString() { return ReadSome() ? ReadString() : FString(); }
+	/** Length prefix of a Vec; fails if it cannot fit in what is left (each element is at least MinElementSize bytes) */
+	int32 ReadLength(int32 MinElementSize = 1);
+
+private:
+	const uint8* Take(int32 Num);
+
+	TArrayView<const uint8> Data;
+	int32 Offset = 0;
+	bool bOk = true;
+};
@@ -0,0 +1,53 @@
+// Copyright HAZE Blockchain. Content-addressed on-disk cache for Core-density blobs.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** A cached blob mapped read-only into memory. The mapping lives as long as this object. */
+class HAZEBLOCKCHAIN_API FHazeMappedBlob
+{
+public:
+	FHazeMappedBlob(TUniquePtr<IMappedFileHandle> InHandle, TUniquePtr<IMappedFileRegion> InRegion);
+	~FHazeMappedBlob();
+
+	const uint8* GetData() const;
+	int64 GetSize() const;
+	TArrayView<const uint8> GetView() const { return MakeArrayView(GetData(), static_cast<int32>(GetSize())); }
+
+private:
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+};
+
+/**
+ * Blobs are stored once per SHA-256 (the hash in the asset's blob_refs), so the same file shared between assets
+ * or versions is downloaded and stored once. Files only appear under their final name after the download has been
+ * verified; partial downloads live next to them as <hash>.part and are resumed from where they stopped.
+ */
+struct HAZEBLOCKCHAIN_API FHazeBlobCache
+{
+	/** Saved/HazeBlobs */
+	static FString GetCacheDirectory();
+
+	/** Path of the verified blob for BlobHashHex (whether or not it exists yet) */
+	static FString GetBlobPath(const FString& BlobHashHex);
+
+	/** Path of the in-progress download for BlobHashHex */
+	static FString GetPartialPath(const FString& BlobHashHex);
+
+	/** True if the verified blob is on disk */
+	static bool Contains(const FString& BlobHashHex);
+
+	/** Map a cached blob read-only. Null if it is not cached or cannot be mapped on this platform. */
+	static TUniquePtr<FHazeMappedBlob> Map(const FString& BlobHashHex);
+
+	/** Delete a cached blob and any partial download of it */
+	static void Remove(const FString& BlobHashHex);
+
+	/** Canonical key: trimmed lowercase hex. Empty if BlobHashHex is not a 32-byte hex hash. */
+	static FString NormalizeHash(const FString& BlobHashHex);
+};
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+/** Warnings and errors from every part of the plugin */
+HAZEBLOCKCHAIN_API DECLARE_LOG_CATEGORY_EXTERN(LogHaze, Log, All);
+
 class FHazeBlockchainModule : public IModuleInterface
 {
 public:
@@ -0,0 +1,207 @@
+// Copyright HAZE Blockchain. Chain head follower resolving transaction receipts from recent blocks.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HazeClient.h"
+#include "HazeChainFollower.generated.h"
+
+class UHazeEventStream;
+
+UENUM(BlueprintType)
+enum class EHazeReceiptStatus : uint8
+{
+	/** Not in any block the follower has seen */
+	Pending = 0,
+	/** In a block that is not final yet (a reorg may still move it back to Pending) */
+	Confirmed,
+	/** In a block at or below last_finalized_height */
+	Finalized
+};
+
+/** Where a tracked transaction stands */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeReceipt
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) FString TxHash;
+	UPROPERTY(BlueprintReadOnly) EHazeReceiptStatus Status = EHazeReceiptStatus::Pending;
+	/** -1 while pending */
+	UPROPERTY(BlueprintReadOnly) int64 BlockHeight = -1;
+	UPROPERTY(BlueprintReadOnly) FString BlockHash;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeReceiptDelegate, const FHazeReceipt&, Receipt);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeChainBlockDelegate, const FHazeBlockInfo&, Block);
+
+/** C++ receipt callback: fires on every status change of one tracked transaction, on the game thread */
+using FHazeOnReceipt = TFunction<void(const FHazeReceipt& Receipt)>;
+
+/**
+ * Follows the chain head and resolves every tracked transaction from the blocks it sees, so confirming N pending
+ * transactions costs one request per block (none with an event stream bound) instead of N polls of
+ * /api/v1/transactions/{hash}. The last RecentBlocks blocks and their transaction hashes are kept, so a
+ * transaction tracked after its block arrived still resolves at once.
+ *
+ *   Follower->BindEventStream(Stream);   // optional: blocks arrive as block_applied events
+ *   Follower->Start();
+ *   Follower->TrackTransaction(Response.Hash);
+ *
+ * Every PollIntervalSeconds the follower reads /api/v1/blockchain/info for the head and last_finalized_height,
+ * and fetches any block it has not seen (/api/v1/blocks/height/{h}) in height order. A fetched block whose parent
+ * is not the block held at the height below rolls the unfinalized tip back; receipts in dropped blocks return to
+ * Pending (OnTransactionReverted). Receipts are dropped once finalized. Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeChainFollower : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a follower that reads through Client (call Start to begin) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks", meta = (DisplayName = "Create Haze Chain Follower"))
+	static UHazeChainFollower* CreateChainFollower(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Blocks")
+	TObjectPtr<UHazeClient> Client;
+
+	/** Seconds between head polls (read by Start) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Blocks", meta = (ClampMin = "0.1"))
+	float PollIntervalSeconds = 1.f;
+
+	/** Blocks (and their transaction hashes) kept for late TrackTransaction calls and reorg checks (read on the first block) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Blocks", meta = (ClampMin = "1"))
+	int32 RecentBlocks = 256;
+
+	/** Blocks below the head fetched when following starts, for transactions already sent (capped by RecentBlocks) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Blocks", meta = (ClampMin = "0"))
+	int32 BackfillBlocks = 16;
+
+	/** A new block joined the head */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Blocks")
+	FHazeChainBlockDelegate OnBlock;
+
+	/** A tracked transaction was seen in a block */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Blocks")
+	FHazeReceiptDelegate OnTransactionConfirmed;
+
+	/** A tracked transaction's block is final; the receipt is no longer tracked */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Blocks")
+	FHazeReceiptDelegate OnTransactionFinalized;
+
+	/** A confirmed transaction's block was replaced; it is Pending again */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Blocks")
+	FHazeReceiptDelegate OnTransactionReverted;
+
+	/** Begin polling the head (and fetching blocks the event stream did not deliver) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks")
+	void Start();
+
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks")
+	void Stop();
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Blocks")
+	bool IsRunning() const { return PollHandle.IsValid(); }
+
+	/** Take blocks from Stream's block_applied events, and subscribe it to them */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks")
+	void BindEventStream(UHazeEventStream* Stream);
+
+	/** Follow a submitted transaction (FTransactionResponse::Hash) until it is final */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks")
+	void TrackTransaction(const FString& TxHash);
+
+	/**
+	 * TrackTransaction with a callback for this transaction only (fires as well as the delegates). Every caller's
+	 * callback is kept, so several systems can wait on one hash. Returns a handle for RemoveReceiptListener (0 when
+	 * OnUpdate is null or TxHash empty).
+	 */
+	uint64 TrackTransactionNative(const FString& TxHash, FHazeOnReceipt OnUpdate);
+
+	/**
+	 * Drop one TrackTransactionNative callback. The transaction stays tracked while another callback is left or it was
+	 * also tracked without one (TrackTransaction); otherwise it is untracked.
+	 */
+	void RemoveReceiptListener(const FString& TxHash, uint64 Handle);
+
+	/** Stop following a transaction (e.g. abandoned); no delegate fires */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks")
+	void UntrackTransaction(const FString& TxHash);
+
+	/** False if TxHash is not tracked (never, or already finalized) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Blocks")
+	bool GetReceipt(const FString& TxHash, FHazeReceipt& OutReceipt) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Blocks")
+	int32 GetTrackedCount() const { return Tracked.Num(); }
+
+	/** Height of the newest block held, or -1 */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Blocks")
+	int64 GetHeadHeight() const { return HasBlocks() ? HeadHeight : -1; }
+
+	/** last_finalized_height as last reported, or -1 */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Blocks")
+	int64 GetFinalizedHeight() const { return FinalizedHeight; }
+
+	/** C++: a held block, or null (valid until the next block arrives) */
+	const FHazeBlockInfo* FindBlock(int64 Height) const;
+
+	/**
+	 * C++: fold in one block, as a fetch or event would. Blocks must arrive in height order; a block above the head
+	 * plus one is ignored, and an unfinalized height re-applied with another hash (or a parent mismatch) rolls back.
+	 * True if the held chain changed.
+	 */
+	bool ApplyBlock(const FHazeBlockInfo& Block);
+
+	/** C++: finalize tracked receipts at or below Height (last_finalized_height) */
+	void ApplyFinalizedHeight(int64 Height);
+
+	virtual void BeginDestroy() override;
+
+private:
+	struct FTracked
+	{
+		FHazeReceipt Receipt;
+		/** TrackTransactionNative callbacks by handle, in the order they were added */
+		TArray<TPair<uint64, FHazeOnReceipt>> Listeners;
+		/** Tracked without a callback too, so removing the last listener keeps it */
+		bool bTrackedPlain = false;
+	};
+
+	bool HasBlocks() const { return HeadHeight >= TailHeight; }
+
+	void Poll();
+	void FetchMissing();
+	void HandleStreamEvent(const FHazeStreamEvent& Event);
+
+	/** Start holding blocks after Height (nothing held yet) */
+	void Position(int64 Height);
+	void Append(const FHazeBlockInfo& Block);
+	/** Drop held blocks from Height up */
+	void RollBack(int64 Height);
+
+	void Confirm(const FString& TxHash, const FHazeBlockInfo& Block);
+	void Finalize(const FString& TxHash);
+	void Notify(const FHazeReceipt& Receipt, const TArray<TPair<uint64, FHazeOnReceipt>>& Listeners, FHazeReceiptDelegate& Delegate);
+
+	/** Blocks TailHeight..HeadHeight at Height % Ring.Num() */
+	TArray<FHazeBlockInfo> Ring;
+	int64 HeadHeight = -1;
+	int64 TailHeight = 0;
+	bool bPositioned = false;
+
+	/** Height of each transaction in a held block */
+	TMap<FString, int64> TxHeights;
+	TMap<FString, FTracked> Tracked;
+	uint64 NextListener = 1;
+	/** Confirmed tracked receipts by block height, so finality touches only those */
+	TMap<int64, TArray<FString>> ConfirmedAt;
+
+	int64 FinalizedHeight = -1;
+	/** Highest height the node has reported (info or event) */
+	int64 TargetHeight = -1;
+	bool bPollInFlight = false;
+	bool bFetchInFlight = false;
+
+	FTSTicker::FDelegateHandle PollHandle;
+};
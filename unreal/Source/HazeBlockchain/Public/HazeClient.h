@@ -5,14 +5,62 @@
 #include "CoreMinimal.h"
 #include "HazeTypes.h"
 #include "Interfaces/IHttpRequest.h"
+#include "Containers/Ticker.h"
+#include "HazeReadCache.h"
+#include "HazeRequestMetrics.h"
+#include "HazeNodeRouter.h"
+#include "HazeRequestScheduler.h"
 #include "HazeClient.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeHealthDelegate, const FString&, Health);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeBalanceDelegate, const FString&, Balance);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeBlockchainInfoDelegate, const FBlockchainInfo&, Info);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeAccountInfoDelegate, const FAccountInfo&, Info);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeTransactionDelegate, bool, bSuccess, const FTransactionResponse&, Response);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeErrorDelegate, bool, bSuccess, const FString&, ErrorMessage);
+class UHazeEventStream;
+class UHazeAssetCursor;
+class FHazeAssetPage;
+class FHazeBlobDownload;
+struct FHazeAssetVersionsPage;
+struct FHazeAssetHistoryPage;
+struct FHazeSnapshotStalePage;
+
+DECLARE_DYNAMIC_DELEGATE_OneParam(FHazeHealthDelegate, const FString&, Health);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FHazeBalanceDelegate, const FHazeAmount&, Balance);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FHazeBlockchainInfoDelegate, const FBlockchainInfo&, Info);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FHazeAccountInfoDelegate, const FAccountInfo&, Info);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeTransactionDelegate, bool, bSuccess, const FTransactionResponse&, Response);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeBlockDelegate, bool, bSuccess, const FHazeBlockInfo&, Block);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeTransactionBatchDelegate, bool, bSuccess, const TArray<FBatchTransactionResult>&, Results);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeAssetDelegate, bool, bSuccess, const FHazeAssetInfo&, Asset);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeAssetSummariesDelegate, bool, bSuccess, const TArray<FHazeAssetInfo>&, Assets);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeBlobDownloadDelegate, bool, bSuccess, const FHazeBlobDownloadResult&, Result);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeErrorDelegate, bool, bSuccess, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeLiquidityPoolsDelegate, bool, bSuccess, const TArray<FLiquidityPool>&, Pools);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FHazeLiquidityPoolDelegate, bool, bSuccess, const FLiquidityPool&, Pool);
+
+/** C++ completion callbacks (no reflected delegate). bOk is false on transport, HTTP or decode failure. Fire on the game thread. */
+using FHazeOnHealth = TFunction<void(bool bOk, const FString& Health)>;
+using FHazeOnBlockchainInfo = TFunction<void(bool bOk, const FBlockchainInfo& Info)>;
+using FHazeOnBalance = TFunction<void(bool bOk, const FHazeAmount& Balance)>;
+using FHazeOnAccount = TFunction<void(bool bOk, const FAccountInfo& Info)>;
+/** ResponseCode is the HTTP status, or 0 if the request never got a response (the tx may or may not have reached the node). */
+using FHazeOnTransaction = TFunction<void(bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode)>;
+/** bOk means the batch request itself succeeded; check each result's Status. */
+using FHazeOnTransactionBatch = TFunction<void(bool bOk, const TArray<FBatchTransactionResult>& Results, int32 ResponseCode)>;
+/** bOk is false for heights the node has not applied yet (404) */
+using FHazeOnBlock = TFunction<void(bool bOk, const FHazeBlockInfo& Block)>;
+using FHazeOnAsset = TFunction<void(bool bOk, const FHazeAssetInfo& Asset)>;
+/** One entry per requested id, in order; unknown ids have an empty AssetId */
+using FHazeOnAssetSummaries = TFunction<void(bool bOk, const TArray<FHazeAssetInfo>& Assets)>;
+using FHazeOnAssetSearchPage = TFunction<void(bool bOk, TSharedPtr<FHazeAssetPage, ESPMode::ThreadSafe> Page)>;
+using FHazeOnBlobDownload = TFunction<void(bool bOk, const FHazeBlobDownloadResult& Result)>;
+/** TotalBytes is -1 until the node has reported the blob size */
+using FHazeOnBlobProgress = TFunction<void(int64 BytesReceived, int64 TotalBytes)>;
+using FHazeOnLiquidityPools = TFunction<void(bool bOk, const TArray<FLiquidityPool>& Pools)>;
+using FHazeOnLiquidityPool = TFunction<void(bool bOk, const FLiquidityPool& Pool)>;
+using FHazeOnAssetVersions = TFunction<void(bool bOk, const FHazeAssetVersionsPage& Page)>;
+using FHazeOnAssetHistory = TFunction<void(bool bOk, const FHazeAssetHistoryPage& Page)>;
+/** bChanged false (Schedule left empty) when the node answered 304 for the version already held */
+using FHazeOnGasSchedule = TFunction<void(bool bOk, bool bChanged, const FHazeGasSchedule& Schedule)>;
+/** bChanged false (Snapshot empty) when the node answered 304 for the state root already held; Snapshot has a valid header */
+using FHazeOnAssetSnapshot = TFunction<void(bool bOk, bool bChanged, const TArray<uint8>& Snapshot)>;
+using FHazeOnSnapshotStale = TFunction<void(bool bOk, const FHazeSnapshotStalePage& Page)>;
 
 UCLASS(BlueprintType)
 class HAZEBLOCKCHAIN_API UHazeClient : public UObject
@@ -25,14 +73,95 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE")
 	FString BaseUrl;
 
+	/**
+	 * Several nodes to route between (each http(s)://host:port); empty means BaseUrl only. Reads go to the fastest
+	 * node that has caught up, submissions are spread across healthy nodes, and a request that fails in transport
+	 * is retried on the next best node. Nodes are probed in the background (/health and /api/v1/blockchain/info).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Nodes")
+	TArray<FString> NodeUrls;
+
+	/** Seconds between probes of each node (read when probing starts) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Nodes", meta = (ClampMin = "0.25"))
+	float NodeProbeIntervalSeconds = 2.f;
+
+	/** Blocks a node's last_finalized_height may trail the highest before reads avoid it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Nodes", meta = (ClampMin = "0"))
+	int32 MaxFinalizedLag = 2;
+
+	/** Timeout of a read while another node is left to fail over to (the last attempt uses TimeoutSeconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Nodes", meta = (ClampMin = "1"))
+	float FailoverTimeoutSeconds = 5.f;
+
 	/** Timeout in seconds */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "1", ClampMax = "120"))
 	int32 TimeoutSeconds = 30;
 
+	/**
+	 * Ask the node for gzip responses (Accept-Encoding). History, version and search responses shrink several times;
+	 * bodies are inflated on the background task that parses them. Blob downloads always use identity encoding.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE")
+	bool bRequestCompression = true;
+
+	/** Serve repeated GETs from a short-lived cache and share one request between identical concurrent GETs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Cache")
+	bool bEnableReadCache = false;
+
+	/** Seconds a result stays cached (0 = coalesce in-flight requests only) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Cache", meta = (ClampMin = "0"))
+	float HealthCacheSeconds = 5.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Cache", meta = (ClampMin = "0"))
+	float BlockchainInfoCacheSeconds = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Cache", meta = (ClampMin = "0"))
+	float BalanceCacheSeconds = 2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Cache", meta = (ClampMin = "0"))
+	float AccountCacheSeconds = 2.f;
+
+	/**
+	 * Requests of each EHazeRequestPriority class in flight at once; the rest wait in their class's queue. Separate
+	 * budgets keep background prefetches from delaying submissions and interactive reads. Applied to the scheduler
+	 * when set, so C++ changes them through the setters rather than by assignment.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMaxCriticalRequests, Category = "HAZE|Scheduling", meta = (ClampMin = "1"))
+	int32 MaxCriticalRequests = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMaxInteractiveRequests, Category = "HAZE|Scheduling", meta = (ClampMin = "1"))
+	int32 MaxInteractiveRequests = 6;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMaxBackgroundRequests, Category = "HAZE|Scheduling", meta = (ClampMin = "1"))
+	int32 MaxBackgroundRequests = 2;
+
+	UFUNCTION(BlueprintSetter)
+	void SetMaxCriticalRequests(int32 InMax);
+
+	UFUNCTION(BlueprintSetter)
+	void SetMaxInteractiveRequests(int32 InMax);
+
+	UFUNCTION(BlueprintSetter)
+	void SetMaxBackgroundRequests(int32 InMax);
+
+	/** Bytes per Range request when downloading blobs (memory held per download is about one chunk) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Blobs", meta = (ClampMin = "65536"))
+	int32 BlobChunkSizeBytes = 4 * 1024 * 1024;
+
 	/** Create client with base URL (Blueprint factory) */
 	UFUNCTION(BlueprintCallable, Category = "HAZE", meta = (DisplayName = "Create Haze Client"))
 	static UHazeClient* CreateClient(const FString& InBaseUrl);
 
+	/** Client routing across NodeUrls (BaseUrl is set to the first, e.g. for UHazeEventStream) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE", meta = (DisplayName = "Create Haze Multi-Node Client"))
+	static UHazeClient* CreateMultiNodeClient(const TArray<FString>& InNodeUrls);
+
+	/** Health, latency and sync height of each of NodeUrls, as routing sees them (empty for a single-node client) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Nodes")
+	TArray<FHazeNodeStatus> GetNodeStatus() const { return Router->GetStatus(); }
+
+	// Responses are decoded on a background task; delegates always fire on the game thread.
+
 	/** GET /health */
 	UFUNCTION(BlueprintCallable, Category = "HAZE")
 	void GetHealth(const FHazeHealthDelegate& OnComplete);
@@ -53,21 +182,248 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "HAZE")
 	void SendTransaction(const FString& TransactionJson, const FHazeTransactionDelegate& OnComplete);
 
-	/** One-shot GET health (for simple tests). Returns health string or empty on error. */
+	/** Largest batch the node accepts (MAX_TRANSACTION_BATCH in src/api.rs) */
+	static constexpr int32 MaxTransactionBatch = 1000;
+
+	/**
+	 * POST /api/v1/transactions/batch with body { "transactions": [ ... ] }. Each entry is an inner transaction object.
+	 * The node adds them to the pool in order, so consecutive nonces from one sender may share a batch.
+	 * Results are per transaction, in input order. Fails without sending if empty or above MaxTransactionBatch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void SendTransactionBatch(const TArray<FString>& TransactionJsons, const FHazeTransactionBatchDelegate& OnComplete);
+
+	/** GET /api/v1/blocks/height/{height}: header and transaction hashes (UHazeChainFollower tracks receipts with these) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blocks")
+	void GetBlockByHeight(int64 Height, const FHazeBlockDelegate& OnComplete);
+
+	/** GET /api/v1/assets/{id}: metadata, attributes and blob refs */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void GetAsset(const FString& AssetIdHex, const FHazeAssetDelegate& OnComplete);
+
+	/** Largest batch the node accepts (MAX_ASSET_SUMMARY_BATCH in src/api.rs) */
+	static constexpr int32 MaxAssetSummaryBatch = 256;
+
+	/**
+	 * POST /api/v1/assets/summaries: the Ethereal view (bIsSummary) of up to MaxAssetSummaryBatch assets in one request.
+	 * Summaries keep only the metadata that fits the Ethereal budget (smallest entries first) and no attributes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void GetAssetSummaries(const TArray<FString>& AssetIdsHex, const FHazeAssetSummariesDelegate& OnComplete);
+
+	/** Largest page the node returns for a search */
+	static constexpr int32 MaxAssetSearchPage = 1000;
+
+	/**
+	 * GET /api/v1/assets/search: returns a cursor over the matching assets (summary view, PageSize per request).
+	 * Nothing is requested until the cursor's first Next. Owner, GameId and Density filters combine; Text matches metadata.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Search")
+	UHazeAssetCursor* SearchAssets(const FHazeAssetSearchQuery& Query);
+
+	/**
+	 * Download a Core-density blob (GET /api/v1/assets/{id}/blob/{key}) into the local blob cache (FHazeBlobCache).
+	 * The expected SHA-256 is read from the asset's blob_refs; the file is fetched in BlobChunkSizeBytes ranges
+	 * straight to disk, resumed after interruptions, and only kept if it hashes to that value. Blobs already cached
+	 * (under any asset or version) complete immediately with bFromCache; concurrent downloads of one blob are shared.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Blobs")
+	void DownloadAssetBlob(const FString& AssetIdHex, const FString& BlobKey, const FHazeBlobDownloadDelegate& OnComplete);
+
+	/** GET /api/v1/economy/pools: every liquidity pool's reserves and fee (quote locally with FHazeAmm / UHazePoolBook) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Economy")
+	void GetLiquidityPools(const FHazeLiquidityPoolsDelegate& OnComplete);
+
+	/** GET /api/v1/economy/pools/{pool_id}. Fails for unknown pools (404). */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Economy")
+	void GetLiquidityPool(const FString& PoolId, const FHazeLiquidityPoolDelegate& OnComplete);
+
+	// C++ variants of the calls above; the Blueprint functions are implemented on top of these. HazeAsync.h wraps them as futures.
+
+	void FetchHealth(FHazeOnHealth OnComplete);
+	void FetchBlockchainInfo(FHazeOnBlockchainInfo OnComplete);
+	void FetchBalance(const FString& AddressHex, FHazeOnBalance OnComplete);
+	void FetchAccount(const FString& AddressHex, FHazeOnAccount OnComplete);
+	void SubmitTransaction(const FString& TransactionJson, FHazeOnTransaction OnComplete);
+	/** SubmitTransaction with a ready UTF-8 body, e.g. from FTransactionBuilder::WriteSignedMistbornCreateRequest; sent as is */
+	void SubmitTransactionBody(TArray<uint8> Body, FHazeOnTransaction OnComplete);
+	void SubmitTransactionBatch(const TArray<FString>& TransactionJsons, FHazeOnTransactionBatch OnComplete);
+	/**
+	 * SubmitTransaction / SubmitTransactionBatch with bincode bodies (FTransactionBuilder::Build*Binary), sent as
+	 * application/x-haze-bincode and answered in the same encoding. Roughly half the bytes of the hex JSON and no
+	 * JSON decode on either side. Fails without sending if a transaction is empty (its build failed).
+	 */
+	void SubmitTransactionBinary(TArray<uint8> Transaction, FHazeOnTransaction OnComplete);
+	void SubmitTransactionBatchBinary(const TArray<TArray<uint8>>& Transactions, FHazeOnTransactionBatch OnComplete);
+	/**
+	 * GET /api/v1/transactions/{hash} for a Transfer built by FTransactionBuilder, asked of the node its sender's
+	 * submissions go to. OnComplete gets true with the node's status (pending or executed) if that node has it.
+	 * Returns false without sending if the hash cannot be derived (FTransactionBuilder::TransferHash).
+	 */
+	bool FetchSubmittedTransaction(const FString& TransactionJson, FHazeOnTransaction OnComplete);
+	void FetchBlockByHeight(int64 Height, FHazeOnBlock OnComplete);
+	void FetchAsset(const FString& AssetIdHex, FHazeOnAsset OnComplete);
+	void FetchAssetSummaries(const TArray<FString>& AssetIdsHex, FHazeOnAssetSummaries OnComplete);
+	/** One page of a search starting at Offset, decoded into columns off the game thread (UHazeAssetCursor uses this) */
+	void FetchAssetSearchPage(const FHazeAssetSearchQuery& Query, int64 Offset, FHazeOnAssetSearchPage OnComplete);
+	void FetchAssetBlob(const FString& AssetIdHex, const FString& BlobKey, FHazeOnBlobDownload OnComplete, FHazeOnBlobProgress OnProgress = nullptr);
+	/** As FetchAssetBlob when the blob hash is already known (skips the asset lookup) */
+	void FetchBlob(const FString& AssetIdHex, const FString& BlobKey, const FString& BlobHashHex, FHazeOnBlobDownload OnComplete, FHazeOnBlobProgress OnProgress = nullptr);
+	void FetchLiquidityPools(FHazeOnLiquidityPools OnComplete);
+	void FetchLiquidityPool(const FString& PoolId, FHazeOnLiquidityPool OnComplete);
+	/** GET /api/v1/assets/{id}/versions?since=: versions after SinceVersion, blob refs as deltas (UHazeAssetVersionCache merges them) */
+	void FetchAssetVersionsSince(const FString& AssetIdHex, int64 SinceVersion, FHazeOnAssetVersions OnComplete);
+	/** GET /api/v1/assets/{id}/history?since=: up to Limit entries (0: all) from history index SinceIndex on */
+	void FetchAssetHistorySince(const FString& AssetIdHex, int64 SinceIndex, int32 Limit, FHazeOnAssetHistory OnComplete);
+	/** GET /api/v1/assets/gas-schedule, conditional on KnownVersion (0: unconditional); UHazeGasEstimator uses this */
+	void FetchGasSchedule(int64 KnownVersion, FHazeOnGasSchedule OnComplete);
+	/**
+	 * GET /api/v1/snapshots/assets?owner= (or ?game_id= with OwnerHex empty): binary asset snapshot (FHazeAssetSnapshot),
+	 * conditional on KnownStateRoot (empty: unconditional); UHazeAssetSnapshotStore uses this
+	 */
+	void FetchAssetSnapshot(const FString& OwnerHex, const FString& GameId, const FString& KnownStateRoot, FHazeOnAssetSnapshot OnComplete);
+
+	/** Largest staleness check the node accepts (MAX_SNAPSHOT_STALE_BATCH in src/api.rs) */
+	static constexpr int32 MaxSnapshotStaleBatch = 1024;
+
+	/** POST /api/v1/snapshots/assets/stale: which (asset id, fingerprint) snapshot entries no longer match the chain */
+	void FetchStaleSnapshotEntries(const TArray<TPair<FString, uint64>>& Entries, FHazeOnSnapshotStale OnComplete);
+
+	/** Drop cached balance and account for an address. Accepted submissions do this for their sender automatically. */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Cache")
+	void InvalidateAccount(const FString& AddressHex);
+
+	/** Drop every cached result */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Cache")
+	void InvalidateCache();
+
+	/** Invalidate from block_applied events: the touched accounts and blockchain info (subscribes Stream to BlockApplied) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Cache")
+	void BindCacheInvalidation(UHazeEventStream* Stream);
+
+	/** Latency (histogram percentiles and per-stage averages) and in-flight count of one endpoint. Cache hits are not requests. */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Stats")
+	FHazeEndpointStats GetEndpointStats(EHazeEndpoint Endpoint) const { return Metrics->GetStats(Endpoint); }
+
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Stats")
+	void ResetRequestStats() { Metrics->Reset(); }
+
+	/** C++: the full metrics, including raw histograms */
+	const FHazeRequestMetrics& GetRequestMetrics() const { return *Metrics; }
+
+	/** Requests of Priority waiting for a slot (they count as in flight in the endpoint stats, with the wait as QueuedMs) */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Stats")
+	int32 GetQueuedRequests(EHazeRequestPriority Priority) const { return Scheduler->GetQueued(Priority); }
+
+	/** Blueprint stub kept for existing graphs: returns at once with OutError "Use async GetHealth instead". Use GetHealth. */
 	UFUNCTION(BlueprintPure, Category = "HAZE")
 	static void GetHealthSync(const FString& BaseUrl, FString& OutHealth, FString& OutError);
 
+	/**
+	 * C++: one-shot blocking GET /health on BaseUrl, for tools and tests. Waits up to ten seconds for the engine's HTTP
+	 * tick, so it must not run on the game thread. Not routed, cached or counted. OutError is empty on success.
+	 * Gameplay code uses GetHealth, or HazeAsync::FetchHealth.
+	 */
+	static void GetHealthBlocking(const FString& BaseUrl, FString& OutHealth, FString& OutError);
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	virtual void BeginDestroy() override;
+
 private:
-	void OnHttpResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess,
-		TSharedPtr<FHazeHealthDelegate> OnHealth);
-	void OnHttpResponseBlockchain(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess,
-		TSharedPtr<FHazeBlockchainInfoDelegate> OnInfo);
-	void OnHttpResponseBalance(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess,
-		TSharedPtr<FHazeBalanceDelegate> OnBalance);
-	void OnHttpResponseAccount(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess,
-		TSharedPtr<FHazeAccountInfoDelegate> OnAccount);
-	void OnHttpResponseSendTx(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess,
-		TSharedPtr<FHazeTransactionDelegate> OnTx);
+	friend class FHazeRequestScope;
+	friend class UHazeAssetCursor;
+
+	/**
+	 * New request to the routed node (or BaseUrl) + Path; starts OutTrace (queued) and marks its first byte.
+	 * Submissions, and lookups of them, pass their Sender, which keeps every transaction of one account on one node.
+	 */
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const TCHAR* Verb, const FString& Path, EHazeEndpoint Endpoint,
+		FHazeRequestTrace& OutTrace, const FString& Sender = FString());
+
+	/**
+	 * Queue Request in its priority class and start it (marking Trace sent) once the class has a free slot; with
+	 * several nodes, transport failures are retried on another one while the slot is held. Sender as for CreateRequest.
+	 */
+	void SendRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, FHazeRequestTrace& Trace, const FString& Sender = FString());
+
+	/** Push MaxCriticalRequests and the other budgets to Scheduler */
+	void ApplyRequestBudgets();
+
+	/** Bring Router in line with NodeUrls; starts probing when there is more than one node */
+	void SyncNodes();
+	void ProbeNodes();
+	void ProbeNode(const FString& NodeUrl);
+
+	void RequestHealth(FHazeOnHealth OnComplete);
+	void RequestBlockchainInfo(FHazeOnBlockchainInfo OnComplete);
+	void RequestBalance(const FString& AddressHex, FHazeOnBalance OnComplete);
+	void RequestAccount(const FString& AddressHex, FHazeOnAccount OnComplete);
+
+	/**
+	 * Route a GET through Cache (member pointer, so completions can check the client is still alive). A caller
+	 * joining a flight still queued promotes it to its own priority and makes it unsupersedable.
+	 */
+	template <typename ValueType, typename SendFn>
+	void FetchCached(THazeReadCache<ValueType> UHazeClient::* Cache, EHazeEndpoint Endpoint, const FString& Key, float TtlSeconds,
+		TFunction<void(bool, const ValueType&)> OnComplete, SendFn&& Send);
+
+	/** Priority a request to Endpoint sent now gets (FHazeRequestScope, else the endpoint's default) */
+	EHazeRequestPriority CurrentPriority(EHazeEndpoint Endpoint) const;
+
+	void HandleStreamEvent(const FHazeStreamEvent& Event);
+
+	THazeReadCache<FString> HealthCache;
+	THazeReadCache<FBlockchainInfo> BlockchainInfoCache;
+	THazeReadCache<FHazeAmount> BalanceCache;
+	THazeReadCache<FAccountInfo> AccountCache;
+
+	TSharedRef<FHazeRequestMetrics, ESPMode::ThreadSafe> Metrics = MakeShared<FHazeRequestMetrics, ESPMode::ThreadSafe>();
+
+	/** Node choice across NodeUrls; shared so request completions can outlive the client safely */
+	TSharedRef<FHazeNodeRouter, ESPMode::ThreadSafe> Router = MakeShared<FHazeNodeRouter, ESPMode::ThreadSafe>();
+	FTSTicker::FDelegateHandle ProbeHandle;
+
+	/** Admission by priority class; shared so completions of requests in flight can free their slot */
+	TSharedRef<FHazeRequestScheduler, ESPMode::ThreadSafe> Scheduler = MakeShared<FHazeRequestScheduler, ESPMode::ThreadSafe>();
+	/** Set by FHazeRequestScope */
+	TOptional<EHazeRequestPriority> ScopedPriority;
+	FString ScopedSupersedeKey;
+	/** Scheduler ticket of the request SendRequest enqueued last */
+	uint64 LastTicket = 0;
+
+	/** Downloads in progress, by blob hash */
+	TMap<FString, TSharedPtr<FHazeBlobDownload, ESPMode::ThreadSafe>> BlobDownloads;
 
 	FString NormalizeBaseUrl() const;
 };
+
+/**
+ * Priority, and optionally a supersede key, for the requests a client sends while the scope is alive, in place of
+ * FHazeRequestScheduler::DefaultPriority. A queued read with the same supersede key is dropped (its callback gets
+ * bOk false) when a newer one is sent; submissions are never superseded.
+ *
+ *   {
+ *       FHazeRequestScope Scope(*Client, EHazeRequestPriority::Background);
+ *       Client->FetchAssetSummaries(Ids, ...);
+ *   }
+ *
+ * Only requests sent during the calls made inside the scope are covered; requests a call makes later (the chunks
+ * of a blob download, which are always Background) use their defaults. Scopes nest. Game thread only.
+ */
+class HAZEBLOCKCHAIN_API FHazeRequestScope
+{
+public:
+	FHazeRequestScope(UHazeClient& InClient, EHazeRequestPriority Priority, const FString& SupersedeKey = FString());
+	~FHazeRequestScope();
+
+	UE_NONCOPYABLE(FHazeRequestScope);
+
+private:
+	UHazeClient& Client;
+	TOptional<EHazeRequestPriority> PreviousPriority;
+	FString PreviousSupersedeKey;
+};
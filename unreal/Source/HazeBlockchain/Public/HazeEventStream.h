@@ -0,0 +1,116 @@
+// Copyright HAZE Blockchain. Persistent WebSocket client for /api/v1/ws.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HazeTypes.h"
+#include "HazeEventStream.generated.h"
+
+class IWebSocket;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeStreamEventDelegate, const FHazeStreamEvent&, Event);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazeStreamConnectionDelegate, bool, bConnected);
+DECLARE_MULTICAST_DELEGATE_OneParam(FHazeStreamEventNative, const FHazeStreamEvent&);
+
+/**
+ * Keeps one WebSocket to the node open and dispatches typed WsEvents.
+ *
+ * Messages are decoded on background tasks and delivered on the game thread in arrival order. The connection is
+ * re-established with exponential backoff after errors or closes, and the subscription list is re-sent on every
+ * connect. The node replaces its filter with each subscribe message; an empty list means "all events".
+ *
+ * The list is the union of every consumer's filters, so consumers sharing one stream must each subscribe to the
+ * types they handle (the Bind* helpers do); relying on the empty list breaks as soon as anyone else subscribes.
+ * Filters are reference counted: Unsubscribe drops one Subscribe, and the filter goes once nobody holds it.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeEventStream : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a stream for the node at BaseUrl (http(s)://host:port, as for UHazeClient) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE", meta = (DisplayName = "Create Haze Event Stream"))
+	static UHazeEventStream* CreateEventStream(const FString& InBaseUrl);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE")
+	FString BaseUrl;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "0.05"))
+	float InitialReconnectDelaySeconds = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "0.05"))
+	float MaxReconnectDelaySeconds = 30.f;
+
+	/** Every decoded event */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE")
+	FHazeStreamEventDelegate OnEvent;
+
+	/** Socket connected (true) or lost (false); reconnects are automatic while connected is wanted */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE")
+	FHazeStreamConnectionDelegate OnConnectionChanged;
+
+	/** C++: every decoded event, without reflection */
+	FHazeStreamEventNative& OnEventNative() { return EventNative; }
+
+	/** Open the socket (and keep it open until Disconnect) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void Connect();
+
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void Disconnect();
+
+	UFUNCTION(BlueprintPure, Category = "HAZE")
+	bool IsConnected() const;
+
+	/** Add a filter (or a reference to an equal one); sent to the node on the next tick (changes in one frame go out as one message) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void Subscribe(const FHazeStreamSubscription& Subscription);
+
+	/** Release one Subscribe of this filter */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void Unsubscribe(const FHazeStreamSubscription& Subscription);
+
+	/** Remove all filters (the node then sends every event) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void ClearSubscriptions();
+
+	UFUNCTION(BlueprintPure, Category = "HAZE")
+	TArray<FHazeStreamSubscription> GetSubscriptions() const { return Subscriptions; }
+
+	virtual void BeginDestroy() override;
+
+private:
+	void OpenSocket();
+	void CloseSocket();
+	void ScheduleReconnect();
+	void MarkSubscriptionsDirty();
+	void SendSubscriptions();
+	FString MakeWebSocketUrl() const;
+
+	void HandleConnected();
+	void HandleConnectionError(const FString& Error);
+	void HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
+	void HandleRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining);
+	void DeliverDecoded(uint64 Sequence, bool bOk, FHazeStreamEvent&& Event);
+
+	TSharedPtr<IWebSocket> Socket;
+	TArray<FHazeStreamSubscription> Subscriptions;
+	/** Subscribe calls holding each entry of Subscriptions */
+	TArray<int32> SubscriptionRefs;
+	FHazeStreamEventNative EventNative;
+
+	/** Fragments of the message being received */
+	TArray<uint8> Partial;
+
+	/** Decoding runs in parallel; deliveries are re-sequenced so handlers see arrival order */
+	uint64 NextDecodeSequence = 0;
+	uint64 NextDeliverSequence = 0;
+	TMap<uint64, TOptional<FHazeStreamEvent>> Decoded;
+
+	bool bWantConnected = false;
+	bool bConnected = false;
+	int32 ReconnectAttempt = 0;
+	FTSTicker::FDelegateHandle ReconnectHandle;
+	FTSTicker::FDelegateHandle FlushHandle;
+};
@@ -0,0 +1,115 @@
+// Copyright HAZE Blockchain. Local Mistborn gas estimates from the node's published gas schedule.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeAmount.h"
+#include "HazeTypes.h"
+#include "HazeClient.h"
+#include "HazeGasEstimator.generated.h"
+
+/** Cost of one Mistborn operation, as POST /api/v1/assets/estimate-gas answers it */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeGasQuote
+{
+	GENERATED_BODY()
+	/** False until a schedule has been fetched */
+	UPROPERTY(BlueprintReadOnly) bool bValid = false;
+	UPROPERTY(BlueprintReadOnly) int64 GasCost = 0;
+	/** GasCost * GasPrice, charged to the data owner */
+	UPROPERTY(BlueprintReadOnly) FHazeAmount GasFee;
+	UPROPERTY(BlueprintReadOnly) int64 GasPrice = 0;
+	/** Version of the schedule the quote was priced with (the node's schedule_version) */
+	UPROPERTY(BlueprintReadOnly) int64 ScheduleVersion = 0;
+};
+
+/**
+ * calculate_asset_operation_gas (src/assets.rs) without the round trip, kb being ceil(bytes / 1024):
+ *
+ *   Create, Update: base + per_kb * kb(bytes)          Evaporate: base
+ *   Condense: base * multiplier(density) + per_kb * kb(bytes)
+ *   Merge: base + per_kb * kb(2 * bytes if _other_asset_id is set, else bytes)
+ *   Split: base + per_component * n + per_kb * kb(bytes / n) * n, n = non-empty _components entries (1 without the key)
+ *
+ * bytes is the UTF-8 size of the metadata values, density the transaction's (target) density. 64-bit wrapping
+ * arithmetic, as the node's release build. Does not allocate.
+ */
+struct HAZEBLOCKCHAIN_API FHazeGasEstimate
+{
+	/** Sum of the UTF-8 lengths of the values */
+	static uint64 MetadataBytes(const TMap<FString, FString>& Metadata);
+
+	/** Entries of a _components list the node counts (non-empty after trimming) */
+	static uint64 CountComponents(FStringView Components);
+
+	/** Gas for an operation whose transaction carries Metadata (including _other_asset_id / _components) */
+	static uint64 GasCost(const FHazeGasSchedule& Schedule, EAssetAction Action, EDensityLevel Density, const TMap<FString, FString>& Metadata);
+
+	/** The same on precomputed inputs with no string work, for pricing many candidates */
+	static uint64 GasCost(const FHazeGasSchedule& Schedule, EAssetAction Action, EDensityLevel Density, uint64 MetadataBytes,
+		bool bHasOtherAsset, uint64 ComponentCount);
+
+	/** GasCost with its fee; invalid for a schedule that was never fetched */
+	static FHazeGasQuote MakeQuote(const FHazeGasSchedule& Schedule, uint64 GasCost);
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeGasScheduleRefreshedDelegate, bool, bSuccess, bool, bChanged);
+
+/**
+ * The node's gas schedule (GET /api/v1/assets/gas-schedule) held locally, so Condense / Merge / Split previews are
+ * priced without a request each (FHazeGasEstimate); a crafting screen can price every combination per frame.
+ *
+ *   Estimator->Refresh();   // on startup and whenever the schedule may have moved (reconnect, node switch)
+ *   const FHazeGasQuote Quote = Estimator->Estimate(EAssetAction::Condense, EDensityLevel::Core, Metadata);
+ *
+ * Refresh is a conditional GET: the node answers 304 with no body while the schedule version is unchanged, so
+ * the schedule itself is only transferred when it changes. NoteScheduleVersion refreshes when some other answer
+ * (estimate-gas's schedule_version) names a different version. Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeGasEstimator : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create an estimator that fetches through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets", meta = (DisplayName = "Create Haze Gas Estimator"))
+	static UHazeGasEstimator* CreateGasEstimator(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Assets")
+	TObjectPtr<UHazeClient> Client;
+
+	/** A Refresh finished; bChanged if a new schedule version was adopted */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Assets")
+	FHazeGasScheduleRefreshedDelegate OnRefreshed;
+
+	/** Revalidate the schedule; a Refresh already in flight runs once more when it finishes */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void Refresh();
+
+	/** Refresh if Version is not the schedule held (e.g. schedule_version from an estimate-gas answer) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Assets")
+	void NoteScheduleVersion(int64 Version);
+
+	/** A schedule has been fetched */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	bool IsReady() const { return Schedule.Version != 0; }
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	FHazeGasSchedule GetSchedule() const { return Schedule; }
+
+	/** What the node charges for Action with the transaction's Density and Metadata */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Assets")
+	FHazeGasQuote Estimate(EAssetAction Action, EDensityLevel Density, const TMap<FString, FString>& Metadata) const;
+
+	/** C++: Estimate on precomputed inputs (FHazeGasEstimate::MetadataBytes / CountComponents) */
+	FHazeGasQuote EstimateSized(EAssetAction Action, EDensityLevel Density, uint64 MetadataBytes, bool bHasOtherAsset = false,
+		uint64 ComponentCount = 1) const;
+
+	/** C++: adopt a schedule, as a fetch would; true if its version differs from the one held */
+	bool ApplySchedule(const FHazeGasSchedule& InSchedule);
+
+private:
+	FHazeGasSchedule Schedule;
+	bool bRefreshing = false;
+	bool bRefreshAgain = false;
+};
@@ -0,0 +1,40 @@
+// Copyright HAZE Blockchain. Lowercase hex codec for addresses, signatures, asset IDs and blob hashes.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Table-driven hex encoder/decoder shared by the whole plugin (SSE/NEON encode where available).
+ * Encoders write into caller buffers and never terminate them; decoders validate every digit.
+ * Calls are too short to time one by one; code that decodes in bulk opens the STAT_HazeHex scope around its loop.
+ */
+struct HAZEBLOCKCHAIN_API FHazeHex
+{
+	/** Write 2*Len lowercase hex TCHARs into Out. */
+	static void Encode(const uint8* Bytes, int32 Len, TCHAR* Out);
+
+	/** Write 2*Len lowercase hex UTF-8 code units into Out. */
+	static void Encode(const uint8* Bytes, int32 Len, UTF8CHAR* Out);
+
+	/** Bytes as a lowercase hex FString (one allocation). */
+	static FString ToHex(TArrayView<const uint8> Bytes);
+
+	/** Append lowercase hex to an existing FString. */
+	static void AppendHex(FString& Out, TArrayView<const uint8> Bytes);
+
+	/** Strict decode: Hex must be exactly 2*OutLen hex digits (either case, no whitespace). Out is unspecified on failure. */
+	static bool Decode(FStringView Hex, uint8* Out, int32 OutLen);
+
+	/**
+	 * Lenient decode: skips ASCII whitespace anywhere (pasted keys, trailing newlines).
+	 * Returns bytes written, or -1 on an invalid digit, an odd digit count or more than OutCapacity bytes.
+	 */
+	static int32 DecodeLenient(FStringView Hex, uint8* Out, int32 OutCapacity);
+
+	/** Lenient decode into a new array. Empty on invalid input. */
+	static TArray<uint8> ToBytes(FStringView Hex);
+
+	/** Value of one hex digit, or -1. */
+	static int32 DigitValue(TCHAR C);
+};
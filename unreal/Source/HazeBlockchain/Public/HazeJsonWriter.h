@@ -0,0 +1,58 @@
+// Copyright HAZE Blockchain. Single-pass UTF-8 JSON writer for request bodies.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Writes compact JSON as UTF-8 straight into a caller-owned byte array, ready for IHttpRequest::SetContent.
+ * Commas are inserted automatically; strings are escaped per RFC 8259 (quote, backslash, control characters)
+ * and converted from TCHAR in the same pass. Reusing the array across builds keeps its capacity, so a warm
+ * buffer builds a transaction without allocating.
+ *
+ * No validation of structure beyond comma placement: callers pair Begin/End and Key/value themselves.
+ */
+class HAZEBLOCKCHAIN_API FHazeJsonWriter
+{
+public:
+	/** Appends to Out (existing content is kept) */
+	explicit FHazeJsonWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+	void BeginObject();
+	void EndObject();
+	void BeginArray();
+	void EndArray();
+
+	/** Object key; the next value follows without a comma */
+	void Key(FStringView Name);
+	void String(FStringView Value);
+	/** Bytes as a lowercase hex string */
+	void Hex(TArrayView<const uint8> Bytes);
+	void Number(uint64 Value);
+	/** u64 as a decimal string (the node accepts both; strings survive JavaScript tooling) */
+	void NumberString(uint64 Value);
+	void Null();
+
+	/** An already-encoded JSON value (e.g. a transaction from FTransactionBuilder), appended as UTF-8 */
+	void RawValue(FStringView Json);
+	void RawValue(TArrayView<const uint8> Utf8Json);
+
+	// Shorthands for "Name": value
+
+	void Field(FStringView Name, FStringView Value) { Key(Name); String(Value); }
+	void HexField(FStringView Name, TArrayView<const uint8> Bytes) { Key(Name); Hex(Bytes); }
+	void NumberField(FStringView Name, uint64 Value) { Key(Name); Number(Value); }
+	/** Writes nothing when Value is unset (the node treats a missing key as None) */
+	void OptionalNumberField(FStringView Name, TOptional<uint64> Value) { if (Value.IsSet()) NumberField(Name, Value.GetValue()); }
+
+private:
+	void Separate();
+	void Ascii(const char* Text, int32 Len) { Out.Append(reinterpret_cast<const uint8*>(Text), Len); }
+	void AppendDigits(uint64 Value);
+	void AppendUtf8(FStringView Text, bool bEscape);
+
+	TArray<uint8>& Out;
+	/** One entry per open container: true once it holds a value */
+	TArray<bool, TInlineAllocator<8>> HasValue;
+	bool bAfterKey = false;
+};
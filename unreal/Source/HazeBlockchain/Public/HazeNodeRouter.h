@@ -0,0 +1,102 @@
+// Copyright HAZE Blockchain. Choice of node per request across several HAZE nodes.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeTypes.h"
+#include "HazeNodeRouter.generated.h"
+
+/** One node as the router currently sees it */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeNodeStatus
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) FString Url;
+	/** Answering; false after FailuresBeforeDown failed requests or probes in a row, until a probe succeeds */
+	UPROPERTY(BlueprintReadOnly) bool bHealthy = true;
+	/** last_finalized_height within MaxFinalizedLag of the highest among healthy nodes (reads only go to these) */
+	UPROPERTY(BlueprintReadOnly) bool bCaughtUp = true;
+	/** Smoothed /health round trip, or -1 before the first probe */
+	UPROPERTY(BlueprintReadOnly) float LatencyMs = -1.f;
+	/** -1 until /api/v1/blockchain/info has answered */
+	UPROPERTY(BlueprintReadOnly) int64 LastFinalizedHeight = -1;
+	UPROPERTY(BlueprintReadOnly) int64 CurrentHeight = -1;
+	UPROPERTY(BlueprintReadOnly) int32 ConsecutiveFailures = 0;
+	UPROPERTY(BlueprintReadOnly) int32 InFlight = 0;
+};
+
+/**
+ * Node selection for UHazeClient: reads go to the lowest-latency healthy node that has caught up, submissions to
+ * the healthy node with the fewest requests in flight (round robin on ties), each sender to the same one. Every Pick* falls back to a node that
+ * is down or behind rather than none, so a request is only refused once every node has been tried (Excluded).
+ * Game thread only.
+ */
+class HAZEBLOCKCHAIN_API FHazeNodeRouter
+{
+public:
+	/** Excluded masks are one bit per node */
+	static constexpr int32 MaxNodes = 64;
+
+	/** Blocks a node's last_finalized_height may trail the highest before reads skip it */
+	int64 MaxFinalizedLag = 2;
+
+	/** Failures in a row before a node counts as down */
+	int32 FailuresBeforeDown = 2;
+
+	/** Replace the node list (at most MaxNodes; trailing slashes dropped). State is kept for URLs already known. */
+	void SetNodes(const TArray<FString>& Urls);
+
+	/** True if Urls is the list last passed to SetNodes */
+	bool HasNodes(const TArray<FString>& Urls) const { return Configured == Urls; }
+
+	int32 Num() const { return Nodes.Num(); }
+	const FString& GetUrl(int32 Node) const { return Nodes[Node].Url; }
+
+	/** Node whose URL Url starts with, or INDEX_NONE */
+	int32 FindNode(const FString& Url) const;
+
+	int32 PickRead(uint64 Excluded = 0) const;
+	int32 PickSubmit(uint64 Excluded = 0);
+	/**
+	 * PickSubmit for Sender's transactions, which stay on the node the first one went to so its pool sees every nonce
+	 * in order. The sender moves only when that node is down or Excluded. An empty Sender picks like PickSubmit.
+	 */
+	int32 PickSubmitFor(const FString& Sender, uint64 Excluded = 0);
+
+	void MarkStarted(int32 Node);
+	/** bReached: the node answered (any status below 500); transport failures and 5xx count towards down */
+	void MarkFinished(int32 Node, bool bReached);
+
+	/** /health result; RoundTripMs is ignored on failure */
+	void RecordProbe(int32 Node, bool bHealthy, double RoundTripMs);
+	void RecordInfo(int32 Node, const FBlockchainInfo& Info);
+
+	/** A probe may start for Node (none is in flight); marks one as started */
+	bool BeginProbe(int32 Node);
+	void EndProbe(int32 Node);
+
+	bool IsCaughtUp(int32 Node) const;
+	TArray<FHazeNodeStatus> GetStatus() const;
+
+private:
+	struct FNode
+	{
+		FString Url;
+		double LatencyMs = -1.0;
+		int64 LastFinalizedHeight = -1;
+		int64 CurrentHeight = -1;
+		int32 Failures = 0;
+		int32 InFlight = 0;
+		bool bDown = false;
+		bool bProbing = false;
+	};
+
+	void RecordFailure(FNode& Node);
+	int64 HighestFinalized() const;
+
+	TArray<FNode> Nodes;
+	TArray<FString> Configured;
+	int32 NextSubmit = 0;
+	/** Lowercase sender address -> URL of the node its submissions go to */
+	TMap<FString, FString> SenderNodes;
+};
@@ -0,0 +1,97 @@
+// Copyright HAZE Blockchain. Local nonce allocation for pipelined transaction submission.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/SortedMap.h"
+
+class UHazeClient;
+
+/** Outcome of reconciling local nonce state with the node's account nonce. */
+struct FHazeNonceResync
+{
+	/** Nonce the next Reserve will return. */
+	uint64 NextNonce = 0;
+	/** Nonces now below the account nonce (executed on chain). */
+	TArray<uint64> Confirmed;
+	/**
+	 * Reserved nonces above the first gap. The node only accepts nonces in sequence, so these were (or will be)
+	 * rejected: rebuild and re-sign them with fresh nonces.
+	 */
+	TArray<uint64> Orphaned;
+	/** First nonce at or above the account nonce that the node never accepted; unset if there was no gap. */
+	TOptional<uint64> Gap;
+};
+
+/**
+ * Hands out nonces per address without a GetAccount round trip per transaction.
+ *
+ * Seed once from FAccountInfo::Nonce (the next nonce the chain expects), then Reserve a nonce for each transaction
+ * and report the node's answer. The node accepts nonce N only after N-1 is in its pool, so one rejection
+ * invalidates every reservation above it: the address stops handing out nonces until Resync reconciles it with
+ * the chain. Thread-safe; addresses are matched case-insensitively.
+ *
+ * Create with MakeShared (SyncFromNode keeps a weak reference across the request).
+ */
+class HAZEBLOCKCHAIN_API FHazeNonceManager : public TSharedFromThis<FHazeNonceManager, ESPMode::ThreadSafe>
+{
+public:
+	/** True once Seed or Resync has run for the address. */
+	bool IsSeeded(const FString& AddressHex) const;
+
+	/** True if a rejection left a gap; Reserve fails until Resync. */
+	bool NeedsResync(const FString& AddressHex) const;
+
+	/** Start handing out nonces from NextNonce. Ignored if the address is already seeded (use Resync). */
+	void Seed(const FString& AddressHex, uint64 NextNonce);
+
+	/** Take the next nonce. False if the address is unseeded or needs a resync. */
+	bool Reserve(const FString& AddressHex, uint64& OutNonce);
+
+	/** The node accepted the transaction with this nonce into its pool. */
+	void MarkAccepted(const FString& AddressHex, uint64 Nonce);
+
+	/** The node rejected the transaction, or it was abandoned. Flags the address for resync. */
+	void MarkRejected(const FString& AddressHex, uint64 Nonce);
+
+	/** The transaction with this nonce is no longer tracked (e.g. seen in a block). */
+	void MarkConfirmed(const FString& AddressHex, uint64 Nonce);
+
+	/**
+	 * Reconcile with the node's account nonce (FAccountInfo::Nonce). Pending nonces below it are confirmed;
+	 * accepted nonces continuing from it stay pending; the first never-accepted nonce is the gap and NextNonce
+	 * restarts there. Seeds the address if needed.
+	 */
+	FHazeNonceResync Resync(const FString& AddressHex, uint64 AccountNonce);
+
+	/** Fetch the account from the node and Resync. OnComplete(bOk, Result) fires on the game thread. */
+	void SyncFromNode(UHazeClient* Client, const FString& AddressHex, TFunction<void(bool bOk, const FHazeNonceResync& Result)> OnComplete);
+
+	/** Reserved or accepted nonces not yet confirmed. */
+	int32 GetPendingCount(const FString& AddressHex) const;
+
+	/** Forget the address (e.g. wallet unloaded). */
+	void Remove(const FString& AddressHex);
+
+private:
+	enum class ENonceState : uint8
+	{
+		Reserved,
+		Accepted,
+		Rejected
+	};
+
+	struct FAccountNonces
+	{
+		uint64 NextNonce = 0;
+		/** Pending nonces in ascending order (allocated sequentially) */
+		TSortedMap<uint64, ENonceState> Pending;
+		bool bNeedsResync = false;
+	};
+
+	static FString KeyFor(const FString& AddressHex);
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FAccountNonces> Accounts;
+};
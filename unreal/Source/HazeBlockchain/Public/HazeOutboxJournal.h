@@ -0,0 +1,100 @@
+// Copyright HAZE Blockchain. Crash-safe journal of signed transactions not yet answered by the node.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class IFileHandle;
+
+/** One journaled transaction */
+struct FHazeOutboxEntry
+{
+	uint64 Id = 0;
+	/** UHazeTxSubmitter ordering key (normally the sender address) */
+	FString OrderingKey;
+	TOptional<uint64> Nonce;
+	/** EHazeTxPriority */
+	uint8 Priority = 1;
+	/** Inner transaction JSON, as passed to SubmitTransaction */
+	FString TransactionJson;
+};
+
+/**
+ * Append-only outbox under Saved/Haze/<Name>.journal. Each signed transaction is recorded before it is sent and
+ * acknowledged once the node has answered; whatever an earlier session left unacknowledged is recovered on Open
+ * (UHazeTxSubmitter::ReplayOutbox sends it again).
+ *
+ * Records are written to the OS as they are appended, so a crash of the process loses nothing. The sync to disk
+ * (which also covers power loss) runs on a background task at most every SyncIntervalSeconds, for all records
+ * appended since, so a submission only waits for the disk when it lands during a sync. Every record carries a CRC;
+ * a torn record at the end of the file (crash mid-write) and everything after it is ignored. Open reads the old file
+ * memory-mapped and rewrites it with the unacknowledged entries only; the file is also truncated whenever nothing is
+ * pending and it has grown past CompactBytes. A journal Open cannot read at all is moved aside to <Name>.journal.<time>.unread
+ * rather than truncated.
+ *
+ * Thread-safe. Create with Open.
+ */
+class HAZEBLOCKCHAIN_API FHazeOutboxJournal : public TSharedFromThis<FHazeOutboxJournal, ESPMode::ThreadSafe>
+{
+public:
+	/** Size at which a journal with nothing pending is truncated */
+	static constexpr int64 CompactBytes = 4 * 1024 * 1024;
+
+	/** Saved/Haze */
+	static FString GetJournalDirectory();
+
+	/** Saved/Haze/<Name>.journal */
+	static FString GetJournalPath(const FString& Name);
+
+	/** Recover, compact and open the journal for appending. Null if the file cannot be written, or is unreadable and cannot be moved aside. */
+	static TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Open(const FString& Name = TEXT("Outbox"), float SyncIntervalSeconds = 0.1f);
+
+	/** Syncs and closes the file */
+	~FHazeOutboxJournal();
+
+	/** Record a transaction before it is sent. Returns its id, or 0 if the write failed. */
+	uint64 Append(const FString& OrderingKey, TOptional<uint64> Nonce, uint8 Priority, const FString& TransactionJson);
+
+	/** The node answered (accepted or rejected) or the caller gave the transaction up: it will not be recovered */
+	void Acknowledge(uint64 Id);
+
+	/** Entries earlier sessions left unacknowledged, in append order. Each is handed out once; they stay pending until acknowledged. */
+	TArray<FHazeOutboxEntry> TakeRecovered();
+
+	/** Appended or recovered, and not acknowledged */
+	int32 GetPendingCount() const;
+
+	/** Bytes in the journal file */
+	int64 GetFileSize() const;
+
+	/** Sync to disk now (blocking; Append and Acknowledge wait for it). The batched sync calls this off the game thread. */
+	void Sync();
+
+	/**
+	 * Unacknowledged entries in journal bytes, in append order; OutMaxId is the highest id seen. Stops at the first bad
+	 * record; OutReadBytes is the length of the whole records before it.
+	 */
+	static TArray<FHazeOutboxEntry> ReadPending(TArrayView<const uint8> Data, uint64& OutMaxId, int32* OutReadBytes = nullptr);
+
+private:
+	FHazeOutboxJournal() = default;
+
+	/** Caller holds Lock */
+	bool WriteRecord(uint8 Kind, const TArray<uint8>& Payload);
+	void StartSyncTicker(float IntervalSeconds);
+
+	mutable FCriticalSection Lock;
+	FString Path;
+	TUniquePtr<IFileHandle> File;
+	TSet<uint64> Pending;
+	TArray<FHazeOutboxEntry> Recovered;
+	uint64 NextId = 1;
+	int64 Size = 0;
+	/** Written since the last sync */
+	bool bDirty = false;
+	std::atomic<bool> bSyncQueued{false};
+	FTSTicker::FDelegateHandle SyncHandle;
+};
@@ -0,0 +1,93 @@
+// Copyright HAZE Blockchain. Local snapshot of the node's liquidity pools, for instant swap quotes.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeAmm.h"
+#include "HazeClient.h"
+#include "HazePoolBook.generated.h"
+
+class UHazeEventStream;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazePoolUpdatedDelegate, const FLiquidityPool&, Pool);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHazePoolBookRefreshedDelegate, bool, bSuccess);
+
+/**
+ * Every pool from GET /api/v1/economy/pools, kept current by pool_updated events so swap quotes are computed
+ * locally (FHazeAmm) instead of asking the node per keystroke. Refresh once, bind an event stream, then quote:
+ *
+ *   Book->Refresh();
+ *   Book->BindEventStream(Stream);
+ *   const FHazeSwapQuote Quote = Book->QuoteSwap(PoolId, TEXT("HAZE"), AmountIn);
+ *
+ * Events that land while a refresh is in flight win over the (older) snapshot. Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazePoolBook : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a book that fetches through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Economy", meta = (DisplayName = "Create Haze Pool Book"))
+	static UHazePoolBook* CreatePoolBook(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE|Economy")
+	TObjectPtr<UHazeClient> Client;
+
+	/** A pool's reserves changed (event, refresh or RefreshPool) */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Economy")
+	FHazePoolUpdatedDelegate OnPoolUpdated;
+
+	/** A full Refresh finished */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE|Economy")
+	FHazePoolBookRefreshedDelegate OnRefreshed;
+
+	/** Replace the snapshot with every pool on the node */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Economy")
+	void Refresh();
+
+	/** Refetch one pool (e.g. after the node reported a failed swap) */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Economy")
+	void RefreshPool(const FString& PoolId);
+
+	/** Apply pool_updated events from Stream, and subscribe it to them */
+	UFUNCTION(BlueprintCallable, Category = "HAZE|Economy")
+	void BindEventStream(UHazeEventStream* Stream);
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Economy")
+	bool GetPool(const FString& PoolId, FLiquidityPool& OutPool) const;
+
+	/** The pool trading AssetA against AssetB, in either order */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Economy")
+	bool FindPool(const FString& AssetA, const FString& AssetB, FLiquidityPool& OutPool) const;
+
+	UFUNCTION(BlueprintPure, Category = "HAZE|Economy")
+	TArray<FLiquidityPool> GetPools() const;
+
+	/** What swapping AmountIn of AssetIn pays out right now */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Economy")
+	FHazeSwapQuote QuoteSwap(const FString& PoolId, const FString& AssetIn, const FHazeAmount& AmountIn) const;
+
+	/** The least AssetIn that pays at least AmountOut of the other asset */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Economy")
+	FHazeSwapQuote QuoteSwapForOutput(const FString& PoolId, const FString& AssetIn, const FHazeAmount& AmountOut) const;
+
+	/** Bumped on every change; a cached quote is current while this is unchanged */
+	UFUNCTION(BlueprintPure, Category = "HAZE|Economy")
+	int64 GetRevision() const { return Revision; }
+
+	/** C++: the pool, or null (valid until the book next changes) */
+	const FLiquidityPool* FindPoolById(const FString& PoolId) const { return Pools.Find(PoolId); }
+
+	/** C++: fold in one pool's state, as an event or fetch would */
+	void ApplyPool(const FLiquidityPool& Pool);
+
+private:
+	void HandleStreamEvent(const FHazeStreamEvent& Event);
+
+	TMap<FString, FLiquidityPool> Pools;
+	/** Pools changed by events since the in-flight Refresh was sent; the snapshot must not roll them back */
+	TSet<FString> ChangedDuringRefresh;
+	int32 RefreshesInFlight = 0;
+	int64 Revision = 0;
+};
@@ -0,0 +1,147 @@
+// Copyright HAZE Blockchain. TTL cache with single-flight request coalescing.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Per-key cache of typed GET results. Concurrent requests for a missing or expired key share one in-flight
+ * request; every waiter gets its result. A key invalidated while in flight still fans out the result it gets,
+ * but that result is not cached. Game thread only.
+ */
+template <typename ValueType>
+class THazeReadCache
+{
+public:
+	using FCallback = TFunction<void(bool bOk, const ValueType& Value)>;
+
+	/** Entries kept before expired ones are pruned. */
+	static constexpr int32 PruneThreshold = 1024;
+
+	/** Cached value for Key if it has not expired. */
+	const ValueType* FindFresh(const FString& Key, double Now) const
+	{
+		const FEntry* Entry = Entries.Find(Key);
+		return Entry && Entry->bHasValue && Now < Entry->ExpiresAt ? &Entry->Value : nullptr;
+	}
+
+	/**
+	 * Queue Callback for Key. Returns true if a request is already in flight (the caller must not send another);
+	 * otherwise starts a flight that the caller completes with Complete.
+	 */
+	bool JoinOrStart(const FString& Key, FCallback&& Callback, double Now)
+	{
+		if (FEntry* Existing = Entries.Find(Key))
+		{
+			Existing->Waiters.Add(MoveTemp(Callback));
+			if (Existing->bInFlight) return true;
+			Existing->bInFlight = true;
+			Existing->bInvalidated = false;
+			Existing->FlightTag = 0;
+			return false;
+		}
+		if (Entries.Num() >= PruneThreshold)
+		{
+			Prune(Now);
+		}
+		FEntry& Entry = Entries.Add(Key);
+		Entry.Waiters.Add(MoveTemp(Callback));
+		Entry.bInFlight = true;
+		return false;
+	}
+
+	/** End the flight for Key, caching Value for TtlSeconds if bOk. Returns the callbacks to invoke. */
+	TArray<FCallback> Complete(const FString& Key, bool bOk, const ValueType& Value, double Now, double TtlSeconds)
+	{
+		FEntry* Entry = Entries.Find(Key);
+		if (!Entry) return {};
+
+		TArray<FCallback> Waiters = MoveTemp(Entry->Waiters);
+		Entry->Waiters.Reset();
+		Entry->bInFlight = false;
+		Entry->FlightTag = 0;
+		if (bOk && !Entry->bInvalidated && TtlSeconds > 0.0)
+		{
+			Entry->Value = Value;
+			Entry->bHasValue = true;
+			Entry->ExpiresAt = Now + TtlSeconds;
+		}
+		else if (!Entry->bHasValue || Entry->bInvalidated)
+		{
+			Entries.Remove(Key);
+		}
+		return Waiters;
+	}
+
+	/** Tag the flight for Key with the request behind it (UHazeClient stores its scheduler ticket) */
+	void SetFlightTag(const FString& Key, uint64 Tag)
+	{
+		FEntry* Entry = Entries.Find(Key);
+		if (Entry && Entry->bInFlight) Entry->FlightTag = Tag;
+	}
+
+	/** Tag of the flight for Key, 0 if none is in flight or it was never tagged */
+	uint64 GetFlightTag(const FString& Key) const
+	{
+		const FEntry* Entry = Entries.Find(Key);
+		return Entry && Entry->bInFlight ? Entry->FlightTag : 0;
+	}
+
+	/** Drop the cached value for Key; an in-flight result for it will be delivered but not cached. */
+	void Invalidate(const FString& Key)
+	{
+		if (FEntry* Entry = Entries.Find(Key))
+		{
+			if (Entry->bInFlight)
+			{
+				Entry->bHasValue = false;
+				Entry->bInvalidated = true;
+			}
+			else
+			{
+				Entries.Remove(Key);
+			}
+		}
+	}
+
+	void InvalidateAll()
+	{
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (It.Value().bInFlight)
+			{
+				It.Value().bHasValue = false;
+				It.Value().bInvalidated = true;
+			}
+			else
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+private:
+	struct FEntry
+	{
+		ValueType Value{};
+		double ExpiresAt = 0.0;
+		bool bHasValue = false;
+		bool bInFlight = false;
+		bool bInvalidated = false;
+		uint64 FlightTag = 0;
+		TArray<FCallback> Waiters;
+	};
+
+	void Prune(double Now)
+	{
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().bInFlight && Now >= It.Value().ExpiresAt)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	TMap<FString, FEntry> Entries;
+};
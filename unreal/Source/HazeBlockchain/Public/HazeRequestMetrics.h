@@ -0,0 +1,92 @@
+// Copyright HAZE Blockchain. Per-endpoint request latency and in-flight tracking.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeTypes.h"
+
+class FHazeRequestMetrics;
+
+/**
+ * Timestamps of one request through queued -> sent -> first byte -> complete -> parsed -> delegate.
+ * Copies share state. Mark* calls happen on the game thread except MarkParsed, which runs on the decode task
+ * before the result is handed back. A default-constructed trace records nothing.
+ */
+class HAZEBLOCKCHAIN_API FHazeRequestTrace
+{
+public:
+	FHazeRequestTrace() = default;
+
+	void MarkSent();
+	/** First response header; later calls are ignored */
+	void MarkFirstByte();
+	void MarkCompleted(int64 BytesReceived);
+	void MarkParsed();
+	/** Record the request; call once, right before the delegate */
+	void Finish(bool bOk);
+
+	/** Endpoint being timed (EHazeEndpoint::Count for a default-constructed trace) */
+	EHazeEndpoint GetEndpoint() const { return State.IsValid() ? State->Endpoint : EHazeEndpoint::Count; }
+
+private:
+	friend class FHazeRequestMetrics;
+
+	struct FState
+	{
+		EHazeEndpoint Endpoint = EHazeEndpoint::Health;
+		TWeakPtr<FHazeRequestMetrics, ESPMode::ThreadSafe> Metrics;
+		double Queued = 0.0;
+		double Sent = 0.0;
+		double FirstByte = 0.0;
+		double Completed = 0.0;
+		double Parsed = 0.0;
+		int64 Bytes = 0;
+		bool bFinished = false;
+	};
+	TSharedPtr<FState, ESPMode::ThreadSafe> State;
+};
+
+/**
+ * Latency histograms and in-flight counts per EHazeEndpoint, owned by a UHazeClient. Game thread only.
+ * Buckets are fixed (1ms to 10s, roughly 1-2-5) so recording never allocates.
+ */
+class HAZEBLOCKCHAIN_API FHazeRequestMetrics : public TSharedFromThis<FHazeRequestMetrics, ESPMode::ThreadSafe>
+{
+public:
+	static constexpr int32 NumBuckets = 14;
+	/** Upper bound of each bucket in milliseconds; the last bucket is unbounded */
+	static const float BucketUpperMs[NumBuckets];
+
+	/** Start timing a request (queued now) */
+	FHazeRequestTrace Begin(EHazeEndpoint Endpoint);
+
+	FHazeEndpointStats GetStats(EHazeEndpoint Endpoint) const;
+	/** Requests per latency bucket (sent to delegate) */
+	TArrayView<const uint32> GetHistogram(EHazeEndpoint Endpoint) const;
+	int32 GetTotalInFlight() const { return TotalInFlight; }
+	/** Clear counts and histograms; requests in flight stay counted */
+	void Reset();
+
+private:
+	friend class FHazeRequestTrace;
+
+	struct FEndpoint
+	{
+		int32 InFlight = 0;
+		int64 Completed = 0;
+		int64 Failed = 0;
+		int64 Bytes = 0;
+		double TotalSeconds = 0.0;
+		double QueuedSeconds = 0.0;
+		double FirstByteSeconds = 0.0;
+		double TransferSeconds = 0.0;
+		double ParseSeconds = 0.0;
+		double DispatchSeconds = 0.0;
+		uint32 Buckets[NumBuckets] = {};
+	};
+
+	void Record(const FHazeRequestTrace::FState& State, bool bOk, double Now);
+
+	FEndpoint Endpoints[static_cast<int32>(EHazeEndpoint::Count)];
+	int32 TotalInFlight = 0;
+};
@@ -0,0 +1,82 @@
+// Copyright HAZE Blockchain. Priority classes and concurrency budgets for a client's requests.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HazeTypes.h"
+
+/**
+ * Admission of UHazeClient requests to the network. Every EHazeRequestPriority class has its own budget of requests
+ * in flight; a request over budget waits in its class's queue (first in, first out) until one of the same class
+ * finishes. The budgets are separate, so a burst of background prefetches never holds the slots a submission or a
+ * balance check needs, and keeping their sum under the engine's per-server connection limit lets requests reuse the
+ * connections already open to each node instead of queueing inside the HTTP stack.
+ *
+ * A request enqueued with a supersede key drops the earlier one with the same key if it is still queued (a newer
+ * read makes it pointless); one already sent is left to finish. A request several callers wait on (a coalesced read)
+ * is Shared: it is never superseded, and Promote moves it up when a more urgent caller joins. Game thread only.
+ */
+class HAZEBLOCKCHAIN_API FHazeRequestScheduler
+{
+public:
+	/** Class of a request when the caller did not pick one: submissions are Critical, sync and prefetch Background */
+	static EHazeRequestPriority DefaultPriority(EHazeEndpoint Endpoint);
+
+	FHazeRequestScheduler();
+
+	/** Requests of Priority allowed in flight at once (at least 1); a raised budget starts queued requests at once */
+	void SetBudget(EHazeRequestPriority Priority, int32 MaxInFlight);
+	int32 GetBudget(EHazeRequestPriority Priority) const;
+
+	/**
+	 * Run Start with the request's ticket now if Priority has a free slot, otherwise when one frees up; the request
+	 * holds its slot until Finish(Ticket). With SupersedeKey set, a queued request with the same key is removed and
+	 * its OnSuperseded runs (synchronously, so callers defer their own completion). Returns the ticket.
+	 */
+	uint64 Enqueue(EHazeRequestPriority Priority, const FString& SupersedeKey, TFunction<void(uint64 Ticket)> Start,
+		TFunction<void()> OnSuperseded);
+
+	/** The request finished; frees its slot and starts whatever the free slots allow. Unknown tickets are ignored. */
+	void Finish(uint64 Ticket);
+
+	/** A caller of Priority now waits on Ticket too: a queued request moves to the back of that class if it is more urgent */
+	void Promote(uint64 Ticket, EHazeRequestPriority Priority);
+
+	/** Ticket has more than one caller: superseding it would fail the others, so its supersede key is cleared */
+	void Share(uint64 Ticket);
+
+	/** Drop every queued request, running its OnSuperseded; requests in flight keep their slots */
+	void CancelQueued();
+
+	int32 GetInFlight(EHazeRequestPriority Priority) const;
+	int32 GetQueued(EHazeRequestPriority Priority) const;
+
+private:
+	struct FQueued
+	{
+		uint64 Ticket = 0;
+		FString SupersedeKey;
+		TFunction<void(uint64)> Start;
+		TFunction<void()> OnSuperseded;
+	};
+
+	struct FClass
+	{
+		int32 Budget = 1;
+		int32 InFlight = 0;
+		TArray<FQueued> Queue;
+	};
+
+	/** Start queued requests, most urgent class first, while their class has a free slot */
+	void Pump();
+
+	/** The queued request with Ticket, or null (started, finished or unknown) */
+	FQueued* FindQueued(uint64 Ticket, int32& OutClass);
+
+	FClass Classes[static_cast<int32>(EHazeRequestPriority::Count)];
+	/** Class of each request in flight, by ticket */
+	TMap<uint64, EHazeRequestPriority> Running;
+	uint64 NextTicket = 1;
+	/** Pump is on the stack; a Start that enqueues or finishes leaves the remaining work to it */
+	bool bPumping = false;
+};
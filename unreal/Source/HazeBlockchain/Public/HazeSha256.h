@@ -0,0 +1,40 @@
+// Copyright HAZE Blockchain. Incremental SHA-256 (blob hashes, as crate::types::sha256 on the node).
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Streaming SHA-256: feed data in any number of Update calls, then Final once.
+ * Used to verify Core-density blobs as they are written to disk, without holding them in memory.
+ * Not thread-safe; one instance per stream.
+ */
+class HAZEBLOCKCHAIN_API FHazeSha256
+{
+public:
+	static constexpr int32 DigestSize = 32;
+
+	FHazeSha256() { Reset(); }
+
+	void Reset();
+
+	void Update(const uint8* Data, int64 Len);
+	void Update(TArrayView<const uint8> Data) { Update(Data.GetData(), Data.Num()); }
+
+	/** Write the digest to OutDigest (DigestSize bytes). The hasher must be Reset before reuse. */
+	void Final(uint8* OutDigest);
+
+	/** Digest as lowercase hex (matches the node's hash_to_hex). */
+	FString FinalHex();
+
+	/** One-shot digest of Data as lowercase hex. */
+	static FString HashHex(TArrayView<const uint8> Data);
+
+private:
+	void Transform(const uint8* Block);
+
+	uint32 State[8];
+	uint8 Buffer[64];
+	uint64 TotalLen = 0;
+	int32 BufferLen = 0;
+};
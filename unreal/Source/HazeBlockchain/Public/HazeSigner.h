@@ -0,0 +1,84 @@
+// Copyright HAZE Blockchain. Expanded Ed25519 signing key, derived once per seed.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FHazeSignerContext;
+
+/**
+ * Non-owning signing key: a public key and the expanded secret held elsewhere (FHazeSignerContext, FHazeWalletPool).
+ * Valid while its owner keeps the key; safe to sign with from any thread.
+ */
+struct HAZEBLOCKCHAIN_API FHazeSignerView
+{
+	FHazeSignerView() = default;
+	FHazeSignerView(const uint8* InPublicKey, const uint8* InExpandedKey) : PublicKey(InPublicKey), ExpandedKey(InExpandedKey) {}
+	/** View of an initialized context (invalid view otherwise) */
+	FHazeSignerView(const FHazeSignerContext& Context);
+
+	bool IsValid() const { return PublicKey && ExpandedKey; }
+
+	/** 32 bytes (the address) */
+	TArrayView<const uint8> GetPublicKey() const;
+
+	/** Sign Message into OutSignature (64 bytes). Returns false if the view is invalid or Ed25519 is not available. */
+	bool Sign(const uint8* Message, int32 MessageLen, uint8* OutSignature) const;
+
+	const uint8* PublicKey = nullptr;
+	const uint8* ExpandedKey = nullptr;
+};
+
+/**
+ * Holds the 64-byte expanded Ed25519 secret and the 32-byte public key for one seed.
+ * ed25519_seed_keypair (SHA-512 + scalar-base multiplication) runs once in Initialize;
+ * every Sign after that only pays for the signature itself.
+ * Key material lives in a page-locked allocation (best effort) and is zeroized on Reset / destruction.
+ */
+class HAZEBLOCKCHAIN_API FHazeSignerContext
+{
+public:
+	static constexpr int32 SeedSize = 32;
+	static constexpr int32 PublicKeySize = 32;
+	static constexpr int32 ExpandedKeySize = 64;
+	static constexpr int32 SignatureSize = 64;
+
+	FHazeSignerContext() = default;
+	~FHazeSignerContext();
+
+	FHazeSignerContext(const FHazeSignerContext&) = delete;
+	FHazeSignerContext& operator=(const FHazeSignerContext&) = delete;
+
+	/** Derive expanded key and public key from a 32-byte seed. Returns false if Ed25519 is not available. */
+	bool Initialize(const uint8* Seed);
+
+	/** Derive into caller-held buffers (32-byte public key, 64-byte expanded key). Returns false if Ed25519 is not available. */
+	static bool DeriveKeys(const uint8* Seed, uint8* OutPublicKey, uint8* OutExpandedKey);
+
+	/** Zeroize and release key material. */
+	void Reset();
+
+	/** True once Initialize succeeded. */
+	bool IsValid() const { return Secret != nullptr; }
+
+	/** True if this context was derived from the given 32-byte seed (constant-time compare). */
+	bool MatchesSeed(const uint8* Seed) const;
+
+	/** 32-byte public key, or nullptr if not initialized. */
+	const uint8* GetPublicKey() const;
+
+	/** Sign Message into OutSignature (64 bytes). Returns false if not initialized. Safe to call from any thread. */
+	bool Sign(const uint8* Message, int32 MessageLen, uint8* OutSignature) const;
+
+private:
+	friend struct FHazeSignerView;
+
+	struct FSecret
+	{
+		uint8 Seed[SeedSize];
+		uint8 ExpandedKey[ExpandedKeySize];
+		uint8 PublicKey[PublicKeySize];
+	};
+
+	FSecret* Secret = nullptr;
+};
@@ -0,0 +1,35 @@
+// Copyright HAZE Blockchain. Stat group and trace channel for plugin hot paths.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * `stat Haze` shows the cycle stats below next to game code; Unreal Insights shows the same scopes on the
+ * Haze trace channel (enable with -trace=cpu,haze or `Trace.Enable Haze`) plus request counters.
+ * Everything compiles out with stats and trace disabled (Shipping).
+ */
+DECLARE_STATS_GROUP(TEXT("HAZE"), STATGROUP_Haze, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build signing payload"), STAT_HazeBuildPayload, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sign (Ed25519)"), STAT_HazeSign, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hex encode/decode"), STAT_HazeHex, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build transaction JSON"), STAT_HazeBuildJson, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build transaction bincode"), STAT_HazeBuildBinary, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inflate response"), STAT_HazeInflate, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse response"), STAT_HazeParse, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Deliver result"), STAT_HazeDeliver, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests in flight"), STAT_HazeRequestsInFlight, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Requests completed"), STAT_HazeRequestsCompleted, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes received"), STAT_HazeBytesReceived, STATGROUP_Haze, HAZEBLOCKCHAIN_API);
+
+UE_TRACE_CHANNEL_EXTERN(HazeChannel, HAZEBLOCKCHAIN_API);
+
+/** Cycle stat plus an Insights scope named TraceName on the Haze channel */
+#define HAZE_SCOPE(StatId, TraceName) \
+	SCOPE_CYCLE_COUNTER(StatId); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(TraceName, HazeChannel)
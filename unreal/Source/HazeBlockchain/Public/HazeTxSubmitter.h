@@ -0,0 +1,249 @@
+// Copyright HAZE Blockchain. Windowed transaction submission with retries and backpressure.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HazeClient.h"
+#include "HazeOutboxJournal.h"
+#include "HazeTxSubmitter.generated.h"
+
+UENUM(BlueprintType)
+enum class EHazeTxPriority : uint8
+{
+	Low = 0,
+	Normal = 1,
+	High = 2
+};
+
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeTxSubmitterStats
+{
+	GENERATED_BODY()
+	/** Queued, waiting behind an earlier tx with the same ordering key, or backing off before a retry */
+	UPROPERTY(BlueprintReadOnly) int32 QueueDepth = 0;
+	UPROPERTY(BlueprintReadOnly) int32 InFlight = 0;
+	/** Current in-flight limit; shrinks below MaxInFlight while the node answers 429/503 */
+	UPROPERTY(BlueprintReadOnly) int32 Window = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Accepted = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Rejected = 0;
+	/** Failed without being sent because an earlier tx with the same ordering key failed */
+	UPROPERTY(BlueprintReadOnly) int64 Dropped = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Retries = 0;
+	/** Accepted transactions per second (smoothed over ~1s samples) */
+	UPROPERTY(BlueprintReadOnly) float AcceptedPerSecond = 0.f;
+};
+
+/** Sends one transaction and reports the outcome as UHazeClient::SubmitTransaction does */
+using FHazeTxTransport = TFunction<void(const FString& TransactionJson, FHazeOnTransaction OnComplete)>;
+
+/** Asks the node for a sent transaction as UHazeClient::FetchSubmittedTransaction does; false if it cannot */
+using FHazeTxLookup = TFunction<bool(const FString& TransactionJson, FHazeOnTransaction OnComplete)>;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHazeBackpressureDelegate, bool, bSaturated, int32, QueueDepth);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FHazeOutboxReplayDelegate, bool, bAccepted, const FTransactionResponse&, Response, const FString&, OrderingKey);
+
+/**
+ * Queues signed transactions and feeds them to UHazeClient::SubmitTransaction through a bounded in-flight window.
+ *
+ * - Higher priority goes first; equal priority is FIFO.
+ * - Transport failures, 429 and 503 are retried with exponential backoff (full jitter); 429/503 also halve the
+ *   window, which then grows back by one per window of accepted transactions.
+ * - A retry refused with a 4xx may be refused because an earlier attempt landed after all (it timed out on the way
+ *   back). Before the rejection is reported the transaction is looked up by hash, and reported accepted if the node
+ *   has it. Only Transfers can be looked up (FTransactionBuilder::TransferHash).
+ * - Transactions sharing an OrderingKey (normally the sender address) go out in enqueue order, up to
+ *   MaxInFlightPerKey of them at once; each is sent only once the one before it is on the wire, and the client keeps
+ *   one sender's submissions on one node (FHazeNodeRouter::PickSubmitFor). Requests can still overtake each other on
+ *   the way, and the node refuses a nonce that arrives before its predecessor: a 4xx while an earlier transaction of
+ *   the key is unanswered is sent again once that one is answered, instead of failing (counted as a retry). If one
+ *   fails for good, the ones queued behind it fail as "dropped" without being sent; resync the sender's nonces
+ *   (FHazeNonceManager) and re-sign.
+ * - OnBackpressure(true) fires when QueueDepth reaches HighWaterMark and (false) once it drains to LowWaterMark;
+ *   Enqueue refuses new work at MaxQueueDepth.
+ * - With an outbox (EnableOutbox), every transaction is journaled before it is sent and acknowledged once the node
+ *   answers or it is dropped; ReplayOutbox resends what a crashed session left unanswered. A replayed transaction
+ *   is looked up first, as above, and completes as accepted without being resent if the node already has it.
+ *
+ * Game thread only.
+ */
+UCLASS(BlueprintType)
+class HAZEBLOCKCHAIN_API UHazeTxSubmitter : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Create a submitter that sends through Client */
+	UFUNCTION(BlueprintCallable, Category = "HAZE", meta = (DisplayName = "Create Haze Tx Submitter"))
+	static UHazeTxSubmitter* CreateSubmitter(UHazeClient* InClient);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE")
+	TObjectPtr<UHazeClient> Client;
+
+	/** Maximum requests in flight at once */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 MaxInFlight = 16;
+
+	/** Maximum transactions of one ordering key sent and not yet answered (1: strictly one at a time) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxInFlightPerKey = 4;
+
+	/** Enqueue fails once this many transactions are waiting */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "1"))
+	int32 MaxQueueDepth = 4096;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "1"))
+	int32 HighWaterMark = 1024;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "0"))
+	int32 LowWaterMark = 256;
+
+	/** Retries after the first attempt for retryable failures */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "0", ClampMax = "20"))
+	int32 MaxRetries = 5;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "0.01"))
+	float InitialBackoffSeconds = 0.25f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "0.01"))
+	float MaxBackoffSeconds = 10.f;
+
+	/** A transaction replayed from the outbox completed (it has no caller callback after a restart) */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE")
+	FHazeOutboxReplayDelegate OnOutboxReplayed;
+
+	/** Queue depth crossed HighWaterMark (true) or drained to LowWaterMark (false) */
+	UPROPERTY(BlueprintAssignable, Category = "HAZE")
+	FHazeBackpressureDelegate OnBackpressure;
+
+	/** Queue a transaction (inner JSON, as for SendTransaction). Returns false if the queue is full. */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	bool Enqueue(const FString& TransactionJson, EHazeTxPriority Priority, const FString& OrderingKey, const FHazeTransactionDelegate& OnComplete);
+
+	/** C++: as Enqueue, with a callback that also receives the final HTTP status (0 if never answered). Nonce is journaled with it. */
+	bool Submit(const FString& TransactionJson, EHazeTxPriority Priority, const FString& OrderingKey, FHazeOnTransaction OnComplete,
+		TOptional<uint64> Nonce = TOptional<uint64>());
+
+	/**
+	 * Journal every transaction to Saved/Haze/<JournalName>.journal and replay what earlier sessions left unanswered.
+	 * Call at startup, before submitting anything new, so replayed nonces go first. Returns the number replayed, or -1
+	 * if the journal cannot be opened.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	int32 EnableOutbox(const FString& JournalName = TEXT("Outbox"));
+
+	/** C++: journal through Outbox (null to stop journaling). Does not replay. */
+	void SetOutbox(TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> InOutbox) { Outbox = MoveTemp(InOutbox); }
+	TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> GetOutbox() const { return Outbox; }
+
+	/** C++: send through Transport instead of Client->SubmitTransaction (null for the client again), e.g. in tests */
+	void SetTransport(FHazeTxTransport InTransport) { Transport = MoveTemp(InTransport); }
+
+	/** C++: look up refused retries through Lookup instead of Client->FetchSubmittedTransaction (null for the client again) */
+	void SetLookup(FHazeTxLookup InLookup) { Lookup = MoveTemp(InLookup); }
+
+	/** C++: send the retries whose backoff has run out by Now (FPlatformTime::Seconds), as the ticker does */
+	void ResumeRetries(double Now);
+
+	/** Queue the outbox's recovered entries (OnOutboxReplayed reports each); each is looked up before it is resent. Returns how many. */
+	int32 ReplayOutbox();
+
+	/** Fail everything not yet sent (status "dropped"). In-flight requests still complete. */
+	UFUNCTION(BlueprintCallable, Category = "HAZE")
+	void CancelPending();
+
+	UFUNCTION(BlueprintPure, Category = "HAZE")
+	int32 GetQueueDepth() const { return QueuedCount; }
+
+	/** Between OnBackpressure(true) and OnBackpressure(false) */
+	UFUNCTION(BlueprintPure, Category = "HAZE")
+	bool IsSaturated() const { return bSaturated; }
+
+	UFUNCTION(BlueprintPure, Category = "HAZE")
+	FHazeTxSubmitterStats GetStats() const;
+
+	virtual void BeginDestroy() override;
+
+private:
+	struct FQueuedTx
+	{
+		FString Json;
+		FString OrderingKey;
+		FHazeOnTransaction OnComplete;
+		EHazeTxPriority Priority = EHazeTxPriority::Normal;
+		uint64 Sequence = 0;
+		int32 Attempts = 0;
+		double NotBefore = 0.0;
+		/** Outbox entry, or 0 */
+		uint64 JournalId = 0;
+		/** Recovered from the outbox and not looked up yet */
+		bool bReplayed = false;
+		/** Sent (or being looked up) and not answered yet */
+		bool bInFlight = false;
+		/** Refused while an earlier transaction of its key was unanswered: waits for all of them before it is resent */
+		bool bAfterEarlier = false;
+	};
+	using FQueuedTxRef = TSharedRef<FQueuedTx>;
+
+	/** Transactions of one ordering key */
+	struct FLane
+	{
+		/** Released to Ready, Delayed or in flight, in enqueue order */
+		TArray<FQueuedTxRef> Active;
+		/** Not released yet, in enqueue order */
+		TArray<FQueuedTxRef> Waiting;
+	};
+
+	/** Queue Tx behind its ordering lane and start sending */
+	void Admit(const FQueuedTxRef& Tx);
+	void Acknowledge(const FQueuedTx& Tx);
+	void PushReady(const FQueuedTxRef& Tx);
+	void Pump();
+	void Send(const FQueuedTxRef& Tx);
+	void OnSendComplete(const FQueuedTxRef& Tx, bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode);
+	/** Send Tx through Transport or Client */
+	void Transmit(const FQueuedTxRef& Tx);
+	/** Ask the node whether Tx landed: if so Tx completes as accepted, otherwise IfMissing runs. False if it cannot ask. */
+	bool LookUp(const FQueuedTxRef& Tx, TFunction<void(UHazeTxSubmitter& This)> IfMissing);
+	void CompleteSend(const FQueuedTxRef& Tx, bool bAccepted, const FTransactionResponse& Response, int32 ResponseCode);
+	/** Take answered Tx out of its ordering lane; on failure, collects the lane's unsent transactions into OutDropped */
+	void ReleaseLane(const FQueuedTxRef& Tx, bool bFailed, TArray<FQueuedTxRef>& OutDropped);
+	/** Release the lane's next transaction to Ready once everything released before it is on the wire */
+	void ReleaseNext(FLane& Lane);
+	/** Tx was refused while an earlier transaction of its lane was unanswered: back into the lane, behind them */
+	void Requeue(const FQueuedTxRef& Tx);
+	void CompleteDropped(TArray<FQueuedTxRef>& Dropped);
+	void UpdateBackpressure();
+	void EnsureTicking();
+	bool Tick(float DeltaTime);
+	double BackoffSeconds(int32 Attempt) const;
+	int32 CurrentWindow() const;
+
+	static bool IsRetryable(int32 ResponseCode);
+
+	/** Ready to send, ordered as a heap by (priority, sequence) */
+	TArray<FQueuedTxRef> Ready;
+	/** Waiting out a retry backoff */
+	TArray<FQueuedTxRef> Delayed;
+	/** Per ordering key */
+	TMap<FString, FLane> Lanes;
+
+	int32 QueuedCount = 0;
+	int32 InFlight = 0;
+	float CongestionWindow = 0.f;
+	uint64 NextSequence = 0;
+	bool bSaturated = false;
+
+	int64 AcceptedTotal = 0;
+	int64 RejectedTotal = 0;
+	int64 DroppedTotal = 0;
+	int64 RetryTotal = 0;
+	int64 AcceptedInSample = 0;
+	double SampleStart = 0.0;
+	float AcceptedPerSecond = 0.f;
+
+	TSharedPtr<FHazeOutboxJournal, ESPMode::ThreadSafe> Outbox;
+	FHazeTxTransport Transport;
+	FHazeTxLookup Lookup;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HazeAmount.h"
 #include "HazeTypes.generated.h"
 
 USTRUCT(BlueprintType)
@@ -10,7 +11,7 @@ struct HAZEBLOCKCHAIN_API FBlockchainInfo
 {
 	GENERATED_BODY()
 	UPROPERTY(BlueprintReadOnly) int64 CurrentHeight = 0;
-	UPROPERTY(BlueprintReadOnly) FString TotalSupply;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount TotalSupply;
 	UPROPERTY(BlueprintReadOnly) int64 CurrentWave = 0;
 	UPROPERTY(BlueprintReadOnly) FString StateRoot;
 	UPROPERTY(BlueprintReadOnly) int64 LastFinalizedHeight = 0;
@@ -21,9 +22,9 @@ USTRUCT(BlueprintType)
 struct HAZEBLOCKCHAIN_API FAccountInfo
 {
 	GENERATED_BODY()
-	UPROPERTY(BlueprintReadOnly) FString Balance;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount Balance;
 	UPROPERTY(BlueprintReadOnly) int32 Nonce = 0;
-	UPROPERTY(BlueprintReadOnly) FString Staked;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount Staked;
 };
 
 USTRUCT(BlueprintType)
@@ -34,17 +35,49 @@ struct HAZEBLOCKCHAIN_API FTransactionResponse
 	UPROPERTY(BlueprintReadOnly) FString Status;
 };
 
+/** GET /api/v1/blocks/height/{height} (or /blocks/{hash}) */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeBlockInfo
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) FString Hash;
+	UPROPERTY(BlueprintReadOnly) FString ParentHash;
+	UPROPERTY(BlueprintReadOnly) int64 Height = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Timestamp = 0;
+	UPROPERTY(BlueprintReadOnly) FString Validator;
+	UPROPERTY(BlueprintReadOnly) int64 WaveNumber = 0;
+	/** Hex hashes of the block's transactions, in block order */
+	UPROPERTY(BlueprintReadOnly) TArray<FString> Transactions;
+};
+
+/** One entry of a POST /api/v1/transactions/batch response (same order as submitted) */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FBatchTransactionResult
+{
+	GENERATED_BODY()
+	/** Empty if the node could not parse the transaction */
+	UPROPERTY(BlueprintReadOnly) FString Hash;
+	/** "pending" (accepted into the pool), "rejected" or "invalid" */
+	UPROPERTY(BlueprintReadOnly) FString Status;
+	UPROPERTY(BlueprintReadOnly) FString Error;
+
+	bool IsAccepted() const { return Status == TEXT("pending"); }
+};
+
+/** GET /api/v1/economy/pools entry (constant product: k = Reserve1 * Reserve2) */
 USTRUCT(BlueprintType)
 struct HAZEBLOCKCHAIN_API FLiquidityPool
 {
 	GENERATED_BODY()
+	/** "pool:{Asset1}:{Asset2}" */
 	UPROPERTY(BlueprintReadOnly) FString PoolId;
 	UPROPERTY(BlueprintReadOnly) FString Asset1;
 	UPROPERTY(BlueprintReadOnly) FString Asset2;
-	UPROPERTY(BlueprintReadOnly) FString Reserve1;
-	UPROPERTY(BlueprintReadOnly) FString Reserve2;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount Reserve1;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount Reserve2;
+	/** Basis points taken from the input (30 = 0.3%) */
 	UPROPERTY(BlueprintReadOnly) int32 FeeRate = 0;
-	UPROPERTY(BlueprintReadOnly) FString TotalLiquidity;
+	UPROPERTY(BlueprintReadOnly) FHazeAmount TotalLiquidity;
 };
 
 UENUM(BlueprintType)
@@ -66,3 +99,277 @@ enum class EAssetAction : uint8
 	Merge = 4,
 	Split = 5
 };
+
+/** GET /api/v1/assets/gas-schedule: the constants the node prices Mistborn operations with (FHazeGasEstimate mirrors the formulas) */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeGasSchedule
+{
+	GENERATED_BODY()
+	/** Changes whenever any constant does; 0 until fetched */
+	UPROPERTY(BlueprintReadOnly) int64 Version = 0;
+	UPROPERTY(BlueprintReadOnly) int64 GasPrice = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CreateBase = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CreatePerKb = 0;
+	UPROPERTY(BlueprintReadOnly) int64 UpdateBase = 0;
+	UPROPERTY(BlueprintReadOnly) int64 UpdatePerKb = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CondenseBase = 0;
+	/** CondenseBase multiplier per target density */
+	UPROPERTY(BlueprintReadOnly) int64 CondenseMultiplierEthereal = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CondenseMultiplierLight = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CondenseMultiplierDense = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CondenseMultiplierCore = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CondensePerKb = 0;
+	UPROPERTY(BlueprintReadOnly) int64 EvaporateBase = 0;
+	UPROPERTY(BlueprintReadOnly) int64 MergeBase = 0;
+	UPROPERTY(BlueprintReadOnly) int64 MergePerKb = 0;
+	UPROPERTY(BlueprintReadOnly) int64 SplitBase = 0;
+	UPROPERTY(BlueprintReadOnly) int64 SplitPerComponent = 0;
+	UPROPERTY(BlueprintReadOnly) int64 SplitPerKb = 0;
+};
+
+/** Event kinds pushed on /api/v1/ws (the "type" field of WsEvent in src/ws_events.rs) */
+UENUM(BlueprintType)
+enum class EHazeStreamEventType : uint8
+{
+	Unknown = 0,
+	AssetCreated,
+	AssetUpdated,
+	AssetCondensed,
+	AssetEvaporated,
+	AssetMerged,
+	AssetSplit,
+	AssetPermissionChanged,
+	AssetAttributeUpdated,
+	AssetVersionCreated,
+	BlockApplied,
+	Error,
+	PoolUpdated
+};
+
+/** One WebSocket event. Fields not carried by the event type are left empty. */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeStreamEvent
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) EHazeStreamEventType Type = EHazeStreamEventType::Unknown;
+	UPROPERTY(BlueprintReadOnly) FString AssetId;
+	UPROPERTY(BlueprintReadOnly) FString Owner;
+	/** density (created) or new_density (condensed / evaporated) */
+	UPROPERTY(BlueprintReadOnly) EDensityLevel Density = EDensityLevel::Ethereal;
+	/** merged_asset_id (merged) or created_assets (split) */
+	UPROPERTY(BlueprintReadOnly) TArray<FString> RelatedAssetIds;
+	UPROPERTY(BlueprintReadOnly) TArray<FString> Attributes;
+	UPROPERTY(BlueprintReadOnly) int64 Version = 0;
+	/** block_applied: height, block hash, transaction hashes and touched accounts */
+	UPROPERTY(BlueprintReadOnly) int64 Height = 0;
+	UPROPERTY(BlueprintReadOnly) FString BlockHash;
+	UPROPERTY(BlueprintReadOnly) TArray<FString> Transactions;
+	UPROPERTY(BlueprintReadOnly) TArray<FString> Accounts;
+	/** error: message */
+	UPROPERTY(BlueprintReadOnly) FString Message;
+	/** pool_updated: the pool's new reserves */
+	UPROPERTY(BlueprintReadOnly) FLiquidityPool Pool;
+};
+
+/**
+ * Server-side filter for /api/v1/ws. Empty fields match everything; for BlockApplied, Owner matches touched accounts,
+ * and PoolUpdated only looks at PoolId.
+ */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeStreamSubscription
+{
+	GENERATED_BODY()
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") EHazeStreamEventType Type = EHazeStreamEventType::AssetCreated;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString AssetId;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString Owner;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString GameId;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString PoolId;
+
+	bool operator==(const FHazeStreamSubscription& Other) const
+	{
+		return Type == Other.Type && AssetId == Other.AssetId && Owner == Other.Owner && GameId == Other.GameId
+			&& PoolId == Other.PoolId;
+	}
+};
+
+/** Outcome of UHazeClient::DownloadAssetBlob */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeBlobDownloadResult
+{
+	GENERATED_BODY()
+	/** SHA-256 from the asset's blob_refs (lowercase hex); also the cache key */
+	UPROPERTY(BlueprintReadOnly) FString BlobHash;
+	/** Verified file in the blob cache (FHazeBlobCache::Map it to read without copying) */
+	UPROPERTY(BlueprintReadOnly) FString FilePath;
+	UPROPERTY(BlueprintReadOnly) int64 Size = 0;
+	/** Already cached; nothing was downloaded */
+	UPROPERTY(BlueprintReadOnly) bool bFromCache = false;
+	UPROPERTY(BlueprintReadOnly) FString Error;
+};
+
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeAssetAttribute
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) FString Name;
+	UPROPERTY(BlueprintReadOnly) FString Value;
+	/** Negative if the attribute has no rarity */
+	UPROPERTY(BlueprintReadOnly) float Rarity = -1.f;
+};
+
+/**
+ * A Mistborn asset: the full view (GET /api/v1/assets/{id}) or its summary (?view=summary and POST
+ * /api/v1/assets/summaries), which carries only the metadata that fits the Ethereal budget and no attributes.
+ */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeAssetInfo
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) FString AssetId;
+	UPROPERTY(BlueprintReadOnly) FString Owner;
+	UPROPERTY(BlueprintReadOnly) EDensityLevel Density = EDensityLevel::Ethereal;
+	UPROPERTY(BlueprintReadOnly) FString GameId;
+	UPROPERTY(BlueprintReadOnly) int64 CreatedAt = 0;
+	UPROPERTY(BlueprintReadOnly) int64 UpdatedAt = 0;
+	UPROPERTY(BlueprintReadOnly) int64 CurrentVersion = 0;
+	UPROPERTY(BlueprintReadOnly) TMap<FString, FString> Metadata;
+	UPROPERTY(BlueprintReadOnly) TArray<FHazeAssetAttribute> Attributes;
+	/** Blob key -> SHA-256 (hex); the blobs themselves come from UHazeClient::DownloadAssetBlob */
+	UPROPERTY(BlueprintReadOnly) TMap<FString, FString> BlobRefs;
+	UPROPERTY(BlueprintReadOnly) bool bPublicRead = false;
+
+	/** True for the summary view */
+	UPROPERTY(BlueprintReadOnly) bool bIsSummary = false;
+	/** Summary: some metadata entries did not fit and were left out */
+	UPROPERTY(BlueprintReadOnly) bool bMetadataTruncated = false;
+	/** Summary: size of the full metadata (keys + values, bytes) */
+	UPROPERTY(BlueprintReadOnly) int64 MetadataBytes = 0;
+	/** Summary: number of attributes in the full view */
+	UPROPERTY(BlueprintReadOnly) int32 AttributeCount = 0;
+};
+
+/** One snapshot from GET /api/v1/assets/{id}/versions, with its full blob refs (UHazeAssetVersionCache rebuilds them from deltas) */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeAssetVersion
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) int64 Version = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Timestamp = 0;
+	UPROPERTY(BlueprintReadOnly) EDensityLevel Density = EDensityLevel::Ethereal;
+	UPROPERTY(BlueprintReadOnly) FString GameId;
+	UPROPERTY(BlueprintReadOnly) TMap<FString, FString> Metadata;
+	UPROPERTY(BlueprintReadOnly) TArray<FHazeAssetAttribute> Attributes;
+	/** Blob key -> SHA-256 (hex) */
+	UPROPERTY(BlueprintReadOnly) TMap<FString, FString> BlobRefs;
+};
+
+/** One change from GET /api/v1/assets/{id}/history */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeAssetHistoryEntry
+{
+	GENERATED_BODY()
+	/** Position among every entry the node ever recorded for the asset (stable across its 100-entry limit) */
+	UPROPERTY(BlueprintReadOnly) int64 Index = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Timestamp = 0;
+	/** Create, Update, Condense, Evaporate, Merge or Split */
+	UPROPERTY(BlueprintReadOnly) FString Action;
+	UPROPERTY(BlueprintReadOnly) TMap<FString, FString> Changes;
+};
+
+UENUM(BlueprintType)
+enum class EHazeAssetSort : uint8
+{
+	CreatedAt = 0,
+	UpdatedAt = 1,
+	/** The "rarity" attribute */
+	Rarity = 2
+};
+
+/** Filters and paging for UHazeClient::SearchAssets (GET /api/v1/assets/search). Empty filters match everything. */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeAssetSearchQuery
+{
+	GENERATED_BODY()
+	/** Owner address (hex) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString Owner;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString GameId;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") bool bFilterDensity = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") EDensityLevel Density = EDensityLevel::Ethereal;
+	/** Metadata full-text query */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString Text;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") EHazeAssetSort SortBy = EHazeAssetSort::CreatedAt;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") bool bAscending = false;
+	/** Assets per request (the node caps this at 1000) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE", meta = (ClampMin = "1", ClampMax = "1000")) int32 PageSize = 200;
+	/** Metadata entry kept per asset as its display label (everything else in metadata is skipped) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString LabelKey = TEXT("name");
+	/** Request the following page as soon as one is handed out */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") bool bPrefetch = true;
+	/**
+	 * Cursors with the same key (one search box) supersede each other's page requests: a cursor for newer text drops
+	 * an older one's request still waiting for a slot, and that cursor's Next fails. Empty: never superseded.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HAZE") FString SupersedeKey;
+};
+
+/** UHazeClient call kinds, for per-endpoint request metrics (UHazeClient::GetEndpointStats) */
+UENUM(BlueprintType)
+enum class EHazeEndpoint : uint8
+{
+	Health = 0,
+	BlockchainInfo,
+	Balance,
+	Account,
+	SubmitTransaction,
+	SubmitTransactionBatch,
+	Asset,
+	AssetSummaries,
+	AssetSearch,
+	AssetBlobRef,
+	LiquidityPools,
+	Block,
+	AssetVersions,
+	AssetHistory,
+	GasSchedule,
+	AssetSnapshot,
+	SnapshotStale,
+	AssetBlob,
+	Transaction,
+	Count UMETA(Hidden)
+};
+
+/** Scheduling class of a UHazeClient request; each has its own budget of requests in flight */
+UENUM(BlueprintType)
+enum class EHazeRequestPriority : uint8
+{
+	/** Transaction submissions */
+	Critical = 0,
+	/** Reads something is waiting on (balances, accounts, assets, search) */
+	Interactive,
+	/** Prefetches and sync that nothing is blocked on (versions, history, snapshots, streaming) */
+	Background,
+	Count UMETA(Hidden)
+};
+
+/** Request metrics of one endpoint since the client was created (or ResetRequestStats). Times in milliseconds. */
+USTRUCT(BlueprintType)
+struct HAZEBLOCKCHAIN_API FHazeEndpointStats
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly) int32 InFlight = 0;
+	UPROPERTY(BlueprintReadOnly) int64 Completed = 0;
+	/** Transport, HTTP or decode failures (included in Completed) */
+	UPROPERTY(BlueprintReadOnly) int64 Failed = 0;
+	/** Sent to delegate; percentiles are histogram bucket bounds */
+	UPROPERTY(BlueprintReadOnly) float AverageMs = 0.f;
+	UPROPERTY(BlueprintReadOnly) float P50Ms = 0.f;
+	UPROPERTY(BlueprintReadOnly) float P95Ms = 0.f;
+	UPROPERTY(BlueprintReadOnly) float P99Ms = 0.f;
+	/** Average per stage: queued -> sent -> first byte -> complete -> parsed -> delegate */
+	UPROPERTY(BlueprintReadOnly) float QueuedMs = 0.f;
+	UPROPERTY(BlueprintReadOnly) float FirstByteMs = 0.f;
+	UPROPERTY(BlueprintReadOnly) float TransferMs = 0.f;
+	UPROPERTY(BlueprintReadOnly) float ParseMs = 0.f;
+	UPROPERTY(BlueprintReadOnly) float DispatchMs = 0.f;
+	UPROPERTY(BlueprintReadOnly) int64 BytesReceived = 0;
+};
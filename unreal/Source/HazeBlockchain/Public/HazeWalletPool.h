@@ -0,0 +1,124 @@
+// Copyright HAZE Blockchain. Contiguous pool of Ed25519 wallets for server-side bulk signing.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HazeSigner.h"
+
+class UHazeKeyPair;
+
+/** A wallet in an FHazeWalletPool. Goes stale when the wallet is removed (its slot may then hold another wallet). */
+struct FHazeWalletHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	/** False for wallets that could not be created or imported */
+	bool IsSet() const { return Index != INDEX_NONE; }
+
+	friend bool operator==(const FHazeWalletHandle& A, const FHazeWalletHandle& B) { return A.Index == B.Index && A.Generation == B.Generation; }
+	friend bool operator!=(const FHazeWalletHandle& A, const FHazeWalletHandle& B) { return !(A == B); }
+};
+
+/**
+ * Custodial hot wallets without a UObject each: seed, public key and expanded key of every wallet sit in one
+ * cache-aligned 128-byte slot, in page-locked chunks of SlotsPerChunk that are zeroized when freed. Wallets are
+ * added in bulk (Generate / Import, keys derived across task-graph workers) and addressed by handle or slot index;
+ * FTransactionBuilder's pool overloads and SignBatch sign from the slots directly. CreateKeyPair makes a
+ * UHazeKeyPair only where a Blueprint needs one.
+ *
+ *   FHazeWalletPool Pool;
+ *   TArray<FHazeWalletHandle> Npcs = Pool.Generate(20000);
+ *   TArray<FString> Txs = FTransactionBuilder::BuildSignedTransferBatch(Pool, Payouts);
+ *
+ * Adding, removing, looking up and signing are thread-safe; CreateKeyPair makes a UObject and is game thread only.
+ * Signer views and transactions in flight stay valid while their wallet is in the pool: do not remove a wallet
+ * something is still signing with.
+ */
+class HAZEBLOCKCHAIN_API FHazeWalletPool
+{
+public:
+	/** Wallets per allocation (64 KiB) */
+	static constexpr int32 SlotsPerChunk = 512;
+
+	FHazeWalletPool() = default;
+	/** Zeroizes and frees every wallet */
+	~FHazeWalletPool();
+
+	FHazeWalletPool(const FHazeWalletPool&) = delete;
+	FHazeWalletPool& operator=(const FHazeWalletPool&) = delete;
+
+	/** Create Count wallets from fresh random seeds. Unset handles where Ed25519 is not available. */
+	TArray<FHazeWalletHandle> Generate(int32 Count);
+
+	/** Add wallets from concatenated 32-byte seeds (e.g. loaded from a vault); a trailing partial seed is ignored */
+	TArray<FHazeWalletHandle> Import(TArrayView<const uint8> Seeds);
+
+	/** Add wallets from 64-digit hex seeds; entries that do not decode get unset handles */
+	TArray<FHazeWalletHandle> ImportHex(TArrayView<const FString> SeedsHex);
+
+	/** Add a copy of a key pair's seed */
+	FHazeWalletHandle Import(const UHazeKeyPair* KeyPair);
+
+	/** Zeroize a wallet and free its slot. False if the handle is stale. */
+	bool Remove(FHazeWalletHandle Wallet);
+
+	bool IsValid(FHazeWalletHandle Wallet) const;
+
+	/** Wallets in the pool */
+	int32 Num() const;
+
+	/** Slots ever used; valid indices for GetHandle are [0, GetSlotCount()) */
+	int32 GetSlotCount() const;
+
+	/** The wallet currently in slot Index, or an unset handle */
+	FHazeWalletHandle GetHandle(int32 Index) const;
+
+	/** Signing key of a wallet (invalid view if the handle is stale) */
+	FHazeSignerView GetSigner(FHazeWalletHandle Wallet) const;
+
+	/** GetSigner for many wallets under one lock */
+	TArray<FHazeSignerView> GetSigners(TArrayView<const FHazeWalletHandle> Wallets) const;
+
+	/** Address as 64-character hex, or empty if the handle is stale */
+	FString GetAddressHex(FHazeWalletHandle Wallet) const;
+
+	/** Sign Message into OutSignature (64 bytes). False if the handle is stale or Ed25519 is not available. */
+	bool Sign(FHazeWalletHandle Wallet, const uint8* Message, int32 MessageLen, uint8* OutSignature) const;
+
+	/**
+	 * Sign Messages[i] with Wallets[i] across task-graph workers. OutSignatures gets 64 bytes per message, zeros
+	 * where signing failed. Returns how many were signed. Blocks until all are done.
+	 */
+	int32 SignBatch(TArrayView<const FHazeWalletHandle> Wallets, TArrayView<const TArrayView<const uint8>> Messages, TArray<uint8>& OutSignatures) const;
+
+	/** A UHazeKeyPair with a copy of the wallet's seed (for Blueprints), or null if the handle is stale. Game thread only. */
+	UHazeKeyPair* CreateKeyPair(FHazeWalletHandle Wallet) const;
+
+private:
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+	{
+		uint8 Seed[FHazeSignerContext::SeedSize];
+		uint8 PublicKey[FHazeSignerContext::PublicKeySize];
+		uint8 ExpandedKey[FHazeSignerContext::ExpandedKeySize];
+	};
+
+	/** Take Count slots, filled by FillSeed (false: no wallet), derive them in parallel and publish them */
+	TArray<FHazeWalletHandle> Add(int32 Count, TFunctionRef<bool(int32 Index, uint8* OutSeed)> FillSeed);
+
+	/** Caller holds Lock */
+	FSlot& SlotAt(int32 Index) const;
+	const FSlot* Find(FHazeWalletHandle Wallet) const;
+	void Release(int32 Index);
+
+	mutable FRWLock Lock;
+	/** Never moved or freed before the pool, so views into them stay valid */
+	TArray<FSlot*> Chunks;
+	/** Per slot: bumped whenever a wallet leaves it */
+	TArray<uint32> Generations;
+	/** Per slot: holds a published wallet */
+	TBitArray<> Live;
+	TArray<int32> FreeSlots;
+	int32 LiveCount = 0;
+};
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+#include "HazeSigner.h"
 #include "KeyPair.generated.h"
 
 UCLASS(BlueprintType)
@@ -34,7 +37,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "HAZE")
 	TArray<uint8> Sign(const TArray<uint8>& Message) const;
 
+	/** C++: sign into a caller-provided 64-byte buffer without allocating. Returns false if signing not available. */
+	bool SignTo(const uint8* Message, int32 MessageLen, uint8* OutSignature) const;
+
 	/** Whether this key pair can sign (Ed25519 library linked) */
 	UFUNCTION(BlueprintPure, Category = "HAZE")
 	static bool IsSigningAvailable();
+
+	/** C++: expanded signing key, derived from PrivateKey on first use and re-derived if PrivateKey changes.
+	 *  Returns null if signing not available. A context is never changed once handed out: a new PrivateKey gets a new
+	 *  one, so a caller signing from another thread keeps a valid key for as long as it holds the pointer. */
+	TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> GetSigner() const;
+
+	virtual void BeginDestroy() override;
+
+private:
+
+	/** Guarded by SignerLock; swapped, never re-initialized in place */
+	mutable TSharedPtr<const FHazeSignerContext, ESPMode::ThreadSafe> Signer;
+	mutable FCriticalSection SignerLock;
 };
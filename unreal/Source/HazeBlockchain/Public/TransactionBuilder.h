@@ -5,6 +5,40 @@
 #include "CoreMinimal.h"
 #include "HazeTypes.h"
 #include "KeyPair.h"
+#include "HazeWalletPool.h"
+
+/** One Transfer to build and sign in a batch (see FTransactionBuilder::BuildSignedTransferBatch). */
+struct HAZEBLOCKCHAIN_API FHazeTransferIntent
+{
+	FString ToAddressHex;
+	uint64 Amount = 0;
+	uint64 Fee = 0;
+	uint64 Nonce = 0;
+	TOptional<uint64> ChainId;
+	TOptional<uint64> ValidUntilHeight;
+};
+
+/** A Transfer from a pooled wallet (see FTransactionBuilder::BuildSignedTransferBatch with an FHazeWalletPool). */
+struct HAZEBLOCKCHAIN_API FHazeWalletTransferIntent : FHazeTransferIntent
+{
+	FHazeWalletHandle From;
+};
+
+/**
+ * One MistbornAsset Create to build and sign in a batch (see FTransactionBuilder::BuildSignedMistbornBatch).
+ * The Create payload carries an empty attribute list, as BuildSignedMistbornCreate writes it.
+ */
+struct HAZEBLOCKCHAIN_API FHazeMistbornCreateIntent
+{
+	FString AssetIdHex;
+	EDensityLevel Density = EDensityLevel::Ethereal;
+	TMap<FString, FString> Metadata;
+	FString GameId;
+	uint64 Fee = 0;
+	uint64 Nonce = 0;
+	TOptional<uint64> ChainId;
+	TOptional<uint64> ValidUntilHeight;
+};
 
 struct HAZEBLOCKCHAIN_API FTransactionBuilder
 {
@@ -18,7 +52,20 @@ struct HAZEBLOCKCHAIN_API FTransactionBuilder
 		TOptional<uint64> ChainId = {},
 		TOptional<uint64> ValidUntilHeight = {});
 
-	/** Build signed MistbornAsset Create transaction JSON. Returns empty on failure. */
+	/** Build signed MistbornAsset Create transaction JSON with an empty attributes list. Returns empty on failure. */
+	static FString BuildSignedMistbornCreate(
+		UHazeKeyPair* KeyPair,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		const TMap<FString, FString>& Metadata,
+		const FString& GameId,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	/** Attributes were never written; returns empty if any are passed, otherwise the same as the overload above */
+	UE_DEPRECATED(0.1, "Attributes were never written to the Create payload. Use the overload without Attributes.")
 	static FString BuildSignedMistbornCreate(
 		UHazeKeyPair* KeyPair,
 		const FString& AssetIdHex,
@@ -31,8 +78,99 @@ struct HAZEBLOCKCHAIN_API FTransactionBuilder
 		TOptional<uint64> ChainId = {},
 		TOptional<uint64> ValidUntilHeight = {});
 
-	/** Bytes to 64-char hex */
+	/** Build and sign many Transfers from one key, spread over the task graph (ParallelFor).
+	 *  Result[i] corresponds to Intents[i]; failed entries are empty. Blocks until all are done. */
+	static TArray<FString> BuildSignedTransferBatch(
+		UHazeKeyPair* KeyPair,
+		const TArray<FHazeTransferIntent>& Intents);
+
+	/** As above, each intent signed by its own wallet in Pool (Intents[i].From); entries with a stale handle are empty. */
+	static TArray<FString> BuildSignedTransferBatch(
+		const FHazeWalletPool& Pool,
+		const TArray<FHazeWalletTransferIntent>& Intents);
+
+	/** Build and sign many MistbornAsset Create transactions from one key, spread over the task graph (ParallelFor).
+	 *  Result[i] corresponds to Intents[i]; failed entries are empty. Blocks until all are done. */
+	static TArray<FString> BuildSignedMistbornBatch(
+		UHazeKeyPair* KeyPair,
+		const TArray<FHazeMistbornCreateIntent>& Intents);
+
+	/**
+	 * Write the whole POST /api/v1/transactions body ({"transaction": <signed Transfer>}) as UTF-8 into OutBody
+	 * for UHazeClient::SubmitTransactionBody. OutBody is reset but keeps its capacity, so reusing one buffer
+	 * builds without allocating. False (and OutBody empty) on failure.
+	 */
+	static bool WriteSignedTransferRequest(
+		TArray<uint8>& OutBody,
+		UHazeKeyPair* KeyPair,
+		const FString& ToAddressHex,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	/** As WriteSignedTransferRequest, for a MistbornAsset Create. Metadata and GameId are escaped as JSON strings. */
+	static bool WriteSignedMistbornCreateRequest(
+		TArray<uint8>& OutBody,
+		UHazeKeyPair* KeyPair,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		const TMap<FString, FString>& Metadata,
+		const FString& GameId,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	// Binary (application/x-haze-bincode) variants: the same signed transactions as bincode bytes for
+	// UHazeClient::SubmitTransactionBinary. Smaller than the JSON and they carry chain_id / valid_until_height.
+
+	/** Build signed Transfer as bincode bytes. Returns empty on failure. */
+	static TArray<uint8> BuildSignedTransferBinary(
+		UHazeKeyPair* KeyPair,
+		const FString& ToAddressHex,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	/** Build signed MistbornAsset Create as bincode bytes (no attributes, as the JSON builder). Returns empty on failure. */
+	static TArray<uint8> BuildSignedMistbornCreateBinary(
+		UHazeKeyPair* KeyPair,
+		const FString& AssetIdHex,
+		EDensityLevel Density,
+		const TMap<FString, FString>& Metadata,
+		const FString& GameId,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	/** BuildSignedTransferBatch, as bincode bytes */
+	static TArray<TArray<uint8>> BuildSignedTransferBatchBinary(
+		UHazeKeyPair* KeyPair,
+		const TArray<FHazeTransferIntent>& Intents);
+
+	/** BuildSignedTransferBatch from pooled wallets, as bincode bytes */
+	static TArray<TArray<uint8>> BuildSignedTransferBatchBinary(
+		const FHazeWalletPool& Pool,
+		const TArray<FHazeWalletTransferIntent>& Intents);
+
+	/** BuildSignedMistbornBatch, as bincode bytes */
+	static TArray<TArray<uint8>> BuildSignedMistbornBatchBinary(
+		UHazeKeyPair* KeyPair,
+		const TArray<FHazeMistbornCreateIntent>& Intents);
+
+	/**
+	 * The node's hash (hex SHA-256 of the bincode encoding) of a Transfer as BuildSignedTransfer writes it. Empty for
+	 * anything else: other transactions the client submits carry a HashMap, which the node encodes in its own order.
+	 */
+	static FString TransferHash(const FString& TransactionJson);
+
+	/** Bytes to lowercase hex (see FHazeHex) */
 	static FString BytesToHex(const TArray<uint8>& Bytes);
-	/** 64-char hex to bytes (32 or 64) */
+	/** Hex to bytes, whitespace ignored; empty on invalid input (see FHazeHex) */
 	static TArray<uint8> HexToBytes(const FString& Hex);
 };
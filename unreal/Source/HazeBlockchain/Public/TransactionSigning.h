@@ -5,12 +5,144 @@
 #include "CoreMinimal.h"
 #include "HazeTypes.h"
 
+/**
+ * Byte layout of the canonical Transfer payload (all integers u64 little-endian):
+ * "Transfer" | from[32] | to[32] | amount | fee | nonce [| chain_id] [| valid_until_height]
+ */
+struct FHazeTransferPayloadLayout
+{
+	static constexpr int32 AddressSize = 32;
+	static constexpr int32 U64Size = 8;
+	static constexpr int32 TagOffset = 0;
+	static constexpr int32 TagSize = 8;
+	static constexpr int32 FromOffset = TagOffset + TagSize;
+	static constexpr int32 ToOffset = FromOffset + AddressSize;
+	static constexpr int32 AmountOffset = ToOffset + AddressSize;
+	static constexpr int32 FeeOffset = AmountOffset + U64Size;
+	static constexpr int32 NonceOffset = FeeOffset + U64Size;
+	static constexpr int32 BaseSize = NonceOffset + U64Size;
+	static constexpr int32 MaxSize = BaseSize + 2 * U64Size;
+
+	static constexpr int32 Size(bool bHasChainId, bool bHasValidUntilHeight)
+	{
+		return BaseSize + (bHasChainId ? U64Size : 0) + (bHasValidUntilHeight ? U64Size : 0);
+	}
+};
+
+/**
+ * Byte layout of the canonical MistbornAsset payload:
+ * "MistbornAsset" | from[32] | action u8 | asset_id[32] | owner[32] | density u8
+ * [| other_asset_id[32] (Merge)] [| components UTF-8 (Split)] | fee | nonce [| chain_id] [| valid_until_height]
+ * Everything except the Split components has a fixed size.
+ */
+struct FHazeMistbornPayloadLayout
+{
+	static constexpr int32 AddressSize = 32;
+	static constexpr int32 U64Size = 8;
+	static constexpr int32 TagOffset = 0;
+	static constexpr int32 TagSize = 13;
+	static constexpr int32 FromOffset = TagOffset + TagSize;
+	static constexpr int32 ActionOffset = FromOffset + AddressSize;
+	static constexpr int32 AssetIdOffset = ActionOffset + 1;
+	static constexpr int32 OwnerOffset = AssetIdOffset + AddressSize;
+	static constexpr int32 DensityOffset = OwnerOffset + AddressSize;
+	static constexpr int32 HeaderSize = DensityOffset + 1;
+	static constexpr int32 MergeExtraSize = AddressSize;
+	static constexpr int32 TrailerMaxSize = 4 * U64Size;
+	/** Largest payload without Split components */
+	static constexpr int32 FixedMaxSize = HeaderSize + MergeExtraSize + TrailerMaxSize;
+};
+
+/** Stack-backed payload buffers. Transfer never touches the heap; Mistborn only for long Split component lists. */
+using FHazeTransferPayload = TArray<uint8, TInlineAllocator<FHazeTransferPayloadLayout::MaxSize>>;
+using FHazeMistbornPayload = TArray<uint8, TInlineAllocator<256>>;
+
 struct HAZEBLOCKCHAIN_API FTransactionSigning
 {
+	/**
+	 * Write the canonical Transfer payload into Out, which must hold FHazeTransferPayloadLayout::MaxSize bytes.
+	 * Returns bytes written, or 0 if an address is shorter than 32 bytes.
+	 */
+	static int32 WriteTransferPayload(
+		uint8* Out,
+		TArrayView<const uint8> FromAddress,
+		TArrayView<const uint8> ToAddress,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	/**
+	 * Write the canonical MistbornAsset payload into Out (Capacity bytes).
+	 * Returns the payload size; nothing is written if that exceeds Capacity. Returns 0 if an address is shorter than 32 bytes.
+	 */
+	static int32 WriteMistbornAssetPayload(
+		uint8* Out,
+		int32 Capacity,
+		TArrayView<const uint8> FromAddress,
+		EAssetAction Action,
+		TArrayView<const uint8> AssetId,
+		TArrayView<const uint8> DataOwner,
+		EDensityLevel Density,
+		uint64 Fee,
+		uint64 Nonce,
+		const TMap<FString, FString>& MetadataMergeSplit,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {});
+
+	/** Build canonical Transfer payload into any byte array (e.g. FHazeTransferPayload). Empty on invalid input. */
+	template <typename AllocatorType>
+	static void BuildTransferPayloadInto(
+		TArray<uint8, AllocatorType>& Out,
+		TArrayView<const uint8> FromAddress,
+		TArrayView<const uint8> ToAddress,
+		uint64 Amount,
+		uint64 Fee,
+		uint64 Nonce,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {})
+	{
+		Out.SetNumUninitialized(FHazeTransferPayloadLayout::Size(ChainId.IsSet(), ValidUntilHeight.IsSet()));
+		if (WriteTransferPayload(Out.GetData(), FromAddress, ToAddress, Amount, Fee, Nonce, ChainId, ValidUntilHeight) == 0)
+		{
+			Out.Reset();
+		}
+	}
+
+	/** Build canonical MistbornAsset payload into any byte array (e.g. FHazeMistbornPayload). Empty on invalid input. */
+	template <typename AllocatorType>
+	static void BuildMistbornAssetPayloadInto(
+		TArray<uint8, AllocatorType>& Out,
+		TArrayView<const uint8> FromAddress,
+		EAssetAction Action,
+		TArrayView<const uint8> AssetId,
+		TArrayView<const uint8> DataOwner,
+		EDensityLevel Density,
+		uint64 Fee,
+		uint64 Nonce,
+		const TMap<FString, FString>& MetadataMergeSplit,
+		TOptional<uint64> ChainId = {},
+		TOptional<uint64> ValidUntilHeight = {})
+	{
+		// Write into slack first; only long Split payloads need a second pass after growing.
+		Out.Reset();
+		Out.Reserve(FHazeMistbornPayloadLayout::FixedMaxSize);
+		int32 Size = WriteMistbornAssetPayload(Out.GetData(), Out.Max(), FromAddress, Action, AssetId, DataOwner,
+			Density, Fee, Nonce, MetadataMergeSplit, ChainId, ValidUntilHeight);
+		if (Size > Out.Max())
+		{
+			Out.Reserve(Size);
+			Size = WriteMistbornAssetPayload(Out.GetData(), Out.Max(), FromAddress, Action, AssetId, DataOwner,
+				Density, Fee, Nonce, MetadataMergeSplit, ChainId, ValidUntilHeight);
+		}
+		Out.SetNumUninitialized(Size);
+	}
+
 	/** Build canonical payload for Transfer (matches Rust get_transaction_data_for_signing) */
 	static TArray<uint8> BuildTransferPayload(
-		const TArray<uint8>& FromAddress,
-		const TArray<uint8>& ToAddress,
+		TArrayView<const uint8> FromAddress,
+		TArrayView<const uint8> ToAddress,
 		uint64 Amount,
 		uint64 Fee,
 		uint64 Nonce,
@@ -19,10 +151,10 @@ struct HAZEBLOCKCHAIN_API FTransactionSigning
 
 	/** Build canonical payload for MistbornAsset Create (and other actions). */
 	static TArray<uint8> BuildMistbornAssetPayload(
-		const TArray<uint8>& FromAddress,
+		TArrayView<const uint8> FromAddress,
 		EAssetAction Action,
-		const TArray<uint8>& AssetId,
-		const TArray<uint8>& DataOwner,
+		TArrayView<const uint8> AssetId,
+		TArrayView<const uint8> DataOwner,
 		EDensityLevel Density,
 		uint64 Fee,
 		uint64 Nonce,